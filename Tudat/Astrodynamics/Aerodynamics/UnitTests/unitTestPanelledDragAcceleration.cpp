@@ -0,0 +1,118 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <vector>
+
+#include <boost/lambda/lambda.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Astrodynamics/Aerodynamics/panelledDragAcceleration.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::aerodynamics;
+using namespace tudat::system_models;
+
+BOOST_AUTO_TEST_SUITE( test_panelled_drag_acceleration )
+
+//! Test drag force on single flat plate for limiting cases of the accommodation coefficients.
+BOOST_AUTO_TEST_CASE( testFlatPlateDrag )
+{
+    const double density = 3.0E-12;
+    const double area = 1.7;
+    const Eigen::Vector3d airspeedVelocity( 7.2E3, 1.0E2, -3.0E2 );
+    const double airspeed = airspeedVelocity.norm( );
+    const Eigen::Vector3d panelNormal = Eigen::Vector3d( 1.0, 0.6, 0.3 ).normalized( );
+    const double cosine = panelNormal.dot( airspeedVelocity.normalized( ) );
+
+    // Fully accommodated re-emission: all incoming momentum absorbed.
+    PanelledSurfaceModel diffusePlate(
+                std::vector< Eigen::Vector3d >( 1, panelNormal ), std::vector< double >( 1, area ),
+                std::vector< double >( 1, 0.0 ), std::vector< double >( 1, 0.0 ) );
+    Eigen::Vector3d expectedForce = -density * airspeed * area * cosine * airspeedVelocity;
+    BOOST_CHECK_SMALL( ( computePanelledDragForce( density, airspeedVelocity, diffusePlate ) -
+                         expectedForce ).norm( ), 1.0E-14 * expectedForce.norm( ) );
+
+    // Specular reflection: force along panel normal only.
+    PanelledSurfaceModel specularPlate(
+                std::vector< Eigen::Vector3d >( 1, panelNormal ), std::vector< double >( 1, area ),
+                std::vector< double >( 1, 0.0 ), std::vector< double >( 1, 0.0 ),
+                std::vector< double >( 1, 0.0 ), std::vector< double >( 1, 0.0 ) );
+    expectedForce = -2.0 * density * airspeed * airspeed * area * cosine * cosine * panelNormal;
+    BOOST_CHECK_SMALL( ( computePanelledDragForce( density, airspeedVelocity, specularPlate ) -
+                         expectedForce ).norm( ), 1.0E-14 * expectedForce.norm( ) );
+
+    // Panel not exposed to flow, and zero airspeed.
+    BOOST_CHECK_EQUAL( computePanelledDragForce( density, -airspeedVelocity, diffusePlate ).norm( ), 0.0 );
+    BOOST_CHECK_EQUAL( computePanelledDragForce( density, Eigen::Vector3d::Zero( ), diffusePlate ).norm( ), 0.0 );
+}
+
+//! Test box-wing drag acceleration, including body rotation.
+BOOST_AUTO_TEST_CASE( testBoxWingDragAcceleration )
+{
+    const double density = 2.0E-11;
+    const double mass = 800.0;
+    const Eigen::Vector3d boxDimensions( 1.0, 2.0, 3.0 );
+
+    // Create absorbing box-wing model with solar array in body x-y plane.
+    boost::shared_ptr< PanelledSurfaceModel > boxWingModel = boost::make_shared< PanelledSurfaceModel >(
+                createBoxWingPanelledSurfaceModel(
+                    boxDimensions, 10.0, Eigen::Vector3d::UnitZ( ), 0.1, 0.2, 0.1, 0.2, 0.1, 0.2 ) );
+
+    const Eigen::Vector3d airspeedVelocity( -1.0E3, 7.3E3, 2.0E2 );
+    const Eigen::Quaterniond centralBodyRotation( Eigen::AngleAxisd( 1.3, Eigen::Vector3d::UnitZ( ) ) );
+
+    for( unsigned int test = 0; test < 10; test++ )
+    {
+        const Eigen::Quaterniond rotationToInertialFrame =
+                Eigen::Quaterniond( Eigen::AngleAxisd( 0.6 * test, Eigen::Vector3d::UnitZ( ) ) *
+                                    Eigen::AngleAxisd( 0.35 * test - 1.0, Eigen::Vector3d::UnitY( ) ) );
+
+        PanelledDragAcceleration accelerationModel(
+                    boost::lambda::constant( density ), boost::lambda::constant( airspeedVelocity ),
+                    boost::lambda::constant( centralBodyRotation ), boost::lambda::constant( rotationToInertialFrame ),
+                    boxWingModel, boost::lambda::constant( mass ) );
+        accelerationModel.updateMembers( 0.0 );
+        Eigen::Vector3d acceleration = accelerationModel.getAcceleration( );
+
+        // With unit accommodation coefficients, drag is opposite to inertial airspeed, with magnitude given by the
+        // projected area of the exposed panels.
+        Eigen::Vector3d inertialAirspeedVelocity = centralBodyRotation * airspeedVelocity;
+        Eigen::Vector3d airspeedDirectionInBodyFrame =
+                rotationToInertialFrame.inverse( ) * inertialAirspeedVelocity.normalized( );
+        BOOST_CHECK_SMALL( ( accelerationModel.getCurrentAirspeedVelocityInBodyFixedFrame( ) -
+                             rotationToInertialFrame.inverse( ) * inertialAirspeedVelocity ).norm( ), 1.0E-9 );
+
+        double projectedArea =
+                boxDimensions( 1 ) * boxDimensions( 2 ) * std::fabs( airspeedDirectionInBodyFrame( 0 ) ) +
+                boxDimensions( 0 ) * boxDimensions( 2 ) * std::fabs( airspeedDirectionInBodyFrame( 1 ) ) +
+                ( boxDimensions( 0 ) * boxDimensions( 1 ) + 10.0 ) * std::fabs( airspeedDirectionInBodyFrame( 2 ) );
+        Eigen::Vector3d expectedAcceleration =
+                -density * inertialAirspeedVelocity.norm( ) * projectedArea * inertialAirspeedVelocity / mass;
+
+        BOOST_CHECK_SMALL( ( acceleration - expectedAcceleration ).norm( ), 1.0E-14 * expectedAcceleration.norm( ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,47 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include "Tudat/Astrodynamics/Aerodynamics/panelledDragAcceleration.h"
+
+namespace tudat
+{
+namespace aerodynamics
+{
+
+//! Compute free molecular flow drag force on a panelled surface.
+Eigen::Vector3d computePanelledDragForce(
+        const double density,
+        const Eigen::Vector3d& airspeedVelocity,
+        system_models::PanelledSurfaceModel& panelledSurfaceModel )
+{
+    const double airspeed = airspeedVelocity.norm( );
+    if( !( airspeed > 0.0 ) )
+    {
+        return Eigen::Vector3d::Zero( );
+    }
+    const Eigen::Vector3d airspeedDirection = airspeedVelocity / airspeed;
+
+    // Compute cosines of angles between flow and panel normals, set to zero for panels not exposed to the flow.
+    const Eigen::ArrayXd cosines =
+            ( panelledSurfaceModel.getPanelNormals( ).transpose( ) * airspeedDirection ).array( ).max( 0.0 );
+
+    // Sum force components along airspeed direction and along panel normals.
+    const double flowDirectionComponent = ( cosines * panelledSurfaceModel.getDragFlowDirectionFactors( ) ).sum( );
+    const Eigen::VectorXd normalComponents =
+            ( cosines * cosines * panelledSurfaceModel.getDragNormalFactors( ) ).matrix( );
+
+    return -density * airspeed * airspeed * (
+                flowDirectionComponent * airspeedDirection +
+                panelledSurfaceModel.getPanelNormals( ) * normalComponents );
+}
+
+} // namespace aerodynamics
+} // namespace tudat
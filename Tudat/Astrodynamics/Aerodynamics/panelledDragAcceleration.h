@@ -0,0 +1,200 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Doornbos, E. Thermospheric Density and Wind Determination from Satellite Dynamics, Springer, 2012.
+ *
+ */
+
+#ifndef TUDAT_PANELLED_DRAG_ACCELERATION_H
+#define TUDAT_PANELLED_DRAG_ACCELERATION_H
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Astrodynamics/SystemModels/panelledSurfaceModel.h"
+
+namespace tudat
+{
+namespace aerodynamics
+{
+
+//! Compute free molecular flow drag force on a panelled surface.
+/*!
+ * Computes the free molecular flow drag force on a panelled surface, summing the contributions of all panels that are
+ * exposed to the flow. A hyperthermal flow is assumed (thermal velocity of the atmospheric particles is neglected
+ * w.r.t. the airspeed), and the velocity of the re-emitted particles is neglected, so that the force on a single panel
+ * becomes -rho V^2 A cos( theta ) [ sigma_t v + ( 2 - sigma_n - sigma_t ) cos( theta ) n ], with sigma_n and sigma_t
+ * the normal and tangential accommodation coefficients, v the airspeed direction and n the outward panel normal.
+ * Shielding of panels by other parts of the vehicle is not taken into account.
+ * \param density Atmospheric density.                                                          [kg/m^3]
+ * \param airspeedVelocity Velocity of the vehicle w.r.t. the atmosphere, in the body-fixed frame of the vehicle. [m/s]
+ * \param panelledSurfaceModel Panelled surface model of the vehicle.
+ * \return Drag force, in the body-fixed frame of the vehicle.                                        [N]
+ */
+Eigen::Vector3d computePanelledDragForce(
+        const double density,
+        const Eigen::Vector3d& airspeedVelocity,
+        system_models::PanelledSurfaceModel& panelledSurfaceModel );
+
+//! Panelled drag acceleration model class.
+/*!
+ * Class that can be used to compute the (free molecular flow) drag acceleration on a body of which the outer surface is
+ * described by a set of flat panels (e.g. a box-wing model), each with its own area and accommodation coefficients.
+ * The orientation of the panels is obtained from the rotation of the body, and the airspeed velocity from the
+ * body-fixed state of the body w.r.t. the central body.
+ */
+class PanelledDragAcceleration: public basic_astrodynamics::AccelerationModel3d
+{
+private:
+
+    //! Typedef for double-returning function.
+    typedef boost::function< double( ) > DoubleReturningFunction;
+
+    //! Typedef for quaternion-returning function.
+    typedef boost::function< Eigen::Quaterniond( ) > QuaternionReturningFunction;
+
+public:
+
+    // Ensure that correctly aligned pointers are generated (Eigen, 2013).
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    //! Constructor.
+    /*!
+     * Constructor.
+     * \param densityFunction Function returning current atmospheric density.
+     * \param airspeedVelocityFunction Function returning current velocity of the vehicle w.r.t. the atmosphere, in the
+     *          body-fixed frame of the central body.
+     * \param centralBodyRotationToInertialFrameFunction Function returning current rotation from body-fixed frame of
+     *          central body to inertial frame.
+     * \param rotationToInertialFrameFunction Function returning current rotation from body-fixed frame of vehicle to
+     *          inertial frame.
+     * \param panelledSurfaceModel Panelled surface model of the vehicle.
+     * \param massFunction Function returning current mass of the vehicle.
+     */
+    PanelledDragAcceleration(
+            DoubleReturningFunction densityFunction,
+            boost::function< Eigen::Vector3d( ) > airspeedVelocityFunction,
+            QuaternionReturningFunction centralBodyRotationToInertialFrameFunction,
+            QuaternionReturningFunction rotationToInertialFrameFunction,
+            boost::shared_ptr< system_models::PanelledSurfaceModel > panelledSurfaceModel,
+            DoubleReturningFunction massFunction )
+        : densityFunction_( densityFunction ),
+          airspeedVelocityFunction_( airspeedVelocityFunction ),
+          centralBodyRotationToInertialFrameFunction_( centralBodyRotationToInertialFrameFunction ),
+          rotationToInertialFrameFunction_( rotationToInertialFrameFunction ),
+          panelledSurfaceModel_( panelledSurfaceModel ),
+          massFunction_( massFunction ){ }
+
+    //! Get drag acceleration.
+    /*!
+     * Returns the drag acceleration, computed from the current values of the variables set by the updateMembers( )
+     * function.
+     * \return Drag acceleration.
+     * \sa computePanelledDragForce().
+     */
+    Eigen::Vector3d getAcceleration( )
+    {
+        return currentRotationToInertialFrame_ * computePanelledDragForce(
+                    currentDensity_, currentAirspeedVelocityInBodyFixedFrame_, *panelledSurfaceModel_ ) /
+                currentMass_;
+    }
+
+    //! Update member variables used by the drag acceleration model.
+    /*!
+     * Updates member variables used by the acceleration model. This function evaluates all
+     * dependent variables to the 'current' values of these parameters. Only these current values,
+     * not the function-pointers are then used by the getAcceleration( ) function.
+     * \param currentTime Time at which acceleration model is to be updated.
+     */
+    void updateMembers( const double currentTime = TUDAT_NAN )
+    {
+        if( !( this->currentTime_ == currentTime ) )
+        {
+            currentRotationToInertialFrame_ = rotationToInertialFrameFunction_( );
+            currentAirspeedVelocityInBodyFixedFrame_ =
+                    currentRotationToInertialFrame_.inverse( ) *
+                    ( centralBodyRotationToInertialFrameFunction_( ) * airspeedVelocityFunction_( ) );
+            currentDensity_ = densityFunction_( );
+            currentMass_ = massFunction_( );
+            this->currentTime_ = currentTime;
+        }
+    }
+
+    //! Function to retrieve the function pointer returning mass of accelerated body.
+    /*!
+     * Function to retrieve the function pointer returning mass of accelerated body.
+     * \return Function pointer returning mass of accelerated body.
+     */
+    DoubleReturningFunction getMassFunction( )
+    {
+        return massFunction_;
+    }
+
+    //! Function to retrieve the panelled surface model of the accelerated body.
+    /*!
+     * Function to retrieve the panelled surface model of the accelerated body.
+     * \return Panelled surface model of the accelerated body.
+     */
+    boost::shared_ptr< system_models::PanelledSurfaceModel > getPanelledSurfaceModel( )
+    {
+        return panelledSurfaceModel_;
+    }
+
+    //! Function to retrieve the current airspeed velocity, in the body-fixed frame of the vehicle.
+    /*!
+     * Function to retrieve the current airspeed velocity, in the body-fixed frame of the vehicle.
+     * \return Current airspeed velocity, in the body-fixed frame of the vehicle.
+     */
+    Eigen::Vector3d getCurrentAirspeedVelocityInBodyFixedFrame( )
+    {
+        return currentAirspeedVelocityInBodyFixedFrame_;
+    }
+
+private:
+
+    //! Function returning current atmospheric density.
+    const DoubleReturningFunction densityFunction_;
+
+    //! Function returning current airspeed velocity, in the body-fixed frame of the central body.
+    const boost::function< Eigen::Vector3d( ) > airspeedVelocityFunction_;
+
+    //! Function returning current rotation from body-fixed frame of central body to inertial frame.
+    const QuaternionReturningFunction centralBodyRotationToInertialFrameFunction_;
+
+    //! Function returning current rotation from body-fixed frame of vehicle to inertial frame.
+    const QuaternionReturningFunction rotationToInertialFrameFunction_;
+
+    //! Panelled surface model of the vehicle.
+    const boost::shared_ptr< system_models::PanelledSurfaceModel > panelledSurfaceModel_;
+
+    //! Function returning current mass of the vehicle.
+    const DoubleReturningFunction massFunction_;
+
+    //! Current rotation from body-fixed frame of vehicle to inertial frame.
+    Eigen::Quaterniond currentRotationToInertialFrame_;
+
+    //! Current airspeed velocity, in the body-fixed frame of the vehicle.
+    Eigen::Vector3d currentAirspeedVelocityInBodyFixedFrame_;
+
+    //! Current atmospheric density.
+    double currentDensity_;
+
+    //! Current mass of the vehicle.
+    double currentMass_;
+};
+
+} // namespace aerodynamics
+} // namespace tudat
+
+#endif // TUDAT_PANELLED_DRAG_ACCELERATION_H
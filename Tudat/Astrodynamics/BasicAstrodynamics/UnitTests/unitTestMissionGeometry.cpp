@@ -115,6 +115,75 @@ BOOST_AUTO_TEST_CASE( testShadowFunctionForPartialShadow )
     BOOST_CHECK_CLOSE_FRACTION( 0.4547, shadowFunction, 0.001 );
 }
 
+//! Unit test for occultation pre-screening, and cylindrical and smoothed shadow functions (Sun, Earth).
+BOOST_AUTO_TEST_CASE( testShadowFunctionModels )
+{
+    const Eigen::Vector3d occultedBodyPosition = -149598000.0e3 * Eigen::Vector3d( 1.0, 0.0, 0.0 );
+    const Eigen::Vector3d occultingBodyPosition = Eigen::Vector3d( 1.0e3, -2.0e3, 5.0e2 );
+    const double occultedBodyRadius = 6.96e8; // Siedelmann 1992.
+    const double occultingBodyRadius = 6378.137e3; // WGS-84.
+
+    // Check models on circles of different radius through shadow.
+    int numberOfPenumbraPoints = 0;
+    const double angleStep = 2.0E-4;
+    for( double radius = occultingBodyRadius + 1.0E5; radius < 1.0E9; radius *= 3.0 )
+    {
+        double previousSmoothedShadowFunction = 1.0;
+        for( double angle = -1.5; angle < 1.5; angle += angleStep )
+        {
+            const Eigen::Vector3d satellitePosition = occultingBodyPosition + radius * Eigen::Vector3d(
+                        std::cos( angle ), std::sin( angle ) * std::sqrt( 0.5 ), std::sin( angle ) * std::sqrt( 0.5 ) );
+
+            const double shadowFunction = mission_geometry::computeShadowFunction(
+                        occultedBodyPosition, occultedBodyRadius, occultingBodyPosition, occultingBodyRadius,
+                        satellitePosition );
+            const double smoothedShadowFunction = mission_geometry::computeSmoothedShadowFunction(
+                        occultedBodyPosition, occultedBodyRadius, occultingBodyPosition, occultingBodyRadius,
+                        satellitePosition );
+            const bool isOccultationPossible = mission_geometry::isOccultationPossible(
+                        occultedBodyPosition, occultedBodyRadius, occultingBodyPosition, occultingBodyRadius,
+                        satellitePosition );
+
+            // Check that pre-screening only removes unoccculted points.
+            if( !isOccultationPossible )
+            {
+                BOOST_CHECK_EQUAL( shadowFunction, 1.0 );
+                BOOST_CHECK_EQUAL( smoothedShadowFunction, 1.0 );
+            }
+            if( shadowFunction < 1.0 )
+            {
+                BOOST_CHECK( isOccultationPossible );
+            }
+
+            // Check that smoothed shadow function is consistent with conical shadow function, and continuous.
+            if( shadowFunction == 1.0 || shadowFunction == 0.0 )
+            {
+                BOOST_CHECK_SMALL( smoothedShadowFunction - shadowFunction, 1.0E-15 );
+            }
+            else
+            {
+                numberOfPenumbraPoints++;
+                BOOST_CHECK_SMALL( smoothedShadowFunction - shadowFunction, 0.08 );
+            }
+            BOOST_CHECK( smoothedShadowFunction >= 0.0 && smoothedShadowFunction <= 1.0 );
+            BOOST_CHECK_SMALL( smoothedShadowFunction - previousSmoothedShadowFunction, 0.05 );
+            previousSmoothedShadowFunction = smoothedShadowFunction;
+        }
+    }
+    BOOST_CHECK( numberOfPenumbraPoints > 10 );
+
+    // Check cylindrical shadow function.
+    BOOST_CHECK_EQUAL( mission_geometry::computeCylindricalShadowFunction(
+                           occultedBodyPosition, occultingBodyPosition, occultingBodyRadius,
+                           occultingBodyPosition + Eigen::Vector3d( 1.0E9, 0.99 * occultingBodyRadius, 0.0 ) ), 0.0 );
+    BOOST_CHECK_EQUAL( mission_geometry::computeCylindricalShadowFunction(
+                           occultedBodyPosition, occultingBodyPosition, occultingBodyRadius,
+                           occultingBodyPosition + Eigen::Vector3d( 1.0E9, 0.0, 1.01 * occultingBodyRadius ) ), 1.0 );
+    BOOST_CHECK_EQUAL( mission_geometry::computeCylindricalShadowFunction(
+                           occultedBodyPosition, occultingBodyPosition, occultingBodyRadius,
+                           occultingBodyPosition + Eigen::Vector3d( -1.0E7, 0.0, 0.0 ) ), 1.0 );
+}
+
 //! Unit test for computation of radius of sphere of influence (Earth with respect to Sun).
 BOOST_AUTO_TEST_CASE( testSphereOfInfluenceEarth )
 {
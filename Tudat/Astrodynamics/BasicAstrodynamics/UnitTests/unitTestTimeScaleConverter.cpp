@@ -0,0 +1,195 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      SOFA Time Scale and Calendar Tools, IAU Standards of Fundamental Astronomy, 2016.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeScaleConverter.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace basic_astrodynamics;
+using namespace physical_constants;
+
+//! Dummy function for UT1 - TT, linear in time.
+double getDummyUt1MinusTt( const double ttSecondsSinceJ2000 )
+{
+    return -64.5 + 1.0E-8 * ttSecondsSinceJ2000;
+}
+
+BOOST_AUTO_TEST_SUITE( test_time_scale_converter )
+
+//! Test TDB - TT series and its cached interpolation.
+BOOST_AUTO_TEST_CASE( testTdbMinusTt )
+{
+    TimeScaleConverter timeScaleConverter;
+    for( int i = 0; i < 2000; i++ )
+    {
+        const double currentTime = -3.0E9 + 3.1E6 * static_cast< double >( i ) + 1234.5;
+
+        // Compare to approximate conversion, using only the main (annual) term.
+        BOOST_CHECK_SMALL( computeTdbMinusTt( currentTime ) -
+                           ( approximateConvertTTtoTDB( currentTime ) - currentTime ), 1.0E-4 );
+
+        // Compare rate to numerical derivative.
+        const double timeStep = 1000.0;
+        BOOST_CHECK_SMALL( computeTdbMinusTtRate( currentTime ) - (
+                               computeTdbMinusTt( currentTime + timeStep ) -
+                               computeTdbMinusTt( currentTime - timeStep ) ) / ( 2.0 * timeStep ), 1.0E-15 );
+
+        // Compare interpolated value to series, both when moving to new interval and in the same interval.
+        BOOST_CHECK_SMALL( timeScaleConverter.getTdbMinusTt( currentTime ) - computeTdbMinusTt( currentTime ), 1.0E-11 );
+        BOOST_CHECK_SMALL( timeScaleConverter.getTdbMinusTt( currentTime + 3600.0 ) -
+                           computeTdbMinusTt( currentTime + 3600.0 ), 1.0E-11 );
+    }
+
+    BOOST_CHECK_THROW( TimeScaleConverter( boost::function< double( const double ) >( ), 0.0 ), std::runtime_error );
+}
+
+//! Test conversions involving leap seconds.
+BOOST_AUTO_TEST_CASE( testLeapSeconds )
+{
+    TimeScaleConverter timeScaleConverter;
+
+    // Check TAI - UTC directly before and after leap second of 1 January 2017.
+    const double leapSecondUtcTime = ( 57754.0 - ( JULIAN_DAY_ON_J2000 - JULIAN_DAY_AT_0_MJD ) ) * JULIAN_DAY;
+    BOOST_CHECK_EQUAL( timeScaleConverter.getTaiMinusUtc( leapSecondUtcTime - 0.5 ), 36.0 );
+    BOOST_CHECK_EQUAL( timeScaleConverter.getTaiMinusUtc( leapSecondUtcTime ), 37.0 );
+    BOOST_CHECK_EQUAL( timeScaleConverter.getTaiMinusUtc( leapSecondUtcTime - 0.5 ), 36.0 );
+    BOOST_CHECK_EQUAL( timeScaleConverter.getTaiMinusUtc( 0.0 ), 32.0 );
+    BOOST_CHECK_EQUAL( timeScaleConverter.getTaiMinusUtc( 1.0E10 ), 37.0 );
+    BOOST_CHECK_THROW( timeScaleConverter.getTaiMinusUtc( -1.0E9 ), std::runtime_error );
+
+    // Check conversion of UTC to TAI, and back, around leap second.
+    for( int i = -5; i < 5; i++ )
+    {
+        const double utcTime = leapSecondUtcTime + 0.5 + static_cast< double >( i );
+        const double taiTime = timeScaleConverter.getCurrentTime( utc_scale, tai_scale, utcTime );
+        BOOST_CHECK_EQUAL( taiTime - utcTime, ( i < 0 ) ? 36.0 : 37.0 );
+        BOOST_CHECK_EQUAL( timeScaleConverter.getCurrentTime( tai_scale, utc_scale, taiTime ), utcTime );
+        BOOST_CHECK_SMALL( timeScaleConverter.getCurrentTime( utc_scale, tt_scale, utcTime ) - utcTime -
+                           ( TT_MINUS_TAI + ( ( i < 0 ) ? 36.0 : 37.0 ) ), 1.0E-7 );
+    }
+
+    // Check UTC at J2000 epoch (TT).
+    BOOST_CHECK_CLOSE_FRACTION( timeScaleConverter.getCurrentTime( tt_scale, utc_scale, 0.0 ), -64.184,
+                                std::numeric_limits< double >::epsilon( ) );
+}
+
+//! Test conversions against example of SOFA time scale cookbook.
+BOOST_AUTO_TEST_CASE( testSofaTimeScaleExample )
+{
+    TimeScaleConverter timeScaleConverter;
+
+    // Example epoch: 2006 January 15, 21:24:37.5 UTC (SOFA, 2016). TDB was computed for an observer at Mauna Kea,
+    // including topocentric terms of about 1 microsecond that are not included here. Tolerances for exact offsets are
+    // set by the resolution of double precision seconds since J2000.
+    const double utcTime = ( 53750.0 - ( JULIAN_DAY_ON_J2000 - JULIAN_DAY_AT_0_MJD ) ) * JULIAN_DAY +
+            21.0 * 3600.0 + 24.0 * 60.0 + 37.5;
+    const double ttTime = timeScaleConverter.getCurrentTime( utc_scale, tt_scale, utcTime );
+
+    BOOST_CHECK_SMALL( timeScaleConverter.getCurrentTime( utc_scale, tai_scale, utcTime ) - utcTime - 33.0, 1.0E-9 );
+    BOOST_CHECK_SMALL( ttTime - utcTime - 65.184, 1.0E-7 );
+    BOOST_CHECK_SMALL( timeScaleConverter.getCurrentTime( utc_scale, tcg_scale, utcTime ) - utcTime - 65.822690,
+                       1.0E-6 );
+    BOOST_CHECK_SMALL( timeScaleConverter.getCurrentTime( utc_scale, tdb_scale, utcTime ) - utcTime - 65.184373,
+                       5.0E-6 );
+    BOOST_CHECK_SMALL( timeScaleConverter.getCurrentTime( utc_scale, tcb_scale, utcTime ) - utcTime - 79.393952,
+                       5.0E-6 );
+    BOOST_CHECK_SMALL( timeScaleConverter.getCurrentTime( tt_scale, utc_scale, ttTime ) - utcTime, 1.0E-7 );
+}
+
+//! Test consistency of conversions between all time scales.
+BOOST_AUTO_TEST_CASE( testTimeScaleConversionConsistency )
+{
+    TimeScaleConverter timeScaleConverter( boost::bind( &getDummyUt1MinusTt, _1 ) );
+
+    std::vector< TimeScales > timeScales;
+    timeScales.push_back( tai_scale );
+    timeScales.push_back( tt_scale );
+    timeScales.push_back( tdb_scale );
+    timeScales.push_back( utc_scale );
+    timeScales.push_back( ut1_scale );
+    timeScales.push_back( tcb_scale );
+    timeScales.push_back( tcg_scale );
+
+    std::vector< double > testTimes;
+    testTimes.push_back( -6.0E8 );
+    testTimes.push_back( 1.0E3 );
+    testTimes.push_back( 5.4E8 );
+    testTimes.push_back( 1.5E9 );
+
+    for( unsigned int i = 0; i < testTimes.size( ); i++ )
+    {
+        // Check offsets from TT against direct computations.
+        const double ttTime = testTimes.at( i );
+        const double tdbTime = timeScaleConverter.getCurrentTime( tt_scale, tdb_scale, ttTime );
+        BOOST_CHECK_SMALL( tdbTime - ttTime - computeTdbMinusTt( ttTime ), 1.0E-6 );
+        BOOST_CHECK_SMALL( timeScaleConverter.getCurrentTime( tt_scale, tcb_scale, ttTime ) -
+                           convertTdbToTcb< double >( tdbTime ), 1.0E-6 );
+        BOOST_CHECK_SMALL( timeScaleConverter.getCurrentTime( tt_scale, tcg_scale, ttTime ) -
+                           convertTtToTcg< double >( ttTime ), 1.0E-6 );
+        BOOST_CHECK_SMALL( timeScaleConverter.getCurrentTime( tt_scale, ut1_scale, ttTime ) - ttTime -
+                           getDummyUt1MinusTt( ttTime ), 1.0E-6 );
+
+        for( unsigned int j = 0; j < timeScales.size( ); j++ )
+        {
+            for( unsigned int k = 0; k < timeScales.size( ); k++ )
+            {
+                // Check that conversion is consistent with conversion through TT.
+                const double inputTime = timeScaleConverter.getCurrentTime( tt_scale, timeScales.at( j ), ttTime );
+                const double outputTime = timeScaleConverter.getCurrentTime(
+                            timeScales.at( j ), timeScales.at( k ), inputTime );
+                BOOST_CHECK_SMALL( outputTime - timeScaleConverter.getCurrentTime(
+                                       tt_scale, timeScales.at( k ), ttTime ), 1.0E-6 );
+
+                // Check round trip with double and Time representation.
+                BOOST_CHECK_SMALL( timeScaleConverter.getCurrentTime(
+                                       timeScales.at( k ), timeScales.at( j ), outputTime ) - inputTime, 1.0E-6 );
+
+                const Time inputTimeObject = Time( static_cast< int >( std::floor( inputTime / 3600.0 ) ), 1234.567890123L );
+                const Time outputTimeObject = timeScaleConverter.getCurrentTime(
+                            timeScales.at( j ), timeScales.at( k ), inputTimeObject );
+                const Time roundTripTimeObject = timeScaleConverter.getCurrentTime(
+                            timeScales.at( k ), timeScales.at( j ), outputTimeObject );
+                BOOST_CHECK_SMALL( static_cast< double >( roundTripTimeObject - inputTimeObject ), 1.0E-13 );
+                BOOST_CHECK_SMALL( static_cast< double >( outputTimeObject - inputTimeObject ) - (
+                                       timeScaleConverter.getCurrentTime(
+                                           timeScales.at( j ), timeScales.at( k ),
+                                           static_cast< double >( inputTimeObject ) ) -
+                                       static_cast< double >( inputTimeObject ) ), 1.0E-6 );
+            }
+        }
+    }
+
+    // Check that UT1 conversions are not possible without UT1 - TT function.
+    TimeScaleConverter timeScaleConverterWithoutUt1;
+    BOOST_CHECK_THROW( timeScaleConverterWithoutUt1.getCurrentTime( tt_scale, ut1_scale, 0.0 ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -50,6 +50,12 @@ std::string getAccelerationModelName( const AvailableAcceleration accelerationTy
     case thrust_acceleration:
         accelerationName = "thrust ";
         break;
+    case panelled_radiation_pressure:
+        accelerationName = "panelled radiation pressure ";
+        break;
+    case panelled_drag:
+        accelerationName = "panelled drag ";
+        break;
     default:
         std::string errorMessage = "Error, acceleration type " +
                 boost::lexical_cast< std::string >( accelerationType ) +
@@ -106,6 +112,16 @@ AvailableAcceleration getAccelerationModelType(
     {
         accelerationType = thrust_acceleration;
     }
+    else if( boost::dynamic_pointer_cast< PanelledRadiationPressureAcceleration >(
+                 accelerationModel ) != NULL )
+    {
+        accelerationType = panelled_radiation_pressure;
+    }
+    else if( boost::dynamic_pointer_cast< PanelledDragAcceleration >(
+                 accelerationModel ) != NULL )
+    {
+        accelerationType = panelled_drag;
+    }
     else
     {
         throw std::runtime_error(
@@ -13,11 +13,13 @@
 #define TUDAT_ACCELERATIONMODELTYPES_H
 
 #include "Tudat/Astrodynamics/ElectroMagnetism/cannonBallRadiationPressureAcceleration.h"
+#include "Tudat/Astrodynamics/ElectroMagnetism/panelledRadiationPressureAcceleration.h"
 #include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/mutualSphericalHarmonicGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/thirdBodyPerturbation.h"
 #include "Tudat/Astrodynamics/Aerodynamics/aerodynamicAcceleration.h"
+#include "Tudat/Astrodynamics/Aerodynamics/panelledDragAcceleration.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/massRateModel.h"
 #include "Tudat/Astrodynamics/Propulsion/thrustAccelerationModel.h"
 #include "Tudat/Astrodynamics/Propulsion/massRateFromThrust.h"
@@ -46,7 +48,9 @@ enum AvailableAcceleration
     third_body_central_gravity,
     third_body_spherical_harmonic_gravity,
     third_body_mutual_spherical_harmonic_gravity,
-    thrust_acceleration
+    thrust_acceleration,
+    panelled_radiation_pressure,
+    panelled_drag
 };
 
 //! Function to get a string representing a 'named identification' of an acceleration type
@@ -37,6 +37,7 @@
 #include <boost/math/special_functions/asinh.hpp>
 
 #include <cmath>
+#include <stdexcept>
 
 #include "Tudat/Mathematics/RootFinders/newtonRaphson.h"
 #include "Tudat/Mathematics/RootFinders/rootFinder.h"
@@ -44,7 +45,7 @@
 #include "Tudat/Mathematics/RootFinders/terminationConditions.h"
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
 #include "Tudat/Mathematics/BasicMathematics/basicMathematicsFunctions.h"
-#include "Tudat/Mathematics/BasicMathematics/functionProxy.h"
+#include "Tudat/Mathematics/BasicMathematics/function.h"
 
 namespace tudat
 {
@@ -136,6 +137,190 @@ ScalarType computeFirstDerivativeKeplersFunctionForHyperbolicOrbits(
     return eccentricity * std::cosh( hyperbolicEccentricAnomaly ) - 1.0;
 }
 
+//! Kepler's function for elliptical orbits, as root function.
+/*!
+ * Kepler's function for elliptical orbits, and its first derivative, as root function for the
+ * root-finders (\sa computeKeplersFunctionForEllipticalOrbits). The eccentricity and mean anomaly
+ * can be reset, so that a single object can be reused for many conversions without allocating
+ * memory.
+ */
+template< typename ScalarType = double >
+class KeplersFunctionForEllipticalOrbits:
+        public basic_mathematics::Function< ScalarType, ScalarType >
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor.
+     * \param eccentricity Eccentricity.
+     * \param meanAnomaly Mean anomaly.
+     */
+    KeplersFunctionForEllipticalOrbits( const ScalarType eccentricity,
+                                        const ScalarType meanAnomaly ):
+        eccentricity_( eccentricity ), meanAnomaly_( meanAnomaly )
+    { }
+
+    //! Function to reset the eccentricity and mean anomaly.
+    /*!
+     * Function to reset the eccentricity and mean anomaly.
+     * \param eccentricity Eccentricity.
+     * \param meanAnomaly Mean anomaly.
+     */
+    void resetParameters( const ScalarType eccentricity, const ScalarType meanAnomaly )
+    {
+        eccentricity_ = eccentricity;
+        meanAnomaly_ = meanAnomaly;
+    }
+
+    //! Evaluate Kepler's function.
+    /*!
+     * Evaluates Kepler's function for elliptical orbits.
+     * \param inputValue Eccentric anomaly.
+     * \return Value of Kepler's function for elliptical orbits.
+     */
+    ScalarType evaluate( const ScalarType inputValue )
+    {
+        return computeKeplersFunctionForEllipticalOrbits< ScalarType >(
+                    inputValue, eccentricity_, meanAnomaly_ );
+    }
+
+    //! Evaluate the first derivative of Kepler's function.
+    /*!
+     * Evaluates the first derivative of Kepler's function for elliptical orbits. Higher-order
+     * derivatives are not available.
+     * \param order Order of the derivative (must be 1).
+     * \param independentVariable Eccentric anomaly.
+     * \return Value of first-derivative of Kepler's function for elliptical orbits.
+     */
+    ScalarType computeDerivative( const unsigned int order, const ScalarType independentVariable )
+    {
+        if( order != 1 )
+        {
+            throw std::runtime_error( "Error in Kepler's function for elliptical orbits, only the "
+                                      "first derivative is available." );
+        }
+        return computeFirstDerivativeKeplersFunctionForEllipticalOrbits< ScalarType >(
+                    independentVariable, eccentricity_ );
+    }
+
+    //! Evaluate the definite integral of Kepler's function (not available).
+    /*!
+     * The definite integral of Kepler's function is not available, this function throws an
+     * exception.
+     * \param order Order of the integral.
+     * \param lowerBound Integration lower bound.
+     * \param upperbound Integration upper bound.
+     * \return Nothing, an exception is thrown.
+     */
+    ScalarType computeDefiniteIntegral( const unsigned int order, const ScalarType lowerBound,
+                                        const ScalarType upperbound )
+    {
+        throw std::runtime_error( "Error in Kepler's function for elliptical orbits, integral is "
+                                  "not available." );
+    }
+
+private:
+
+    //! Eccentricity.
+    ScalarType eccentricity_;
+
+    //! Mean anomaly.
+    ScalarType meanAnomaly_;
+};
+
+//! Kepler's function for hyperbolic orbits, as root function.
+/*!
+ * Kepler's function for hyperbolic orbits, and its first derivative, as root function for the
+ * root-finders (\sa computeKeplersFunctionForHyperbolicOrbits). The eccentricity and mean anomaly
+ * can be reset, so that a single object can be reused for many conversions without allocating
+ * memory.
+ */
+template< typename ScalarType = double >
+class KeplersFunctionForHyperbolicOrbits:
+        public basic_mathematics::Function< ScalarType, ScalarType >
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor.
+     * \param eccentricity Eccentricity.
+     * \param meanAnomaly Hyperbolic mean anomaly.
+     */
+    KeplersFunctionForHyperbolicOrbits( const ScalarType eccentricity,
+                                        const ScalarType meanAnomaly ):
+        eccentricity_( eccentricity ), meanAnomaly_( meanAnomaly )
+    { }
+
+    //! Function to reset the eccentricity and mean anomaly.
+    /*!
+     * Function to reset the eccentricity and mean anomaly.
+     * \param eccentricity Eccentricity.
+     * \param meanAnomaly Hyperbolic mean anomaly.
+     */
+    void resetParameters( const ScalarType eccentricity, const ScalarType meanAnomaly )
+    {
+        eccentricity_ = eccentricity;
+        meanAnomaly_ = meanAnomaly;
+    }
+
+    //! Evaluate Kepler's function.
+    /*!
+     * Evaluates Kepler's function for hyperbolic orbits.
+     * \param inputValue Hyperbolic eccentric anomaly.
+     * \return Value of Kepler's function for hyperbolic orbits.
+     */
+    ScalarType evaluate( const ScalarType inputValue )
+    {
+        return computeKeplersFunctionForHyperbolicOrbits< ScalarType >(
+                    inputValue, eccentricity_, meanAnomaly_ );
+    }
+
+    //! Evaluate the first derivative of Kepler's function.
+    /*!
+     * Evaluates the first derivative of Kepler's function for hyperbolic orbits. Higher-order
+     * derivatives are not available.
+     * \param order Order of the derivative (must be 1).
+     * \param independentVariable Hyperbolic eccentric anomaly.
+     * \return Value of first-derivative of Kepler's function for hyperbolic orbits.
+     */
+    ScalarType computeDerivative( const unsigned int order, const ScalarType independentVariable )
+    {
+        if( order != 1 )
+        {
+            throw std::runtime_error( "Error in Kepler's function for hyperbolic orbits, only the "
+                                      "first derivative is available." );
+        }
+        return computeFirstDerivativeKeplersFunctionForHyperbolicOrbits< ScalarType >(
+                    independentVariable, eccentricity_ );
+    }
+
+    //! Evaluate the definite integral of Kepler's function (not available).
+    /*!
+     * The definite integral of Kepler's function is not available, this function throws an
+     * exception.
+     * \param order Order of the integral.
+     * \param lowerBound Integration lower bound.
+     * \param upperbound Integration upper bound.
+     * \return Nothing, an exception is thrown.
+     */
+    ScalarType computeDefiniteIntegral( const unsigned int order, const ScalarType lowerBound,
+                                        const ScalarType upperbound )
+    {
+        throw std::runtime_error( "Error in Kepler's function for hyperbolic orbits, integral is "
+                                  "not available." );
+    }
+
+private:
+
+    //! Eccentricity.
+    ScalarType eccentricity_;
+
+    //! Hyperbolic mean anomaly.
+    ScalarType meanAnomaly_;
+};
+
 //! Convert mean anomaly to eccentric anomaly.
 /*!
  * Converts mean anomaly to eccentric anomaly for elliptical orbits for all eccentricities >=
@@ -199,17 +384,13 @@ ScalarType convertMeanAnomalyToEccentricAnomaly(
     if ( eccentricity < getFloatingInteger< ScalarType >( 1 ) &&
          eccentricity >= getFloatingInteger< ScalarType >( 0 ) )
     {
-        // Create an object containing the function of which we whish to obtain the root from.
-        boost::shared_ptr< basic_mathematics::FunctionProxy< ScalarType, ScalarType > > rootFunction
-                = boost::make_shared< basic_mathematics::FunctionProxy< ScalarType, ScalarType >  >(
-                    boost::bind( &computeKeplersFunctionForEllipticalOrbits< ScalarType >, _1,
-                                 eccentricity, meanAnomaly ) );
-
-        // Add the first derivative of the root function.
-        rootFunction->addBinding(
-                    -1, boost::bind(
-                        &computeFirstDerivativeKeplersFunctionForEllipticalOrbits< ScalarType >, _1,
-                        eccentricity ) );
+        // Create an object containing the function of which we whish to obtain the root from. The
+        // object is reused by each thread, so that no memory is allocated per conversion.
+        static thread_local boost::shared_ptr< KeplersFunctionForEllipticalOrbits< ScalarType > >
+                rootFunction =
+                boost::make_shared< KeplersFunctionForEllipticalOrbits< ScalarType > >(
+                    eccentricity, meanAnomaly );
+        rootFunction->resetParameters( eccentricity, meanAnomaly );
 
         // Declare initial guess.
         ScalarType initialGuess = TUDAT_NAN;
@@ -338,17 +519,13 @@ ScalarType convertMeanAnomalyToHyperbolicEccentricAnomaly(
     // Check if orbit is hyperbolic.
     if ( eccentricity > getFloatingInteger< ScalarType >( 1 ) )
     {
-        // Create an object containing the function of which we whish to obtain the root from.
-        boost::shared_ptr< basic_mathematics::FunctionProxy< ScalarType, ScalarType > > rootFunction
-                = boost::make_shared< basic_mathematics::FunctionProxy< ScalarType, ScalarType > >(
-                    boost::bind( &computeKeplersFunctionForHyperbolicOrbits< ScalarType >, _1,
-                                 eccentricity, hyperbolicMeanAnomaly ) );
-
-        // Add the first derivative of the root function.
-        rootFunction->addBinding(
-                    -1, boost::bind(
-                        &computeFirstDerivativeKeplersFunctionForHyperbolicOrbits< ScalarType >,
-                        _1, eccentricity ) );
+        // Create an object containing the function of which we whish to obtain the root from. The
+        // object is reused by each thread, so that no memory is allocated per conversion.
+        static thread_local boost::shared_ptr< KeplersFunctionForHyperbolicOrbits< ScalarType > >
+                rootFunction =
+                boost::make_shared< KeplersFunctionForHyperbolicOrbits< ScalarType > >(
+                    eccentricity, hyperbolicMeanAnomaly );
+        rootFunction->resetParameters( eccentricity, hyperbolicMeanAnomaly );
 
         // Declare initial guess.
         ScalarType initialGuess = TUDAT_NAN;
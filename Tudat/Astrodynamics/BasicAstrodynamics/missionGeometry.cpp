@@ -14,6 +14,7 @@
  */
 
 #include <Eigen/Core>
+#include <algorithm>
 #include <cmath>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/missionGeometry.h"
@@ -145,6 +146,108 @@ double computeShadowFunction( const Eigen::Vector3d& occultedBodyPosition,
     return shadowFunction;
 }
 
+//! Check whether an occulting body can (partially) block an occulted body as seen from a satellite.
+bool isOccultationPossible( const Eigen::Vector3d& occultedBodyPosition,
+                            const double occultedBodyRadius,
+                            const Eigen::Vector3d& occultingBodyPosition,
+                            const double occultingBodyRadius,
+                            const Eigen::Vector3d& satellitePosition )
+{
+    // Calculate vectors from satellite to both bodies.
+    const Eigen::Vector3d occultedBodyRelativePosition = occultedBodyPosition - satellitePosition;
+    const Eigen::Vector3d occultingBodyRelativePosition = occultingBodyPosition - satellitePosition;
+
+    // Calculate distance of occulting body along, and perpendicular to, direction of occulted body.
+    const double occultedBodyDistanceSquared = occultedBodyRelativePosition.squaredNorm( );
+    const double occultedBodyDistance = std::sqrt( occultedBodyDistanceSquared );
+    const double axialDistance = occultingBodyRelativePosition.dot( occultedBodyRelativePosition ) /
+            occultedBodyDistance;
+
+    // Occulting body behind satellite (as seen from occulted body).
+    if( axialDistance <= 0.0 )
+    {
+        return ( occultingBodyRelativePosition.squaredNorm( ) < occultingBodyRadius * occultingBodyRadius );
+    }
+
+    // Check whether occulting body intersects cone enclosing occulted body (with half-angle alpha):
+    // perpendicularDistance < axialDistance * tan( alpha ) + occultingBodyRadius / cos( alpha ).
+    const double coneBaseDistance = std::sqrt( occultedBodyDistanceSquared - occultedBodyRadius * occultedBodyRadius );
+    const double perpendicularDistanceSquared =
+            occultingBodyRelativePosition.squaredNorm( ) - axialDistance * axialDistance;
+    const double maximumPerpendicularDistance =
+            ( axialDistance * occultedBodyRadius + occultingBodyRadius * occultedBodyDistance ) / coneBaseDistance;
+
+    return ( perpendicularDistanceSquared < maximumPerpendicularDistance * maximumPerpendicularDistance );
+}
+
+//! Compute the shadow function for a cylindrical shadow model.
+double computeCylindricalShadowFunction( const Eigen::Vector3d& occultedBodyPosition,
+                                         const Eigen::Vector3d& occultingBodyPosition,
+                                         const double occultingBodyRadius,
+                                         const Eigen::Vector3d& satellitePosition )
+{
+    // Calculate coordinates of the spacecraft with respect to the occulting body, and direction to occulted body.
+    const Eigen::Vector3d satellitePositionRelativeToOccultingBody = satellitePosition - occultingBodyPosition;
+    const Eigen::Vector3d occultedBodyDirection = ( occultedBodyPosition - occultingBodyPosition ).normalized( );
+
+    // Check if satellite is behind occulting body, and within shadow cylinder.
+    const double axialDistance = satellitePositionRelativeToOccultingBody.dot( occultedBodyDirection );
+    double shadowFunction = 1.0;
+    if( axialDistance < 0.0 &&
+            ( satellitePositionRelativeToOccultingBody - axialDistance * occultedBodyDirection ).norm( ) <
+            occultingBodyRadius )
+    {
+        shadowFunction = 0.0;
+    }
+
+    return shadowFunction;
+}
+
+//! Compute a smoothed shadow function.
+double computeSmoothedShadowFunction( const Eigen::Vector3d& occultedBodyPosition,
+                                      const double occultedBodyRadius,
+                                      const Eigen::Vector3d& occultingBodyPosition,
+                                      const double occultingBodyRadius,
+                                      const Eigen::Vector3d& satellitePosition )
+{
+    // Calculate vectors from satellite to both bodies.
+    const Eigen::Vector3d occultedBodyRelativePosition = occultedBodyPosition - satellitePosition;
+    const Eigen::Vector3d occultingBodyRelativePosition = occultingBodyPosition - satellitePosition;
+
+    // Calculate apparent radii and separation of both bodies.
+    const double occultedBodyApparentRadius =
+            std::asin( occultedBodyRadius / occultedBodyRelativePosition.norm( ) );
+    const double occultingBodyApparentRadius =
+            std::asin( occultingBodyRadius / occultingBodyRelativePosition.norm( ) );
+    const double apparentSeparation = std::acos(
+                std::max( -1.0, std::min( 1.0, occultedBodyRelativePosition.normalized( ).dot(
+                                              occultingBodyRelativePosition.normalized( ) ) ) ) );
+
+    // Calculate (normalized) depth into penumbra: 0 at first contact, 1 at start of umbra/antumbra.
+    const double penumbraDepth = ( occultedBodyApparentRadius + occultingBodyApparentRadius - apparentSeparation ) /
+            ( 2.0 * std::min( occultedBodyApparentRadius, occultingBodyApparentRadius ) );
+
+    double shadowFunction = 1.0;
+    if( penumbraDepth > 0.0 )
+    {
+        // Calculate maximum occulted fraction (1 for total occultation, area ratio for annular occultation).
+        const double apparentRadiusRatio = occultingBodyApparentRadius / occultedBodyApparentRadius;
+        const double maximumOccultedFraction = std::min( 1.0, apparentRadiusRatio * apparentRadiusRatio );
+
+        if( penumbraDepth >= 1.0 )
+        {
+            shadowFunction = 1.0 - maximumOccultedFraction;
+        }
+        else
+        {
+            shadowFunction = 1.0 - maximumOccultedFraction * penumbraDepth * penumbraDepth *
+                    ( 3.0 - 2.0 * penumbraDepth );
+        }
+    }
+
+    return shadowFunction;
+}
+
 double computeSphereOfInfluence( const double distanceToCentralBody,
                                  const double ratioOfOrbitingToCentralBodyMass )
 {
@@ -81,6 +81,71 @@ double computeShadowFunction( const Eigen::Vector3d& occultedBodyPosition,
                               const double occultingBodyRadius,
                               const Eigen::Vector3d& satellitePosition );
 
+//! Check whether an occulting body can (partially) block an occulted body as seen from a satellite.
+/*!
+ * Checks whether the occulting body intersects the cone with its apex at the satellite, that
+ * encloses the occulted body (i.e. whether the satellite is inside the penumbral cone). This test
+ * is equivalent to checking whether the apparent separation of both bodies is smaller than the sum
+ * of their apparent radii, but requires no trigonometric functions, so that it can be used as an
+ * inexpensive pre-screening of occultations. If this function returns false, the shadow function
+ * is exactly 1.
+ *
+ * \param occultedBodyPosition Vector containing Cartesian coordinates of the occulted body.
+ * \param occultedBodyRadius Mean radius of occulted body.
+ * \param occultingBodyPosition Vector containing Cartesian coordinates of the occulting body.
+ * \param occultingBodyRadius Mean radius of occulting body.
+ * \param satellitePosition Vector containing Cartesian coordinates of the satellite.
+ * \return True if (partial) occultation can take place, false if not.
+ */
+bool isOccultationPossible( const Eigen::Vector3d& occultedBodyPosition,
+                            const double occultedBodyRadius,
+                            const Eigen::Vector3d& occultingBodyPosition,
+                            const double occultingBodyRadius,
+                            const Eigen::Vector3d& satellitePosition );
+
+//! Compute the shadow function for a cylindrical shadow model.
+/*!
+ * Returns the value of the shadow function for a cylindrical shadow model, in which the occulted
+ * body is assumed to be at infinite distance, and no penumbra exists. Returns 0 if the satellite is
+ * behind the occulting body, within the cylinder with the radius of the occulting body, and 1
+ * otherwise.
+ *
+ * Reference: Section 3.4.2 from ( Montebruck O, Gill E., 2005).
+ *
+ * \param occultedBodyPosition Vector containing Cartesian coordinates of the occulted body.
+ * \param occultingBodyPosition Vector containing Cartesian coordinates of the occulting body.
+ * \param occultingBodyRadius Mean radius of occulting body.
+ * \param satellitePosition Vector containing Cartesian coordinates of the satellite.
+ * \return Shadow function value.
+ */
+double computeCylindricalShadowFunction( const Eigen::Vector3d& occultedBodyPosition,
+                                         const Eigen::Vector3d& occultingBodyPosition,
+                                         const double occultingBodyRadius,
+                                         const Eigen::Vector3d& satellitePosition );
+
+//! Compute a smoothed shadow function.
+/*!
+ * Returns the value of a smoothed conical shadow function. The umbra/antumbra and full-light
+ * regions are identical to those of computeShadowFunction, but the occulted fraction in the
+ * penumbra is modelled by a cubic (smoothstep) function of the apparent separation, which is
+ * continuously differentiable at the penumbra boundaries. This prevents the step-size control of
+ * an integrator from repeatedly rejecting steps at shadow boundaries, at the expense of an error
+ * of up to about 0.07 in the shadow function inside the (short) penumbra. In the antumbra
+ * (annular occultation) the shadow function equals one minus the ratio of the apparent areas.
+ *
+ * \param occultedBodyPosition Vector containing Cartesian coordinates of the occulted body.
+ * \param occultedBodyRadius Mean radius of occulted body.
+ * \param occultingBodyPosition Vector containing Cartesian coordinates of the occulting body.
+ * \param occultingBodyRadius Mean radius of occulting body.
+ * \param satellitePosition Vector containing Cartesian coordinates of the satellite.
+ * \return Shadow function value.
+ */
+double computeSmoothedShadowFunction( const Eigen::Vector3d& occultedBodyPosition,
+                                      const double occultedBodyRadius,
+                                      const Eigen::Vector3d& occultingBodyPosition,
+                                      const double occultingBodyRadius,
+                                      const Eigen::Vector3d& satellitePosition );
+
 //! Compute the radius of the sphere of influence.
 /*!
  * Returns the radius of the the Sphere of Influence (SOI) for a body orbiting a central body.
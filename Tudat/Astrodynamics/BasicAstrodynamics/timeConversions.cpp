@@ -9,6 +9,9 @@
  *
  */
 
+#include <algorithm>
+#include <stdexcept>
+
 #include <boost/date_time/gregorian/gregorian.hpp>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
@@ -256,6 +259,37 @@ double approximateConvertTTtoTDB( const double ttSecondsSinceJ2000 )
     return ttSecondsSinceJ2000 + 0.001657  * std::sin( 628.3076 * ttCenturiesSinceJ2000 + 6.2401 );
 }
 
+//! Function to retrieve the UTC dates at which the number of leap seconds changed.
+const std::vector< double >& getLeapSecondModifiedJulianDays( )
+{
+    // Modified Julian days at which leap seconds were introduced (first entry is start of integer leap seconds), with
+    // TAI - UTC after first entry equal to 10 seconds, incremented by 1 second for each subsequent entry.
+    static const double leapSecondModifiedJulianDays[ ] =
+    { 41317.0, 41499.0, 41683.0, 42048.0, 42413.0, 42778.0, 43144.0, 43509.0, 43874.0, 44239.0, 44786.0, 45151.0,
+      45516.0, 46247.0, 47161.0, 47892.0, 48257.0, 48804.0, 49169.0, 49534.0, 50083.0, 50630.0, 51179.0, 53736.0,
+      54832.0, 56109.0, 57204.0, 57754.0 };
+    static const std::vector< double > leapSecondModifiedJulianDaysVector(
+                leapSecondModifiedJulianDays,
+                leapSecondModifiedJulianDays + sizeof( leapSecondModifiedJulianDays ) / sizeof( double ) );
+    return leapSecondModifiedJulianDaysVector;
+}
+
+//! Function to retrieve the difference between TAI and UTC at a given UTC date.
+double getTaiMinusUtc( const double utcModifiedJulianDay )
+{
+    const std::vector< double >& leapSecondModifiedJulianDays = getLeapSecondModifiedJulianDays( );
+    if( utcModifiedJulianDay < leapSecondModifiedJulianDays.front( ) )
+    {
+        throw std::runtime_error( "Error when retrieving TAI - UTC, only dates from 1972 onwards are supported." );
+    }
+
+    // Find number of leap seconds introduced after first entry.
+    int numberOfLeapSeconds = static_cast< int >(
+                std::upper_bound( leapSecondModifiedJulianDays.begin( ), leapSecondModifiedJulianDays.end( ),
+                                  utcModifiedJulianDay ) - leapSecondModifiedJulianDays.begin( ) ) - 1;
+
+    return 10.0 + static_cast< double >( numberOfLeapSeconds );
+}
 
 } // namespace basic_astrodynamics
 } // namespace tudat
@@ -12,6 +12,8 @@
 #ifndef TUDAT_TIME_CONVERSIONS_H
 #define TUDAT_TIME_CONVERSIONS_H
 
+#include <vector>
+
 #include "boost/date_time/gregorian/gregorian.hpp"
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
@@ -426,6 +428,24 @@ TimeType convertTTtoTAI( const TimeType ttTime )
  */
 double approximateConvertTTtoTDB( const double ttSecondsSinceJ2000);
 
+//! Function to retrieve the UTC dates at which the number of leap seconds changed.
+/*!
+ * Function to retrieve the UTC dates at which the number of leap seconds changed, with the first entry the start of
+ * integer leap seconds (1 January 1972, with TAI - UTC = 10 s). Each subsequent entry increments TAI - UTC by 1 s.
+ * \return UTC dates (as modified Julian days) at which the number of leap seconds changed, in ascending order.
+ */
+const std::vector< double >& getLeapSecondModifiedJulianDays( );
+
+//! Function to retrieve the difference between TAI and UTC at a given UTC date.
+/*!
+ * Function to retrieve the difference between TAI and UTC (i.e. the accumulated number of leap seconds) at a given UTC
+ * date. Only dates from 1972 onwards (when UTC started using integer leap seconds) are supported. The table of leap
+ * seconds is complete up to the leap second of 1 January 2017.
+ * \param utcModifiedJulianDay UTC date, as modified Julian day.
+ * \return TAI - UTC in seconds at given date.
+ */
+double getTaiMinusUtc( const double utcModifiedJulianDay );
+
 
 } // namespace basic_astrodynamics
 } // tudat
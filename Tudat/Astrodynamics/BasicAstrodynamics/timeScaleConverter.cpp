@@ -0,0 +1,279 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Fairhead, L. and Bretagnon, P., An analytical formula for the time transformation TB-TT, Astronomy and
+ *          Astrophysics 229, 240-247, 1990.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeScaleConverter.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace basic_astrodynamics
+{
+
+//! Number of terms of the Fairhead and Bretagnon (1990) series that are used, with a constant amplitude.
+static const int NUMBER_OF_CONSTANT_AMPLITUDE_TDB_TERMS = 12;
+
+//! Amplitude (s), frequency (rad/Julian millennium) and phase (rad) of the leading terms of the Fairhead and Bretagnon
+//! (1990) series, with a constant amplitude.
+static const double CONSTANT_AMPLITUDE_TDB_TERMS[ NUMBER_OF_CONSTANT_AMPLITUDE_TDB_TERMS ][ 3 ] =
+{
+    { 1656.674564E-6, 6283.075849991, 6.240054195 },
+    { 22.417471E-6, 5753.384884897, 4.296977442 },
+    { 13.839792E-6, 12566.151699983, 6.196904410 },
+    { 4.770086E-6, 529.690965095, 0.444401603 },
+    { 4.676740E-6, 6069.776754553, 4.021195093 },
+    { 2.256707E-6, 213.299095438, 5.543113262 },
+    { 1.694205E-6, -3.523118349, 5.025132748 },
+    { 1.554905E-6, 77713.771467920, 5.198467090 },
+    { 1.276839E-6, 7860.419392439, 5.988822341 },
+    { 1.193379E-6, 5223.693919802, 3.649823730 },
+    { 1.115322E-6, 3930.209696220, 1.422745069 },
+    { 0.794185E-6, 11506.769769794, 2.841062830 }
+};
+
+//! Amplitude (s/Julian millennium), frequency (rad/Julian millennium) and phase (rad) of the leading term of the
+//! Fairhead and Bretagnon (1990) series, with an amplitude linear in time.
+static const double LINEAR_AMPLITUDE_TDB_TERM[ 3 ] = { 102.156724E-6, 6283.075849991, 4.249032005 };
+
+//! Number of seconds in a Julian millennium.
+static const double SECONDS_PER_JULIAN_MILLENNIUM = 1000.0 * physical_constants::JULIAN_YEAR;
+
+//! Function to compute TDB - TT at the geocenter from a truncated analytical series.
+double computeTdbMinusTt( const double ttSecondsSinceJ2000 )
+{
+    const double millenniaSinceJ2000 = ttSecondsSinceJ2000 / SECONDS_PER_JULIAN_MILLENNIUM;
+
+    double tdbMinusTt = millenniaSinceJ2000 * LINEAR_AMPLITUDE_TDB_TERM[ 0 ] * std::sin(
+                LINEAR_AMPLITUDE_TDB_TERM[ 1 ] * millenniaSinceJ2000 + LINEAR_AMPLITUDE_TDB_TERM[ 2 ] );
+    for( int i = 0; i < NUMBER_OF_CONSTANT_AMPLITUDE_TDB_TERMS; i++ )
+    {
+        tdbMinusTt += CONSTANT_AMPLITUDE_TDB_TERMS[ i ][ 0 ] * std::sin(
+                    CONSTANT_AMPLITUDE_TDB_TERMS[ i ][ 1 ] * millenniaSinceJ2000 + CONSTANT_AMPLITUDE_TDB_TERMS[ i ][ 2 ] );
+    }
+    return tdbMinusTt;
+}
+
+//! Function to compute the time derivative of TDB - TT at the geocenter, from a truncated analytical series.
+double computeTdbMinusTtRate( const double ttSecondsSinceJ2000 )
+{
+    const double millenniaSinceJ2000 = ttSecondsSinceJ2000 / SECONDS_PER_JULIAN_MILLENNIUM;
+
+    const double linearTermArgument =
+            LINEAR_AMPLITUDE_TDB_TERM[ 1 ] * millenniaSinceJ2000 + LINEAR_AMPLITUDE_TDB_TERM[ 2 ];
+    double tdbMinusTtRate = LINEAR_AMPLITUDE_TDB_TERM[ 0 ] * (
+                std::sin( linearTermArgument ) +
+                millenniaSinceJ2000 * LINEAR_AMPLITUDE_TDB_TERM[ 1 ] * std::cos( linearTermArgument ) );
+    for( int i = 0; i < NUMBER_OF_CONSTANT_AMPLITUDE_TDB_TERMS; i++ )
+    {
+        tdbMinusTtRate += CONSTANT_AMPLITUDE_TDB_TERMS[ i ][ 0 ] * CONSTANT_AMPLITUDE_TDB_TERMS[ i ][ 1 ] * std::cos(
+                    CONSTANT_AMPLITUDE_TDB_TERMS[ i ][ 1 ] * millenniaSinceJ2000 + CONSTANT_AMPLITUDE_TDB_TERMS[ i ][ 2 ] );
+    }
+    return tdbMinusTtRate / SECONDS_PER_JULIAN_MILLENNIUM;
+}
+
+//! Constructor.
+TimeScaleConverter::TimeScaleConverter( const boost::function< double( const double ) > ut1MinusTtFunction,
+                                        const double tdbMinusTtInterpolationStep ):
+    ut1MinusTtFunction_( ut1MinusTtFunction ),
+    tdbMinusTtInterpolationStep_( tdbMinusTtInterpolationStep ),
+    currentTdbIntervalStartTime_( TUDAT_NAN ),
+    currentLeapSecondIntervalStartTime_( TUDAT_NAN ),
+    currentLeapSecondIntervalEndTime_( TUDAT_NAN ),
+    currentTaiMinusUtc_( TUDAT_NAN ),
+    currentUt1Time_( TUDAT_NAN ),
+    currentUt1MinusTt_( TUDAT_NAN )
+{
+    if( !( tdbMinusTtInterpolationStep_ > 0.0 ) )
+    {
+        throw std::runtime_error( "Error when creating time scale converter, interpolation step must be positive." );
+    }
+}
+
+//! Function to retrieve TDB - TT, using the cached interpolation of the analytical series.
+double TimeScaleConverter::getTdbMinusTt( const double ttSecondsSinceJ2000 )
+{
+    double normalizedTimeInInterval =
+            ( ttSecondsSinceJ2000 - currentTdbIntervalStartTime_ ) / tdbMinusTtInterpolationStep_;
+
+    // Evaluate series at nodes of new interval if requested time is outside current interval.
+    if( !( normalizedTimeInInterval >= 0.0 && normalizedTimeInInterval <= 1.0 ) )
+    {
+        currentTdbIntervalStartTime_ =
+                std::floor( ttSecondsSinceJ2000 / tdbMinusTtInterpolationStep_ ) * tdbMinusTtInterpolationStep_;
+        for( unsigned int i = 0; i < 2; i++ )
+        {
+            double nodeTime = currentTdbIntervalStartTime_ + static_cast< double >( i ) * tdbMinusTtInterpolationStep_;
+            currentTdbMinusTtNodeValues_[ i ] = computeTdbMinusTt( nodeTime );
+            currentScaledTdbMinusTtNodeRates_[ i ] = computeTdbMinusTtRate( nodeTime ) * tdbMinusTtInterpolationStep_;
+        }
+        normalizedTimeInInterval =
+                ( ttSecondsSinceJ2000 - currentTdbIntervalStartTime_ ) / tdbMinusTtInterpolationStep_;
+    }
+
+    // Evaluate cubic Hermite polynomial.
+    const double s = normalizedTimeInInterval;
+    const double sSquared = s * s;
+    const double sCubed = sSquared * s;
+    return ( 2.0 * sCubed - 3.0 * sSquared + 1.0 ) * currentTdbMinusTtNodeValues_[ 0 ] +
+            ( sCubed - 2.0 * sSquared + s ) * currentScaledTdbMinusTtNodeRates_[ 0 ] +
+            ( -2.0 * sCubed + 3.0 * sSquared ) * currentTdbMinusTtNodeValues_[ 1 ] +
+            ( sCubed - sSquared ) * currentScaledTdbMinusTtNodeRates_[ 1 ];
+}
+
+//! Function to retrieve TAI - UTC (i.e. the accumulated number of leap seconds), using the cached value if possible.
+double TimeScaleConverter::getTaiMinusUtc( const double utcSecondsSinceJ2000 )
+{
+    if( !( utcSecondsSinceJ2000 >= currentLeapSecondIntervalStartTime_ &&
+           utcSecondsSinceJ2000 < currentLeapSecondIntervalEndTime_ ) )
+    {
+        const double utcModifiedJulianDay = utcSecondsSinceJ2000 / physical_constants::JULIAN_DAY +
+                ( JULIAN_DAY_ON_J2000 - JULIAN_DAY_AT_0_MJD );
+        currentTaiMinusUtc_ = basic_astrodynamics::getTaiMinusUtc( utcModifiedJulianDay );
+
+        // Set interval between leap seconds in which the current value is valid.
+        const std::vector< double >& leapSecondModifiedJulianDays = getLeapSecondModifiedJulianDays( );
+        std::vector< double >::const_iterator nextLeapSecond = std::upper_bound(
+                    leapSecondModifiedJulianDays.begin( ), leapSecondModifiedJulianDays.end( ),
+                    utcModifiedJulianDay );
+        currentLeapSecondIntervalStartTime_ =
+                ( *( nextLeapSecond - 1 ) - ( JULIAN_DAY_ON_J2000 - JULIAN_DAY_AT_0_MJD ) ) *
+                physical_constants::JULIAN_DAY;
+        currentLeapSecondIntervalEndTime_ = ( nextLeapSecond == leapSecondModifiedJulianDays.end( ) ) ?
+                    std::numeric_limits< double >::infinity( ) :
+                    ( *nextLeapSecond - ( JULIAN_DAY_ON_J2000 - JULIAN_DAY_AT_0_MJD ) ) *
+                    physical_constants::JULIAN_DAY;
+    }
+    return currentTaiMinusUtc_;
+}
+
+//! Function to retrieve UT1 - TT, using the cached value if possible.
+double TimeScaleConverter::getUt1MinusTt( const double ttSecondsSinceJ2000 )
+{
+    if( !( ttSecondsSinceJ2000 == currentUt1Time_ ) )
+    {
+        if( ut1MinusTtFunction_.empty( ) )
+        {
+            throw std::runtime_error( "Error when converting to or from UT1, no UT1 - TT function provided." );
+        }
+        currentUt1MinusTt_ = ut1MinusTtFunction_( ttSecondsSinceJ2000 );
+        currentUt1Time_ = ttSecondsSinceJ2000;
+    }
+    return currentUt1MinusTt_;
+}
+
+//! Function to compute the difference between TT and a given time scale, at an epoch in that time scale.
+long double TimeScaleConverter::getTtMinusTimeScale( const TimeScales timeScale, const double timeInScale )
+{
+    long double ttMinusTimeScale = 0.0L;
+    switch( timeScale )
+    {
+    case tt_scale:
+        break;
+    case tai_scale:
+        ttMinusTimeScale = getTTMinusTai< long double >( );
+        break;
+    case utc_scale:
+        ttMinusTimeScale = getTTMinusTai< long double >( ) +
+                static_cast< long double >( getTaiMinusUtc( timeInScale ) );
+        break;
+    case tdb_scale:
+        ttMinusTimeScale = -static_cast< long double >(
+                    getTdbMinusTt( timeInScale - getTdbMinusTt( timeInScale ) ) );
+        break;
+    case tcb_scale:
+    {
+        // Convert to TDB first, using TDB - TCB = TDB0 - LB * ( TCB - T0 ).
+        const long double tdbMinusTcb = getTdbSecondsOffsetAtSynchronization< long double >( ) -
+                physical_constants::getLbTimeRateTerm< long double >( ) * (
+                    static_cast< long double >( timeInScale ) -
+                    getTimeOfTaiSynchronizationSinceJ2000< long double >( ) );
+        const double tdbTime = timeInScale + static_cast< double >( tdbMinusTcb );
+        ttMinusTimeScale = tdbMinusTcb - static_cast< long double >(
+                    getTdbMinusTt( tdbTime - getTdbMinusTt( tdbTime ) ) );
+        break;
+    }
+    case tcg_scale:
+        ttMinusTimeScale = -physical_constants::getLgTimeRateTerm< long double >( ) * (
+                    static_cast< long double >( timeInScale ) -
+                    getTimeOfTaiSynchronizationSinceJ2000< long double >( ) );
+        break;
+    case ut1_scale:
+        ttMinusTimeScale = -static_cast< long double >(
+                    getUt1MinusTt( timeInScale - getUt1MinusTt( timeInScale ) ) );
+        break;
+    default:
+        throw std::runtime_error( "Error when converting time scales, input time scale not recognized." );
+    }
+    return ttMinusTimeScale;
+}
+
+//! Function to compute the difference between a given time scale and TT, at an epoch in TT.
+long double TimeScaleConverter::getTimeScaleMinusTt( const TimeScales timeScale, const double ttTime )
+{
+    long double timeScaleMinusTt = 0.0L;
+    switch( timeScale )
+    {
+    case tt_scale:
+        break;
+    case tai_scale:
+        timeScaleMinusTt = -getTTMinusTai< long double >( );
+        break;
+    case utc_scale:
+    {
+        // Iterate once to ensure that the number of leap seconds is evaluated at the UTC epoch.
+        const double taiTime = ttTime - getTTMinusTai< double >( );
+        timeScaleMinusTt = -getTTMinusTai< long double >( ) - static_cast< long double >(
+                    getTaiMinusUtc( taiTime - getTaiMinusUtc( taiTime ) ) );
+        break;
+    }
+    case tdb_scale:
+        timeScaleMinusTt = static_cast< long double >( getTdbMinusTt( ttTime ) );
+        break;
+    case tcb_scale:
+    {
+        // Convert from TDB, using TCB - TDB = ( LB * ( TDB - T0 ) - TDB0 ) / ( 1 - LB ).
+        const long double tdbMinusTt = static_cast< long double >( getTdbMinusTt( ttTime ) );
+        const long double lbTimeRateTerm = physical_constants::getLbTimeRateTerm< long double >( );
+        timeScaleMinusTt = tdbMinusTt + (
+                    lbTimeRateTerm * ( static_cast< long double >( ttTime ) + tdbMinusTt -
+                                       getTimeOfTaiSynchronizationSinceJ2000< long double >( ) ) -
+                    getTdbSecondsOffsetAtSynchronization< long double >( ) ) / ( 1.0L - lbTimeRateTerm );
+        break;
+    }
+    case tcg_scale:
+    {
+        const long double lgTimeRateTerm = physical_constants::getLgTimeRateTerm< long double >( );
+        timeScaleMinusTt = lgTimeRateTerm / ( 1.0L - lgTimeRateTerm ) * (
+                    static_cast< long double >( ttTime ) - getTimeOfTaiSynchronizationSinceJ2000< long double >( ) );
+        break;
+    }
+    case ut1_scale:
+        timeScaleMinusTt = static_cast< long double >( getUt1MinusTt( ttTime ) );
+        break;
+    default:
+        throw std::runtime_error( "Error when converting time scales, output time scale not recognized." );
+    }
+    return timeScaleMinusTt;
+}
+
+} // namespace basic_astrodynamics
+
+} // namespace tudat
@@ -0,0 +1,201 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Fairhead, L. and Bretagnon, P., An analytical formula for the time transformation TB-TT, Astronomy and
+ *          Astrophysics 229, 240-247, 1990.
+ *      Petit, G. and Luzum, B. (eds.), IERS Conventions 2010, IERS Technical Note 36, 2010.
+ *
+ */
+
+#ifndef TUDAT_TIME_SCALE_CONVERTER_H
+#define TUDAT_TIME_SCALE_CONVERTER_H
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "Tudat/Basics/timeType.h"
+
+namespace tudat
+{
+
+namespace basic_astrodynamics
+{
+
+//! List of time scales that can be converted by the TimeScaleConverter
+enum TimeScales
+{
+    tai_scale = 0,
+    tt_scale = 1,
+    tdb_scale = 2,
+    utc_scale = 3,
+    ut1_scale = 4,
+    tcb_scale = 5,
+    tcg_scale = 6
+};
+
+//! Function to compute TDB - TT at the geocenter from a truncated analytical series.
+/*!
+ *  Function to compute TDB - TT at the geocenter from the leading terms of the series by Fairhead and Bretagnon (1990).
+ *  The topocentric terms, which are below 2 microseconds for an observer on the Earth's surface, are not included.
+ *  The truncation error of the series is of the order of several microseconds.
+ *  \param ttSecondsSinceJ2000 TT in seconds since J2000.
+ *  \return TDB - TT (in seconds).
+ */
+double computeTdbMinusTt( const double ttSecondsSinceJ2000 );
+
+//! Function to compute the time derivative of TDB - TT at the geocenter, from a truncated analytical series.
+/*!
+ *  Function to compute the time derivative of TDB - TT at the geocenter, from the same truncated series as used in
+ *  the computeTdbMinusTt function.
+ *  \param ttSecondsSinceJ2000 TT in seconds since J2000.
+ *  \return Time derivative of TDB - TT (in seconds per second).
+ */
+double computeTdbMinusTtRate( const double ttSecondsSinceJ2000 );
+
+//! Class to convert epochs between time scales, with cached and interpolated offsets between the scales.
+/*!
+ *  Class to convert epochs between time scales (TAI, TT, TDB, UTC, UT1, TCB and TCG). All epochs are given in seconds
+ *  since J2000 in the respective time scale, either as double or as Time. Conversions are performed through TT, with
+ *  the offsets between the time scales computed in (long) double precision, and added to the input time, so that the
+ *  resolution of a Time input is preserved.
+ *  To allow frequent conversions at low computational cost, the offsets are cached: TDB - TT is evaluated from a
+ *  piecewise cubic Hermite interpolation of the Fairhead and Bretagnon (1990) series, for which the nodes of the current
+ *  interval are stored, the number of leap seconds is stored along with its interval of validity, and UT1 - TT is
+ *  stored for the most recent TT. Since the caches are modified by each conversion, a single object should not be used
+ *  concurrently from multiple threads.
+ *  Note that epochs during a leap second cannot be represented as UTC seconds since J2000.
+ */
+class TimeScaleConverter
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor.
+     *  \param ut1MinusTtFunction Function returning UT1 - TT (in seconds) as a function of TT (in seconds since
+     *  J2000), typically obtained from Earth orientation parameters. If empty, conversions to or from UT1 are not
+     *  supported.
+     *  \param tdbMinusTtInterpolationStep Step size (in seconds) between nodes of the interpolation of TDB - TT (default
+     *  one day, for which the interpolation error is below 1.0E-11 s).
+     */
+    TimeScaleConverter( const boost::function< double( const double ) > ut1MinusTtFunction =
+            boost::function< double( const double ) >( ),
+                        const double tdbMinusTtInterpolationStep = physical_constants::JULIAN_DAY );
+
+    //! Destructor.
+    ~TimeScaleConverter( ){ }
+
+    //! Function to convert an epoch from one time scale to another.
+    /*!
+     *  Function to convert an epoch from one time scale to another.
+     *  \param inputScale Time scale of input epoch.
+     *  \param outputScale Time scale of output epoch.
+     *  \param inputTime Input epoch, in seconds since J2000 in the input time scale.
+     *  \return Output epoch, in seconds since J2000 in the output time scale.
+     */
+    template< typename TimeType >
+    TimeType getCurrentTime( const TimeScales inputScale, const TimeScales outputScale, const TimeType& inputTime )
+    {
+        if( inputScale == outputScale )
+        {
+            return inputTime;
+        }
+
+        TimeType ttTime = inputTime + getTtMinusTimeScale( inputScale, static_cast< double >( inputTime ) );
+        return ttTime + getTimeScaleMinusTt( outputScale, static_cast< double >( ttTime ) );
+    }
+
+    //! Function to retrieve TDB - TT, using the cached interpolation of the analytical series.
+    /*!
+     *  Function to retrieve TDB - TT at the geocenter, using the cached interpolation of the analytical series.
+     *  \param ttSecondsSinceJ2000 TT in seconds since J2000.
+     *  \return TDB - TT (in seconds).
+     */
+    double getTdbMinusTt( const double ttSecondsSinceJ2000 );
+
+    //! Function to retrieve TAI - UTC (i.e. the accumulated number of leap seconds), using the cached value if possible.
+    /*!
+     *  Function to retrieve TAI - UTC (i.e. the accumulated number of leap seconds), using the cached value if the
+     *  requested epoch is in the same interval between leap seconds as the previous request.
+     *  \param utcSecondsSinceJ2000 UTC in seconds since J2000.
+     *  \return TAI - UTC (in seconds).
+     */
+    double getTaiMinusUtc( const double utcSecondsSinceJ2000 );
+
+    //! Function to retrieve UT1 - TT, using the cached value if possible.
+    /*!
+     *  Function to retrieve UT1 - TT, from the function provided to the constructor, using the cached value if the
+     *  requested epoch is equal to that of the previous request.
+     *  \param ttSecondsSinceJ2000 TT in seconds since J2000.
+     *  \return UT1 - TT (in seconds).
+     */
+    double getUt1MinusTt( const double ttSecondsSinceJ2000 );
+
+private:
+
+    //! Function to compute the difference between TT and a given time scale, at an epoch in that time scale.
+    /*!
+     *  Function to compute the difference between TT and a given time scale, at an epoch in that time scale.
+     *  \param timeScale Time scale from which TT is to be computed.
+     *  \param timeInScale Epoch in seconds since J2000, in time scale timeScale.
+     *  \return TT minus time in timeScale (in seconds).
+     */
+    long double getTtMinusTimeScale( const TimeScales timeScale, const double timeInScale );
+
+    //! Function to compute the difference between a given time scale and TT, at an epoch in TT.
+    /*!
+     *  Function to compute the difference between a given time scale and TT, at an epoch in TT.
+     *  \param timeScale Time scale to which TT is to be converted.
+     *  \param ttTime TT in seconds since J2000.
+     *  \return Time in timeScale minus TT (in seconds).
+     */
+    long double getTimeScaleMinusTt( const TimeScales timeScale, const double ttTime );
+
+    //! Function returning UT1 - TT (in seconds) as a function of TT (in seconds since J2000).
+    boost::function< double( const double ) > ut1MinusTtFunction_;
+
+    //! Step size (in seconds) between nodes of the interpolation of TDB - TT.
+    double tdbMinusTtInterpolationStep_;
+
+    //! TT (in seconds since J2000) at the start of the current interpolation interval of TDB - TT.
+    double currentTdbIntervalStartTime_;
+
+    //! Values of TDB - TT at the start and end of the current interpolation interval.
+    double currentTdbMinusTtNodeValues_[ 2 ];
+
+    //! Values of the rate of TDB - TT at the start and end of the current interpolation interval, multiplied by the
+    //! interpolation step.
+    double currentScaledTdbMinusTtNodeRates_[ 2 ];
+
+    //! UTC (in seconds since J2000) at the start of the interval of validity of currentTaiMinusUtc_.
+    double currentLeapSecondIntervalStartTime_;
+
+    //! UTC (in seconds since J2000) at the end of the interval of validity of currentTaiMinusUtc_.
+    double currentLeapSecondIntervalEndTime_;
+
+    //! TAI - UTC (in seconds) in the current interval between leap seconds.
+    double currentTaiMinusUtc_;
+
+    //! TT (in seconds since J2000) at which currentUt1MinusTt_ was last computed.
+    double currentUt1Time_;
+
+    //! UT1 - TT (in seconds) at currentUt1Time_.
+    double currentUt1MinusTt_;
+};
+
+//! Typedef for shared pointer to TimeScaleConverter.
+typedef boost::shared_ptr< TimeScaleConverter > TimeScaleConverterPointer;
+
+} // namespace basic_astrodynamics
+
+} // namespace tudat
+
+#endif // TUDAT_TIME_SCALE_CONVERTER_H
@@ -0,0 +1,185 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Montenbruck, O. and Gill, E. Satellite Orbits, Springer, 2000.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/lambda/lambda.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Astrodynamics/ElectroMagnetism/cannonBallRadiationPressureAcceleration.h"
+#include "Tudat/Astrodynamics/ElectroMagnetism/panelledRadiationPressureAcceleration.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::electro_magnetism;
+using namespace tudat::system_models;
+
+//! Function to compute the radiation pressure force on a single panel (Montenbruck and Gill, 2000, eq. 3.79).
+Eigen::Vector3d computeSinglePanelRadiationPressureForce(
+        const double radiationPressure, const Eigen::Vector3d& vectorToSource, const Eigen::Vector3d& panelNormal,
+        const double area, const double specularReflectivity, const double diffuseReflectivity )
+{
+    double cosine = panelNormal.normalized( ).dot( vectorToSource );
+    if( cosine <= 0.0 )
+    {
+        return Eigen::Vector3d::Zero( );
+    }
+    return -radiationPressure * area * cosine * (
+                ( 1.0 - specularReflectivity ) * vectorToSource +
+                2.0 * ( specularReflectivity * cosine + diffuseReflectivity / 3.0 ) * panelNormal.normalized( ) );
+}
+
+BOOST_AUTO_TEST_SUITE( test_panelled_radiation_pressure_acceleration )
+
+//! Test whether a single panel facing the source is equivalent to a cannon-ball model.
+BOOST_AUTO_TEST_CASE( testSinglePanelRadiationPressure )
+{
+    const double radiationPressure = 4.56E-6;
+    const double area = 2.3;
+    const double mass = 450.0;
+    const Eigen::Vector3d vectorToSource = Eigen::Vector3d( 0.3, -0.5, 0.8 ).normalized( );
+
+    for( unsigned int test = 0; test < 3; test++ )
+    {
+        const double specularReflectivity = 0.4 * test;
+        const double diffuseReflectivity = ( test == 1 ) ? 0.35 : 0.0;
+
+        PanelledSurfaceModel surfaceModel(
+                    std::vector< Eigen::Vector3d >( 1, 3.0 * vectorToSource ), std::vector< double >( 1, area ),
+                    std::vector< double >( 1, specularReflectivity ),
+                    std::vector< double >( 1, diffuseReflectivity ) );
+
+        // Compare to cannon-ball model with radiation pressure coefficient including reflected radiation.
+        Eigen::Vector3d cannonBallAcceleration = computeCannonBallRadiationPressureAcceleration(
+                    radiationPressure, vectorToSource, area,
+                    1.0 + specularReflectivity + 2.0 / 3.0 * diffuseReflectivity, mass );
+        Eigen::Vector3d panelledAcceleration = computePanelledRadiationPressureForce(
+                    radiationPressure, vectorToSource, surfaceModel ) / mass;
+        BOOST_CHECK_SMALL( ( panelledAcceleration - cannonBallAcceleration ).norm( ),
+                           10.0 * std::numeric_limits< double >::epsilon( ) * cannonBallAcceleration.norm( ) );
+
+        // Check that panel facing away from source has no force.
+        BOOST_CHECK_EQUAL( computePanelledRadiationPressureForce(
+                               radiationPressure, -vectorToSource, surfaceModel ).norm( ), 0.0 );
+    }
+
+    // Check projected area of absorbing cube.
+    PanelledSurfaceModel cubeModel = createBoxWingPanelledSurfaceModel(
+                Eigen::Vector3d::Constant( 2.0 ), 0.0, Eigen::Vector3d::UnitX( ), 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 );
+    Eigen::Vector3d diagonalVectorToSource = Eigen::Vector3d::Ones( ).normalized( );
+    Eigen::Vector3d cubeForce = computePanelledRadiationPressureForce(
+                radiationPressure, diagonalVectorToSource, cubeModel );
+    BOOST_CHECK_SMALL( ( cubeForce + radiationPressure * 4.0 * std::sqrt( 3.0 ) * diagonalVectorToSource ).norm( ),
+                       1.0E-14 * cubeForce.norm( ) );
+
+    // Check input validation.
+    BOOST_CHECK_THROW( PanelledSurfaceModel(
+                           std::vector< Eigen::Vector3d >( 1, vectorToSource ), std::vector< double >( 1, area ),
+                           std::vector< double >( 1, 0.7 ), std::vector< double >( 1, 0.4 ) ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( PanelledSurfaceModel(
+                           std::vector< Eigen::Vector3d >( 2, vectorToSource ), std::vector< double >( 1, area ),
+                           std::vector< double >( 1, 0.2 ), std::vector< double >( 1, 0.4 ) ),
+                       std::runtime_error );
+}
+
+//! Test box-wing radiation pressure acceleration, including body rotation.
+BOOST_AUTO_TEST_CASE( testBoxWingRadiationPressureAcceleration )
+{
+    const double radiationPressure = 4.56E-6;
+    const double mass = 1200.0;
+
+    const Eigen::Vector3d boxDimensions( 1.5, 2.0, 2.5 );
+    const double solarArrayArea = 12.0;
+    const Eigen::Vector3d solarArrayNormal = Eigen::Vector3d( 0.2, 1.0, -0.1 ).normalized( );
+
+    boost::shared_ptr< PanelledSurfaceModel > boxWingModel = boost::make_shared< PanelledSurfaceModel >(
+                createBoxWingPanelledSurfaceModel(
+                    boxDimensions, solarArrayArea, solarArrayNormal, 0.2, 0.3, 0.05, 0.05, 0.1, 0.4 ) );
+    BOOST_CHECK_EQUAL( boxWingModel->getNumberOfPanels( ), 8 );
+
+    // Define per-panel properties for explicit computation.
+    std::vector< Eigen::Vector3d > panelNormals;
+    std::vector< double > panelAreas;
+    for( unsigned int i = 0; i < 3; i++ )
+    {
+        panelNormals.push_back( Eigen::Vector3d::Unit( i ) );
+        panelNormals.push_back( -Eigen::Vector3d::Unit( i ) );
+        panelAreas.push_back( boxDimensions( ( i + 1 ) % 3 ) * boxDimensions( ( i + 2 ) % 3 ) );
+        panelAreas.push_back( boxDimensions( ( i + 1 ) % 3 ) * boxDimensions( ( i + 2 ) % 3 ) );
+    }
+    panelNormals.push_back( solarArrayNormal );
+    panelNormals.push_back( -solarArrayNormal );
+    panelAreas.push_back( solarArrayArea );
+    panelAreas.push_back( solarArrayArea );
+
+    std::vector< double > specularReflectivities( 6, 0.2 );
+    specularReflectivities.push_back( 0.05 );
+    specularReflectivities.push_back( 0.1 );
+    std::vector< double > diffuseReflectivities( 6, 0.3 );
+    diffuseReflectivities.push_back( 0.05 );
+    diffuseReflectivities.push_back( 0.4 );
+
+    const Eigen::Vector3d sourcePosition( 1.0E11, -5.0E10, 2.0E10 );
+    for( unsigned int test = 0; test < 20; test++ )
+    {
+        // Define body position and orientation.
+        const Eigen::Vector3d bodyPosition = 7.0E6 * Eigen::Vector3d(
+                    std::cos( 0.7 * test ), std::sin( 0.7 * test ), 0.1 * test - 1.0 );
+        const Eigen::Quaterniond rotationToInertialFrame =
+                Eigen::Quaterniond( Eigen::AngleAxisd( 0.9 * test, Eigen::Vector3d::UnitZ( ) ) *
+                                    Eigen::AngleAxisd( -0.4 * test + 0.3, Eigen::Vector3d::UnitX( ) ) *
+                                    Eigen::AngleAxisd( 0.25 * test, Eigen::Vector3d::UnitY( ) ) );
+
+        PanelledRadiationPressureAcceleration accelerationModel(
+                    boost::lambda::constant( sourcePosition ), boost::lambda::constant( bodyPosition ),
+                    boost::lambda::constant( radiationPressure ), boost::lambda::constant( rotationToInertialFrame ),
+                    boxWingModel, boost::lambda::constant( mass ) );
+        accelerationModel.updateMembers( 0.0 );
+        Eigen::Vector3d acceleration = accelerationModel.getAcceleration( );
+
+        // Compute acceleration explicitly, panel by panel.
+        Eigen::Vector3d vectorToSourceInBodyFrame =
+                rotationToInertialFrame.inverse( ) * ( sourcePosition - bodyPosition ).normalized( );
+        Eigen::Vector3d expectedForceInBodyFrame = Eigen::Vector3d::Zero( );
+        for( unsigned int i = 0; i < panelNormals.size( ); i++ )
+        {
+            expectedForceInBodyFrame += computeSinglePanelRadiationPressureForce(
+                        radiationPressure, vectorToSourceInBodyFrame, panelNormals.at( i ), panelAreas.at( i ),
+                        specularReflectivities.at( i ), diffuseReflectivities.at( i ) );
+        }
+        Eigen::Vector3d expectedAcceleration = rotationToInertialFrame * expectedForceInBodyFrame / mass;
+
+        BOOST_CHECK_SMALL( ( acceleration - expectedAcceleration ).norm( ), 1.0E-14 * expectedAcceleration.norm( ) );
+
+        // Check that force has component away from source.
+        BOOST_CHECK( acceleration.dot( sourcePosition - bodyPosition ) < 0.0 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
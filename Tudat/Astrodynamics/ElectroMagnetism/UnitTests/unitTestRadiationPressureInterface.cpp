@@ -12,13 +12,16 @@
 #define BOOST_TEST_MAIN
 
 
+#include <boost/bind.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/ref.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include <Eigen/Core>
 
+#include "Tudat/Astrodynamics/BasicAstrodynamics/missionGeometry.h"
 #include "Tudat/Astrodynamics/ElectroMagnetism/radiationPressureInterface.h"
 
 namespace tudat
@@ -26,6 +29,13 @@ namespace tudat
 namespace unit_tests
 {
 
+//! Function returning a constant position, counting the number of calls.
+Eigen::Vector3d getCountedPosition( const Eigen::Vector3d position, int& numberOfCalls )
+{
+    numberOfCalls++;
+    return position;
+}
+
 BOOST_AUTO_TEST_SUITE( test_radiation_pressure_interface )
 
 //! Test implementation of radiation pressure calculation
@@ -119,6 +129,109 @@ BOOST_AUTO_TEST_CASE( testShadowFunctionLink )
 
 }
 
+//! Test use of a single occultation model for multiple targets.
+BOOST_AUTO_TEST_CASE( testSharedOccultationModel )
+{
+    using namespace electro_magnetism;
+
+    // Set test geometry (see testShadowFunctionForPartialShadow for details)
+    const Eigen::Vector3d occultingBodyPosition = Eigen::Vector3d::Zero( );
+    const Eigen::Vector3d occultedBodyPosition = -149598000.0e3 * Eigen::Vector3d( 1.0, 0.0, 0.0 );
+    const double occultedBodyRadius = 6.96e8;
+    const double occultingBodyRadius = 6378.137e3;
+
+    int numberOfSourceCalls = 0;
+    int numberOfOccultingBodyCalls = 0;
+    std::vector< boost::function< Eigen::Vector3d( ) > > occultingBodyPositionFunctions;
+    occultingBodyPositionFunctions.push_back(
+                boost::bind( &getCountedPosition, occultingBodyPosition, boost::ref( numberOfOccultingBodyCalls ) ) );
+    std::vector< double > occultingBodyRadii;
+    occultingBodyRadii.push_back( occultingBodyRadius );
+
+    // Create single occultation model for all targets.
+    boost::shared_ptr< OccultationModel > occultationModel = boost::make_shared< OccultationModel >(
+                boost::bind( &getCountedPosition, occultedBodyPosition, boost::ref( numberOfSourceCalls ) ),
+                occultedBodyRadius, occultingBodyPositionFunctions, occultingBodyRadii );
+
+    // Create targets in full light, penumbra and umbra.
+    Eigen::Vector3d satelliteDirection( 0.018, 1.0, 0.0 );
+    satelliteDirection.normalize( );
+    std::vector< Eigen::Vector3d > satellitePositions;
+    satellitePositions.push_back( ( occultingBodyRadius + 1.0e6 ) * Eigen::Vector3d( 0.0, 1.0, 0.0 ) );
+    satellitePositions.push_back( ( occultingBodyRadius + 1.0e3 ) * satelliteDirection );
+    satellitePositions.push_back( ( occultingBodyRadius + 1.0e6 ) * Eigen::Vector3d( 1.0, 0.0, 0.0 ) );
+    satellitePositions.push_back( ( occultingBodyRadius + 1.0e6 ) * Eigen::Vector3d( -1.0, 0.0, 0.0 ) );
+
+    std::vector< boost::shared_ptr< RadiationPressureInterface > > radiationPressureInterfaces;
+    for( unsigned int i = 0; i < satellitePositions.size( ); i++ )
+    {
+        radiationPressureInterfaces.push_back(
+                    boost::make_shared< RadiationPressureInterface >(
+                        boost::lambda::constant( 3.839E26 ), occultationModel,
+                        boost::lambda::constant( satellitePositions.at( i ) ), 1.0, 1.0 ) );
+    }
+
+    // Update all interfaces twice at two epochs, and check that source and occulting body positions are only
+    // retrieved once per epoch.
+    for( int epoch = 0; epoch < 2; epoch++ )
+    {
+        for( int update = 0; update < 2; update++ )
+        {
+            for( unsigned int i = 0; i < radiationPressureInterfaces.size( ); i++ )
+            {
+                radiationPressureInterfaces.at( i )->updateInterface( 100.0 * epoch );
+            }
+        }
+        BOOST_CHECK_EQUAL( numberOfSourceCalls, epoch + 1 );
+        BOOST_CHECK_EQUAL( numberOfOccultingBodyCalls, epoch + 1 );
+    }
+
+    // Check that positions are retrieved anew after reset.
+    radiationPressureInterfaces.at( 0 )->resetCurrentTime( );
+    radiationPressureInterfaces.at( 1 )->updateInterface( 100.0 );
+    BOOST_CHECK_EQUAL( numberOfSourceCalls, 3 );
+
+    // Compare shadow functions to direct computation, and to batch computation.
+    std::vector< double > shadowFunctions = occultationModel->computeShadowFunctions( satellitePositions );
+    for( unsigned int i = 0; i < satellitePositions.size( ); i++ )
+    {
+        double expectedShadowFunction = mission_geometry::computeShadowFunction(
+                    occultedBodyPosition, occultedBodyRadius, occultingBodyPosition, occultingBodyRadius,
+                    satellitePositions.at( i ) );
+        BOOST_CHECK_EQUAL( shadowFunctions.at( i ), expectedShadowFunction );
+        BOOST_CHECK_CLOSE_FRACTION(
+                    radiationPressureInterfaces.at( i )->getCurrentRadiationPressure( ),
+                    expectedShadowFunction * calculateRadiationPressure(
+                        3.839E26, ( occultedBodyPosition - satellitePositions.at( i ) ).norm( ) ),
+                    1.0E-15 );
+    }
+    BOOST_CHECK_CLOSE_FRACTION( shadowFunctions.at( 1 ), 0.4547, 1.0E-3 );
+
+    // Check that targets in full light and behind the occulted body were pre-screened (in 4 updates and batch).
+    BOOST_CHECK_EQUAL( occultationModel->getNumberOfScreenedOccultations( ), 2 * 4 + 2 );
+
+    // Check that source and occulting body properties of interfaces are taken from the occultation model, and that
+    // the source position function is not affected by the per-epoch position cache.
+    BOOST_CHECK_EQUAL( radiationPressureInterfaces.at( 0 )->getSourceRadius( ), occultedBodyRadius );
+    BOOST_CHECK_EQUAL( radiationPressureInterfaces.at( 0 )->getOccultingBodyRadii( ).size( ), 1 );
+    BOOST_CHECK_EQUAL( radiationPressureInterfaces.at( 0 )->getOccultingBodyRadii( ).at( 0 ), occultingBodyRadius );
+    BOOST_CHECK_EQUAL( radiationPressureInterfaces.at( 0 )->getOccultingBodyPositions( ).size( ), 1 );
+    int numberOfSourceCallsBeforeRetrieval = numberOfSourceCalls;
+    BOOST_CHECK_EQUAL( radiationPressureInterfaces.at( 0 )->getSourcePositionFunction( )( ), occultedBodyPosition );
+    BOOST_CHECK_EQUAL( numberOfSourceCalls, numberOfSourceCallsBeforeRetrieval + 1 );
+
+    // Check that interface with its own occultation model retrieves positions at each update, also at equal times.
+    int numberOfOwnSourceCalls = 0;
+    RadiationPressureInterface ownRadiationPressureInterface(
+                boost::lambda::constant( 3.839E26 ),
+                boost::bind( &getCountedPosition, occultedBodyPosition, boost::ref( numberOfOwnSourceCalls ) ),
+                boost::lambda::constant( satellitePositions.at( 1 ) ), 1.0, 1.0, occultingBodyPositionFunctions,
+                occultingBodyRadii, occultedBodyRadius );
+    ownRadiationPressureInterface.updateInterface( 100.0 );
+    ownRadiationPressureInterface.updateInterface( 100.0 );
+    BOOST_CHECK_EQUAL( numberOfOwnSourceCalls, 2 );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
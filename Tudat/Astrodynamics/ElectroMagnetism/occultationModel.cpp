@@ -0,0 +1,129 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <iostream>
+#include <stdexcept>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/missionGeometry.h"
+#include "Tudat/Astrodynamics/ElectroMagnetism/occultationModel.h"
+
+namespace tudat
+{
+
+namespace electro_magnetism
+{
+
+//! Constructor.
+OccultationModel::OccultationModel(
+        const boost::function< Eigen::Vector3d( ) > sourcePositionFunction,
+        const double sourceRadius,
+        const std::vector< boost::function< Eigen::Vector3d( ) > >& occultingBodyPositions,
+        const std::vector< double >& occultingBodyRadii,
+        const ShadowFunctionType shadowFunctionType ):
+    sourcePositionFunction_( sourcePositionFunction ), sourceRadius_( sourceRadius ),
+    occultingBodyPositions_( occultingBodyPositions ), occultingBodyRadii_( occultingBodyRadii ),
+    shadowFunctionType_( shadowFunctionType ),
+    currentSourcePosition_( Eigen::Vector3d::Constant( TUDAT_NAN ) ),
+    currentOccultingBodyPositions_( occultingBodyPositions.size( ), Eigen::Vector3d::Constant( TUDAT_NAN ) ),
+    currentTime_( TUDAT_NAN ), numberOfScreenedOccultations_( 0 ), isMultipleOccultationWarningPrinted_( false )
+{
+    if( occultingBodyPositions_.size( ) != occultingBodyRadii_.size( ) )
+    {
+        throw std::runtime_error( "Error when creating occultation model, number of occulting body positions and "
+                                  "radii are not equal." );
+    }
+}
+
+//! Function to update the positions of the source and occulting bodies.
+void OccultationModel::updateBodyPositions( const double currentTime )
+{
+    if( !( currentTime == currentTime_ ) )
+    {
+        currentSourcePosition_ = sourcePositionFunction_( );
+        for( unsigned int i = 0; i < occultingBodyPositions_.size( ); i++ )
+        {
+            currentOccultingBodyPositions_[ i ] = occultingBodyPositions_[ i ]( );
+        }
+        currentTime_ = currentTime;
+    }
+}
+
+//! Function to compute the shadow function at a target position, using the current body positions.
+double OccultationModel::computeShadowFunction( const Eigen::Vector3d& targetPosition )
+{
+    double shadowFunction = 1.0;
+    double currentShadowFunction;
+    for( unsigned int i = 0; i < currentOccultingBodyPositions_.size( ); i++ )
+    {
+        switch( shadowFunctionType_ )
+        {
+        case conical_shadow:
+        case smoothed_conical_shadow:
+        {
+            // Skip shadow function evaluation if target is outside penumbral cone.
+            if( !mission_geometry::isOccultationPossible(
+                        currentSourcePosition_, sourceRadius_, currentOccultingBodyPositions_[ i ],
+                        occultingBodyRadii_[ i ], targetPosition ) )
+            {
+                numberOfScreenedOccultations_++;
+                currentShadowFunction = 1.0;
+            }
+            else if( shadowFunctionType_ == conical_shadow )
+            {
+                currentShadowFunction = mission_geometry::computeShadowFunction(
+                            currentSourcePosition_, sourceRadius_, currentOccultingBodyPositions_[ i ],
+                            occultingBodyRadii_[ i ], targetPosition );
+            }
+            else
+            {
+                currentShadowFunction = mission_geometry::computeSmoothedShadowFunction(
+                            currentSourcePosition_, sourceRadius_, currentOccultingBodyPositions_[ i ],
+                            occultingBodyRadii_[ i ], targetPosition );
+            }
+            break;
+        }
+        case cylindrical_shadow:
+            currentShadowFunction = mission_geometry::computeCylindricalShadowFunction(
+                        currentSourcePosition_, currentOccultingBodyPositions_[ i ], occultingBodyRadii_[ i ],
+                        targetPosition );
+            break;
+        default:
+            throw std::runtime_error( "Error, did not recognize shadow function type in occultation model." );
+        }
+
+        if( currentShadowFunction != 1.0 && shadowFunction != 1.0 && !isMultipleOccultationWarningPrinted_ )
+        {
+            std::cerr << "Warning, multiple occultation occured in radiation pressure interface, results may be "
+                      << "slightly in error" << std::endl;
+            isMultipleOccultationWarningPrinted_ = true;
+        }
+
+        shadowFunction *= currentShadowFunction;
+    }
+
+    return shadowFunction;
+}
+
+//! Function to compute the shadow function at a list of target positions, using the current body positions.
+std::vector< double > OccultationModel::computeShadowFunctions( const std::vector< Eigen::Vector3d >& targetPositions )
+{
+    std::vector< double > shadowFunctions;
+    shadowFunctions.reserve( targetPositions.size( ) );
+    for( unsigned int i = 0; i < targetPositions.size( ); i++ )
+    {
+        shadowFunctions.push_back( computeShadowFunction( targetPositions[ i ] ) );
+    }
+    return shadowFunctions;
+}
+
+} // namespace electro_magnetism
+
+} // namespace tudat
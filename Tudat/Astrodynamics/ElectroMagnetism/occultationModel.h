@@ -0,0 +1,230 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Montebruck O, Gill E. Satellite Orbits, Corrected Third Printing, Springer, 2005.
+ *
+ */
+
+#ifndef TUDAT_OCCULTATIONMODEL_H
+#define TUDAT_OCCULTATIONMODEL_H
+
+#include <vector>
+
+#include <boost/function.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace electro_magnetism
+{
+
+//! List of models for the shadow function of a source occulted by a (spherical) body.
+enum ShadowFunctionType
+{
+    //! Conical umbra and penumbra, with exact occulted area (Montenbruck and Gill, 2005, sec. 3.4.2).
+    conical_shadow,
+    //! Cylindrical umbra without penumbra, source at infinite distance.
+    cylindrical_shadow,
+    //! Conical umbra and penumbra, with continuously differentiable occulted fraction in penumbra.
+    smoothed_conical_shadow
+};
+
+//! Class to compute the shadow function of a radiation source, due to one or more occulting bodies.
+/*!
+ *  Class to compute the shadow function of a radiation source (e.g. the Sun), due to one or more occulting bodies, for
+ *  any number of target bodies. The positions of the source and occulting bodies are retrieved only once per epoch
+ *  (see updateBodyPositions), so that a single object can be shared by all radiation pressure interfaces with the same
+ *  source and occulting bodies. For the conical shadow models, occulting bodies are pre-screened for each target
+ *  using a (trigonometry-free) test of whether the target is inside the penumbral cone, so that the full shadow
+ *  function is only evaluated close to an eclipse. Multiple concurrent occultations are treated as independent
+ *  (product of the shadow functions of each occulting body), which slightly underestimates the radiation pressure
+ *  if the occulting bodies overlap.
+ */
+class OccultationModel
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor.
+     *  \param sourcePositionFunction Function returning the current position of the source body.
+     *  \param sourceRadius Radius of the source body.
+     *  \param occultingBodyPositions List of functions returning the positions of the bodies causing occultations.
+     *  \param occultingBodyRadii List of radii of the bodies causing occultations.
+     *  \param shadowFunctionType Model to use for the shadow function.
+     */
+    OccultationModel(
+            const boost::function< Eigen::Vector3d( ) > sourcePositionFunction,
+            const double sourceRadius,
+            const std::vector< boost::function< Eigen::Vector3d( ) > >& occultingBodyPositions =
+            std::vector< boost::function< Eigen::Vector3d( ) > >( ),
+            const std::vector< double >& occultingBodyRadii = std::vector< double >( ),
+            const ShadowFunctionType shadowFunctionType = conical_shadow );
+
+    //! Function to update the positions of the source and occulting bodies.
+    /*!
+     *  Function to update the positions of the source and occulting bodies. The positions are only retrieved if the
+     *  input time differs from the time of the last update, or if it is NaN.
+     *  \param currentTime Time to which positions are to be updated.
+     */
+    void updateBodyPositions( const double currentTime = TUDAT_NAN );
+
+    //! Function to reset the current time of the model.
+    /*!
+     *  Function to reset the current time of the model, to ensure that the body positions are retrieved anew at the
+     *  next call to updateBodyPositions.
+     *  \param currentTime New current time of the model (default NaN).
+     */
+    void resetCurrentTime( const double currentTime = TUDAT_NAN )
+    {
+        currentTime_ = currentTime;
+    }
+
+    //! Function to compute the shadow function at a target position, using the current body positions.
+    /*!
+     *  Function to compute the shadow function at a target position, using the body positions set by the last call
+     *  to updateBodyPositions.
+     *  \param targetPosition Position of the target at which the shadow function is to be computed.
+     *  \return Shadow function (0 for total occultation, 1 for no occultation).
+     */
+    double computeShadowFunction( const Eigen::Vector3d& targetPosition );
+
+    //! Function to compute the shadow function at a list of target positions, using the current body positions.
+    /*!
+     *  Function to compute the shadow function at a list of target positions, using the body positions set by the
+     *  last call to updateBodyPositions.
+     *  \param targetPositions Positions of the targets at which the shadow function is to be computed.
+     *  \return Shadow functions at the target positions.
+     */
+    std::vector< double > computeShadowFunctions( const std::vector< Eigen::Vector3d >& targetPositions );
+
+    //! Function to return the position of the source, as set by the last call to updateBodyPositions.
+    /*!
+     *  Function to return the position of the source, as set by the last call to updateBodyPositions.
+     *  \return Current position of the source.
+     */
+    Eigen::Vector3d getCurrentSourcePosition( )
+    {
+        return currentSourcePosition_;
+    }
+
+    //! Function to return the positions of the occulting bodies, as set by the last call to updateBodyPositions.
+    /*!
+     *  Function to return the positions of the occulting bodies, as set by the last call to updateBodyPositions.
+     *  \return Current positions of the occulting bodies.
+     */
+    std::vector< Eigen::Vector3d > getCurrentOccultingBodyPositions( )
+    {
+        return currentOccultingBodyPositions_;
+    }
+
+    //! Function to return the function returning the current position of the source body.
+    /*!
+     *  Function to return the function returning the current position of the source body.
+     *  \return Function returning the current position of the source body.
+     */
+    boost::function< Eigen::Vector3d( ) > getSourcePositionFunction( )
+    {
+        return sourcePositionFunction_;
+    }
+
+    //! Function to return the radius of the source body.
+    /*!
+     *  Function to return the radius of the source body.
+     *  \return Radius of the source body.
+     */
+    double getSourceRadius( )
+    {
+        return sourceRadius_;
+    }
+
+    //! Function to return the list of functions returning the positions of the bodies causing occultations.
+    /*!
+     *  Function to return the list of functions returning the positions of the bodies causing occultations.
+     *  \return List of functions returning the positions of the bodies causing occultations.
+     */
+    std::vector< boost::function< Eigen::Vector3d( ) > > getOccultingBodyPositions( )
+    {
+        return occultingBodyPositions_;
+    }
+
+    //! Function to return the list of radii of the bodies causing occultations.
+    /*!
+     *  Function to return the list of radii of the bodies causing occultations.
+     *  \return List of radii of the bodies causing occultations.
+     */
+    std::vector< double > getOccultingBodyRadii( )
+    {
+        return occultingBodyRadii_;
+    }
+
+    //! Function to return the number of shadow function evaluations skipped by the penumbral cone pre-screening.
+    /*!
+     *  Function to return the number of shadow function evaluations (for a single target and occulting body) skipped
+     *  by the penumbral cone pre-screening, since the creation of this object.
+     *  \return Number of shadow function evaluations skipped by the pre-screening.
+     */
+    int getNumberOfScreenedOccultations( )
+    {
+        return numberOfScreenedOccultations_;
+    }
+
+    //! Function to return the model used for the shadow function.
+    /*!
+     *  Function to return the model used for the shadow function.
+     *  \return Model used for the shadow function.
+     */
+    ShadowFunctionType getShadowFunctionType( )
+    {
+        return shadowFunctionType_;
+    }
+
+private:
+
+    //! Function returning the current position of the source body.
+    boost::function< Eigen::Vector3d( ) > sourcePositionFunction_;
+
+    //! Radius of the source body.
+    double sourceRadius_;
+
+    //! List of functions returning the positions of the bodies causing occultations
+    std::vector< boost::function< Eigen::Vector3d( ) > > occultingBodyPositions_;
+
+    //! List of radii of the bodies causing occultations.
+    std::vector< double > occultingBodyRadii_;
+
+    //! Model used for the shadow function.
+    ShadowFunctionType shadowFunctionType_;
+
+    //! Position of the source at currentTime_.
+    Eigen::Vector3d currentSourcePosition_;
+
+    //! Positions of the occulting bodies at currentTime_.
+    std::vector< Eigen::Vector3d > currentOccultingBodyPositions_;
+
+    //! Time of the last update of the body positions.
+    double currentTime_;
+
+    //! Number of shadow function evaluations skipped by the penumbral cone pre-screening.
+    int numberOfScreenedOccultations_;
+
+    //! Boolean denoting whether a warning for multiple concurrent occultations has been printed.
+    bool isMultipleOccultationWarningPrinted_;
+};
+
+} // namespace electro_magnetism
+
+} // namespace tudat
+
+#endif // TUDAT_OCCULTATIONMODEL_H
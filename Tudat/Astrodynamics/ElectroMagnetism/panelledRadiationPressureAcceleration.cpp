@@ -0,0 +1,42 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include "Tudat/Astrodynamics/ElectroMagnetism/panelledRadiationPressureAcceleration.h"
+
+namespace tudat
+{
+namespace electro_magnetism
+{
+
+//! Compute radiation pressure force on a panelled surface.
+Eigen::Vector3d computePanelledRadiationPressureForce(
+        const double radiationPressure,
+        const Eigen::Vector3d& vectorToSource,
+        system_models::PanelledSurfaceModel& panelledSurfaceModel )
+{
+    // Compute cosines of incidence angles, set to zero for panels facing away from the source.
+    const Eigen::ArrayXd cosines =
+            ( panelledSurfaceModel.getPanelNormals( ).transpose( ) * vectorToSource ).array( ).max( 0.0 );
+
+    // Sum force components along source direction (absorbed and diffusely reflected radiation) and along panel
+    // normals (specularly and diffusely reflected radiation).
+    const double sourceDirectionComponent =
+            ( cosines * panelledSurfaceModel.getRadiationPressureSourceDirectionFactors( ) ).sum( );
+    const Eigen::VectorXd normalComponents =
+            ( cosines * ( cosines * panelledSurfaceModel.getRadiationPressureSpecularNormalFactors( ) +
+                          panelledSurfaceModel.getRadiationPressureDiffuseNormalFactors( ) ) ).matrix( );
+
+    return -radiationPressure * ( sourceDirectionComponent * vectorToSource +
+                                  panelledSurfaceModel.getPanelNormals( ) * normalComponents );
+}
+
+} // namespace electro_magnetism
+} // namespace tudat
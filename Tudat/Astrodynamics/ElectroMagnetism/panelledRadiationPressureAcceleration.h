@@ -0,0 +1,254 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Montenbruck, O. and Gill, E. Satellite Orbits, Springer, 2000.
+ *
+ */
+
+#ifndef TUDAT_PANELLED_RADIATION_PRESSURE_ACCELERATION_H
+#define TUDAT_PANELLED_RADIATION_PRESSURE_ACCELERATION_H
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Astrodynamics/SystemModels/panelledSurfaceModel.h"
+
+namespace tudat
+{
+namespace electro_magnetism
+{
+
+//! Compute radiation pressure force on a panelled surface.
+/*!
+ * Computes radiation pressure force on a panelled surface, summing the contributions of all panels that are illuminated
+ * by the source (Montenbruck and Gill, 2000, eq. 3.79). Self-shadowing of panels is not taken into account. The sum
+ * over the panels is evaluated as Eigen matrix/array operations on the panel properties.
+ * \param radiationPressure Radiation pressure at target.                                     [N/m^2]
+ * \param vectorToSource Unit vector pointing from target to source, in the body-fixed frame of the target.    [-]
+ * \param panelledSurfaceModel Panelled surface model of the target.
+ * \return Force due to radiation pressure, in the body-fixed frame of the target.                  [N]
+ */
+Eigen::Vector3d computePanelledRadiationPressureForce(
+        const double radiationPressure,
+        const Eigen::Vector3d& vectorToSource,
+        system_models::PanelledSurfaceModel& panelledSurfaceModel );
+
+//! Panelled radiation pressure acceleration model class.
+/*!
+ * Class that can be used to compute the radiation pressure acceleration on a body of which the outer surface is
+ * described by a set of flat panels (e.g. a box-wing model), each with its own area and reflectivities. The orientation
+ * of the panels is obtained from the rotation of the body.
+ */
+class PanelledRadiationPressureAcceleration: public basic_astrodynamics::AccelerationModel3d
+{
+private:
+
+    //! Typedef for double-returning function.
+    typedef boost::function< double( ) > DoubleReturningFunction;
+
+    //! Typedef for Eigen::Vector3d-returning function.
+    typedef boost::function< Eigen::Vector3d( ) > Vector3dReturningFunction;
+
+public:
+
+    // Ensure that correctly aligned pointers are generated (Eigen, 2013).
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    //! Constructor taking function pointers for all variables.
+    /*!
+     * Constructor taking function pointers for all variables.
+     * \param sourcePositionFunction Function returning position of radiation source.
+     * \param acceleratedBodyPositionFunction Function returning position of body undergoing
+     *          radiation pressure acceleration.
+     * \param radiationPressureFunction Function returning current radiation pressure.
+     * \param rotationToInertialFrameFunction Function returning current rotation from body-fixed frame of body
+     *          undergoing acceleration to inertial frame.
+     * \param panelledSurfaceModel Panelled surface model of body undergoing acceleration.
+     * \param massFunction Function returning current mass of body undergoing acceleration.
+     */
+    PanelledRadiationPressureAcceleration(
+            Vector3dReturningFunction sourcePositionFunction,
+            Vector3dReturningFunction acceleratedBodyPositionFunction,
+            DoubleReturningFunction radiationPressureFunction,
+            boost::function< Eigen::Quaterniond( ) > rotationToInertialFrameFunction,
+            boost::shared_ptr< system_models::PanelledSurfaceModel > panelledSurfaceModel,
+            DoubleReturningFunction massFunction )
+        : sourcePositionFunction_( sourcePositionFunction ),
+          acceleratedBodyPositionFunction_( acceleratedBodyPositionFunction ),
+          radiationPressureFunction_( radiationPressureFunction ),
+          rotationToInertialFrameFunction_( rotationToInertialFrameFunction ),
+          panelledSurfaceModel_( panelledSurfaceModel ),
+          massFunction_( massFunction )
+    {
+        this->updateMembers( );
+    }
+
+    //! Get radiation pressure acceleration.
+    /*!
+     * Returns the radiation pressure acceleration, computed from the current values of the variables set by the
+     * updateMembers( ) function.
+     * \return Radiation pressure acceleration.
+     * \sa computePanelledRadiationPressureForce().
+     */
+    Eigen::Vector3d getAcceleration( )
+    {
+        return currentRotationToInertialFrame_ * computePanelledRadiationPressureForce(
+                    currentRadiationPressure_, currentVectorToSourceInBodyFixedFrame_, *panelledSurfaceModel_ ) /
+                currentMass_;
+    }
+
+    //! Update member variables used by the radiation pressure acceleration model.
+    /*!
+     * Updates member variables used by the acceleration model. This function evaluates all
+     * dependent variables to the 'current' values of these parameters. Only these current values,
+     * not the function-pointers are then used by the getAcceleration( ) function.
+     * \param currentTime Time at which acceleration model is to be updated.
+     */
+    void updateMembers( const double currentTime = TUDAT_NAN )
+    {
+        if( !( this->currentTime_ == currentTime ) )
+        {
+            currentVectorToSource_ = ( sourcePositionFunction_( )
+                                       - acceleratedBodyPositionFunction_( ) ).normalized( );
+            currentRotationToInertialFrame_ = rotationToInertialFrameFunction_( );
+            currentVectorToSourceInBodyFixedFrame_ = currentRotationToInertialFrame_.inverse( ) * currentVectorToSource_;
+            currentRadiationPressure_ = radiationPressureFunction_( );
+            currentMass_ = massFunction_( );
+            this->currentTime_ = currentTime;
+        }
+    }
+
+    //! Function to retrieve the function pointer returning mass of accelerated body.
+    /*!
+     * Function to retrieve the function pointer returning mass of accelerated body.
+     * \return Function pointer returning mass of accelerated body.
+     */
+    DoubleReturningFunction getMassFunction( )
+    {
+        return massFunction_;
+    }
+
+    //! Function to retrieve the function returning the position of the radiation source.
+    /*!
+     * Function to retrieve the function returning the position of the radiation source.
+     * \return Function returning the position of the radiation source.
+     */
+    Vector3dReturningFunction getSourcePositionFunction( )
+    {
+        return sourcePositionFunction_;
+    }
+
+    //! Function to retrieve the function returning the position of the accelerated body.
+    /*!
+     * Function to retrieve the function returning the position of the accelerated body.
+     * \return Function returning the position of the accelerated body.
+     */
+    Vector3dReturningFunction getAcceleratedBodyPositionFunction( )
+    {
+        return acceleratedBodyPositionFunction_;
+    }
+
+    //! Function to retrieve the panelled surface model of the accelerated body.
+    /*!
+     * Function to retrieve the panelled surface model of the accelerated body.
+     * \return Panelled surface model of the accelerated body.
+     */
+    boost::shared_ptr< system_models::PanelledSurfaceModel > getPanelledSurfaceModel( )
+    {
+        return panelledSurfaceModel_;
+    }
+
+    //! Function to retrieve the current unit vector from accelerated body to source, in the inertial frame.
+    /*!
+     * Function to retrieve the current unit vector from accelerated body to source, in the inertial frame.
+     * \return Current unit vector from accelerated body to source.
+     */
+    Eigen::Vector3d getCurrentVectorToSource( )
+    {
+        return currentVectorToSource_;
+    }
+
+    //! Function to retrieve the current rotation from body-fixed frame of accelerated body to inertial frame.
+    /*!
+     * Function to retrieve the current rotation from body-fixed frame of accelerated body to inertial frame.
+     * \return Current rotation from body-fixed frame of accelerated body to inertial frame.
+     */
+    Eigen::Quaterniond getCurrentRotationToInertialFrame( )
+    {
+        return currentRotationToInertialFrame_;
+    }
+
+    //! Function to retrieve the current radiation pressure.
+    /*!
+     * Function to retrieve the current radiation pressure.
+     * \return Current radiation pressure.
+     */
+    double getCurrentRadiationPressure( )
+    {
+        return currentRadiationPressure_;
+    }
+
+    //! Function to retrieve the current mass of the accelerated body.
+    /*!
+     * Function to retrieve the current mass of the accelerated body.
+     * \return Current mass of the accelerated body.
+     */
+    double getCurrentMass( )
+    {
+        return currentMass_;
+    }
+
+private:
+
+    //! Function pointer returning position of source.
+    const Vector3dReturningFunction sourcePositionFunction_;
+
+    //! Function pointer returning position of accelerated body.
+    const Vector3dReturningFunction acceleratedBodyPositionFunction_;
+
+    //! Function pointer returning radiation pressure.
+    const DoubleReturningFunction radiationPressureFunction_;
+
+    //! Function returning rotation from body-fixed frame of accelerated body to inertial frame.
+    const boost::function< Eigen::Quaterniond( ) > rotationToInertialFrameFunction_;
+
+    //! Panelled surface model of accelerated body.
+    const boost::shared_ptr< system_models::PanelledSurfaceModel > panelledSurfaceModel_;
+
+    //! Function pointer returning mass.
+    const DoubleReturningFunction massFunction_;
+
+    //! Current unit vector from accelerated body to source, in the inertial frame.
+    Eigen::Vector3d currentVectorToSource_;
+
+    //! Current unit vector from accelerated body to source, in the body-fixed frame of the accelerated body.
+    Eigen::Vector3d currentVectorToSourceInBodyFixedFrame_;
+
+    //! Current rotation from body-fixed frame of accelerated body to inertial frame.
+    Eigen::Quaterniond currentRotationToInertialFrame_;
+
+    //! Current radiation pressure.
+    double currentRadiationPressure_;
+
+    //! Current mass.
+    double currentMass_;
+};
+
+//! Typedef for shared-pointer to PanelledRadiationPressureAcceleration.
+typedef boost::shared_ptr< PanelledRadiationPressureAcceleration > PanelledRadiationPressureAccelerationPointer;
+
+} // namespace electro_magnetism
+} // namespace tudat
+
+#endif // TUDAT_PANELLED_RADIATION_PRESSURE_ACCELERATION_H
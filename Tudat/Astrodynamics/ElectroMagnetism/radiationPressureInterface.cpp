@@ -9,9 +9,6 @@
  *
  */
 
-#include <iostream>
-
-#include "Tudat/Astrodynamics/BasicAstrodynamics/missionGeometry.h"
 #include "Tudat/Astrodynamics/ElectroMagnetism/radiationPressureInterface.h"
 
 
@@ -34,31 +31,19 @@ void RadiationPressureInterface::updateInterface(
 {
     currentTime_ = currentTime;
 
+    // Retrieve source and occulting body positions (only once per epoch, if occultation model is shared).
+    occultationModel_->updateBodyPositions( isOccultationModelShared_ ? currentTime : TUDAT_NAN );
+
     // Calculate current radiation pressure
-    currentSolarVector_ = sourcePositionFunction_( ) - targetPositionFunction_( );
+    Eigen::Vector3d targetPosition = targetPositionFunction_( );
+    currentSolarVector_ = occultationModel_->getCurrentSourcePosition( ) - targetPosition;
     double distanceFromSource = currentSolarVector_.norm( );
     currentRadiationPressure_ = calculateRadiationPressure(
                 sourcePower_( ), distanceFromSource );
 
-    // Calculate total shadowing due to occulting body; note that multiple concurrent
+    // Calculate total shadowing due to occulting bodies; note that multiple concurrent
     // occultations are not completely correctly (prints warning).
-    double shadowFunction = 1.0;
-    double currentShadowFunction = 1.0;
-    for( unsigned int i = 0; i < occultingBodyPositions_.size( ); i++ )
-    {
-        currentShadowFunction *= mission_geometry::computeShadowFunction(
-                    sourcePositionFunction_( ), sourceRadius_, occultingBodyPositions_[ i ]( ),
-                    occultingBodyRadii_[ i ], targetPositionFunction_( ) );
-
-        if( currentShadowFunction != 1.0 && shadowFunction != 1.0 )
-        {
-            std::cerr << "Warning, multiple occultation occured in radiation pressure interface, results may be slightly in error" << std::endl;
-        }
-
-        shadowFunction *= currentShadowFunction;
-    }
-
-    currentRadiationPressure_ *= shadowFunction;
+    currentRadiationPressure_ *= occultationModel_->computeShadowFunction( targetPosition );
 }
 
 } // namespace electro_magnetism
@@ -14,11 +14,15 @@
 
 #include <vector>
 
+#include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <Eigen/Core>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "Tudat/Astrodynamics/ElectroMagnetism/occultationModel.h"
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
 
 namespace tudat
@@ -60,6 +64,7 @@ public:
      *  result in slighlty underestimted radiation pressure.
      *  \param occultingBodyRadii List of radii of the bodies causing occultations (default none).
      *  \param sourceRadius Radius of the source body (used for occultation calculations) (default 0).
+     *  \param shadowFunctionType Model to use for the shadow function (default conical).
      */
     RadiationPressureInterface(
             const boost::function< double( ) > sourcePower,
@@ -70,13 +75,53 @@ public:
             const std::vector< boost::function< Eigen::Vector3d( ) > > occultingBodyPositions =
             std::vector< boost::function< Eigen::Vector3d( ) > >( ),
             const std::vector< double > occultingBodyRadii = std::vector< double > ( ),
-            const double sourceRadius = 0.0 ):
+            const double sourceRadius = 0.0,
+            const ShadowFunctionType shadowFunctionType = conical_shadow ):
         sourcePower_( sourcePower ), sourcePositionFunction_( sourcePositionFunction ),
         targetPositionFunction_( targetPositionFunction ),
         radiationPressureCoefficient_( radiationPressureCoefficient ), area_( area ),
         occultingBodyPositions_( occultingBodyPositions ),
         occultingBodyRadii_( occultingBodyRadii ),
         sourceRadius_( sourceRadius ),
+        occultationModel_( boost::make_shared< OccultationModel >(
+                               sourcePositionFunction, sourceRadius, occultingBodyPositions, occultingBodyRadii,
+                               shadowFunctionType ) ),
+        isOccultationModelShared_( false ),
+        currentRadiationPressure_( TUDAT_NAN ),
+        currentSolarVector_( Eigen::Vector3d::Zero( ) ),
+        currentTime_( TUDAT_NAN ){ }
+
+    //! Constructor, with occultation model that may be shared with other radiation pressure interfaces.
+    /*!
+     *  Constructor, with occultation model that may be shared with other radiation pressure interfaces (i.e. other
+     *  target bodies) with the same source and occulting bodies. In this way, the positions of the source and
+     *  occulting bodies are retrieved only once per epoch for all targets. Since these positions are then cached
+     *  per epoch, resetCurrentTime must be called (as done by the environment updater before each state derivative
+     *  evaluation) whenever the states of the source or occulting bodies are modified without changing the time
+     *  passed to updateInterface. The source and occulting body properties of this interface are taken from the
+     *  occultation model.
+     *  \param sourcePower Function returning the current total power (in W) emitted by the source
+     *  body.
+     *  \param occultationModel Model for the positions of the source and occulting bodies, and the shadow function.
+     *  \param targetPositionFunction Function returning the current position of the target body.
+     *  \param radiationPressureCoefficient Reflectivity coefficient of the target body.
+     *  \param area Reflecting area of the target body.
+     */
+    RadiationPressureInterface(
+            const boost::function< double( ) > sourcePower,
+            const boost::shared_ptr< OccultationModel > occultationModel,
+            const boost::function< Eigen::Vector3d( ) > targetPositionFunction,
+            const double radiationPressureCoefficient,
+            const double area ):
+        sourcePower_( sourcePower ),
+        sourcePositionFunction_( occultationModel->getSourcePositionFunction( ) ),
+        targetPositionFunction_( targetPositionFunction ),
+        radiationPressureCoefficient_( radiationPressureCoefficient ), area_( area ),
+        occultingBodyPositions_( occultationModel->getOccultingBodyPositions( ) ),
+        occultingBodyRadii_( occultationModel->getOccultingBodyRadii( ) ),
+        sourceRadius_( occultationModel->getSourceRadius( ) ),
+        occultationModel_( occultationModel ),
+        isOccultationModelShared_( true ),
         currentRadiationPressure_( TUDAT_NAN ),
         currentSolarVector_( Eigen::Vector3d::Zero( ) ),
         currentTime_( TUDAT_NAN ){ }
@@ -87,11 +132,25 @@ public:
     //! Function to update the current value of the radiation pressure
     /*!
      *  Function to update the current value of the radiation pressure, based on functions returning
-     *  the positions of the bodies involved and the source power.
+     *  the positions of the bodies involved and the source power. If the occultation model is shared with other
+     *  interfaces, the positions of the source and occulting bodies are only retrieved if the occultation model has
+     *  not yet been updated to currentTime (see resetCurrentTime); otherwise they are retrieved at each call.
      * \param currentTime Time at which acceleration model is to be updated.
      */
     void updateInterface( const double currentTime = TUDAT_NAN );
 
+    //! Function to reset the current time of the interface.
+    /*!
+     *  Function to reset the current time of the interface, and of its occultation model, to ensure that the positions
+     *  of the source and occulting bodies are retrieved anew at the next call to updateInterface.
+     *  \param currentTime New current time of the interface (default NaN).
+     */
+    void resetCurrentTime( const double currentTime = TUDAT_NAN )
+    {
+        currentTime_ = currentTime;
+        occultationModel_->resetCurrentTime( currentTime );
+    }
+
     //! Function to return the current radiation pressure due to source at target (in N/m^2).
     /*!
      *  Function to return the current radiation pressure due to source at target (in N/m^2).
@@ -217,6 +276,16 @@ public:
         return sourceRadius_;
     }
 
+    //! Function to return the model for the positions of the source and occulting bodies, and the shadow function.
+    /*!
+     *  Function to return the model for the positions of the source and occulting bodies, and the shadow function.
+     *  \return Model for the positions of the source and occulting bodies, and the shadow function.
+     */
+    boost::shared_ptr< OccultationModel > getOccultationModel( )
+    {
+        return occultationModel_;
+    }
+
 
 protected:
 
@@ -244,6 +313,12 @@ protected:
     //! Radius of the source body.
     double sourceRadius_;
 
+    //! Model for the positions of the source and occulting bodies, and the shadow function.
+    boost::shared_ptr< OccultationModel > occultationModel_;
+
+    //! Boolean denoting whether occultationModel_ was provided to constructor (positions then cached per epoch).
+    bool isOccultationModelShared_;
+
     //! Current radiation pressure due to source at target (in N/m^2).
     double currentRadiationPressure_;
 
@@ -0,0 +1,286 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Astrodynamics/Ephemerides/compositeEphemeris.h"
+#include "Tudat/Astrodynamics/Ephemerides/constantEphemeris.h"
+#include "Tudat/Astrodynamics/Ephemerides/frameManager.h"
+#include "Tudat/Astrodynamics/Ephemerides/keplerEphemeris.h"
+#include "Tudat/Basics/parallelization.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace ephemerides;
+
+//! Function to create a Keplerian ephemeris w.r.t. a given origin.
+boost::shared_ptr< Ephemeris > createTestKeplerEphemeris(
+        const double semiMajorAxis, const double eccentricity, const double inclination,
+        const double gravitationalParameter, const std::string& origin )
+{
+    Eigen::Vector6d keplerianElements;
+    keplerianElements << semiMajorAxis, eccentricity, inclination, 0.3, 1.2, 2.1;
+    return boost::make_shared< KeplerEphemeris >( keplerianElements, 0.0, gravitationalParameter, origin );
+}
+
+//! Function to create the ephemerides of a test frame hierarchy (SSB-Sun-Earth-Moon-LRO and SSB-Sun-Mars-Phobos).
+std::map< std::string, boost::shared_ptr< Ephemeris > > getTestEphemerides( )
+{
+    Eigen::Vector6d sunState;
+    sunState << 4.0E8, -7.0E8, 2.0E7, 12.0, 9.0, -0.3;
+
+    std::map< std::string, boost::shared_ptr< Ephemeris > > ephemerides;
+    ephemerides[ "Sun" ] = boost::make_shared< ConstantEphemeris >( sunState, "SSB" );
+    ephemerides[ "Earth" ] = createTestKeplerEphemeris( 1.496E11, 0.0167, 0.0, 1.327E20, "Sun" );
+    ephemerides[ "Mars" ] = createTestKeplerEphemeris( 2.279E11, 0.0934, 0.032, 1.327E20, "Sun" );
+    ephemerides[ "Moon" ] = createTestKeplerEphemeris( 3.844E8, 0.0549, 0.09, 4.035E14, "Earth" );
+    ephemerides[ "Phobos" ] = createTestKeplerEphemeris( 9.376E6, 0.0151, 0.019, 4.283E13, "Mars" );
+    ephemerides[ "LRO" ] = createTestKeplerEphemeris( 1.79E6, 0.01, 1.57, 4.903E12, "Moon" );
+    return ephemerides;
+}
+
+//! Function to create composite ephemeris from lists of ephemerides to add and subtract, as previously done by the
+//! frame manager.
+template< typename StateScalarType, typename TimeType >
+boost::shared_ptr< Ephemeris > createReferenceCompositeEphemeris(
+        const std::vector< boost::shared_ptr< Ephemeris > >& ephemeridesToAdd,
+        const std::vector< boost::shared_ptr< Ephemeris > >& ephemeridesToSubtract )
+{
+    typedef Eigen::Matrix< StateScalarType, 6, 1 > StateType;
+
+    std::map< int, std::pair< boost::function< StateType( const TimeType& ) >, bool > > ephemerisList;
+    for( unsigned int i = 0; i < ephemeridesToAdd.size( ); i++ )
+    {
+        ephemerisList[ ephemerisList.size( ) ] = std::make_pair(
+                    boost::bind( &Ephemeris::getTemplatedStateFromEphemeris< StateScalarType, TimeType >,
+                                 ephemeridesToAdd.at( i ), _1 ), true );
+    }
+    for( unsigned int i = 0; i < ephemeridesToSubtract.size( ); i++ )
+    {
+        ephemerisList[ ephemerisList.size( ) ] = std::make_pair(
+                    boost::bind( &Ephemeris::getTemplatedStateFromEphemeris< StateScalarType, TimeType >,
+                                 ephemeridesToSubtract.at( i ), _1 ), false );
+    }
+
+    return boost::make_shared< CompositeEphemeris< TimeType, StateScalarType > >(
+                ephemerisList, std::map< int, boost::function< StateType( const double, const StateType& ) > >( ) );
+}
+
+BOOST_AUTO_TEST_SUITE( test_frame_translation_chain )
+
+//! Test whether flattened frame chains reproduce the composite ephemerides previously created by the frame manager.
+BOOST_AUTO_TEST_CASE( testFrameTranslationChainStates )
+{
+    std::map< std::string, boost::shared_ptr< Ephemeris > > ephemerides = getTestEphemerides( );
+    ReferenceFrameManager frameManager( ephemerides );
+
+    // Define test cases: origin, body, ephemerides to add and ephemerides to subtract (from body/origin downward).
+    std::vector< std::pair< std::string, std::string > > framePairs;
+    std::vector< std::vector< boost::shared_ptr< Ephemeris > > > addedEphemerides;
+    std::vector< std::vector< boost::shared_ptr< Ephemeris > > > subtractedEphemerides;
+
+    // Common frame is neither origin nor body.
+    framePairs.push_back( std::make_pair( "Phobos", "LRO" ) );
+    addedEphemerides.push_back( { ephemerides[ "LRO" ], ephemerides[ "Moon" ], ephemerides[ "Earth" ] } );
+    subtractedEphemerides.push_back( { ephemerides[ "Phobos" ], ephemerides[ "Mars" ] } );
+
+    // Common frame is origin.
+    framePairs.push_back( std::make_pair( "SSB", "LRO" ) );
+    addedEphemerides.push_back(
+                { ephemerides[ "LRO" ], ephemerides[ "Moon" ], ephemerides[ "Earth" ], ephemerides[ "Sun" ] } );
+    subtractedEphemerides.push_back( { } );
+
+    // Common frame is body.
+    framePairs.push_back( std::make_pair( "Moon", "Earth" ) );
+    addedEphemerides.push_back( { } );
+    subtractedEphemerides.push_back( { ephemerides[ "Moon" ] } );
+
+    // Frames at equal level.
+    framePairs.push_back( std::make_pair( "Earth", "Mars" ) );
+    addedEphemerides.push_back( { ephemerides[ "Mars" ] } );
+    subtractedEphemerides.push_back( { ephemerides[ "Earth" ] } );
+
+    for( unsigned int i = 0; i < framePairs.size( ); i++ )
+    {
+        boost::shared_ptr< Ephemeris > frameChain =
+                frameManager.getEphemeris( framePairs.at( i ).first, framePairs.at( i ).second );
+        boost::shared_ptr< Ephemeris > referenceEphemeris = createReferenceCompositeEphemeris< double, double >(
+                    addedEphemerides.at( i ), subtractedEphemerides.at( i ) );
+
+        BOOST_CHECK_EQUAL( frameChain->getReferenceFrameOrigin( ), framePairs.at( i ).first );
+
+        typedef FrameTranslationChain< double, double > DoubleFrameTranslationChain;
+        BOOST_CHECK_EQUAL(
+                    boost::dynamic_pointer_cast< DoubleFrameTranslationChain >( frameChain )->getFrameIndices( ).size( ),
+                    addedEphemerides.at( i ).size( ) + subtractedEphemerides.at( i ).size( ) );
+
+        // Check that states are identical, including repeated evaluations at the same epoch (from cache).
+        for( unsigned int j = 0; j < 10; j++ )
+        {
+            const double currentTime = 1.0E6 * static_cast< double >( j / 2 );
+            Eigen::Vector6d chainState = frameChain->getCartesianState( currentTime );
+            Eigen::Vector6d referenceState = referenceEphemeris->getCartesianState( currentTime );
+            for( unsigned int k = 0; k < 6; k++ )
+            {
+                BOOST_CHECK_EQUAL( chainState( k ), referenceState( k ) );
+            }
+        }
+    }
+
+    // Check state of frame w.r.t. itself.
+    BOOST_CHECK_EQUAL( frameManager.getEphemeris( "Moon", "Moon" )->getCartesianState( 1.0E6 ).norm( ), 0.0 );
+
+    // Check that unknown frames are rejected.
+    BOOST_CHECK_THROW( frameManager.getEphemeris( "Moon", "Jupiter" ), std::runtime_error );
+    BOOST_CHECK_THROW( frameManager.getEphemeris( "Jupiter", "Moon" ), std::runtime_error );
+}
+
+//! Test chains with extended time and/or state scalar types.
+BOOST_AUTO_TEST_CASE( testFrameTranslationChainStateTypes )
+{
+    std::map< std::string, boost::shared_ptr< Ephemeris > > ephemerides = getTestEphemerides( );
+    ReferenceFrameManager frameManager( ephemerides );
+
+    std::vector< boost::shared_ptr< Ephemeris > > addedEphemerides =
+    { ephemerides[ "LRO" ], ephemerides[ "Moon" ], ephemerides[ "Earth" ] };
+    std::vector< boost::shared_ptr< Ephemeris > > subtractedEphemerides =
+    { ephemerides[ "Phobos" ], ephemerides[ "Mars" ] };
+
+    boost::shared_ptr< Ephemeris > longFrameChain = frameManager.getEphemeris< long double, double >( "Phobos", "LRO" );
+    boost::shared_ptr< Ephemeris > longReferenceEphemeris = createReferenceCompositeEphemeris< long double, double >(
+                addedEphemerides, subtractedEphemerides );
+
+    boost::shared_ptr< Ephemeris > extendedTimeFrameChain = frameManager.getEphemeris< long double, Time >(
+                "Phobos", "LRO" );
+    boost::shared_ptr< Ephemeris > extendedTimeReferenceEphemeris =
+            createReferenceCompositeEphemeris< long double, Time >( addedEphemerides, subtractedEphemerides );
+
+    for( unsigned int j = 0; j < 5; j++ )
+    {
+        const double currentTime = 3.0E5 * static_cast< double >( j );
+        Eigen::Matrix< long double, 6, 1 > chainState = longFrameChain->getCartesianLongState( currentTime );
+        Eigen::Matrix< long double, 6, 1 > referenceState = longReferenceEphemeris->getCartesianLongState( currentTime );
+
+        Eigen::Matrix< long double, 6, 1 > extendedTimeChainState =
+                extendedTimeFrameChain->getCartesianLongStateFromExtendedTime( Time( currentTime ) );
+        Eigen::Matrix< long double, 6, 1 > extendedTimeReferenceState =
+                extendedTimeReferenceEphemeris->getCartesianLongStateFromExtendedTime( Time( currentTime ) );
+        for( unsigned int k = 0; k < 6; k++ )
+        {
+            BOOST_CHECK_EQUAL( chainState( k ), referenceState( k ) );
+            BOOST_CHECK_EQUAL( extendedTimeChainState( k ), extendedTimeReferenceState( k ) );
+        }
+    }
+}
+
+//! Test whether the frame state cache is correctly updated when an ephemeris is modified.
+BOOST_AUTO_TEST_CASE( testFrameStateCacheReset )
+{
+    std::map< std::string, boost::shared_ptr< Ephemeris > > ephemerides = getTestEphemerides( );
+    ReferenceFrameManager frameManager( ephemerides );
+
+    boost::shared_ptr< Ephemeris > frameChain = frameManager.getEphemeris( "SSB", "Moon" );
+    const Eigen::Vector6d initialState = frameChain->getCartesianState( 1.0E6 );
+    const unsigned int initialSunEphemerisVersion = ephemerides[ "Sun" ]->getEphemerisVersion( );
+
+    // Modify state of Sun w.r.t. SSB.
+    Eigen::Vector6d newSunState = Eigen::Vector6d::Zero( );
+    newSunState( 0 ) = 1.0E9;
+    boost::dynamic_pointer_cast< ConstantEphemeris >( ephemerides[ "Sun" ] )->updateConstantState( newSunState );
+    BOOST_CHECK_EQUAL( ephemerides[ "Sun" ]->getEphemerisVersion( ), initialSunEphemerisVersion + 1 );
+
+    // Check that modification is detected at the same epoch, without resetting the cache.
+    const Eigen::Vector6d expectedState = newSunState + ephemerides[ "Earth" ]->getCartesianState( 1.0E6 ) +
+            ephemerides[ "Moon" ]->getCartesianState( 1.0E6 );
+    const Eigen::Vector6d newState = frameChain->getCartesianState( 1.0E6 );
+    BOOST_CHECK( ( newState - initialState ).norm( ) > 0.0 );
+    for( unsigned int k = 0; k < 6; k++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( newState( k ), expectedState( k ), 1.0E-15 );
+    }
+
+    // Check that explicit reset of cache leaves states unchanged.
+    frameManager.resetFrameStateCaches( );
+    BOOST_CHECK_EQUAL( ( frameChain->getCartesianState( 1.0E6 ) - newState ).norm( ), 0.0 );
+
+    // Chains created after the reset use the same (updated) cache.
+    BOOST_CHECK_EQUAL( ( frameManager.getEphemeris( "SSB", "Moon" )->getCartesianState( 1.0E6 ) - newState ).norm( ),
+                       0.0 );
+}
+
+//! Test whether chains sharing a single frame state cache can be evaluated concurrently.
+BOOST_AUTO_TEST_CASE( testFrameTranslationChainConcurrency )
+{
+    std::map< std::string, boost::shared_ptr< Ephemeris > > ephemerides = getTestEphemerides( );
+    ReferenceFrameManager frameManager( ephemerides );
+
+    std::vector< boost::shared_ptr< Ephemeris > > frameChains;
+    std::vector< boost::shared_ptr< Ephemeris > > referenceEphemerides;
+    frameChains.push_back( frameManager.getEphemeris( "Phobos", "LRO" ) );
+    referenceEphemerides.push_back( createReferenceCompositeEphemeris< double, double >(
+                { ephemerides[ "LRO" ], ephemerides[ "Moon" ], ephemerides[ "Earth" ] },
+                { ephemerides[ "Phobos" ], ephemerides[ "Mars" ] } ) );
+    frameChains.push_back( frameManager.getEphemeris( "Mars", "LRO" ) );
+    referenceEphemerides.push_back( createReferenceCompositeEphemeris< double, double >(
+                { ephemerides[ "LRO" ], ephemerides[ "Moon" ], ephemerides[ "Earth" ] },
+                { ephemerides[ "Mars" ] } ) );
+    frameChains.push_back( frameManager.getEphemeris( "Earth", "LRO" ) );
+    referenceEphemerides.push_back( createReferenceCompositeEphemeris< double, double >(
+                { ephemerides[ "LRO" ], ephemerides[ "Moon" ] }, { } ) );
+    frameChains.push_back( frameManager.getEphemeris( "SSB", "Phobos" ) );
+    referenceEphemerides.push_back( createReferenceCompositeEphemeris< double, double >(
+                { ephemerides[ "Phobos" ], ephemerides[ "Mars" ], ephemerides[ "Sun" ] }, { } ) );
+
+    // Compute reference states.
+    const unsigned int numberOfEpochs = 2000;
+    std::vector< Eigen::Vector6d > referenceStates( numberOfEpochs * frameChains.size( ) );
+    for( unsigned int i = 0; i < numberOfEpochs; i++ )
+    {
+        for( unsigned int j = 0; j < referenceEphemerides.size( ); j++ )
+        {
+            referenceStates[ i * frameChains.size( ) + j ] =
+                    referenceEphemerides.at( j )->getCartesianState( 60.0 * static_cast< double >( i ) );
+        }
+    }
+
+    // Evaluate chains concurrently, with each thread evaluating all chains at its own epochs.
+    std::vector< Eigen::Vector6d > chainStates( numberOfEpochs * frameChains.size( ) );
+    utilities::executeParallelLoop(
+                numberOfEpochs, [ & ]( const unsigned int i )
+    {
+        for( unsigned int j = 0; j < frameChains.size( ); j++ )
+        {
+            chainStates[ i * frameChains.size( ) + j ] =
+                    frameChains.at( j )->getCartesianState( 60.0 * static_cast< double >( i ) );
+        }
+    }, 4 );
+
+    for( unsigned int i = 0; i < chainStates.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( ( chainStates.at( i ) - referenceStates.at( i ) ).norm( ), 0.0 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,211 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Petit, G. and Luzum, B. (eds.), IERS Conventions (2010), IERS Technical Note 36, 2010.
+ *      IAU SOFA Board, SOFA Tools for Earth Attitude, 2017.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
+#include "Tudat/Astrodynamics/Ephemerides/gcrsToItrsRotationModel.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::ephemerides;
+
+BOOST_AUTO_TEST_SUITE( test_gcrs_to_itrs_rotation_model )
+
+//! Test reading of series file, in the format of the IERS Conventions tables.
+BOOST_AUTO_TEST_CASE( testEarthOrientationSeriesReading )
+{
+    // Write part of table 5.2a to a file.
+    std::string fileName = "testCipXSeries.txt";
+    {
+        std::ofstream seriesFile( fileName.c_str( ) );
+        seriesFile << "Expression for the X coordinate of the CIP in the GCRS\n"
+                   << "----------------------------------------------------------------------\n"
+                   << "j = 0  Number of terms = 2\n"
+                   << "  1   -6844318.44   1328.67   0  0  0  0  1  0  0  0  0  0  0  0  0  0\n"
+                   << "  2    -523908.04  -3309.56   0  0  2 -2  2  0  0  0  0  0  0  0  0  0\n"
+                   << "j = 1  Number of terms = 1\n"
+                   << "  3    -3328.48   205833.15   0  0  0  0  1  0  0  0  0  0  0  0  0  0\n"
+                   << "\n";
+    }
+
+    EarthOrientationSeries series = readEarthOrientationSeries( fileName, cip_x_coordinate );
+    std::remove( fileName.c_str( ) );
+    BOOST_CHECK_EQUAL( series.getNumberOfTerms( ), 3 );
+
+    // Compare to manual evaluation.
+    const double microarcsecondsToRadians = mathematical_constants::PI / ( 180.0 * 3600.0 * 1.0E6 );
+    for( double julianCenturies = -0.5; julianCenturies < 0.5; julianCenturies += 0.07 )
+    {
+        FundamentalArgumentsVector arguments = computeFundamentalArguments( julianCenturies );
+        Eigen::VectorXd polynomialCoefficients = getEarthOrientationSeriesPolynomialCoefficients( cip_x_coordinate );
+        double expectedValue = 0.0;
+        for( int i = 0; i < polynomialCoefficients.rows( ); i++ )
+        {
+            expectedValue += polynomialCoefficients( i ) * std::pow( julianCenturies, i );
+        }
+        double omega = arguments( 4 );
+        double secondArgument = 2.0 * arguments( 2 ) - 2.0 * arguments( 3 ) + 2.0 * arguments( 4 );
+        expectedValue += microarcsecondsToRadians * (
+                    -6844318.44 * std::sin( omega ) + 1328.67 * std::cos( omega ) +
+                    -523908.04 * std::sin( secondArgument ) - 3309.56 * std::cos( secondArgument ) +
+                    julianCenturies * ( -3328.48 * std::sin( omega ) + 205833.15 * std::cos( omega ) ) );
+
+        BOOST_CHECK_SMALL( series.evaluate( julianCenturies, arguments ) - expectedValue, 1.0E-16 );
+    }
+
+    BOOST_CHECK_THROW( readEarthOrientationSeries( "nonExistentSeriesFile.txt", cip_x_coordinate ),
+                       std::runtime_error );
+}
+
+//! Test reading and interpolation of Earth orientation parameters, over a leap second (2016-12-31).
+BOOST_AUTO_TEST_CASE( testEarthOrientationParameters )
+{
+    std::string fileName = "testEopFile.txt";
+    {
+        std::ofstream eopFile( fileName.c_str( ) );
+        eopFile << "  EARTH ORIENTATION PARAMETER (EOP) PRODUCT CENTER CENTER (PARIS OBSERVATORY)\n"
+                << "2016  12  28  57750   0.083123   0.260541  -0.5904660   0.0008560   0.000220  -0.000054\n"
+                << "2016  12  29  57751   0.081654   0.260929  -0.5912780   0.0007869   0.000209  -0.000071\n"
+                << "2016  12  30  57752   0.080246   0.261301  -0.5919930   0.0006497   0.000193  -0.000088\n"
+                << "2016  12  31  57753   0.078810   0.261723  -0.5925720   0.0005157   0.000176  -0.000101\n"
+                << "2017   1   1  57754   0.077364   0.262140   0.4069940   0.0004102   0.000160  -0.000108\n"
+                << "2017   1   2  57755   0.075933   0.262550   0.4066340   0.0003230   0.000146  -0.000112\n"
+                << "2017   1   3  57756   0.074555   0.263026   0.4063710   0.0002260   0.000134  -0.000114\n"
+                << "2017   1   4  57757   0.073204   0.263516   0.4062150   0.0001005   0.000126  -0.000114\n";
+    }
+
+    boost::shared_ptr< EarthOrientationParameters > earthOrientationParameters =
+            readEarthOrientationParameters( fileName );
+    std::remove( fileName.c_str( ) );
+
+    const double arcsecondsToRadians = mathematical_constants::PI / ( 180.0 * 3600.0 );
+
+    // Check values at nodes, before and after leap second.
+    double timeBeforeLeapSecond = ( 57752.0 + basic_astrodynamics::JULIAN_DAY_AT_0_MJD -
+                                    basic_astrodynamics::JULIAN_DAY_ON_J2000 ) * physical_constants::JULIAN_DAY + 68.184;
+    EarthOrientationParametersVector parameters = earthOrientationParameters->getParameters( timeBeforeLeapSecond );
+    BOOST_CHECK_SMALL( parameters( 0 ) - 0.080246 * arcsecondsToRadians, 1.0E-15 );
+    BOOST_CHECK_SMALL( parameters( 1 ) - 0.261301 * arcsecondsToRadians, 1.0E-15 );
+    BOOST_CHECK_SMALL( parameters( 2 ) - ( -0.5919930 - 68.184 ), 1.0E-10 );
+    BOOST_CHECK_SMALL( parameters( 3 ) - 0.000193 * arcsecondsToRadians, 1.0E-15 );
+    BOOST_CHECK_SMALL( parameters( 4 ) + 0.000088 * arcsecondsToRadians, 1.0E-15 );
+
+    double timeAfterLeapSecond = ( 57755.0 + basic_astrodynamics::JULIAN_DAY_AT_0_MJD -
+                                   basic_astrodynamics::JULIAN_DAY_ON_J2000 ) * physical_constants::JULIAN_DAY + 69.184;
+    parameters = earthOrientationParameters->getParameters( timeAfterLeapSecond );
+    BOOST_CHECK_SMALL( parameters( 2 ) - ( 0.4066340 - 69.184 ), 1.0E-10 );
+
+    // Check that UT1 - TT is continuous (and smooth) over the leap second.
+    double previousValue = TUDAT_NAN;
+    for( double time = timeBeforeLeapSecond; time < timeAfterLeapSecond; time += 3600.0 )
+    {
+        double currentValue = earthOrientationParameters->getParameters( time )( 2 );
+        if( time > timeBeforeLeapSecond )
+        {
+            BOOST_CHECK_SMALL( currentValue - previousValue, 1.0E-4 );
+        }
+        previousValue = currentValue;
+    }
+
+    BOOST_CHECK_THROW( earthOrientationParameters->getParameters( timeAfterLeapSecond + 5.0 * 86400.0 ),
+                       std::runtime_error );
+}
+
+//! Test computation of GCRS to ITRS rotation.
+BOOST_AUTO_TEST_CASE( testGcrsToItrsRotation )
+{
+    // Check Earth rotation angle at J2000.
+    BOOST_CHECK_SMALL( computeEarthRotationAngle( 0.0 ) - 2.0 * mathematical_constants::PI * 0.7790572732640,
+                       1.0E-14 );
+
+    EarthOrientationSeries cipXSeries = getTruncatedEarthOrientationSeries( cip_x_coordinate );
+    EarthOrientationSeries cipYSeries = getTruncatedEarthOrientationSeries( cip_y_coordinate );
+    EarthOrientationSeries cioLocatorSeries = getTruncatedEarthOrientationSeries( cio_locator_plus_half_xy );
+
+    // Create rotation models with and without grid.
+    double gridStartTime = 2.0E8;
+    double gridEndTime = 2.0E8 + 30.0 * 86400.0;
+    GcrsToItrsRotationModel directRotationModel( cipXSeries, cipYSeries, cioLocatorSeries );
+    GcrsToItrsRotationModel interpolatedRotationModel(
+                cipXSeries, cipYSeries, cioLocatorSeries, boost::shared_ptr< EarthOrientationParameters >( ),
+                gridStartTime, gridEndTime, 3600.0 );
+
+    // Check CIP coordinates against SOFA cookbook values for 2007-04-05 12:00 UTC (TT = UTC + 65.184 s), with
+    // tolerance of truncated series.
+    double ttTime = ( 2454196.0 - basic_astrodynamics::JULIAN_DAY_ON_J2000 ) * physical_constants::JULIAN_DAY + 65.184;
+    Eigen::Vector3d cipCoordinatesAndCioLocator = directRotationModel.getCipCoordinatesAndCioLocator( ttTime );
+    BOOST_CHECK_SMALL( cipCoordinatesAndCioLocator( 0 ) - 0.712264729525E-3, 1.0E-6 );
+    BOOST_CHECK_SMALL( cipCoordinatesAndCioLocator( 1 ) - 0.44385248875E-4, 1.0E-6 );
+    BOOST_CHECK_SMALL( cipCoordinatesAndCioLocator( 2 ) +
+                       0.002200475 * mathematical_constants::PI / ( 180.0 * 3600.0 ), 1.0E-10 );
+    BOOST_CHECK_SMALL( directRotationModel.getUt1MinusTt( ttTime ) + 65.184, 1.0E-12 );
+
+    for( double time = gridStartTime; time <= gridEndTime; time += 86400.0 / 7.0 )
+    {
+        // Check interpolated X, Y and s.
+        Eigen::Vector3d directValue = directRotationModel.computeCipCoordinatesAndCioLocator( time );
+        Eigen::Vector3d interpolatedValue = interpolatedRotationModel.getCipCoordinatesAndCioLocator( time );
+        BOOST_CHECK_SMALL( ( directValue - interpolatedValue ).cwiseAbs( ).maxCoeff( ), 1.0E-14 );
+
+        // Check that rotation matrix is orthonormal, and consistent with interpolated model.
+        Eigen::Matrix3d rotationToBaseFrame = Eigen::Matrix3d( directRotationModel.getRotationToBaseFrame( time ) );
+        BOOST_CHECK_SMALL( ( rotationToBaseFrame * rotationToBaseFrame.transpose( ) -
+                             Eigen::Matrix3d::Identity( ) ).cwiseAbs( ).maxCoeff( ), 1.0E-14 );
+        BOOST_CHECK_SMALL( ( rotationToBaseFrame - Eigen::Matrix3d(
+                                 interpolatedRotationModel.getRotationToBaseFrame( time ) ) ).cwiseAbs( ).maxCoeff( ),
+                           1.0E-13 );
+        BOOST_CHECK_SMALL( ( rotationToBaseFrame.transpose( ) - Eigen::Matrix3d(
+                                 directRotationModel.getRotationToTargetFrame( time ) ) ).cwiseAbs( ).maxCoeff( ),
+                           1.0E-15 );
+
+        // Check rotation matrix derivative with central difference.
+        double timeStep = 10.0;
+        Eigen::Matrix3d numericalDerivative =
+                ( Eigen::Matrix3d( directRotationModel.getRotationToBaseFrame( time + timeStep ) ) -
+                  Eigen::Matrix3d( directRotationModel.getRotationToBaseFrame( time - timeStep ) ) ) /
+                ( 2.0 * timeStep );
+        BOOST_CHECK_SMALL( ( directRotationModel.getDerivativeOfRotationToBaseFrame( time ) -
+                             numericalDerivative ).cwiseAbs( ).maxCoeff( ), 1.0E-11 );
+        BOOST_CHECK_SMALL( ( directRotationModel.getDerivativeOfRotationToTargetFrame( time ) -
+                             numericalDerivative.transpose( ) ).cwiseAbs( ).maxCoeff( ), 1.0E-11 );
+    }
+
+    // Check that z-axis of ITRS is along CIP (without polar motion).
+    double time = gridStartTime + 1234.0;
+    double ttTimeOfTest = time - ( basic_astrodynamics::approximateConvertTTtoTDB( time ) - time );
+    Eigen::Vector3d cipCoordinates = directRotationModel.getCipCoordinatesAndCioLocator( ttTimeOfTest );
+    Eigen::Vector3d itrsZAxisInGcrs = directRotationModel.getRotationToBaseFrame( time ) * Eigen::Vector3d::UnitZ( );
+    BOOST_CHECK_SMALL( itrsZAxisInGcrs.x( ) - cipCoordinates( 0 ), 1.0E-15 );
+    BOOST_CHECK_SMALL( itrsZAxisInGcrs.y( ) - cipCoordinates( 1 ), 1.0E-15 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
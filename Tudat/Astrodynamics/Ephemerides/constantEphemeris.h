@@ -76,6 +76,7 @@ public:
     void updateConstantState( const Eigen::Vector6d& newState )
     {
         constantStateFunction_ = boost::lambda::constant( newState );
+        incrementEphemerisVersion( );
     }
 
 private:
@@ -0,0 +1,504 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+
+#include <Eigen/Geometry>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
+#include "Tudat/Astrodynamics/Ephemerides/earthOrientationCalculator.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Conversion factor from arcseconds to radians.
+static const double ARCSECONDS_TO_RADIANS = mathematical_constants::PI / ( 180.0 * 3600.0 );
+
+//! Number of arcseconds in a full circle.
+static const double ARCSECONDS_IN_FULL_CIRCLE = 1296000.0;
+
+//! Conversion factor from microarcseconds to radians.
+static const double MICROARCSECONDS_TO_RADIANS = 1.0E-6 * ARCSECONDS_TO_RADIANS;
+
+//! Function to compute the fundamental arguments of the IAU 2006/2000A precession-nutation theory.
+FundamentalArgumentsVector computeFundamentalArguments( const double julianCenturiesSinceJ2000 )
+{
+    const double t = julianCenturiesSinceJ2000;
+
+    // Compute Delaunay arguments (in arcseconds, reduced to single revolution before conversion).
+    FundamentalArgumentsVector fundamentalArguments;
+    fundamentalArguments( 0 ) = std::fmod( 485868.249036 + t * 1717915923.2178, ARCSECONDS_IN_FULL_CIRCLE ) +
+            t * t * ( 31.8792 + t * ( 0.051635 - t * 0.00024470 ) );
+    fundamentalArguments( 1 ) = std::fmod( 1287104.79305 + t * 129596581.0481, ARCSECONDS_IN_FULL_CIRCLE ) +
+            t * t * ( -0.5532 + t * ( 0.000136 - t * 0.00001149 ) );
+    fundamentalArguments( 2 ) = std::fmod( 335779.526232 + t * 1739527262.8478, ARCSECONDS_IN_FULL_CIRCLE ) +
+            t * t * ( -12.7512 + t * ( -0.001037 + t * 0.00000417 ) );
+    fundamentalArguments( 3 ) = std::fmod( 1072260.70369 + t * 1602961601.2090, ARCSECONDS_IN_FULL_CIRCLE ) +
+            t * t * ( -6.3706 + t * ( 0.006593 - t * 0.00003169 ) );
+    fundamentalArguments( 4 ) = std::fmod( 450160.398036 - t * 6962890.5431, ARCSECONDS_IN_FULL_CIRCLE ) +
+            t * t * ( 7.4722 + t * ( 0.007702 - t * 0.00005939 ) );
+    fundamentalArguments.segment( 0, 5 ) *= ARCSECONDS_TO_RADIANS;
+
+    // Compute planetary arguments (in radians).
+    fundamentalArguments( 5 ) = 4.402608842 + 2608.7903141574 * t;
+    fundamentalArguments( 6 ) = 3.176146697 + 1021.3285546211 * t;
+    fundamentalArguments( 7 ) = 1.753470314 + 628.3075849991 * t;
+    fundamentalArguments( 8 ) = 6.203480913 + 334.0612426700 * t;
+    fundamentalArguments( 9 ) = 0.599546497 + 52.9690962641 * t;
+    fundamentalArguments( 10 ) = 0.874016757 + 21.3299104960 * t;
+    fundamentalArguments( 11 ) = 5.481293872 + 7.4781598567 * t;
+    fundamentalArguments( 12 ) = 5.311886287 + 3.8133035638 * t;
+    fundamentalArguments( 13 ) = ( 0.02438175 + 0.00000538691 * t ) * t;
+
+    return fundamentalArguments;
+}
+
+//! Constructor.
+EarthOrientationSeries::EarthOrientationSeries(
+        const Eigen::VectorXd& polynomialCoefficients,
+        const std::vector< Eigen::MatrixXd >& argumentMultipliers,
+        const std::vector< Eigen::VectorXd >& sineAmplitudes,
+        const std::vector< Eigen::VectorXd >& cosineAmplitudes ):
+    polynomialCoefficients_( polynomialCoefficients ), argumentMultipliers_( argumentMultipliers ),
+    sineAmplitudes_( sineAmplitudes ), cosineAmplitudes_( cosineAmplitudes )
+{
+    if( argumentMultipliers_.size( ) != sineAmplitudes_.size( ) ||
+            argumentMultipliers_.size( ) != cosineAmplitudes_.size( ) )
+    {
+        throw std::runtime_error( "Error when creating Earth orientation series, inconsistent number of powers." );
+    }
+
+    for( unsigned int i = 0; i < argumentMultipliers_.size( ); i++ )
+    {
+        if( argumentMultipliers_.at( i ).cols( ) != 14 ||
+                argumentMultipliers_.at( i ).rows( ) != sineAmplitudes_.at( i ).rows( ) ||
+                argumentMultipliers_.at( i ).rows( ) != cosineAmplitudes_.at( i ).rows( ) )
+        {
+            throw std::runtime_error( "Error when creating Earth orientation series, inconsistent number of terms." );
+        }
+    }
+}
+
+//! Function to evaluate the series.
+double EarthOrientationSeries::evaluate( const double julianCenturiesSinceJ2000,
+                                         const FundamentalArgumentsVector& fundamentalArguments ) const
+{
+    // Evaluate polynomial part.
+    double value = 0.0;
+    for( int i = polynomialCoefficients_.rows( ) - 1; i >= 0; i-- )
+    {
+        value = value * julianCenturiesSinceJ2000 + polynomialCoefficients_( i );
+    }
+
+    // Evaluate periodic part, for all powers of time.
+    double currentTimePower = 1.0;
+    Eigen::ArrayXd currentArguments;
+    for( unsigned int j = 0; j < argumentMultipliers_.size( ); j++ )
+    {
+        if( argumentMultipliers_.at( j ).rows( ) > 0 )
+        {
+            currentArguments = ( argumentMultipliers_.at( j ) * fundamentalArguments ).array( );
+            value += currentTimePower * (
+                        ( sineAmplitudes_.at( j ).array( ) * currentArguments.sin( ) ).sum( ) +
+                        ( cosineAmplitudes_.at( j ).array( ) * currentArguments.cos( ) ).sum( ) );
+        }
+        currentTimePower *= julianCenturiesSinceJ2000;
+    }
+
+    return value;
+}
+
+//! Function to return the total number of periodic terms in the series.
+int EarthOrientationSeries::getNumberOfTerms( ) const
+{
+    int numberOfTerms = 0;
+    for( unsigned int j = 0; j < argumentMultipliers_.size( ); j++ )
+    {
+        numberOfTerms += argumentMultipliers_.at( j ).rows( );
+    }
+    return numberOfTerms;
+}
+
+//! Function to retrieve the polynomial part of the IAU 2006/2000A series of a CIP or CIO quantity.
+Eigen::VectorXd getEarthOrientationSeriesPolynomialCoefficients( const EarthOrientationSeriesType seriesType )
+{
+    // Set coefficients in microarcseconds.
+    Eigen::VectorXd polynomialCoefficients = Eigen::VectorXd( 6 );
+    switch( seriesType )
+    {
+    case cip_x_coordinate:
+        polynomialCoefficients << -16617.0, 2004191898.0, -429782.9, -198618.34, 7.578, 5.9285;
+        break;
+    case cip_y_coordinate:
+        polynomialCoefficients << -6951.0, -25896.0, -22407274.7, 1900.59, 1112.526, 0.1358;
+        break;
+    case cio_locator_plus_half_xy:
+        polynomialCoefficients << 94.0, 3808.65, -122.68, -72574.11, 27.98, 15.62;
+        break;
+    default:
+        throw std::runtime_error( "Error, did not recognize Earth orientation series type." );
+    }
+
+    return polynomialCoefficients * MICROARCSECONDS_TO_RADIANS;
+}
+
+//! Function to create a series from a list of terms (with amplitudes in microarcseconds).
+EarthOrientationSeries createEarthOrientationSeriesFromTerms(
+        const EarthOrientationSeriesType seriesType,
+        const std::vector< std::vector< std::vector< double > > >& termsPerPower )
+{
+    std::vector< Eigen::MatrixXd > argumentMultipliers;
+    std::vector< Eigen::VectorXd > sineAmplitudes;
+    std::vector< Eigen::VectorXd > cosineAmplitudes;
+    for( unsigned int j = 0; j < termsPerPower.size( ); j++ )
+    {
+        int numberOfTerms = termsPerPower.at( j ).size( );
+        argumentMultipliers.push_back( Eigen::MatrixXd::Zero( numberOfTerms, 14 ) );
+        sineAmplitudes.push_back( Eigen::VectorXd::Zero( numberOfTerms ) );
+        cosineAmplitudes.push_back( Eigen::VectorXd::Zero( numberOfTerms ) );
+
+        for( int i = 0; i < numberOfTerms; i++ )
+        {
+            const std::vector< double >& currentTerm = termsPerPower.at( j ).at( i );
+            sineAmplitudes[ j ]( i ) = currentTerm.at( 0 ) * MICROARCSECONDS_TO_RADIANS;
+            cosineAmplitudes[ j ]( i ) = currentTerm.at( 1 ) * MICROARCSECONDS_TO_RADIANS;
+            for( int k = 0; k < 14; k++ )
+            {
+                argumentMultipliers[ j ]( i, k ) = currentTerm.at( k + 2 );
+            }
+        }
+    }
+
+    return EarthOrientationSeries(
+                getEarthOrientationSeriesPolynomialCoefficients( seriesType ),
+                argumentMultipliers, sineAmplitudes, cosineAmplitudes );
+}
+
+//! Function to read the periodic terms of a CIP or CIO series from a file in the IERS format.
+EarthOrientationSeries readEarthOrientationSeries( const std::string& fileName,
+                                                   const EarthOrientationSeriesType seriesType )
+{
+    std::ifstream seriesFile( fileName.c_str( ) );
+    if( !seriesFile.good( ) )
+    {
+        throw std::runtime_error( "Error when reading Earth orientation series, could not open file " + fileName );
+    }
+
+    std::vector< std::vector< std::vector< double > > > termsPerPower;
+    int currentPower = -1;
+
+    std::string currentLine;
+    while( std::getline( seriesFile, currentLine ) )
+    {
+        // Check if line starts new block of terms.
+        std::size_t powerPosition = currentLine.find( "j =" );
+        if( powerPosition != std::string::npos )
+        {
+            std::istringstream powerStream( currentLine.substr( powerPosition + 3 ) );
+            if( !( powerStream >> currentPower ) || currentPower < 0 )
+            {
+                throw std::runtime_error( "Error when reading Earth orientation series, could not parse line: " +
+                                          currentLine );
+            }
+            if( static_cast< int >( termsPerPower.size( ) ) <= currentPower )
+            {
+                termsPerPower.resize( currentPower + 1 );
+            }
+            continue;
+        }
+
+        // Parse line as term (index, sine and cosine amplitude, 14 argument multipliers).
+        std::istringstream lineStream( currentLine );
+        std::vector< double > lineValues;
+        double currentValue;
+        while( lineStream >> currentValue )
+        {
+            lineValues.push_back( currentValue );
+        }
+        if( lineValues.size( ) == 17 && lineStream.eof( ) && currentPower >= 0 )
+        {
+            termsPerPower[ currentPower ].push_back( std::vector< double >( lineValues.begin( ) + 1,
+                                                                            lineValues.end( ) ) );
+        }
+    }
+
+    if( termsPerPower.size( ) == 0 )
+    {
+        throw std::runtime_error( "Error when reading Earth orientation series, no terms found in file " + fileName );
+    }
+
+    return createEarthOrientationSeriesFromTerms( seriesType, termsPerPower );
+}
+
+//! Function to retrieve a truncated IAU 2006/2000A series of a CIP or CIO quantity.
+EarthOrientationSeries getTruncatedEarthOrientationSeries( const EarthOrientationSeriesType seriesType )
+{
+    // Dominant terms (sine amplitude, cosine amplitude in microarcseconds, multipliers of l, l', F, D, Omega; planetary
+    // multipliers are zero), from Petit and Luzum (2010, tabs. 5.2a, 5.2b and 5.2d).
+    std::vector< std::vector< std::vector< double > > > termsPerPower;
+
+    switch( seriesType )
+    {
+    case cip_x_coordinate:
+    {
+        static const double xTerms[ 4 ][ 7 ] = {
+            { -6844318.44, 1328.67, 0, 0, 0, 0, 1 },
+            { -523908.04, -3309.56, 0, 0, 2, -2, 2 },
+            { -90552.22, 509.30, 0, 0, 2, 0, 2 },
+            { 82168.76, -515.36, 0, 0, 0, 0, 2 } };
+        termsPerPower.resize( 1 );
+        for( int i = 0; i < 4; i++ )
+        {
+            termsPerPower[ 0 ].push_back( std::vector< double >( xTerms[ i ], xTerms[ i ] + 7 ) );
+        }
+        break;
+    }
+    case cip_y_coordinate:
+    {
+        static const double yTerms[ 4 ][ 7 ] = {
+            { 1538.18, 9205236.26, 0, 0, 0, 0, 1 },
+            { -458.66, 573033.42, 0, 0, 2, -2, 2 },
+            { 137.41, 97846.69, 0, 0, 2, 0, 2 },
+            { -29.05, -89618.24, 0, 0, 0, 0, 2 } };
+        termsPerPower.resize( 1 );
+        for( int i = 0; i < 4; i++ )
+        {
+            termsPerPower[ 0 ].push_back( std::vector< double >( yTerms[ i ], yTerms[ i ] + 7 ) );
+        }
+        break;
+    }
+    case cio_locator_plus_half_xy:
+    {
+        static const double sTermsOfPowerZero[ 5 ][ 7 ] = {
+            { -2640.73, 0.39, 0, 0, 0, 0, 1 },
+            { -63.53, 0.02, 0, 0, 0, 0, 2 },
+            { -11.75, -0.01, 0, 0, 2, -2, 3 },
+            { -11.21, -0.01, 0, 0, 2, -2, 1 },
+            { 4.57, 0.00, 0, 0, 2, -2, 2 } };
+        static const double sTermsOfPowerTwo[ 2 ][ 7 ] = {
+            { 743.52, -0.17, 0, 0, 0, 0, 1 },
+            { 56.91, 0.06, 0, 0, 2, -2, 2 } };
+        termsPerPower.resize( 3 );
+        for( int i = 0; i < 5; i++ )
+        {
+            termsPerPower[ 0 ].push_back( std::vector< double >(
+                                              sTermsOfPowerZero[ i ], sTermsOfPowerZero[ i ] + 7 ) );
+        }
+        for( int i = 0; i < 2; i++ )
+        {
+            termsPerPower[ 2 ].push_back( std::vector< double >(
+                                              sTermsOfPowerTwo[ i ], sTermsOfPowerTwo[ i ] + 7 ) );
+        }
+        break;
+    }
+    default:
+        throw std::runtime_error( "Error, did not recognize Earth orientation series type." );
+    }
+
+    // Add (zero) planetary argument multipliers.
+    for( unsigned int j = 0; j < termsPerPower.size( ); j++ )
+    {
+        for( unsigned int i = 0; i < termsPerPower.at( j ).size( ); i++ )
+        {
+            termsPerPower[ j ][ i ].resize( 16, 0.0 );
+        }
+    }
+
+    return createEarthOrientationSeriesFromTerms( seriesType, termsPerPower );
+}
+
+//! Function to compute the Earth rotation angle.
+double computeEarthRotationAngle( const double ut1SecondsSinceJ2000 )
+{
+    // Split days since J2000 in integer and fractional part, to retain precision.
+    double ut1DaysSinceJ2000 = ut1SecondsSinceJ2000 / physical_constants::JULIAN_DAY;
+    double fractionOfDay = std::fmod( ut1DaysSinceJ2000, 1.0 );
+
+    double earthRotationAngle = 2.0 * mathematical_constants::PI * std::fmod(
+                fractionOfDay + 0.7790572732640 + 0.00273781191135448 * ut1DaysSinceJ2000, 1.0 );
+    if( earthRotationAngle < 0.0 )
+    {
+        earthRotationAngle += 2.0 * mathematical_constants::PI;
+    }
+    return earthRotationAngle;
+}
+
+//! Function to retrieve the rate of change of the Earth rotation angle.
+double getEarthRotationAngleRate( )
+{
+    return 2.0 * mathematical_constants::PI * 1.00273781191135448 / physical_constants::JULIAN_DAY;
+}
+
+//! Function to compute the rotation matrix from the celestial intermediate to the celestial reference system.
+Eigen::Matrix3d getIntermediateToCelestialRotation( const double cipXCoordinate, const double cipYCoordinate,
+                                                    const double cioLocator )
+{
+    const double x = cipXCoordinate;
+    const double y = cipYCoordinate;
+    const double a = 1.0 / ( 1.0 + std::sqrt( 1.0 - x * x - y * y ) );
+
+    Eigen::Matrix3d cipMatrix;
+    cipMatrix << 1.0 - a * x * x, -a * x * y, x,
+            -a * x * y, 1.0 - a * y * y, y,
+            -x, -y, 1.0 - a * ( x * x + y * y );
+
+    return cipMatrix * Eigen::AngleAxisd( -cioLocator, Eigen::Vector3d::UnitZ( ) ).toRotationMatrix( );
+}
+
+//! Function to compute the polar motion matrix.
+Eigen::Matrix3d getPolarMotionRotation( const double xPolarMotion, const double yPolarMotion,
+                                        const double tioLocator )
+{
+    return ( Eigen::AngleAxisd( tioLocator, Eigen::Vector3d::UnitZ( ) ) *
+             Eigen::AngleAxisd( -xPolarMotion, Eigen::Vector3d::UnitY( ) ) *
+             Eigen::AngleAxisd( -yPolarMotion, Eigen::Vector3d::UnitX( ) ) ).toRotationMatrix( );
+}
+
+//! Function to compute the TIO locator s'.
+double computeTioLocator( const double julianCenturiesSinceJ2000 )
+{
+    return -47.0E-6 * ARCSECONDS_TO_RADIANS * julianCenturiesSinceJ2000;
+}
+
+//! Constructor.
+EarthOrientationParameters::EarthOrientationParameters( const std::vector< double >& utcModifiedJulianDays,
+                                                        const std::vector< double >& xPolarMotion,
+                                                        const std::vector< double >& yPolarMotion,
+                                                        const std::vector< double >& ut1MinusUtc,
+                                                        const std::vector< double >& cipXOffsets,
+                                                        const std::vector< double >& cipYOffsets,
+                                                        const int interpolationStages )
+{
+    unsigned int numberOfEntries = utcModifiedJulianDays.size( );
+    if( xPolarMotion.size( ) != numberOfEntries || yPolarMotion.size( ) != numberOfEntries ||
+            ut1MinusUtc.size( ) != numberOfEntries || cipXOffsets.size( ) != numberOfEntries ||
+            cipYOffsets.size( ) != numberOfEntries )
+    {
+        throw std::runtime_error( "Error when creating Earth orientation parameters, inconsistent input sizes." );
+    }
+    if( numberOfEntries < static_cast< unsigned int >( interpolationStages ) )
+    {
+        throw std::runtime_error( "Error when creating Earth orientation parameters, insufficient data points." );
+    }
+
+    // Convert data to function of TT, and UT1 - UTC to (continuous) UT1 - TT.
+    std::vector< double > ttSecondsSinceJ2000;
+    std::vector< EarthOrientationParametersVector > parameters;
+    EarthOrientationParametersVector currentParameters;
+    for( unsigned int i = 0; i < numberOfEntries; i++ )
+    {
+        double ttMinusUtc = basic_astrodynamics::getTaiMinusUtc( utcModifiedJulianDays.at( i ) ) +
+                basic_astrodynamics::getTTMinusTai< double >( );
+        ttSecondsSinceJ2000.push_back(
+                    ( utcModifiedJulianDays.at( i ) + basic_astrodynamics::JULIAN_DAY_AT_0_MJD -
+                      basic_astrodynamics::JULIAN_DAY_ON_J2000 ) * physical_constants::JULIAN_DAY + ttMinusUtc );
+
+        currentParameters << xPolarMotion.at( i ), yPolarMotion.at( i ), ut1MinusUtc.at( i ) - ttMinusUtc,
+                cipXOffsets.at( i ), cipYOffsets.at( i );
+        parameters.push_back( currentParameters );
+    }
+
+    startTime_ = ttSecondsSinceJ2000.front( );
+    endTime_ = ttSecondsSinceJ2000.back( );
+
+    parameterInterpolator_ = boost::make_shared<
+            interpolators::LagrangeInterpolator< double, EarthOrientationParametersVector > >(
+                ttSecondsSinceJ2000, parameters, interpolationStages );
+}
+
+//! Function to retrieve the interpolated Earth orientation parameters.
+EarthOrientationParametersVector EarthOrientationParameters::getParameters( const double ttSecondsSinceJ2000 )
+{
+    if( ttSecondsSinceJ2000 < startTime_ || ttSecondsSinceJ2000 > endTime_ )
+    {
+        throw std::runtime_error( "Error when retrieving Earth orientation parameters, requested time is outside "
+                                  "range of data." );
+    }
+    return parameterInterpolator_->interpolate( ttSecondsSinceJ2000 );
+}
+
+//! Function to read Earth orientation parameters from a file in the IERS EOP C04 format.
+boost::shared_ptr< EarthOrientationParameters > readEarthOrientationParameters(
+        const std::string& fileName, const int interpolationStages )
+{
+    std::ifstream eopFile( fileName.c_str( ) );
+    if( !eopFile.good( ) )
+    {
+        throw std::runtime_error( "Error when reading Earth orientation parameters, could not open file " +
+                                  fileName );
+    }
+
+    std::vector< double > utcModifiedJulianDays, xPolarMotion, yPolarMotion, ut1MinusUtc, cipXOffsets, cipYOffsets;
+
+    std::string currentLine;
+    while( std::getline( eopFile, currentLine ) )
+    {
+        // Parse year, month, day, MJD, x, y, UT1-UTC, LOD, dX, dY; skip line if not possible.
+        std::istringstream lineStream( currentLine );
+        int year, month, day;
+        double lineValues[ 7 ];
+        if( !( lineStream >> year >> month >> day ) )
+        {
+            continue;
+        }
+
+        bool isLineValid = true;
+        for( int i = 0; i < 7; i++ )
+        {
+            if( !( lineStream >> lineValues[ i ] ) )
+            {
+                isLineValid = false;
+                break;
+            }
+        }
+
+        if( isLineValid )
+        {
+            utcModifiedJulianDays.push_back( lineValues[ 0 ] );
+            xPolarMotion.push_back( lineValues[ 1 ] * ARCSECONDS_TO_RADIANS );
+            yPolarMotion.push_back( lineValues[ 2 ] * ARCSECONDS_TO_RADIANS );
+            ut1MinusUtc.push_back( lineValues[ 3 ] );
+            cipXOffsets.push_back( lineValues[ 5 ] * ARCSECONDS_TO_RADIANS );
+            cipYOffsets.push_back( lineValues[ 6 ] * ARCSECONDS_TO_RADIANS );
+        }
+    }
+
+    return boost::make_shared< EarthOrientationParameters >(
+                utcModifiedJulianDays, xPolarMotion, yPolarMotion, ut1MinusUtc, cipXOffsets, cipYOffsets,
+                interpolationStages );
+}
+
+//! Function to create a time scale converter, using UT1 - TT from Earth orientation parameters.
+boost::shared_ptr< basic_astrodynamics::TimeScaleConverter > createTimeScaleConverter(
+        const boost::shared_ptr< EarthOrientationParameters > earthOrientationParameters )
+{
+    boost::function< double( const double ) > ut1MinusTtFunction;
+    if( earthOrientationParameters != NULL )
+    {
+        ut1MinusTtFunction = boost::bind( &EarthOrientationParameters::getUt1MinusTt, earthOrientationParameters, _1 );
+    }
+    return boost::make_shared< basic_astrodynamics::TimeScaleConverter >( ut1MinusTtFunction );
+}
+
+} // namespace ephemerides
+
+} // namespace tudat
@@ -0,0 +1,304 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Petit, G. and Luzum, B. (eds.), IERS Conventions (2010), IERS Technical Note 36, 2010.
+ *
+ */
+
+#ifndef TUDAT_EARTH_ORIENTATION_CALCULATOR_H
+#define TUDAT_EARTH_ORIENTATION_CALCULATOR_H
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeScaleConverter.h"
+#include "Tudat/Mathematics/Interpolators/lagrangeInterpolator.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Typedef for vector of fundamental arguments of nutation theory.
+typedef Eigen::Matrix< double, 14, 1 > FundamentalArgumentsVector;
+
+//! Typedef for vector of (interpolated) Earth orientation parameters.
+typedef Eigen::Matrix< double, 5, 1 > EarthOrientationParametersVector;
+
+//! Function to compute the fundamental arguments of the IAU 2006/2000A precession-nutation theory.
+/*!
+ *  Function to compute the fundamental arguments of the IAU 2006/2000A precession-nutation theory (Petit and Luzum,
+ *  2010, eqs. 5.43 and 5.44): l, l', F, D, Omega, the mean longitudes of Mercury to Neptune and the general precession
+ *  in longitude p_A, in this order.
+ *  \param julianCenturiesSinceJ2000 TT in Julian centuries since J2000.
+ *  \return Fundamental arguments (in radians).
+ */
+FundamentalArgumentsVector computeFundamentalArguments( const double julianCenturiesSinceJ2000 );
+
+//! Types of series for quantities defining the position of the Celestial Intermediate Pole (CIP) and Origin (CIO).
+enum EarthOrientationSeriesType
+{
+    cip_x_coordinate,
+    cip_y_coordinate,
+    cio_locator_plus_half_xy
+};
+
+//! Class for a series expansion of a quantity defining the position of the CIP or CIO.
+/*!
+ *  Class for a series expansion of a quantity defining the position of the CIP (X, Y) or CIO (s + XY/2), consisting
+ *  of a polynomial part and a periodic (Poisson) part, as in Petit and Luzum (2010, eq. 5.16).
+ */
+class EarthOrientationSeries
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor.
+     *  \param polynomialCoefficients Coefficients of polynomial part (in radians), entry i multiplying t^i.
+     *  \param argumentMultipliers Integer multipliers of fundamental arguments (one row per term), per power of t.
+     *  \param sineAmplitudes Amplitudes of sine terms (in radians), per power of t.
+     *  \param cosineAmplitudes Amplitudes of cosine terms (in radians), per power of t.
+     */
+    EarthOrientationSeries( const Eigen::VectorXd& polynomialCoefficients,
+                            const std::vector< Eigen::MatrixXd >& argumentMultipliers,
+                            const std::vector< Eigen::VectorXd >& sineAmplitudes,
+                            const std::vector< Eigen::VectorXd >& cosineAmplitudes );
+
+    //! Function to evaluate the series.
+    /*!
+     *  Function to evaluate the series.
+     *  \param julianCenturiesSinceJ2000 TT in Julian centuries since J2000.
+     *  \param fundamentalArguments Fundamental arguments at given time (see computeFundamentalArguments).
+     *  \return Value of series (in radians).
+     */
+    double evaluate( const double julianCenturiesSinceJ2000,
+                     const FundamentalArgumentsVector& fundamentalArguments ) const;
+
+    //! Function to return the total number of periodic terms in the series.
+    /*!
+     *  Function to return the total number of periodic terms in the series.
+     *  \return Total number of periodic terms in the series.
+     */
+    int getNumberOfTerms( ) const;
+
+private:
+
+    //! Coefficients of polynomial part (in radians), entry i multiplying t^i.
+    Eigen::VectorXd polynomialCoefficients_;
+
+    //! Integer multipliers of fundamental arguments (one row per term), per power of t.
+    std::vector< Eigen::MatrixXd > argumentMultipliers_;
+
+    //! Amplitudes of sine terms (in radians), per power of t.
+    std::vector< Eigen::VectorXd > sineAmplitudes_;
+
+    //! Amplitudes of cosine terms (in radians), per power of t.
+    std::vector< Eigen::VectorXd > cosineAmplitudes_;
+
+};
+
+//! Function to retrieve the polynomial part of the IAU 2006/2000A series of a CIP or CIO quantity.
+/*!
+ *  Function to retrieve the polynomial part of the IAU 2006/2000A series of a CIP or CIO quantity (Petit and Luzum,
+ *  2010, eqs. 5.16 and tab. 5.2d).
+ *  \param seriesType Quantity for which the coefficients are to be retrieved.
+ *  \return Coefficients (in radians), entry i multiplying t^i, with t in Julian centuries since J2000.
+ */
+Eigen::VectorXd getEarthOrientationSeriesPolynomialCoefficients( const EarthOrientationSeriesType seriesType );
+
+//! Function to read the periodic terms of a CIP or CIO series from a file in the IERS format.
+/*!
+ *  Function to read the periodic terms of a CIP or CIO series from a file in the format of the IERS Conventions
+ *  tables 5.2a (X), 5.2b (Y) and 5.2d (s + XY/2). Each block of terms is preceded by a line 'j = <power of t>', each
+ *  term is given by a line containing its index, the sine and cosine amplitudes (in microarcseconds) and the 14
+ *  integer multipliers of the fundamental arguments. All other lines are ignored. The polynomial part is taken from
+ *  getEarthOrientationSeriesPolynomialCoefficients.
+ *  \param fileName Name of file from which series is to be read.
+ *  \param seriesType Quantity which the file represents.
+ *  \return Series read from file.
+ */
+EarthOrientationSeries readEarthOrientationSeries( const std::string& fileName,
+                                                   const EarthOrientationSeriesType seriesType );
+
+//! Function to retrieve a truncated IAU 2006/2000A series of a CIP or CIO quantity.
+/*!
+ *  Function to retrieve a truncated IAU 2006/2000A series of a CIP or CIO quantity, containing the full polynomial part
+ *  and only the dominant periodic terms. The resulting CIP coordinates have errors of the order of 0.1 arcseconds, so
+ *  that the full series should be loaded with readEarthOrientationSeries for high-accuracy applications.
+ *  \param seriesType Quantity for which the series is to be retrieved.
+ *  \return Truncated series.
+ */
+EarthOrientationSeries getTruncatedEarthOrientationSeries( const EarthOrientationSeriesType seriesType );
+
+//! Function to compute the Earth rotation angle.
+/*!
+ *  Function to compute the Earth rotation angle (ERA) (Petit and Luzum, 2010, eq. 5.15).
+ *  \param ut1SecondsSinceJ2000 UT1 in seconds since J2000 (JD 2451545.0 UT1).
+ *  \return Earth rotation angle, in the range [0, 2 pi).
+ */
+double computeEarthRotationAngle( const double ut1SecondsSinceJ2000 );
+
+//! Function to retrieve the rate of change of the Earth rotation angle.
+/*!
+ *  Function to retrieve the rate of change of the Earth rotation angle, w.r.t. UT1.
+ *  \return Rate of change of the Earth rotation angle (in rad/s).
+ */
+double getEarthRotationAngleRate( );
+
+//! Function to compute the rotation matrix from the celestial intermediate to the celestial reference system.
+/*!
+ *  Function to compute the rotation matrix Q(t) from the celestial intermediate reference system (CIRS) to the
+ *  geocentric celestial reference system (GCRS), from the coordinates of the CIP and the CIO locator (Petit and
+ *  Luzum, 2010, eq. 5.10).
+ *  \param cipXCoordinate X-coordinate of the CIP in the GCRS.
+ *  \param cipYCoordinate Y-coordinate of the CIP in the GCRS.
+ *  \param cioLocator CIO locator s (in radians).
+ *  \return Rotation matrix from CIRS to GCRS.
+ */
+Eigen::Matrix3d getIntermediateToCelestialRotation( const double cipXCoordinate, const double cipYCoordinate,
+                                                    const double cioLocator );
+
+//! Function to compute the polar motion matrix.
+/*!
+ *  Function to compute the polar motion matrix W(t) = R3(-s') R2(xp) R1(yp), from the terrestrial reference system to
+ *  the terrestrial intermediate reference system (Petit and Luzum, 2010, eq. 5.3).
+ *  \param xPolarMotion x-coordinate of the pole (in radians).
+ *  \param yPolarMotion y-coordinate of the pole (in radians).
+ *  \param tioLocator TIO locator s' (in radians).
+ *  \return Polar motion matrix.
+ */
+Eigen::Matrix3d getPolarMotionRotation( const double xPolarMotion, const double yPolarMotion,
+                                        const double tioLocator );
+
+//! Function to compute the TIO locator s'.
+/*!
+ *  Function to compute the TIO locator s' (Petit and Luzum, 2010, eq. 5.13).
+ *  \param julianCenturiesSinceJ2000 TT in Julian centuries since J2000.
+ *  \return TIO locator (in radians).
+ */
+double computeTioLocator( const double julianCenturiesSinceJ2000 );
+
+//! Class for tabulated Earth orientation parameters (EOP), interpolated in time.
+/*!
+ *  Class for tabulated Earth orientation parameters (EOP): polar motion, UT1 - UTC and celestial pole offsets, as
+ *  provided (typically at daily intervals) by the IERS. Internally, UT1 - UTC is stored as UT1 - TT, which is
+ *  continuous over leap seconds, and all parameters are tabulated as a function of TT, so that they can be
+ *  interpolated directly.
+ */
+class EarthOrientationParameters
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor.
+     *  \param utcModifiedJulianDays UTC dates (as modified Julian days) at which parameters are given (equidistant
+     *  spacing is not required).
+     *  \param xPolarMotion x-coordinates of the pole (in radians).
+     *  \param yPolarMotion y-coordinates of the pole (in radians).
+     *  \param ut1MinusUtc Values of UT1 - UTC (in seconds).
+     *  \param cipXOffsets Celestial pole offsets dX w.r.t. IAU 2006/2000A model (in radians).
+     *  \param cipYOffsets Celestial pole offsets dY w.r.t. IAU 2006/2000A model (in radians).
+     *  \param interpolationStages Number of data points used for each (Lagrange) interpolation.
+     */
+    EarthOrientationParameters( const std::vector< double >& utcModifiedJulianDays,
+                                const std::vector< double >& xPolarMotion,
+                                const std::vector< double >& yPolarMotion,
+                                const std::vector< double >& ut1MinusUtc,
+                                const std::vector< double >& cipXOffsets,
+                                const std::vector< double >& cipYOffsets,
+                                const int interpolationStages = 4 );
+
+    //! Function to retrieve the interpolated Earth orientation parameters.
+    /*!
+     *  Function to retrieve the interpolated Earth orientation parameters.
+     *  \param ttSecondsSinceJ2000 TT in seconds since J2000 at which parameters are to be retrieved.
+     *  \return Earth orientation parameters: xp, yp, UT1 - TT, dX, dY (angles in radians, time in seconds).
+     */
+    EarthOrientationParametersVector getParameters( const double ttSecondsSinceJ2000 );
+
+    //! Function to retrieve the interpolated value of UT1 - TT.
+    /*!
+     *  Function to retrieve the interpolated value of UT1 - TT, for instance for use in a
+     *  basic_astrodynamics::TimeScaleConverter.
+     *  \param ttSecondsSinceJ2000 TT in seconds since J2000 at which UT1 - TT is to be retrieved.
+     *  \return UT1 - TT (in seconds).
+     */
+    double getUt1MinusTt( const double ttSecondsSinceJ2000 )
+    {
+        return getParameters( ttSecondsSinceJ2000 )( 2 );
+    }
+
+    //! Function to return the TT (in seconds since J2000) of the first tabulated parameters.
+    /*!
+     *  Function to return the TT (in seconds since J2000) of the first tabulated parameters.
+     *  \return TT of the first tabulated parameters.
+     */
+    double getStartTime( )
+    {
+        return startTime_;
+    }
+
+    //! Function to return the TT (in seconds since J2000) of the last tabulated parameters.
+    /*!
+     *  Function to return the TT (in seconds since J2000) of the last tabulated parameters.
+     *  \return TT of the last tabulated parameters.
+     */
+    double getEndTime( )
+    {
+        return endTime_;
+    }
+
+private:
+
+    //! Interpolator for the Earth orientation parameters, as a function of TT.
+    boost::shared_ptr< interpolators::LagrangeInterpolator< double, EarthOrientationParametersVector > >
+    parameterInterpolator_;
+
+    //! TT (in seconds since J2000) of the first tabulated parameters.
+    double startTime_;
+
+    //! TT (in seconds since J2000) of the last tabulated parameters.
+    double endTime_;
+};
+
+//! Function to read Earth orientation parameters from a file in the IERS EOP C04 format.
+/*!
+ *  Function to read Earth orientation parameters from a file in the IERS EOP 14 C04 format, in which each data line
+ *  contains the year, month, day, modified Julian day, x (arcsec), y (arcsec), UT1 - UTC (s), LOD (s), dX (arcsec) and
+ *  dY (arcsec), followed by the formal errors. Lines not starting with this sequence (such as headers) are ignored.
+ *  \param fileName Name of file from which parameters are to be read.
+ *  \param interpolationStages Number of data points used for each (Lagrange) interpolation.
+ *  \return Earth orientation parameters read from file.
+ */
+boost::shared_ptr< EarthOrientationParameters > readEarthOrientationParameters(
+        const std::string& fileName, const int interpolationStages = 4 );
+
+//! Function to create a time scale converter, using UT1 - TT from Earth orientation parameters.
+/*!
+ *  Function to create a time scale converter, using UT1 - TT from Earth orientation parameters.
+ *  \param earthOrientationParameters Earth orientation parameters from which UT1 - TT is retrieved. If NULL,
+ *  conversions to or from UT1 are not supported by the converter.
+ *  \return Time scale converter.
+ */
+boost::shared_ptr< basic_astrodynamics::TimeScaleConverter > createTimeScaleConverter(
+        const boost::shared_ptr< EarthOrientationParameters > earthOrientationParameters );
+
+} // namespace ephemerides
+
+} // namespace tudat
+
+#endif // TUDAT_EARTH_ORIENTATION_CALCULATOR_H
@@ -44,7 +44,8 @@ public:
     Ephemeris( const std::string& referenceFrameOrigin = "",
                const std::string& referenceFrameOrientation = "" ):
         referenceFrameOrigin_( referenceFrameOrigin ),
-        referenceFrameOrientation_( referenceFrameOrientation )
+        referenceFrameOrientation_( referenceFrameOrientation ),
+        ephemerisVersion_( 0 )
     { }
 
     //! Default destructor.
@@ -128,8 +129,19 @@ public:
      */
     std::string getReferenceFrameOrientation( ) { return referenceFrameOrientation_; }
 
+    //! Get version of ephemeris.
+    /*!
+     * Returns the number of times that the ephemeris has been modified through its reset/update functions since its
+     * creation, so that objects caching states computed from the ephemeris can detect that these are outdated.
+     * \return Version of ephemeris.
+     */
+    unsigned int getEphemerisVersion( ) { return ephemerisVersion_; }
+
 protected:
 
+    //! Function to register a modification of the ephemeris, to be called by each function that modifies it.
+    void incrementEphemerisVersion( ) { ephemerisVersion_++; }
+
     //! Reference frame origin.
     /*!
      * Reference frame origin. This identifier gives only the origin of the reference frame,
@@ -143,6 +155,9 @@ protected:
      * reference frame, the origin is defined by the referenceFrameOrigin_ variable.
      */
     std::string referenceFrameOrientation_;
+
+    //! Number of times that the ephemeris has been modified since its creation.
+    unsigned int ephemerisVersion_;
 };
 
 //! Typedef for shared-pointer to Ephemeris object.
@@ -155,6 +155,158 @@ void ReferenceFrameManager::setEphemerides(
                         "Error, multiple reference frame orientations of ephemerides currently not supported" );
         }
     }
+
+    // Assign integer indices to all frames, level by level, so that base frame indices are known when setting a frame.
+    frameIndices_.clear( );
+    frameEphemerides_.clear( );
+    baseFrameIndices_.clear( );
+    frameLevels_.clear( );
+    for( unsigned int i = 0; i < baseFrameList_.size( ); i++ )
+    {
+        for( std::map< std::string, std::string >::const_iterator frameIterator = baseFrameList_.at( i ).begin( );
+             frameIterator != baseFrameList_.at( i ).end( ); frameIterator++ )
+        {
+            frameIndices_[ frameIterator->first ] = frameEphemerides_.size( );
+            frameEphemerides_.push_back( availableEphemerides_.at( frameIterator->first ) );
+            baseFrameIndices_.push_back( getFrameIndex( frameIterator->second ) );
+            frameLevels_.push_back( i );
+        }
+    }
+
+    // Remove existing caches, which are recreated (with new frame list) upon request.
+    frameStateCache_.reset( );
+    longFrameStateCache_.reset( );
+    extendedTimeFrameStateCache_.reset( );
+    extendedTimeLongFrameStateCache_.reset( );
+}
+
+//! Function to retrieve the integer index of a frame.
+int ReferenceFrameManager::getFrameIndex( const std::string& frame )
+{
+    int frameIndex;
+    if( frame == getBaseFrameName( ) )
+    {
+        frameIndex = -1;
+    }
+    else if( frameIndices_.count( frame ) == 0 )
+    {
+        throw std::runtime_error( "Error when retrieving frame index in frame manager, frame " + frame +
+                                  " not found" );
+    }
+    else
+    {
+        frameIndex = frameIndices_.at( frame );
+    }
+    return frameIndex;
+}
+
+//! Function to resolve the chain of frames that connects two frames.
+void ReferenceFrameManager::getFlattenedFrameChain(
+        const std::string& origin, const std::string& body,
+        std::vector< int >& frameIndices, std::vector< int >& frameSigns )
+{
+    int currentBodyFrame = getFrameIndex( body );
+    int currentOriginFrame = getFrameIndex( origin );
+
+    // Move down the hierarchy from both frames (starting with the frame at the highest level) until they coincide.
+    std::vector< int > bodyBranch;
+    std::vector< int > originBranch;
+    int currentBodyFrameLevel, currentOriginFrameLevel;
+    while( currentBodyFrame != currentOriginFrame )
+    {
+        currentBodyFrameLevel = ( currentBodyFrame < 0 ) ? -1 : frameLevels_[ currentBodyFrame ];
+        currentOriginFrameLevel = ( currentOriginFrame < 0 ) ? -1 : frameLevels_[ currentOriginFrame ];
+
+        if( currentBodyFrameLevel >= currentOriginFrameLevel )
+        {
+            bodyBranch.push_back( currentBodyFrame );
+            currentBodyFrame = baseFrameIndices_[ currentBodyFrame ];
+        }
+
+        if( currentOriginFrameLevel >= currentBodyFrameLevel )
+        {
+            originBranch.push_back( currentOriginFrame );
+            currentOriginFrame = baseFrameIndices_[ currentOriginFrame ];
+        }
+    }
+
+    // Set chain, with states of body branch added and those of origin branch subtracted.
+    frameIndices = bodyBranch;
+    frameIndices.insert( frameIndices.end( ), originBranch.begin( ), originBranch.end( ) );
+    frameSigns = std::vector< int >( bodyBranch.size( ), 1 );
+    frameSigns.resize( frameIndices.size( ), -1 );
+}
+
+//! Function to retrieve the frame state cache for double time and state scalar, creating it if it does not exist.
+void ReferenceFrameManager::getFrameStateCache(
+        boost::shared_ptr< FrameStateCache< double, double > >& frameStateCache )
+{
+    if( frameStateCache_ == NULL )
+    {
+        frameStateCache_ = boost::make_shared< FrameStateCache< double, double > >( frameEphemerides_ );
+    }
+    frameStateCache = frameStateCache_;
+}
+
+//! Function to retrieve the frame state cache for double time and long double state scalar, creating it if it
+//! does not exist.
+void ReferenceFrameManager::getFrameStateCache(
+        boost::shared_ptr< FrameStateCache< double, long double > >& frameStateCache )
+{
+    if( longFrameStateCache_ == NULL )
+    {
+        longFrameStateCache_ = boost::make_shared< FrameStateCache< double, long double > >( frameEphemerides_ );
+    }
+    frameStateCache = longFrameStateCache_;
+}
+
+//! Function to retrieve the frame state cache for Time time and double state scalar, creating it if it does not
+//! exist.
+void ReferenceFrameManager::getFrameStateCache(
+        boost::shared_ptr< FrameStateCache< Time, double > >& frameStateCache )
+{
+    if( extendedTimeFrameStateCache_ == NULL )
+    {
+        extendedTimeFrameStateCache_ = boost::make_shared< FrameStateCache< Time, double > >( frameEphemerides_ );
+    }
+    frameStateCache = extendedTimeFrameStateCache_;
+}
+
+//! Function to retrieve the frame state cache for Time time and long double state scalar, creating it if it does
+//! not exist.
+void ReferenceFrameManager::getFrameStateCache(
+        boost::shared_ptr< FrameStateCache< Time, long double > >& frameStateCache )
+{
+    if( extendedTimeLongFrameStateCache_ == NULL )
+    {
+        extendedTimeLongFrameStateCache_ =
+                boost::make_shared< FrameStateCache< Time, long double > >( frameEphemerides_ );
+    }
+    frameStateCache = extendedTimeLongFrameStateCache_;
+}
+
+//! Function to clear the cached frame states used by the ephemerides created by this object.
+void ReferenceFrameManager::resetFrameStateCaches( )
+{
+    if( frameStateCache_ != NULL )
+    {
+        frameStateCache_->resetCache( );
+    }
+
+    if( longFrameStateCache_ != NULL )
+    {
+        longFrameStateCache_->resetCache( );
+    }
+
+    if( extendedTimeFrameStateCache_ != NULL )
+    {
+        extendedTimeFrameStateCache_->resetCache( );
+    }
+
+    if( extendedTimeLongFrameStateCache_ != NULL )
+    {
+        extendedTimeLongFrameStateCache_->resetCache( );
+    }
 }
 
 
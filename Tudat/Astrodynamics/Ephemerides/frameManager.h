@@ -22,6 +22,7 @@
 
 #include "Tudat/Astrodynamics/Ephemerides/compositeEphemeris.h"
 #include "Tudat/Astrodynamics/Ephemerides/constantEphemeris.h"
+#include "Tudat/Astrodynamics/Ephemerides/frameTranslationChain.h"
 
 namespace tudat
 {
@@ -50,7 +51,10 @@ std::string getBaseFrameName( );
 /*!
  * Class to retrieve translation functions between different frames, as calculated from a list of
  * ephemeris objects.  Using this class, the various Ephemeris objects may be 'pasted' together to
- * obtain the state of one body w.r.t. any other body.
+ * obtain the state of one body w.r.t. any other body. The frame hierarchy is resolved into integer
+ * frame indices upon construction, and the ephemerides between frames are created as flattened
+ * chains of these indices, evaluated through a per-epoch cache of frame states that is shared by
+ * all ephemerides created by a single frame manager.
  */
 class ReferenceFrameManager
 {
@@ -76,7 +80,6 @@ public:
     boost::shared_ptr< Ephemeris > getEphemeris(
             const std::string& origin, const std::string& body )
     {
-        typedef Eigen::Matrix< StateScalarType, 6, 1 > StateType;
         boost::shared_ptr< Ephemeris > ephemerisBetweenFrames;
 
         // If requested 'body' is global base frame, return constant zero ephemeris.
@@ -88,85 +91,32 @@ public:
         }
         else
         {
-            // Set frames between which ephemeris must be created.
-            std::vector< std::string > framesToCheck;
-            framesToCheck.push_back( origin );
-            framesToCheck.push_back( body );
-
-            // Find nearest common frame between frames.
-            std::pair< std::string, int > nearestCommonFrame = getNearestCommonFrame( framesToCheck );
-
-            // Initialize list of ephemeris functions for composite ephemeris creation
-            std::map< int, std::pair< boost::function< StateType( const TimeType& ) >, bool > >
-                 totalEphemerisList;
-
-            // If body is nearest common frame, get set of ephemeris and set to subtract them when
-            // making composite ephemeris.
-            std::vector< boost::shared_ptr< Ephemeris > > ephemerisList;
-            if( nearestCommonFrame.first == body )
-            {
-                ephemerisList = getDirectEphemerisFromLowerToUpperFrame( body, origin );
-                for( unsigned int i = 0; i < ephemerisList.size( ); i++ )
-                {
-                    totalEphemerisList[ i ] = std::make_pair(
-                                boost::bind( &Ephemeris::getTemplatedStateFromEphemeris
-                                             < StateScalarType, TimeType >,
-                                             ephemerisList[ i ], _1 ), false );
-                }
-            }
-            // If origin is nearest common frame, get set of ephemeris and set to add them when
-            // making composite ephemeris.
-            else if( nearestCommonFrame.first == origin )
-            {
-                ephemerisList = getDirectEphemerisFromLowerToUpperFrame( origin, body );
-                for( unsigned int i = 0; i < ephemerisList.size( ); i++ )
-                {
-                    totalEphemerisList[ i ] = std::make_pair(
-                                boost::bind( &Ephemeris::getTemplatedStateFromEphemeris
-                                             < StateScalarType, TimeType >,
-                                             ephemerisList[ i ], _1 ), true );
-                }
-            }
-            // If nearest common frame is neither input, create link from both to nearest common frame.
-            else
-            {
-                // Get set of ephemeris from nearest common frame to body and set to add them when
-                // making composite ephemeris.
-                ephemerisList = getDirectEphemerisFromLowerToUpperFrame( nearestCommonFrame.first, body );
-                for( unsigned int i = 0; i < ephemerisList.size( ); i++ )
-                {
-                    totalEphemerisList[ i ] = std::make_pair(
-                                boost::bind( &Ephemeris::getTemplatedStateFromEphemeris
-                                             < StateScalarType, TimeType >,
-                                             ephemerisList[ i ], _1 ), true );
-                }
-                int firstListSize = ephemerisList.size( );
-
-                // Get set of ephemeris from nearest common frame to origin and set to subtract them
-                // when making composite ephemeris.
-                ephemerisList = getDirectEphemerisFromLowerToUpperFrame( nearestCommonFrame.first, origin );
-                for( unsigned int i = 0; i < ephemerisList.size( ); i++ )
-                {
-                    totalEphemerisList[ i + firstListSize ] = std::make_pair(
-                                boost::bind( &Ephemeris::getTemplatedStateFromEphemeris
-                                             < StateScalarType, TimeType >,
-                                             ephemerisList[ i ], _1 ), false );
-                }
-            }
-
-            typedef Eigen::Matrix< StateScalarType, 6, 1 > StateType;
-
-
-            // Create composite ephemeris
-            ephemerisBetweenFrames = boost::make_shared< CompositeEphemeris< TimeType, StateScalarType > >(
-                        totalEphemerisList,
-                        std::map< int, boost::function< StateType( const double, const StateType& ) > >( ),
-                        origin );
+            // Resolve chain of frames between origin and body, through their nearest common frame.
+            std::vector< int > frameIndices;
+            std::vector< int > frameSigns;
+            getFlattenedFrameChain( origin, body, frameIndices, frameSigns );
+
+            // Create ephemeris from chain, using frame state cache shared by all chains of this frame manager.
+            boost::shared_ptr< FrameStateCache< TimeType, StateScalarType > > frameStateCache;
+            getFrameStateCache( frameStateCache );
+            ephemerisBetweenFrames = boost::make_shared< FrameTranslationChain< TimeType, StateScalarType > >(
+                        frameIndices, frameSigns, frameStateCache, origin,
+                        frameEphemerides_.at( 0 )->getReferenceFrameOrientation( ) );
         }
 
         return ephemerisBetweenFrames;
     }
 
+    //! Function to clear the cached frame states used by the ephemerides created by this object.
+    /*!
+     *  Function to clear the cached frame states used by the ephemerides created by this object (see getEphemeris). Each
+     *  constituent ephemeris is evaluated only once per epoch, and the result is shared between all ephemerides
+     *  created by this object. Modifications of the constituent ephemerides through their own reset functions are
+     *  detected automatically (see FrameStateCache); this function must be called whenever any of the constituent
+     *  ephemerides is modified in any other way, so that the states are recomputed on the next call.
+     */
+    void resetFrameStateCaches( );
+
     //! Return the level at which the requested ephemeris is in the hierarchy.
     /*!
      *  Return the level at which the requested ephemeris is in the hierarchy.
@@ -240,6 +190,67 @@ private:
     void setEphemerides( const std::map< std::string,
                          boost::shared_ptr< Ephemeris > >& additionalEphemerides );
 
+    //! Function to retrieve the integer index of a frame.
+    /*!
+     *  Function to retrieve the integer index of a frame, as used by the flattened frame chains.
+     *  \param frame Name of frame.
+     *  \return Index of frame (-1 for global base frame).
+     */
+    int getFrameIndex( const std::string& frame );
+
+    //! Function to resolve the chain of frames that connects two frames.
+    /*!
+     *  Function to resolve the chain of frames that connects two frames through their nearest common frame. The state
+     *  of the body w.r.t. the origin is obtained by summing the states of the returned frames w.r.t. their base frames,
+     *  multiplied by the returned signs. The frames from the body down to the nearest common frame are listed first,
+     *  followed by those from the origin down to the nearest common frame.
+     *  \param origin Frame w.r.t. which the state is to be computed.
+     *  \param body Frame of which the state is to be computed.
+     *  \param frameIndices Indices of frames in chain (returned by reference).
+     *  \param frameSigns Signs (1 or -1) of frames in chain (returned by reference).
+     */
+    void getFlattenedFrameChain( const std::string& origin, const std::string& body,
+                                 std::vector< int >& frameIndices, std::vector< int >& frameSigns );
+
+    //! Function to retrieve the frame state cache for double time and state scalar, creating it if it does not exist.
+    void getFrameStateCache( boost::shared_ptr< FrameStateCache< double, double > >& frameStateCache );
+
+    //! Function to retrieve the frame state cache for double time and long double state scalar, creating it if it
+    //! does not exist.
+    void getFrameStateCache( boost::shared_ptr< FrameStateCache< double, long double > >& frameStateCache );
+
+    //! Function to retrieve the frame state cache for Time time and double state scalar, creating it if it does not
+    //! exist.
+    void getFrameStateCache( boost::shared_ptr< FrameStateCache< Time, double > >& frameStateCache );
+
+    //! Function to retrieve the frame state cache for Time time and long double state scalar, creating it if it does
+    //! not exist.
+    void getFrameStateCache( boost::shared_ptr< FrameStateCache< Time, long double > >& frameStateCache );
+
+    //! Map giving the integer index (value) for each frame name (key), as used by the flattened frame chains.
+    std::map< std::string, int > frameIndices_;
+
+    //! Ephemerides of frames, with vector index denoting the frame index.
+    std::vector< boost::shared_ptr< Ephemeris > > frameEphemerides_;
+
+    //! Indices of base frames of frames (-1 for global base frame), with vector index denoting the frame index.
+    std::vector< int > baseFrameIndices_;
+
+    //! Frame levels of frames, with vector index denoting the frame index.
+    std::vector< int > frameLevels_;
+
+    //! Frame state cache for double time and state scalar.
+    boost::shared_ptr< FrameStateCache< double, double > > frameStateCache_;
+
+    //! Frame state cache for double time and long double state scalar.
+    boost::shared_ptr< FrameStateCache< double, long double > > longFrameStateCache_;
+
+    //! Frame state cache for Time time and double state scalar.
+    boost::shared_ptr< FrameStateCache< Time, double > > extendedTimeFrameStateCache_;
+
+    //! Frame state cache for Time time and long double state scalar.
+    boost::shared_ptr< FrameStateCache< Time, long double > > extendedTimeLongFrameStateCache_;
+
 };
 
 template< typename StateScalarType = double, typename TimeType = double >
@@ -0,0 +1,267 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_FRAMETRANSLATIONCHAIN_H
+#define TUDAT_FRAMETRANSLATIONCHAIN_H
+
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Ephemerides/ephemeris.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Class to cache the states of a set of frames w.r.t. their respective base frames, for the most recent epoch.
+/*!
+ *  Class to cache the states of a set of frames (identified by an integer index) w.r.t. their respective base frames,
+ *  as computed from their ephemerides. For each frame, the state at the most recently requested epoch is stored, so
+ *  that the ephemeris of each frame is evaluated only once per epoch, irrespective of the number of frame translation
+ *  chains in which it is used. A cached state is only used if the version of the frame's ephemeris (see
+ *  Ephemeris::getEphemerisVersion) has not changed since it was computed, so that modifications through the reset
+ *  functions of the ephemerides are detected automatically. Modifications that do not change the version (e.g. of an
+ *  ephemeris on which a frame's ephemeris depends) require a call to resetCache. Each state request is protected by a
+ *  mutex, so that a single object may be used concurrently from multiple threads (requests are then serialized).
+ */
+template< typename TimeType = double, typename StateScalarType = double >
+class FrameStateCache
+{
+public:
+
+    //! Typedef for state vector.
+    typedef Eigen::Matrix< StateScalarType, 6, 1 > StateType;
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param frameEphemerides Ephemerides of the frames, with the index in the vector denoting the frame index.
+     */
+    FrameStateCache( const std::vector< boost::shared_ptr< Ephemeris > >& frameEphemerides ):
+        frameEphemerides_( frameEphemerides ),
+        cachedStates_( Eigen::Matrix< StateScalarType, 6, Eigen::Dynamic >::Zero( 6, frameEphemerides.size( ) ) ),
+        cachedTimes_( frameEphemerides.size( ) ),
+        cachedEphemerisVersions_( frameEphemerides.size( ) ),
+        isStateCached_( frameEphemerides.size( ), false ){ }
+
+    //! Function to retrieve the state of a frame w.r.t. its base frame.
+    /*!
+     *  Function to retrieve the state of a frame w.r.t. its base frame, from the cache if it was computed at the same
+     *  epoch, and with the same version of the frame's ephemeris, in the previous request for this frame, and from the
+     *  frame's ephemeris otherwise.
+     *  \param frameIndex Index of the frame.
+     *  \param currentTime Time at which the state is to be retrieved.
+     *  \return State of the frame w.r.t. its base frame.
+     */
+    StateType getStateWrtBaseFrame( const int frameIndex, const TimeType& currentTime )
+    {
+        std::lock_guard< std::mutex > cacheLock( cacheMutex_ );
+
+        const unsigned int ephemerisVersion = frameEphemerides_[ frameIndex ]->getEphemerisVersion( );
+        if( !isStateCached_[ frameIndex ] || !( cachedTimes_[ frameIndex ] == currentTime ) ||
+                cachedEphemerisVersions_[ frameIndex ] != ephemerisVersion )
+        {
+            cachedStates_.col( frameIndex ) = frameEphemerides_[ frameIndex ]->template getTemplatedStateFromEphemeris<
+                    StateScalarType, TimeType >( currentTime );
+            cachedTimes_[ frameIndex ] = currentTime;
+            cachedEphemerisVersions_[ frameIndex ] = ephemerisVersion;
+            isStateCached_[ frameIndex ] = true;
+        }
+        return cachedStates_.col( frameIndex );
+    }
+
+    //! Function to clear the cached states, forcing all states to be recomputed on the next request.
+    void resetCache( )
+    {
+        std::lock_guard< std::mutex > cacheLock( cacheMutex_ );
+        isStateCached_.assign( isStateCached_.size( ), false );
+    }
+
+private:
+
+    //! Ephemerides of the frames, with the index in the vector denoting the frame index.
+    std::vector< boost::shared_ptr< Ephemeris > > frameEphemerides_;
+
+    //! Cached states of the frames w.r.t. their base frames, one column per frame.
+    Eigen::Matrix< StateScalarType, 6, Eigen::Dynamic > cachedStates_;
+
+    //! Epochs at which the states in cachedStates_ were computed.
+    std::vector< TimeType > cachedTimes_;
+
+    //! Versions of the frame ephemerides with which the states in cachedStates_ were computed.
+    std::vector< unsigned int > cachedEphemerisVersions_;
+
+    //! List of booleans denoting whether the corresponding entries of cachedStates_ are valid.
+    std::vector< bool > isStateCached_;
+
+    //! Mutex protecting the cached data against concurrent state requests.
+    std::mutex cacheMutex_;
+};
+
+//! Ephemeris class that computes the state of one frame w.r.t. another, from a flattened chain of frame states.
+/*!
+ *  Ephemeris class that computes the state of one frame w.r.t. another, by summing (with sign) the states of a list of
+ *  frames w.r.t. their respective base frames. The list of frames, which connects the two frames through their
+ *  nearest common frame, is resolved once upon creation (typically by the ReferenceFrameManager) and stored as a list
+ *  of integer frame indices. The constituent states are retrieved from a FrameStateCache, which is shared between all
+ *  chains created from a single frame manager, so that each constituent ephemeris is evaluated only once per epoch.
+ *  All states are evaluated with the TimeType and StateScalarType of the chain, and cast to the requested types. In
+ *  particular, for a chain with double TimeType, the getCartesianStateFromExtendedTime and
+ *  getCartesianLongStateFromExtendedTime functions evaluate the chain at the input Time cast to double (as is done by
+ *  the default implementation of these functions in the Ephemeris base class), so that the resolution of the Time
+ *  input is not retained. A chain with Time TimeType should be used if this is required.
+ */
+template< typename TimeType = double, typename StateScalarType = double >
+class FrameTranslationChain : public Ephemeris
+{
+public:
+
+    using Ephemeris::getCartesianLongState;
+    using Ephemeris::getCartesianState;
+
+    //! Typedef for state vector.
+    typedef Eigen::Matrix< StateScalarType, 6, 1 > StateType;
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param frameIndices Indices of frames of which the state w.r.t. their base frames are to be summed.
+     *  \param frameSigns Signs (1 or -1) with which the states of the frames in frameIndices are to be summed.
+     *  \param frameStateCache Object from which the states of the frames w.r.t. their base frames are retrieved.
+     *  \param referenceFrameOrigin Origin of reference frame in which state is defined.
+     *  \param referenceFrameOrientation Orientation of reference frame in which state is defined.
+     */
+    FrameTranslationChain(
+            const std::vector< int >& frameIndices,
+            const std::vector< int >& frameSigns,
+            const boost::shared_ptr< FrameStateCache< TimeType, StateScalarType > > frameStateCache,
+            const std::string& referenceFrameOrigin = "SSB",
+            const std::string& referenceFrameOrientation = "ECLIPJ2000" ):
+        Ephemeris( referenceFrameOrigin, referenceFrameOrientation ),
+        frameIndices_( frameIndices ), frameStateCache_( frameStateCache )
+    {
+        if( frameIndices.size( ) != frameSigns.size( ) )
+        {
+            throw std::runtime_error( "Error when making frame translation chain, input sizes are inconsistent" );
+        }
+
+        for( unsigned int i = 0; i < frameSigns.size( ); i++ )
+        {
+            frameSigns_.push_back( static_cast< StateScalarType >( frameSigns.at( i ) ) );
+        }
+    }
+
+    //! Destructor
+    ~FrameTranslationChain( ){ }
+
+    //! Get state from ephemeris.
+    /*!
+     * Returns state from ephemeris at given time.
+     * \param secondsSinceEpoch Seconds since epoch at which ephemeris is to be evaluated.
+     * \return State given by summed constituent frame states.
+     */
+    Eigen::Vector6d getCartesianState(
+            const double secondsSinceEpoch )
+    {
+        return getTemplatedStateFromChain< double, double >( secondsSinceEpoch );
+    }
+
+    //! Get state from ephemeris (with long double as state scalar).
+    /*!
+     * Returns state from ephemeris with long double as state scalar at given time.
+     * \param secondsSinceEpoch Seconds since epoch at which ephemeris is to be evaluated.
+     * \return State with long double as state scalar given by summed constituent frame states.
+     */
+    Eigen::Matrix< long double, 6, 1 > getCartesianLongState(
+            const double secondsSinceEpoch )
+    {
+        return getTemplatedStateFromChain< double, long double >( secondsSinceEpoch );
+    }
+
+    //! Get state from ephemeris (with double as state scalar and Time as time type).
+    /*!
+     * Returns state from ephemeris with double as state scalar at given time (as custom Time type).
+     * \param currentTime Time at which state is to be evaluated
+     * \return State given by summed constituent frame states.
+     */
+    Eigen::Matrix< double, 6, 1 > getCartesianStateFromExtendedTime(
+            const Time& currentTime )
+    {
+        return getTemplatedStateFromChain< Time, double >( currentTime );
+    }
+
+    //! Get state from ephemeris (with long double as state scalar and Time as time type).
+    /*!
+     * Returns state from ephemeris with long double as state scalar at given time (as custom Time type).
+     * \param currentTime Time at which state is to be evaluated
+     * \return State with long double as state scalar given by summed constituent frame states.
+     */
+    Eigen::Matrix< long double, 6, 1 > getCartesianLongStateFromExtendedTime(
+            const Time& currentTime )
+    {
+        return getTemplatedStateFromChain< Time, long double >( currentTime );
+    }
+
+    //! Templated function to get the state from the chain of frames.
+    /*!
+     *  Templated function to get the state from the chain of frames, evaluated with the time and state scalar types
+     *  of this object, and cast to the requested types. Note that the input time is cast to the TimeType of this
+     *  object, so that a Time input to a chain with double TimeType loses its extended resolution.
+     *  \param currentTime Seconds since epoch at which ephemeris is to be evaluated.
+     *  \return State given by summed constituent frame states, at requested precision.
+     */
+    template< typename OutputTimeType, typename OutputStateScalarType >
+    Eigen::Matrix< OutputStateScalarType, 6, 1 > getTemplatedStateFromChain(
+            const OutputTimeType& currentTime )
+    {
+        const TimeType evaluationTime = static_cast< TimeType >( currentTime );
+
+        StateType state = StateType::Zero( );
+        for( unsigned int i = 0; i < frameIndices_.size( ); i++ )
+        {
+            state += frameStateCache_->getStateWrtBaseFrame( frameIndices_[ i ], evaluationTime ) * frameSigns_[ i ];
+        }
+        return state.template cast< OutputStateScalarType >( );
+    }
+
+    //! Function to retrieve the indices of frames of which the state w.r.t. their base frames are summed.
+    /*!
+     *  Function to retrieve the indices of frames of which the state w.r.t. their base frames are summed.
+     *  \return Indices of frames of which the state w.r.t. their base frames are summed.
+     */
+    std::vector< int > getFrameIndices( )
+    {
+        return frameIndices_;
+    }
+
+private:
+
+    //! Indices of frames of which the state w.r.t. their base frames are summed.
+    std::vector< int > frameIndices_;
+
+    //! Signs with which the states of the frames in frameIndices_ are summed.
+    std::vector< StateScalarType > frameSigns_;
+
+    //! Object from which the states of the frames w.r.t. their base frames are retrieved.
+    boost::shared_ptr< FrameStateCache< TimeType, StateScalarType > > frameStateCache_;
+};
+
+} // namespace ephemerides
+
+} // namespace tudat
+
+#endif // TUDAT_FRAMETRANSLATIONCHAIN_H
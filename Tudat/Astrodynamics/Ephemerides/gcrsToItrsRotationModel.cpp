@@ -0,0 +1,176 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
+#include "Tudat/Astrodynamics/Ephemerides/gcrsToItrsRotationModel.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Constructor.
+GcrsToItrsRotationModel::GcrsToItrsRotationModel(
+        const EarthOrientationSeries& cipXSeries,
+        const EarthOrientationSeries& cipYSeries,
+        const EarthOrientationSeries& cioLocatorSeries,
+        const boost::shared_ptr< EarthOrientationParameters > earthOrientationParameters,
+        const double gridStartTime,
+        const double gridEndTime,
+        const double gridTimeStep,
+        const std::string& baseFrameOrientation,
+        const std::string& targetFrameOrientation ):
+    RotationalEphemeris( baseFrameOrientation, targetFrameOrientation ),
+    cipXSeries_( cipXSeries ), cipYSeries_( cipYSeries ), cioLocatorSeries_( cioLocatorSeries ),
+    earthOrientationParameters_( earthOrientationParameters ),
+    gridStartTime_( TUDAT_NAN ), gridEndTime_( TUDAT_NAN ), currentTime_( TUDAT_NAN )
+{
+    // Precompute X, Y and s on grid (with sufficient margin for interpolation at edges), if requested.
+    if( gridEndTime > gridStartTime )
+    {
+        if( !( gridTimeStep > 0.0 ) )
+        {
+            throw std::runtime_error( "Error when creating GCRS to ITRS rotation model, grid time step must be "
+                                      "positive." );
+        }
+
+        const int interpolationStages = 8;
+        double ttGridStartTime = gridStartTime - ( basic_astrodynamics::approximateConvertTTtoTDB(
+                                                       gridStartTime ) - gridStartTime );
+        int numberOfNodes = static_cast< int >( std::ceil( ( gridEndTime - gridStartTime ) / gridTimeStep ) ) + 1 +
+                interpolationStages;
+
+        std::vector< double > nodeTimes;
+        std::vector< Eigen::Vector3d > nodeValues;
+        for( int i = 0; i < numberOfNodes; i++ )
+        {
+            nodeTimes.push_back( ttGridStartTime + static_cast< double >( i - interpolationStages / 2 ) *
+                                 gridTimeStep );
+            nodeValues.push_back( computeCipCoordinatesAndCioLocator( nodeTimes.back( ) ) );
+        }
+
+        // Only use grid where interpolation is performed with nodes on both sides.
+        gridStartTime_ = nodeTimes.at( interpolationStages / 2 );
+        gridEndTime_ = nodeTimes.at( numberOfNodes - 1 - interpolationStages / 2 );
+
+        cipInterpolator_ = boost::make_shared< interpolators::LagrangeInterpolator< double, Eigen::Vector3d > >(
+                    nodeTimes, nodeValues, interpolationStages );
+    }
+}
+
+//! Function to compute the CIP coordinates X and Y, and the CIO locator s.
+Eigen::Vector3d GcrsToItrsRotationModel::getCipCoordinatesAndCioLocator( const double ttSecondsSinceJ2000 )
+{
+    if( cipInterpolator_ != NULL && ttSecondsSinceJ2000 >= gridStartTime_ && ttSecondsSinceJ2000 <= gridEndTime_ )
+    {
+        return cipInterpolator_->interpolate( ttSecondsSinceJ2000 );
+    }
+    else
+    {
+        return computeCipCoordinatesAndCioLocator( ttSecondsSinceJ2000 );
+    }
+}
+
+//! Function to compute the CIP coordinates X and Y, and the CIO locator s directly from the series.
+Eigen::Vector3d GcrsToItrsRotationModel::computeCipCoordinatesAndCioLocator( const double ttSecondsSinceJ2000 )
+{
+    double julianCenturiesSinceJ2000 = ttSecondsSinceJ2000 / ( 100.0 * physical_constants::JULIAN_YEAR );
+    FundamentalArgumentsVector fundamentalArguments = computeFundamentalArguments( julianCenturiesSinceJ2000 );
+
+    Eigen::Vector3d cipCoordinatesAndCioLocator;
+    cipCoordinatesAndCioLocator( 0 ) = cipXSeries_.evaluate( julianCenturiesSinceJ2000, fundamentalArguments );
+    cipCoordinatesAndCioLocator( 1 ) = cipYSeries_.evaluate( julianCenturiesSinceJ2000, fundamentalArguments );
+    cipCoordinatesAndCioLocator( 2 ) = cioLocatorSeries_.evaluate( julianCenturiesSinceJ2000, fundamentalArguments ) -
+            0.5 * cipCoordinatesAndCioLocator( 0 ) * cipCoordinatesAndCioLocator( 1 );
+    return cipCoordinatesAndCioLocator;
+}
+
+//! Function to compute the difference between UT1 and TT.
+double GcrsToItrsRotationModel::getUt1MinusTt( const double ttSecondsSinceJ2000 )
+{
+    if( earthOrientationParameters_ != NULL )
+    {
+        return earthOrientationParameters_->getParameters( ttSecondsSinceJ2000 )( 2 );
+    }
+    else
+    {
+        double approximateUtcModifiedJulianDay =
+                ttSecondsSinceJ2000 / physical_constants::JULIAN_DAY + basic_astrodynamics::JULIAN_DAY_ON_J2000 -
+                basic_astrodynamics::JULIAN_DAY_AT_0_MJD;
+        return -basic_astrodynamics::getTaiMinusUtc( approximateUtcModifiedJulianDay ) -
+                basic_astrodynamics::getTTMinusTai< double >( );
+    }
+}
+
+//! Function to update the rotation matrix and its derivative to the given time.
+void GcrsToItrsRotationModel::updateRotation( const double secondsSinceEpoch )
+{
+    if( !( secondsSinceEpoch == currentTime_ ) )
+    {
+        double ttSecondsSinceJ2000 = secondsSinceEpoch -
+                ( basic_astrodynamics::approximateConvertTTtoTDB( secondsSinceEpoch ) - secondsSinceEpoch );
+
+        // Retrieve Earth orientation parameters.
+        EarthOrientationParametersVector earthOrientationParameters = EarthOrientationParametersVector::Zero( );
+        if( earthOrientationParameters_ != NULL )
+        {
+            earthOrientationParameters = earthOrientationParameters_->getParameters( ttSecondsSinceJ2000 );
+        }
+        else
+        {
+            earthOrientationParameters( 2 ) = getUt1MinusTt( ttSecondsSinceJ2000 );
+        }
+
+        // Compute precession-nutation matrix.
+        Eigen::Vector3d cipCoordinatesAndCioLocator = getCipCoordinatesAndCioLocator( ttSecondsSinceJ2000 );
+        Eigen::Matrix3d intermediateToCelestialRotation = getIntermediateToCelestialRotation(
+                    cipCoordinatesAndCioLocator( 0 ) + earthOrientationParameters( 3 ),
+                    cipCoordinatesAndCioLocator( 1 ) + earthOrientationParameters( 4 ),
+                    cipCoordinatesAndCioLocator( 2 ) );
+
+        // Compute polar motion matrix.
+        Eigen::Matrix3d polarMotionRotation = getPolarMotionRotation(
+                    earthOrientationParameters( 0 ), earthOrientationParameters( 1 ),
+                    computeTioLocator( ttSecondsSinceJ2000 / ( 100.0 * physical_constants::JULIAN_YEAR ) ) );
+
+        // Compute Earth rotation matrix, and its derivative.
+        double earthRotationAngle = computeEarthRotationAngle( ttSecondsSinceJ2000 + earthOrientationParameters( 2 ) );
+        double cosineOfAngle = std::cos( earthRotationAngle );
+        double sineOfAngle = std::sin( earthRotationAngle );
+
+        Eigen::Matrix3d earthRotation;
+        earthRotation << cosineOfAngle, -sineOfAngle, 0.0,
+                sineOfAngle, cosineOfAngle, 0.0,
+                0.0, 0.0, 1.0;
+
+        Eigen::Matrix3d earthRotationDerivative;
+        earthRotationDerivative << -sineOfAngle, -cosineOfAngle, 0.0,
+                cosineOfAngle, -sineOfAngle, 0.0,
+                0.0, 0.0, 0.0;
+        earthRotationDerivative *= getEarthRotationAngleRate( );
+
+        currentRotationToBaseFrame_ = intermediateToCelestialRotation * earthRotation * polarMotionRotation;
+        currentRotationToBaseFrameDerivative_ =
+                intermediateToCelestialRotation * earthRotationDerivative * polarMotionRotation;
+        currentTime_ = secondsSinceEpoch;
+    }
+}
+
+} // namespace ephemerides
+
+} // namespace tudat
@@ -0,0 +1,215 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Petit, G. and Luzum, B. (eds.), IERS Conventions (2010), IERS Technical Note 36, 2010.
+ *
+ */
+
+#ifndef TUDAT_GCRS_TO_ITRS_ROTATION_MODEL_H
+#define TUDAT_GCRS_TO_ITRS_ROTATION_MODEL_H
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Astrodynamics/Ephemerides/earthOrientationCalculator.h"
+#include "Tudat/Astrodynamics/Ephemerides/rotationalEphemeris.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Class to model the rotation from the GCRS to the ITRS, using the IAU 2006/2000A precession-nutation model.
+/*!
+ *  Class to model the rotation from the GCRS to the ITRS, using the CIO-based IAU 2006/2000A precession-nutation
+ *  model, the Earth rotation angle and (optionally) tabulated Earth orientation parameters (Petit and Luzum, 2010,
+ *  chap. 5). The rotation from ITRS to GCRS is computed as Q(t) R(t) W(t), with Q(t) the precession-nutation matrix
+ *  computed from the CIP coordinates X, Y and the CIO locator s, R(t) the rotation by the Earth rotation angle and
+ *  W(t) the polar motion matrix.
+ *  To avoid evaluating the (long) series for X, Y and s at each call, these quantities can be precomputed on an
+ *  equidistant time grid, and interpolated between the nodes. Outside of this grid, the series are evaluated directly.
+ *  Input times are TDB seconds since J2000; the conversion to TT uses the approximate (periodic) TDB - TT relation. The
+ *  derivative of the rotation matrix only includes the contribution of the Earth rotation angle, the contributions of
+ *  precession-nutation and polar motion being smaller by a factor of order 1.0E-8.
+ */
+class GcrsToItrsRotationModel: public RotationalEphemeris
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor.
+     *  \param cipXSeries Series for X-coordinate of the CIP.
+     *  \param cipYSeries Series for Y-coordinate of the CIP.
+     *  \param cioLocatorSeries Series for s + XY/2.
+     *  \param earthOrientationParameters Tabulated Earth orientation parameters. If NULL, polar motion and celestial
+     *  pole offsets are set to zero, and UT1 is set equal to UTC.
+     *  \param gridStartTime Start time of grid for precomputation of CIP coordinates and CIO locator (TDB seconds since
+     *  J2000).
+     *  \param gridEndTime End time of grid for precomputation of CIP coordinates and CIO locator (TDB seconds since
+     *  J2000). No grid is used if this time is not larger than gridStartTime.
+     *  \param gridTimeStep Time step of grid for precomputation of CIP coordinates and CIO locator.
+     *  \param baseFrameOrientation Base frame identifier.
+     *  \param targetFrameOrientation Target frame identifier.
+     */
+    GcrsToItrsRotationModel(
+            const EarthOrientationSeries& cipXSeries,
+            const EarthOrientationSeries& cipYSeries,
+            const EarthOrientationSeries& cioLocatorSeries,
+            const boost::shared_ptr< EarthOrientationParameters > earthOrientationParameters =
+            boost::shared_ptr< EarthOrientationParameters >( ),
+            const double gridStartTime = TUDAT_NAN,
+            const double gridEndTime = TUDAT_NAN,
+            const double gridTimeStep = 3600.0,
+            const std::string& baseFrameOrientation = "GCRS",
+            const std::string& targetFrameOrientation = "ITRS" );
+
+    //! Destructor.
+    ~GcrsToItrsRotationModel( ){ }
+
+    //! Get rotation quaternion from target frame (ITRS) to base frame (GCRS).
+    /*!
+     *  Function to calculate and return the rotation quaternion from target frame (ITRS) to base frame (GCRS) at
+     *  specified time.
+     *  \param secondsSinceEpoch TDB seconds since J2000.
+     *  \return Rotation quaternion computed.
+     */
+    Eigen::Quaterniond getRotationToBaseFrame( const double secondsSinceEpoch )
+    {
+        updateRotation( secondsSinceEpoch );
+        return Eigen::Quaterniond( currentRotationToBaseFrame_ );
+    }
+
+    //! Get rotation quaternion to target frame (ITRS) from base frame (GCRS).
+    /*!
+     *  Function to calculate and return the rotation quaternion to target frame (ITRS) from base frame (GCRS) at
+     *  specified time.
+     *  \param secondsSinceEpoch TDB seconds since J2000.
+     *  \return Rotation quaternion computed.
+     */
+    Eigen::Quaterniond getRotationToTargetFrame( const double secondsSinceEpoch )
+    {
+        updateRotation( secondsSinceEpoch );
+        return Eigen::Quaterniond( currentRotationToBaseFrame_.transpose( ) );
+    }
+
+    //! Function to calculate the derivative of the rotation matrix from target frame to base frame.
+    /*!
+     *  Function to calculate the derivative of the rotation matrix from target frame (ITRS) to base frame (GCRS) at
+     *  specified time.
+     *  \param secondsSinceEpoch TDB seconds since J2000.
+     *  \return Derivative of rotation from target to base frame at specified time.
+     */
+    Eigen::Matrix3d getDerivativeOfRotationToBaseFrame( const double secondsSinceEpoch )
+    {
+        updateRotation( secondsSinceEpoch );
+        return currentRotationToBaseFrameDerivative_;
+    }
+
+    //! Function to calculate the derivative of the rotation matrix from base frame to target frame.
+    /*!
+     *  Function to calculate the derivative of the rotation matrix from base frame (GCRS) to target frame (ITRS) at
+     *  specified time.
+     *  \param secondsSinceEpoch TDB seconds since J2000.
+     *  \return Derivative of rotation from base to target frame at specified time.
+     */
+    Eigen::Matrix3d getDerivativeOfRotationToTargetFrame( const double secondsSinceEpoch )
+    {
+        updateRotation( secondsSinceEpoch );
+        return currentRotationToBaseFrameDerivative_.transpose( );
+    }
+
+    //! Function to compute the CIP coordinates X and Y, and the CIO locator s.
+    /*!
+     *  Function to compute the CIP coordinates X and Y (excluding celestial pole offsets), and the CIO locator s, from
+     *  the precomputed grid when possible, or directly from the series otherwise.
+     *  \param ttSecondsSinceJ2000 TT in seconds since J2000.
+     *  \return X, Y and s (in radians).
+     */
+    Eigen::Vector3d getCipCoordinatesAndCioLocator( const double ttSecondsSinceJ2000 );
+
+    //! Function to compute the CIP coordinates X and Y, and the CIO locator s directly from the series.
+    /*!
+     *  Function to compute the CIP coordinates X and Y (excluding celestial pole offsets), and the CIO locator s
+     *  directly from the series.
+     *  \param ttSecondsSinceJ2000 TT in seconds since J2000.
+     *  \return X, Y and s (in radians).
+     */
+    Eigen::Vector3d computeCipCoordinatesAndCioLocator( const double ttSecondsSinceJ2000 );
+
+    //! Function to compute the difference between UT1 and TT.
+    /*!
+     *  Function to compute the difference between UT1 and TT, from the Earth orientation parameters if available,
+     *  or from UTC if not.
+     *  \param ttSecondsSinceJ2000 TT in seconds since J2000.
+     *  \return UT1 - TT (in seconds).
+     */
+    double getUt1MinusTt( const double ttSecondsSinceJ2000 );
+
+    //! Function to return the Earth orientation parameters.
+    /*!
+     *  Function to return the Earth orientation parameters.
+     *  \return Earth orientation parameters.
+     */
+    boost::shared_ptr< EarthOrientationParameters > getEarthOrientationParameters( )
+    {
+        return earthOrientationParameters_;
+    }
+
+private:
+
+    //! Function to update the rotation matrix and its derivative to the given time.
+    /*!
+     *  Function to update the rotation matrix and its derivative to the given time, if this is not the time of the
+     *  current rotation.
+     *  \param secondsSinceEpoch TDB seconds since J2000.
+     */
+    void updateRotation( const double secondsSinceEpoch );
+
+    //! Series for X-coordinate of the CIP.
+    EarthOrientationSeries cipXSeries_;
+
+    //! Series for Y-coordinate of the CIP.
+    EarthOrientationSeries cipYSeries_;
+
+    //! Series for s + XY/2.
+    EarthOrientationSeries cioLocatorSeries_;
+
+    //! Tabulated Earth orientation parameters (NULL if not used).
+    boost::shared_ptr< EarthOrientationParameters > earthOrientationParameters_;
+
+    //! Interpolator for the X, Y and s on the precomputed grid (NULL if not used).
+    boost::shared_ptr< interpolators::LagrangeInterpolator< double, Eigen::Vector3d > > cipInterpolator_;
+
+    //! Start time (TT seconds since J2000) of the precomputed grid.
+    double gridStartTime_;
+
+    //! End time (TT seconds since J2000) of the precomputed grid.
+    double gridEndTime_;
+
+    //! Time (TDB seconds since J2000) at which the rotation was last computed.
+    double currentTime_;
+
+    //! Rotation matrix from ITRS to GCRS at currentTime_.
+    Eigen::Matrix3d currentRotationToBaseFrame_;
+
+    //! Derivative of rotation matrix from ITRS to GCRS at currentTime_.
+    Eigen::Matrix3d currentRotationToBaseFrameDerivative_;
+};
+
+} // namespace ephemerides
+
+} // namespace tudat
+
+#endif // TUDAT_GCRS_TO_ITRS_ROTATION_MODEL_H
@@ -119,11 +119,12 @@ Eigen::Vector6d KeplerEphemeris::getCartesianState(
                 convertElapsedTimeToEllipticalMeanAnomalyChange(
                     propagationTime, centralBodyGravitationalParameter_, semiMajorAxis_ );
 
-        // Compute eccentric anomaly for mean anomaly.
+        // Compute eccentric anomaly for mean anomaly (using the root finder of this object, to prevent a new root finder
+        // from being created for each evaluation).
         eccentricAnomaly =
                 convertMeanAnomalyToEccentricAnomaly(
                     eccentricity_,
-                    initialMeanAnomaly_ + meanAnomalyChange );
+                    initialMeanAnomaly_ + meanAnomalyChange, true, TUDAT_NAN, rootFinder_ );
     }
     else
     {
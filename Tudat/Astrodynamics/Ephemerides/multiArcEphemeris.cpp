@@ -0,0 +1,77 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/lexical_cast.hpp>
+
+#include "Tudat/Astrodynamics/Ephemerides/multiArcEphemeris.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Function to reset the arcs of the ephemeris.
+void MultiArcEphemeris::resetArcEphemerides( const std::vector< double >& arcStartTimes,
+                                             const std::vector< boost::shared_ptr< Ephemeris > >& arcEphemerides )
+{
+    if( arcStartTimes.size( ) == 0 )
+    {
+        throw std::runtime_error( "Error when setting multi-arc ephemeris, no arcs provided." );
+    }
+
+    if( arcStartTimes.size( ) != arcEphemerides.size( ) )
+    {
+        throw std::runtime_error( "Error when setting multi-arc ephemeris, number of start times (" +
+                                  boost::lexical_cast< std::string >( arcStartTimes.size( ) ) +
+                                  ") is inconsistent with number of ephemerides (" +
+                                  boost::lexical_cast< std::string >( arcEphemerides.size( ) ) + ")." );
+    }
+
+    for( unsigned int i = 0; i < arcStartTimes.size( ); i++ )
+    {
+        if( arcEphemerides.at( i ) == NULL )
+        {
+            throw std::runtime_error( "Error when setting multi-arc ephemeris, ephemeris of arc " +
+                                      boost::lexical_cast< std::string >( i ) + " is not defined." );
+        }
+
+        if( i > 0 && !( arcStartTimes.at( i ) > arcStartTimes.at( i - 1 ) ) )
+        {
+            throw std::runtime_error( "Error when setting multi-arc ephemeris, start times are not in ascending order." );
+        }
+    }
+
+    arcStartTimes_ = arcStartTimes;
+    arcEphemerides_ = arcEphemerides;
+    incrementEphemerisVersion( );
+}
+
+//! Function to get the index of the arc that is used at the given time.
+unsigned int MultiArcEphemeris::getArcIndex( const double time ) const
+{
+    std::vector< double >::const_iterator nextArcIterator =
+            std::upper_bound( arcStartTimes_.begin( ), arcStartTimes_.end( ), time );
+    return ( nextArcIterator == arcStartTimes_.begin( ) ) ?
+                0 : static_cast< unsigned int >( std::distance( arcStartTimes_.begin( ), nextArcIterator ) - 1 );
+}
+
+//! Function to determine whether an ephemeris is a multi-arc ephemeris.
+bool isMultiArcEphemeris( const boost::shared_ptr< Ephemeris > ephemeris )
+{
+    return ( boost::dynamic_pointer_cast< MultiArcEphemeris >( ephemeris ) != NULL );
+}
+
+} // namespace ephemerides
+
+} // namespace tudat
@@ -0,0 +1,163 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_MULTIARCEPHEMERIS_H
+#define TUDAT_MULTIARCEPHEMERIS_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Ephemerides/ephemeris.h"
+
+namespace tudat
+{
+
+namespace ephemerides
+{
+
+//! Ephemeris that is defined by a separate ephemeris in each of a series of consecutive arcs.
+/*!
+ *  Ephemeris that is defined by a separate ephemeris (typically a TabulatedCartesianEphemeris created from the
+ *  numerical propagation of the arc) in each of a series of consecutive arcs. A state is retrieved from the ephemeris of
+ *  the last arc that starts at or before the requested time (or from the first arc for times before its start), so that
+ *  the arc that is used in an overlap between arcs is the later one.
+ */
+class MultiArcEphemeris: public Ephemeris
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor.
+     *  \param arcStartTimes Start times of the arcs (in ascending order).
+     *  \param arcEphemerides Ephemerides of the arcs (in the same order as arcStartTimes).
+     *  \param referenceFrameOrigin Origin of reference frame (string identifier), equal for all arcs.
+     *  \param referenceFrameOrientation Orientation of reference frame (string identifier), equal for all arcs.
+     *  \throws std::runtime_error If the input is inconsistent (see resetArcEphemerides).
+     */
+    MultiArcEphemeris( const std::vector< double >& arcStartTimes,
+                       const std::vector< boost::shared_ptr< Ephemeris > >& arcEphemerides,
+                       const std::string& referenceFrameOrigin = "SSB",
+                       const std::string& referenceFrameOrientation = "ECLIPJ2000" ):
+        Ephemeris( referenceFrameOrigin, referenceFrameOrientation )
+    {
+        resetArcEphemerides( arcStartTimes, arcEphemerides );
+    }
+
+    //! Destructor.
+    ~MultiArcEphemeris( ){ }
+
+    //! Function to reset the arcs of the ephemeris.
+    /*!
+     *  Function to reset the arcs of the ephemeris, for instance following a new numerical propagation of the arcs.
+     *  \param arcStartTimes Start times of the arcs (in ascending order).
+     *  \param arcEphemerides Ephemerides of the arcs (in the same order as arcStartTimes).
+     *  \throws std::runtime_error If no arcs are provided, the sizes of the inputs differ, the start times are not
+     *  ascending or any of the ephemerides is not defined.
+     */
+    void resetArcEphemerides( const std::vector< double >& arcStartTimes,
+                              const std::vector< boost::shared_ptr< Ephemeris > >& arcEphemerides );
+
+    //! Function to get the state from the ephemeris of the arc that contains the given time.
+    /*!
+     *  Function to get the state from the ephemeris of the arc that contains the given time.
+     *  \param secondsSinceEpoch Seconds since epoch at which ephemeris is to be evaluated.
+     *  \return State from ephemeris.
+     */
+    Eigen::Vector6d getCartesianState( const double secondsSinceEpoch )
+    {
+        return arcEphemerides_[ getArcIndex( secondsSinceEpoch ) ]->getCartesianState( secondsSinceEpoch );
+    }
+
+    //! Function to get the state (with long double as state scalar) from the ephemeris of the arc that contains the
+    //! given time.
+    /*!
+     *  Function to get the state (with long double as state scalar) from the ephemeris of the arc that contains the
+     *  given time.
+     *  \param secondsSinceEpoch Seconds since epoch at which ephemeris is to be evaluated.
+     *  \return State from ephemeris with long double as state scalar.
+     */
+    Eigen::Matrix< long double, 6, 1 > getCartesianLongState( const double secondsSinceEpoch )
+    {
+        return arcEphemerides_[ getArcIndex( secondsSinceEpoch ) ]->getCartesianLongState( secondsSinceEpoch );
+    }
+
+    //! Function to get the state (with Time as time type) from the ephemeris of the arc that contains the given time.
+    /*!
+     *  Function to get the state (with Time as time type) from the ephemeris of the arc that contains the given time.
+     *  \param currentTime Time at which state is to be evaluated.
+     *  \return State from ephemeris.
+     */
+    Eigen::Vector6d getCartesianStateFromExtendedTime( const Time& currentTime )
+    {
+        return arcEphemerides_[ getArcIndex( static_cast< double >( currentTime ) ) ]->
+                getCartesianStateFromExtendedTime( currentTime );
+    }
+
+    //! Function to get the state (with long double as state scalar and Time as time type) from the ephemeris of the arc
+    //! that contains the given time.
+    /*!
+     *  Function to get the state (with long double as state scalar and Time as time type) from the ephemeris of the arc
+     *  that contains the given time.
+     *  \param currentTime Time at which state is to be evaluated.
+     *  \return State from ephemeris with long double as state scalar.
+     */
+    Eigen::Matrix< long double, 6, 1 > getCartesianLongStateFromExtendedTime( const Time& currentTime )
+    {
+        return arcEphemerides_[ getArcIndex( static_cast< double >( currentTime ) ) ]->
+                getCartesianLongStateFromExtendedTime( currentTime );
+    }
+
+    //! Function to get the index of the arc that is used at the given time.
+    /*!
+     *  Function to get the index of the arc that is used at the given time: the last arc that starts at or before the
+     *  given time, or the first arc if the time is before the start of all arcs.
+     *  \param time Time at which the arc is to be determined.
+     *  \return Index of the arc that is used at the given time.
+     */
+    unsigned int getArcIndex( const double time ) const;
+
+    //! Function to get the start times of the arcs.
+    std::vector< double > getArcStartTimes( ) const
+    {
+        return arcStartTimes_;
+    }
+
+    //! Function to get the ephemerides of the arcs.
+    std::vector< boost::shared_ptr< Ephemeris > > getArcEphemerides( ) const
+    {
+        return arcEphemerides_;
+    }
+
+private:
+
+    //! Start times of the arcs (in ascending order).
+    std::vector< double > arcStartTimes_;
+
+    //! Ephemerides of the arcs.
+    std::vector< boost::shared_ptr< Ephemeris > > arcEphemerides_;
+};
+
+//! Function to determine whether an ephemeris is a multi-arc ephemeris.
+/*!
+ *  Function to determine whether an ephemeris is a multi-arc ephemeris.
+ *  \param ephemeris Ephemeris for which the type is to be determined.
+ *  \return True if the ephemeris is a MultiArcEphemeris, false otherwise.
+ */
+bool isMultiArcEphemeris( const boost::shared_ptr< Ephemeris > ephemeris );
+
+} // namespace ephemerides
+
+} // namespace tudat
+
+#endif // TUDAT_MULTIARCEPHEMERIS_H
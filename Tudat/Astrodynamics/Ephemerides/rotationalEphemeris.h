@@ -15,6 +15,7 @@
 #include <string>
 
 #include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <Eigen/Core>
 #include <Eigen/Geometry>
@@ -81,6 +81,7 @@ public:
     void resetInterpolator( const StateInterpolatorPointer interpolator )
     {
         interpolator_ = interpolator;
+        this->incrementEphemerisVersion( );
     }
 
     //! Get cartesian state from ephemeris.
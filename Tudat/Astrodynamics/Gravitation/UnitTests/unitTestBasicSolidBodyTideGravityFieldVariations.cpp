@@ -0,0 +1,208 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/lambda/lambda.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Astrodynamics/Gravitation/basicSolidBodyTideGravityFieldVariations.h"
+#include "Tudat/Mathematics/BasicMathematics/legendrePolynomials.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::gravitation;
+
+//! Function to compute the state of a body on a circular orbit.
+Eigen::Vector6d getCircularOrbitState( const double time, const double radius, const double meanMotion,
+                                       const double inclination, const double phase )
+{
+    Eigen::Vector6d state;
+    state << radius * std::cos( meanMotion * time + phase ),
+            radius * std::sin( meanMotion * time + phase ) * std::cos( inclination ),
+            radius * std::sin( meanMotion * time + phase ) * std::sin( inclination ),
+            -radius * meanMotion * std::sin( meanMotion * time + phase ),
+            radius * meanMotion * std::cos( meanMotion * time + phase ) * std::cos( inclination ),
+            radius * meanMotion * std::cos( meanMotion * time + phase ) * std::sin( inclination );
+    return state;
+}
+
+//! Function to compute the rotation to a frame fixed to a uniformly rotating body.
+Eigen::Quaterniond getRotationToBodyFixedFrame( const double time )
+{
+    return Eigen::Quaterniond( Eigen::AngleAxisd( -7.3E-5 * time, Eigen::Vector3d::UnitZ( ) ) *
+                               Eigen::AngleAxisd( -0.4, Eigen::Vector3d::UnitX( ) ) );
+}
+
+//! Function to compute the solid body tide correction at a single degree and order, using geodesy-normalized Legendre
+//! polynomials (Petit et al. 2010, eq. 6.6).
+std::complex< double > computeTestTideCorrection(
+        const std::complex< double > loveNumber, const double massRatio, const double referenceRadius,
+        const Eigen::Vector3d& relativeBodyFixedPosition, const int degree, const int order )
+{
+    double distance = relativeBodyFixedPosition.norm( );
+    double longitude = std::atan2( relativeBodyFixedPosition.y( ), relativeBodyFixedPosition.x( ) );
+    return loveNumber / ( 2.0 * degree + 1.0 ) * massRatio * std::pow( referenceRadius / distance, degree + 1 ) *
+            basic_mathematics::computeGeodesyLegendrePolynomial(
+                degree, order, relativeBodyFixedPosition.z( ) / distance ) *
+            std::exp( std::complex< double >( 0.0, -order * longitude ) );
+}
+
+BOOST_AUTO_TEST_SUITE( test_basic_solid_body_tide_gravity_field_variations )
+
+//! Test whether corrections for all bodies, degrees and orders are equal to those computed per degree and order.
+BOOST_AUTO_TEST_CASE( testSolidBodyTideCorrections )
+{
+    const double referenceRadius = 6378137.0;
+    const double deformedBodyMass = 3.986004418E14;
+
+    // Define Love numbers (complex, and different per degree and order) up to degree 4.
+    std::vector< std::vector< std::complex< double > > > loveNumbers;
+    for( int n = 2; n <= 4; n++ )
+    {
+        std::vector< std::complex< double > > loveNumbersOfDegree;
+        for( int m = 0; m <= n; m++ )
+        {
+            loveNumbersOfDegree.push_back( std::complex< double >( 0.3 / ( n - 1 ) + 0.01 * m, -0.002 * ( m + 1 ) ) );
+        }
+        loveNumbers.push_back( loveNumbersOfDegree );
+    }
+
+    // Define deformed body and bodies causing deformation.
+    std::vector< boost::function< Eigen::Vector6d( const double ) > > deformingBodyStateFunctions;
+    deformingBodyStateFunctions.push_back( boost::bind( &getCircularOrbitState, _1, 3.84E8, 2.66E-6, 0.09, 0.3 ) );
+    deformingBodyStateFunctions.push_back( boost::bind( &getCircularOrbitState, _1, 1.496E11, 1.99E-7, 0.41, 2.0 ) );
+    deformingBodyStateFunctions.push_back( boost::bind( &getCircularOrbitState, _1, 4.2E7, 7.3E-5, 1.2, -1.0 ) );
+
+    std::vector< double > deformingBodyMasses;
+    deformingBodyMasses.push_back( 4.9028E12 );
+    deformingBodyMasses.push_back( 1.32712440018E20 );
+    deformingBodyMasses.push_back( 1.0E6 );
+
+    std::vector< boost::function< double( ) > > deformingBodyMassFunctions;
+    for( unsigned int i = 0; i < deformingBodyMasses.size( ); i++ )
+    {
+        deformingBodyMassFunctions.push_back( boost::lambda::constant( deformingBodyMasses.at( i ) ) );
+    }
+
+    boost::function< Eigen::Vector6d( const double ) > deformedBodyStateFunction =
+            boost::bind( &getCircularOrbitState, _1, 1.0E7, 1.0E-6, 0.2, 0.0 );
+
+    BasicSolidBodyTideGravityFieldVariations solidBodyTide(
+                deformedBodyStateFunction, &getRotationToBodyFixedFrame, deformingBodyStateFunctions,
+                referenceRadius, boost::lambda::constant( deformedBodyMass ), deformingBodyMassFunctions,
+                loveNumbers, std::vector< std::string >( 3, "" ) );
+
+    for( double time = 0.0; time < 1.0E6; time += 1.23E5 )
+    {
+        // Compute corrections per body, degree and order.
+        Eigen::MatrixXd expectedCosineCorrections = Eigen::MatrixXd::Zero( 5, 5 );
+        Eigen::MatrixXd expectedSineCorrections = Eigen::MatrixXd::Zero( 5, 5 );
+        for( unsigned int i = 0; i < deformingBodyStateFunctions.size( ); i++ )
+        {
+            Eigen::Vector3d relativeBodyFixedPosition = getRotationToBodyFixedFrame( time ) * (
+                        deformingBodyStateFunctions.at( i )( time ) - deformedBodyStateFunction( time ) ).segment( 0, 3 );
+
+            for( int n = 2; n <= 4; n++ )
+            {
+                for( int m = 0; m <= n; m++ )
+                {
+                    std::complex< double > correction = computeTestTideCorrection(
+                                loveNumbers.at( n - 2 ).at( m ), deformingBodyMasses.at( i ) / deformedBodyMass,
+                                referenceRadius, relativeBodyFixedPosition, n, m );
+
+                    // Compare to explicit computation of single coefficient (for which the Legendre polynomials are
+                    // consistent with those of the cache up to degree 3).
+                    if( n <= 3 )
+                    {
+                        std::complex< double > explicitCorrection =
+                                calculateSolidBodyTideSingleCoefficientSetCorrectionFromAmplitude(
+                                    loveNumbers.at( n - 2 ).at( m ), deformingBodyMasses.at( i ) / deformedBodyMass,
+                                    referenceRadius, relativeBodyFixedPosition, n, m );
+                        BOOST_CHECK_SMALL( std::abs( explicitCorrection - correction ),
+                                           1.0E-13 * std::abs( correction ) );
+                    }
+
+                    expectedCosineCorrections( n, m ) += correction.real( );
+                    if( m > 0 )
+                    {
+                        expectedSineCorrections( n, m ) -= correction.imag( );
+                    }
+                }
+            }
+
+            // Check corrections for single body at all degrees and orders.
+            std::pair< Eigen::MatrixXd, Eigen::MatrixXd > singleBodyCorrections =
+                    calculateSolidBodyTideSingleCoefficientSetCorrectionFromAmplitude(
+                        loveNumbers, deformingBodyMasses.at( i ) / deformedBodyMass, referenceRadius,
+                        relativeBodyFixedPosition, 4, 3 );
+            for( int n = 0; n <= 4; n++ )
+            {
+                for( int m = 0; m <= 3; m++ )
+                {
+                    std::complex< double > correction = ( n >= 2 && m <= n ) ?
+                                computeTestTideCorrection(
+                                    loveNumbers.at( n - 2 ).at( m ), deformingBodyMasses.at( i ) / deformedBodyMass,
+                                    referenceRadius, relativeBodyFixedPosition, n, m ) : std::complex< double >( );
+                    BOOST_CHECK_SMALL( singleBodyCorrections.first( n, m ) - correction.real( ),
+                                       1.0E-13 * std::abs( correction ) + 1.0E-300 );
+                    BOOST_CHECK_SMALL( singleBodyCorrections.second( n, m ) + ( m > 0 ? correction.imag( ) : 0.0 ),
+                                       1.0E-13 * std::abs( correction ) + 1.0E-300 );
+                }
+            }
+        }
+
+        double tolerance = 1.0E-13 * expectedCosineCorrections.cwiseAbs( ).maxCoeff( );
+
+        // Check corrections returned as pair.
+        std::pair< Eigen::MatrixXd, Eigen::MatrixXd > corrections =
+                solidBodyTide.calculateSphericalHarmonicsCorrections( time );
+        BOOST_CHECK_SMALL( ( corrections.first - expectedCosineCorrections.block( 2, 0, 3, 5 ) ).cwiseAbs( ).maxCoeff( ),
+                           tolerance );
+        BOOST_CHECK_SMALL( ( corrections.second - expectedSineCorrections.block( 2, 0, 3, 5 ) ).cwiseAbs( ).maxCoeff( ),
+                           tolerance );
+
+        // Check corrections added directly to coefficients.
+        Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Constant( 6, 6, 1.0E-6 );
+        Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Constant( 6, 6, -1.0E-6 );
+        solidBodyTide.addSphericalHarmonicsCorrections( time, sineCoefficients, cosineCoefficients );
+        BOOST_CHECK_SMALL( ( cosineCoefficients.block( 0, 0, 5, 5 ) - expectedCosineCorrections -
+                             Eigen::MatrixXd::Constant( 5, 5, 1.0E-6 ) ).cwiseAbs( ).maxCoeff( ), tolerance );
+        BOOST_CHECK_SMALL( ( sineCoefficients.block( 0, 0, 5, 5 ) - expectedSineCorrections -
+                             Eigen::MatrixXd::Constant( 5, 5, -1.0E-6 ) ).cwiseAbs( ).maxCoeff( ), tolerance );
+        BOOST_CHECK_EQUAL( cosineCoefficients( 5, 5 ), 1.0E-6 );
+        BOOST_CHECK_EQUAL( sineCoefficients( 5, 5 ), -1.0E-6 );
+
+        BOOST_CHECK_EQUAL( solidBodyTide.getCurrentCosineCorrections( ), corrections.first );
+        BOOST_CHECK_EQUAL( solidBodyTide.getCurrentSineCorrections( ), corrections.second );
+    }
+
+    // Check that reset Love numbers are used.
+    std::vector< std::complex< double > > newLoveNumbers( 3, std::complex< double >( 0.0, 0.0 ) );
+    solidBodyTide.resetLoveNumbersOfDegree( newLoveNumbers, 3 );
+    std::pair< Eigen::MatrixXd, Eigen::MatrixXd > corrections =
+            solidBodyTide.calculateSphericalHarmonicsCorrections( 0.0 );
+    BOOST_CHECK_EQUAL( corrections.first.block( 1, 0, 1, 3 ).cwiseAbs( ).maxCoeff( ), 0.0 );
+    BOOST_CHECK_EQUAL( corrections.second.block( 1, 0, 1, 3 ).cwiseAbs( ).maxCoeff( ), 0.0 );
+    BOOST_CHECK( corrections.first.row( 0 ).cwiseAbs( ).maxCoeff( ) > 0.0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,170 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Astrodynamics/Gravitation/timeDependentSphericalHarmonicsGravityField.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::gravitation;
+
+//! Gravity field variation with a sinusoidal correction of a coefficient block, counting the number of calls.
+class TestGravityFieldVariations: public GravityFieldVariations
+{
+public:
+
+    TestGravityFieldVariations( const int minimumDegree, const int minimumOrder,
+                                const int maximumDegree, const int maximumOrder,
+                                const double amplitude ):
+        GravityFieldVariations( minimumDegree, minimumOrder, maximumDegree, maximumOrder ),
+        amplitude_( amplitude ), numberOfCalls_( 0 ){ }
+
+    std::pair< Eigen::MatrixXd, Eigen::MatrixXd > calculateSphericalHarmonicsCorrections( const double time )
+    {
+        numberOfCalls_++;
+        return std::make_pair( getCorrection( time, 0 ), getCorrection( time, 1 ) );
+    }
+
+    Eigen::MatrixXd getCorrection( const double time, const int type )
+    {
+        Eigen::MatrixXd correction = Eigen::MatrixXd::Zero( numberOfDegrees_, numberOfOrders_ );
+        for( int i = 0; i < numberOfDegrees_; i++ )
+        {
+            for( int j = 0; j < numberOfOrders_; j++ )
+            {
+                correction( i, j ) = amplitude_ * std::sin( 1.0E-3 * time * ( i + 1 ) + j + 0.5 * type );
+            }
+        }
+        return correction;
+    }
+
+    int getNumberOfCalls( )
+    {
+        return numberOfCalls_;
+    }
+
+private:
+
+    double amplitude_;
+
+    int numberOfCalls_;
+};
+
+BOOST_AUTO_TEST_SUITE( test_time_dependent_spherical_harmonics_gravity_field )
+
+//! Test whether incremental (block-wise) coefficient updates are equal to a full recomputation.
+BOOST_AUTO_TEST_CASE( testIncrementalCoefficientUpdate )
+{
+    // Create nominal coefficients.
+    const int maximumDegree = 50;
+    Eigen::MatrixXd nominalCosineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 1 );
+    Eigen::MatrixXd nominalSineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 1 );
+    for( int i = 0; i <= maximumDegree; i++ )
+    {
+        for( int j = 0; j <= i; j++ )
+        {
+            nominalCosineCoefficients( i, j ) = 1.0E-6 * std::cos( static_cast< double >( i * j + 1 ) ) / ( i + 1 );
+            nominalSineCoefficients( i, j ) = ( j > 0 ) ?
+                        1.0E-6 * std::sin( static_cast< double >( i + j ) ) / ( i + 1 ) : 0.0;
+        }
+    }
+    nominalCosineCoefficients( 0, 0 ) = 1.0;
+
+    // Create variations, with one block contained in another block, and one separate block.
+    std::vector< boost::shared_ptr< TestGravityFieldVariations > > testVariations;
+    testVariations.push_back( boost::make_shared< TestGravityFieldVariations >( 2, 0, 4, 4, 1.0E-8 ) );
+    testVariations.push_back( boost::make_shared< TestGravityFieldVariations >( 3, 1, 4, 3, 2.0E-9 ) );
+    testVariations.push_back( boost::make_shared< TestGravityFieldVariations >( 10, 5, 12, 8, 3.0E-9 ) );
+
+    std::vector< boost::shared_ptr< GravityFieldVariations > > variationObjects(
+                testVariations.begin( ), testVariations.end( ) );
+    std::vector< BodyDeformationTypes > variationTypes( 3, basic_solid_body );
+    std::vector< std::string > variationIdentifiers;
+    variationIdentifiers.push_back( "A" );
+    variationIdentifiers.push_back( "B" );
+    variationIdentifiers.push_back( "C" );
+
+    TimeDependentSphericalHarmonicsGravityField gravityField(
+                3.986004418E14, 6378137.0, nominalCosineCoefficients, nominalSineCoefficients,
+                boost::make_shared< GravityFieldVariationsSet >(
+                    variationObjects, variationTypes, variationIdentifiers ) );
+
+    // Check that contained block is merged.
+    BOOST_CHECK_EQUAL( gravityField.getVariedCoefficientBlocks( ).size( ), 2 );
+
+    for( int test = 0; test < 3; test++ )
+    {
+        // Modify nominal coefficients in last test.
+        if( test == 2 )
+        {
+            nominalCosineCoefficients( 30, 20 ) = 1.0E-3;
+            nominalCosineCoefficients( 3, 2 ) = 2.0E-3;
+            gravityField.setNominalCosineCoefficients( nominalCosineCoefficients );
+        }
+
+        for( double time = 0.0; time < 1.0E4; time += 1234.5 )
+        {
+            gravityField.update( time );
+
+            // Compute expected coefficients by full recomputation.
+            Eigen::MatrixXd expectedCosineCoefficients = nominalCosineCoefficients;
+            Eigen::MatrixXd expectedSineCoefficients = nominalSineCoefficients;
+            for( unsigned int i = 0; i < testVariations.size( ); i++ )
+            {
+                expectedCosineCoefficients.block(
+                            testVariations.at( i )->getMinimumDegree( ), testVariations.at( i )->getMinimumOrder( ),
+                            testVariations.at( i )->getNumberOfDegrees( ), testVariations.at( i )->getNumberOfOrders( ) ) +=
+                        testVariations.at( i )->getCorrection( time, 0 );
+                expectedSineCoefficients.block(
+                            testVariations.at( i )->getMinimumDegree( ), testVariations.at( i )->getMinimumOrder( ),
+                            testVariations.at( i )->getNumberOfDegrees( ), testVariations.at( i )->getNumberOfOrders( ) ) +=
+                        testVariations.at( i )->getCorrection( time, 1 );
+            }
+
+            BOOST_CHECK_SMALL( ( gravityField.getCosineCoefficients( ) - expectedCosineCoefficients ).cwiseAbs( ).maxCoeff( ),
+                               std::numeric_limits< double >::epsilon( ) );
+            BOOST_CHECK_SMALL( ( gravityField.getSineCoefficients( ) - expectedSineCoefficients ).cwiseAbs( ).maxCoeff( ),
+                               std::numeric_limits< double >::epsilon( ) );
+        }
+    }
+
+    // Check that update is skipped for equal times, unless time is reset.
+    int numberOfCalls = testVariations.at( 0 )->getNumberOfCalls( );
+    gravityField.update( 5.0E4 );
+    BOOST_CHECK_EQUAL( testVariations.at( 0 )->getNumberOfCalls( ), numberOfCalls + 1 );
+    gravityField.update( 5.0E4 );
+    BOOST_CHECK_EQUAL( testVariations.at( 0 )->getNumberOfCalls( ), numberOfCalls + 1 );
+    gravityField.resetCurrentTime( );
+    gravityField.update( 5.0E4 );
+    BOOST_CHECK_EQUAL( testVariations.at( 0 )->getNumberOfCalls( ), numberOfCalls + 2 );
+
+    // Check that directly set coefficients are overwritten on next update.
+    gravityField.setCosineCoefficients( Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 1 ) );
+    gravityField.update( 5.0E4 );
+    BOOST_CHECK_EQUAL( gravityField.getCosineCoefficients( )( 30, 20 ), nominalCosineCoefficients( 30, 20 ) );
+    BOOST_CHECK_EQUAL( testVariations.at( 0 )->getNumberOfCalls( ), numberOfCalls + 3 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -8,6 +8,8 @@
  *    http://tudat.tudelft.nl/LICENSE.
  */
 
+#include <boost/lexical_cast.hpp>
+
 #include "Tudat/Astrodynamics/Gravitation/basicSolidBodyTideGravityFieldVariations.h"
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
 #include "Tudat/Mathematics/BasicMathematics/legendrePolynomials.h"
@@ -102,27 +104,118 @@ std::pair< Eigen::MatrixXd, Eigen::MatrixXd > calculateSolidBodyTideSingleCoeffi
     Eigen::MatrixXd cosineCorrections = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumOrder + 1 );
     Eigen::MatrixXd sineCorrections = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumOrder + 1 );
 
-    std::complex< double > currentCorrections;
-
-    // Iterate over all requested degrees and orders
-    for( int n = 2; n <= maximumDegree; n++ )
+    if( maximumDegree >= 2 )
     {
-        for( int m = 0; ( m <= maximumOrder && m <= n ); m++ )
+        if( loveNumbers.size( ) < static_cast< unsigned int >( maximumDegree - 1 ) )
         {
-            // Calculate and set corrections at current degree and order.
-            currentCorrections = calculateSolidBodyTideSingleCoefficientSetCorrectionFromAmplitude(
-                       loveNumbers.at( n - 2 ).at( m ), massRatio, referenceRadius, relativeBodyFixedPosition, n, m );
-            cosineCorrections( n, m ) = currentCorrections.real( );
-            if( m > 0 )
-            {
-                sineCorrections( n, m ) = -currentCorrections.imag( );
-            }
+            throw std::runtime_error( "Error when computing solid body tide corrections, Love numbers up to degree " +
+                                      boost::lexical_cast< std::string >( maximumDegree ) + " not available" );
         }
+
+        // Retrieve Love numbers up to requested degree.
+        std::vector< std::vector< std::complex< double > > > truncatedLoveNumbers(
+                    loveNumbers.begin( ), loveNumbers.begin( ) + ( maximumDegree - 1 ) );
+        std::pair< Eigen::MatrixXd, Eigen::MatrixXd > loveNumberFactors =
+                getSolidBodyTideLoveNumberFactors( truncatedLoveNumbers, maximumOrder );
+
+        // Calculate corrections at all degrees and orders.
+        basic_mathematics::LegendreCache legendreCache( maximumDegree, maximumOrder, true );
+        Eigen::VectorXd cosineOfOrderTimesLongitude = Eigen::VectorXd::Zero( maximumOrder + 1 );
+        Eigen::VectorXd sineOfOrderTimesLongitude = Eigen::VectorXd::Zero( maximumOrder + 1 );
+        addSolidBodyTideCorrectionsFromLoveNumberFactors(
+                    loveNumberFactors.first, loveNumberFactors.second, massRatio, referenceRadius,
+                    relativeBodyFixedPosition, legendreCache, cosineOfOrderTimesLongitude, sineOfOrderTimesLongitude,
+                    cosineCorrections.block( 2, 0, maximumDegree - 1, maximumOrder + 1 ),
+                    sineCorrections.block( 2, 0, maximumDegree - 1, maximumOrder + 1 ) );
     }
 
     return std::make_pair( cosineCorrections, sineCorrections );
 }
 
+//! Function to compute the (scaled) real and imaginary parts of the Love numbers, as used for the tidal corrections
+std::pair< Eigen::MatrixXd, Eigen::MatrixXd > getSolidBodyTideLoveNumberFactors(
+        const std::vector< std::vector< std::complex< double > > >& loveNumbers, const int maximumOrder )
+{
+    Eigen::MatrixXd realLoveNumberFactors = Eigen::MatrixXd::Zero( loveNumbers.size( ), maximumOrder + 1 );
+    Eigen::MatrixXd imaginaryLoveNumberFactors = Eigen::MatrixXd::Zero( loveNumbers.size( ), maximumOrder + 1 );
+
+    for( unsigned int i = 0; i < loveNumbers.size( ); i++ )
+    {
+        double degreeScaling = 1.0 / ( 2.0 * static_cast< double >( i + 2 ) + 1.0 );
+        for( unsigned int m = 0; ( m <= i + 2 && m < loveNumbers.at( i ).size( ) &&
+                                   static_cast< int >( m ) <= maximumOrder ); m++ )
+        {
+            realLoveNumberFactors( i, m ) = degreeScaling * loveNumbers.at( i ).at( m ).real( );
+            imaginaryLoveNumberFactors( i, m ) = degreeScaling * loveNumbers.at( i ).at( m ).imag( );
+        }
+    }
+
+    return std::make_pair( realLoveNumberFactors, imaginaryLoveNumberFactors );
+}
+
+//! Function to add solid body tide gravity field variations due to single body at a set of degrees and orders.
+void addSolidBodyTideCorrectionsFromLoveNumberFactors(
+        const Eigen::MatrixXd& realLoveNumberFactors, const Eigen::MatrixXd& imaginaryLoveNumberFactors,
+        const double massRatio, const double referenceRadius, const Eigen::Vector3d& relativeBodyFixedPosition,
+        basic_mathematics::LegendreCache& legendreCache,
+        Eigen::VectorXd& cosineOfOrderTimesLongitude, Eigen::VectorXd& sineOfOrderTimesLongitude,
+        Eigen::Block< Eigen::MatrixXd > cosineCorrections, Eigen::Block< Eigen::MatrixXd > sineCorrections )
+{
+    const int numberOfDegrees = realLoveNumberFactors.rows( );
+    const int numberOfOrders = realLoveNumberFactors.cols( );
+
+    // Compute trigonometric functions of (multiples of) longitude, using recursion for multiples.
+    double distance = relativeBodyFixedPosition.norm( );
+    double horizontalDistance = std::sqrt( relativeBodyFixedPosition.x( ) * relativeBodyFixedPosition.x( ) +
+                                           relativeBodyFixedPosition.y( ) * relativeBodyFixedPosition.y( ) );
+    cosineOfOrderTimesLongitude( 0 ) = 1.0;
+    sineOfOrderTimesLongitude( 0 ) = 0.0;
+    if( numberOfOrders > 1 )
+    {
+        cosineOfOrderTimesLongitude( 1 ) =
+                ( horizontalDistance > 0.0 ) ? relativeBodyFixedPosition.x( ) / horizontalDistance : 1.0;
+        sineOfOrderTimesLongitude( 1 ) =
+                ( horizontalDistance > 0.0 ) ? relativeBodyFixedPosition.y( ) / horizontalDistance : 0.0;
+    }
+    for( int m = 2; m < numberOfOrders; m++ )
+    {
+        cosineOfOrderTimesLongitude( m ) = cosineOfOrderTimesLongitude( m - 1 ) * cosineOfOrderTimesLongitude( 1 ) -
+                sineOfOrderTimesLongitude( m - 1 ) * sineOfOrderTimesLongitude( 1 );
+        sineOfOrderTimesLongitude( m ) = sineOfOrderTimesLongitude( m - 1 ) * cosineOfOrderTimesLongitude( 1 ) +
+                cosineOfOrderTimesLongitude( m - 1 ) * sineOfOrderTimesLongitude( 1 );
+    }
+
+    // Update Legendre polynomials to current sine of latitude.
+    legendreCache.update( relativeBodyFixedPosition.z( ) / distance );
+
+    // Initialize mass ratio times radius ratio^(n+1) (calculation starts at n=2)
+    double radiusRatio = referenceRadius / distance;
+    double scalingFactor = massRatio * radiusRatio * radiusRatio * radiusRatio;
+
+    // Add corrections for all degrees and orders, using:
+    // Delta C_{n,m} - i * Delta S_{n,m} = k_{n,m} / ( 2n + 1 ) * scalingFactor * P_{n,m} * exp( -i * m * longitude )
+    double scaledLegendrePolynomial;
+    for( int i = 0; i < numberOfDegrees; i++ )
+    {
+        for( int m = 0; ( m <= i + 2 && m < numberOfOrders ); m++ )
+        {
+            scaledLegendrePolynomial = scalingFactor * legendreCache.getLegendrePolynomial( i + 2, m );
+
+            cosineCorrections( i, m ) += scaledLegendrePolynomial * (
+                        realLoveNumberFactors( i, m ) * cosineOfOrderTimesLongitude( m ) +
+                        imaginaryLoveNumberFactors( i, m ) * sineOfOrderTimesLongitude( m ) );
+            if( m != 0 )
+            {
+                sineCorrections( i, m ) += scaledLegendrePolynomial * (
+                            realLoveNumberFactors( i, m ) * sineOfOrderTimesLongitude( m ) -
+                            imaginaryLoveNumberFactors( i, m ) * cosineOfOrderTimesLongitude( m ) );
+            }
+        }
+
+        // Increment radius ratio power.
+        scalingFactor *= radiusRatio;
+    }
+}
 
 //! Sets current properties (mass state) of body involved in tidal deformation.
 void BasicSolidBodyTideGravityFieldVariations::setBodyGeometryParameters(
@@ -135,45 +228,55 @@ void BasicSolidBodyTideGravityFieldVariations::setBodyGeometryParameters(
         toDeformedBodyFrameRotation = deformedBodyOrientationFunction_( evaluationTime );
     }
 
-    // Calculate current state of body causing deformation.
-    Eigen::Vector3d relativeDeformingBodyPosition = toDeformedBodyFrameRotation * (
+    // Calculate current position of body causing deformation, in frame fixed to deformed body.
+    relativeDeformingBodyPosition = toDeformedBodyFrameRotation * (
                 deformingBodyStateFunctions_[ bodyIndex ]( evaluationTime ).segment( 0, 3 ) -
             deformedBodyPosition );
-    Eigen::Vector3d  relativeDeformingBodySphericalPosition =coordinate_conversions::
-            convertCartesianToSpherical( relativeDeformingBodyPosition );
-
-    // Set geometric parameters of body causing deformation.
-    radiusRatio = deformedBodyReferenceRadius_ / relativeDeformingBodySphericalPosition.x( );
-    iLongitude = mathematical_constants::COMPLEX_I * relativeDeformingBodySphericalPosition.z( );
-    sineOfLatitude = std::sin( mathematical_constants::PI / 2.0 -
-                               relativeDeformingBodySphericalPosition.y( ) );
 }
 
 //! Function for calculating spherical harmonic coefficient corrections.
 std::pair< Eigen::MatrixXd, Eigen::MatrixXd > BasicSolidBodyTideGravityFieldVariations::
 calculateBasicSphericalHarmonicsCorrections(
         const double time )
+{
+    updateCurrentCorrections( time );
+    return std::make_pair( currentCosineCorrections_, currentSineCorrections_ );
+}
+
+//! Function to add sine and cosine corrections at given time to coefficient matrices.
+void BasicSolidBodyTideGravityFieldVariations::addSphericalHarmonicsCorrections(
+        const double time, Eigen::MatrixXd& sineCoefficients, Eigen::MatrixXd& cosineCoefficients )
+{
+    updateCurrentCorrections( time );
+
+    sineCoefficients.block( minimumDegree_, minimumOrder_, numberOfDegrees_, numberOfOrders_ ) +=
+            currentSineCorrections_;
+    cosineCoefficients.block( minimumDegree_, minimumOrder_, numberOfDegrees_, numberOfOrders_ ) +=
+            currentCosineCorrections_;
+}
+
+//! Function to compute the current corrections due to all bodies causing deformation.
+void BasicSolidBodyTideGravityFieldVariations::updateCurrentCorrections( const double time )
 {
     // Initialize corrections to zero.
-    Eigen::MatrixXd cTermCorrections = Eigen::MatrixXd::Zero( numberOfDegrees_, numberOfOrders_ );
-    Eigen::MatrixXd sTermCorrections = Eigen::MatrixXd::Zero( numberOfDegrees_, numberOfOrders_ );
+    currentCosineCorrections_.setZero( );
+    currentSineCorrections_.setZero( );
 
     // Iterate over all bodies causing deformation and calculate and add associated corrections
+    double deformedBodyMass = deformedBodyMass_( );
     for( unsigned int i = 0; i < deformingBodyStateFunctions_.size( ); i++ )
     {
         setBodyGeometryParameters( i, time );
 
         // Calculate properties of currently considered body
-        massRatio = deformingBodyMasses_[ i ]( ) / deformedBodyMass_( );
+        massRatio = deformingBodyMasses_[ i ]( ) / deformedBodyMass;
 
         // Calculate all correction functions.
         for( unsigned int j = 0; j < correctionFunctions.size( ); j++ )
         {
-            correctionFunctions[ j ]( cTermCorrections, sTermCorrections );
+            correctionFunctions[ j ]( currentCosineCorrections_, currentSineCorrections_ );
         }
     }
-
-    return std::make_pair( cTermCorrections, sTermCorrections );
 }
 
 //! Calculates basic solid body gravity field corrections due to single body.
@@ -181,44 +284,11 @@ void BasicSolidBodyTideGravityFieldVariations::addBasicSolidBodyTideCorrections(
         Eigen::MatrixXd& cTermCorrections,
         Eigen::MatrixXd& sTermCorrections )
 {
-//    // Initialize power of radiusRatio^(N+1) (calculation starts at N=2)
-    radiusRatioPower = radiusRatio * radiusRatio * radiusRatio;
-
-    currentCosineCorrections_.setZero( );
-    currentSineCorrections_.setZero( );
-
-    //    // Iterate over all love
-    std::complex< double > stokesCoefficientCorrection( 0.0, 0.0 );
-
-    for( unsigned int n = 2; n < loveNumbers_.size( ) + 2; n++ )
-    {
-        for( unsigned int m = 0; ( m <= n && m < loveNumbers_.at( n - 2 ).size( ) ); m++ )
-        {
-            updateTidalAmplitudeAndArgument( n, m );
-
-            // Calculate and add coefficients.
-            stokesCoefficientCorrection =
-                    calculateSolidBodyTideSingleCoefficientSetCorrectionFromAmplitude(
-                        loveNumbers_[ n - 2 ][ m ], massRatio, radiusRatioPower, tideAmplitude,
-                    tideArgument, n, m );
-
-
-            currentCosineCorrections_( n - 2, m ) += stokesCoefficientCorrection.real( );
-            if( m != 0 )
-            {
-                currentSineCorrections_( n - 2, m ) -= stokesCoefficientCorrection.imag( );
-            }
-        }
-
-        // Increment radius ratio power.
-        radiusRatioPower *= radiusRatio;
-    }
-
-    cTermCorrections.block( 0, 0, maximumDegree_ - minimumDegree_ + 1, maximumOrder_  - minimumOrder_ + 1 ) +=
-            currentCosineCorrections_;
-    sTermCorrections.block( 0, 0, maximumDegree_ - minimumDegree_ + 1, maximumOrder_  - minimumOrder_ + 1 ) +=
-            currentSineCorrections_;
-
+    addSolidBodyTideCorrectionsFromLoveNumberFactors(
+                realLoveNumberFactors_, imaginaryLoveNumberFactors_, massRatio, deformedBodyReferenceRadius_,
+                relativeDeformingBodyPosition, legendreCache_, cosineOfOrderTimesLongitude_, sineOfOrderTimesLongitude_,
+                cTermCorrections.block( 0, 0, numberOfDegrees_, numberOfOrders_ ),
+                sTermCorrections.block( 0, 0, numberOfDegrees_, numberOfOrders_ ) );
 }
 
 }
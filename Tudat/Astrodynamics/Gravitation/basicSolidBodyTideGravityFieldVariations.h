@@ -126,6 +126,48 @@ std::pair< Eigen::MatrixXd, Eigen::MatrixXd > calculateSolidBodyTideSingleCoeffi
         const double referenceRadius, const Eigen::Vector3d& relativeBodyFixedPosition,
         const int maximumDegree, const int maximumOrder );
 
+//! Function to compute the (scaled) real and imaginary parts of the Love numbers, as used for the tidal corrections
+/*!
+ *  Function to compute the real and imaginary parts of the Love numbers, divided by (2n+1), as used by
+ *  addSolidBodyTideCorrectionsFromLoveNumberFactors. Entries for which no Love number is defined are set to zero.
+ *  \param loveNumbers Complex Love numbers for each degree and order (index of first vector is degree-2; index of second
+ *  vector is order.
+ *  \param maximumOrder Maximum order of current coefficient corrections.
+ *  \return Real (first) and imaginary (second) parts of k_{n,m}/(2n+1), with row index degree-2 and column index
+ *  order.
+ */
+std::pair< Eigen::MatrixXd, Eigen::MatrixXd > getSolidBodyTideLoveNumberFactors(
+        const std::vector< std::vector< std::complex< double > > >& loveNumbers, const int maximumOrder );
+
+//! Function to add solid body tide gravity field variations due to single body at a set of degrees and orders.
+/*!
+ *  Function to add solid body tide gravity field variations due to single body at a set of degrees and orders
+ *  (frequency-independent part), after (Petit et al. 2010, eq. 6.6). All degrees and orders are evaluated in a single
+ *  pass: the (geodesy-normalized) Legendre polynomials are retrieved from a cache, and the trigonometric functions of
+ *  the multiples of the longitude are computed by recursion, so that no complex arithmetic is required. The corrections
+ *  are added directly to the blocks provided as input.
+ *  \param realLoveNumberFactors Real parts of k_{n,m}/(2n+1) (see getSolidBodyTideLoveNumberFactors).
+ *  \param imaginaryLoveNumberFactors Imaginary parts of k_{n,m}/(2n+1) (see getSolidBodyTideLoveNumberFactors).
+ *  \param massRatio Ratio of masses of body causing deformation to body being deformed.
+ *  \param referenceRadius Equatorial radius of body being deformed.
+ *  \param relativeBodyFixedPosition Cartesian position of body causing deformation in a frame centered on and fixed to
+ *  the body that is being deformed.
+ *  \param legendreCache Geodesy-normalized Legendre polynomial cache, of at least the maximum degree of the corrections
+ *  (updated by this function).
+ *  \param cosineOfOrderTimesLongitude Work vector, of at least the number of orders, to which cos(m*longitude) is set.
+ *  \param sineOfOrderTimesLongitude Work vector, of at least the number of orders, to which sin(m*longitude) is set.
+ *  \param cosineCorrections Block of cosine coefficient corrections, starting at degree 2 and order 0, to which the
+ *  corrections are added.
+ *  \param sineCorrections Block of sine coefficient corrections, starting at degree 2 and order 0, to which the
+ *  corrections are added.
+ */
+void addSolidBodyTideCorrectionsFromLoveNumberFactors(
+        const Eigen::MatrixXd& realLoveNumberFactors, const Eigen::MatrixXd& imaginaryLoveNumberFactors,
+        const double massRatio, const double referenceRadius, const Eigen::Vector3d& relativeBodyFixedPosition,
+        basic_mathematics::LegendreCache& legendreCache,
+        Eigen::VectorXd& cosineOfOrderTimesLongitude, Eigen::VectorXd& sineOfOrderTimesLongitude,
+        Eigen::Block< Eigen::MatrixXd > cosineCorrections, Eigen::Block< Eigen::MatrixXd > sineCorrections );
+
 //! Class to calculate first-order solid body tide gravity field variations on a single body raised
 //! by any number of bodies up to any degree and order.
 class BasicSolidBodyTideGravityFieldVariations: public GravityFieldVariations
@@ -169,7 +211,8 @@ public:
         deformedBodyMass_( deformedBodyMass ),
         deformingBodyMasses_( deformingBodyMasses ),
         loveNumbers_( loveNumbers ),
-        deformingBodies_( deformingBodies )
+        deformingBodies_( deformingBodies ),
+        legendreCache_( maximumDegree_, maximumOrder_, true )
     {
         // Set basic deformation functon as function to be evaluated when requesting variations.
         correctionFunctions.push_back(
@@ -180,6 +223,10 @@ public:
                     maximumDegree_ - minimumDegree_ + 1, maximumOrder_ - minimumOrder_ + 1 );
         currentSineCorrections_ = Eigen::MatrixXd::Zero(
                     maximumDegree_ - minimumDegree_ + 1, maximumOrder_ - minimumOrder_ + 1 );
+
+        cosineOfOrderTimesLongitude_ = Eigen::VectorXd::Zero( numberOfOrders_ );
+        sineOfOrderTimesLongitude_ = Eigen::VectorXd::Zero( numberOfOrders_ );
+        updateLoveNumberFactors( );
     }
 
     //! Destructor
@@ -209,6 +256,22 @@ public:
         return calculateBasicSphericalHarmonicsCorrections( time );
     }
 
+    //! Function to add sine and cosine corrections at given time to coefficient matrices.
+    /*!
+     *  Function to add sine and cosine corrections at given time to coefficient matrices. Overrides the base class
+     *  function, so that the corrections are accumulated in pre-allocated matrices, and added to the coefficient
+     *  blocks without creating temporary matrices.
+     *  \param time Time at which corrections are to be evaluated.
+     *  \param sineCoefficients Current spherical harmonic sine coefficients, calculated
+     *  corrections are added and returned by reference
+     *  \param cosineCoefficients Current spherical harmonic cosine coefficients, calculated
+     *  corrections are added and returned by reference
+     */
+    void addSphericalHarmonicsCorrections(
+            const double time,
+            Eigen::MatrixXd& sineCoefficients,
+            Eigen::MatrixXd& cosineCoefficients );
+
     //! Function to retrieve the love numbers at given degree.
     /*!
      *  Function to retrieve the love numbers at given degree. Returns a vector containing (complex)
@@ -248,6 +311,7 @@ public:
             if( loveNumbers.size( ) <= static_cast< unsigned int >( degree ) )
             {
                 loveNumbers_[ degree - 2 ] = loveNumbers;
+                updateLoveNumberFactors( );
             }
             else
             {                               
@@ -366,7 +430,7 @@ public:
     //! Function to return the current corrections to the cosine coefficients.
     /*!
      * Function to return the current corrections to the cosine coefficients (as calculated by
-     * current instance of this class).
+     * current instance of this class, due to all bodies causing deformation).
      * \return Current corrections to the cosine coefficients.
      */
     Eigen::MatrixXd getCurrentCosineCorrections( )
@@ -377,7 +441,7 @@ public:
     //! Function to return the current corrections to the sine coefficients.
     /*!
      * Function to return the current corrections to the sine coefficients (as calculated by
-     * current instance of this class).
+     * current instance of this class, due to all bodies causing deformation).
      * \return Current corrections to the sine coefficients.
      */
     Eigen::MatrixXd getCurrentSineCorrections( )
@@ -387,6 +451,23 @@ public:
 
 protected:
 
+    //! Function to compute the current corrections due to all bodies causing deformation.
+    /*!
+     *  Function to compute the current corrections due to all bodies causing deformation, which are set in the
+     *  currentCosineCorrections_ and currentSineCorrections_ member variables.
+     *  \param time Time at which variations are to be calculated.
+     */
+    void updateCurrentCorrections( const double time );
+
+    //! Function to update the scaled real and imaginary parts of the Love numbers from the loveNumbers_ member.
+    void updateLoveNumberFactors( )
+    {
+        std::pair< Eigen::MatrixXd, Eigen::MatrixXd > loveNumberFactors =
+                getSolidBodyTideLoveNumberFactors( loveNumbers_, maximumOrder_ );
+        realLoveNumberFactors_ = loveNumberFactors.first;
+        imaginaryLoveNumberFactors_ = loveNumberFactors.second;
+    }
+
     //! List of functions to call for calculating spherical harmonic corrections.
     /*!
      *  List of functions to call for calculating spherical harmonic corrections. Each function
@@ -422,20 +503,6 @@ protected:
     virtual void setBodyGeometryParameters(
             const int bodyIndex, const double evaluationTime);
 
-    //! Calculate tidal amplitude and argument at current degree and order.
-    /*!
-     * Calculate tidal amplitude and argument at current degree and order.
-     * \param degree Degree of tide.
-     * \param order Order of tide.
-     */
-    virtual void updateTidalAmplitudeAndArgument(
-            const int degree, const int order )
-    {
-        tideAmplitude = basic_mathematics::computeLegendrePolynomialExplicit(
-                    degree, order, sineOfLatitude );
-        tideArgument = static_cast< double >( order ) * iLongitude;
-    }
-
 
     //! Function returning state of body being deformed.
     /*!
@@ -499,49 +566,12 @@ protected:
      */
     double massRatio;
 
-    //! Ratio of radii in current calculation step.
-    /*!
-     *  Ratio of equatorial radius of body being deformed over distance between center of body
-     *  being deformed to center of body causing deformation in current calculation step
-     */
-    double radiusRatio;
-
-    //! Ratio of radii in current calculation step to the power (degree+1).
-    /*!
-     *  Ratio of equatorial radius of body being deformed over distance between center of body
-     *  being deformed to center of body causing deformation, to the power (degree+1), in current
-     *  calculation step
-     */
-    double radiusRatioPower;
-
-    //! Sine of latitude of currently considered body in current calculation step
-    /*!
-     *  Sine of latitude of body causing deformation in frame fixed to body being deformed in
-     *  current calculation step.
-     */
-    double sineOfLatitude;
-
-    //! Longitude of currently considered body times i in current calculation step
-    /*!
-     *  i (sqrt(-1)) times longitude of body causing deformation in frame fixed to body being
-     *  deformed in current calculation step.
-     */
-    std::complex< double > iLongitude;
-
-    //! Current argument of the tide.
-    /*!
-     *  Current argument of the tide, to be used as input to
-     *  calculateSolidBodyTideSingleCoefficientSetCorrectionFromAmplitude, modulates the tide as
-     *  exp( -tideArgument).
-     */
-    std::complex< double > tideArgument;
-
-    //! Current amplitude of the tide.
+    //! Position of currently considered body in current calculation step
     /*!
-     *  Current amplitude of the tide, to be used as input to
-     *  calculateSolidBodyTideSingleCoefficientSetCorrectionFromAmplitude.
+     *  Position of body causing deformation in frame centered on and fixed to body being deformed in current
+     *  calculation step.
      */
-    double tideAmplitude;
+    Eigen::Vector3d relativeDeformingBodyPosition;
 
     //! Current position of body being deformed.
     Eigen::Vector3d deformedBodyPosition;
@@ -555,6 +585,21 @@ protected:
     //! Tidal corrections to sine coefficients at current calculation step.
     Eigen::MatrixXd currentSineCorrections_;
 
+    //! Real parts of k_{n,m}/(2n+1) (row index degree-2, column index order).
+    Eigen::MatrixXd realLoveNumberFactors_;
+
+    //! Imaginary parts of k_{n,m}/(2n+1) (row index degree-2, column index order).
+    Eigen::MatrixXd imaginaryLoveNumberFactors_;
+
+    //! Geodesy-normalized Legendre polynomial cache, shared by all bodies causing deformation.
+    basic_mathematics::LegendreCache legendreCache_;
+
+    //! Cosine of order times longitude of currently considered body (index is order).
+    Eigen::VectorXd cosineOfOrderTimesLongitude_;
+
+    //! Sine of order times longitude of currently considered body (index is order).
+    Eigen::VectorXd sineOfOrderTimesLongitude_;
+
 };
 
 } // namespace gravitation
@@ -181,7 +181,7 @@ public:
      *  \param cosineCoefficients Current spherical harmonic cosine coefficients, calculated
      *  corrections are added and returned by reference
      */
-    void addSphericalHarmonicsCorrections(
+    virtual void addSphericalHarmonicsCorrections(
             const double time,
             Eigen::MatrixXd& sineCoefficients,
             Eigen::MatrixXd& cosineCoefficients );
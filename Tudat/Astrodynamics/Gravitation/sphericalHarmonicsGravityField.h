@@ -134,7 +134,7 @@ public:
      *  Function to reset the cosine spherical harmonic coefficients (geodesy normalized)
      *  \param cosineCoefficients New cosine spherical harmonic coefficients (geodesy normalized)
      */
-    void setCosineCoefficients( const Eigen::MatrixXd& cosineCoefficients )
+    virtual void setCosineCoefficients( const Eigen::MatrixXd& cosineCoefficients )
     {
         cosineCoefficients_ = cosineCoefficients;
     }
@@ -144,7 +144,7 @@ public:
      *  Function to reset the cosine spherical harmonic coefficients (geodesy normalized)
      *  \param sineCoefficients New sine spherical harmonic coefficients (geodesy normalized)
      */
-    void setSineCoefficients( const Eigen::MatrixXd& sineCoefficients )
+    virtual void setSineCoefficients( const Eigen::MatrixXd& sineCoefficients )
     {
         sineCoefficients_ = sineCoefficients;
     }
@@ -177,6 +177,36 @@ public:
         return sineCoefficients_.block( 0, 0, maximumDegree + 1, maximumOrder + 1 );
     }
 
+    //! Function to get a cosine spherical harmonic coefficient block (geodesy normalized) into an existing matrix
+    /*!
+     *  Function to get a cosine spherical harmonic coefficient block (geodesy normalized) up to a given degree and
+     *  order, copied into an existing matrix. If the matrix already has the size of the block, no memory is allocated.
+     *  \param cosineCoefficientBlock Cosine spherical harmonic coefficients (geodesy normalized) up to given degree and
+     *  order (returned by reference).
+     *  \param maximumDegree Maximum degree of coefficient block
+     *  \param maximumOrder Maximum order of coefficient block
+     */
+    void getCosineCoefficientsBlock( Eigen::MatrixXd& cosineCoefficientBlock,
+                                     const int maximumDegree, const int maximumOrder )
+    {
+        cosineCoefficientBlock = cosineCoefficients_.block( 0, 0, maximumDegree + 1, maximumOrder + 1 );
+    }
+
+    //! Function to get a sine spherical harmonic coefficient block (geodesy normalized) into an existing matrix
+    /*!
+     *  Function to get a sine spherical harmonic coefficient block (geodesy normalized) up to a given degree and
+     *  order, copied into an existing matrix. If the matrix already has the size of the block, no memory is allocated.
+     *  \param sineCoefficientBlock Sine spherical harmonic coefficients (geodesy normalized) up to given degree and
+     *  order (returned by reference).
+     *  \param maximumDegree Maximum degree of coefficient block
+     *  \param maximumOrder Maximum order of coefficient block
+     */
+    void getSineCoefficientsBlock( Eigen::MatrixXd& sineCoefficientBlock,
+                                   const int maximumDegree, const int maximumOrder )
+    {
+        sineCoefficientBlock = sineCoefficients_.block( 0, 0, maximumDegree + 1, maximumOrder + 1 );
+    }
+
     //! Get maximum degree of spherical harmonics gravity field expansion.
     /*!
      *  Returns the maximum degree of the spherical harmonics gravity field expansion.
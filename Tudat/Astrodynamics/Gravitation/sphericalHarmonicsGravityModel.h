@@ -160,6 +160,9 @@ private:
     //! Typedef for coefficient-matrix-returning function.
     typedef boost::function< Eigen::MatrixXd( ) > CoefficientMatrixReturningFunction;
 
+    //! Typedef for function updating a coefficient matrix in place.
+    typedef boost::function< void( Eigen::MatrixXd& ) > CoefficientMatrixUpdateFunction;
+
 public:
 
     //! Constructor taking position-functions for bodies, and constant parameters of spherical
@@ -307,8 +310,17 @@ public:
     {
         if( !( this->currentTime_ == currentTime ) )
         {
-            cosineHarmonicCoefficients = getCosineHarmonicsCoefficients( );
-            sineHarmonicCoefficients = getSineHarmonicsCoefficients( );
+            // Retrieve current coefficients, in place if possible.
+            if( !updateCosineHarmonicsCoefficients_.empty( ) )
+            {
+                updateCosineHarmonicsCoefficients_( cosineHarmonicCoefficients );
+                updateSineHarmonicsCoefficients_( sineHarmonicCoefficients );
+            }
+            else
+            {
+                cosineHarmonicCoefficients = getCosineHarmonicsCoefficients( );
+                sineHarmonicCoefficients = getSineHarmonicsCoefficients( );
+            }
             rotationToIntegrationFrame_ = rotationFromBodyFixedToIntegrationFrameFunction_( );
             this->updateBaseMembers( );
             currentAcceleration_ = rotationToIntegrationFrame_ *
@@ -360,6 +372,24 @@ public:
         return getSineHarmonicsCoefficients;
     }
 
+    //! Function to set functions that update the coefficient matrices in place.
+    /*!
+     * Function to set functions that update the cosine and sine coefficient matrices of this model in place, for
+     * instance by SphericalHarmonicsGravityField::getCosineCoefficientsBlock. When set, these functions are used by
+     * updateMembers instead of the coefficient-returning functions (which create a new matrix for each call), so that no
+     * memory is allocated when updating the model. The functions must provide the same coefficients as the
+     * coefficient-returning functions of this model.
+     * \param cosineHarmonicCoefficientsUpdateFunction Function updating the matrix of cosine coefficients in place.
+     * \param sineHarmonicCoefficientsUpdateFunction Function updating the matrix of sine coefficients in place.
+     */
+    void setCoefficientUpdateFunctions(
+            const CoefficientMatrixUpdateFunction& cosineHarmonicCoefficientsUpdateFunction,
+            const CoefficientMatrixUpdateFunction& sineHarmonicCoefficientsUpdateFunction )
+    {
+        updateCosineHarmonicsCoefficients_ = cosineHarmonicCoefficientsUpdateFunction;
+        updateSineHarmonicsCoefficients_ = sineHarmonicCoefficientsUpdateFunction;
+    }
+
     //! Function to retrieve the current rotation from body-fixed frame to integration frame, in the form of a quaternion.
     /*!
      *  Function to retrieve the current rotation from body-fixed frame to integration frame, in the form of a quaternion.
@@ -416,6 +446,12 @@ private:
      */
     const CoefficientMatrixReturningFunction getSineHarmonicsCoefficients;
 
+    //! Function updating the cosine harmonics coefficients matrix in place (empty if not used).
+    CoefficientMatrixUpdateFunction updateCosineHarmonicsCoefficients_;
+
+    //! Function updating the sine harmonics coefficients matrix in place (empty if not used).
+    CoefficientMatrixUpdateFunction updateSineHarmonicsCoefficients_;
+
     //! Function returning the current rotation from body-fixed frame to integration frame.
     boost::function< Eigen::Quaterniond( ) > rotationFromBodyFixedToIntegrationFrameFunction_;
 
@@ -25,6 +25,7 @@ void TimeDependentSphericalHarmonicsGravityField::setFieldVariationSettings(
 {
     // Set new variation set.
     gravityFieldVariationsSet_ = gravityFieldVariationUpdateSettings;
+    requestFullReset( );
 
     // Update correction functions if necessary.
     if( updateCorrections )
@@ -38,15 +39,90 @@ void TimeDependentSphericalHarmonicsGravityField::clearVariations( )
 {
     gravityFieldVariationsSet_ = boost::shared_ptr< GravityFieldVariationsSet >( );
     correctionFunctions_.clear( );
+    variedCoefficientBlocks_.clear( );
+    requestFullReset( );
+}
+
+//! Function to update the list of coefficient blocks that are modified by the gravity field variations.
+void TimeDependentSphericalHarmonicsGravityField::updateVariedCoefficientBlocks( )
+{
+    variedCoefficientBlocks_.clear( );
+
+    std::vector< boost::shared_ptr< GravityFieldVariations > > variationObjects =
+            gravityFieldVariationsSet_->getVariationObjects( );
+    for( unsigned int i = 0; i < variationObjects.size( ); i++ )
+    {
+        boost::tuple< int, int, int, int > currentBlock = boost::make_tuple(
+                    variationObjects.at( i )->getMinimumDegree( ), variationObjects.at( i )->getMinimumOrder( ),
+                    variationObjects.at( i )->getNumberOfDegrees( ), variationObjects.at( i )->getNumberOfOrders( ) );
+
+        // Check if block is contained in an existing block, and replace existing blocks contained in this block.
+        bool isBlockContained = false;
+        for( unsigned int j = 0; j < variedCoefficientBlocks_.size( ); j++ )
+        {
+            const boost::tuple< int, int, int, int >& existingBlock = variedCoefficientBlocks_.at( j );
+            if( currentBlock.get< 0 >( ) >= existingBlock.get< 0 >( ) &&
+                    currentBlock.get< 1 >( ) >= existingBlock.get< 1 >( ) &&
+                    currentBlock.get< 0 >( ) + currentBlock.get< 2 >( ) <=
+                    existingBlock.get< 0 >( ) + existingBlock.get< 2 >( ) &&
+                    currentBlock.get< 1 >( ) + currentBlock.get< 3 >( ) <=
+                    existingBlock.get< 1 >( ) + existingBlock.get< 3 >( ) )
+            {
+                isBlockContained = true;
+                break;
+            }
+            else if( existingBlock.get< 0 >( ) >= currentBlock.get< 0 >( ) &&
+                     existingBlock.get< 1 >( ) >= currentBlock.get< 1 >( ) &&
+                     existingBlock.get< 0 >( ) + existingBlock.get< 2 >( ) <=
+                     currentBlock.get< 0 >( ) + currentBlock.get< 2 >( ) &&
+                     existingBlock.get< 1 >( ) + existingBlock.get< 3 >( ) <=
+                     currentBlock.get< 1 >( ) + currentBlock.get< 3 >( ) )
+            {
+                variedCoefficientBlocks_.erase( variedCoefficientBlocks_.begin( ) + j );
+                j--;
+            }
+        }
+
+        if( !isBlockContained )
+        {
+            variedCoefficientBlocks_.push_back( currentBlock );
+        }
+    }
+    requestFullReset( );
 }
 
 
 //! Update gravity field to current time.
 void TimeDependentSphericalHarmonicsGravityField::update( const double time )
 {
-    // Initialize current coefficients to nominal values.
-    sineCoefficients_ = nominalSineCoefficients_;
-    cosineCoefficients_ = nominalCosineCoefficients_;
+    // Check if update is required.
+    if( time == currentTime_ )
+    {
+        return;
+    }
+
+    // Initialize current coefficients to nominal values, either completely, or only for blocks that are modified.
+    if( isFullResetRequired_ )
+    {
+        sineCoefficients_ = nominalSineCoefficients_;
+        cosineCoefficients_ = nominalCosineCoefficients_;
+        isFullResetRequired_ = false;
+    }
+    else
+    {
+        for( unsigned int i = 0; i < variedCoefficientBlocks_.size( ); i++ )
+        {
+            const boost::tuple< int, int, int, int >& currentBlock = variedCoefficientBlocks_[ i ];
+            sineCoefficients_.block( currentBlock.get< 0 >( ), currentBlock.get< 1 >( ),
+                                     currentBlock.get< 2 >( ), currentBlock.get< 3 >( ) ) =
+                    nominalSineCoefficients_.block( currentBlock.get< 0 >( ), currentBlock.get< 1 >( ),
+                                                    currentBlock.get< 2 >( ), currentBlock.get< 3 >( ) );
+            cosineCoefficients_.block( currentBlock.get< 0 >( ), currentBlock.get< 1 >( ),
+                                       currentBlock.get< 2 >( ), currentBlock.get< 3 >( ) ) =
+                    nominalCosineCoefficients_.block( currentBlock.get< 0 >( ), currentBlock.get< 1 >( ),
+                                                      currentBlock.get< 2 >( ), currentBlock.get< 3 >( ) );
+        }
+    }
 
     // Iterate over all corrections.
     for( unsigned int i = 0; i < correctionFunctions_.size( ); i++ )
@@ -54,6 +130,8 @@ void TimeDependentSphericalHarmonicsGravityField::update( const double time )
         // Add correction of this iteration to current coefficients.
         correctionFunctions_[ i ]( time, sineCoefficients_, cosineCoefficients_ );
     }
+
+    currentTime_ = time;
 }
 
 } // namespace gravitation
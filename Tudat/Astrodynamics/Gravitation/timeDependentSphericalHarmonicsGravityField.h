@@ -13,9 +13,12 @@
 
 #include <boost/function.hpp>
 #include <boost/make_shared.hpp>
+#include <boost/tuple/tuple.hpp>
 
 #include <vector>
 
+#include "Tudat/Basics/utilityMacros.h"
+
 #include "Tudat/Mathematics/Interpolators/cubicSplineInterpolator.h"
 
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityField.h"
@@ -66,7 +69,8 @@ public:
             gravitationalParameter, referenceRadius, nominalCosineCoefficients,
             nominalSineCoefficients, fixedReferenceFrame ),
         nominalSineCoefficients_( nominalSineCoefficients ),
-        nominalCosineCoefficients_( nominalCosineCoefficients )
+        nominalCosineCoefficients_( nominalCosineCoefficients ),
+        currentTime_( TUDAT_NAN ), isFullResetRequired_( true )
     { }
 
     //! Full class constructor.
@@ -94,7 +98,8 @@ public:
             nominalCosineCoefficients, nominalSineCoefficients, fixedReferenceFrame ),
         nominalSineCoefficients_( nominalSineCoefficients ),
         nominalCosineCoefficients_( nominalCosineCoefficients ),
-        gravityFieldVariationsSet_( gravityFieldVariationUpdateSettings )
+        gravityFieldVariationsSet_( gravityFieldVariationUpdateSettings ),
+        currentTime_( TUDAT_NAN ), isFullResetRequired_( true )
     {
         updateCorrectionFunctions( );
     }
@@ -107,12 +112,37 @@ public:
 
     //! Update gravity field to current time.
     /*!
-     *  Update gravity field coefficient corrections to current time. All correction functions are
-     *  called and subsequently added to the nominal value.
+     *  Update gravity field coefficient corrections to current time. Only the coefficient blocks that
+     *  are modified by the variations are reset to their nominal values, after which all correction
+     *  functions are called, adding their corrections in-place. If the time is equal to that of the
+     *  previous call (and resetCurrentTime has not been called in the meantime), no update is performed.
      *  \param time Current time.
      */
     void update( const double time );
 
+    //! Function to reset the current time of the gravity field.
+    /*!
+     *  Function to reset the current time of the gravity field, forcing the coefficients to be recomputed
+     *  on the next call to update (typically called with NaN as argument, i.e. before a new state derivative
+     *  evaluation, as the variations may depend on the current states of other bodies).
+     *  \param currentTime New current time.
+     */
+    void resetCurrentTime( const double currentTime = TUDAT_NAN )
+    {
+        currentTime_ = currentTime;
+    }
+
+    //! Function to retrieve the coefficient blocks that are modified by the gravity field variations.
+    /*!
+     *  Function to retrieve the coefficient blocks that are modified by the gravity field variations, each
+     *  defined by start degree, start order, number of degrees and number of orders.
+     *  \return Coefficient blocks that are modified by the gravity field variations.
+     */
+    std::vector< boost::tuple< int, int, int, int > > getVariedCoefficientBlocks( )
+    {
+        return variedCoefficientBlocks_;
+    }
+
     //! Update correction functions.
     /*!
      *  Update correction functions, for instance to account for changed changed environmental
@@ -129,6 +159,7 @@ public:
         {
             // Reset correction functions.
             correctionFunctions_ = gravityFieldVariationsSet_->getVariationFunctions( );
+            updateVariedCoefficientBlocks( );
         }
 
     }
@@ -171,6 +202,7 @@ public:
     void setNominalCosineCoefficients( Eigen::MatrixXd nominalCosineCoefficients )
     {
         nominalCosineCoefficients_ = nominalCosineCoefficients;
+        requestFullReset( );
     }
 
     //! Set nominal (i.e. with zero variations) cosine coefficient of given degree and order.
@@ -186,6 +218,7 @@ public:
                 order <= nominalCosineCoefficients_.cols( ) )
         {
             nominalCosineCoefficients_( degree, order ) = coefficient;
+            requestFullReset( );
         }
         else
         {
@@ -211,6 +244,7 @@ public:
     void setNominalSineCoefficients( const Eigen::MatrixXd& nominalSineCoefficients )
     {
         nominalSineCoefficients_ = nominalSineCoefficients;
+        requestFullReset( );
     }
 
     //! Set nominal (i.e. with zero variations) sine coefficient of given degree and order.
@@ -226,6 +260,7 @@ public:
                 order <= nominalSineCoefficients_.cols( ) )
         {
             nominalSineCoefficients_( degree, order ) = coefficient;
+            requestFullReset( );
         }
         else
         {
@@ -242,8 +277,46 @@ public:
         return gravityFieldVariationsSet_;
     }
 
+    //! Function to reset the current cosine spherical harmonic coefficients (geodesy normalized)
+    /*!
+     *  Function to reset the current cosine spherical harmonic coefficients (geodesy normalized). Note that
+     *  these values are overwritten by the nominal coefficients and variations on the next call to update.
+     *  \param cosineCoefficients New cosine spherical harmonic coefficients (geodesy normalized)
+     */
+    void setCosineCoefficients( const Eigen::MatrixXd& cosineCoefficients )
+    {
+        SphericalHarmonicsGravityField::setCosineCoefficients( cosineCoefficients );
+        requestFullReset( );
+    }
+
+    //! Function to reset the current sine spherical harmonic coefficients (geodesy normalized)
+    /*!
+     *  Function to reset the current sine spherical harmonic coefficients (geodesy normalized). Note that
+     *  these values are overwritten by the nominal coefficients and variations on the next call to update.
+     *  \param sineCoefficients New sine spherical harmonic coefficients (geodesy normalized)
+     */
+    void setSineCoefficients( const Eigen::MatrixXd& sineCoefficients )
+    {
+        SphericalHarmonicsGravityField::setSineCoefficients( sineCoefficients );
+        requestFullReset( );
+    }
+
 private:
 
+    //! Function to require the complete set of current coefficients to be reset on the next update.
+    /*!
+     *  Function to require the complete set of current coefficients to be reset to the nominal values on the
+     *  next update (instead of only the blocks modified by the variations), and to force this update.
+     */
+    void requestFullReset( )
+    {
+        isFullResetRequired_ = true;
+        currentTime_ = TUDAT_NAN;
+    }
+
+    //! Function to update the list of coefficient blocks that are modified by the gravity field variations.
+    void updateVariedCoefficientBlocks( );
+
     //! Nominal (i.e. with zero variations) cosine coefficients.
     /*!
      *  Nominal (i.e. with zero variations) cosine coefficients. When calling the update function,
@@ -277,6 +350,20 @@ private:
      */
     boost::shared_ptr< GravityFieldVariationsSet > gravityFieldVariationsSet_;
 
+    //! Coefficient blocks that are modified by the gravity field variations.
+    /*!
+     *  Coefficient blocks that are modified by the gravity field variations (without duplicates), each
+     *  defined by start degree, start order, number of degrees and number of orders. Only these blocks are
+     *  reset to their nominal values when calling the update function.
+     */
+    std::vector< boost::tuple< int, int, int, int > > variedCoefficientBlocks_;
+
+    //! Time at which the coefficients were last updated (NaN if update is required).
+    double currentTime_;
+
+    //! Boolean denoting whether all coefficients are to be reset to nominal values on the next update.
+    bool isFullResetRequired_;
+
 };
 
 } // namespace gravitation
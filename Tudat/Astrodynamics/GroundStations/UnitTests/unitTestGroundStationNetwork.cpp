@@ -0,0 +1,281 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/parallelization.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/oblateSpheroidBodyShapeModel.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/unitConversions.h"
+#include "Tudat/Astrodynamics/GroundStations/groundStationNetwork.h"
+#include "Tudat/Astrodynamics/ReferenceFrames/referenceFrameTransformations.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::basic_astrodynamics;
+using namespace tudat::coordinate_conversions;
+using namespace tudat::ground_stations;
+using namespace tudat::unit_conversions;
+using mathematical_constants::PI;
+
+//! Function to compute body-fixed state of a target in a circular orbit about the z-axis of the body-fixed frame.
+Eigen::Vector6d computeCircularOrbitState( const double time, const double radius, const double inclination,
+                                           const double angularVelocity, const double initialPhase )
+{
+    const double phase = initialPhase + angularVelocity * time;
+    Eigen::Vector6d state;
+    state << radius * std::cos( phase ), radius * std::sin( phase ) * std::cos( inclination ),
+            radius * std::sin( phase ) * std::sin( inclination ),
+            -radius * angularVelocity * std::sin( phase ),
+            radius * angularVelocity * std::cos( phase ) * std::cos( inclination ),
+            radius * angularVelocity * std::cos( phase ) * std::sin( inclination );
+    return state;
+}
+
+//! Function to create a list of ground stations on a grid of geodetic latitudes and longitudes.
+std::vector< boost::shared_ptr< GroundStation > > createStationGrid(
+        const int numberOfStations,
+        const boost::shared_ptr< BodyShapeModel > bodyShape )
+{
+    std::vector< boost::shared_ptr< GroundStation > > groundStations;
+    for( int i = 0; i < numberOfStations; i++ )
+    {
+        Eigen::Vector3d geodeticPosition( 100.0 * static_cast< double >( i % 7 ),
+                                          convertDegreesToRadians( -70.0 + 140.0 * static_cast< double >( i % 11 ) / 10.0 ),
+                                          convertDegreesToRadians( -180.0 + 7.3 * static_cast< double >( i ) ) );
+        groundStations.push_back(
+                    boost::make_shared< GroundStation >(
+                        boost::make_shared< GroundStationState >( geodeticPosition, geodetic_position, bodyShape ),
+                        "Station" + boost::lexical_cast< std::string >( i ) ) );
+    }
+    return groundStations;
+}
+
+BOOST_AUTO_TEST_SUITE( test_ground_station_network )
+
+//! Test topocentric frame and elevation, azimuth and range, against direct computation.
+BOOST_AUTO_TEST_CASE( testGroundStationNetworkTopocentricGeometry )
+{
+    boost::shared_ptr< OblateSpheroidBodyShapeModel > earthShape =
+            boost::make_shared< OblateSpheroidBodyShapeModel >( 6378137.0, 1.0 / 298.257223563 );
+
+    std::vector< boost::shared_ptr< GroundStation > > groundStations = createStationGrid( 13, earthShape );
+    GroundStationNetwork stationNetwork( groundStations );
+    BOOST_CHECK_EQUAL( stationNetwork.getNumberOfStations( ), 13 );
+    BOOST_CHECK_EQUAL( stationNetwork.getStationNames( ).at( 4 ), "Station4" );
+
+    // Create targets and tabulate their states.
+    std::vector< double > times;
+    for( int i = 0; i < 200; i++ )
+    {
+        times.push_back( 30.0 * static_cast< double >( i ) );
+    }
+    std::vector< Eigen::Matrix< double, 6, Eigen::Dynamic > > targetStates;
+    for( int j = 0; j < 5; j++ )
+    {
+        targetStates.push_back( tabulateBodyFixedTargetStates(
+                                    boost::bind( &computeCircularOrbitState, _1, 7.0E6 + 1.0E6 * j, 0.3 * j,
+                                                 1.0E-3, 0.5 * j ), times ) );
+    }
+
+    std::vector< std::vector< Eigen::Matrix3Xd > > topocentricGeometry =
+            stationNetwork.computeTopocentricGeometry( targetStates );
+    std::vector< std::vector< Eigen::Matrix3Xd > > multiThreadedTopocentricGeometry =
+            stationNetwork.computeTopocentricGeometry( targetStates, 4 );
+
+    for( int i = 0; i < stationNetwork.getNumberOfStations( ); i++ )
+    {
+        // Compare topocentric frame with frame transformation.
+        boost::shared_ptr< GroundStationState > stationState = groundStations.at( i )->getNominalStationState( );
+        Eigen::Matrix3d expectedRotation = Eigen::Matrix3d(
+                    reference_frames::getRotatingPlanetocentricToEnuLocalVerticalFrameTransformationQuaternion(
+                        stationState->getNominalGeodeticPosition( )( 2 ),
+                        stationState->getNominalGeodeticPosition( )( 1 ) ) );
+        BOOST_CHECK_SMALL( ( stationState->getRotationFromBodyFixedToTopocentricFrame( ) - expectedRotation ).
+                           cwiseAbs( ).maxCoeff( ), 1.0E-14 );
+
+        for( unsigned int j = 0; j < targetStates.size( ); j++ )
+        {
+            BOOST_CHECK_EQUAL( topocentricGeometry[ i ][ j ].cols( ), static_cast< int >( times.size( ) ) );
+            for( unsigned int k = 0; k < times.size( ); k++ )
+            {
+                // Compute elevation, azimuth and range directly.
+                Eigen::Vector3d relativePosition = expectedRotation * (
+                            targetStates[ j ].block( 0, k, 3, 1 ) - stationState->getNominalCartesianPosition( ) );
+                double expectedRange = relativePosition.norm( );
+                double expectedElevation = PI / 2.0 - std::acos( relativePosition( 2 ) / expectedRange );
+                double expectedAzimuth = std::atan2( relativePosition( 0 ), relativePosition( 1 ) );
+
+                BOOST_CHECK_SMALL( topocentricGeometry[ i ][ j ]( 0, k ) - expectedElevation, 1.0E-12 );
+                BOOST_CHECK_SMALL( topocentricGeometry[ i ][ j ]( 1, k ) - expectedAzimuth, 1.0E-12 );
+                BOOST_CHECK_CLOSE_FRACTION( topocentricGeometry[ i ][ j ]( 2, k ), expectedRange, 1.0E-14 );
+
+                // Check that multi-threaded computation gives identical results.
+                BOOST_CHECK( topocentricGeometry[ i ][ j ].col( k ) ==
+                             multiThreadedTopocentricGeometry[ i ][ j ].col( k ) );
+            }
+        }
+    }
+
+    // Check elevation and azimuth of targets directly above, and to the east and north of a station on the equator.
+    std::vector< boost::shared_ptr< GroundStation > > equatorialStation;
+    equatorialStation.push_back( boost::make_shared< GroundStation >(
+                                     boost::make_shared< GroundStationState >(
+                                         Eigen::Vector3d( 6378137.0, 0.0, 0.0 ) ), "Equator" ) );
+    GroundStationNetwork equatorialNetwork( equatorialStation );
+    Eigen::Matrix< double, 6, Eigen::Dynamic > testTargetStates = Eigen::MatrixXd::Zero( 6, 3 );
+    testTargetStates.block( 0, 0, 3, 3 ) << 7.0E6, 6378137.0, 6378137.0,
+            0.0, 1.0E6, 0.0,
+            0.0, 0.0, 1.0E6;
+    Eigen::Matrix3Xd testGeometry;
+    equatorialNetwork.computeTopocentricGeometry( 0, testTargetStates, testGeometry );
+
+    BOOST_CHECK_CLOSE_FRACTION( testGeometry( 0, 0 ), PI / 2.0, 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( testGeometry( 2, 0 ), 7.0E6 - 6378137.0, 1.0E-15 );
+    BOOST_CHECK_SMALL( testGeometry( 0, 1 ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( testGeometry( 1, 1 ), PI / 2.0, 1.0E-15 );
+    BOOST_CHECK_SMALL( testGeometry( 0, 2 ), 1.0E-15 );
+    BOOST_CHECK_SMALL( testGeometry( 1, 2 ), 1.0E-15 );
+}
+
+//! Test visibility windows against analytical rise and set times.
+BOOST_AUTO_TEST_CASE( testGroundStationNetworkVisibilityWindows )
+{
+    // Create stations on equator of spherical body, at longitudes of 0 and 90 degrees.
+    const double bodyRadius = 6378137.0;
+    std::vector< boost::shared_ptr< GroundStation > > groundStations;
+    groundStations.push_back( boost::make_shared< GroundStation >(
+                                  boost::make_shared< GroundStationState >(
+                                      Eigen::Vector3d( bodyRadius, 0.0, 0.0 ) ), "Station0" ) );
+    groundStations.push_back( boost::make_shared< GroundStation >(
+                                  boost::make_shared< GroundStationState >(
+                                      Eigen::Vector3d( 0.0, bodyRadius, 0.0 ) ), "Station1" ) );
+    GroundStationNetwork stationNetwork( groundStations );
+
+    // Create targets in equatorial orbits (in body-fixed frame) with different radii.
+    const double angularVelocity = 2.0 * PI / 6000.0;
+    const double initialPhase = -2.0;
+    std::vector< double > orbitRadii;
+    orbitRadii.push_back( 7.0E6 );
+    orbitRadii.push_back( 8.0E6 );
+    orbitRadii.push_back( 2.0E7 );
+
+    std::vector< double > times;
+    for( int i = 0; i <= 600; i++ )
+    {
+        times.push_back( 10.0 * static_cast< double >( i ) );
+    }
+    std::vector< Eigen::Matrix< double, 6, Eigen::Dynamic > > targetStates;
+    for( unsigned int j = 0; j < orbitRadii.size( ); j++ )
+    {
+        targetStates.push_back( tabulateBodyFixedTargetStates(
+                                    boost::bind( &computeCircularOrbitState, _1, orbitRadii.at( j ), 0.0,
+                                                 angularVelocity, initialPhase ), times ) );
+    }
+
+    for( int elevationIndex = 0; elevationIndex < 2; elevationIndex++ )
+    {
+        const double minimumElevation = convertDegreesToRadians( 10.0 * static_cast< double >( elevationIndex ) );
+        std::vector< std::vector< VisibilityWindowList > > visibilityWindows =
+                stationNetwork.computeVisibilityWindows( times, targetStates, minimumElevation, 1, 1.0E-4 );
+        std::vector< std::vector< VisibilityWindowList > > multiThreadedVisibilityWindows =
+                stationNetwork.computeVisibilityWindows( times, targetStates, minimumElevation, 3, 1.0E-4 );
+
+        for( int i = 0; i < 2; i++ )
+        {
+            const double stationLongitude = PI / 2.0 * static_cast< double >( i );
+            for( unsigned int j = 0; j < orbitRadii.size( ); j++ )
+            {
+                // Compute half-width of visibility arc, from geocentric angle at which minimum elevation is reached.
+                const double halfVisibilityArc = std::acos(
+                            bodyRadius / orbitRadii.at( j ) * std::cos( minimumElevation ) ) - minimumElevation;
+                const double riseTime = ( stationLongitude - halfVisibilityArc - initialPhase ) / angularVelocity;
+                const double setTime = ( stationLongitude + halfVisibilityArc - initialPhase ) / angularVelocity;
+
+                // Check single visibility window, with analytical rise and set times, within tabulated times.
+                BOOST_CHECK_EQUAL( visibilityWindows[ i ][ j ].size( ), 1 );
+                BOOST_CHECK_SMALL( visibilityWindows[ i ][ j ].at( 0 ).first -
+                                   std::max( riseTime, times.front( ) ), 2.0E-3 );
+                BOOST_CHECK_SMALL( visibilityWindows[ i ][ j ].at( 0 ).second -
+                                   std::min( setTime, times.back( ) ), 2.0E-3 );
+
+                BOOST_CHECK( visibilityWindows[ i ][ j ] == multiThreadedVisibilityWindows[ i ][ j ] );
+            }
+        }
+    }
+
+    // Check inconsistent input.
+    targetStates.push_back( Eigen::MatrixXd::Zero( 6, 10 ) );
+    BOOST_CHECK_THROW( stationNetwork.computeVisibilityWindows( times, targetStates, 0.0 ), std::runtime_error );
+}
+
+//! Test single- and multi-threaded visibility computation for a network of stations, and a constellation of targets.
+BOOST_AUTO_TEST_CASE( testGroundStationNetworkMultiThreadedVisibility )
+{
+    boost::shared_ptr< OblateSpheroidBodyShapeModel > earthShape =
+            boost::make_shared< OblateSpheroidBodyShapeModel >( 6378137.0, 1.0 / 298.257223563 );
+    GroundStationNetwork stationNetwork( createStationGrid( 50, earthShape ) );
+
+    // Tabulate states of 100 targets over one day, with one minute step size.
+    std::vector< double > times;
+    for( int i = 0; i <= 1440; i++ )
+    {
+        times.push_back( 60.0 * static_cast< double >( i ) );
+    }
+    std::vector< Eigen::Matrix< double, 6, Eigen::Dynamic > > targetStates;
+    for( int j = 0; j < 100; j++ )
+    {
+        const double orbitRadius = 6.9E6 + 1.0E4 * static_cast< double >( j );
+        targetStates.push_back( tabulateBodyFixedTargetStates(
+                                    boost::bind( &computeCircularOrbitState, _1, orbitRadius,
+                                                 0.017 * static_cast< double >( j ),
+                                                 std::sqrt( 3.986004418E14 / std::pow( orbitRadius, 3.0 ) ) -
+                                                 7.292115E-5, 0.1 * static_cast< double >( j ) ), times ) );
+    }
+
+    // Compute visibility windows, single- and multi-threaded.
+    std::vector< std::vector< VisibilityWindowList > > visibilityWindows =
+            stationNetwork.computeVisibilityWindows( times, targetStates, convertDegreesToRadians( 5.0 ) );
+
+    const unsigned int numberOfThreads = utilities::getNumberOfHardwareThreads( );
+    std::vector< std::vector< VisibilityWindowList > > multiThreadedVisibilityWindows =
+            stationNetwork.computeVisibilityWindows( times, targetStates, convertDegreesToRadians( 5.0 ),
+                                                     numberOfThreads );
+
+    int numberOfWindows = 0;
+    for( unsigned int i = 0; i < visibilityWindows.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < visibilityWindows[ i ].size( ); j++ )
+        {
+            numberOfWindows += visibilityWindows[ i ][ j ].size( );
+            BOOST_CHECK( visibilityWindows[ i ][ j ] == multiThreadedVisibilityWindows[ i ][ j ] );
+        }
+    }
+
+    BOOST_CHECK( numberOfWindows > 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,226 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include "Tudat/Astrodynamics/GroundStations/groundStationNetwork.h"
+#include "Tudat/Basics/parallelization.h"
+
+namespace tudat
+{
+
+namespace ground_stations
+{
+
+//! Function to tabulate the body-fixed state of a target on a grid of times.
+Eigen::Matrix< double, 6, Eigen::Dynamic > tabulateBodyFixedTargetStates(
+        const boost::function< Eigen::Vector6d( const double ) > targetStateFunction,
+        const std::vector< double >& times )
+{
+    Eigen::Matrix< double, 6, Eigen::Dynamic > targetStates( 6, times.size( ) );
+    for( unsigned int i = 0; i < times.size( ); i++ )
+    {
+        targetStates.col( i ) = targetStateFunction( times.at( i ) );
+    }
+    return targetStates;
+}
+
+//! Constructor
+GroundStationNetwork::GroundStationNetwork(
+        const std::vector< boost::shared_ptr< GroundStation > >& groundStations )
+{
+    stationPositions_.resize( 3, groundStations.size( ) );
+    for( unsigned int i = 0; i < groundStations.size( ); i++ )
+    {
+        boost::shared_ptr< GroundStationState > stationState = groundStations.at( i )->getNominalStationState( );
+
+        stationNames_.push_back( groundStations.at( i )->getStationId( ) );
+        stationPositions_.col( i ) = stationState->getNominalCartesianPosition( );
+        bodyFixedToTopocentricRotations_.push_back( stationState->getRotationFromBodyFixedToTopocentricFrame( ) );
+    }
+}
+
+//! Function to compute elevation, azimuth and range of a single target, as seen from a single station.
+void GroundStationNetwork::computeTopocentricGeometry(
+        const int stationIndex,
+        const Eigen::Matrix< double, 6, Eigen::Dynamic >& targetStates,
+        Eigen::Matrix3Xd& topocentricGeometry )
+{
+    // Compute relative positions in topocentric frame for all epochs at once.
+    topocentricGeometry.noalias( ) = bodyFixedToTopocentricRotations_[ stationIndex ] *
+            ( targetStates.topRows< 3 >( ).colwise( ) - stationPositions_.col( stationIndex ) );
+
+    // Convert (in place) to elevation, azimuth and range.
+    double currentRange, currentAzimuth;
+    for( int i = 0; i < topocentricGeometry.cols( ); i++ )
+    {
+        currentRange = topocentricGeometry.col( i ).norm( );
+        currentAzimuth = std::atan2( topocentricGeometry( 0, i ), topocentricGeometry( 1, i ) );
+
+        topocentricGeometry( 0, i ) = std::asin( topocentricGeometry( 2, i ) / currentRange );
+        topocentricGeometry( 1, i ) = currentAzimuth;
+        topocentricGeometry( 2, i ) = currentRange;
+    }
+}
+
+//! Function to compute elevation, azimuth and range for all station-target pairs.
+std::vector< std::vector< Eigen::Matrix3Xd > > GroundStationNetwork::computeTopocentricGeometry(
+        const std::vector< Eigen::Matrix< double, 6, Eigen::Dynamic > >& targetStates,
+        const unsigned int numberOfThreads )
+{
+    const unsigned int numberOfTargets = targetStates.size( );
+    std::vector< std::vector< Eigen::Matrix3Xd > > topocentricGeometry(
+                getNumberOfStations( ), std::vector< Eigen::Matrix3Xd >( numberOfTargets ) );
+
+    utilities::executeParallelLoop(
+                getNumberOfStations( ) * numberOfTargets,
+                [ this, &targetStates, &topocentricGeometry, numberOfTargets ]( const unsigned int linkIndex )
+    {
+        const unsigned int stationIndex = linkIndex / numberOfTargets;
+        const unsigned int targetIndex = linkIndex % numberOfTargets;
+        computeTopocentricGeometry( stationIndex, targetStates[ targetIndex ],
+                                    topocentricGeometry[ stationIndex ][ targetIndex ] );
+    }, numberOfThreads );
+
+    return topocentricGeometry;
+}
+
+//! Function to compute the windows in which targets are visible above a minimum elevation, for all stations.
+std::vector< std::vector< VisibilityWindowList > > GroundStationNetwork::computeVisibilityWindows(
+        const std::vector< double >& times,
+        const std::vector< Eigen::Matrix< double, 6, Eigen::Dynamic > >& targetStates,
+        const double minimumElevation,
+        const unsigned int numberOfThreads,
+        const double timeTolerance )
+{
+    const unsigned int numberOfTargets = targetStates.size( );
+    for( unsigned int i = 0; i < numberOfTargets; i++ )
+    {
+        if( targetStates.at( i ).cols( ) != static_cast< int >( times.size( ) ) )
+        {
+            throw std::runtime_error( "Error when computing visibility windows, number of target states is not equal to "
+                                      "number of times." );
+        }
+    }
+
+    std::vector< std::vector< VisibilityWindowList > > visibilityWindows(
+                getNumberOfStations( ), std::vector< VisibilityWindowList >( numberOfTargets ) );
+    if( times.size( ) == 0 )
+    {
+        return visibilityWindows;
+    }
+
+    const double sineOfMinimumElevation = std::sin( minimumElevation );
+    utilities::executeParallelLoop(
+                getNumberOfStations( ) * numberOfTargets,
+                [ this, &times, &targetStates, &visibilityWindows, numberOfTargets, sineOfMinimumElevation,
+                timeTolerance ]( const unsigned int linkIndex )
+    {
+        const unsigned int stationIndex = linkIndex / numberOfTargets;
+        const unsigned int targetIndex = linkIndex % numberOfTargets;
+        visibilityWindows[ stationIndex ][ targetIndex ] = computeSingleLinkVisibilityWindows(
+                    stationIndex, times, targetStates[ targetIndex ], sineOfMinimumElevation, timeTolerance );
+    }, numberOfThreads );
+
+    return visibilityWindows;
+}
+
+//! Function to compute the visibility windows of a single target, as seen from a single station.
+VisibilityWindowList GroundStationNetwork::computeSingleLinkVisibilityWindows(
+        const int stationIndex,
+        const std::vector< double >& times,
+        const Eigen::Matrix< double, 6, Eigen::Dynamic >& targetStates,
+        const double sineOfMinimumElevation,
+        const double timeTolerance )
+{
+    // Evaluate elevation function (positive if target is visible) at all tabulated epochs, without computing angles.
+    Eigen::Matrix3Xd relativePositions = targetStates.topRows< 3 >( ).colwise( ) - stationPositions_.col( stationIndex );
+    Eigen::RowVectorXd elevationFunction =
+            bodyFixedToTopocentricRotations_[ stationIndex ].row( 2 ) * relativePositions -
+            sineOfMinimumElevation * relativePositions.colwise( ).norm( );
+
+    VisibilityWindowList visibilityWindows;
+    bool isTargetVisible = ( elevationFunction( 0 ) > 0.0 );
+    double currentRiseTime = times.at( 0 );
+    for( unsigned int i = 1; i < times.size( ); i++ )
+    {
+        const bool isTargetCurrentlyVisible = ( elevationFunction( i ) > 0.0 );
+        if( isTargetCurrentlyVisible != isTargetVisible )
+        {
+            // Find time of rise/set by bisection, using interpolated target state.
+            const double intervalLength = times.at( i ) - times.at( i - 1 );
+            double lowerBound = 0.0;
+            double upperBound = intervalLength;
+            while( upperBound - lowerBound > timeTolerance )
+            {
+                const double currentTime = 0.5 * ( lowerBound + upperBound );
+                if( ( computeInterpolatedElevationFunction(
+                          stationIndex, targetStates, i - 1, intervalLength, currentTime,
+                          sineOfMinimumElevation ) > 0.0 ) == isTargetVisible )
+                {
+                    lowerBound = currentTime;
+                }
+                else
+                {
+                    upperBound = currentTime;
+                }
+            }
+            const double eventTime = times.at( i - 1 ) + 0.5 * ( lowerBound + upperBound );
+
+            if( isTargetCurrentlyVisible )
+            {
+                currentRiseTime = eventTime;
+            }
+            else
+            {
+                visibilityWindows.push_back( std::make_pair( currentRiseTime, eventTime ) );
+            }
+            isTargetVisible = isTargetCurrentlyVisible;
+        }
+    }
+
+    // Close window that is open at final epoch.
+    if( isTargetVisible )
+    {
+        visibilityWindows.push_back( std::make_pair( currentRiseTime, times.back( ) ) );
+    }
+
+    return visibilityWindows;
+}
+
+//! Function to compute the elevation function of which the root defines rise and set times, between two epochs.
+double GroundStationNetwork::computeInterpolatedElevationFunction(
+        const int stationIndex,
+        const Eigen::Matrix< double, 6, Eigen::Dynamic >& targetStates,
+        const int intervalStartIndex,
+        const double intervalLength,
+        const double timeIntoInterval,
+        const double sineOfMinimumElevation )
+{
+    // Compute cubic Hermite basis functions.
+    const double s = timeIntoInterval / intervalLength;
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+
+    const Eigen::Vector3d relativePosition =
+            ( 2.0 * s3 - 3.0 * s2 + 1.0 ) * targetStates.block< 3, 1 >( 0, intervalStartIndex ) +
+            ( s3 - 2.0 * s2 + s ) * intervalLength * targetStates.block< 3, 1 >( 3, intervalStartIndex ) +
+            ( -2.0 * s3 + 3.0 * s2 ) * targetStates.block< 3, 1 >( 0, intervalStartIndex + 1 ) +
+            ( s3 - s2 ) * intervalLength * targetStates.block< 3, 1 >( 3, intervalStartIndex + 1 ) -
+            stationPositions_.col( stationIndex );
+
+    return bodyFixedToTopocentricRotations_[ stationIndex ].row( 2 ).dot( relativePosition ) -
+            sineOfMinimumElevation * relativePosition.norm( );
+}
+
+} // namespace ground_stations
+
+} // namespace tudat
@@ -0,0 +1,209 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_GROUNDSTATIONNETWORK_H
+#define TUDAT_GROUNDSTATIONNETWORK_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/GroundStations/groundStation.h"
+#include "Tudat/Basics/basicTypedefs.h"
+
+namespace tudat
+{
+
+namespace ground_stations
+{
+
+//! Typedef for list of visibility windows (rise and set time) of a single target, as seen from a single station.
+typedef std::vector< std::pair< double, double > > VisibilityWindowList;
+
+//! Function to tabulate the body-fixed state of a target on a grid of times.
+/*!
+ *  Function to tabulate the body-fixed state of a target on a grid of times, for use as input to the batch computations
+ *  of the GroundStationNetwork class. The state function is called once per epoch, on the calling thread, so that it
+ *  need not be thread-safe.
+ *  \param targetStateFunction Function returning the Cartesian state of the target in the body-fixed frame of the body
+ *  on which the stations are located, as a function of time.
+ *  \param times Times at which the state is to be tabulated.
+ *  \return Tabulated states, one column per time.
+ */
+Eigen::Matrix< double, 6, Eigen::Dynamic > tabulateBodyFixedTargetStates(
+        const boost::function< Eigen::Vector6d( const double ) > targetStateFunction,
+        const std::vector< double >& times );
+
+//! Class for batch computation of the observation geometry of a network of ground stations.
+/*!
+ *  Class for batch computation of the observation geometry (elevation, azimuth and range) and visibility windows, for a
+ *  network of ground stations on a single body and any number of targets. The body-fixed positions of the stations, and
+ *  the rotation matrices to their topocentric (East-North-Up) frames, are retrieved once upon construction and stored
+ *  contiguously. The states of the targets are provided in the body-fixed frame, tabulated on a common grid of times
+ *  (see tabulateBodyFixedTargetStates). All station-target pairs are then evaluated independently, distributed over
+ *  a user-defined number of threads, with results that do not depend on the number of threads.
+ */
+class GroundStationNetwork
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param groundStations List of ground stations in the network (all on the same body).
+     */
+    GroundStationNetwork( const std::vector< boost::shared_ptr< GroundStation > >& groundStations );
+
+    //! Function to retrieve the number of stations in the network.
+    /*!
+     *  Function to retrieve the number of stations in the network.
+     *  \return Number of stations in the network.
+     */
+    int getNumberOfStations( )
+    {
+        return static_cast< int >( stationNames_.size( ) );
+    }
+
+    //! Function to retrieve the names of the stations in the network.
+    /*!
+     *  Function to retrieve the names of the stations in the network, in the order in which the results of the batch
+     *  computations are stored.
+     *  \return Names of the stations in the network.
+     */
+    std::vector< std::string > getStationNames( )
+    {
+        return stationNames_;
+    }
+
+    //! Function to retrieve the body-fixed positions of the stations.
+    /*!
+     *  Function to retrieve the body-fixed positions of the stations.
+     *  \return Body-fixed positions of the stations, one column per station.
+     */
+    Eigen::Matrix3Xd getStationPositions( )
+    {
+        return stationPositions_;
+    }
+
+    //! Function to compute elevation, azimuth and range of a single target, as seen from a single station.
+    /*!
+     *  Function to compute elevation, azimuth and range of a single target, as seen from a single station, at all epochs
+     *  for which the target states are provided. The azimuth is measured from North towards East, in the range
+     *  (-pi, pi].
+     *  \param stationIndex Index of the station in the network.
+     *  \param targetStates Tabulated body-fixed states of the target (only first three rows are used), one column per
+     *  epoch.
+     *  \param topocentricGeometry Elevation, azimuth and range of the target (returned by reference), one column per
+     *  epoch.
+     */
+    void computeTopocentricGeometry(
+            const int stationIndex,
+            const Eigen::Matrix< double, 6, Eigen::Dynamic >& targetStates,
+            Eigen::Matrix3Xd& topocentricGeometry );
+
+    //! Function to compute elevation, azimuth and range for all station-target pairs.
+    /*!
+     *  Function to compute elevation, azimuth and range for all station-target pairs, at all epochs for which the
+     *  target states are provided (see computeTopocentricGeometry for single station-target pair). Since the output
+     *  scales with the number of stations, targets and epochs, this function is intended for moderately sized problems;
+     *  use computeVisibilityWindows to find visibility of many targets over long periods.
+     *  \param targetStates Tabulated body-fixed states of the targets (only first three rows of each are used), one
+     *  column per epoch.
+     *  \param numberOfThreads Number of threads over which the station-target pairs are distributed.
+     *  \return Elevation, azimuth and range, one column per epoch, for each target (inner vector) for each station
+     *  (outer vector).
+     */
+    std::vector< std::vector< Eigen::Matrix3Xd > > computeTopocentricGeometry(
+            const std::vector< Eigen::Matrix< double, 6, Eigen::Dynamic > >& targetStates,
+            const unsigned int numberOfThreads = 1 );
+
+    //! Function to compute the windows in which targets are visible above a minimum elevation, for all stations.
+    /*!
+     *  Function to compute the windows in which targets are visible above a minimum elevation, for all station-target
+     *  pairs. Visibility is first evaluated at the tabulated epochs, after which the rise and set times between two
+     *  consecutive epochs are refined by bisection, using a cubic Hermite interpolation of the target state between
+     *  the two epochs. Consequently, passes that start and end between two consecutive epochs are not detected, so that
+     *  the time step of the tabulated states should be well below the shortest pass of interest. A target that is
+     *  visible at the first (last) epoch is taken to rise (set) at that epoch.
+     *  \param times Times at which target states are tabulated (in ascending order).
+     *  \param targetStates Tabulated body-fixed states of the targets, one column per epoch.
+     *  \param minimumElevation Minimum elevation (in radians) above which the target is visible.
+     *  \param numberOfThreads Number of threads over which the station-target pairs are distributed.
+     *  \param timeTolerance Tolerance (in seconds) to which the rise and set times are determined.
+     *  \return Visibility windows for each target (inner vector) for each station (outer vector).
+     */
+    std::vector< std::vector< VisibilityWindowList > > computeVisibilityWindows(
+            const std::vector< double >& times,
+            const std::vector< Eigen::Matrix< double, 6, Eigen::Dynamic > >& targetStates,
+            const double minimumElevation,
+            const unsigned int numberOfThreads = 1,
+            const double timeTolerance = 1.0E-3 );
+
+private:
+
+    //! Function to compute the visibility windows of a single target, as seen from a single station.
+    /*!
+     *  Function to compute the visibility windows of a single target, as seen from a single station (see
+     *  computeVisibilityWindows).
+     *  \param stationIndex Index of the station in the network.
+     *  \param times Times at which target states are tabulated (in ascending order).
+     *  \param targetStates Tabulated body-fixed states of the target, one column per epoch.
+     *  \param sineOfMinimumElevation Sine of minimum elevation above which the target is visible.
+     *  \param timeTolerance Tolerance (in seconds) to which the rise and set times are determined.
+     *  \return Visibility windows of the target.
+     */
+    VisibilityWindowList computeSingleLinkVisibilityWindows(
+            const int stationIndex,
+            const std::vector< double >& times,
+            const Eigen::Matrix< double, 6, Eigen::Dynamic >& targetStates,
+            const double sineOfMinimumElevation,
+            const double timeTolerance );
+
+    //! Function to compute the elevation function of which the root defines rise and set times, between two epochs.
+    /*!
+     *  Function to compute the function of which the root defines rise and set times (up-component of relative position,
+     *  minus range times sine of minimum elevation) at a time between two tabulated epochs, using a cubic Hermite
+     *  interpolation of the target state.
+     *  \param stationIndex Index of the station in the network.
+     *  \param targetStates Tabulated body-fixed states of the target, one column per epoch.
+     *  \param intervalStartIndex Index of the epoch at the start of the interval.
+     *  \param intervalLength Time between the epochs at the start and end of the interval.
+     *  \param timeIntoInterval Time since the epoch at the start of the interval.
+     *  \param sineOfMinimumElevation Sine of minimum elevation above which the target is visible.
+     *  \return Value of the elevation function.
+     */
+    double computeInterpolatedElevationFunction(
+            const int stationIndex,
+            const Eigen::Matrix< double, 6, Eigen::Dynamic >& targetStates,
+            const int intervalStartIndex,
+            const double intervalLength,
+            const double timeIntoInterval,
+            const double sineOfMinimumElevation );
+
+    //! Names of the stations in the network.
+    std::vector< std::string > stationNames_;
+
+    //! Body-fixed positions of the stations, one column per station.
+    Eigen::Matrix3Xd stationPositions_;
+
+    //! Rotation matrices from the body-fixed frame to the topocentric frame of each station.
+    std::vector< Eigen::Matrix3d > bodyFixedToTopocentricRotations_;
+};
+
+} // namespace ground_stations
+
+} // namespace tudat
+
+#endif // TUDAT_GROUNDSTATIONNETWORK_H
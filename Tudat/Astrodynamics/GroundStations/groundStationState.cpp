@@ -1,3 +1,5 @@
+#include <cmath>
+
 #include <boost/assign/list_of.hpp>
 
 #include "Tudat/Mathematics/BasicMathematics/coordinateConversions.h"
@@ -66,6 +68,20 @@ void GroundStationState::resetGroundStationPositionAtEpoch(
         geodeticPosition = Eigen::Vector3d::Constant( TUDAT_NAN );
     }
 
+    // Set rotation to topocentric frame, using geodetic latitude if available.
+    const double latitude = ( geodeticPosition( 1 ) == geodeticPosition( 1 ) ) ?
+                geodeticPosition( 1 ) : sphericalPosition_( 1 );
+    const double longitude = sphericalPosition_( 2 );
+    const double sineLatitude = std::sin( latitude );
+    const double cosineLatitude = std::cos( latitude );
+    const double sineLongitude = std::sin( longitude );
+    const double cosineLongitude = std::cos( longitude );
+
+    bodyFixedToTopocentricRotation_ <<
+            -sineLongitude, cosineLongitude, 0.0,
+            -sineLatitude * cosineLongitude, -sineLatitude * sineLongitude, cosineLatitude,
+            cosineLatitude * cosineLongitude, cosineLatitude * sineLongitude, sineLatitude;
+
 }
 
 }
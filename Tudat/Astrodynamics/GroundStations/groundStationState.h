@@ -95,6 +95,19 @@ public:
         return geodeticPosition;
     }
 
+    //! Function to return the rotation from the body-fixed frame to the topocentric (East-North-Up) frame of the station
+    /*!
+     *  Function to return the rotation matrix from the body-fixed frame to the topocentric (East-North-Up) frame of the
+     *  station, which is computed once when setting the nominal position of the station. The local vertical is
+     *  defined by the geodetic latitude if the geodetic position of the station is defined, and by the geocentric latitude
+     *  otherwise.
+     *  \return Rotation matrix from body-fixed to topocentric frame.
+     */
+    Eigen::Matrix3d getRotationFromBodyFixedToTopocentricFrame( )
+    {
+        return bodyFixedToTopocentricRotation_;
+    }
+
     //! Function to (re)set the nominal state of the station
     /*!
      *  Function to (re)set the nominal state of the station. Input may be in any type of elements defined in
@@ -139,6 +152,9 @@ protected:
      */
     Eigen::Vector3d geodeticPosition;
 
+    //! Rotation matrix from the body-fixed frame to the topocentric (East-North-Up) frame of the station.
+    Eigen::Matrix3d bodyFixedToTopocentricRotation_;
+
     //! Shape of body on which state is defined
     boost::shared_ptr< basic_astrodynamics::BodyShapeModel > bodySurface_;
 };
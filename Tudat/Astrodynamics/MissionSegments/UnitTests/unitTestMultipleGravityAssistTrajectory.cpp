@@ -0,0 +1,341 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Notes
+ *      This test is compiled with Tudat/Basics/allocationAuditHooks.cpp (see CMakeLists.txt), so that all heap
+ *      allocations in the test executable are counted.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <random>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "Tudat/Astrodynamics/Ephemerides/approximatePlanetPositions.h"
+#include "Tudat/Astrodynamics/MissionSegments/gravityAssist.h"
+#include "Tudat/Astrodynamics/MissionSegments/lambertTargeterIzzo.h"
+#include "Tudat/Astrodynamics/MissionSegments/multipleGravityAssistTrajectory.h"
+#include "Tudat/Basics/allocationAudit.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace mission_segments;
+
+//! Gravitational parameter of the Sun [m^3/s^2].
+static const double SUN_GRAVITATIONAL_PARAMETER = 1.32712440018E20;
+
+//! Create ephemeris table for a planet, using approximate planet positions, for 2000-2030.
+EphemerisTablePointer createPlanetEphemerisTable(
+        const ephemerides::ApproximatePlanetPositionsBase::BodiesWithEphemerisData planet )
+{
+    boost::shared_ptr< ephemerides::ApproximatePlanetPositions > planetEphemeris =
+            boost::make_shared< ephemerides::ApproximatePlanetPositions >( planet );
+    return boost::make_shared< EphemerisTable >(
+                boost::bind( &ephemerides::ApproximatePlanetPositions::getCartesianState, planetEphemeris, _1 ),
+                0.0, 30.0 * physical_constants::JULIAN_YEAR, physical_constants::JULIAN_DAY );
+}
+
+//! Create trajectory model for the sequence Earth-Venus-Mars, or Earth-Mars.
+template< typename TrajectoryType >
+boost::shared_ptr< TrajectoryType > createTrajectoryModel( const bool useSwingBy )
+{
+    using namespace ephemerides;
+
+    std::vector< EphemerisTablePointer > ephemerisTables;
+    std::vector< double > gravitationalParameters, minimumPericenterRadii;
+
+    ephemerisTables.push_back( createPlanetEphemerisTable( ApproximatePlanetPositionsBase::earthMoonBarycenter ) );
+    gravitationalParameters.push_back( 3.986004418E14 );
+    minimumPericenterRadii.push_back( 6678.0E3 );
+    if( useSwingBy )
+    {
+        ephemerisTables.push_back( createPlanetEphemerisTable( ApproximatePlanetPositionsBase::venus ) );
+        gravitationalParameters.push_back( 3.24859E14 );
+        minimumPericenterRadii.push_back( 6351.8E3 );
+    }
+    ephemerisTables.push_back( createPlanetEphemerisTable( ApproximatePlanetPositionsBase::mars ) );
+    gravitationalParameters.push_back( 4.282837E13 );
+    minimumPericenterRadii.push_back( 3689.0E3 );
+
+    return boost::make_shared< TrajectoryType >(
+                ephemerisTables, gravitationalParameters, minimumPericenterRadii, SUN_GRAVITATIONAL_PARAMETER );
+}
+
+BOOST_AUTO_TEST_SUITE( test_multiple_gravity_assist_trajectory )
+
+//! Test ephemeris table against the ephemeris from which it is created.
+BOOST_AUTO_TEST_CASE( testEphemerisTable )
+{
+    ephemerides::ApproximatePlanetPositions earthEphemeris(
+                ephemerides::ApproximatePlanetPositionsBase::earthMoonBarycenter );
+    const EphemerisTable ephemerisTable(
+                boost::bind( &ephemerides::ApproximatePlanetPositions::getCartesianState, &earthEphemeris, _1 ),
+                0.0, 2.0 * physical_constants::JULIAN_YEAR, physical_constants::JULIAN_DAY );
+
+    for( int i = 0; i < 100; i++ )
+    {
+        const double time = ( 0.37 + 7.3 * static_cast< double >( i ) ) * physical_constants::JULIAN_DAY;
+        const Eigen::Vector6d stateDifference =
+                ephemerisTable.getCartesianState( time ) - earthEphemeris.getCartesianState( time );
+        BOOST_CHECK_SMALL( stateDifference.segment( 0, 3 ).norm( ), 1.0 );
+        BOOST_CHECK_SMALL( stateDifference.segment( 3, 3 ).norm( ), 1.0E-6 );
+    }
+
+    // Check that table nodes are reproduced, and that times outside table are rejected.
+    BOOST_CHECK_EQUAL( ( ephemerisTable.getCartesianState( 10.0 * physical_constants::JULIAN_DAY ) -
+                         earthEphemeris.getCartesianState( 10.0 * physical_constants::JULIAN_DAY ) ).norm( ), 0.0 );
+    BOOST_CHECK_NO_THROW( ephemerisTable.getCartesianState( ephemerisTable.getEndTime( ) ) );
+    BOOST_CHECK_THROW( ephemerisTable.getCartesianState( -1.0 ), std::runtime_error );
+    BOOST_CHECK_THROW( ephemerisTable.getCartesianState( ephemerisTable.getEndTime( ) + 1.0 ), std::runtime_error );
+}
+
+//! Test MGA trajectory against direct computation with Lambert targeter objects.
+BOOST_AUTO_TEST_CASE( testPoweredSwingByTrajectory )
+{
+    boost::shared_ptr< MultipleGravityAssistPoweredSwingByTrajectory > trajectoryModel =
+            createTrajectoryModel< MultipleGravityAssistPoweredSwingByTrajectory >( true );
+    BOOST_CHECK_EQUAL( trajectoryModel->getDecisionVectorSize( ), 3 );
+
+    Eigen::VectorXd decisionVector( 3 );
+    decisionVector << 7.2 * physical_constants::JULIAN_YEAR, 160.0 * physical_constants::JULIAN_DAY,
+            300.0 * physical_constants::JULIAN_DAY;
+
+    MultipleGravityAssistWorkspacePointer workspace = trajectoryModel->createWorkspace( );
+    const double totalDeltaV = trajectoryModel->evaluate( decisionVector, *workspace );
+
+    // Compute delta V directly from the same ephemeris tables.
+    const double epochs[ 3 ] = { decisionVector( 0 ), decisionVector( 0 ) + decisionVector( 1 ),
+                                 decisionVector( 0 ) + decisionVector( 1 ) + decisionVector( 2 ) };
+    std::vector< Eigen::Vector6d > bodyStates;
+    bodyStates.push_back( createPlanetEphemerisTable(
+                              ephemerides::ApproximatePlanetPositionsBase::earthMoonBarycenter )->getCartesianState(
+                              epochs[ 0 ] ) );
+    bodyStates.push_back( createPlanetEphemerisTable(
+                              ephemerides::ApproximatePlanetPositionsBase::venus )->getCartesianState( epochs[ 1 ] ) );
+    bodyStates.push_back( createPlanetEphemerisTable(
+                              ephemerides::ApproximatePlanetPositionsBase::mars )->getCartesianState( epochs[ 2 ] ) );
+
+    LambertTargeterIzzo firstLeg( bodyStates[ 0 ].segment( 0, 3 ), bodyStates[ 1 ].segment( 0, 3 ),
+                                  decisionVector( 1 ), SUN_GRAVITATIONAL_PARAMETER );
+    LambertTargeterIzzo secondLeg( bodyStates[ 1 ].segment( 0, 3 ), bodyStates[ 2 ].segment( 0, 3 ),
+                                   decisionVector( 2 ), SUN_GRAVITATIONAL_PARAMETER );
+
+    const double departureDeltaV =
+            ( firstLeg.getInertialVelocityAtDeparture( ) - bodyStates[ 0 ].segment( 3, 3 ) ).norm( );
+    const double swingByDeltaV = gravityAssist(
+                3.24859E14, bodyStates[ 1 ].segment( 3, 3 ), firstLeg.getInertialVelocityAtArrival( ),
+                secondLeg.getInertialVelocityAtDeparture( ), 6351.8E3 );
+    const double arrivalDeltaV =
+            ( secondLeg.getInertialVelocityAtArrival( ) - bodyStates[ 2 ].segment( 3, 3 ) ).norm( );
+
+    BOOST_CHECK_CLOSE_FRACTION( workspace->bodyDeltaVs( 0 ), departureDeltaV, 1.0E-12 );
+    BOOST_CHECK_CLOSE_FRACTION( workspace->bodyDeltaVs( 1 ), swingByDeltaV, 1.0E-10 );
+    BOOST_CHECK_CLOSE_FRACTION( workspace->bodyDeltaVs( 2 ), arrivalDeltaV, 1.0E-12 );
+    BOOST_CHECK_CLOSE_FRACTION( totalDeltaV, departureDeltaV + swingByDeltaV + arrivalDeltaV, 1.0E-12 );
+    BOOST_CHECK_EQUAL( workspace->deepSpaceManeuverDeltaVs.norm( ), 0.0 );
+
+    // Check evaluation without workspace, and invalid decision vector size.
+    BOOST_CHECK_EQUAL( trajectoryModel->evaluate( decisionVector ), totalDeltaV );
+    BOOST_CHECK_THROW( trajectoryModel->evaluate( Eigen::VectorXd::Zero( 4 ) ), std::runtime_error );
+}
+
+//! Test MGA-1DSM trajectory against MGA trajectory, for a deep space maneuver on a Lambert arc.
+BOOST_AUTO_TEST_CASE( testDeepSpaceManeuverTrajectory )
+{
+    boost::shared_ptr< MultipleGravityAssistPoweredSwingByTrajectory > mgaModel =
+            createTrajectoryModel< MultipleGravityAssistPoweredSwingByTrajectory >( false );
+    boost::shared_ptr< MultipleGravityAssistDeepSpaceManeuverTrajectory > mgaDsmModel =
+            createTrajectoryModel< MultipleGravityAssistDeepSpaceManeuverTrajectory >( false );
+    BOOST_CHECK_EQUAL( mgaDsmModel->getDecisionVectorSize( ), 6 );
+
+    // Evaluate direct Earth-Mars transfer.
+    Eigen::VectorXd mgaDecisionVector( 2 );
+    mgaDecisionVector << 5.1 * physical_constants::JULIAN_YEAR, 250.0 * physical_constants::JULIAN_DAY;
+    MultipleGravityAssistWorkspacePointer mgaWorkspace = mgaModel->createWorkspace( );
+    const double mgaDeltaV = mgaModel->evaluate( mgaDecisionVector, *mgaWorkspace );
+
+    // Set departure excess velocity of MGA-1DSM trajectory equal to that of the Lambert arc.
+    const Eigen::Vector3d excessVelocity =
+            mgaWorkspace->legDepartureVelocities.col( 0 ) - mgaWorkspace->bodyStates.block( 3, 0, 3, 1 );
+    const double inPlaneAngle = std::atan2( excessVelocity( 1 ), excessVelocity( 0 ) );
+    const double outOfPlaneAngle = std::asin( excessVelocity( 2 ) / excessVelocity.norm( ) );
+
+    Eigen::VectorXd mgaDsmDecisionVector( 6 );
+    mgaDsmDecisionVector << mgaDecisionVector( 0 ), excessVelocity.norm( ),
+            ( inPlaneAngle < 0.0 ? inPlaneAngle + 2.0 * mathematical_constants::PI : inPlaneAngle ) /
+            ( 2.0 * mathematical_constants::PI ),
+            0.5 * ( std::cos( outOfPlaneAngle + mathematical_constants::PI / 2.0 ) + 1.0 ), 0.4,
+            mgaDecisionVector( 1 );
+
+    MultipleGravityAssistWorkspacePointer mgaDsmWorkspace = mgaDsmModel->createWorkspace( );
+    const double mgaDsmDeltaV = mgaDsmModel->evaluate( mgaDsmDecisionVector, *mgaDsmWorkspace );
+
+    // Deep space maneuver should vanish, and total delta V should be equal.
+    BOOST_CHECK_SMALL( mgaDsmWorkspace->deepSpaceManeuverDeltaVs( 0 ), 1.0E-3 );
+    BOOST_CHECK_CLOSE_FRACTION( mgaDsmDeltaV, mgaDeltaV, 1.0E-7 );
+    BOOST_CHECK_CLOSE_FRACTION( mgaDsmWorkspace->deepSpaceManeuverEpochs( 0 ),
+                                mgaDecisionVector( 0 ) + 0.4 * mgaDecisionVector( 1 ), 1.0E-15 );
+    BOOST_CHECK_SMALL( ( mgaDsmWorkspace->legArrivalVelocities.col( 0 ) -
+                         mgaWorkspace->legArrivalVelocities.col( 0 ) ).norm( ), 1.0E-3 );
+
+    // Check that the unpowered swing-by conserves the excess velocity, and that the delta V is consistent.
+    boost::shared_ptr< MultipleGravityAssistDeepSpaceManeuverTrajectory > swingByModel =
+            createTrajectoryModel< MultipleGravityAssistDeepSpaceManeuverTrajectory >( true );
+    Eigen::VectorXd swingByDecisionVector( 10 );
+    swingByDecisionVector << 7.2 * physical_constants::JULIAN_YEAR, 3.0E3, 0.6, 0.5, 0.3,
+            160.0 * physical_constants::JULIAN_DAY, 1.0, 1.5, 0.6, 300.0 * physical_constants::JULIAN_DAY;
+    MultipleGravityAssistWorkspacePointer swingByWorkspace = swingByModel->createWorkspace( );
+    const double swingByDeltaV = swingByModel->evaluate( swingByDecisionVector, *swingByWorkspace );
+
+    BOOST_CHECK_CLOSE_FRACTION(
+                ( swingByWorkspace->legArrivalVelocities.col( 0 ) - swingByWorkspace->bodyStates.block( 3, 1, 3, 1 ) ).norm( ),
+                ( swingByWorkspace->legDepartureVelocities.col( 1 ) -
+                  swingByWorkspace->bodyStates.block( 3, 1, 3, 1 ) ).norm( ), 1.0E-12 );
+    BOOST_CHECK_EQUAL( swingByWorkspace->bodyDeltaVs( 1 ), 0.0 );
+    BOOST_CHECK_CLOSE_FRACTION( swingByDeltaV, swingByWorkspace->bodyDeltaVs.sum( ) +
+                                swingByWorkspace->deepSpaceManeuverDeltaVs.sum( ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( swingByWorkspace->bodyEpochs( 2 ), 7.2 * physical_constants::JULIAN_YEAR +
+                                460.0 * physical_constants::JULIAN_DAY, 1.0E-15 );
+}
+
+//! Test population evaluation, and check that results are independent of number of threads.
+BOOST_AUTO_TEST_CASE( testPopulationEvaluation )
+{
+    for( unsigned int modelType = 0; modelType < 2; modelType++ )
+    {
+        MultipleGravityAssistTrajectoryPointer trajectoryModel;
+        if( modelType == 0 )
+        {
+            trajectoryModel = createTrajectoryModel< MultipleGravityAssistPoweredSwingByTrajectory >( true );
+        }
+        else
+        {
+            trajectoryModel = createTrajectoryModel< MultipleGravityAssistDeepSpaceManeuverTrajectory >( true );
+        }
+
+        // Create random population within typical bounds.
+        const int populationSize = 2000;
+        std::mt19937 randomNumberGenerator( 42 );
+        std::uniform_real_distribution< double > uniformDistribution( 0.0, 1.0 );
+        Eigen::MatrixXd decisionVectors( trajectoryModel->getDecisionVectorSize( ), populationSize );
+        for( int i = 0; i < populationSize; i++ )
+        {
+            decisionVectors( 0, i ) = ( 1.0 + 20.0 * uniformDistribution( randomNumberGenerator ) ) *
+                    physical_constants::JULIAN_YEAR;
+            if( modelType == 0 )
+            {
+                for( int j = 1; j < 3; j++ )
+                {
+                    decisionVectors( j, i ) = ( 50.0 + 400.0 * uniformDistribution( randomNumberGenerator ) ) *
+                            physical_constants::JULIAN_DAY;
+                }
+            }
+            else
+            {
+                decisionVectors( 1, i ) = 5.0E3 * uniformDistribution( randomNumberGenerator );
+                for( int j = 2; j < 5; j++ )
+                {
+                    decisionVectors( j, i ) = 0.01 + 0.98 * uniformDistribution( randomNumberGenerator );
+                }
+                decisionVectors( 5, i ) = ( 50.0 + 400.0 * uniformDistribution( randomNumberGenerator ) ) *
+                        physical_constants::JULIAN_DAY;
+                decisionVectors( 6, i ) = 2.0 * mathematical_constants::PI * uniformDistribution( randomNumberGenerator );
+                decisionVectors( 7, i ) = 1.0 + 4.0 * uniformDistribution( randomNumberGenerator );
+                decisionVectors( 8, i ) = 0.01 + 0.98 * uniformDistribution( randomNumberGenerator );
+                decisionVectors( 9, i ) = ( 50.0 + 400.0 * uniformDistribution( randomNumberGenerator ) ) *
+                        physical_constants::JULIAN_DAY;
+            }
+        }
+
+        // Evaluate population with 1 and 4 threads.
+        std::vector< Eigen::VectorXd > totalDeltaVs( 2 );
+        for( unsigned int i = 0; i < 2; i++ )
+        {
+            trajectoryModel->evaluatePopulation( decisionVectors, totalDeltaVs[ i ], ( i == 0 ) ? 1 : 4 );
+        }
+
+        int numberOfValidIndividuals = 0;
+        for( int i = 0; i < populationSize; i++ )
+        {
+            if( totalDeltaVs[ 0 ]( i ) == totalDeltaVs[ 0 ]( i ) )
+            {
+                numberOfValidIndividuals++;
+                BOOST_CHECK_EQUAL( totalDeltaVs[ 0 ]( i ), totalDeltaVs[ 1 ]( i ) );
+            }
+            else
+            {
+                BOOST_CHECK( totalDeltaVs[ 1 ]( i ) != totalDeltaVs[ 1 ]( i ) );
+            }
+        }
+        BOOST_CHECK_GT( numberOfValidIndividuals, populationSize / 2 );
+
+        // Compare with evaluation of single individual.
+        BOOST_CHECK_EQUAL( trajectoryModel->evaluate( decisionVectors.col( 7 ) ), totalDeltaVs[ 1 ]( 7 ) );
+    }
+}
+
+//! Test that evaluating trajectories with an existing workspace does not allocate heap memory.
+BOOST_AUTO_TEST_CASE( testEvaluationHeapAllocations )
+{
+    BOOST_CHECK_EQUAL( utilities::isHeapAllocationAuditActive( ), true );
+
+    for( int modelType = 0; modelType < 2; modelType++ )
+    {
+        boost::shared_ptr< MultipleGravityAssistTrajectory > trajectoryModel;
+        Eigen::VectorXd decisionVector;
+        if( modelType == 0 )
+        {
+            trajectoryModel = createTrajectoryModel< MultipleGravityAssistPoweredSwingByTrajectory >( true );
+            decisionVector.resize( 3 );
+            decisionVector << 7.2 * physical_constants::JULIAN_YEAR, 160.0 * physical_constants::JULIAN_DAY,
+                    300.0 * physical_constants::JULIAN_DAY;
+        }
+        else
+        {
+            trajectoryModel = createTrajectoryModel< MultipleGravityAssistDeepSpaceManeuverTrajectory >( true );
+            decisionVector.resize( 10 );
+            decisionVector << 7.2 * physical_constants::JULIAN_YEAR, 3.0E3, 0.3, 0.6, 0.4,
+                    160.0 * physical_constants::JULIAN_DAY, 1.2, 2.0, 0.5, 300.0 * physical_constants::JULIAN_DAY;
+        }
+        MultipleGravityAssistWorkspacePointer workspace = trajectoryModel->createWorkspace( );
+
+        // Evaluate trajectories with different departure epochs twice, counting the allocations of the second pass
+        // only, so that the one-time creation of the reused root functions (in all branches of the swing-by
+        // computations) is excluded.
+        const double initialEpoch = decisionVector( 0 );
+        utilities::HeapAllocationCounter allocationCounter;
+        double sumOfTotalDeltaVs = 0.0;
+        for( int j = 0; j < 2; j++ )
+        {
+            allocationCounter.reset( );
+            for( int i = 0; i < 100; i++ )
+            {
+                decisionVector( 0 ) = initialEpoch + 3.0 * static_cast< double >( i ) * physical_constants::JULIAN_DAY;
+                sumOfTotalDeltaVs += trajectoryModel->evaluate( decisionVector, *workspace );
+            }
+        }
+        BOOST_CHECK( sumOfTotalDeltaVs == sumOfTotalDeltaVs );
+        BOOST_CHECK_EQUAL( allocationCounter.getNumberOfAllocations( ), 0 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,303 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "Tudat/Astrodynamics/MissionSegments/shapeBasedLowThrustTrajectory.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace mission_segments;
+
+//! Gravitational parameter of the Sun [m^3/s^2].
+static const double SUN_GRAVITATIONAL_PARAMETER = 1.32712440018E20;
+
+//! Compute state of a body on a circular orbit in the x-y plane.
+Eigen::Vector6d computeCircularOrbitState( const double time, const double radius, const double initialAngle )
+{
+    const double velocity = std::sqrt( SUN_GRAVITATIONAL_PARAMETER / radius );
+    const double angle = initialAngle + velocity / radius * time;
+
+    Eigen::Vector6d state;
+    state << radius * std::cos( angle ), radius * std::sin( angle ), 0.0,
+            -velocity * std::sin( angle ), velocity * std::cos( angle ), 0.0;
+    return state;
+}
+
+//! Propagate planar trajectory with thrust along velocity (as function of azimuthal angle), using fixed-step RK4.
+Eigen::Vector4d propagatePolarStateWithTangentialThrust(
+        const ShapeBasedLowThrustTrajectoryPointer trajectory, const Eigen::Vector4d& initialPolarState,
+        const double timeOfFlight, const int numberOfSteps )
+{
+    // Polar state: radial distance, azimuthal angle (from departure), radial velocity, azimuthal velocity.
+    auto computeStateDerivative = [ & ]( const Eigen::Vector4d& state )
+    {
+        const double velocity = std::sqrt( state( 2 ) * state( 2 ) + state( 3 ) * state( 3 ) );
+        const double thrustAcceleration = trajectory->computeThrustAcceleration( state( 1 ) );
+
+        Eigen::Vector4d stateDerivative;
+        stateDerivative << state( 2 ), state( 3 ) / state( 0 ),
+                state( 3 ) * state( 3 ) / state( 0 ) - SUN_GRAVITATIONAL_PARAMETER / ( state( 0 ) * state( 0 ) ) +
+                thrustAcceleration * state( 2 ) / velocity,
+                -state( 2 ) * state( 3 ) / state( 0 ) + thrustAcceleration * state( 3 ) / velocity;
+        return stateDerivative;
+    };
+
+    const double stepSize = timeOfFlight / static_cast< double >( numberOfSteps );
+    Eigen::Vector4d state = initialPolarState;
+    for( int i = 0; i < numberOfSteps; i++ )
+    {
+        const Eigen::Vector4d k1 = computeStateDerivative( state );
+        const Eigen::Vector4d k2 = computeStateDerivative( state + 0.5 * stepSize * k1 );
+        const Eigen::Vector4d k3 = computeStateDerivative( state + 0.5 * stepSize * k2 );
+        const Eigen::Vector4d k4 = computeStateDerivative( state + stepSize * k3 );
+        state += stepSize / 6.0 * ( k1 + 2.0 * k2 + 2.0 * k3 + k4 );
+    }
+    return state;
+}
+
+//! Convert Cartesian state, for given shape, to polar state with azimuthal angle measured from departure.
+Eigen::Vector4d getPolarStateAtAzimuthalAngle(
+        const ShapeBasedLowThrustTrajectoryPointer trajectory, const double azimuthalAngle )
+{
+    const Eigen::Vector6d cartesianState = trajectory->computeCartesianState( azimuthalAngle );
+    const double radialDistance = cartesianState.segment( 0, 2 ).norm( );
+
+    Eigen::Vector4d polarState;
+    polarState << radialDistance, azimuthalAngle,
+            ( cartesianState( 0 ) * cartesianState( 3 ) + cartesianState( 1 ) * cartesianState( 4 ) ) / radialDistance,
+            ( cartesianState( 0 ) * cartesianState( 4 ) - cartesianState( 1 ) * cartesianState( 3 ) ) / radialDistance;
+    return polarState;
+}
+
+BOOST_AUTO_TEST_SUITE( test_shape_based_low_thrust_trajectory )
+
+//! Test exponential sinusoid against boundary conditions, and against numerical propagation of its thrust profile.
+BOOST_AUTO_TEST_CASE( testExponentialSinusoid )
+{
+    const double astronomicalUnit = physical_constants::ASTRONOMICAL_UNIT;
+    const Eigen::Vector6d departureState = computeCircularOrbitState( 0.0, astronomicalUnit, 0.3 );
+    const Eigen::Vector6d arrivalState = computeCircularOrbitState( 0.0, 1.5 * astronomicalUnit, 2.8 );
+    const double timeOfFlight = 250.0 * physical_constants::JULIAN_DAY;
+
+    ShapeBasedLowThrustTrajectoryPointer trajectory = boost::make_shared< ExponentialSinusoidTrajectory >(
+                departureState, arrivalState, timeOfFlight, SUN_GRAVITATIONAL_PARAMETER );
+    BOOST_CHECK_EQUAL( trajectory->isTrajectoryFeasible( ), true );
+    BOOST_CHECK_CLOSE_FRACTION( trajectory->getTransferAngle( ), 2.5, 1.0E-15 );
+
+    // Check boundary positions and time of flight.
+    const Eigen::Vector6d computedDepartureState = trajectory->computeCartesianState( 0.0 );
+    const Eigen::Vector6d computedArrivalState = trajectory->computeCartesianState( trajectory->getTransferAngle( ) );
+    for( unsigned int i = 0; i < 3; i++ )
+    {
+        BOOST_CHECK_SMALL( computedDepartureState( i ) - departureState( i ), 1.0E-6 * astronomicalUnit );
+        BOOST_CHECK_SMALL( computedArrivalState( i ) - arrivalState( i ), 1.0E-6 * astronomicalUnit );
+    }
+    BOOST_CHECK_CLOSE_FRACTION( trajectory->computeTimeOfFlight( ), timeOfFlight, 1.0E-9 );
+
+    // Check that shape satisfies |k1 k2^2| < 1.
+    const Eigen::Vector4d shapeParameters =
+            boost::dynamic_pointer_cast< ExponentialSinusoidTrajectory >( trajectory )->getShapeParameters( );
+    BOOST_CHECK_LT( std::fabs( shapeParameters( 1 ) * shapeParameters( 2 ) * shapeParameters( 2 ) ), 1.0 );
+
+    // Check delta V against quadrature of thrust profile magnitude (trapezoid rule).
+    const std::map< double, Eigen::Vector3d > thrustProfile = trajectory->computeThrustAccelerationProfile( 2001 );
+    BOOST_CHECK_EQUAL( thrustProfile.size( ), 2001 );
+    BOOST_CHECK_EQUAL( thrustProfile.begin( )->first, 0.0 );
+    BOOST_CHECK_CLOSE_FRACTION( thrustProfile.rbegin( )->first, timeOfFlight, 1.0E-9 );
+
+    double profileDeltaV = 0.0;
+    for( std::map< double, Eigen::Vector3d >::const_iterator profileIterator = thrustProfile.begin( );
+         std::next( profileIterator ) != thrustProfile.end( ); profileIterator++ )
+    {
+        profileDeltaV += 0.5 * ( std::next( profileIterator )->first - profileIterator->first ) *
+                ( profileIterator->second.norm( ) + std::next( profileIterator )->second.norm( ) );
+    }
+    BOOST_CHECK_CLOSE_FRACTION( trajectory->computeDeltaV( ), profileDeltaV, 1.0E-4 );
+
+    // Propagate the thrust profile numerically, and compare with arrival position.
+    const Eigen::Vector4d finalPolarState = propagatePolarStateWithTangentialThrust(
+                trajectory, getPolarStateAtAzimuthalAngle( trajectory, 0.0 ), timeOfFlight, 5000 );
+    const Eigen::Vector4d expectedFinalPolarState =
+            getPolarStateAtAzimuthalAngle( trajectory, trajectory->getTransferAngle( ) );
+    BOOST_CHECK_CLOSE_FRACTION( finalPolarState( 0 ), expectedFinalPolarState( 0 ), 1.0E-7 );
+    BOOST_CHECK_SMALL( finalPolarState( 1 ) - expectedFinalPolarState( 1 ), 1.0E-7 );
+    BOOST_CHECK_CLOSE_FRACTION( finalPolarState( 2 ), expectedFinalPolarState( 2 ), 1.0E-5 );
+    BOOST_CHECK_CLOSE_FRACTION( finalPolarState( 3 ), expectedFinalPolarState( 3 ), 1.0E-7 );
+
+    // Check that infeasible time of flight is detected.
+    ShapeBasedLowThrustTrajectoryPointer infeasibleTrajectory = boost::make_shared< ExponentialSinusoidTrajectory >(
+                departureState, arrivalState, 1.0 * physical_constants::JULIAN_DAY, SUN_GRAVITATIONAL_PARAMETER );
+    BOOST_CHECK_EQUAL( infeasibleTrajectory->isTrajectoryFeasible( ), false );
+}
+
+//! Test inverse polynomial for a Keplerian transfer, and against numerical propagation of its thrust profile.
+BOOST_AUTO_TEST_CASE( testInversePolynomial )
+{
+    using namespace orbital_element_conversions;
+
+    const double astronomicalUnit = physical_constants::ASTRONOMICAL_UNIT;
+
+    // Create boundary conditions on a single Keplerian orbit.
+    Eigen::Vector6d keplerianElements;
+    keplerianElements << 1.3 * astronomicalUnit, 0.2, 0.0, 0.4, 0.0, 0.5;
+    const Eigen::Vector6d departureState =
+            convertKeplerianToCartesianElements( keplerianElements, SUN_GRAVITATIONAL_PARAMETER );
+    keplerianElements( trueAnomalyIndex ) = 3.0;
+    const Eigen::Vector6d arrivalState =
+            convertKeplerianToCartesianElements( keplerianElements, SUN_GRAVITATIONAL_PARAMETER );
+
+    // Compute Keplerian time of flight from mean anomalies.
+    const double eccentricity = keplerianElements( eccentricityIndex );
+    double meanAnomalyDifference = 0.0;
+    for( unsigned int i = 0; i < 2; i++ )
+    {
+        const double trueAnomaly = ( i == 0 ) ? 0.5 : 3.0;
+        const double eccentricAnomaly = 2.0 * std::atan(
+                    std::sqrt( ( 1.0 - eccentricity ) / ( 1.0 + eccentricity ) ) * std::tan( 0.5 * trueAnomaly ) );
+        const double meanAnomaly = eccentricAnomaly - eccentricity * std::sin( eccentricAnomaly );
+        meanAnomalyDifference += ( i == 0 ) ? -meanAnomaly : meanAnomaly;
+    }
+    const double keplerianTimeOfFlight = meanAnomalyDifference / std::sqrt(
+                SUN_GRAVITATIONAL_PARAMETER / std::pow( keplerianElements( semiMajorAxisIndex ), 3 ) );
+
+    // Check that Keplerian transfer is recovered (d = 0, no delta V).
+    boost::shared_ptr< InversePolynomialTrajectory > keplerianTrajectory =
+            boost::make_shared< InversePolynomialTrajectory >(
+                departureState, arrivalState, keplerianTimeOfFlight, SUN_GRAVITATIONAL_PARAMETER );
+    BOOST_CHECK_EQUAL( keplerianTrajectory->isTrajectoryFeasible( ), true );
+    BOOST_CHECK_SMALL( keplerianTrajectory->getTimeDependentParameter( ) * astronomicalUnit, 1.0E-10 );
+    BOOST_CHECK_SMALL( keplerianTrajectory->getBoundaryParameters( ).second.norm( ) * astronomicalUnit, 1.0E-10 );
+    BOOST_CHECK_SMALL( keplerianTrajectory->computeDeltaV( ), 1.0E-6 );
+    BOOST_CHECK_CLOSE_FRACTION( keplerianTrajectory->computeRadialDistance( 0.0 ),
+                                departureState.segment( 0, 3 ).norm( ), 1.0E-14 );
+
+    // Check that ImprovedInversePolynomialWall reproduces shape.
+    ImprovedInversePolynomialWallPointer radialDistanceFunction =
+            keplerianTrajectory->createRadialDistanceFunction( );
+    BOOST_CHECK_CLOSE_FRACTION( radialDistanceFunction->evaluate( 1.3 ),
+                                keplerianTrajectory->computeRadialDistance( 1.3 ), 1.0E-14 );
+
+    // Check rendezvous transfer with longer time of flight (using more accurate quadrature, for comparison with
+    // numerical propagation).
+    const double timeOfFlight = 1.3 * keplerianTimeOfFlight;
+    ShapeBasedLowThrustTrajectoryPointer trajectory = boost::make_shared< InversePolynomialTrajectory >(
+                departureState, arrivalState, timeOfFlight, SUN_GRAVITATIONAL_PARAMETER, 0, 32 );
+    BOOST_CHECK_EQUAL( trajectory->isTrajectoryFeasible( ), true );
+    BOOST_CHECK_CLOSE_FRACTION( trajectory->computeTimeOfFlight( ), timeOfFlight, 1.0E-9 );
+    BOOST_CHECK_GT( trajectory->computeDeltaV( ), 0.0 );
+
+    const Eigen::Vector6d computedDepartureState = trajectory->computeCartesianState( 0.0 );
+    const Eigen::Vector6d computedArrivalState = trajectory->computeCartesianState( trajectory->getTransferAngle( ) );
+    for( unsigned int i = 0; i < 3; i++ )
+    {
+        BOOST_CHECK_SMALL( computedDepartureState( i ) - departureState( i ), 1.0E-6 * astronomicalUnit );
+        BOOST_CHECK_SMALL( computedArrivalState( i ) - arrivalState( i ), 1.0E-6 * astronomicalUnit );
+        BOOST_CHECK_SMALL( computedDepartureState( i + 3 ) - departureState( i + 3 ), 1.0E-6 );
+        BOOST_CHECK_SMALL( computedArrivalState( i + 3 ) - arrivalState( i + 3 ), 1.0E-6 );
+    }
+
+    // Propagate the thrust profile numerically, and compare with arrival position.
+    const Eigen::Vector4d finalPolarState = propagatePolarStateWithTangentialThrust(
+                trajectory, getPolarStateAtAzimuthalAngle( trajectory, 0.0 ), timeOfFlight, 5000 );
+    const Eigen::Vector4d expectedFinalPolarState =
+            getPolarStateAtAzimuthalAngle( trajectory, trajectory->getTransferAngle( ) );
+    BOOST_CHECK_CLOSE_FRACTION( finalPolarState( 0 ), expectedFinalPolarState( 0 ), 1.0E-7 );
+    BOOST_CHECK_SMALL( finalPolarState( 1 ) - expectedFinalPolarState( 1 ), 1.0E-7 );
+    BOOST_CHECK_CLOSE_FRACTION( finalPolarState( 3 ), expectedFinalPolarState( 3 ), 1.0E-7 );
+}
+
+//! Test grid evaluation, and check that results are independent of number of threads.
+BOOST_AUTO_TEST_CASE( testShapeBasedTransferGrid )
+{
+    const double astronomicalUnit = physical_constants::ASTRONOMICAL_UNIT;
+    const boost::function< Eigen::Vector6d( const double ) > departureBodyStateFunction =
+            boost::bind( &computeCircularOrbitState, _1, astronomicalUnit, 0.0 );
+    const boost::function< Eigen::Vector6d( const double ) > arrivalBodyStateFunction =
+            boost::bind( &computeCircularOrbitState, _1, 1.524 * astronomicalUnit, 1.0 );
+
+    const boost::function< ShapeBasedLowThrustTrajectoryPointer(
+                const Eigen::Vector6d&, const Eigen::Vector6d&, const double ) > trajectoryCreationFunction =
+            [ ]( const Eigen::Vector6d& departureState, const Eigen::Vector6d& arrivalState,
+                 const double timeOfFlight )
+    {
+        return boost::make_shared< ExponentialSinusoidTrajectory >(
+                    departureState, arrivalState, timeOfFlight, SUN_GRAVITATIONAL_PARAMETER );
+    };
+
+    for( unsigned int test = 0; test < 2; test++ )
+    {
+        const int gridSize = ( test == 0 ) ? 8 : 40;
+        std::vector< double > departureTimes, timesOfFlight;
+        for( int i = 0; i < gridSize; i++ )
+        {
+            departureTimes.push_back( static_cast< double >( i ) * 800.0 / gridSize * physical_constants::JULIAN_DAY );
+            timesOfFlight.push_back( ( 100.0 + static_cast< double >( i ) * 500.0 / gridSize ) *
+                                     physical_constants::JULIAN_DAY );
+        }
+
+        std::vector< Eigen::MatrixXd > deltaVs( 2 ), departureExcessVelocities( 2 ), arrivalExcessVelocities( 2 );
+        for( unsigned int i = 0; i < 2; i++ )
+        {
+            computeShapeBasedTransferGrid(
+                        trajectoryCreationFunction, departureBodyStateFunction, arrivalBodyStateFunction,
+                        departureTimes, timesOfFlight, deltaVs[ i ], departureExcessVelocities[ i ],
+                        arrivalExcessVelocities[ i ], ( i == 0 ) ? 1 : 4 );
+        }
+
+        // Compare results for single and multiple threads (including infeasible grid points).
+        int numberOfFeasibleTransfers = 0;
+        for( int i = 0; i < gridSize; i++ )
+        {
+            for( int j = 0; j < gridSize; j++ )
+            {
+                const bool isFeasible = ( deltaVs[ 0 ]( i, j ) == deltaVs[ 0 ]( i, j ) );
+                BOOST_CHECK_EQUAL( isFeasible, ( deltaVs[ 1 ]( i, j ) == deltaVs[ 1 ]( i, j ) ) );
+                if( isFeasible )
+                {
+                    numberOfFeasibleTransfers++;
+                    BOOST_CHECK_EQUAL( deltaVs[ 0 ]( i, j ), deltaVs[ 1 ]( i, j ) );
+                    BOOST_CHECK_EQUAL( departureExcessVelocities[ 0 ]( i, j ),
+                                       departureExcessVelocities[ 1 ]( i, j ) );
+                    BOOST_CHECK_EQUAL( arrivalExcessVelocities[ 0 ]( i, j ),
+                                       arrivalExcessVelocities[ 1 ]( i, j ) );
+                }
+            }
+        }
+        BOOST_CHECK_GT( numberOfFeasibleTransfers, 0 );
+
+        // Check single grid point against direct computation.
+        const ShapeBasedLowThrustTrajectoryPointer trajectory = trajectoryCreationFunction(
+                    departureBodyStateFunction( departureTimes.at( 2 ) ),
+                    arrivalBodyStateFunction( departureTimes.at( 2 ) + timesOfFlight.at( 5 ) ), timesOfFlight.at( 5 ) );
+        if( trajectory->isTrajectoryFeasible( ) )
+        {
+            BOOST_CHECK_EQUAL( trajectory->computeDeltaV( ), deltaVs[ 0 ]( 2, 5 ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,77 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+
+#include "Tudat/Astrodynamics/MissionSegments/ephemerisTable.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Constructor.
+EphemerisTable::EphemerisTable( const boost::function< Eigen::Vector6d( const double ) > stateFunction,
+                                const double startTime, const double endTime, const double timeStep,
+                                const int numberOfStages ):
+    startTime_( startTime ), timeStep_( timeStep )
+{
+    if( !( timeStep > 0.0 ) || !( endTime > startTime ) )
+    {
+        throw std::runtime_error( "Error when creating ephemeris table, time step and time range must be positive" );
+    }
+
+    if( numberOfStages < 2 || numberOfStages % 2 != 0 )
+    {
+        throw std::runtime_error( "Error when creating ephemeris table, number of stages must be even and positive, "
+                                  "but is " + boost::lexical_cast< std::string >( numberOfStages ) );
+    }
+
+    // Tabulate states on the requested range, extended on both sides such that all epochs in the range are interpolated
+    // with the centered interpolating polynomial.
+    const int numberOfIntervals = static_cast< int >( std::ceil( ( endTime - startTime ) / timeStep ) );
+    const int numberOfPaddingEpochs = numberOfStages / 2;
+    endTime_ = startTime_ + timeStep_ * static_cast< double >( numberOfIntervals );
+
+    std::vector< double > epochs;
+    std::vector< Eigen::Vector6d > states;
+    for( int i = -numberOfPaddingEpochs; i <= numberOfIntervals + numberOfPaddingEpochs; i++ )
+    {
+        epochs.push_back( startTime_ + timeStep_ * static_cast< double >( i ) );
+        states.push_back( stateFunction( epochs.back( ) ) );
+    }
+
+    stateInterpolator_ = boost::make_shared< interpolators::LagrangeInterpolator< double, Eigen::Vector6d > >(
+                epochs, states, numberOfStages, interpolators::equidistantLookup,
+                interpolators::lagrange_no_boundary_interpolation, interpolators::component_major_storage );
+}
+
+//! Function to retrieve the Cartesian state of the body.
+void EphemerisTable::getCartesianState( const double time, Eigen::Vector6d& cartesianState ) const
+{
+    if( !( time >= startTime_ ) || !( time <= endTime_ ) )
+    {
+        throw std::runtime_error( "Error when retrieving state from ephemeris table, time " +
+                                  boost::lexical_cast< std::string >( time ) + " is outside table range [" +
+                                  boost::lexical_cast< std::string >( startTime_ ) + ", " +
+                                  boost::lexical_cast< std::string >( endTime_ ) + "]" );
+    }
+
+    stateInterpolator_->interpolateInto( time, cartesianState );
+}
+
+} // namespace mission_segments
+} // namespace tudat
@@ -0,0 +1,130 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_EPHEMERIS_TABLE_H
+#define TUDAT_EPHEMERIS_TABLE_H
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/basicTypedefs.h"
+#include "Tudat/Mathematics/Interpolators/lagrangeInterpolator.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Table of the Cartesian state of a body at equidistant epochs.
+/*!
+ *  Table of the Cartesian state of a body at equidistant epochs, from which the state at any epoch in the table range is
+ *  retrieved by Lagrange interpolation (using the equidistant lookup scheme and component-major storage of the
+ *  LagrangeInterpolator). The table is extended by half the number of interpolation stages on either side of the
+ *  requested range, so that the centered interpolating polynomial is used for all epochs in the range. Retrieving a
+ *  state requires no memory allocation, and is safe to do concurrently. This class is intended to replace repeated
+ *  evaluations of an (analytical) ephemeris in trajectory optimization. For the approximate planet positions, a time
+ *  step of one day (and the default of 8 stages) results in errors below 1 m and 1.0E-6 m/s, respectively (except
+ *  for Mercury, for which the errors are below 50 m and 1.0E-3 m/s).
+ */
+class EphemerisTable
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor, evaluates the state function at all epochs in the table (including the numberOfStages / 2 epochs
+     *  before startTime and after endTime that are added for the interpolation).
+     *  \param stateFunction Function returning the Cartesian state of the body as a function of time.
+     *  \param startTime First epoch of the table.
+     *  \param endTime Last epoch of the table (increased to an integer number of time steps after startTime, if needed).
+     *  \param timeStep Time step between subsequent epochs of the table.
+     *  \param numberOfStages Number of epochs that are used for the Lagrange interpolation (must be even).
+     */
+    EphemerisTable( const boost::function< Eigen::Vector6d( const double ) > stateFunction,
+                    const double startTime, const double endTime, const double timeStep,
+                    const int numberOfStages = 8 );
+
+    //! Function to retrieve the Cartesian state of the body.
+    /*!
+     *  Function to retrieve the Cartesian state of the body at a given epoch, by interpolation of the table.
+     *  \param time Epoch at which the state is to be retrieved.
+     *  \param cartesianState Cartesian state of the body at the given epoch (returned by reference).
+     *  \throws std::runtime_error If the epoch is outside the range of the table.
+     */
+    void getCartesianState( const double time, Eigen::Vector6d& cartesianState ) const;
+
+    //! Function to retrieve the Cartesian state of the body.
+    /*!
+     *  Function to retrieve the Cartesian state of the body at a given epoch, by interpolation of the table.
+     *  \param time Epoch at which the state is to be retrieved.
+     *  \return Cartesian state of the body at the given epoch.
+     *  \throws std::runtime_error If the epoch is outside the range of the table.
+     */
+    Eigen::Vector6d getCartesianState( const double time ) const
+    {
+        Eigen::Vector6d cartesianState;
+        getCartesianState( time, cartesianState );
+        return cartesianState;
+    }
+
+    //! Function to retrieve the first epoch of the table.
+    /*!
+     *  Function to retrieve the first epoch of the table.
+     *  \return First epoch of the table.
+     */
+    double getStartTime( ) const
+    {
+        return startTime_;
+    }
+
+    //! Function to retrieve the last epoch of the table.
+    /*!
+     *  Function to retrieve the last epoch of the table.
+     *  \return Last epoch of the table.
+     */
+    double getEndTime( ) const
+    {
+        return endTime_;
+    }
+
+    //! Function to retrieve the time step of the table.
+    /*!
+     *  Function to retrieve the time step between subsequent epochs of the table.
+     *  \return Time step between subsequent epochs of the table.
+     */
+    double getTimeStep( ) const
+    {
+        return timeStep_;
+    }
+
+private:
+
+    //! First epoch of the table.
+    double startTime_;
+
+    //! Last epoch of the table.
+    double endTime_;
+
+    //! Time step between subsequent epochs of the table.
+    double timeStep_;
+
+    //! Interpolator of the tabulated Cartesian states.
+    boost::shared_ptr< interpolators::LagrangeInterpolator< double, Eigen::Vector6d > > stateInterpolator_;
+};
+
+//! Typedef for shared-pointer to EphemerisTable object.
+typedef boost::shared_ptr< EphemerisTable > EphemerisTablePointer;
+
+} // namespace mission_segments
+} // namespace tudat
+
+#endif // TUDAT_EPHEMERIS_TABLE_H
@@ -36,16 +36,12 @@
  *
  */
 
+#include <algorithm>
 #include <cmath>
 
-#include <boost/bind.hpp>
-
 #include <Eigen/Dense>
 
-#include "Tudat/Mathematics/BasicMathematics/linearAlgebra.h"
-
 #include "Tudat/Astrodynamics/MissionSegments/gravityAssist.h"
-#include "Tudat/Mathematics/BasicMathematics/functionProxy.h"
 
 namespace tudat
 {
@@ -64,9 +60,6 @@ double gravityAssist( const double centralBodyGravitationalParameter,
                       const double speedTolerance,
                       RootFinderPointer rootFinder )
 {
-    using basic_mathematics::UnivariateProxyPointer;
-    using basic_mathematics::UnivariateProxy;
-
     // Compute incoming and outgoing hyperbolic excess velocity.
     const Eigen::Vector3d incomingHyperbolicExcessVelocity
             = incomingVelocity - centralBodyVelocity;
@@ -77,9 +70,12 @@ double gravityAssist( const double centralBodyGravitationalParameter,
     const double absoluteIncomingExcessVelocity = incomingHyperbolicExcessVelocity.norm( );
     const double absoluteOutgoingExcessVelocity = outgoingHyperbolicExcessVelocity.norm( );
 
-    // Compute bending angle.
-    double bendingAngle = linear_algebra::computeAngleBetweenVectors(
-                            incomingHyperbolicExcessVelocity, outgoingHyperbolicExcessVelocity );
+    // Compute bending angle (directly from the fixed-size vectors, rather than by using
+    // linear_algebra::computeAngleBetweenVectors, which would allocate dynamic-size copies).
+    const double cosineOfBendingAngle = std::max( -1.0, std::min(
+            1.0, incomingHyperbolicExcessVelocity.normalized( ).dot(
+                outgoingHyperbolicExcessVelocity.normalized( ) ) ) );
+    double bendingAngle = std::acos( cosineOfBendingAngle );
 
     // Compute maximum achievable bending angle.
     const double maximumBendingAngle =
@@ -162,21 +158,11 @@ double gravityAssist( const double centralBodyGravitationalParameter,
                                              absoluteOutgoingExcessVelocity;
 
         // Set the gravity assist function with the variables to perform root finder calculations.
-        EccentricityFindingFunctions eccentricityFindingFunctions( incomingSemiMajorAxis,
-                                                                   outgoingSemiMajorAxis,
-                                                                   bendingAngle );
-
-        // Create an object containing the function of which we whish to obtain the root from.
-        UnivariateProxyPointer rootFunction = boost::make_shared< UnivariateProxy >(
-                    boost::bind( &EccentricityFindingFunctions::
-                                 computeIncomingEccentricityFunction,
-                                 eccentricityFindingFunctions, _1 ) );
-
-        // Add the first derivative of the root function.
-        rootFunction->addBinding( -1, boost::bind(
-                                      &EccentricityFindingFunctions::
-                                      computeFirstDerivativeIncomingEccentricityFunction,
-                                      eccentricityFindingFunctions, _1 ) );
+        // The root function object is reused by each thread, so that no memory is allocated.
+        static thread_local EccentricityFindingFunctionsPointer rootFunction =
+                boost::make_shared< EccentricityFindingFunctions >( TUDAT_NAN, TUDAT_NAN,
+                                                                    TUDAT_NAN );
+        rootFunction->resetParameters( incomingSemiMajorAxis, outgoingSemiMajorAxis, bendingAngle );
 
         // Initialize incoming eccentricity.
         double incomingEccentricity = TUDAT_NAN;
@@ -231,19 +217,11 @@ double gravityAssist( const double centralBodyGravitationalParameter,
                                                      absoluteOutgoingExcessVelocity;
 
         // Set the gravity assist function with the variables to perform root finder calculations.
-        PericenterFindingFunctions pericenterFindingFunctions( absoluteIncomingSemiMajorAxis,
-                                                               absoluteOutgoingSemiMajorAxis,
-                                                               bendingAngle);
-
-        // Create an object containing the function of which we whish to obtain the root from.
-        UnivariateProxyPointer rootFunction = boost::make_shared< UnivariateProxy >(
-                    boost::bind( &PericenterFindingFunctions::computePericenterRadiusFunction,
-                                 pericenterFindingFunctions, _1 ) );
-
-        // Add the first derivative of the root function.
-        rootFunction->addBinding( -1, boost::bind( &PericenterFindingFunctions::
-                                                   computeFirstDerivativePericenterRadiusFunction,
-                                                   pericenterFindingFunctions, _1 ) );
+        // The root function object is reused by each thread, so that no memory is allocated.
+        static thread_local PericenterFindingFunctionsPointer rootFunction =
+                boost::make_shared< PericenterFindingFunctions >( TUDAT_NAN, TUDAT_NAN, TUDAT_NAN );
+        rootFunction->resetParameters( absoluteIncomingSemiMajorAxis,
+                                       absoluteOutgoingSemiMajorAxis, bendingAngle );
 
         // Set pericenter radius based on result of Newton-Raphson root-finding algorithm.
         const double pericenterRadius = rootFinder->execute( rootFunction,
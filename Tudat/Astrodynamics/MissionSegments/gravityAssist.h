@@ -23,10 +23,13 @@
 #ifndef TUDAT_GRAVITY_ASSIST_H
 #define TUDAT_GRAVITY_ASSIST_H
 
+#include <stdexcept>
+
 #include <boost/make_shared.hpp>
 
 #include <Eigen/Core>
 
+#include "Tudat/Mathematics/BasicMathematics/function.h"
 #include "Tudat/Mathematics/RootFinders/newtonRaphson.h"
 #include "Tudat/Mathematics/RootFinders/rootFinder.h"
 #include "Tudat/Mathematics/RootFinders/terminationConditions.h"
@@ -105,9 +108,10 @@ Eigen::Vector3d gravityAssist( const double centralBodyGravitationalParameter,
 //! Pericenter finding functions class.
 /*!
  * This class contains the functions required by the root-finders to find the pericenter radius in
- * the gravity assist function to find the deltaV.
+ * the gravity assist function to find the deltaV. It is a root function itself, of which the
+ * parameters can be reset, so that a single object can be reused for many gravity assists.
  */
-class PericenterFindingFunctions
+class PericenterFindingFunctions: public basic_mathematics::Function< >
 {
 public:
 
@@ -152,6 +156,70 @@ public:
      */
     double computeFirstDerivativePericenterRadiusFunction( const double pericenterRadius );
 
+    //! Function to reset the parameters.
+    /*!
+     * Function to reset the parameters of the pericenter finding functions, so that the object
+     * can be reused for another gravity assist without allocating a new one.
+     * \param absoluteIncomingSemiMajorAxis The absolute semi-major axis of the incoming hyperbolic
+     *          leg.                                                                            [m]
+     * \param absoluteOutgoingSemiMajorAxis The absolute semi-major axis of the outgoing hyperbolic
+     *          leg.                                                                            [m]
+     * \param bendingAngle The bending angle between the excess velocities.                   [rad]
+     */
+    void resetParameters( const double absoluteIncomingSemiMajorAxis,
+                          const double absoluteOutgoingSemiMajorAxis,
+                          const double bendingAngle )
+    {
+        absoluteIncomingSemiMajorAxis_ = absoluteIncomingSemiMajorAxis;
+        absoluteOutgoingSemiMajorAxis_ = absoluteOutgoingSemiMajorAxis;
+        bendingAngle_ = bendingAngle;
+    }
+
+    //! Evaluate the pericenter radius function.
+    /*!
+     * Evaluates the pericenter radius function, for use as root function by the root-finders.
+     * \param inputValue Pericenter radius.
+     * \return Pericenter radius root finding function value.
+     */
+    double evaluate( const double inputValue )
+    {
+        return computePericenterRadiusFunction( inputValue );
+    }
+
+    //! Evaluate the derivative of the pericenter radius function.
+    /*!
+     * Evaluates the first derivative of the pericenter radius function, for use as root function
+     * by the root-finders. Higher-order derivatives are not available.
+     * \param order Order of the derivative (must be 1).
+     * \param independentVariable Pericenter radius.
+     * \return Pericenter radius root finding function first-derivative value.
+     */
+    double computeDerivative( const unsigned int order, const double independentVariable )
+    {
+        if( order != 1 )
+        {
+            throw std::runtime_error( "Error in PericenterFindingFunctions, only the first "
+                                      "derivative is available." );
+        }
+        return computeFirstDerivativePericenterRadiusFunction( independentVariable );
+    }
+
+    //! Evaluate the definite integral of the pericenter radius function (not available).
+    /*!
+     * The definite integral of the pericenter radius function is not available, this function
+     * throws an exception.
+     * \param order Order of the integral.
+     * \param lowerBound Integration lower bound.
+     * \param upperbound Integration upper bound.
+     * \return Nothing, an exception is thrown.
+     */
+    double computeDefiniteIntegral( const unsigned int order, const double lowerBound,
+                                    const double upperbound )
+    {
+        throw std::runtime_error( "Error in PericenterFindingFunctions, integral is not "
+                                  "available." );
+    }
+
 protected:
 
 private:
@@ -162,7 +230,7 @@ private:
      * because otherwisely the first derivative of the pericenter radius finding function will
      * compute the root of a negative value.
      */
-    const double absoluteIncomingSemiMajorAxis_;
+    double absoluteIncomingSemiMajorAxis_;
 
     //! The absolute semi-major axis of the outgoing hyperbolic leg.
     /*!
@@ -170,13 +238,13 @@ private:
      * because otherwisely the first derivative of the pericenter radius finding function will
      * compute the root of a negative value.
      */
-    const double absoluteOutgoingSemiMajorAxis_;
+    double absoluteOutgoingSemiMajorAxis_;
 
     //! Bending angle between the excess velocities.
     /*!
      * Bending angle between the excess velocities.
      */
-    const double bendingAngle_;
+    double bendingAngle_;
 };
 
 //! Typedef for shared-pointer to PericenterFindingFunctions object.
@@ -185,9 +253,10 @@ typedef boost::shared_ptr< PericenterFindingFunctions > PericenterFindingFunctio
 //! Eccentricity finding functions class.
 /*!
  * This class contains the functions required by the root-finders to find the incoming eccentricity
- * in the gravity assist function to find the deltaV.
+ * in the gravity assist function to find the deltaV. It is a root function itself, of which the
+ * parameters can be reset, so that a single object can be reused for many gravity assists.
  */
-class EccentricityFindingFunctions
+class EccentricityFindingFunctions: public basic_mathematics::Function< >
 {
 public:
 
@@ -229,6 +298,69 @@ public:
      */
     double computeFirstDerivativeIncomingEccentricityFunction( const double incomingEccentricity );
 
+    //! Function to reset the parameters.
+    /*!
+     * Function to reset the parameters of the eccentricity finding functions, so that the object
+     * can be reused for another gravity assist without allocating a new one.
+     * \param incomingSemiMajorAxis The semi-major axis of the incomming hyperbolic leg.        [m]
+     * \param outgoingSemiMajorAxis The semi-major axis of the outgoing hyperbolic leg.         [m]
+     * \param bendingAngle The bending angle between the excess velocities.                   [rad]
+     */
+    void resetParameters( const double incomingSemiMajorAxis,
+                          const double outgoingSemiMajorAxis,
+                          const double bendingAngle )
+    {
+        incomingSemiMajorAxis_ = incomingSemiMajorAxis;
+        outgoingSemiMajorAxis_ = outgoingSemiMajorAxis;
+        bendingAngle_ = bendingAngle;
+    }
+
+    //! Evaluate the incoming eccentricity function.
+    /*!
+     * Evaluates the incoming eccentricity function, for use as root function by the
+     * root-finders.
+     * \param inputValue Incoming eccentricity.
+     * \return Incoming eccentricity root finding function value.
+     */
+    double evaluate( const double inputValue )
+    {
+        return computeIncomingEccentricityFunction( inputValue );
+    }
+
+    //! Evaluate the derivative of the incoming eccentricity function.
+    /*!
+     * Evaluates the first derivative of the incoming eccentricity function, for use as root
+     * function by the root-finders. Higher-order derivatives are not available.
+     * \param order Order of the derivative (must be 1).
+     * \param independentVariable Incoming eccentricity.
+     * \return Incoming eccentricity root finding function first-derivative value.
+     */
+    double computeDerivative( const unsigned int order, const double independentVariable )
+    {
+        if( order != 1 )
+        {
+            throw std::runtime_error( "Error in EccentricityFindingFunctions, only the first "
+                                      "derivative is available." );
+        }
+        return computeFirstDerivativeIncomingEccentricityFunction( independentVariable );
+    }
+
+    //! Evaluate the definite integral of the incoming eccentricity function (not available).
+    /*!
+     * The definite integral of the incoming eccentricity function is not available, this
+     * function throws an exception.
+     * \param order Order of the integral.
+     * \param lowerBound Integration lower bound.
+     * \param upperbound Integration upper bound.
+     * \return Nothing, an exception is thrown.
+     */
+    double computeDefiniteIntegral( const unsigned int order, const double lowerBound,
+                                    const double upperbound )
+    {
+        throw std::runtime_error( "Error in EccentricityFindingFunctions, integral is not "
+                                  "available." );
+    }
+
 protected:
 
 private:
@@ -237,19 +369,19 @@ private:
     /*!
      * Semi-major axis of the incoming hyperbolic leg.
      */
-    const double incomingSemiMajorAxis_;
+    double incomingSemiMajorAxis_;
 
     //! Semi-major axis of the outgoing hyperbolic leg.
     /*!
      * Semi-major axis of the outgoing hyperbolic leg.
      */
-    const double outgoingSemiMajorAxis_;
+    double outgoingSemiMajorAxis_;
 
     //! Bending angle between the excess velocities.
     /*!
      * Bending angle between the excess velocities.
      */
-    const double bendingAngle_;
+    double bendingAngle_;
 };
 
 //! Typedef for shared-pointer to EccentricityFindingFunctions object.
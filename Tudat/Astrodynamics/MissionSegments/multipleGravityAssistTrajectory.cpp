@@ -0,0 +1,289 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Vinko, T., Izzo, D. and C. Bombardelli. Benchmarking different global optimisation techniques
+ *          for preliminary space trajectory design, 58th International Astronautical Congress,
+ *          IAC-07-A1.3.01, 2007.
+ */
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/keplerPropagator.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Astrodynamics/MissionSegments/escapeAndCapture.h"
+#include "Tudat/Astrodynamics/MissionSegments/gravityAssist.h"
+#include "Tudat/Astrodynamics/MissionSegments/lambertRoutines.h"
+#include "Tudat/Astrodynamics/MissionSegments/multipleGravityAssistTrajectory.h"
+#include "Tudat/Basics/parallelization.h"
+#include "Tudat/Mathematics/RootFinders/newtonRaphson.h"
+#include "Tudat/Mathematics/RootFinders/terminationConditions.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Constructor of workspace.
+MultipleGravityAssistWorkspace::MultipleGravityAssistWorkspace( const int numberOfBodies ):
+    bodyEpochs( numberOfBodies ), bodyStates( 6, numberOfBodies ),
+    legDepartureVelocities( 3, numberOfBodies - 1 ), legArrivalVelocities( 3, numberOfBodies - 1 ),
+    deepSpaceManeuverEpochs( numberOfBodies - 1 ), deepSpaceManeuverDeltaVs( numberOfBodies - 1 ),
+    bodyDeltaVs( numberOfBodies )
+{
+    // Create root finders with the same settings as the defaults of gravityAssist and propagateKeplerOrbit.
+    gravityAssistRootFinder = boost::make_shared< root_finders::NewtonRaphson >( 1.0e-12, 1000 );
+    keplerRootFinder = boost::make_shared< root_finders::NewtonRaphson >(
+                boost::bind( &root_finders::termination_conditions::RootAbsoluteToleranceTerminationCondition< double >::
+                             checkTerminationCondition,
+                             boost::make_shared< root_finders::termination_conditions::
+                             RootAbsoluteToleranceTerminationCondition< double > >(
+                                 200.0 * std::numeric_limits< double >::epsilon( ), 1000 ), _1, _2, _3, _4, _5 ) );
+}
+
+//! Constructor of multiple gravity assist trajectory model.
+MultipleGravityAssistTrajectory::MultipleGravityAssistTrajectory(
+        const std::vector< EphemerisTablePointer >& bodyEphemerisTables,
+        const std::vector< double >& bodyGravitationalParameters,
+        const std::vector< double >& minimumPericenterRadii,
+        const double centralBodyGravitationalParameter,
+        const std::pair< double, double >& departureParkingOrbit,
+        const std::pair< double, double >& arrivalCaptureOrbit ):
+    numberOfBodies_( bodyEphemerisTables.size( ) ), bodyEphemerisTables_( bodyEphemerisTables ),
+    bodyGravitationalParameters_( bodyGravitationalParameters ), minimumPericenterRadii_( minimumPericenterRadii ),
+    centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+    departureParkingOrbit_( departureParkingOrbit ), arrivalCaptureOrbit_( arrivalCaptureOrbit )
+{
+    if( numberOfBodies_ < 2 )
+    {
+        throw std::runtime_error( "Error when creating multiple gravity assist trajectory, at least 2 bodies required" );
+    }
+
+    if( static_cast< int >( bodyGravitationalParameters_.size( ) ) != numberOfBodies_ ||
+            static_cast< int >( minimumPericenterRadii_.size( ) ) != numberOfBodies_ )
+    {
+        throw std::runtime_error( "Error when creating multiple gravity assist trajectory, inconsistent number of "
+                                  "gravitational parameters or minimum pericenter radii" );
+    }
+}
+
+//! Function to evaluate a population of trajectories.
+void MultipleGravityAssistTrajectory::evaluatePopulation(
+        const Eigen::MatrixXd& decisionVectors, Eigen::VectorXd& totalDeltaVs, const unsigned int numberOfThreads )
+{
+    if( decisionVectors.rows( ) != getDecisionVectorSize( ) )
+    {
+        throw std::runtime_error( "Error when evaluating multiple gravity assist population, decision vector size is " +
+                                  boost::lexical_cast< std::string >( decisionVectors.rows( ) ) + ", expected " +
+                                  boost::lexical_cast< std::string >( getDecisionVectorSize( ) ) );
+    }
+
+    const unsigned int numberOfIndividuals = decisionVectors.cols( );
+    const unsigned int numberOfBlocks = std::max( 1U, std::min( numberOfThreads, numberOfIndividuals ) );
+
+    // Create workspaces that are not yet available from previous calls.
+    while( populationWorkspaces_.size( ) < numberOfBlocks )
+    {
+        populationWorkspaces_.push_back( createWorkspace( ) );
+    }
+
+    // Evaluate contiguous blocks of individuals concurrently, each with its own workspace.
+    totalDeltaVs.resize( numberOfIndividuals );
+    utilities::executeParallelLoop( numberOfBlocks, [ & ]( const unsigned int blockIndex )
+    {
+        MultipleGravityAssistWorkspace& workspace = *populationWorkspaces_[ blockIndex ];
+        const unsigned int startIndex = ( blockIndex * numberOfIndividuals ) / numberOfBlocks;
+        const unsigned int endIndex = ( ( blockIndex + 1 ) * numberOfIndividuals ) / numberOfBlocks;
+        for( unsigned int i = startIndex; i < endIndex; i++ )
+        {
+            workspace.decisionVector = decisionVectors.col( i );
+            try
+            {
+                totalDeltaVs( i ) = evaluate( workspace.decisionVector, workspace );
+            }
+            catch( std::runtime_error& )
+            {
+                totalDeltaVs( i ) = TUDAT_NAN;
+            }
+        }
+    }, numberOfBlocks );
+}
+
+//! Function to check the size of a decision vector.
+void MultipleGravityAssistTrajectory::checkDecisionVectorSize( const Eigen::VectorXd& decisionVector ) const
+{
+    if( decisionVector.rows( ) != getDecisionVectorSize( ) )
+    {
+        throw std::runtime_error( "Error when evaluating multiple gravity assist trajectory, decision vector size is " +
+                                  boost::lexical_cast< std::string >( decisionVector.rows( ) ) + ", expected " +
+                                  boost::lexical_cast< std::string >( getDecisionVectorSize( ) ) );
+    }
+}
+
+//! Function to retrieve the states of all bodies at the epochs in the workspace.
+void MultipleGravityAssistTrajectory::setBodyStates( MultipleGravityAssistWorkspace& workspace ) const
+{
+    Eigen::Vector6d bodyState;
+    for( int i = 0; i < numberOfBodies_; i++ )
+    {
+        bodyEphemerisTables_[ i ]->getCartesianState( workspace.bodyEpochs( i ), bodyState );
+        workspace.bodyStates.col( i ) = bodyState;
+    }
+}
+
+//! Function to compute the delta V at departure.
+double MultipleGravityAssistTrajectory::computeDepartureDeltaV( const double excessVelocity ) const
+{
+    if( departureParkingOrbit_.first == departureParkingOrbit_.first )
+    {
+        return computeEscapeOrCaptureDeltaV( bodyGravitationalParameters_.front( ), departureParkingOrbit_.first,
+                                             departureParkingOrbit_.second, excessVelocity );
+    }
+    else
+    {
+        return excessVelocity;
+    }
+}
+
+//! Function to compute the delta V at arrival.
+double MultipleGravityAssistTrajectory::computeArrivalDeltaV( const double excessVelocity ) const
+{
+    if( arrivalCaptureOrbit_.first == arrivalCaptureOrbit_.first )
+    {
+        return computeEscapeOrCaptureDeltaV( bodyGravitationalParameters_.back( ), arrivalCaptureOrbit_.first,
+                                             arrivalCaptureOrbit_.second, excessVelocity );
+    }
+    else
+    {
+        return excessVelocity;
+    }
+}
+
+//! Function to evaluate an MGA trajectory.
+double MultipleGravityAssistPoweredSwingByTrajectory::evaluate(
+        const Eigen::VectorXd& decisionVector, MultipleGravityAssistWorkspace& workspace ) const
+{
+    checkDecisionVectorSize( decisionVector );
+
+    // Set epochs and states of bodies.
+    workspace.bodyEpochs( 0 ) = decisionVector( 0 );
+    for( int i = 1; i < numberOfBodies_; i++ )
+    {
+        workspace.bodyEpochs( i ) = workspace.bodyEpochs( i - 1 ) + decisionVector( i );
+    }
+    setBodyStates( workspace );
+
+    // Solve Lambert problem for each leg.
+    Eigen::Vector3d departureVelocity, arrivalVelocity;
+    for( int i = 0; i < numberOfBodies_ - 1; i++ )
+    {
+        solveLambertProblemIzzo( workspace.bodyStates.block( 0, i, 3, 1 ), workspace.bodyStates.block( 0, i + 1, 3, 1 ),
+                                 decisionVector( i + 1 ), centralBodyGravitationalParameter_,
+                                 departureVelocity, arrivalVelocity );
+        workspace.legDepartureVelocities.col( i ) = departureVelocity;
+        workspace.legArrivalVelocities.col( i ) = arrivalVelocity;
+    }
+    workspace.deepSpaceManeuverEpochs.setConstant( TUDAT_NAN );
+    workspace.deepSpaceManeuverDeltaVs.setZero( );
+
+    // Compute delta V at departure, swing-bys and arrival.
+    workspace.bodyDeltaVs( 0 ) = computeDepartureDeltaV(
+                ( workspace.legDepartureVelocities.col( 0 ) - workspace.bodyStates.block( 3, 0, 3, 1 ) ).norm( ) );
+    for( int i = 1; i < numberOfBodies_ - 1; i++ )
+    {
+        workspace.bodyDeltaVs( i ) = gravityAssist(
+                    bodyGravitationalParameters_[ i ], workspace.bodyStates.block( 3, i, 3, 1 ),
+                    workspace.legArrivalVelocities.col( i - 1 ), workspace.legDepartureVelocities.col( i ),
+                    minimumPericenterRadii_[ i ], true, 1.0e-6, workspace.gravityAssistRootFinder );
+    }
+    workspace.bodyDeltaVs( numberOfBodies_ - 1 ) = computeArrivalDeltaV(
+                ( workspace.legArrivalVelocities.col( numberOfBodies_ - 2 ) -
+                  workspace.bodyStates.block( 3, numberOfBodies_ - 1, 3, 1 ) ).norm( ) );
+
+    return workspace.bodyDeltaVs.sum( );
+}
+
+//! Function to evaluate an MGA-1DSM trajectory.
+double MultipleGravityAssistDeepSpaceManeuverTrajectory::evaluate(
+        const Eigen::VectorXd& decisionVector, MultipleGravityAssistWorkspace& workspace ) const
+{
+    checkDecisionVectorSize( decisionVector );
+
+    // Set epochs and states of bodies (time of flight of leg i is the last entry of its block of the decision vector).
+    workspace.bodyEpochs( 0 ) = decisionVector( 0 );
+    workspace.bodyEpochs( 1 ) = decisionVector( 0 ) + decisionVector( 5 );
+    for( int i = 2; i < numberOfBodies_; i++ )
+    {
+        workspace.bodyEpochs( i ) = workspace.bodyEpochs( i - 1 ) + decisionVector( 4 * i + 1 );
+    }
+    setBodyStates( workspace );
+
+    // Compute departure velocity from excess velocity magnitude and direction.
+    const double excessVelocity = decisionVector( 1 );
+    const double inPlaneAngle = 2.0 * mathematical_constants::PI * decisionVector( 2 );
+    const double outOfPlaneAngle = std::acos( 2.0 * decisionVector( 3 ) - 1.0 ) - mathematical_constants::PI / 2.0;
+    Eigen::Vector3d outgoingVelocity = workspace.bodyStates.block( 3, 0, 3, 1 ) + excessVelocity * Eigen::Vector3d(
+                std::cos( outOfPlaneAngle ) * std::cos( inPlaneAngle ),
+                std::cos( outOfPlaneAngle ) * std::sin( inPlaneAngle ),
+                std::sin( outOfPlaneAngle ) );
+    workspace.bodyDeltaVs( 0 ) = computeDepartureDeltaV( excessVelocity );
+
+    Eigen::Vector6d cartesianState;
+    Eigen::Vector3d departureVelocity, arrivalVelocity;
+    for( int i = 0; i < numberOfBodies_ - 1; i++ )
+    {
+        // Perform unpowered swing-by at the departure body of the leg.
+        const int legStartIndex = 4 * i + 4;
+        if( i > 0 )
+        {
+            outgoingVelocity = gravityAssist(
+                        bodyGravitationalParameters_[ i ], workspace.bodyStates.block( 3, i, 3, 1 ),
+                        workspace.legArrivalVelocities.col( i - 1 ), decisionVector( legStartIndex - 2 ),
+                        decisionVector( legStartIndex - 1 ) * minimumPericenterRadii_[ i ] );
+            workspace.bodyDeltaVs( i ) = 0.0;
+        }
+        workspace.legDepartureVelocities.col( i ) = outgoingVelocity;
+
+        // Propagate Keplerian orbit to deep space maneuver.
+        const double timeOfFlight = workspace.bodyEpochs( i + 1 ) - workspace.bodyEpochs( i );
+        const double timeToDeepSpaceManeuver = decisionVector( legStartIndex ) * timeOfFlight;
+        cartesianState << workspace.bodyStates.block( 0, i, 3, 1 ), outgoingVelocity;
+        cartesianState = orbital_element_conversions::convertKeplerianToCartesianElements(
+                    orbital_element_conversions::propagateKeplerOrbit(
+                        orbital_element_conversions::convertCartesianToKeplerianElements(
+                            cartesianState, centralBodyGravitationalParameter_ ),
+                        timeToDeepSpaceManeuver, centralBodyGravitationalParameter_, workspace.keplerRootFinder ),
+                    centralBodyGravitationalParameter_ );
+
+        // Solve Lambert problem from deep space maneuver to next body.
+        solveLambertProblemIzzo( cartesianState.segment( 0, 3 ), workspace.bodyStates.block( 0, i + 1, 3, 1 ),
+                                 timeOfFlight - timeToDeepSpaceManeuver, centralBodyGravitationalParameter_,
+                                 departureVelocity, arrivalVelocity );
+
+        workspace.deepSpaceManeuverEpochs( i ) = workspace.bodyEpochs( i ) + timeToDeepSpaceManeuver;
+        workspace.deepSpaceManeuverDeltaVs( i ) = ( departureVelocity - cartesianState.segment( 3, 3 ) ).norm( );
+        workspace.legArrivalVelocities.col( i ) = arrivalVelocity;
+    }
+
+    // Compute delta V at arrival.
+    workspace.bodyDeltaVs( numberOfBodies_ - 1 ) = computeArrivalDeltaV(
+                ( workspace.legArrivalVelocities.col( numberOfBodies_ - 2 ) -
+                  workspace.bodyStates.block( 3, numberOfBodies_ - 1, 3, 1 ) ).norm( ) );
+
+    return workspace.bodyDeltaVs.sum( ) + workspace.deepSpaceManeuverDeltaVs.sum( );
+}
+
+} // namespace mission_segments
+} // namespace tudat
@@ -0,0 +1,384 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Izzo, D. Global Optimization and Space Pruning for Spacecraft Trajectory Design, in: Spacecraft
+ *          Trajectory Optimization, Conway, B.A. (ed.), Cambridge University Press, pp. 178-201, 2010.
+ *      Vinko, T., Izzo, D. and C. Bombardelli. Benchmarking different global optimisation techniques
+ *          for preliminary space trajectory design, 58th International Astronautical Congress,
+ *          IAC-07-A1.3.01, 2007.
+ */
+
+#ifndef TUDAT_MULTIPLE_GRAVITY_ASSIST_TRAJECTORY_H
+#define TUDAT_MULTIPLE_GRAVITY_ASSIST_TRAJECTORY_H
+
+#include <utility>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/MissionSegments/ephemerisTable.h"
+#include "Tudat/Basics/basicTypedefs.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "Tudat/Mathematics/RootFinders/rootFinder.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Workspace for the evaluation of a multiple gravity assist trajectory.
+/*!
+ *  Workspace for the evaluation of a multiple gravity assist trajectory, containing all memory (and root finders) that
+ *  is required to evaluate a trajectory, which is allocated once upon creation. After an evaluation, the workspace
+ *  contains the details of the evaluated trajectory. A workspace may only be used by a single thread at a time.
+ */
+class MultipleGravityAssistWorkspace
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor, allocates all memory for a trajectory with the given number of bodies.
+     *  \param numberOfBodies Number of bodies in the sequence (including departure and arrival body).
+     */
+    MultipleGravityAssistWorkspace( const int numberOfBodies );
+
+    //! Epochs at which the bodies are visited (departure epoch, swing-by epochs, arrival epoch).
+    Eigen::VectorXd bodyEpochs;
+
+    //! Cartesian states of the bodies at the epochs at which they are visited (one column per body).
+    Eigen::Matrix< double, 6, Eigen::Dynamic > bodyStates;
+
+    //! Velocity of the spacecraft at the start of each leg, after departure or swing-by (one column per leg).
+    Eigen::Matrix3Xd legDepartureVelocities;
+
+    //! Velocity of the spacecraft at the end of each leg, before swing-by or arrival (one column per leg).
+    Eigen::Matrix3Xd legArrivalVelocities;
+
+    //! Epochs of the deep space maneuvers of each leg (NaN if the trajectory model has no deep space maneuvers).
+    Eigen::VectorXd deepSpaceManeuverEpochs;
+
+    //! Delta V of the deep space maneuvers of each leg (zero if the trajectory model has no deep space maneuvers).
+    Eigen::VectorXd deepSpaceManeuverDeltaVs;
+
+    //! Delta V at each body (departure, powered swing-bys and arrival).
+    Eigen::VectorXd bodyDeltaVs;
+
+    //! Decision vector of the individual that is evaluated by evaluatePopulation.
+    Eigen::VectorXd decisionVector;
+
+    //! Root finder used to compute the delta V of powered swing-bys.
+    root_finders::RootFinderPointer gravityAssistRootFinder;
+
+    //! Root finder used to solve Kepler's equation when propagating the trajectory to deep space maneuvers.
+    root_finders::RootFinderPointer keplerRootFinder;
+};
+
+//! Typedef for shared-pointer to MultipleGravityAssistWorkspace object.
+typedef boost::shared_ptr< MultipleGravityAssistWorkspace > MultipleGravityAssistWorkspacePointer;
+
+//! Base class for a multiple gravity assist trajectory model.
+/*!
+ *  Base class for a multiple gravity assist (MGA) trajectory model, in which a spacecraft departs from the first body in
+ *  a sequence, performs swing-bys at all intermediate bodies, and arrives at the last body. The legs between the bodies
+ *  are Keplerian arcs about the central body (Lambert arcs, possibly with a deep space maneuver). A trajectory is
+ *  defined by a decision vector, of which the layout is defined by the derived class, and evaluated to its total
+ *  delta V. All body states are retrieved from precomputed ephemeris tables, and all per-trajectory results are stored in
+ *  a reusable workspace, so that evaluating a trajectory with an existing workspace requires no memory allocation (after
+ *  the first evaluation on a given thread, which creates the reused root functions of the Kepler propagation and
+ *  swing-by functions), which makes this class suited for use in global optimization. The (const) evaluation functions
+ *  are safe to call concurrently with different workspaces.
+ *
+ *  The delta V at departure is the escape delta V from a parking orbit about the departure body if a parking orbit is
+ *  provided, and the magnitude of the excess velocity otherwise; the delta V at arrival is defined likewise.
+ */
+class MultipleGravityAssistTrajectory
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param bodyEphemerisTables Ephemeris tables of the bodies in the sequence (departure body, swing-by bodies, and
+     *  arrival body), w.r.t. the central body.
+     *  \param bodyGravitationalParameters Gravitational parameters of the bodies in the sequence.
+     *  \param minimumPericenterRadii Minimum pericenter radii of swing-bys at the bodies in the sequence (values for the
+     *  departure and arrival body are not used).
+     *  \param centralBodyGravitationalParameter Gravitational parameter of the central body.
+     *  \param departureParkingOrbit Semi-major axis and eccentricity of the parking orbit about the departure body (NaN
+     *  semi-major axis if the excess velocity is to be used as departure delta V).
+     *  \param arrivalCaptureOrbit Semi-major axis and eccentricity of the capture orbit about the arrival body (NaN
+     *  semi-major axis if the excess velocity is to be used as arrival delta V).
+     */
+    MultipleGravityAssistTrajectory(
+            const std::vector< EphemerisTablePointer >& bodyEphemerisTables,
+            const std::vector< double >& bodyGravitationalParameters,
+            const std::vector< double >& minimumPericenterRadii,
+            const double centralBodyGravitationalParameter,
+            const std::pair< double, double >& departureParkingOrbit = std::make_pair( TUDAT_NAN, 0.0 ),
+            const std::pair< double, double >& arrivalCaptureOrbit = std::make_pair( TUDAT_NAN, 0.0 ) );
+
+    //! Destructor
+    virtual ~MultipleGravityAssistTrajectory( ){ }
+
+    //! Function to retrieve the size of the decision vector.
+    /*!
+     *  Function to retrieve the size of the decision vector of this trajectory model.
+     *  \return Size of the decision vector.
+     */
+    virtual int getDecisionVectorSize( ) const = 0;
+
+    //! Function to evaluate a trajectory.
+    /*!
+     *  Function to evaluate the trajectory defined by a decision vector, using the memory of a workspace. After
+     *  evaluation, the workspace contains the details of the trajectory.
+     *  \param decisionVector Decision vector defining the trajectory.
+     *  \param workspace Workspace created by createWorkspace of this object (modified by this function).
+     *  \return Total delta V of the trajectory.
+     */
+    virtual double evaluate( const Eigen::VectorXd& decisionVector, MultipleGravityAssistWorkspace& workspace ) const = 0;
+
+    //! Function to evaluate a trajectory.
+    /*!
+     *  Function to evaluate the trajectory defined by a decision vector, using a newly created workspace. For repeated
+     *  evaluations, the overload taking a workspace, or evaluatePopulation, should be used.
+     *  \param decisionVector Decision vector defining the trajectory.
+     *  \return Total delta V of the trajectory.
+     */
+    double evaluate( const Eigen::VectorXd& decisionVector ) const
+    {
+        return evaluate( decisionVector, *createWorkspace( ) );
+    }
+
+    //! Function to evaluate a population of trajectories.
+    /*!
+     *  Function to evaluate a population of trajectories, distributed over a number of threads, using one (reused)
+     *  workspace per thread. If the evaluation of an individual fails (e.g. due to non-convergence of a Lambert
+     *  targeter), its delta V is set to NaN. The results are independent of the number of threads.
+     *  \param decisionVectors Decision vectors of the population (one column per individual).
+     *  \param totalDeltaVs Total delta V of each individual (returned by reference).
+     *  \param numberOfThreads Number of threads that is to be used.
+     */
+    void evaluatePopulation( const Eigen::MatrixXd& decisionVectors, Eigen::VectorXd& totalDeltaVs,
+                             const unsigned int numberOfThreads = 1 );
+
+    //! Function to create a workspace for the evaluation of a trajectory.
+    /*!
+     *  Function to create a workspace for the evaluation of a trajectory of this model.
+     *  \return Workspace for the evaluation of a trajectory.
+     */
+    MultipleGravityAssistWorkspacePointer createWorkspace( ) const
+    {
+        return boost::make_shared< MultipleGravityAssistWorkspace >( numberOfBodies_ );
+    }
+
+    //! Function to retrieve the number of bodies in the sequence.
+    /*!
+     *  Function to retrieve the number of bodies in the sequence (including departure and arrival body).
+     *  \return Number of bodies in the sequence.
+     */
+    int getNumberOfBodies( ) const
+    {
+        return numberOfBodies_;
+    }
+
+protected:
+
+    //! Function to check the size of a decision vector.
+    /*!
+     *  Function to check the size of a decision vector, throws an exception if it is not equal to the decision vector
+     *  size of this model.
+     *  \param decisionVector Decision vector that is to be checked.
+     */
+    void checkDecisionVectorSize( const Eigen::VectorXd& decisionVector ) const;
+
+    //! Function to retrieve the states of all bodies at the epochs in the workspace.
+    /*!
+     *  Function to retrieve the states of all bodies at the epochs at which they are visited, from the epochs in the
+     *  workspace, and to store them in the workspace.
+     *  \param workspace Workspace in which the body epochs have been set (modified by this function).
+     */
+    void setBodyStates( MultipleGravityAssistWorkspace& workspace ) const;
+
+    //! Function to compute the delta V at departure.
+    /*!
+     *  Function to compute the delta V at departure, from the magnitude of the excess velocity.
+     *  \param excessVelocity Magnitude of the excess velocity w.r.t. the departure body.
+     *  \return Delta V at departure.
+     */
+    double computeDepartureDeltaV( const double excessVelocity ) const;
+
+    //! Function to compute the delta V at arrival.
+    /*!
+     *  Function to compute the delta V at arrival, from the magnitude of the excess velocity.
+     *  \param excessVelocity Magnitude of the excess velocity w.r.t. the arrival body.
+     *  \return Delta V at arrival.
+     */
+    double computeArrivalDeltaV( const double excessVelocity ) const;
+
+    //! Number of bodies in the sequence.
+    int numberOfBodies_;
+
+    //! Ephemeris tables of the bodies in the sequence.
+    std::vector< EphemerisTablePointer > bodyEphemerisTables_;
+
+    //! Gravitational parameters of the bodies in the sequence.
+    std::vector< double > bodyGravitationalParameters_;
+
+    //! Minimum pericenter radii of swing-bys at the bodies in the sequence.
+    std::vector< double > minimumPericenterRadii_;
+
+    //! Gravitational parameter of the central body.
+    double centralBodyGravitationalParameter_;
+
+    //! Semi-major axis and eccentricity of the parking orbit about the departure body.
+    std::pair< double, double > departureParkingOrbit_;
+
+    //! Semi-major axis and eccentricity of the capture orbit about the arrival body.
+    std::pair< double, double > arrivalCaptureOrbit_;
+
+    //! Workspaces used by evaluatePopulation (one per thread).
+    std::vector< MultipleGravityAssistWorkspacePointer > populationWorkspaces_;
+};
+
+//! Typedef for shared-pointer to MultipleGravityAssistTrajectory object.
+typedef boost::shared_ptr< MultipleGravityAssistTrajectory > MultipleGravityAssistTrajectoryPointer;
+
+//! Multiple gravity assist trajectory model with powered swing-bys (MGA).
+/*!
+ *  Multiple gravity assist trajectory model in which each leg is a (zero-revolution, prograde) Lambert arc, and the
+ *  incoming and outgoing velocities at each swing-by are patched by a powered swing-by, of which the delta V is
+ *  computed by the gravityAssist function. The decision vector is:
+ *  [ departure epoch, time of flight of leg 1, ..., time of flight of leg N - 1 ], with N the number of bodies.
+ */
+class MultipleGravityAssistPoweredSwingByTrajectory: public MultipleGravityAssistTrajectory
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param bodyEphemerisTables Ephemeris tables of the bodies in the sequence (departure body, swing-by bodies, and
+     *  arrival body), w.r.t. the central body.
+     *  \param bodyGravitationalParameters Gravitational parameters of the bodies in the sequence.
+     *  \param minimumPericenterRadii Minimum pericenter radii of swing-bys at the bodies in the sequence (values for the
+     *  departure and arrival body are not used).
+     *  \param centralBodyGravitationalParameter Gravitational parameter of the central body.
+     *  \param departureParkingOrbit Semi-major axis and eccentricity of the parking orbit about the departure body (NaN
+     *  semi-major axis if the excess velocity is to be used as departure delta V).
+     *  \param arrivalCaptureOrbit Semi-major axis and eccentricity of the capture orbit about the arrival body (NaN
+     *  semi-major axis if the excess velocity is to be used as arrival delta V).
+     */
+    MultipleGravityAssistPoweredSwingByTrajectory(
+            const std::vector< EphemerisTablePointer >& bodyEphemerisTables,
+            const std::vector< double >& bodyGravitationalParameters,
+            const std::vector< double >& minimumPericenterRadii,
+            const double centralBodyGravitationalParameter,
+            const std::pair< double, double >& departureParkingOrbit = std::make_pair( TUDAT_NAN, 0.0 ),
+            const std::pair< double, double >& arrivalCaptureOrbit = std::make_pair( TUDAT_NAN, 0.0 ) ):
+        MultipleGravityAssistTrajectory( bodyEphemerisTables, bodyGravitationalParameters, minimumPericenterRadii,
+                                         centralBodyGravitationalParameter, departureParkingOrbit,
+                                         arrivalCaptureOrbit ){ }
+
+    //! Function to retrieve the size of the decision vector.
+    /*!
+     *  Function to retrieve the size of the decision vector of this trajectory model (equal to the number of bodies).
+     *  \return Size of the decision vector.
+     */
+    int getDecisionVectorSize( ) const
+    {
+        return numberOfBodies_;
+    }
+
+    using MultipleGravityAssistTrajectory::evaluate;
+
+    //! Function to evaluate a trajectory.
+    /*!
+     *  Function to evaluate the trajectory defined by a decision vector, using the memory of a workspace. After
+     *  evaluation, the workspace contains the details of the trajectory.
+     *  \param decisionVector Decision vector defining the trajectory.
+     *  \param workspace Workspace created by createWorkspace of this object (modified by this function).
+     *  \return Total delta V of the trajectory.
+     */
+    double evaluate( const Eigen::VectorXd& decisionVector, MultipleGravityAssistWorkspace& workspace ) const;
+};
+
+//! Multiple gravity assist trajectory model with one deep space maneuver per leg (MGA-1DSM).
+/*!
+ *  Multiple gravity assist trajectory model in which each leg consists of a Keplerian arc, a deep space maneuver, and a
+ *  (zero-revolution, prograde) Lambert arc to the next body, and the swing-bys are unpowered (velocity formulation of
+ *  Vinko et al., 2007). The decision vector is:
+ *  [ departure epoch, departure excess velocity, u, v, eta_1, time of flight of leg 1,
+ *    rotation angle_2, pericenter radius ratio_2, eta_2, time of flight of leg 2, ... ],
+ *  with 4 entries per leg after the first leg. The direction of the departure excess velocity is given by the in-plane
+ *  angle 2 pi u and the out-of-plane angle acos( 2 v - 1 ) - pi / 2 (with u and v in [0, 1]), w.r.t. the frame of the
+ *  ephemeris tables. The deep space maneuver of leg i is performed at the fraction eta_i of the time of flight of the
+ *  leg, and the pericenter radius of each swing-by is given as a multiple of the minimum pericenter radius.
+ */
+class MultipleGravityAssistDeepSpaceManeuverTrajectory: public MultipleGravityAssistTrajectory
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param bodyEphemerisTables Ephemeris tables of the bodies in the sequence (departure body, swing-by bodies, and
+     *  arrival body), w.r.t. the central body.
+     *  \param bodyGravitationalParameters Gravitational parameters of the bodies in the sequence.
+     *  \param minimumPericenterRadii Minimum pericenter radii of swing-bys at the bodies in the sequence (values for the
+     *  departure and arrival body are not used).
+     *  \param centralBodyGravitationalParameter Gravitational parameter of the central body.
+     *  \param departureParkingOrbit Semi-major axis and eccentricity of the parking orbit about the departure body (NaN
+     *  semi-major axis if the excess velocity is to be used as departure delta V).
+     *  \param arrivalCaptureOrbit Semi-major axis and eccentricity of the capture orbit about the arrival body (NaN
+     *  semi-major axis if the excess velocity is to be used as arrival delta V).
+     */
+    MultipleGravityAssistDeepSpaceManeuverTrajectory(
+            const std::vector< EphemerisTablePointer >& bodyEphemerisTables,
+            const std::vector< double >& bodyGravitationalParameters,
+            const std::vector< double >& minimumPericenterRadii,
+            const double centralBodyGravitationalParameter,
+            const std::pair< double, double >& departureParkingOrbit = std::make_pair( TUDAT_NAN, 0.0 ),
+            const std::pair< double, double >& arrivalCaptureOrbit = std::make_pair( TUDAT_NAN, 0.0 ) ):
+        MultipleGravityAssistTrajectory( bodyEphemerisTables, bodyGravitationalParameters, minimumPericenterRadii,
+                                         centralBodyGravitationalParameter, departureParkingOrbit,
+                                         arrivalCaptureOrbit ){ }
+
+    //! Function to retrieve the size of the decision vector.
+    /*!
+     *  Function to retrieve the size of the decision vector of this trajectory model (4 N - 2, with N the number of
+     *  bodies).
+     *  \return Size of the decision vector.
+     */
+    int getDecisionVectorSize( ) const
+    {
+        return 4 * numberOfBodies_ - 2;
+    }
+
+    using MultipleGravityAssistTrajectory::evaluate;
+
+    //! Function to evaluate a trajectory.
+    /*!
+     *  Function to evaluate the trajectory defined by a decision vector, using the memory of a workspace. After
+     *  evaluation, the workspace contains the details of the trajectory.
+     *  \param decisionVector Decision vector defining the trajectory.
+     *  \param workspace Workspace created by createWorkspace of this object (modified by this function).
+     *  \return Total delta V of the trajectory.
+     */
+    double evaluate( const Eigen::VectorXd& decisionVector, MultipleGravityAssistWorkspace& workspace ) const;
+};
+
+} // namespace mission_segments
+} // namespace tudat
+
+#endif // TUDAT_MULTIPLE_GRAVITY_ASSIST_TRAJECTORY_H
@@ -0,0 +1,548 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Petropoulos, A.E. and J.M. Longuski. Shape-Based Algorithm for Automated Design of Low-Thrust,
+ *          Gravity-Assist Trajectories, Journal of Spacecraft and Rockets 41(5), pp. 787-796, 2004.
+ *      Izzo, D. Lambert's Problem for Exponential Sinusoids, Journal of Guidance, Control, and Dynamics
+ *          29(5), pp. 1242-1245, 2006.
+ *      Wall, B.J., Pols, B. and B. Lanktree. Shape-Based Approximation Method for Low-Thrust
+ *          Interception and Rendezvous Trajectory Design, Advances in the Astronautical Sciences
+ *          136(2), pp. 1447-1458, 2010.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/make_shared.hpp>
+
+#include <Eigen/LU>
+
+#include "Tudat/Astrodynamics/MissionSegments/shapeBasedLowThrustTrajectory.h"
+#include "Tudat/Basics/parallelization.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "Tudat/Mathematics/NumericalQuadrature/gaussianQuadrature.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Compute the quadrature of a function of the azimuthal angle.
+template< typename IntegrandType >
+double ShapeBasedLowThrustTrajectory::computeQuadrature(
+        const IntegrandType& integrand, const double lowerBound, const double upperBound ) const
+{
+    const int numberOfSegments = std::max(
+                1, static_cast< int >( std::ceil( static_cast< double >( numberOfQuadratureSegmentsPerRevolution_ ) *
+                                                  std::fabs( upperBound - lowerBound ) /
+                                                  ( 2.0 * mathematical_constants::PI ) ) ) );
+    return numerical_quadrature::performGaussLegendreQuadrature( integrand, lowerBound, upperBound, numberOfSegments );
+}
+
+//! Compute the radial distance.
+double ShapeBasedLowThrustTrajectory::computeRadialDistance( const double azimuthalAngle ) const
+{
+    double inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative;
+    computeInverseRadialDistanceAndDerivatives(
+                azimuthalAngle, inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative );
+    return 1.0 / inverseRadialDistance;
+}
+
+//! Compute the flight path angle.
+double ShapeBasedLowThrustTrajectory::computeFlightPathAngle( const double azimuthalAngle ) const
+{
+    double inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative;
+    computeInverseRadialDistanceAndDerivatives(
+                azimuthalAngle, inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative );
+    return std::atan( -firstDerivative / inverseRadialDistance );
+}
+
+//! Compute the time derivative of the azimuthal angle.
+double ShapeBasedLowThrustTrajectory::computeAzimuthalAngleRate( const double azimuthalAngle ) const
+{
+    return 1.0 / computeTimeOfFlightDerivative( azimuthalAngle );
+}
+
+//! Compute the magnitude of the thrust acceleration.
+double ShapeBasedLowThrustTrajectory::computeThrustAcceleration( const double azimuthalAngle ) const
+{
+    double inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative;
+    computeInverseRadialDistanceAndDerivatives(
+                azimuthalAngle, inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative );
+
+    const double tangentOfFlightPathAngle = -firstDerivative / inverseRadialDistance;
+    const double shapeDenominator = inverseRadialDistance + secondDerivative;
+
+    return -centralBodyGravitationalParameter_ * inverseRadialDistance * inverseRadialDistance *
+            inverseRadialDistance * ( firstDerivative + thirdDerivative ) *
+            std::sqrt( 1.0 + tangentOfFlightPathAngle * tangentOfFlightPathAngle ) /
+            ( 2.0 * shapeDenominator * shapeDenominator );
+}
+
+//! Compute the time of flight from the departure position to a given azimuthal angle.
+double ShapeBasedLowThrustTrajectory::computeTimeOfFlight( const double azimuthalAngle ) const
+{
+    return computeQuadrature( [ this ]( const double currentAngle )
+    { return computeTimeOfFlightDerivative( currentAngle ); }, 0.0, azimuthalAngle );
+}
+
+//! Compute the delta V of the complete transfer.
+double ShapeBasedLowThrustTrajectory::computeDeltaV( ) const
+{
+    return computeQuadrature( [ this ]( const double currentAngle )
+    { return computeDeltaVDerivative( currentAngle ); }, 0.0, transferAngle_ );
+}
+
+//! Compute the Cartesian state at a given azimuthal angle.
+Eigen::Vector6d ShapeBasedLowThrustTrajectory::computeCartesianState( const double azimuthalAngle ) const
+{
+    double inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative;
+    computeInverseRadialDistanceAndDerivatives(
+                azimuthalAngle, inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative );
+
+    // Compute polar position and velocity.
+    const double radialDistance = 1.0 / inverseRadialDistance;
+    const double azimuthalVelocity = radialDistance * computeAzimuthalAngleRate( azimuthalAngle );
+    const double radialVelocity = -firstDerivative * radialDistance * azimuthalVelocity;
+
+    // Convert to Cartesian state.
+    const double angleFromXAxis = departureAzimuthalAngle_ + azimuthalAngle;
+    const double cosineOfAngle = std::cos( angleFromXAxis );
+    const double sineOfAngle = std::sin( angleFromXAxis );
+
+    Eigen::Vector6d cartesianState;
+    cartesianState << radialDistance * cosineOfAngle, radialDistance * sineOfAngle, 0.0,
+            radialVelocity * cosineOfAngle - azimuthalVelocity * sineOfAngle,
+            radialVelocity * sineOfAngle + azimuthalVelocity * cosineOfAngle, 0.0;
+    return cartesianState;
+}
+
+//! Compute the thrust acceleration profile of the transfer.
+std::map< double, Eigen::Vector3d > ShapeBasedLowThrustTrajectory::computeThrustAccelerationProfile(
+        const int numberOfPoints ) const
+{
+    if( numberOfPoints < 2 )
+    {
+        throw std::runtime_error( "Error when computing shape-based thrust profile, at least 2 points are required" );
+    }
+
+    std::map< double, Eigen::Vector3d > thrustAccelerationProfile;
+    double currentTime = 0.0;
+    double previousAngle = 0.0;
+    for( int i = 0; i < numberOfPoints; i++ )
+    {
+        const double currentAngle = transferAngle_ * static_cast< double >( i ) /
+                static_cast< double >( numberOfPoints - 1 );
+
+        // Update time since departure.
+        if( i > 0 )
+        {
+            currentTime += computeQuadrature( [ this ]( const double angle )
+            { return computeTimeOfFlightDerivative( angle ); }, previousAngle, currentAngle );
+        }
+
+        // Compute thrust acceleration along velocity.
+        const Eigen::Vector3d velocity = computeCartesianState( currentAngle ).segment( 3, 3 );
+        thrustAccelerationProfile[ currentTime ] = computeThrustAcceleration( currentAngle ) * velocity.normalized( );
+
+        previousAngle = currentAngle;
+    }
+
+    return thrustAccelerationProfile;
+}
+
+//! Compute the time derivative of the time of flight w.r.t. the azimuthal angle.
+double ShapeBasedLowThrustTrajectory::computeTimeOfFlightDerivative( const double azimuthalAngle ) const
+{
+    double inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative;
+    computeInverseRadialDistanceAndDerivatives(
+                azimuthalAngle, inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative );
+
+    const double shapeDenominator = inverseRadialDistance + secondDerivative;
+    if( !( shapeDenominator > 0.0 ) || !( inverseRadialDistance > 0.0 ) )
+    {
+        return TUDAT_NAN;
+    }
+
+    return std::sqrt( shapeDenominator / centralBodyGravitationalParameter_ ) /
+            ( inverseRadialDistance * inverseRadialDistance );
+}
+
+//! Compute the derivative of the delta V w.r.t. the azimuthal angle.
+double ShapeBasedLowThrustTrajectory::computeDeltaVDerivative( const double azimuthalAngle ) const
+{
+    double inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative;
+    computeInverseRadialDistanceAndDerivatives(
+                azimuthalAngle, inverseRadialDistance, firstDerivative, secondDerivative, thirdDerivative );
+
+    const double shapeDenominator = inverseRadialDistance + secondDerivative;
+    if( !( shapeDenominator > 0.0 ) || !( inverseRadialDistance > 0.0 ) )
+    {
+        return TUDAT_NAN;
+    }
+
+    // Product of thrust acceleration and derivative of time w.r.t. azimuthal angle.
+    const double tangentOfFlightPathAngle = -firstDerivative / inverseRadialDistance;
+    return std::sqrt( centralBodyGravitationalParameter_ ) * inverseRadialDistance *
+            std::fabs( firstDerivative + thirdDerivative ) *
+            std::sqrt( 1.0 + tangentOfFlightPathAngle * tangentOfFlightPathAngle ) /
+            ( 2.0 * shapeDenominator * std::sqrt( shapeDenominator ) );
+}
+
+//! Set the departure and arrival polar coordinates from Cartesian states.
+void ShapeBasedLowThrustTrajectory::setBoundaryConditions(
+        const Eigen::Vector6d& departureState, const Eigen::Vector6d& arrivalState, const int numberOfRevolutions )
+{
+    if( numberOfRevolutions < 0 )
+    {
+        throw std::runtime_error( "Error when creating shape-based trajectory, number of revolutions is negative" );
+    }
+
+    // Convert (projected) Cartesian states to polar coordinates.
+    for( unsigned int i = 0; i < 2; i++ )
+    {
+        const Eigen::Vector6d& cartesianState = ( i == 0 ) ? departureState : arrivalState;
+        Eigen::Vector4d& polarState = ( i == 0 ) ? departurePolarState_ : arrivalPolarState_;
+
+        polarState( 0 ) = std::sqrt( cartesianState( 0 ) * cartesianState( 0 ) +
+                                     cartesianState( 1 ) * cartesianState( 1 ) );
+        polarState( 1 ) = std::atan2( cartesianState( 1 ), cartesianState( 0 ) );
+        polarState( 2 ) = ( cartesianState( 0 ) * cartesianState( 3 ) + cartesianState( 1 ) * cartesianState( 4 ) ) /
+                polarState( 0 );
+        polarState( 3 ) = ( cartesianState( 0 ) * cartesianState( 4 ) - cartesianState( 1 ) * cartesianState( 3 ) ) /
+                polarState( 0 );
+    }
+
+    // Set transfer angle in [0, 2 pi), plus full revolutions.
+    departureAzimuthalAngle_ = departurePolarState_( 1 );
+    transferAngle_ = arrivalPolarState_( 1 ) - departurePolarState_( 1 );
+    if( transferAngle_ < 0.0 )
+    {
+        transferAngle_ += 2.0 * mathematical_constants::PI;
+    }
+    transferAngle_ += 2.0 * mathematical_constants::PI * static_cast< double >( numberOfRevolutions );
+}
+
+//! Constructor for exponential sinusoid trajectory.
+ExponentialSinusoidTrajectory::ExponentialSinusoidTrajectory(
+        const Eigen::Vector6d& departureState, const Eigen::Vector6d& arrivalState,
+        const double timeOfFlight, const double centralBodyGravitationalParameter,
+        const double windingParameter, const int numberOfRevolutions,
+        const int numberOfQuadratureSegmentsPerRevolution ):
+    ShapeBasedLowThrustTrajectory( centralBodyGravitationalParameter, numberOfQuadratureSegmentsPerRevolution ),
+    scalingParameter_( TUDAT_NAN ), dynamicRangeParameter_( TUDAT_NAN ), windingParameter_( windingParameter ),
+    phaseParameter_( TUDAT_NAN )
+{
+    setBoundaryConditions( departureState, arrivalState, numberOfRevolutions );
+
+    // Compute range of initial flight path angles for which |k1 k2^2| < 1 (Izzo, 2006).
+    const double logarithmOfRadiusRatio = std::log( departurePolarState_( 0 ) / arrivalPolarState_( 0 ) );
+    const double oneMinusCosine = 1.0 - std::cos( windingParameter_ * transferAngle_ );
+    const double discriminant = 2.0 * oneMinusCosine / std::pow( windingParameter_, 4 ) -
+            logarithmOfRadiusRatio * logarithmOfRadiusRatio;
+    if( !( oneMinusCosine > 1.0E-12 ) || !( discriminant > 0.0 ) )
+    {
+        return;
+    }
+
+    const double centralTangent = -0.5 * windingParameter_ * logarithmOfRadiusRatio *
+            std::sin( windingParameter_ * transferAngle_ ) / oneMinusCosine;
+    const double tangentHalfRange = ( 1.0 - 1.0E-9 ) * 0.5 * windingParameter_ * std::sqrt( discriminant );
+
+    // Solve initial flight path angle for time of flight (Illinois variant of regula falsi).
+    double lowerTangent = centralTangent - tangentHalfRange;
+    double upperTangent = centralTangent + tangentHalfRange;
+    setShapeParameters( lowerTangent );
+    double lowerError = computeTimeOfFlight( ) - timeOfFlight;
+    setShapeParameters( upperTangent );
+    double upperError = computeTimeOfFlight( ) - timeOfFlight;
+    if( !( lowerError * upperError <= 0.0 ) )
+    {
+        return;
+    }
+
+    int previousSide = 0;
+    for( int i = 0; i < 100; i++ )
+    {
+        const double currentTangent = ( lowerTangent * upperError - upperTangent * lowerError ) /
+                ( upperError - lowerError );
+        setShapeParameters( currentTangent );
+        const double currentError = computeTimeOfFlight( ) - timeOfFlight;
+
+        if( !( currentError == currentError ) )
+        {
+            return;
+        }
+        else if( std::fabs( currentError ) <= 1.0E-10 * timeOfFlight ||
+                 std::fabs( upperTangent - lowerTangent ) <= 1.0E-15 * ( 1.0 + std::fabs( currentTangent ) ) )
+        {
+            isTrajectoryFeasible_ = true;
+            return;
+        }
+        else if( currentError * lowerError > 0.0 )
+        {
+            lowerTangent = currentTangent;
+            lowerError = currentError;
+            if( previousSide == -1 )
+            {
+                upperError *= 0.5;
+            }
+            previousSide = -1;
+        }
+        else
+        {
+            upperTangent = currentTangent;
+            upperError = currentError;
+            if( previousSide == 1 )
+            {
+                lowerError *= 0.5;
+            }
+            previousSide = 1;
+        }
+    }
+}
+
+//! Compute the inverse of the radial distance, and its first three derivatives.
+void ExponentialSinusoidTrajectory::computeInverseRadialDistanceAndDerivatives(
+        const double azimuthalAngle, double& inverseRadialDistance, double& firstDerivative,
+        double& secondDerivative, double& thirdDerivative ) const
+{
+    // Write u = exp( g ) / k0, with g = -k1 sin( k2 theta + phi ).
+    const double sineOfArgument = std::sin( windingParameter_ * azimuthalAngle + phaseParameter_ );
+    const double cosineOfArgument = std::cos( windingParameter_ * azimuthalAngle + phaseParameter_ );
+
+    const double exponentFirstDerivative = -dynamicRangeParameter_ * windingParameter_ * cosineOfArgument;
+    const double exponentSecondDerivative =
+            dynamicRangeParameter_ * windingParameter_ * windingParameter_ * sineOfArgument;
+    const double exponentThirdDerivative =
+            dynamicRangeParameter_ * windingParameter_ * windingParameter_ * windingParameter_ * cosineOfArgument;
+
+    inverseRadialDistance = std::exp( -dynamicRangeParameter_ * sineOfArgument ) / scalingParameter_;
+    firstDerivative = exponentFirstDerivative * inverseRadialDistance;
+    secondDerivative = ( exponentSecondDerivative + exponentFirstDerivative * exponentFirstDerivative ) *
+            inverseRadialDistance;
+    thirdDerivative = ( exponentThirdDerivative + 3.0 * exponentFirstDerivative * exponentSecondDerivative +
+                        exponentFirstDerivative * exponentFirstDerivative * exponentFirstDerivative ) *
+            inverseRadialDistance;
+}
+
+//! Set the shape parameters for a given tangent of the initial flight path angle.
+void ExponentialSinusoidTrajectory::setShapeParameters( const double tangentOfInitialFlightPathAngle )
+{
+    // Compute k1 sin( phi ) and k1 cos( phi ) from boundary conditions (Izzo, 2006).
+    const double sineComponent =
+            ( std::log( departurePolarState_( 0 ) / arrivalPolarState_( 0 ) ) +
+              tangentOfInitialFlightPathAngle * std::sin( windingParameter_ * transferAngle_ ) / windingParameter_ ) /
+            ( 1.0 - std::cos( windingParameter_ * transferAngle_ ) );
+    const double cosineComponent = tangentOfInitialFlightPathAngle / windingParameter_;
+
+    dynamicRangeParameter_ = std::sqrt( sineComponent * sineComponent + cosineComponent * cosineComponent );
+    phaseParameter_ = std::atan2( sineComponent, cosineComponent );
+    scalingParameter_ = departurePolarState_( 0 ) * std::exp( -sineComponent );
+}
+
+//! Constructor for inverse polynomial trajectory.
+InversePolynomialTrajectory::InversePolynomialTrajectory(
+        const Eigen::Vector6d& departureState, const Eigen::Vector6d& arrivalState,
+        const double timeOfFlight, const double centralBodyGravitationalParameter,
+        const int numberOfRevolutions, const int numberOfQuadratureSegmentsPerRevolution ):
+    ShapeBasedLowThrustTrajectory( centralBodyGravitationalParameter, numberOfQuadratureSegmentsPerRevolution ),
+    timeDependentParameter_( TUDAT_NAN )
+{
+    setBoundaryConditions( departureState, arrivalState, numberOfRevolutions );
+
+    // Compute required values of u, u' and u'' at departure and arrival, using the relation between u + u'' and the
+    // time derivative of the azimuthal angle.
+    Eigen::Vector3d departureInverseRadialDistanceAndDerivatives;
+    for( unsigned int i = 0; i < 2; i++ )
+    {
+        const Eigen::Vector4d& polarState = ( i == 0 ) ? departurePolarState_ : arrivalPolarState_;
+        Eigen::Vector3d& inverseRadialDistanceAndDerivatives =
+                ( i == 0 ) ? departureInverseRadialDistanceAndDerivatives : arrivalInverseRadialDistanceAndDerivatives_;
+
+        const double azimuthalAngleRate = polarState( 3 ) / polarState( 0 );
+        inverseRadialDistanceAndDerivatives( 0 ) = 1.0 / polarState( 0 );
+        inverseRadialDistanceAndDerivatives( 1 ) = -polarState( 2 ) / ( polarState( 3 ) * polarState( 0 ) );
+        inverseRadialDistanceAndDerivatives( 2 ) = centralBodyGravitationalParameter_ /
+                ( std::pow( polarState( 0 ), 4 ) * azimuthalAngleRate * azimuthalAngleRate ) - 1.0 / polarState( 0 );
+    }
+
+    // Compute parameters a, b and c from departure conditions.
+    const double cosineComponent = -departureInverseRadialDistanceAndDerivatives( 2 );
+    const double sineComponent = -departureInverseRadialDistanceAndDerivatives( 1 );
+    boundaryParameters_.first( 0 ) = departureInverseRadialDistanceAndDerivatives( 0 ) - cosineComponent;
+    boundaryParameters_.first( 1 ) = std::sqrt( cosineComponent * cosineComponent + sineComponent * sineComponent );
+    boundaryParameters_.first( 2 ) = std::atan2( sineComponent, cosineComponent );
+
+    // Compute matrix relating e, f and g to their contribution to u, u' and u'' at arrival.
+    const double finalAngle = transferAngle_;
+    Eigen::Matrix3d finalBoundaryMatrix;
+    finalBoundaryMatrix << std::pow( finalAngle, 4 ), std::pow( finalAngle, 5 ), std::pow( finalAngle, 6 ),
+            4.0 * std::pow( finalAngle, 3 ), 5.0 * std::pow( finalAngle, 4 ), 6.0 * std::pow( finalAngle, 5 ),
+            12.0 * std::pow( finalAngle, 2 ), 20.0 * std::pow( finalAngle, 3 ), 30.0 * std::pow( finalAngle, 4 );
+    inverseFinalBoundaryMatrix_ = finalBoundaryMatrix.inverse( );
+
+    // Solve time-dependent parameter for time of flight (secant method), starting from d = 0.
+    double previousParameter = 0.0;
+    setTimeDependentParameter( previousParameter );
+    double previousError = computeTimeOfFlight( ) - timeOfFlight;
+
+    double currentParameter = 1.0E-3 * departureInverseRadialDistanceAndDerivatives( 0 ) /
+            ( finalAngle * finalAngle * finalAngle );
+    for( int i = 0; i < 50; i++ )
+    {
+        setTimeDependentParameter( currentParameter );
+        const double currentError = computeTimeOfFlight( ) - timeOfFlight;
+
+        if( std::fabs( currentError ) <= 1.0E-10 * timeOfFlight )
+        {
+            isTrajectoryFeasible_ = true;
+            return;
+        }
+
+        double nextParameter;
+        if( !( currentError == currentError ) )
+        {
+            // Shape is invalid (u + u'' <= 0): step back towards the previous parameter.
+            nextParameter = 0.5 * ( currentParameter + previousParameter );
+        }
+        else if( !( previousError == previousError ) || currentError == previousError )
+        {
+            nextParameter = 2.0 * currentParameter - previousParameter;
+            previousParameter = currentParameter;
+            previousError = currentError;
+        }
+        else
+        {
+            nextParameter = currentParameter - currentError * ( currentParameter - previousParameter ) /
+                    ( currentError - previousError );
+            previousParameter = currentParameter;
+            previousError = currentError;
+        }
+        currentParameter = nextParameter;
+    }
+}
+
+//! Compute the inverse of the radial distance, and its first three derivatives.
+void InversePolynomialTrajectory::computeInverseRadialDistanceAndDerivatives(
+        const double azimuthalAngle, double& inverseRadialDistance, double& firstDerivative,
+        double& secondDerivative, double& thirdDerivative ) const
+{
+    const double a = boundaryParameters_.first( 0 );
+    const double b = boundaryParameters_.first( 1 );
+    const double c = boundaryParameters_.first( 2 );
+    const double d = timeDependentParameter_;
+    const double e = boundaryParameters_.second( 0 );
+    const double f = boundaryParameters_.second( 1 );
+    const double g = boundaryParameters_.second( 2 );
+
+    const double theta = azimuthalAngle;
+    const double theta2 = theta * theta;
+    const double theta3 = theta2 * theta;
+    const double bCosine = b * std::cos( theta + c );
+    const double bSine = b * std::sin( theta + c );
+
+    inverseRadialDistance = a + bCosine + theta3 * ( d + theta * ( e + theta * ( f + theta * g ) ) );
+    firstDerivative = -bSine + theta2 * ( 3.0 * d + theta * ( 4.0 * e + theta * ( 5.0 * f + theta * 6.0 * g ) ) );
+    secondDerivative = -bCosine + theta * ( 6.0 * d + theta * ( 12.0 * e + theta * ( 20.0 * f + theta * 30.0 * g ) ) );
+    thirdDerivative = bSine + 6.0 * d + theta * ( 24.0 * e + theta * ( 60.0 * f + theta * 120.0 * g ) );
+}
+
+//! Create the radial distance function of this trajectory.
+ImprovedInversePolynomialWallPointer InversePolynomialTrajectory::createRadialDistanceFunction( ) const
+{
+    const double timeDependentParameter = timeDependentParameter_;
+    const std::pair< Eigen::Vector3d, Eigen::Vector3d > boundaryParameters = boundaryParameters_;
+    return boost::make_shared< ImprovedInversePolynomialWall >(
+                [ timeDependentParameter ]( ){ return timeDependentParameter; },
+                [ boundaryParameters ]( ){ return boundaryParameters; } );
+}
+
+//! Set the time-dependent parameter, and compute the final boundary parameters.
+void InversePolynomialTrajectory::setTimeDependentParameter( const double timeDependentParameter )
+{
+    timeDependentParameter_ = timeDependentParameter;
+
+    // Compute contribution of e, f and g required to satisfy the arrival conditions.
+    const double finalAngle = transferAngle_;
+    const double a = boundaryParameters_.first( 0 );
+    const double b = boundaryParameters_.first( 1 );
+    const double c = boundaryParameters_.first( 2 );
+
+    Eigen::Vector3d requiredContribution;
+    requiredContribution << arrivalInverseRadialDistanceAndDerivatives_( 0 ) - a - b * std::cos( finalAngle + c ) -
+                            timeDependentParameter * finalAngle * finalAngle * finalAngle,
+            arrivalInverseRadialDistanceAndDerivatives_( 1 ) + b * std::sin( finalAngle + c ) -
+            3.0 * timeDependentParameter * finalAngle * finalAngle,
+            arrivalInverseRadialDistanceAndDerivatives_( 2 ) + b * std::cos( finalAngle + c ) -
+            6.0 * timeDependentParameter * finalAngle;
+    boundaryParameters_.second = inverseFinalBoundaryMatrix_ * requiredContribution;
+}
+
+//! Compute the delta V and excess velocities of shape-based transfers for a grid of departure times and times of
+//! flight.
+void computeShapeBasedTransferGrid(
+        const boost::function< ShapeBasedLowThrustTrajectoryPointer(
+            const Eigen::Vector6d&, const Eigen::Vector6d&, const double ) > trajectoryCreationFunction,
+        const boost::function< Eigen::Vector6d( const double ) > departureBodyStateFunction,
+        const boost::function< Eigen::Vector6d( const double ) > arrivalBodyStateFunction,
+        const std::vector< double >& departureTimes,
+        const std::vector< double >& timesOfFlight,
+        Eigen::MatrixXd& deltaVs,
+        Eigen::MatrixXd& departureExcessVelocities,
+        Eigen::MatrixXd& arrivalExcessVelocities,
+        const unsigned int numberOfThreads )
+{
+    const int numberOfDepartureTimes = departureTimes.size( );
+    const int numberOfTimesOfFlight = timesOfFlight.size( );
+
+    // Retrieve all body states (sequentially, since state functions need not be thread-safe).
+    Eigen::Matrix< double, 6, Eigen::Dynamic > departureBodyStates( 6, numberOfDepartureTimes );
+    Eigen::Matrix< double, 6, Eigen::Dynamic > arrivalBodyStates( 6, numberOfDepartureTimes * numberOfTimesOfFlight );
+    for( int i = 0; i < numberOfDepartureTimes; i++ )
+    {
+        departureBodyStates.col( i ) = departureBodyStateFunction( departureTimes.at( i ) );
+        for( int j = 0; j < numberOfTimesOfFlight; j++ )
+        {
+            arrivalBodyStates.col( i * numberOfTimesOfFlight + j ) =
+                    arrivalBodyStateFunction( departureTimes.at( i ) + timesOfFlight.at( j ) );
+        }
+    }
+
+    deltaVs = Eigen::MatrixXd::Constant( numberOfDepartureTimes, numberOfTimesOfFlight, TUDAT_NAN );
+    departureExcessVelocities = deltaVs;
+    arrivalExcessVelocities = deltaVs;
+
+    // Compute transfers concurrently, each writing only to its own grid point.
+    utilities::executeParallelLoop(
+                numberOfDepartureTimes * numberOfTimesOfFlight, [ & ]( const unsigned int gridIndex )
+    {
+        const int i = gridIndex / numberOfTimesOfFlight;
+        const int j = gridIndex % numberOfTimesOfFlight;
+        const Eigen::Vector6d departureBodyState = departureBodyStates.col( i );
+        const Eigen::Vector6d arrivalBodyState = arrivalBodyStates.col( gridIndex );
+
+        ShapeBasedLowThrustTrajectoryPointer trajectory = trajectoryCreationFunction(
+                    departureBodyState, arrivalBodyState, timesOfFlight.at( j ) );
+        if( trajectory->isTrajectoryFeasible( ) )
+        {
+            deltaVs( i, j ) = trajectory->computeDeltaV( );
+            departureExcessVelocities( i, j ) =
+                    ( trajectory->computeCartesianState( 0.0 ) - departureBodyState ).segment( 3, 3 ).norm( );
+            arrivalExcessVelocities( i, j ) =
+                    ( trajectory->computeCartesianState( trajectory->getTransferAngle( ) ) -
+                      arrivalBodyState ).segment( 3, 3 ).norm( );
+        }
+    }, numberOfThreads );
+}
+
+} // namespace mission_segments
+} // namespace tudat
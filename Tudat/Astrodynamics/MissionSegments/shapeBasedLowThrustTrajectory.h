@@ -0,0 +1,474 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Petropoulos, A.E. and J.M. Longuski. Shape-Based Algorithm for Automated Design of Low-Thrust,
+ *          Gravity-Assist Trajectories, Journal of Spacecraft and Rockets 41(5), pp. 787-796, 2004.
+ *      Izzo, D. Lambert's Problem for Exponential Sinusoids, Journal of Guidance, Control, and Dynamics
+ *          29(5), pp. 1242-1245, 2006.
+ *      Wall, B.J., Pols, B. and B. Lanktree. Shape-Based Approximation Method for Low-Thrust
+ *          Interception and Rendezvous Trajectory Design, Advances in the Astronautical Sciences
+ *          136(2), pp. 1447-1458, 2010.
+ *
+ *    Notes
+ *      The shape-based trajectories in this file are planar: the departure and arrival states are projected onto the
+ *      x-y plane of the frame in which they are provided, and the transfer is assumed to be prograde (counter-clockwise
+ *      about the z-axis). Thrust is applied along the velocity vector, as assumed in the derivation of both shapes.
+ */
+
+#ifndef TUDAT_SHAPE_BASED_LOW_THRUST_TRAJECTORY_H
+#define TUDAT_SHAPE_BASED_LOW_THRUST_TRAJECTORY_H
+
+#include <map>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/MissionSegments/improvedInversePolynomialWall.h"
+#include "Tudat/Basics/basicTypedefs.h"
+
+namespace tudat
+{
+namespace mission_segments
+{
+
+//! Base class for a planar, shape-based, low-thrust trajectory.
+/*!
+ *  Base class for a planar, shape-based, low-thrust trajectory, in which the inverse of the radial distance u = 1 / r is
+ *  prescribed as an analytical function of the azimuthal angle theta (measured from the departure position), and the
+ *  thrust acceleration is directed along the velocity vector. Derived classes implement the shape (and the
+ *  computation of its free parameters from the boundary conditions); this base class computes the resulting
+ *  velocity, thrust acceleration, time of flight and delta V. From u and its derivatives w.r.t. theta (denoted by
+ *  primes), the time derivative of theta and the thrust acceleration follow as:
+ *
+ *  \f[
+ *      \dot{\theta}^{2} = \frac{ \mu u^{4} }{ u + u'' }, \qquad
+ *      a_{T} = -\frac{ \mu u^{3} }{ 2 \cos\gamma } \frac{ u' + u''' }{ ( u + u'' )^{2} }
+ *  \f]
+ *
+ *  with \f$ \tan \gamma = -u' / u \f$ the flight path angle. The time of flight and delta V are computed by
+ *  (composite Gauss-Legendre) quadrature over theta, and are undefined (NaN) if u + u'' is not positive along the
+ *  trajectory. All const member functions are safe to call concurrently.
+ */
+class ShapeBasedLowThrustTrajectory
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param centralBodyGravitationalParameter Gravitational parameter of the central body.
+     *  \param numberOfQuadratureSegmentsPerRevolution Number of segments per revolution (2 pi rad of azimuthal angle) of
+     *  the composite Gauss-Legendre quadrature used to compute the time of flight and delta V.
+     */
+    ShapeBasedLowThrustTrajectory( const double centralBodyGravitationalParameter,
+                                   const int numberOfQuadratureSegmentsPerRevolution = 8 ):
+        centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+        numberOfQuadratureSegmentsPerRevolution_( numberOfQuadratureSegmentsPerRevolution ),
+        departureAzimuthalAngle_( 0.0 ), transferAngle_( 0.0 ), isTrajectoryFeasible_( false ){ }
+
+    //! Destructor
+    virtual ~ShapeBasedLowThrustTrajectory( ){ }
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    //! Function to compute the inverse of the radial distance, and its first three derivatives.
+    /*!
+     *  Function to compute the inverse of the radial distance (u = 1 / r), and its first three derivatives w.r.t. the
+     *  azimuthal angle, as defined by the shape of the derived class.
+     *  \param azimuthalAngle Azimuthal angle, measured from the departure position [rad].
+     *  \param inverseRadialDistance Inverse of the radial distance (returned by reference) [1/m].
+     *  \param firstDerivative First derivative of u w.r.t. the azimuthal angle (returned by reference) [1/m].
+     *  \param secondDerivative Second derivative of u w.r.t. the azimuthal angle (returned by reference) [1/m].
+     *  \param thirdDerivative Third derivative of u w.r.t. the azimuthal angle (returned by reference) [1/m].
+     */
+    virtual void computeInverseRadialDistanceAndDerivatives(
+            const double azimuthalAngle, double& inverseRadialDistance, double& firstDerivative,
+            double& secondDerivative, double& thirdDerivative ) const = 0;
+
+    //! Function to compute the radial distance.
+    /*!
+     *  Function to compute the radial distance at a given azimuthal angle.
+     *  \param azimuthalAngle Azimuthal angle, measured from the departure position [rad].
+     *  \return Radial distance [m].
+     */
+    double computeRadialDistance( const double azimuthalAngle ) const;
+
+    //! Function to compute the flight path angle.
+    /*!
+     *  Function to compute the flight path angle at a given azimuthal angle.
+     *  \param azimuthalAngle Azimuthal angle, measured from the departure position [rad].
+     *  \return Flight path angle [rad].
+     */
+    double computeFlightPathAngle( const double azimuthalAngle ) const;
+
+    //! Function to compute the time derivative of the azimuthal angle.
+    /*!
+     *  Function to compute the time derivative of the azimuthal angle at a given azimuthal angle (NaN if u + u'' is not
+     *  positive).
+     *  \param azimuthalAngle Azimuthal angle, measured from the departure position [rad].
+     *  \return Time derivative of the azimuthal angle [rad/s].
+     */
+    double computeAzimuthalAngleRate( const double azimuthalAngle ) const;
+
+    //! Function to compute the magnitude of the thrust acceleration.
+    /*!
+     *  Function to compute the thrust acceleration (along the velocity vector) at a given azimuthal angle. A negative
+     *  value denotes a thrust acceleration opposite to the velocity vector.
+     *  \param azimuthalAngle Azimuthal angle, measured from the departure position [rad].
+     *  \return Thrust acceleration along the velocity vector [m/s^2].
+     */
+    double computeThrustAcceleration( const double azimuthalAngle ) const;
+
+    //! Function to compute the time of flight from the departure position to a given azimuthal angle.
+    /*!
+     *  Function to compute the time of flight from the departure position to a given azimuthal angle, by quadrature.
+     *  \param azimuthalAngle Azimuthal angle, measured from the departure position [rad].
+     *  \return Time of flight from the departure position to the given azimuthal angle [s].
+     */
+    double computeTimeOfFlight( const double azimuthalAngle ) const;
+
+    //! Function to compute the time of flight of the complete transfer.
+    /*!
+     *  Function to compute the time of flight of the complete transfer, by quadrature.
+     *  \return Time of flight of the complete transfer [s].
+     */
+    double computeTimeOfFlight( ) const
+    {
+        return computeTimeOfFlight( transferAngle_ );
+    }
+
+    //! Function to compute the delta V of the complete transfer.
+    /*!
+     *  Function to compute the delta V (integral of the magnitude of the thrust acceleration over time) of the
+     *  complete transfer, by quadrature.
+     *  \return Delta V of the complete transfer [m/s].
+     */
+    double computeDeltaV( ) const;
+
+    //! Function to compute the Cartesian state at a given azimuthal angle.
+    /*!
+     *  Function to compute the Cartesian state (in the frame of the boundary conditions, with zero z-components) at a
+     *  given azimuthal angle.
+     *  \param azimuthalAngle Azimuthal angle, measured from the departure position [rad].
+     *  \return Cartesian state at the given azimuthal angle.
+     */
+    Eigen::Vector6d computeCartesianState( const double azimuthalAngle ) const;
+
+    //! Function to compute the thrust acceleration profile of the transfer.
+    /*!
+     *  Function to compute the thrust acceleration vector (in the frame of the boundary conditions) at a number of
+     *  equally spaced azimuthal angles along the transfer, as a function of the time since departure. The output can
+     *  be used to create an interpolator for the thrust settings of a numerical propagation.
+     *  \param numberOfPoints Number of points at which the thrust acceleration is computed (at least 2).
+     *  \return Thrust acceleration vectors, with time since departure as key.
+     */
+    std::map< double, Eigen::Vector3d > computeThrustAccelerationProfile( const int numberOfPoints ) const;
+
+    //! Function to retrieve whether a trajectory satisfying the boundary conditions was found.
+    /*!
+     *  Function to retrieve whether a trajectory satisfying the boundary conditions (including the time of flight) was
+     *  found. If not, the output of the other functions of this class is meaningless.
+     *  \return True if a trajectory satisfying the boundary conditions was found.
+     */
+    bool isTrajectoryFeasible( ) const
+    {
+        return isTrajectoryFeasible_;
+    }
+
+    //! Function to retrieve the transfer angle.
+    /*!
+     *  Function to retrieve the transfer angle (azimuthal angle of the arrival position, measured from the departure
+     *  position, including full revolutions).
+     *  \return Transfer angle [rad].
+     */
+    double getTransferAngle( ) const
+    {
+        return transferAngle_;
+    }
+
+protected:
+
+    //! Function to compute the time derivative of the time of flight w.r.t. the azimuthal angle.
+    /*!
+     *  Function to compute the derivative of the time of flight w.r.t. the azimuthal angle (inverse of
+     *  computeAzimuthalAngleRate), used as integrand for the time of flight.
+     *  \param azimuthalAngle Azimuthal angle, measured from the departure position [rad].
+     *  \return Derivative of the time of flight w.r.t. the azimuthal angle [s/rad].
+     */
+    double computeTimeOfFlightDerivative( const double azimuthalAngle ) const;
+
+    //! Function to compute the derivative of the delta V w.r.t. the azimuthal angle.
+    /*!
+     *  Function to compute the derivative of the delta V w.r.t. the azimuthal angle, used as integrand for the delta V.
+     *  \param azimuthalAngle Azimuthal angle, measured from the departure position [rad].
+     *  \return Derivative of the delta V w.r.t. the azimuthal angle [m/s/rad].
+     */
+    double computeDeltaVDerivative( const double azimuthalAngle ) const;
+
+    //! Function to compute the quadrature of a function of the azimuthal angle.
+    /*!
+     *  Function to compute the quadrature of a function of the azimuthal angle between two angles, using the number of
+     *  segments per revolution provided to the constructor.
+     *  \param integrand Function of the azimuthal angle that is to be integrated.
+     *  \param lowerBound Lower bound of the integration interval [rad].
+     *  \param upperBound Upper bound of the integration interval [rad].
+     *  \return Quadrature of the integrand between the given azimuthal angles.
+     */
+    template< typename IntegrandType >
+    double computeQuadrature( const IntegrandType& integrand, const double lowerBound, const double upperBound ) const;
+
+    //! Function to set the departure and arrival polar coordinates from Cartesian states.
+    /*!
+     *  Function to set the departure and arrival polar coordinates (radial distance, azimuthal angle, radial velocity
+     *  and azimuthal velocity) from the Cartesian states, projected on the x-y plane, and to set the transfer angle.
+     *  \param departureState Cartesian state at departure.
+     *  \param arrivalState Cartesian state at arrival.
+     *  \param numberOfRevolutions Number of full revolutions of the transfer.
+     */
+    void setBoundaryConditions( const Eigen::Vector6d& departureState, const Eigen::Vector6d& arrivalState,
+                                const int numberOfRevolutions );
+
+    //! Gravitational parameter of the central body.
+    double centralBodyGravitationalParameter_;
+
+    //! Number of segments per revolution of the composite Gauss-Legendre quadrature.
+    int numberOfQuadratureSegmentsPerRevolution_;
+
+    //! Polar coordinates (radial distance, azimuthal angle, radial velocity, azimuthal velocity) at departure.
+    Eigen::Vector4d departurePolarState_;
+
+    //! Polar coordinates (radial distance, azimuthal angle, radial velocity, azimuthal velocity) at arrival.
+    Eigen::Vector4d arrivalPolarState_;
+
+    //! Azimuthal angle of the departure position, w.r.t. the x-axis.
+    double departureAzimuthalAngle_;
+
+    //! Transfer angle, including full revolutions.
+    double transferAngle_;
+
+    //! Boolean denoting whether a trajectory satisfying the boundary conditions was found.
+    bool isTrajectoryFeasible_;
+};
+
+//! Typedef for shared-pointer to ShapeBasedLowThrustTrajectory object.
+typedef boost::shared_ptr< ShapeBasedLowThrustTrajectory > ShapeBasedLowThrustTrajectoryPointer;
+
+//! Planar exponential sinusoid low-thrust trajectory, solved for a given time of flight.
+/*!
+ *  Planar exponential sinusoid low-thrust trajectory (Petropoulos and Longuski, 2004), with radial distance
+ *  \f$ r = k_{0} \exp( k_{1} \sin( k_{2} \theta + \phi ) ) \f$. For a given winding parameter k2, the shape
+ *  connecting the departure and arrival positions is a one-parameter family in the initial flight path angle, which
+ *  is solved to match the required time of flight (Izzo, 2006). The velocities at departure and arrival are not
+ *  constrained, so that the excess velocities w.r.t. the departure and arrival bodies follow from the solution.
+ */
+class ExponentialSinusoidTrajectory: public ShapeBasedLowThrustTrajectory
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor, solves the shape parameters for the boundary conditions and time of flight.
+     *  \param departureState Cartesian state of the departure body at departure (only the position is used).
+     *  \param arrivalState Cartesian state of the arrival body at arrival (only the position is used).
+     *  \param timeOfFlight Required time of flight [s].
+     *  \param centralBodyGravitationalParameter Gravitational parameter of the central body.
+     *  \param windingParameter Winding parameter k2 of the exponential sinusoid.
+     *  \param numberOfRevolutions Number of full revolutions of the transfer.
+     *  \param numberOfQuadratureSegmentsPerRevolution Number of segments per revolution of the composite
+     *  Gauss-Legendre quadrature.
+     */
+    ExponentialSinusoidTrajectory( const Eigen::Vector6d& departureState, const Eigen::Vector6d& arrivalState,
+                                   const double timeOfFlight, const double centralBodyGravitationalParameter,
+                                   const double windingParameter = 1.0 / 4.0, const int numberOfRevolutions = 0,
+                                   const int numberOfQuadratureSegmentsPerRevolution = 8 );
+
+    //! Function to compute the inverse of the radial distance, and its first three derivatives.
+    /*!
+     *  Function to compute the inverse of the radial distance (u = 1 / r), and its first three derivatives w.r.t. the
+     *  azimuthal angle.
+     *  \param azimuthalAngle Azimuthal angle, measured from the departure position [rad].
+     *  \param inverseRadialDistance Inverse of the radial distance (returned by reference) [1/m].
+     *  \param firstDerivative First derivative of u w.r.t. the azimuthal angle (returned by reference) [1/m].
+     *  \param secondDerivative Second derivative of u w.r.t. the azimuthal angle (returned by reference) [1/m].
+     *  \param thirdDerivative Third derivative of u w.r.t. the azimuthal angle (returned by reference) [1/m].
+     */
+    void computeInverseRadialDistanceAndDerivatives(
+            const double azimuthalAngle, double& inverseRadialDistance, double& firstDerivative,
+            double& secondDerivative, double& thirdDerivative ) const;
+
+    //! Function to retrieve the shape parameters.
+    /*!
+     *  Function to retrieve the shape parameters.
+     *  \return Shape parameters (k0, k1, k2, phi).
+     */
+    Eigen::Vector4d getShapeParameters( ) const
+    {
+        return ( Eigen::Vector4d( ) << scalingParameter_, dynamicRangeParameter_, windingParameter_,
+                 phaseParameter_ ).finished( );
+    }
+
+private:
+
+    //! Function to set the shape parameters for a given tangent of the initial flight path angle.
+    /*!
+     *  Function to set the shape parameters (k0, k1, phi) for a given tangent of the initial flight path angle, such
+     *  that the shape connects the departure and arrival positions.
+     *  \param tangentOfInitialFlightPathAngle Tangent of the initial flight path angle.
+     */
+    void setShapeParameters( const double tangentOfInitialFlightPathAngle );
+
+    //! Scaling parameter k0 [m].
+    double scalingParameter_;
+
+    //! Dynamic range parameter k1.
+    double dynamicRangeParameter_;
+
+    //! Winding parameter k2.
+    double windingParameter_;
+
+    //! Phase parameter phi [rad].
+    double phaseParameter_;
+};
+
+//! Planar improved inverse polynomial low-thrust trajectory, solved for a given time of flight.
+/*!
+ *  Planar improved inverse polynomial low-thrust trajectory (Wall et al., 2010), with radial distance
+ *  \f$ r = 1 / ( a + b \cos( \theta + c ) + d \theta^{3} + e \theta^{4} + f \theta^{5} + g \theta^{6} ) \f$,
+ *  as evaluated by the ImprovedInversePolynomialWall class. The parameters a, b and c follow from the departure
+ *  position and velocity, the parameters e, f and g from the arrival position and velocity (for a given d), and the
+ *  time-dependent parameter d is solved (by a secant method) to match the required time of flight. The in-plane
+ *  velocities of the departure and arrival bodies are matched, so that this shape models a rendezvous transfer.
+ */
+class InversePolynomialTrajectory: public ShapeBasedLowThrustTrajectory
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor, solves the shape parameters for the boundary conditions and time of flight.
+     *  \param departureState Cartesian state at departure.
+     *  \param arrivalState Cartesian state at arrival.
+     *  \param timeOfFlight Required time of flight [s].
+     *  \param centralBodyGravitationalParameter Gravitational parameter of the central body.
+     *  \param numberOfRevolutions Number of full revolutions of the transfer.
+     *  \param numberOfQuadratureSegmentsPerRevolution Number of segments per revolution of the composite
+     *  Gauss-Legendre quadrature.
+     */
+    InversePolynomialTrajectory( const Eigen::Vector6d& departureState, const Eigen::Vector6d& arrivalState,
+                                 const double timeOfFlight, const double centralBodyGravitationalParameter,
+                                 const int numberOfRevolutions = 0,
+                                 const int numberOfQuadratureSegmentsPerRevolution = 8 );
+
+    //! Function to compute the inverse of the radial distance, and its first three derivatives.
+    /*!
+     *  Function to compute the inverse of the radial distance (u = 1 / r), and its first three derivatives w.r.t. the
+     *  azimuthal angle.
+     *  \param azimuthalAngle Azimuthal angle, measured from the departure position [rad].
+     *  \param inverseRadialDistance Inverse of the radial distance (returned by reference) [1/m].
+     *  \param firstDerivative First derivative of u w.r.t. the azimuthal angle (returned by reference) [1/m].
+     *  \param secondDerivative Second derivative of u w.r.t. the azimuthal angle (returned by reference) [1/m].
+     *  \param thirdDerivative Third derivative of u w.r.t. the azimuthal angle (returned by reference) [1/m].
+     */
+    void computeInverseRadialDistanceAndDerivatives(
+            const double azimuthalAngle, double& inverseRadialDistance, double& firstDerivative,
+            double& secondDerivative, double& thirdDerivative ) const;
+
+    //! Function to retrieve the time-dependent shape parameter.
+    /*!
+     *  Function to retrieve the time-dependent shape parameter d.
+     *  \return Time-dependent shape parameter d.
+     */
+    double getTimeDependentParameter( ) const
+    {
+        return timeDependentParameter_;
+    }
+
+    //! Function to retrieve the shape parameters related to the boundary conditions.
+    /*!
+     *  Function to retrieve the shape parameters related to the boundary conditions.
+     *  \return Shape parameters (a, b, c) (first) and (e, f, g) (second).
+     */
+    std::pair< Eigen::Vector3d, Eigen::Vector3d > getBoundaryParameters( ) const
+    {
+        return boundaryParameters_;
+    }
+
+    //! Function to create the radial distance function of this trajectory.
+    /*!
+     *  Function to create an ImprovedInversePolynomialWall object, returning the radial distance (and its derivatives)
+     *  of this trajectory as a function of the azimuthal angle.
+     *  \return Radial distance function of this trajectory.
+     */
+    ImprovedInversePolynomialWallPointer createRadialDistanceFunction( ) const;
+
+private:
+
+    //! Function to set the time-dependent parameter, and compute the final boundary parameters.
+    /*!
+     *  Function to set the time-dependent parameter d, and compute the parameters e, f and g that satisfy the arrival
+     *  boundary conditions for this value of d.
+     *  \param timeDependentParameter Time-dependent parameter d.
+     */
+    void setTimeDependentParameter( const double timeDependentParameter );
+
+    //! Time-dependent parameter d.
+    double timeDependentParameter_;
+
+    //! Shape parameters (a, b, c) (first) and (e, f, g) (second).
+    std::pair< Eigen::Vector3d, Eigen::Vector3d > boundaryParameters_;
+
+    //! Required values of u, u' and u'' at arrival.
+    Eigen::Vector3d arrivalInverseRadialDistanceAndDerivatives_;
+
+    //! Inverse of the matrix relating (e, f, g) to their contribution to u, u' and u'' at arrival.
+    Eigen::Matrix3d inverseFinalBoundaryMatrix_;
+};
+
+//! Function to compute the delta V and excess velocities of shape-based transfers for a grid of departure times and
+//! times of flight.
+/*!
+ *  Function to compute the delta V and excess velocities of shape-based transfers for a grid of departure times and
+ *  times of flight, as typically used to screen a large number of low-thrust transfers. The states of the departure
+ *  and arrival bodies are first retrieved (sequentially) for all grid points, after which the transfers are computed
+ *  concurrently, distributed over the requested number of threads. The results are independent of the number of
+ *  threads. For infeasible transfers, all output values are NaN.
+ *  \param trajectoryCreationFunction Function creating a shape-based trajectory from the departure state, arrival state
+ *  and time of flight (e.g. a bound constructor of ExponentialSinusoidTrajectory). Must be safe to call concurrently.
+ *  \param departureBodyStateFunction Function returning the Cartesian state of the departure body as a function of time.
+ *  \param arrivalBodyStateFunction Function returning the Cartesian state of the arrival body as a function of time.
+ *  \param departureTimes List of departure times.
+ *  \param timesOfFlight List of times of flight.
+ *  \param deltaVs Delta V of the low-thrust arc, with one row per departure time and one column per time of flight
+ *  (returned by reference).
+ *  \param departureExcessVelocities Magnitude of the velocity at departure w.r.t. the departure body, with the same
+ *  layout as deltaVs (returned by reference).
+ *  \param arrivalExcessVelocities Magnitude of the velocity at arrival w.r.t. the arrival body, with the same layout as
+ *  deltaVs (returned by reference).
+ *  \param numberOfThreads Number of threads that is to be used.
+ */
+void computeShapeBasedTransferGrid(
+        const boost::function< ShapeBasedLowThrustTrajectoryPointer(
+            const Eigen::Vector6d&, const Eigen::Vector6d&, const double ) > trajectoryCreationFunction,
+        const boost::function< Eigen::Vector6d( const double ) > departureBodyStateFunction,
+        const boost::function< Eigen::Vector6d( const double ) > arrivalBodyStateFunction,
+        const std::vector< double >& departureTimes,
+        const std::vector< double >& timesOfFlight,
+        Eigen::MatrixXd& deltaVs,
+        Eigen::MatrixXd& departureExcessVelocities,
+        Eigen::MatrixXd& arrivalExcessVelocities,
+        const unsigned int numberOfThreads = 1 );
+
+} // namespace mission_segments
+} // namespace tudat
+
+#endif // TUDAT_SHAPE_BASED_LOW_THRUST_TRAJECTORY_H
@@ -0,0 +1,361 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <limits>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/bind.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+
+#include "Tudat/Astrodynamics/ObservationModels/angularPositionObservationModel.h"
+#include "Tudat/Astrodynamics/ObservationModels/oneWayRangeObservationModel.h"
+#include "Tudat/Astrodynamics/ObservationModels/positionObservationModel.h"
+#include "Tudat/Astrodynamics/ObservationModels/observationSimulator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::observation_models;
+
+//! Function to compute the state of a link end, moving on a circular orbit.
+Eigen::Vector6d getCircularOrbitState( const double time, const double radius, const double meanMotion,
+                                       const double phase )
+{
+    Eigen::Vector6d state;
+    state << radius * std::cos( meanMotion * time + phase ), radius * std::sin( meanMotion * time + phase ), 0.0,
+            -radius * meanMotion * std::sin( meanMotion * time + phase ),
+            radius * meanMotion * std::cos( meanMotion * time + phase ), 0.0;
+    return state;
+}
+
+//! Function to create a batch observation simulator for a set of links that partially share bodies.
+/*!
+ *  Function to create a batch observation simulator for a set of links that partially share bodies: one-way range and
+ *  angular position between each spacecraft and its own lander, and one-way range between the first spacecraft and
+ *  the second and third spacecraft (so that the links form six groups that do not share any body).
+ *  \param numberOfThreads Number of threads used by the batch observation simulator.
+ *  \param observationsToSimulate List of observations that are to be simulated (returned by reference).
+ *  \return Batch observation simulator.
+ */
+boost::shared_ptr< BatchObservationSimulator< > > createPartiallyIndependentLinksSimulator(
+        const unsigned int numberOfThreads,
+        BatchObservationSimulator< >::ObservationsToSimulateList& observationsToSimulate )
+{
+    boost::shared_ptr< BatchObservationSimulator< > > batchSimulator =
+            boost::make_shared< BatchObservationSimulator< > >( numberOfThreads );
+    observationsToSimulate.clear( );
+
+    std::vector< double > observationTimes;
+    for( int j = 0; j < 40; j++ )
+    {
+        observationTimes.push_back( 1000.0 + 60.0 * static_cast< double >( j ) );
+    }
+
+    int numberOfSpacecraft = 8;
+    for( int i = 0; i < numberOfSpacecraft; i++ )
+    {
+        std::string spacecraftIndex = boost::lexical_cast< std::string >( i );
+        boost::function< Eigen::Vector6d( const double ) > spacecraftStateFunction =
+                boost::bind( &getCircularOrbitState, _1, 7.0E6 + 1.0E5 * i, 1.0E-3, 0.1 * i );
+        boost::function< Eigen::Vector6d( const double ) > landerStateFunction =
+                boost::bind( &getCircularOrbitState, _1, 6.4E6, 7.3E-5, -0.2 * i );
+
+        LinkEnds linkEnds;
+        linkEnds[ transmitter ] = std::make_pair( "Spacecraft" + spacecraftIndex, "" );
+        linkEnds[ receiver ] = std::make_pair( "Lander" + spacecraftIndex, "" );
+        batchSimulator->addObservationModel(
+                    linkEnds, boost::shared_ptr< ObservationModel< 1 > >(
+                        boost::make_shared< OneWayRangeObservationModel< > >(
+                            boost::make_shared< LightTimeCalculator< > >(
+                                spacecraftStateFunction, landerStateFunction ) ) ) );
+        batchSimulator->addObservationModel(
+                    linkEnds, boost::shared_ptr< ObservationModel< 2 > >(
+                        boost::make_shared< AngularPositionObservationModel< > >(
+                            boost::make_shared< LightTimeCalculator< > >(
+                                spacecraftStateFunction, landerStateFunction ) ) ) );
+        observationsToSimulate[ oneWayRange ][ linkEnds ] = std::make_pair( observationTimes, receiver );
+        observationsToSimulate[ angular_position ][ linkEnds ] = std::make_pair( observationTimes, transmitter );
+
+        if( i > 0 && i < 3 )
+        {
+            LinkEnds interSatelliteLinkEnds;
+            interSatelliteLinkEnds[ transmitter ] = std::make_pair( "Spacecraft0", "" );
+            interSatelliteLinkEnds[ receiver ] = linkEnds[ transmitter ];
+            batchSimulator->addObservationModel(
+                        interSatelliteLinkEnds, boost::shared_ptr< ObservationModel< 1 > >(
+                            boost::make_shared< OneWayRangeObservationModel< > >(
+                                boost::make_shared< LightTimeCalculator< > >(
+                                    boost::bind( &getCircularOrbitState, _1, 7.0E6, 1.0E-3, 0.0 ),
+                                    spacecraftStateFunction ) ) ) );
+            observationsToSimulate[ oneWayRange ][ interSatelliteLinkEnds ] =
+                    std::make_pair( observationTimes, receiver );
+        }
+    }
+    return batchSimulator;
+}
+
+BOOST_AUTO_TEST_SUITE( test_batch_observation_simulator )
+
+//! Test whether links are correctly divided into groups that do not share any bodies.
+BOOST_AUTO_TEST_CASE( testLinkGrouping )
+{
+    std::vector< std::vector< std::string > > linkBodies;
+    linkBodies.push_back( { "A", "B" } );
+    linkBodies.push_back( { "C", "D" } );
+    linkBodies.push_back( { "B", "E" } );
+    linkBodies.push_back( { "F" } );
+    linkBodies.push_back( { "E", "C" } );
+    linkBodies.push_back( { "G", "H" } );
+
+    std::vector< std::vector< unsigned int > > linkGroups = groupLinksBySharedBodies( linkBodies );
+    BOOST_CHECK_EQUAL( linkGroups.size( ), 3 );
+    BOOST_CHECK( linkGroups.at( 0 ) == std::vector< unsigned int >( { 0, 1, 2, 4 } ) );
+    BOOST_CHECK( linkGroups.at( 1 ) == std::vector< unsigned int >( { 3 } ) );
+    BOOST_CHECK( linkGroups.at( 2 ) == std::vector< unsigned int >( { 5 } ) );
+
+    BOOST_CHECK_EQUAL( groupLinksBySharedBodies( std::vector< std::vector< std::string > >( ) ).size( ), 0 );
+}
+
+//! Test whether concurrent simulation of links gives results identical to serial simulation.
+BOOST_AUTO_TEST_CASE( testParallelBatchObservationSimulation )
+{
+    BatchObservationSimulator< >::ObservationsToSimulateList observationsToSimulate;
+    BatchObservationSimulator< >::ObservationBatchList serialObservations =
+            createPartiallyIndependentLinksSimulator( 1, observationsToSimulate )->simulateObservations(
+                observationsToSimulate );
+
+    for( unsigned int numberOfThreads = 2; numberOfThreads <= 8; numberOfThreads *= 2 )
+    {
+        BatchObservationSimulator< >::ObservationBatchList parallelObservations =
+                createPartiallyIndependentLinksSimulator( numberOfThreads, observationsToSimulate )->
+                simulateObservations( observationsToSimulate );
+
+        BOOST_CHECK_EQUAL( parallelObservations.size( ), serialObservations.size( ) );
+        for( BatchObservationSimulator< >::ObservationBatchList::const_iterator observableIterator =
+             serialObservations.begin( ); observableIterator != serialObservations.end( ); observableIterator++ )
+        {
+            BOOST_CHECK_EQUAL( parallelObservations.at( observableIterator->first ).size( ),
+                               observableIterator->second.size( ) );
+            for( std::map< LinkEnds, boost::shared_ptr< BatchObservationSimulator< >::ObservationBatch > >::
+                 const_iterator linkIterator = observableIterator->second.begin( );
+                 linkIterator != observableIterator->second.end( ); linkIterator++ )
+            {
+                boost::shared_ptr< BatchObservationSimulator< >::ObservationBatch > parallelBatch =
+                        parallelObservations.at( observableIterator->first ).at( linkIterator->first );
+                BOOST_CHECK( parallelBatch->getObservations( ) == linkIterator->second->getObservations( ) );
+                BOOST_CHECK( parallelBatch->getLinkEndTimes( ) == linkIterator->second->getLinkEndTimes( ) );
+                BOOST_CHECK( parallelBatch->getLinkEndStates( ) == linkIterator->second->getLinkEndStates( ) );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( testBatchObservationSimulator )
+{
+    // Define number of links, and observation times per link (unsorted for the second half).
+    int numberOfLinks = 6;
+    std::vector< std::vector< double > > observationTimes;
+    for( int i = 0; i < numberOfLinks; i++ )
+    {
+        std::vector< double > currentObservationTimes;
+        for( int j = 0; j < 50 + i; j++ )
+        {
+            currentObservationTimes.push_back( 1000.0 + 60.0 * static_cast< double >( j ) + 7.0 * i );
+        }
+        if( i >= numberOfLinks / 2 )
+        {
+            std::reverse( currentObservationTimes.begin( ), currentObservationTimes.end( ) );
+        }
+        observationTimes.push_back( currentObservationTimes );
+    }
+
+    BatchObservationSimulator< > batchSimulator;
+    BatchObservationSimulator< >::ObservationsToSimulateList observationsToSimulate;
+
+    std::map< LinkEnds, boost::shared_ptr< ObservationModel< 1 > > > rangeModels;
+    std::map< LinkEnds, boost::shared_ptr< ObservationModel< 2 > > > angularPositionModels;
+    std::map< LinkEnds, boost::shared_ptr< ObservationModel< 3 > > > positionModels;
+    std::map< LinkEnds, boost::shared_ptr< LightTimeCalculator< > > > rangeLightTimeCalculators;
+
+    // Create models for each link, with independent state functions.
+    for( int i = 0; i < numberOfLinks; i++ )
+    {
+        std::string linkIndex = boost::lexical_cast< std::string >( i );
+        LinkEnds linkEnds;
+        linkEnds[ transmitter ] = std::make_pair( "Spacecraft" + linkIndex, "" );
+        linkEnds[ receiver ] = std::make_pair( "Earth", "Station" + linkIndex );
+
+        boost::function< Eigen::Vector6d( const double ) > transmitterStateFunction =
+                boost::bind( &getCircularOrbitState, _1, 7.0E6 + 1.0E5 * i, 1.0E-3, 0.1 * i );
+        boost::function< Eigen::Vector6d( const double ) > receiverStateFunction =
+                boost::bind( &getCircularOrbitState, _1, 6.4E6, 7.3E-5, -0.2 * i );
+
+        rangeLightTimeCalculators[ linkEnds ] = boost::make_shared< LightTimeCalculator< > >(
+                    transmitterStateFunction, receiverStateFunction );
+        rangeModels[ linkEnds ] = boost::make_shared< OneWayRangeObservationModel< > >(
+                    rangeLightTimeCalculators[ linkEnds ] );
+        angularPositionModels[ linkEnds ] = boost::make_shared< AngularPositionObservationModel< > >(
+                    boost::make_shared< LightTimeCalculator< > >( transmitterStateFunction, receiverStateFunction ),
+                    boost::make_shared< ConstantObservationBias< 2 > >( Eigen::Vector2d( 1.0E-6, -2.0E-6 ) ) );
+
+        LinkEnds positionLinkEnds;
+        positionLinkEnds[ observed_body ] = linkEnds[ transmitter ];
+        positionModels[ positionLinkEnds ] = boost::make_shared< PositionObservationModel< > >(
+                    transmitterStateFunction );
+
+        batchSimulator.addObservationModel( linkEnds, rangeModels[ linkEnds ] );
+        batchSimulator.addObservationModel( linkEnds, angularPositionModels[ linkEnds ] );
+        batchSimulator.addObservationModel( positionLinkEnds, positionModels[ positionLinkEnds ] );
+
+        observationsToSimulate[ oneWayRange ][ linkEnds ] = std::make_pair( observationTimes.at( i ), receiver );
+        observationsToSimulate[ angular_position ][ linkEnds ] =
+                std::make_pair( observationTimes.at( i ), transmitter );
+        observationsToSimulate[ position_observable ][ positionLinkEnds ] =
+                std::make_pair( observationTimes.at( i ), observed_body );
+    }
+
+    BatchObservationSimulator< >::ObservationBatchList simulatedObservations =
+            batchSimulator.simulateObservations( observationsToSimulate );
+    BOOST_CHECK_EQUAL( simulatedObservations.size( ), 3 );
+
+    // Compare batch results to single (cold-started) observation computations
+    std::vector< double > linkEndTimes;
+    std::vector< Eigen::Vector6d > linkEndStates;
+    int linkCounter = 0;
+    for( std::map< LinkEnds, boost::shared_ptr< ObservationModel< 1 > > >::iterator modelIterator =
+         rangeModels.begin( ); modelIterator != rangeModels.end( ); modelIterator++ )
+    {
+        boost::shared_ptr< BatchObservationSimulator< >::ObservationBatch > currentBatch =
+                simulatedObservations.at( oneWayRange ).at( modelIterator->first );
+        std::vector< double > sortedTimes = observationTimes.at( linkCounter );
+        std::sort( sortedTimes.begin( ), sortedTimes.end( ) );
+
+        BOOST_CHECK_EQUAL( currentBatch->getNumberOfObservations( ), static_cast< int >( sortedTimes.size( ) ) );
+        BOOST_CHECK_EQUAL( currentBatch->getNumberOfLinkEnds( ), 2 );
+        BOOST_CHECK_EQUAL( currentBatch->getObservationSize( ), 1 );
+        BOOST_CHECK_EQUAL( currentBatch->getObservations( ).rows( ), static_cast< int >( sortedTimes.size( ) ) );
+
+        // Check that warm-start setting is restored after batch simulation
+        boost::shared_ptr< LightTimeCalculator< > > lightTimeCalculator =
+                rangeLightTimeCalculators.at( modelIterator->first );
+        BOOST_CHECK_EQUAL( lightTimeCalculator->getUseWarmStart( ), false );
+        int numberOfBatchStateEvaluations = lightTimeCalculator->getNumberOfStateFunctionEvaluations( );
+
+        for( unsigned int j = 0; j < sortedTimes.size( ); j++ )
+        {
+            BOOST_CHECK_EQUAL( currentBatch->getObservationTimes( ).at( j ), sortedTimes.at( j ) );
+
+            // Warm- and cold-started light-time solutions are equal to within the light-time tolerance.
+            double directObservation = modelIterator->second->computeObservationsWithLinkEndData(
+                        sortedTimes.at( j ), receiver, linkEndTimes, linkEndStates )( 0 );
+            BOOST_CHECK_SMALL( currentBatch->getObservations( )( j ) - directObservation,
+                               10.0 * physical_constants::SPEED_OF_LIGHT * 1.0E-12 );
+            for( unsigned int k = 0; k < 2; k++ )
+            {
+                BOOST_CHECK_SMALL( currentBatch->getLinkEndTimes( ).at( 2 * j + k ) - linkEndTimes.at( k ),
+                                   1.0E-11 );
+
+                // Velocity of iterated link end is not corrected for difference between predicted and converged
+                // link end time of warm-started solution (see LightTimeCalculator).
+                Eigen::Vector6d stateDifference = currentBatch->getSingleLinkEndState( j, k ) - linkEndStates.at( k );
+                BOOST_CHECK_SMALL( stateDifference.segment( 0, 3 ).norm( ), 1.0E-5 );
+                BOOST_CHECK_SMALL( stateDifference.segment( 3, 3 ).norm( ), 1.0E-4 );
+            }
+
+            // Check that the reception time is the observation time
+            BOOST_CHECK_EQUAL( currentBatch->getLinkEndTimes( ).at( 2 * j + 1 ), sortedTimes.at( j ) );
+        }
+
+        // Check that warm-starting reduces the number of link end state evaluations
+        int numberOfDirectStateEvaluations =
+                lightTimeCalculator->getNumberOfStateFunctionEvaluations( ) - numberOfBatchStateEvaluations;
+        BOOST_CHECK( numberOfBatchStateEvaluations < numberOfDirectStateEvaluations );
+        linkCounter++;
+    }
+
+    linkCounter = 0;
+    for( std::map< LinkEnds, boost::shared_ptr< ObservationModel< 2 > > >::iterator modelIterator =
+         angularPositionModels.begin( ); modelIterator != angularPositionModels.end( ); modelIterator++ )
+    {
+        boost::shared_ptr< BatchObservationSimulator< >::ObservationBatch > currentBatch =
+                simulatedObservations.at( angular_position ).at( modelIterator->first );
+        std::vector< double > sortedTimes = observationTimes.at( linkCounter );
+        std::sort( sortedTimes.begin( ), sortedTimes.end( ) );
+
+        BOOST_CHECK_EQUAL( currentBatch->getObservations( ).rows( ), 2 * static_cast< int >( sortedTimes.size( ) ) );
+        for( unsigned int j = 0; j < sortedTimes.size( ); j++ )
+        {
+            Eigen::Vector2d directObservation = modelIterator->second->computeObservationsWithLinkEndData(
+                        sortedTimes.at( j ), transmitter, linkEndTimes, linkEndStates );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                        currentBatch->getSingleObservation( j ), directObservation, 1.0E-10 );
+
+            // Check that the transmission time is the observation time
+            BOOST_CHECK_EQUAL( currentBatch->getLinkEndTimes( ).at( 2 * j ), sortedTimes.at( j ) );
+        }
+        linkCounter++;
+    }
+
+    linkCounter = 0;
+    for( std::map< LinkEnds, boost::shared_ptr< ObservationModel< 3 > > >::iterator modelIterator =
+         positionModels.begin( ); modelIterator != positionModels.end( ); modelIterator++ )
+    {
+        boost::shared_ptr< BatchObservationSimulator< >::ObservationBatch > currentBatch =
+                simulatedObservations.at( position_observable ).at( modelIterator->first );
+        std::vector< double > sortedTimes = observationTimes.at( linkCounter );
+        std::sort( sortedTimes.begin( ), sortedTimes.end( ) );
+
+        BOOST_CHECK_EQUAL( currentBatch->getNumberOfLinkEnds( ), 1 );
+        for( unsigned int j = 0; j < sortedTimes.size( ); j++ )
+        {
+            Eigen::Vector3d directObservation = modelIterator->second->computeObservations(
+                        sortedTimes.at( j ), observed_body );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                        currentBatch->getSingleObservation( j ), directObservation,
+                        std::numeric_limits< double >::epsilon( ) );
+        }
+        linkCounter++;
+    }
+
+    // Check that missing observation model is caught
+    {
+        BatchObservationSimulator< > batchSimulator;
+        BatchObservationSimulator< >::ObservationsToSimulateList observationsToSimulate;
+        LinkEnds linkEnds;
+        linkEnds[ observed_body ] = std::make_pair( "Spacecraft", "" );
+        observationsToSimulate[ position_observable ][ linkEnds ] =
+                std::make_pair( observationTimes.at( 0 ), observed_body );
+
+        bool isExceptionCaught = false;
+        try
+        {
+            batchSimulator.simulateObservations( observationsToSimulate );
+        }
+        catch( std::runtime_error& )
+        {
+            isExceptionCaught = true;
+        }
+        BOOST_CHECK_EQUAL( isExceptionCaught, true );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
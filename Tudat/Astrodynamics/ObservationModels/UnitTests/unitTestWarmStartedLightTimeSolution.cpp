@@ -0,0 +1,135 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/bind.hpp>
+
+#include "Tudat/Astrodynamics/ObservationModels/lightTimeSolution.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::observation_models;
+
+//! Function to compute the state of a link end moving on a circular orbit.
+Eigen::Vector6d getCircularOrbitState( const double time, const double radius, const double meanMotion,
+                                       const double inclination )
+{
+    Eigen::Vector6d state;
+    state << radius * std::cos( meanMotion * time ),
+            radius * std::sin( meanMotion * time ) * std::cos( inclination ),
+            radius * std::sin( meanMotion * time ) * std::sin( inclination ),
+            -radius * meanMotion * std::sin( meanMotion * time ),
+            radius * meanMotion * std::cos( meanMotion * time ) * std::cos( inclination ),
+            radius * meanMotion * std::cos( meanMotion * time ) * std::sin( inclination );
+    return state;
+}
+
+//! Function to compute a (time-dependent) light-time correction.
+double getTestLightTimeCorrection( const Eigen::Vector6d& transmitterState, const Eigen::Vector6d& receiverState,
+                                   const double transmissionTime, const double receptionTime )
+{
+    return 1.0E-9 * ( 1.0 + std::sin( 1.0E-4 * receptionTime ) );
+}
+
+BOOST_AUTO_TEST_SUITE( test_warm_started_light_time )
+
+//! Test whether warm-started and batch light-time solutions are equal to cold-started solutions, with fewer evaluations.
+BOOST_AUTO_TEST_CASE( testWarmStartedLightTimeSolution )
+{
+    boost::function< Eigen::Vector6d( const double ) > transmitterStateFunction =
+            boost::bind( &getCircularOrbitState, _1, 4.2E7, 7.3E-5, 0.1 );
+    boost::function< Eigen::Vector6d( const double ) > receiverStateFunction =
+            boost::bind( &getCircularOrbitState, _1, 6.4E6, 1.1E-3, 1.2 );
+
+    std::vector< double > observationTimes;
+    for( double currentTime = 0.0; currentTime < 3600.0; currentTime += 1.0 )
+    {
+        observationTimes.push_back( currentTime );
+    }
+
+    for( unsigned int useCorrections = 0; useCorrections < 2; useCorrections++ )
+    {
+        std::vector< LightTimeCorrectionFunction > correctionFunctions;
+        if( useCorrections )
+        {
+            correctionFunctions.push_back( &getTestLightTimeCorrection );
+        }
+
+        for( unsigned int isTimeAtReception = 0; isTimeAtReception < 2; isTimeAtReception++ )
+        {
+            LightTimeCalculator< > coldLightTimeCalculator(
+                        transmitterStateFunction, receiverStateFunction, correctionFunctions );
+            LightTimeCalculator< > warmLightTimeCalculator(
+                        transmitterStateFunction, receiverStateFunction, correctionFunctions );
+            LightTimeCalculator< > batchLightTimeCalculator(
+                        transmitterStateFunction, receiverStateFunction, correctionFunctions );
+            warmLightTimeCalculator.setUseWarmStart( true );
+
+            // Compute light times in batch.
+            std::vector< Eigen::Vector6d > batchReceiverStates, batchTransmitterStates;
+            std::vector< double > batchLightTimes;
+            batchLightTimeCalculator.calculateLightTimesWithLinkEndsStates(
+                        batchReceiverStates, batchTransmitterStates, batchLightTimes, observationTimes,
+                        isTimeAtReception );
+            BOOST_CHECK_EQUAL( batchLightTimes.size( ), observationTimes.size( ) );
+
+            // Compute light times one by one, and compare
+            Eigen::Vector6d coldReceiverState, coldTransmitterState, warmReceiverState, warmTransmitterState;
+            for( unsigned int i = 0; i < observationTimes.size( ); i++ )
+            {
+                double coldLightTime = coldLightTimeCalculator.calculateLightTimeWithLinkEndsStates(
+                            coldReceiverState, coldTransmitterState, observationTimes.at( i ), isTimeAtReception );
+                double warmLightTime = warmLightTimeCalculator.calculateLightTimeWithLinkEndsStates(
+                            warmReceiverState, warmTransmitterState, observationTimes.at( i ), isTimeAtReception );
+
+                BOOST_CHECK_SMALL( warmLightTime - coldLightTime, 1.0E-14 );
+                BOOST_CHECK_EQUAL( warmLightTime, batchLightTimes.at( i ) );
+                BOOST_CHECK_SMALL( ( warmTransmitterState - coldTransmitterState ).segment( 0, 3 ).norm( ), 1.0E-6 );
+                BOOST_CHECK_SMALL( ( warmReceiverState - coldReceiverState ).segment( 0, 3 ).norm( ), 1.0E-6 );
+                BOOST_CHECK_SMALL( ( warmTransmitterState - coldTransmitterState ).segment( 3, 3 ).norm( ), 1.0E-6 );
+                BOOST_CHECK_SMALL( ( warmReceiverState - coldReceiverState ).segment( 3, 3 ).norm( ), 1.0E-6 );
+                BOOST_CHECK_EQUAL( warmTransmitterState, batchTransmitterStates.at( i ) );
+                BOOST_CHECK_EQUAL( warmReceiverState, batchReceiverStates.at( i ) );
+
+                // Check consistency of light time with link end states.
+                double expectedLightTime = ( warmReceiverState - warmTransmitterState ).segment( 0, 3 ).norm( ) /
+                        physical_constants::SPEED_OF_LIGHT + ( useCorrections ? getTestLightTimeCorrection(
+                                                                   warmTransmitterState, warmReceiverState, 0.0,
+                                                                   observationTimes.at( i ) +
+                                                                   ( isTimeAtReception ? 0.0 : warmLightTime ) ) : 0.0 );
+                BOOST_CHECK_SMALL( warmLightTime - expectedLightTime, 1.0E-12 );
+            }
+
+            // Check reduction in number of state function evaluations (single evaluation per link end, except for the
+            // first few observations).
+            int numberOfObservations = observationTimes.size( );
+            BOOST_CHECK_EQUAL( warmLightTimeCalculator.getNumberOfStateFunctionEvaluations( ),
+                               batchLightTimeCalculator.getNumberOfStateFunctionEvaluations( ) );
+            BOOST_CHECK( batchLightTimeCalculator.getNumberOfStateFunctionEvaluations( ) <= 2 * numberOfObservations + 4 );
+            BOOST_CHECK( coldLightTimeCalculator.getNumberOfStateFunctionEvaluations( ) > 3 * numberOfObservations );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
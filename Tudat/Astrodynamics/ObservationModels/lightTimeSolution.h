@@ -16,6 +16,7 @@
 #include <boost/function.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <vector>
@@ -103,7 +104,12 @@ public:
         stateFunctionOfReceivingBody_( positionFunctionOfReceivingBody ),
         correctionFunctions_( correctionFunctions ),
         iterateCorrections_( iterateCorrections ),
-        currentCorrection_( 0.0 ){ }
+        currentCorrection_( 0.0 ),
+        useWarmStart_( false ),
+        numberOfStateFunctionEvaluations_( 0 )
+    {
+        resetWarmStart( );
+    }
 
     LightTimeCalculator(
             const boost::function< StateType( const TimeType ) > positionFunctionOfTransmittingBody,
@@ -113,8 +119,11 @@ public:
         stateFunctionOfTransmittingBody_( positionFunctionOfTransmittingBody ),
         stateFunctionOfReceivingBody_( positionFunctionOfReceivingBody ),
         iterateCorrections_( iterateCorrections ),
-        currentCorrection_( 0.0 )
+        currentCorrection_( 0.0 ),
+        useWarmStart_( false ),
+        numberOfStateFunctionEvaluations_( 0 )
     {
+        resetWarmStart( );
         for( unsigned int i = 0; i < correctionFunctions.size( ); i++ )
         {
             correctionFunctions_.push_back(
@@ -194,24 +203,174 @@ public:
             const bool isTimeAtReception = 1,
             const ObservationScalarType tolerance =
             ( getDefaultLightTimeTolerance< ObservationScalarType, StateScalarType >( ) ) )
+    {
+        // Link end states are only cached during a single solution, as state functions may change between calls.
+        isTransmitterStateCached_ = false;
+        isReceiverStateCached_ = false;
+
+        return calculateLightTimeWithLinkEndsStatesFromInitialGuess(
+                    receiverStateOutput, transmitterStateOutput, time, isTimeAtReception, tolerance, useWarmStart_ );
+    }
+
+    //! Function to calculate the light times and link-ends states for a list of times.
+    /*!
+     *  Function to calculate the transmitter states at transmission times, the receiver states at
+     *  reception times, and the light times, for a list of times. Each light-time solution is warm-started from the
+     *  previous solution(s) in the list (regardless of the setting of setUseWarmStart), so that for closely spaced,
+     *  sorted times, typically only a single iteration is required per light time. Link end states are cached per
+     *  epoch during this call, so that the state functions are not re-evaluated at identical times. The warm-start
+     *  history is reset at the start of this function, so that the results do not depend on earlier calls.
+     *  \param receiverStatesOutput Output by reference of receiver states.
+     *  \param transmitterStatesOutput Output by reference of transmitter states.
+     *  \param lightTimesOutput Output by reference of light times.
+     *  \param times Times at reception or transmission (preferably sorted).
+     *  \param isTimeAtReception True if input times are at reception, false if at transmission.
+     *  \param tolerance Maximum allowed light-time difference between two subsequent iterations
+     *  for which solution is accepted.
+     */
+    void calculateLightTimesWithLinkEndsStates(
+            std::vector< StateType >& receiverStatesOutput,
+            std::vector< StateType >& transmitterStatesOutput,
+            std::vector< ObservationScalarType >& lightTimesOutput,
+            const std::vector< TimeType >& times,
+            const bool isTimeAtReception = 1,
+            const ObservationScalarType tolerance =
+            ( getDefaultLightTimeTolerance< ObservationScalarType, StateScalarType >( ) ) )
+    {
+        receiverStatesOutput.resize( times.size( ) );
+        transmitterStatesOutput.resize( times.size( ) );
+        lightTimesOutput.resize( times.size( ) );
+
+        resetWarmStart( );
+        for( unsigned int i = 0; i < times.size( ); i++ )
+        {
+            lightTimesOutput[ i ] = calculateLightTimeWithLinkEndsStatesFromInitialGuess(
+                        receiverStatesOutput[ i ], transmitterStatesOutput[ i ], times[ i ], isTimeAtReception,
+                        tolerance, true );
+        }
+    }
+
+    //! Function to set whether light-time solutions are to be warm-started from previous solutions.
+    /*!
+     *  Function to set whether light-time solutions are to be warm-started from previous solutions. If true, the
+     *  initial guess of the light time is predicted by quadratic (Lagrange) extrapolation of the previous three
+     *  solutions (or linear/constant extrapolation if fewer solutions at distinct times are available), instead of
+     *  from an infinite signal speed. For high-rate tracking data, this reduces the number of iterations
+     *  (and state function evaluations) to typically one per solution. The solution is converged to the same
+     *  tolerance in either case.
+     *  \param useWarmStart Boolean denoting whether light-time solutions are to be warm-started.
+     */
+    void setUseWarmStart( const bool useWarmStart )
+    {
+        useWarmStart_ = useWarmStart;
+        resetWarmStart( );
+    }
+
+    //! Function to retrieve whether light-time solutions are warm-started from previous solutions.
+    /*!
+     *  Function to retrieve whether light-time solutions are warm-started from previous solutions.
+     *  \return Boolean denoting whether light-time solutions are warm-started.
+     */
+    bool getUseWarmStart( )
+    {
+        return useWarmStart_;
+    }
+
+    //! Function to reset the warm-start history.
+    /*!
+     *  Function to reset the warm-start history, and state function caches, so that the next light-time solution is
+     *  started from an infinite signal speed initial guess. This function should be called if the state functions of
+     *  the link ends have been modified (e.g. after a reset of an ephemeris).
+     */
+    void resetWarmStart( )
+    {
+        numberOfPreviousSolutions_ = 0;
+        isTransmitterStateCached_ = false;
+        isReceiverStateCached_ = false;
+    }
+
+    //! Function to retrieve the number of state function evaluations.
+    /*!
+     *  Function to retrieve the total number of evaluations of the link end state functions by this object.
+     *  \return Total number of evaluations of the link end state functions by this object.
+     */
+    int getNumberOfStateFunctionEvaluations( )
+    {
+        return numberOfStateFunctionEvaluations_;
+    }
+
+    std::vector< boost::shared_ptr< LightTimeCorrection > > getLightTimeCorrection( )
+    {
+        return correctionFunctions_;
+    }
+
+protected:
+
+    //! Function to calculate the light time and link-ends states, optionally warm-started from previous solutions.
+    /*!
+     *  Function to calculate the transmitter state at transmission time, the receiver state at
+     *  reception time, and the light time, optionally using previous solutions to predict the initial light time.
+     *  \param receiverStateOutput Output by reference of receiver state.
+     *  \param transmitterStateOutput Output by reference of transmitter state.
+     *  \param time Time at reception or transmission.
+     *  \param isTimeAtReception True if input time is at reception, false if at transmission.
+     *  \param tolerance Maximum allowed light-time difference between two subsequent iterations
+     *  for which solution is accepted.
+     *  \param useWarmStart Boolean denoting whether to predict the initial light time from previous solutions.
+     *  \return The value of the light time between the reciever state and the transmitter state.
+     */
+    ObservationScalarType calculateLightTimeWithLinkEndsStatesFromInitialGuess(
+            StateType& receiverStateOutput,
+            StateType& transmitterStateOutput,
+            const TimeType time,
+            const bool isTimeAtReception,
+            const ObservationScalarType tolerance,
+            const bool useWarmStart )
     {
         using physical_constants::SPEED_OF_LIGHT;
         using std::fabs;
 
-        // Initialize reception and transmission times and states to initial guess (zero light time)
+        // Check if previous solutions can be used to predict light time.
+        bool isWarmStarted = useWarmStart && ( numberOfPreviousSolutions_ > 0 ) &&
+                ( previousIsTimeAtReception_ == isTimeAtReception );
+
         TimeType receptionTime = time;
         TimeType transmissionTime = time;
-        StateType receiverState = stateFunctionOfReceivingBody_( receptionTime );
-        StateType transmitterState =
-                stateFunctionOfTransmittingBody_( transmissionTime );
+        StateType receiverState;
+        StateType transmitterState;
+        ObservationScalarType previousLightTimeCalculation;
+        if( !isWarmStarted )
+        {
+            // Initialize reception and transmission times and states to initial guess (zero light time)
+            receiverState = getReceiverState( receptionTime );
+            transmitterState = getTransmitterState( transmissionTime );
 
-        // Set initial light-time correction.
-        setTotalLightTimeCorrection(
-                    transmitterState, receiverState, transmissionTime, receptionTime );
+            // Set initial light-time correction.
+            setTotalLightTimeCorrection(
+                        transmitterState, receiverState, transmissionTime, receptionTime );
+
+            // Calculate light-time solution assuming infinte speed of signal as initial estimate.
+            previousLightTimeCalculation = calculateNewLightTimeEstime( receiverState, transmitterState );
+        }
+        else
+        {
+            // Predict light time from previous solution(s), and set link end states at predicted times.
+            previousLightTimeCalculation = predictLightTime( time );
+            if( isTimeAtReception )
+            {
+                transmissionTime = time - previousLightTimeCalculation;
+            }
+            else
+            {
+                receptionTime = time + previousLightTimeCalculation;
+            }
+            receiverState = getReceiverState( receptionTime );
+            transmitterState = getTransmitterState( transmissionTime );
 
-        // Calculate light-time solution assuming infinte speed of signal as initial estimate.
-        ObservationScalarType previousLightTimeCalculation =
-                calculateNewLightTimeEstime( receiverState, transmitterState );
+            // Set initial light-time correction, at predicted link end times.
+            setTotalLightTimeCorrection(
+                        transmitterState, receiverState, transmissionTime, receptionTime );
+        }
 
         // Set variables for iteration
         ObservationScalarType newLightTimeCalculation = 0.0;
@@ -242,22 +401,28 @@ public:
             {
                 receptionTime = time;
                 transmissionTime = time - previousLightTimeCalculation;
-                transmitterState = ( stateFunctionOfTransmittingBody_( transmissionTime ) );
+                transmitterState = getTransmitterState( transmissionTime );
             }
             else
             {
                 receptionTime = time + previousLightTimeCalculation;
                 transmissionTime = time;
-                receiverState = ( stateFunctionOfReceivingBody_( receptionTime ) );
+                receiverState = getReceiverState( receptionTime );
             }
             newLightTimeCalculation = calculateNewLightTimeEstime( receiverState, transmitterState );
 
-            // Check for convergence.
-            if( fabs( newLightTimeCalculation - previousLightTimeCalculation ) < tolerance )
+            // Check for convergence. For a warm-started solution, the error of the new estimate is also bounded
+            // using the (linearized) contraction factor of the fixed-point iteration, which is typically sufficient
+            // to accept the first iteration, without an additional state function evaluation.
+            ObservationScalarType lightTimeChange = fabs( newLightTimeCalculation - previousLightTimeCalculation );
+            if( lightTimeChange < tolerance || ( isWarmStarted && computeFixedPointContractionFactor(
+                                                     receiverState, transmitterState, isTimeAtReception ) *
+                                                 lightTimeChange < tolerance ) )
             {
                 // If convergence reached, but light-time corrections not iterated,
-                // perform 1 more iteration to check for change in correction.
-                if( !updateLightTimeCorrections )
+                // perform 1 more iteration to check for change in correction (not needed for warm-started
+                // solution without corrections).
+                if( !updateLightTimeCorrections && !( isWarmStarted && correctionFunctions_.size( ) == 0 ) )
                 {
                     updateLightTimeCorrections = true;
                 }
@@ -290,19 +455,148 @@ public:
             counter++;
         }
 
+        // For warm-started solution, the iteration may have been accepted based on the contraction factor, in which
+        // case the iterated link end state is evaluated at a time that differs (slightly) from the final light time.
+        // Correct the position of this link end to first order, to make it consistent with the final light time.
+        if( isWarmStarted )
+        {
+            StateScalarType linkEndTimeDifference = static_cast< StateScalarType >(
+                        previousLightTimeCalculation - newLightTimeCalculation );
+            if( isTimeAtReception )
+            {
+                transmitterState.segment( 0, 3 ) += linkEndTimeDifference * transmitterState.segment( 3, 3 );
+            }
+            else
+            {
+                receiverState.segment( 0, 3 ) -= linkEndTimeDifference * receiverState.segment( 3, 3 );
+            }
+        }
+
         // Set output variables and return the light time.
         receiverStateOutput = receiverState;
         transmitterStateOutput = transmitterState;
 
+        // Store solution for warm-starting next solution.
+        for( int i = std::min( numberOfPreviousSolutions_, 2 ); i > 0; i-- )
+        {
+            previousTimes_[ i ] = previousTimes_[ i - 1 ];
+            previousLightTimes_[ i ] = previousLightTimes_[ i - 1 ];
+        }
+        previousTimes_[ 0 ] = time;
+        previousLightTimes_[ 0 ] = newLightTimeCalculation;
+        previousIsTimeAtReception_ = isTimeAtReception;
+        numberOfPreviousSolutions_ = std::min( numberOfPreviousSolutions_ + 1, 3 );
+
         return newLightTimeCalculation;
     }
 
-    std::vector< boost::shared_ptr< LightTimeCorrection > > getLightTimeCorrection( )
+    //! Function to predict the light time from previous solutions.
+    /*!
+     *  Function to predict the light time from previous solutions, by polynomial (Lagrange) extrapolation from the
+     *  previous (up to three) solutions. Solutions at coinciding input times are not used.
+     *  \param time Time at reception or transmission.
+     *  \return Predicted light time.
+     */
+    ObservationScalarType predictLightTime( const TimeType time )
     {
-        return correctionFunctions_;
+        // Determine number of solutions at distinct times.
+        int numberOfPredictionPoints = 1;
+        while( numberOfPredictionPoints < numberOfPreviousSolutions_ )
+        {
+            bool isTimeDistinct = true;
+            for( int i = 0; i < numberOfPredictionPoints; i++ )
+            {
+                if( previousTimes_[ numberOfPredictionPoints ] == previousTimes_[ i ] )
+                {
+                    isTimeDistinct = false;
+                }
+            }
+
+            if( !isTimeDistinct )
+            {
+                break;
+            }
+            numberOfPredictionPoints++;
+        }
+
+        // Extrapolate previous light times.
+        ObservationScalarType predictedLightTime = mathematical_constants::getFloatingInteger< ObservationScalarType >( 0 );
+        for( int i = 0; i < numberOfPredictionPoints; i++ )
+        {
+            ObservationScalarType currentWeight = mathematical_constants::getFloatingInteger< ObservationScalarType >( 1 );
+            for( int j = 0; j < numberOfPredictionPoints; j++ )
+            {
+                if( i != j )
+                {
+                    currentWeight *= static_cast< ObservationScalarType >( time - previousTimes_[ j ] ) /
+                            static_cast< ObservationScalarType >( previousTimes_[ i ] - previousTimes_[ j ] );
+                }
+            }
+            predictedLightTime += currentWeight * previousLightTimes_[ i ];
+        }
+        return predictedLightTime;
     }
 
-protected:
+    //! Function to compute the contraction factor of the light-time fixed-point iteration.
+    /*!
+     *  Function to compute the (linearized) contraction factor of the light-time fixed-point iteration, i.e. the
+     *  factor by which the error in the light-time estimate is reduced in a single iteration. This factor is equal to
+     *  the magnitude of the projection of the velocity of the link end at which the time is iterated onto the line of
+     *  sight, divided by the speed of light (and its complement).
+     *  \param receiverState State of receiver.
+     *  \param transmitterState State of transmitter.
+     *  \param isTimeAtReception True if input time is at reception, false if at transmission.
+     *  \return Upper bound of ratio of errors of new and previous light time estimates.
+     */
+    ObservationScalarType computeFixedPointContractionFactor(
+            const StateType& receiverState,
+            const StateType& transmitterState,
+            const bool isTimeAtReception ) const
+    {
+        Eigen::Matrix< ObservationScalarType, 3, 1 > lineOfSight =
+                ( receiverState - transmitterState ).segment( 0, 3 ).template cast< ObservationScalarType >( ).normalized( );
+        ObservationScalarType rangeRateRatio = std::fabs(
+                    lineOfSight.dot( ( isTimeAtReception ? transmitterState : receiverState ).segment( 3, 3 ).
+                                     template cast< ObservationScalarType >( ) ) ) /
+                physical_constants::getSpeedOfLight< ObservationScalarType >( );
+        return rangeRateRatio / ( mathematical_constants::getFloatingInteger< ObservationScalarType >( 1 ) - rangeRateRatio );
+    }
+
+    //! Function to retrieve the transmitter state, using the state cached at the previous call if the time is equal.
+    /*!
+     *  Function to retrieve the transmitter state, using the state cached at the previous call if the time is equal.
+     *  \param transmissionTime Time at which the state is to be retrieved.
+     *  \return Transmitter state at transmissionTime.
+     */
+    const StateType& getTransmitterState( const TimeType transmissionTime )
+    {
+        if( !isTransmitterStateCached_ || !( cachedTransmissionTime_ == transmissionTime ) )
+        {
+            cachedTransmitterState_ = stateFunctionOfTransmittingBody_( transmissionTime );
+            cachedTransmissionTime_ = transmissionTime;
+            isTransmitterStateCached_ = true;
+            numberOfStateFunctionEvaluations_++;
+        }
+        return cachedTransmitterState_;
+    }
+
+    //! Function to retrieve the receiver state, using the state cached at the previous call if the time is equal.
+    /*!
+     *  Function to retrieve the receiver state, using the state cached at the previous call if the time is equal.
+     *  \param receptionTime Time at which the state is to be retrieved.
+     *  \return Receiver state at receptionTime.
+     */
+    const StateType& getReceiverState( const TimeType receptionTime )
+    {
+        if( !isReceiverStateCached_ || !( cachedReceptionTime_ == receptionTime ) )
+        {
+            cachedReceiverState_ = stateFunctionOfReceivingBody_( receptionTime );
+            cachedReceptionTime_ = receptionTime;
+            isReceiverStateCached_ = true;
+            numberOfStateFunctionEvaluations_++;
+        }
+        return cachedReceiverState_;
+    }
 
     //! Transmitter state function.
     /*!
@@ -338,6 +632,42 @@ protected:
     //! Current light-time correction.
     double currentCorrection_;
 
+    //! Boolean denoting whether light-time solutions are warm-started from previous solutions.
+    bool useWarmStart_;
+
+    //! Number of previous solutions (up to 3) that are available for warm-starting the light-time solution.
+    int numberOfPreviousSolutions_;
+
+    //! Boolean denoting whether the input time of the previous solution was at reception.
+    bool previousIsTimeAtReception_;
+
+    //! Input times of previous light-time solutions (most recent first).
+    TimeType previousTimes_[ 3 ];
+
+    //! Previous light-time solutions (most recent first).
+    ObservationScalarType previousLightTimes_[ 3 ];
+
+    //! Boolean denoting whether cachedTransmitterState_ is set.
+    bool isTransmitterStateCached_;
+
+    //! Time at which transmitter state was last evaluated.
+    TimeType cachedTransmissionTime_;
+
+    //! Transmitter state at cachedTransmissionTime_
+    StateType cachedTransmitterState_;
+
+    //! Boolean denoting whether cachedReceiverState_ is set.
+    bool isReceiverStateCached_;
+
+    //! Time at which receiver state was last evaluated.
+    TimeType cachedReceptionTime_;
+
+    //! Receiver state at cachedReceptionTime_
+    StateType cachedReceiverState_;
+
+    //! Total number of evaluations of the link end state functions.
+    int numberOfStateFunctionEvaluations_;
+
     //! Function to calculate a new light-time estimate from the link-ends states.
     /*!
      *  Function to calculate a new light-time estimate from the states of the two ends of the
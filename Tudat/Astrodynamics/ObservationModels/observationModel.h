@@ -182,7 +182,7 @@ public:
         // Check if any non-ideal models are set.
         if( isBiasNull_ )
         {
-            return computeObservations( time, linkEndAssociatedWithTime );
+            return computeIdealObservations( time, linkEndAssociatedWithTime );
         }
         else
         {
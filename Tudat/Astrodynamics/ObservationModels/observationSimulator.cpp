@@ -0,0 +1,88 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <set>
+
+#include "Tudat/Astrodynamics/ObservationModels/observationSimulator.h"
+
+namespace tudat
+{
+
+namespace observation_models
+{
+
+//! Function to divide a list of links into groups that do not share any bodies.
+std::vector< std::vector< unsigned int > > groupLinksBySharedBodies(
+        const std::vector< std::vector< std::string > >& linkBodies )
+{
+    std::vector< std::vector< unsigned int > > linkGroups;
+    std::vector< std::set< std::string > > groupBodies;
+
+    for( unsigned int linkIndex = 0; linkIndex < linkBodies.size( ); linkIndex++ )
+    {
+        // Find first group that shares a body with the current link, and merge all other such groups into it.
+        int currentGroup = -1;
+        for( unsigned int groupIndex = 0; groupIndex < linkGroups.size( ); )
+        {
+            bool isBodyShared = false;
+            for( unsigned int i = 0; i < linkBodies.at( linkIndex ).size( ); i++ )
+            {
+                if( groupBodies.at( groupIndex ).count( linkBodies.at( linkIndex ).at( i ) ) > 0 )
+                {
+                    isBodyShared = true;
+                    break;
+                }
+            }
+
+            if( !isBodyShared )
+            {
+                groupIndex++;
+            }
+            else if( currentGroup < 0 )
+            {
+                currentGroup = groupIndex;
+                groupIndex++;
+            }
+            else
+            {
+                linkGroups.at( currentGroup ).insert( linkGroups.at( currentGroup ).end( ),
+                                                      linkGroups.at( groupIndex ).begin( ),
+                                                      linkGroups.at( groupIndex ).end( ) );
+                groupBodies.at( currentGroup ).insert( groupBodies.at( groupIndex ).begin( ),
+                                                       groupBodies.at( groupIndex ).end( ) );
+                linkGroups.erase( linkGroups.begin( ) + groupIndex );
+                groupBodies.erase( groupBodies.begin( ) + groupIndex );
+            }
+        }
+
+        // Create new group if no body is shared with an existing group.
+        if( currentGroup < 0 )
+        {
+            currentGroup = linkGroups.size( );
+            linkGroups.push_back( std::vector< unsigned int >( ) );
+            groupBodies.push_back( std::set< std::string >( ) );
+        }
+
+        linkGroups.at( currentGroup ).push_back( linkIndex );
+        groupBodies.at( currentGroup ).insert( linkBodies.at( linkIndex ).begin( ), linkBodies.at( linkIndex ).end( ) );
+    }
+
+    // Restore original order of links in merged groups.
+    for( unsigned int groupIndex = 0; groupIndex < linkGroups.size( ); groupIndex++ )
+    {
+        std::sort( linkGroups.at( groupIndex ).begin( ), linkGroups.at( groupIndex ).end( ) );
+    }
+
+    return linkGroups;
+}
+
+} // namespace observation_models
+
+} // namespace tudat
@@ -0,0 +1,654 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_OBSERVATIONSIMULATOR_H
+#define TUDAT_OBSERVATIONSIMULATOR_H
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/parallelization.h"
+#include "Tudat/Astrodynamics/ObservationModels/linkTypeDefs.h"
+#include "Tudat/Astrodynamics/ObservationModels/observableTypes.h"
+#include "Tudat/Astrodynamics/ObservationModels/angularPositionObservationModel.h"
+#include "Tudat/Astrodynamics/ObservationModels/observationModel.h"
+#include "Tudat/Astrodynamics/ObservationModels/oneWayRangeObservationModel.h"
+#include "Tudat/Astrodynamics/ObservationModels/ObservableCorrections/firstOrderRelativisticLightTimeCorrection.h"
+
+namespace tudat
+{
+
+namespace observation_models
+{
+
+//! Class to store a batch of simulated observations of a single observable type, for a single set of link ends.
+/*!
+ *  Class to store a batch of simulated observations of a single observable type, for a single set of link ends. All
+ *  observations, link end times and link end states are stored in contiguous arrays, which are sized once before the
+ *  simulation of the batch. The observations are stored in order of increasing observation time.
+ */
+template< typename ObservationScalarType = double, typename TimeType = double,
+          typename StateScalarType = ObservationScalarType >
+class SingleLinkObservationBatch
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param observableType Type of observable that is stored in the batch.
+     *  \param referenceLinkEnd Link end at which the observation times are valid.
+     */
+    SingleLinkObservationBatch( const ObservableType observableType,
+                                const LinkEndType referenceLinkEnd ):
+        observableType_( observableType ), referenceLinkEnd_( referenceLinkEnd ),
+        observationSize_( 0 ), numberOfLinkEnds_( 0 ){ }
+
+    //! Function to (re)size the batch for a given number of observations.
+    /*!
+     *  Function to (re)size the batch for a given number of observations.
+     *  \param observationTimes Times at which observations are to be stored (in ascending order).
+     *  \param observationSize Size of a single observation.
+     *  \param numberOfLinkEnds Number of link ends involved in a single observation.
+     */
+    void resize( const std::vector< TimeType >& observationTimes,
+                 const int observationSize,
+                 const int numberOfLinkEnds )
+    {
+        observationTimes_ = observationTimes;
+        observationSize_ = observationSize;
+        numberOfLinkEnds_ = numberOfLinkEnds;
+
+        observations_.resize( observationSize_ * observationTimes_.size( ) );
+        linkEndTimes_.resize( numberOfLinkEnds_ * observationTimes_.size( ) );
+        linkEndStates_.resize( 6, numberOfLinkEnds_ * observationTimes_.size( ) );
+    }
+
+    //! Function to retrieve the type of observable that is stored in the batch.
+    /*!
+     *  Function to retrieve the type of observable that is stored in the batch.
+     *  \return Type of observable that is stored in the batch.
+     */
+    ObservableType getObservableType( )
+    {
+        return observableType_;
+    }
+
+    //! Function to retrieve the link end at which the observation times are valid.
+    /*!
+     *  Function to retrieve the link end at which the observation times are valid.
+     *  \return Link end at which the observation times are valid.
+     */
+    LinkEndType getReferenceLinkEnd( )
+    {
+        return referenceLinkEnd_;
+    }
+
+    //! Function to retrieve the number of observations in the batch.
+    /*!
+     *  Function to retrieve the number of observations in the batch.
+     *  \return Number of observations in the batch.
+     */
+    int getNumberOfObservations( )
+    {
+        return observationTimes_.size( );
+    }
+
+    //! Function to retrieve the size of a single observation.
+    /*!
+     *  Function to retrieve the size of a single observation.
+     *  \return Size of a single observation.
+     */
+    int getObservationSize( )
+    {
+        return observationSize_;
+    }
+
+    //! Function to retrieve the number of link ends involved in a single observation.
+    /*!
+     *  Function to retrieve the number of link ends involved in a single observation.
+     *  \return Number of link ends involved in a single observation.
+     */
+    int getNumberOfLinkEnds( )
+    {
+        return numberOfLinkEnds_;
+    }
+
+    //! Function to retrieve the times (at reference link end) of the observations.
+    /*!
+     *  Function to retrieve the times (at reference link end) of the observations, in ascending order.
+     *  \return Times (at reference link end) of the observations.
+     */
+    std::vector< TimeType >& getObservationTimes( )
+    {
+        return observationTimes_;
+    }
+
+    //! Function to retrieve the concatenated vector of all observations.
+    /*!
+     *  Function to retrieve the concatenated vector of all observations. Entries
+     *  [ i * observationSize, ( i + 1 ) * observationSize ) contain the observation at the i-th observation time.
+     *  \return Concatenated vector of all observations.
+     */
+    Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 >& getObservations( )
+    {
+        return observations_;
+    }
+
+    //! Function to retrieve the list of all link end times
+    /*!
+     *  Function to retrieve the list of all link end times. Entry i * numberOfLinkEnds + j contains the time at the j-th
+     *  link end (in the order returned by ObservationModel::computeObservationsWithLinkEndData) for the i-th observation.
+     *  \return List of all link end times
+     */
+    std::vector< TimeType >& getLinkEndTimes( )
+    {
+        return linkEndTimes_;
+    }
+
+    //! Function to retrieve the matrix of all link end states
+    /*!
+     *  Function to retrieve the matrix of all link end states. Column i * numberOfLinkEnds + j contains the state of the
+     *  j-th link end (in the order returned by ObservationModel::computeObservationsWithLinkEndData) for the i-th
+     *  observation.
+     *  \return Matrix of all link end states
+     */
+    Eigen::Matrix< StateScalarType, 6, Eigen::Dynamic >& getLinkEndStates( )
+    {
+        return linkEndStates_;
+    }
+
+    //! Function to retrieve a single observation from the batch.
+    /*!
+     *  Function to retrieve a single observation from the batch.
+     *  \param observationIndex Index of observation (in the list of sorted observation times).
+     *  \return Observation at requested index.
+     */
+    Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > getSingleObservation( const int observationIndex )
+    {
+        return observations_.segment( observationIndex * observationSize_, observationSize_ );
+    }
+
+    //! Function to retrieve the state of a single link end for a single observation from the batch.
+    /*!
+     *  Function to retrieve the state of a single link end for a single observation from the batch.
+     *  \param observationIndex Index of observation (in the list of sorted observation times).
+     *  \param linkEndIndex Index of link end (in the order returned by
+     *  ObservationModel::computeObservationsWithLinkEndData)
+     *  \return State of requested link end, for requested observation.
+     */
+    Eigen::Matrix< StateScalarType, 6, 1 > getSingleLinkEndState( const int observationIndex, const int linkEndIndex )
+    {
+        return linkEndStates_.col( observationIndex * numberOfLinkEnds_ + linkEndIndex );
+    }
+
+private:
+
+    //! Type of observable that is stored in the batch.
+    ObservableType observableType_;
+
+    //! Link end at which the observation times are valid.
+    LinkEndType referenceLinkEnd_;
+
+    //! Size of a single observation.
+    int observationSize_;
+
+    //! Number of link ends involved in a single observation.
+    int numberOfLinkEnds_;
+
+    //! Times (at reference link end) of the observations, in ascending order.
+    std::vector< TimeType > observationTimes_;
+
+    //! Concatenated vector of all observations.
+    Eigen::Matrix< ObservationScalarType, Eigen::Dynamic, 1 > observations_;
+
+    //! List of all link end times (see getLinkEndTimes).
+    std::vector< TimeType > linkEndTimes_;
+
+    //! Matrix of all link end states (see getLinkEndStates).
+    Eigen::Matrix< StateScalarType, 6, Eigen::Dynamic > linkEndStates_;
+
+};
+
+//! Base class for simulating batches of observations of a single observable type, for a single set of link ends.
+/*!
+ *  Base class for simulating batches of observations of a single observable type, for a single set of link ends. This
+ *  base class is used to allow observation models of different size (ObservationSize template argument) to be handled
+ *  through the same interface.
+ */
+template< typename ObservationScalarType = double, typename TimeType = double,
+          typename StateScalarType = ObservationScalarType >
+class SingleLinkObservationSimulatorBase
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param observableType Type of observable that is simulated.
+     */
+    SingleLinkObservationSimulatorBase( const ObservableType observableType ):
+        observableType_( observableType ){ }
+
+    //! Destructor
+    virtual ~SingleLinkObservationSimulatorBase( ){ }
+
+    //! Function to simulate a batch of observations.
+    /*!
+     *  Function to simulate a batch of observations.
+     *  \param observationTimes Times at which the observations are to be simulated (need not be sorted).
+     *  \param observationBatch Object in which the simulated observations are stored (returned by reference).
+     */
+    virtual void simulateObservations(
+            const std::vector< TimeType >& observationTimes,
+            SingleLinkObservationBatch< ObservationScalarType, TimeType, StateScalarType >& observationBatch ) = 0;
+
+    //! Function to retrieve the type of observable that is simulated.
+    /*!
+     *  Function to retrieve the type of observable that is simulated.
+     *  \return Type of observable that is simulated.
+     */
+    ObservableType getObservableType( )
+    {
+        return observableType_;
+    }
+
+protected:
+
+    //! Type of observable that is simulated.
+    ObservableType observableType_;
+};
+
+//! Function to retrieve the light-time calculators used by an observation model.
+/*!
+ *  Function to retrieve the light-time calculators used by an observation model (one-way range and angular position
+ *  observation models).
+ *  \param observationModel Observation model for which the light-time calculators are to be retrieved.
+ *  \return Light-time calculators used by the observation model (empty if model uses no light-time calculator).
+ */
+template< int ObservationSize, typename ObservationScalarType, typename TimeType, typename StateScalarType >
+std::vector< boost::shared_ptr< LightTimeCalculator< ObservationScalarType, TimeType, StateScalarType > > >
+getObservationModelLightTimeCalculators(
+        const boost::shared_ptr< ObservationModel< ObservationSize, ObservationScalarType, TimeType, StateScalarType > >
+        observationModel )
+{
+    std::vector< boost::shared_ptr< LightTimeCalculator< ObservationScalarType, TimeType, StateScalarType > > >
+            lightTimeCalculators;
+
+    boost::shared_ptr< OneWayRangeObservationModel< ObservationScalarType, TimeType, StateScalarType > >
+            oneWayRangeModel = boost::dynamic_pointer_cast<
+            OneWayRangeObservationModel< ObservationScalarType, TimeType, StateScalarType > >( observationModel );
+    boost::shared_ptr< AngularPositionObservationModel< ObservationScalarType, TimeType, StateScalarType > >
+            angularPositionModel = boost::dynamic_pointer_cast<
+            AngularPositionObservationModel< ObservationScalarType, TimeType, StateScalarType > >( observationModel );
+
+    if( oneWayRangeModel != NULL )
+    {
+        lightTimeCalculators.push_back( oneWayRangeModel->getLightTimeCalculator( ) );
+    }
+    else if( angularPositionModel != NULL )
+    {
+        lightTimeCalculators.push_back( angularPositionModel->getLightTimeCalculator( ) );
+    }
+
+    return lightTimeCalculators;
+}
+
+//! Function to retrieve the names of the bodies of which the state is evaluated when computing an observation.
+/*!
+ *  Function to retrieve the names of the bodies of which the state is evaluated when computing an observation of a
+ *  given observation model: the bodies of the link ends, and the perturbing bodies of any first-order relativistic
+ *  light-time correction.
+ *  \param linkEnds Link ends of the observation model.
+ *  \param observationModel Observation model for which the bodies are to be retrieved.
+ *  \return Names of the bodies of which the state is evaluated when computing an observation (without duplicates).
+ */
+template< int ObservationSize, typename ObservationScalarType, typename TimeType, typename StateScalarType >
+std::vector< std::string > getBodiesEvaluatedByObservationModel(
+        const LinkEnds& linkEnds,
+        const boost::shared_ptr< ObservationModel< ObservationSize, ObservationScalarType, TimeType, StateScalarType > >
+        observationModel )
+{
+    std::vector< std::string > evaluatedBodies;
+    for( LinkEnds::const_iterator linkEndIterator = linkEnds.begin( ); linkEndIterator != linkEnds.end( );
+         linkEndIterator++ )
+    {
+        evaluatedBodies.push_back( linkEndIterator->second.first );
+    }
+
+    std::vector< boost::shared_ptr< LightTimeCalculator< ObservationScalarType, TimeType, StateScalarType > > >
+            lightTimeCalculators = getObservationModelLightTimeCalculators( observationModel );
+    for( unsigned int i = 0; i < lightTimeCalculators.size( ); i++ )
+    {
+        std::vector< boost::shared_ptr< LightTimeCorrection > > lightTimeCorrections =
+                lightTimeCalculators.at( i )->getLightTimeCorrection( );
+        for( unsigned int j = 0; j < lightTimeCorrections.size( ); j++ )
+        {
+            boost::shared_ptr< FirstOrderLightTimeCorrectionCalculator > relativisticCorrection =
+                    boost::dynamic_pointer_cast< FirstOrderLightTimeCorrectionCalculator >( lightTimeCorrections.at( j ) );
+            if( relativisticCorrection != NULL )
+            {
+                std::vector< std::string > perturbingBodies = relativisticCorrection->getPerturbingBodyNames( );
+                evaluatedBodies.insert( evaluatedBodies.end( ), perturbingBodies.begin( ), perturbingBodies.end( ) );
+            }
+        }
+    }
+
+    std::sort( evaluatedBodies.begin( ), evaluatedBodies.end( ) );
+    evaluatedBodies.erase( std::unique( evaluatedBodies.begin( ), evaluatedBodies.end( ) ), evaluatedBodies.end( ) );
+    return evaluatedBodies;
+}
+
+//! Function to divide a list of links into groups that do not share any bodies.
+/*!
+ *  Function to divide a list of links into groups, such that no two links in different groups evaluate the state of
+ *  the same body (i.e. links that share a body, directly or through other links, are in the same group). The groups
+ *  are ordered by their first link, and the links in each group are in their original order.
+ *  \param linkBodies Names of the bodies of which the state is evaluated, per link.
+ *  \return Indices (in linkBodies) of the links in each group.
+ */
+std::vector< std::vector< unsigned int > > groupLinksBySharedBodies(
+        const std::vector< std::vector< std::string > >& linkBodies );
+
+//! Class for simulating batches of observations of a single observable type, for a single set of link ends.
+/*!
+ *  Class for simulating batches of observations of a single observable type, for a single set of link ends, from a
+ *  single ObservationModel. The observations are computed in order of increasing time, so that the state functions of
+ *  the link ends (e.g. tabulated ephemerides using a hunting algorithm, or bodies caching their state at the current
+ *  epoch) are evaluated at slowly varying times. The light-time solutions of the observation model are warm-started
+ *  from the solutions at the preceding observation times (see LightTimeCalculator::setUseWarmStart) during the
+ *  simulation of a batch, so that typically a single iteration is required per light-time solution. The link end
+ *  time/state vectors that are passed to the observation model are member variables, so that no (de-)allocations take
+ *  place for each observation.
+ */
+template< int ObservationSize = 1, typename ObservationScalarType = double, typename TimeType = double,
+          typename StateScalarType = ObservationScalarType >
+class SingleLinkObservationSimulator: public SingleLinkObservationSimulatorBase<
+        ObservationScalarType, TimeType, StateScalarType >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param observationModel Observation model that is used to simulate the observations.
+     */
+    SingleLinkObservationSimulator(
+            const boost::shared_ptr< ObservationModel< ObservationSize, ObservationScalarType, TimeType, StateScalarType > >
+            observationModel ):
+        SingleLinkObservationSimulatorBase< ObservationScalarType, TimeType, StateScalarType >(
+            observationModel->getObservableType( ) ),
+        observationModel_( observationModel ),
+        lightTimeCalculators_( getObservationModelLightTimeCalculators( observationModel ) ){ }
+
+    //! Destructor
+    ~SingleLinkObservationSimulator( ){ }
+
+    //! Function to simulate a batch of observations.
+    /*!
+     *  Function to simulate a batch of observations from the observation model, including any observation biases. The
+     *  light-time solutions are warm-started from the previous observation(s) in the batch, after which the
+     *  warm-start setting of the light-time calculators is restored (and their warm-start history reset).
+     *  \param observationTimes Times at which the observations are to be simulated (need not be sorted).
+     *  \param observationBatch Object in which the simulated observations are stored (returned by reference).
+     */
+    void simulateObservations(
+            const std::vector< TimeType >& observationTimes,
+            SingleLinkObservationBatch< ObservationScalarType, TimeType, StateScalarType >& observationBatch )
+    {
+        // Sort observation times
+        std::vector< TimeType > sortedObservationTimes = observationTimes;
+        if( !std::is_sorted( sortedObservationTimes.begin( ), sortedObservationTimes.end( ) ) )
+        {
+            std::sort( sortedObservationTimes.begin( ), sortedObservationTimes.end( ) );
+        }
+
+        if( sortedObservationTimes.size( ) == 0 )
+        {
+            observationBatch.resize( sortedObservationTimes, ObservationSize, 0 );
+            return;
+        }
+
+        // Warm-start light-time solutions from previous observations in batch.
+        std::vector< bool > useWarmStart;
+        for( unsigned int i = 0; i < lightTimeCalculators_.size( ); i++ )
+        {
+            useWarmStart.push_back( lightTimeCalculators_.at( i )->getUseWarmStart( ) );
+            lightTimeCalculators_.at( i )->setUseWarmStart( true );
+        }
+
+        LinkEndType referenceLinkEnd = observationBatch.getReferenceLinkEnd( );
+        for( unsigned int i = 0; i < sortedObservationTimes.size( ); i++ )
+        {
+            // Compute current observation, and size batch from number of link ends for first observation.
+            currentObservation_ = observationModel_->computeObservationsWithLinkEndData(
+                        sortedObservationTimes[ i ], referenceLinkEnd, currentLinkEndTimes_, currentLinkEndStates_ );
+            if( i == 0 )
+            {
+                observationBatch.resize( sortedObservationTimes, ObservationSize, currentLinkEndStates_.size( ) );
+            }
+
+            // Store current observation and link end data.
+            int numberOfLinkEnds = observationBatch.getNumberOfLinkEnds( );
+            observationBatch.getObservations( ).segment( i * ObservationSize, ObservationSize ) = currentObservation_;
+            for( int j = 0; j < numberOfLinkEnds; j++ )
+            {
+                observationBatch.getLinkEndTimes( )[ i * numberOfLinkEnds + j ] = currentLinkEndTimes_[ j ];
+                observationBatch.getLinkEndStates( ).col( i * numberOfLinkEnds + j ) = currentLinkEndStates_[ j ];
+            }
+        }
+
+        // Restore warm-start settings of light-time calculators.
+        for( unsigned int i = 0; i < lightTimeCalculators_.size( ); i++ )
+        {
+            lightTimeCalculators_.at( i )->setUseWarmStart( useWarmStart.at( i ) );
+        }
+    }
+
+    //! Function to retrieve the observation model that is used to simulate the observations.
+    /*!
+     *  Function to retrieve the observation model that is used to simulate the observations.
+     *  \return Observation model that is used to simulate the observations.
+     */
+    boost::shared_ptr< ObservationModel< ObservationSize, ObservationScalarType, TimeType, StateScalarType > >
+    getObservationModel( )
+    {
+        return observationModel_;
+    }
+
+private:
+
+    //! Observation model that is used to simulate the observations.
+    boost::shared_ptr< ObservationModel< ObservationSize, ObservationScalarType, TimeType, StateScalarType > >
+    observationModel_;
+
+    //! Light-time calculators used by the observation model (warm-started during simulation of a batch).
+    std::vector< boost::shared_ptr< LightTimeCalculator< ObservationScalarType, TimeType, StateScalarType > > >
+    lightTimeCalculators_;
+
+    //! Pre-declared current observation, to prevent many (de-)allocations
+    Eigen::Matrix< ObservationScalarType, ObservationSize, 1 > currentObservation_;
+
+    //! Pre-declared list of link end times, to prevent many (de-)allocations
+    std::vector< TimeType > currentLinkEndTimes_;
+
+    //! Pre-declared list of link end states, to prevent many (de-)allocations
+    std::vector< Eigen::Matrix< StateScalarType, 6, 1 > > currentLinkEndStates_;
+};
+
+//! Class for simulating observations of any number of observable types and link ends in a single call.
+/*!
+ *  Class for simulating observations of any number of observable types and link ends in a single call, for instance
+ *  to simulate a complete tracking schedule. The observations of each set of link ends are simulated by a
+ *  SingleLinkObservationSimulator, and the results are returned as a SingleLinkObservationBatch per observable type
+ *  and link ends.
+ *
+ *  The links may be simulated concurrently on a number of threads. Since the link end state functions of links that
+ *  involve the same body typically use the same simulation_setup::Body (and ephemeris) object, which caches its
+ *  current state and is therefore not safe for concurrent evaluation, the links are first divided into groups that do
+ *  not share any body (see groupLinksBySharedBodies). The groups are simulated concurrently, and the links in a group
+ *  one after the other, so that the results do not depend on the number of threads. The bodies of a link are retrieved
+ *  with getBodiesEvaluatedByObservationModel; any other body that is evaluated by a link (for instance the ephemeris
+ *  origin of a link end body, or a body used by a user-defined light-time correction) must be provided when adding the
+ *  observation model. By default, a single thread is used.
+ */
+template< typename ObservationScalarType = double, typename TimeType = double,
+          typename StateScalarType = ObservationScalarType >
+class BatchObservationSimulator
+{
+public:
+
+    //! Typedef for the batch of observations of a single link.
+    typedef SingleLinkObservationBatch< ObservationScalarType, TimeType, StateScalarType > ObservationBatch;
+
+    //! Typedef for the list of observation batches, per observable type and link ends.
+    typedef std::map< ObservableType, std::map< LinkEnds, boost::shared_ptr< ObservationBatch > > >
+    ObservationBatchList;
+
+    //! Typedef for the list of observation times and reference link ends, per observable type and link ends.
+    typedef std::map< ObservableType, std::map< LinkEnds, std::pair< std::vector< TimeType >, LinkEndType > > >
+    ObservationsToSimulateList;
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param numberOfThreads Number of threads over which the simulation of the groups of links that do not share any
+     *  body is distributed.
+     */
+    BatchObservationSimulator( const unsigned int numberOfThreads = 1 ):
+        numberOfThreads_( numberOfThreads ){ }
+
+    //! Function to add an observation model for a given set of link ends.
+    /*!
+     *  Function to add an observation model for a given set of link ends, overriding any existing model of the same
+     *  observable type for the same link ends.
+     *  \param linkEnds Link ends for which the observation model is to be used.
+     *  \param observationModel Observation model that is to be added.
+     *  \param additionalEvaluatedBodies Names of bodies of which the state is evaluated by the observation model, in
+     *  addition to those retrieved by getBodiesEvaluatedByObservationModel (default none).
+     */
+    template< int ObservationSize >
+    void addObservationModel(
+            const LinkEnds& linkEnds,
+            const boost::shared_ptr< ObservationModel< ObservationSize, ObservationScalarType, TimeType, StateScalarType > >
+            observationModel,
+            const std::vector< std::string >& additionalEvaluatedBodies = std::vector< std::string >( ) )
+    {
+        singleLinkSimulators_[ observationModel->getObservableType( ) ][ linkEnds ] =
+                boost::make_shared< SingleLinkObservationSimulator<
+                ObservationSize, ObservationScalarType, TimeType, StateScalarType > >( observationModel );
+
+        std::vector< std::string > evaluatedBodies = getBodiesEvaluatedByObservationModel( linkEnds, observationModel );
+        evaluatedBodies.insert( evaluatedBodies.end( ), additionalEvaluatedBodies.begin( ),
+                                additionalEvaluatedBodies.end( ) );
+        evaluatedBodies_[ observationModel->getObservableType( ) ][ linkEnds ] = evaluatedBodies;
+    }
+
+    //! Function to simulate observations for any number of observable types and link ends.
+    /*!
+     *  Function to simulate observations for any number of observable types and link ends. The observations of each
+     *  combination of observable type and link ends are simulated as a single batch. Groups of links that do not share
+     *  any body are distributed over the threads set in the constructor.
+     *  \param observationsToSimulate List of observation times (need not be sorted) and associated reference link end,
+     *  per observable type and link ends.
+     *  \return List of simulated observation batches, per observable type and link ends.
+     */
+    ObservationBatchList simulateObservations( const ObservationsToSimulateList& observationsToSimulate )
+    {
+        ObservationBatchList observationBatches;
+
+        // Create list of all links that are to be simulated, and create output batch for each.
+        std::vector< boost::shared_ptr< SingleLinkObservationSimulatorBase<
+                ObservationScalarType, TimeType, StateScalarType > > > linkSimulators;
+        std::vector< const std::vector< TimeType >* > linkObservationTimes;
+        std::vector< boost::shared_ptr< ObservationBatch > > linkObservationBatches;
+        std::vector< std::vector< std::string > > linkBodies;
+        for( typename ObservationsToSimulateList::const_iterator observableIterator = observationsToSimulate.begin( );
+             observableIterator != observationsToSimulate.end( ); observableIterator++ )
+        {
+            for( typename std::map< LinkEnds, std::pair< std::vector< TimeType >, LinkEndType > >::const_iterator
+                 linkIterator = observableIterator->second.begin( ); linkIterator != observableIterator->second.end( );
+                 linkIterator++ )
+            {
+                if( singleLinkSimulators_.count( observableIterator->first ) == 0 ||
+                        singleLinkSimulators_.at( observableIterator->first ).count( linkIterator->first ) == 0 )
+                {
+                    throw std::runtime_error(
+                                "Error when simulating observations of type " +
+                                getObservableName( observableIterator->first ) + ", no model found for link ends." );
+                }
+
+                boost::shared_ptr< ObservationBatch > currentBatch = boost::make_shared< ObservationBatch >(
+                            observableIterator->first, linkIterator->second.second );
+                observationBatches[ observableIterator->first ][ linkIterator->first ] = currentBatch;
+
+                linkSimulators.push_back(
+                            singleLinkSimulators_.at( observableIterator->first ).at( linkIterator->first ) );
+                linkObservationTimes.push_back( &( linkIterator->second.first ) );
+                linkObservationBatches.push_back( currentBatch );
+                linkBodies.push_back( evaluatedBodies_.at( observableIterator->first ).at( linkIterator->first ) );
+            }
+        }
+
+        // Simulate observations of all links, concurrently for links that do not share any body.
+        std::vector< std::vector< unsigned int > > linkGroups = groupLinksBySharedBodies( linkBodies );
+        utilities::executeParallelLoop(
+                    linkGroups.size( ),
+                    [ &linkGroups, &linkSimulators, &linkObservationTimes, &linkObservationBatches ](
+                    const unsigned int groupIndex )
+        {
+            for( unsigned int i = 0; i < linkGroups[ groupIndex ].size( ); i++ )
+            {
+                unsigned int linkIndex = linkGroups[ groupIndex ][ i ];
+                linkSimulators[ linkIndex ]->simulateObservations(
+                            *linkObservationTimes[ linkIndex ], *linkObservationBatches[ linkIndex ] );
+            }
+        }, numberOfThreads_ );
+
+        return observationBatches;
+    }
+
+    //! Function to reset the number of threads over which the simulation of the groups of links is distributed.
+    /*!
+     *  Function to reset the number of threads over which the simulation of the groups of links that do not share any
+     *  body is distributed.
+     *  \param numberOfThreads Number of threads over which the simulation of the groups of links is distributed.
+     */
+    void setNumberOfThreads( const unsigned int numberOfThreads )
+    {
+        numberOfThreads_ = numberOfThreads;
+    }
+
+private:
+
+    //! Objects for simulating observations of a single link, per observable type and link ends.
+    std::map< ObservableType, std::map< LinkEnds, boost::shared_ptr< SingleLinkObservationSimulatorBase<
+    ObservationScalarType, TimeType, StateScalarType > > > > singleLinkSimulators_;
+
+    //! Names of bodies of which the state is evaluated by the observation models, per observable type and link ends.
+    std::map< ObservableType, std::map< LinkEnds, std::vector< std::string > > > evaluatedBodies_;
+
+    //! Number of threads over which the simulation of the groups of links that do not share any body is distributed.
+    unsigned int numberOfThreads_;
+
+};
+
+} // namespace observation_models
+
+} // namespace tudat
+
+#endif // TUDAT_OBSERVATIONSIMULATOR_H
@@ -150,10 +150,12 @@ public:
         observation *= physical_constants::getSpeedOfLight< ObservationScalarType >( );
 
         // Set link end states and times.
+        linkEndTimes.clear( );
         linkEndTimes.push_back( transmissionTime );
         linkEndTimes.push_back( receptionTime );
 
-        linkEndStates.push_back( transmitterState);
+        linkEndStates.clear( );
+        linkEndStates.push_back( transmitterState );
         linkEndStates.push_back( receiverState );
 
         return ( Eigen::Matrix< ObservationScalarType, 1, 1 >( ) << observation ).finished( );
@@ -21,6 +21,7 @@
 #include <boost/lambda/lambda.hpp>
 
 #include "Tudat/Astrodynamics/Aerodynamics/exponentialAtmosphere.h"
+#include "Tudat/Astrodynamics/Ephemerides/simpleRotationalEphemeris.h"
 #include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
 #include "Tudat/External/SpiceInterface/spiceInterface.h"
 #include "Tudat/InputOutput/basicInputOutput.h"
@@ -279,6 +280,116 @@ BOOST_AUTO_TEST_CASE( testRadiationPressureAccelerationPartials )
                                        partialWrtRadiationPressureCoefficient, 1.0E-12 );
 }
 
+BOOST_AUTO_TEST_CASE( testPanelledRadiationPressureAccelerationPartials )
+{
+    // Create empty bodies, vehicle and sun.
+    boost::shared_ptr< Body > vehicle = boost::make_shared< Body >( );
+    vehicle->setConstantBodyMass( 400.0 );
+    boost::shared_ptr< Body > sun = boost::make_shared< Body >( );
+
+    NamedBodyMap bodyMap;
+    bodyMap[ "Vehicle" ] = vehicle;
+    bodyMap[ "Sun" ] = sun;
+
+    // Set current state of sun and vehicle.
+    Eigen::Vector6d sunState;
+    sunState << 1.0E9, -2.0E9, 5.0E8, 10.0, -5.0, 1.0;
+    sun->setState( sunState );
+    Eigen::Vector6d vehicleState;
+    vehicleState << 1.1E11, 6.5E10, 2.8E10, -1.4E4, 2.6E4, 1.1E4;
+    vehicle->setState( vehicleState );
+
+    // Set vehicle orientation.
+    vehicle->setRotationalEphemeris(
+                boost::make_shared< ephemerides::SimpleRotationalEphemeris >(
+                    Eigen::Quaterniond( Eigen::AngleAxisd( 0.4, Eigen::Vector3d::UnitX( ) ) *
+                                        Eigen::AngleAxisd( -1.2, Eigen::Vector3d::UnitZ( ) ) ),
+                    1.0E-3, 0.0, "ECLIPJ2000", "VehicleFixed" ) );
+    vehicle->setCurrentRotationalStateToLocalFrameFromEphemeris( 0.0 );
+
+    // Create links to set and get state functions of bodies.
+    boost::function< void( Eigen::Vector6d ) > sunStateSetFunction =
+            boost::bind( &Body::setState, sun, _1 );
+    boost::function< void( Eigen::Vector6d ) > vehicleStateSetFunction =
+            boost::bind( &Body::setState, vehicle, _1 );
+
+    // Create radiation pressure and panelled surface properties of vehicle
+    boost::shared_ptr< RadiationPressureInterface > radiationPressureInterface =
+            createRadiationPressureInterface( boost::make_shared< CannonBallRadiationPressureInterfaceSettings >(
+                                                  "Sun", mathematical_constants::PI * 0.3 * 0.3, 1.2 ), "Vehicle", bodyMap );
+    radiationPressureInterface->updateInterface( 0.0 );
+    vehicle->setRadiationPressureInterface( "Sun", radiationPressureInterface );
+
+    boost::shared_ptr< system_models::VehicleSystems > vehicleSystems =
+            boost::make_shared< system_models::VehicleSystems >( );
+    vehicleSystems->setPanelledSurfaceModel(
+                boost::make_shared< system_models::PanelledSurfaceModel >(
+                    system_models::createBoxWingPanelledSurfaceModel(
+                        Eigen::Vector3d( 1.0, 1.5, 2.0 ), 8.0, Eigen::Vector3d( 0.1, 0.2, 1.0 ),
+                        0.2, 0.3, 0.05, 0.1, 0.3, 0.2 ) ) );
+    vehicle->setVehicleSystems( vehicleSystems );
+
+    // Create acceleration model.
+    boost::shared_ptr< PanelledRadiationPressureAcceleration > accelerationModel =
+            createPanelledRadiationPressureAccelerationModel( vehicle, sun, "Vehicle", "Sun" );
+    accelerationModel->updateMembers( 0.0 );
+
+    // Create partial-calculating object.
+    boost::shared_ptr< AccelerationPartial > accelerationPartial =
+            createAnalyticalAccelerationPartial( accelerationModel, std::make_pair( "Vehicle", vehicle ),
+                                                 std::make_pair( "Sun", sun ), bodyMap );
+
+    // Calculate analytical partials.
+    accelerationPartial->update( 0.0 );
+    Eigen::MatrixXd partialWrtSunPosition = Eigen::Matrix3d::Zero( );
+    accelerationPartial->wrtPositionOfAcceleratingBody( partialWrtSunPosition.block( 0, 0, 3, 3 ) );
+    Eigen::MatrixXd partialWrtVehiclePosition = Eigen::Matrix3d::Zero( );
+    accelerationPartial->wrtPositionOfAcceleratedBody( partialWrtVehiclePosition.block( 0, 0, 3, 3 ) );
+    Eigen::MatrixXd partialWrtVehicleVelocity = Eigen::Matrix3d::Zero( );
+    accelerationPartial->wrtVelocityOfAcceleratedBody( partialWrtVehicleVelocity.block( 0, 0, 3, 3 ), 1, 0, 0 );
+    Eigen::MatrixXd partialWrtVehicleMass = Eigen::Vector3d::Zero( );
+    accelerationPartial->wrtNonTranslationalStateOfAdditionalBody(
+                partialWrtVehicleMass.block( 0, 0, 3, 1 ), std::make_pair( "Vehicle", "" ),
+                propagators::body_mass_state );
+
+    // Calculate numerical partials.
+    Eigen::Vector3d positionPerturbation;
+    positionPerturbation << 10000.0, 10000.0, 10000.0;
+    Eigen::Vector3d velocityPerturbation;
+    velocityPerturbation << 1.0, 1.0, 1.0;
+
+    boost::function< void( ) > updateFunction =
+            boost::bind( &RadiationPressureInterface::updateInterface, radiationPressureInterface, 0.0 );
+    Eigen::Matrix3d testPartialWrtSunPosition = calculateAccelerationWrtStatePartials(
+                sunStateSetFunction, accelerationModel, sun->getState( ), positionPerturbation, 0, updateFunction );
+    Eigen::Matrix3d testPartialWrtVehiclePosition = calculateAccelerationWrtStatePartials(
+                vehicleStateSetFunction, accelerationModel, vehicle->getState( ), positionPerturbation, 0, updateFunction );
+    Eigen::Matrix3d testPartialWrtVehicleVelocity = calculateAccelerationWrtStatePartials(
+                vehicleStateSetFunction, accelerationModel, vehicle->getState( ), velocityPerturbation, 3, updateFunction );
+
+    Eigen::Vector3d nominalAcceleration = accelerationModel->getAcceleration( );
+    vehicle->setConstantBodyMass( 400.0 + 1.0E-3 );
+    accelerationModel->resetTime( TUDAT_NAN );
+    Eigen::Vector3d upPerturbedAcceleration = basic_astrodynamics::updateAndGetAcceleration< Eigen::Vector3d >(
+                accelerationModel );
+    vehicle->setConstantBodyMass( 400.0 - 1.0E-3 );
+    accelerationModel->resetTime( TUDAT_NAN );
+    Eigen::Vector3d testPartialWrtVehicleMass = ( upPerturbedAcceleration -
+            basic_astrodynamics::updateAndGetAcceleration< Eigen::Vector3d >( accelerationModel ) ) / 2.0E-3;
+    vehicle->setConstantBodyMass( 400.0 );
+
+    // Compare numerical and analytical results.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( testPartialWrtSunPosition,
+                                       partialWrtSunPosition, 1.0E-8 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( testPartialWrtVehiclePosition,
+                                       partialWrtVehiclePosition, 1.0E-8 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( testPartialWrtVehicleVelocity,
+                                       partialWrtVehicleVelocity, std::numeric_limits< double >::epsilon( ) );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( testPartialWrtVehicleMass,
+                                       partialWrtVehicleMass, 1.0E-8 );
+    BOOST_CHECK( nominalAcceleration.norm( ) > 0.0 );
+}
+
 
 BOOST_AUTO_TEST_CASE( testThirdBodyGravityPartials )
 {
@@ -0,0 +1,82 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include "Tudat/Astrodynamics/OrbitDetermination/AccelerationPartials/panelledRadiationPressureAccelerationPartial.h"
+
+namespace tudat
+{
+
+namespace acceleration_partials
+{
+
+//! Calculates partial derivative of panelled radiation pressure force w.r.t. the unit vector to the source.
+Eigen::Matrix3d computePartialOfPanelledRadiationPressureForceWrtVectorToSource(
+        const double radiationPressure,
+        const Eigen::Vector3d& vectorToSource,
+        system_models::PanelledSurfaceModel& panelledSurfaceModel )
+{
+    const Eigen::Matrix3Xd& panelNormals = panelledSurfaceModel.getPanelNormals( );
+
+    // Compute cosines of incidence angles, and mask of illuminated panels.
+    const Eigen::ArrayXd unclippedCosines = ( panelNormals.transpose( ) * vectorToSource ).array( );
+    const Eigen::ArrayXd isIlluminated = ( unclippedCosines > 0.0 ).cast< double >( );
+    const Eigen::ArrayXd cosines = unclippedCosines * isIlluminated;
+
+    // Compute partials of force components along source direction and panel normals.
+    const Eigen::ArrayXd& sourceDirectionFactors = panelledSurfaceModel.getRadiationPressureSourceDirectionFactors( );
+    const Eigen::VectorXd sourceDirectionCosinePartials = ( isIlluminated * sourceDirectionFactors ).matrix( );
+    const Eigen::VectorXd normalCosinePartials =
+            ( isIlluminated * ( 2.0 * cosines * panelledSurfaceModel.getRadiationPressureSpecularNormalFactors( ) +
+                                panelledSurfaceModel.getRadiationPressureDiffuseNormalFactors( ) ) ).matrix( );
+
+    return -radiationPressure * (
+                ( cosines * sourceDirectionFactors ).sum( ) * Eigen::Matrix3d::Identity( ) +
+                vectorToSource * ( panelNormals * sourceDirectionCosinePartials ).transpose( ) +
+                panelNormals * normalCosinePartials.asDiagonal( ) * panelNormals.transpose( ) );
+}
+
+//! Function for updating partial w.r.t. the bodies' positions
+void PanelledRadiationPressurePartial::update( const double currentTime )
+{
+    if( !( currentTime_ == currentTime ) )
+    {
+        // Compute helper quantities.
+        Eigen::Vector3d rangeVector = ( sourceBodyState_( ) - acceleratedBodyState_( ) );
+        double range = rangeVector.norm( );
+        Eigen::Vector3d vectorToSource = rangeVector / range;
+
+        Eigen::Matrix3d rotationToInertialFrame =
+                radiationPressureAcceleration_->getCurrentRotationToInertialFrame( ).toRotationMatrix( );
+        double radiationPressure = radiationPressureAcceleration_->getCurrentRadiationPressure( );
+        double mass = radiationPressureAcceleration_->getCurrentMass( );
+        Eigen::Vector3d vectorToSourceInBodyFixedFrame = rotationToInertialFrame.transpose( ) * vectorToSource;
+
+        // Compute acceleration and its partial w.r.t. the (inertial) unit vector to the source.
+        Eigen::Vector3d acceleration = rotationToInertialFrame * electro_magnetism::computePanelledRadiationPressureForce(
+                    radiationPressure, vectorToSourceInBodyFixedFrame,
+                    *radiationPressureAcceleration_->getPanelledSurfaceModel( ) ) / mass;
+        Eigen::Matrix3d partialWrtVectorToSource =
+                rotationToInertialFrame * computePartialOfPanelledRadiationPressureForceWrtVectorToSource(
+                    radiationPressure, vectorToSourceInBodyFixedFrame,
+                    *radiationPressureAcceleration_->getPanelledSurfaceModel( ) ) *
+                rotationToInertialFrame.transpose( ) / mass;
+
+        // Compute position partial, from inverse square dependency of radiation pressure on range and dependency of
+        // source direction on position.
+        currentPartialWrtPosition_ =
+                ( 2.0 * acceleration * vectorToSource.transpose( ) - partialWrtVectorToSource * (
+                      Eigen::Matrix3d::Identity( ) - vectorToSource * vectorToSource.transpose( ) ) ) / range;
+        currentTime_ = currentTime;
+    }
+}
+
+} // namespace acceleration_partials
+
+} // namespace tudat
@@ -0,0 +1,187 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_PANELLEDRADIATIONPRESSUREACCELERATIONPARTIAL_H
+#define TUDAT_PANELLEDRADIATIONPRESSUREACCELERATIONPARTIAL_H
+
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Astrodynamics/OrbitDetermination/AccelerationPartials/accelerationPartial.h"
+#include "Tudat/Astrodynamics/ElectroMagnetism/panelledRadiationPressureAcceleration.h"
+
+namespace tudat
+{
+
+namespace acceleration_partials
+{
+
+//! Calculates partial derivative of panelled radiation pressure force w.r.t. the unit vector to the source.
+/*!
+ * Calculates partial derivative of panelled radiation pressure force w.r.t. the unit vector to the source (both
+ * expressed in the body-fixed frame of the body undergoing the acceleration), for constant radiation pressure.
+ * \param radiationPressure Current radiation pressure (in N/m^2)
+ * \param vectorToSource Unit vector from body undergoing acceleration to source of radiation, in body-fixed frame.
+ * \param panelledSurfaceModel Panelled surface model of the body undergoing the acceleration.
+ * \return Partial derivative of panelled radiation pressure force w.r.t. the unit vector to the source.
+ */
+Eigen::Matrix3d computePartialOfPanelledRadiationPressureForceWrtVectorToSource(
+        const double radiationPressure,
+        const Eigen::Vector3d& vectorToSource,
+        system_models::PanelledSurfaceModel& panelledSurfaceModel );
+
+//! Class to calculate the partials of the panelled radiation pressure acceleration w.r.t. parameters and states.
+/*!
+ *  Class to calculate the partials of the panelled radiation pressure acceleration w.r.t. parameters and states. The
+ *  dependency of the radiation pressure on the distance to the source is included, the dependency of the shadow
+ *  function and the body orientation on the states is not.
+ */
+class PanelledRadiationPressurePartial: public AccelerationPartial
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor.
+     * \param radiationPressureAcceleration Panelled radiation pressure acceleration model w.r.t. which partials are to
+     * be computed.
+     * \param acceleratedBody Name of the body undergoing acceleration.
+     * \param acceleratingBody Name of the body exerting acceleration.
+     */
+    PanelledRadiationPressurePartial(
+            const boost::shared_ptr< electro_magnetism::PanelledRadiationPressureAcceleration >
+            radiationPressureAcceleration,
+            const std::string& acceleratedBody, const std::string& acceleratingBody ):
+        AccelerationPartial( acceleratedBody, acceleratingBody,
+                             basic_astrodynamics::panelled_radiation_pressure ),
+        radiationPressureAcceleration_( radiationPressureAcceleration ),
+        sourceBodyState_( radiationPressureAcceleration->getSourcePositionFunction( ) ),
+        acceleratedBodyState_( radiationPressureAcceleration->getAcceleratedBodyPositionFunction( ) ){ }
+
+    //! Destructor.
+    ~PanelledRadiationPressurePartial( ){ }
+
+    //! Function for calculating the partial of the acceleration w.r.t. the position of body undergoing acceleration..
+    /*!
+     *  Function for calculating the partial of the acceleration w.r.t. the position of body undergoing acceleration
+     *  and adding it to exting partial block.
+     *  Update( ) function must have been called during current time step before calling this function.
+     *  \param partialMatrix Block of partial derivatives of acceleration w.r.t. Cartesian position of body
+     *  undergoing acceleration where current partial is to be added.
+     *  \param addContribution Variable denoting whether to return the partial itself (true) or the negative partial (false).
+     *  \param startRow First row in partialMatrix block where the computed partial is to be added.
+     *  \param startColumn First column in partialMatrix block where the computed partial is to be added.
+     */
+    void wrtPositionOfAcceleratedBody( Eigen::Block< Eigen::MatrixXd > partialMatrix,
+                                       const bool addContribution = 1, const int startRow = 0, const int startColumn = 0 )
+    {
+        if( addContribution )
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) += currentPartialWrtPosition_;
+        }
+        else
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) -= currentPartialWrtPosition_;
+        }
+    }
+
+    //! Function for calculating the partial of the acceleration w.r.t. the position of body exerting acceleration..
+    /*!
+     *  Function for calculating the partial of the acceleration w.r.t. the position of body exerting acceleration and
+     *  adding it to exting partial block.
+     *  The update( ) function must have been called during current time step before calling this function.
+     *  \param partialMatrix Block of partial derivatives of acceleration w.r.t. Cartesian position of body
+     *  exerting acceleration where current partial is to be added.
+     *  \param addContribution Variable denoting whether to return the partial itself (true) or the negative partial (false).
+     *  \param startRow First row in partialMatrix block where the computed partial is to be added.
+     *  \param startColumn First column in partialMatrix block where the computed partial is to be added.
+     */
+    void wrtPositionOfAcceleratingBody( Eigen::Block< Eigen::MatrixXd > partialMatrix,
+                                        const bool addContribution = 1, const int startRow = 0, const int startColumn = 0 )
+    {
+        if( addContribution )
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) -= currentPartialWrtPosition_;
+        }
+        else
+        {
+            partialMatrix.block( startRow, startColumn, 3, 3 ) += currentPartialWrtPosition_;
+        }
+    }
+
+    //! Function for calculating the partial of the acceleration w.r.t. a non-translational integrated state
+    /*!
+     *  Function for calculating the partial of the acceleration w.r.t. a non-translational integrated state
+     *  and adding it to the existing partial block.
+     *  \param partialMatrix Block of partial derivatives of where current partial is to be added.
+     *  \param stateReferencePoint Reference point id of propagated state
+     *  \param integratedStateType Type of propagated state for which partial is to be computed.
+     */
+    void wrtNonTranslationalStateOfAdditionalBody(
+            Eigen::Block< Eigen::MatrixXd > partialMatrix,
+            const std::pair< std::string, std::string >& stateReferencePoint,
+            const propagators::IntegratedStateType integratedStateType )
+    {
+        if( stateReferencePoint.first == acceleratedBody_ && integratedStateType == propagators::body_mass_state )
+        {
+            partialMatrix.block( 0, 0, 3, 1 ) -= radiationPressureAcceleration_->getAcceleration( ) /
+                    radiationPressureAcceleration_->getCurrentMass( );
+        }
+    }
+
+    //! Function for determining if the acceleration is dependent on a non-translational integrated state.
+    /*!
+     *  Function for determining if the acceleration is dependent on a non-translational integrated state.
+     *  \param stateReferencePoint Reference point id of propagated state
+     *  \param integratedStateType Type of propagated state for which dependency is to be determined.
+     *  \return True if dependency exists (non-zero partial), false otherwise.
+     */
+    bool isStateDerivativeDependentOnIntegratedNonTranslationalState(
+            const std::pair< std::string, std::string >& stateReferencePoint,
+            const propagators::IntegratedStateType integratedStateType )
+    {
+        bool isDependent = 0;
+
+        // Acceleration is dependent on mass of body undergoing acceleration.
+        if( stateReferencePoint.first == acceleratedBody_ && integratedStateType == propagators::body_mass_state )
+        {
+            isDependent = 1;
+        }
+        return isDependent;
+    }
+
+    //! Function for updating partial w.r.t. the bodies' positions
+    /*!
+     *  Function for updating common blocks of partial to current state. For the radiation pressure acceleration,
+     *  position partial is computed and set.
+     *  \param currentTime Time at which partials are to be calculated
+     */
+    void update( const double currentTime = 0.0 );
+
+private:
+
+    //! Panelled radiation pressure acceleration model w.r.t. which partials are computed.
+    boost::shared_ptr< electro_magnetism::PanelledRadiationPressureAcceleration > radiationPressureAcceleration_;
+
+    //! Function returning position of radiation source.
+    boost::function< Eigen::Vector3d( ) > sourceBodyState_;
+
+    //! Function returning position of body undergoing acceleration.
+    boost::function< Eigen::Vector3d( )> acceleratedBodyState_;
+
+    //! Current partial of acceleration w.r.t. position of body undergoing acceleration (equal to minus partial w.r.t.
+    //! position of body exerting acceleration).
+    Eigen::Matrix3d currentPartialWrtPosition_;
+};
+
+} // namespace acceleration_partials
+
+} // namespace tudat
+
+#endif // TUDAT_PANELLEDRADIATIONPRESSUREACCELERATIONPARTIAL_H
@@ -0,0 +1,153 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <limits>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/bind.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/ObservationModels/angularPositionObservationModel.h"
+#include "Tudat/Astrodynamics/ObservationModels/oneWayRangeObservationModel.h"
+#include "Tudat/Astrodynamics/OrbitDetermination/ObservationPartials/linkEndStatePartials.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::observation_models;
+using namespace tudat::observation_partials;
+
+//! Function to compute the state of a link end, moving on a circular orbit, with a constant position offset.
+Eigen::Vector6d getOffsetCircularOrbitState( const double time, const double radius, const double meanMotion,
+                                             const Eigen::Vector3d* positionOffset )
+{
+    Eigen::Vector6d state;
+    state << radius * std::cos( meanMotion * time ), radius * std::sin( meanMotion * time ), 0.0,
+            -radius * meanMotion * std::sin( meanMotion * time ),
+            radius * meanMotion * std::cos( meanMotion * time ), 0.0;
+    state.segment( 0, 3 ) += *positionOffset;
+    return state;
+}
+
+BOOST_AUTO_TEST_SUITE( test_link_end_state_partials )
+
+//! Test partials of one-way range and angular position w.r.t. link end positions, by numerical differentiation.
+BOOST_AUTO_TEST_CASE( testLinkEndStatePartials )
+{
+    // Create link end state functions, with offsets that are used for numerical differentiation.
+    Eigen::Vector3d transmitterOffset = Eigen::Vector3d::Zero( );
+    Eigen::Vector3d receiverOffset = Eigen::Vector3d::Zero( );
+    boost::function< Eigen::Vector6d( const double ) > transmitterStateFunction =
+            boost::bind( &getOffsetCircularOrbitState, _1, 2.0E7, 2.0E-4, &transmitterOffset );
+    boost::function< Eigen::Vector6d( const double ) > receiverStateFunction =
+            boost::bind( &getOffsetCircularOrbitState, _1, 6.4E6, 7.3E-5, &receiverOffset );
+    receiverOffset << 0.0, 0.0, 1.0E6;
+
+    std::vector< ObservableType > observableTypes;
+    observableTypes.push_back( oneWayRange );
+    observableTypes.push_back( angular_position );
+
+    std::vector< LinkEndType > referenceLinkEnds;
+    referenceLinkEnds.push_back( receiver );
+    referenceLinkEnds.push_back( transmitter );
+
+    double observationTime = 1.0E4;
+    for( unsigned int i = 0; i < observableTypes.size( ); i++ )
+    {
+        // Create observation model
+        boost::shared_ptr< ObservationModel< 1 > > rangeModel;
+        boost::shared_ptr< ObservationModel< 2 > > angularPositionModel;
+        if( observableTypes.at( i ) == oneWayRange )
+        {
+            rangeModel = boost::make_shared< OneWayRangeObservationModel< > >(
+                        boost::make_shared< LightTimeCalculator< > >( transmitterStateFunction, receiverStateFunction ) );
+        }
+        else
+        {
+            angularPositionModel = boost::make_shared< AngularPositionObservationModel< > >(
+                        boost::make_shared< LightTimeCalculator< > >( transmitterStateFunction, receiverStateFunction ) );
+        }
+
+        for( unsigned int j = 0; j < referenceLinkEnds.size( ); j++ )
+        {
+            // Compute observation and analytical partials at nominal link end states.
+            std::vector< double > linkEndTimes;
+            std::vector< Eigen::Vector6d > linkEndStates;
+            Eigen::VectorXd nominalObservation = ( rangeModel != NULL ) ?
+                        Eigen::VectorXd( rangeModel->computeObservationsWithLinkEndData(
+                                             observationTime, referenceLinkEnds.at( j ), linkEndTimes, linkEndStates ) ) :
+                        Eigen::VectorXd( angularPositionModel->computeObservationsWithLinkEndData(
+                                             observationTime, referenceLinkEnds.at( j ), linkEndTimes, linkEndStates ) );
+            Eigen::MatrixXd analyticalPartial = computeObservationPartialWrtLinkEndStates(
+                        observableTypes.at( i ), linkEndStates, referenceLinkEnds.at( j ) );
+
+            BOOST_CHECK_EQUAL( analyticalPartial.rows( ), nominalObservation.rows( ) );
+            BOOST_CHECK_EQUAL( analyticalPartial.cols( ), 12 );
+
+            // Compute partials w.r.t. link end positions numerically.
+            double positionPerturbation = 10.0;
+            Eigen::MatrixXd numericalPartial = Eigen::MatrixXd::Zero( nominalObservation.rows( ), 12 );
+            for( unsigned int linkEndIndex = 0; linkEndIndex < 2; linkEndIndex++ )
+            {
+                Eigen::Vector3d& currentOffset = ( linkEndIndex == 0 ) ? transmitterOffset : receiverOffset;
+                for( unsigned int k = 0; k < 3; k++ )
+                {
+                    Eigen::VectorXd upperturbedObservation, downperturbedObservation;
+
+                    currentOffset( k ) += positionPerturbation;
+                    upperturbedObservation = ( rangeModel != NULL ) ?
+                                Eigen::VectorXd( rangeModel->computeObservations(
+                                                     observationTime, referenceLinkEnds.at( j ) ) ) :
+                                Eigen::VectorXd( angularPositionModel->computeObservations(
+                                                     observationTime, referenceLinkEnds.at( j ) ) );
+
+                    currentOffset( k ) -= 2.0 * positionPerturbation;
+                    downperturbedObservation = ( rangeModel != NULL ) ?
+                                Eigen::VectorXd( rangeModel->computeObservations(
+                                                     observationTime, referenceLinkEnds.at( j ) ) ) :
+                                Eigen::VectorXd( angularPositionModel->computeObservations(
+                                                     observationTime, referenceLinkEnds.at( j ) ) );
+                    currentOffset( k ) += positionPerturbation;
+
+                    numericalPartial.col( 6 * linkEndIndex + k ) =
+                            ( upperturbedObservation - downperturbedObservation ) / ( 2.0 * positionPerturbation );
+                }
+            }
+
+            // Compare position partials, and check that velocity partials are zero.
+            for( int k = 0; k < numericalPartial.rows( ); k++ )
+            {
+                double partialScale = analyticalPartial.row( k ).cwiseAbs( ).maxCoeff( );
+                for( unsigned int linkEndIndex = 0; linkEndIndex < 2; linkEndIndex++ )
+                {
+                    for( unsigned int l = 0; l < 3; l++ )
+                    {
+                        BOOST_CHECK_SMALL( analyticalPartial( k, 6 * linkEndIndex + l ) -
+                                           numericalPartial( k, 6 * linkEndIndex + l ), 1.0E-7 * partialScale );
+                        BOOST_CHECK_EQUAL( analyticalPartial( k, 6 * linkEndIndex + l + 3 ), 0.0 );
+                    }
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,174 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <stdexcept>
+
+#include <boost/lexical_cast.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "Tudat/Astrodynamics/OrbitDetermination/ObservationPartials/linkEndStatePartials.h"
+
+namespace tudat
+{
+
+namespace observation_partials
+{
+
+//! Function to retrieve the link end types of an observable, in the order in which their states are computed.
+std::vector< observation_models::LinkEndType > getLinkEndTypesOfObservable(
+        const observation_models::ObservableType observableType )
+{
+    using namespace observation_models;
+
+    std::vector< LinkEndType > linkEndTypes;
+    switch( observableType )
+    {
+    case oneWayRange:
+    case angular_position:
+        linkEndTypes.push_back( transmitter );
+        linkEndTypes.push_back( receiver );
+        break;
+    case position_observable:
+        linkEndTypes.push_back( observed_body );
+        break;
+    default:
+        throw std::runtime_error( "Error, link end types not defined for observable " +
+                                  boost::lexical_cast< std::string >( observableType ) );
+    }
+
+    return linkEndTypes;
+}
+
+//! Function to compute the partial of the light-time-corrected distance w.r.t. the receiver position.
+/*!
+ *  Function to compute the partial of the light-time-corrected distance between transmitter and receiver w.r.t. the
+ *  receiver position (the partial w.r.t. the transmitter position is the negative of this value).
+ *  \param transmitterState Cartesian state of transmitter at transmission time.
+ *  \param receiverState Cartesian state of receiver at reception time.
+ *  \param isTimeAtReception Boolean denoting whether the observation time is fixed at the receiver.
+ *  \param lineOfSightVector Unit vector from transmitter to receiver (returned by reference).
+ *  \param movingLinkEndVelocity Velocity of the link end at which the time is not fixed (returned by reference).
+ *  \return Partial of the distance w.r.t. receiver position.
+ */
+Eigen::Matrix< double, 1, 3 > computeLightTimeCorrectedDistancePartial(
+        const Eigen::Vector6d& transmitterState,
+        const Eigen::Vector6d& receiverState,
+        const bool isTimeAtReception,
+        Eigen::Vector3d& lineOfSightVector,
+        Eigen::Vector3d& movingLinkEndVelocity )
+{
+    lineOfSightVector = ( receiverState.segment( 0, 3 ) - transmitterState.segment( 0, 3 ) ).normalized( );
+    movingLinkEndVelocity = isTimeAtReception ? transmitterState.segment( 3, 3 ) : receiverState.segment( 3, 3 );
+
+    return lineOfSightVector.transpose( ) /
+            ( 1.0 - lineOfSightVector.dot( movingLinkEndVelocity ) / physical_constants::SPEED_OF_LIGHT );
+}
+
+//! Function to compute the partial of the one-way range w.r.t. the Cartesian states of its link ends.
+Eigen::Matrix< double, 1, 12 > computeOneWayRangePartialWrtLinkEndStates(
+        const Eigen::Vector6d& transmitterState,
+        const Eigen::Vector6d& receiverState,
+        const bool isTimeAtReception )
+{
+    Eigen::Vector3d lineOfSightVector, movingLinkEndVelocity;
+    Eigen::Matrix< double, 1, 3 > distancePartial = computeLightTimeCorrectedDistancePartial(
+                transmitterState, receiverState, isTimeAtReception, lineOfSightVector, movingLinkEndVelocity );
+
+    Eigen::Matrix< double, 1, 12 > rangePartial = Eigen::Matrix< double, 1, 12 >::Zero( );
+    rangePartial.block( 0, 0, 1, 3 ) = -distancePartial;
+    rangePartial.block( 0, 6, 1, 3 ) = distancePartial;
+
+    return rangePartial;
+}
+
+//! Function to compute the partial of the angular position w.r.t. the Cartesian states of its link ends.
+Eigen::Matrix< double, 2, 12 > computeAngularPositionPartialWrtLinkEndStates(
+        const Eigen::Vector6d& transmitterState,
+        const Eigen::Vector6d& receiverState,
+        const bool isTimeAtReception )
+{
+    Eigen::Vector3d lineOfSightVector, movingLinkEndVelocity;
+    Eigen::Matrix< double, 1, 3 > distancePartial = computeLightTimeCorrectedDistancePartial(
+                transmitterState, receiverState, isTimeAtReception, lineOfSightVector, movingLinkEndVelocity );
+
+    // Compute partial of relative position (transmitter w.r.t. receiver) w.r.t. receiver position, including
+    // change in position of link end at which time is not fixed, due to change in light time.
+    Eigen::Matrix3d relativePositionPartial = -Eigen::Matrix3d::Identity( ) -
+            movingLinkEndVelocity * distancePartial / physical_constants::SPEED_OF_LIGHT;
+
+    // Compute partials of right ascension and declination w.r.t. relative position.
+    Eigen::Vector3d relativePosition = transmitterState.segment( 0, 3 ) - receiverState.segment( 0, 3 );
+    double squaredEquatorialDistance =
+            relativePosition.x( ) * relativePosition.x( ) + relativePosition.y( ) * relativePosition.y( );
+    double equatorialDistance = std::sqrt( squaredEquatorialDistance );
+    double squaredDistance = relativePosition.squaredNorm( );
+
+    Eigen::Matrix< double, 2, 3 > angularPositionPartial;
+    angularPositionPartial << -relativePosition.y( ) / squaredEquatorialDistance,
+            relativePosition.x( ) / squaredEquatorialDistance, 0.0,
+            -relativePosition.x( ) * relativePosition.z( ) / ( squaredDistance * equatorialDistance ),
+            -relativePosition.y( ) * relativePosition.z( ) / ( squaredDistance * equatorialDistance ),
+            equatorialDistance / squaredDistance;
+
+    Eigen::Matrix< double, 2, 12 > observationPartial = Eigen::Matrix< double, 2, 12 >::Zero( );
+    observationPartial.block( 0, 0, 2, 3 ) = -angularPositionPartial * relativePositionPartial;
+    observationPartial.block( 0, 6, 2, 3 ) = angularPositionPartial * relativePositionPartial;
+
+    return observationPartial;
+}
+
+//! Function to compute the partial of an observable w.r.t. the Cartesian states of its link ends.
+Eigen::MatrixXd computeObservationPartialWrtLinkEndStates(
+        const observation_models::ObservableType observableType,
+        const std::vector< Eigen::Vector6d >& linkEndStates,
+        const observation_models::LinkEndType referenceLinkEnd )
+{
+    using namespace observation_models;
+
+    Eigen::MatrixXd observationPartial;
+    switch( observableType )
+    {
+    case oneWayRange:
+        if( linkEndStates.size( ) != 2 )
+        {
+            throw std::runtime_error( "Error when computing one-way range partials, expected 2 link end states" );
+        }
+        observationPartial = computeOneWayRangePartialWrtLinkEndStates(
+                    linkEndStates.at( 0 ), linkEndStates.at( 1 ), referenceLinkEnd == receiver );
+        break;
+    case angular_position:
+        if( linkEndStates.size( ) != 2 )
+        {
+            throw std::runtime_error(
+                        "Error when computing angular position partials, expected 2 link end states" );
+        }
+        observationPartial = computeAngularPositionPartialWrtLinkEndStates(
+                    linkEndStates.at( 0 ), linkEndStates.at( 1 ), referenceLinkEnd == receiver );
+        break;
+    case position_observable:
+        if( linkEndStates.size( ) != 1 )
+        {
+            throw std::runtime_error(
+                        "Error when computing position observable partials, expected 1 link end state" );
+        }
+        observationPartial = Eigen::MatrixXd::Zero( 3, 6 );
+        observationPartial.block( 0, 0, 3, 3 ).setIdentity( );
+        break;
+    default:
+        throw std::runtime_error( "Error, link end state partials not implemented for observable " +
+                                  boost::lexical_cast< std::string >( observableType ) );
+    }
+
+    return observationPartial;
+}
+
+} // namespace observation_partials
+
+} // namespace tudat
@@ -0,0 +1,91 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_LINKENDSTATEPARTIALS_H
+#define TUDAT_LINKENDSTATEPARTIALS_H
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/basicTypedefs.h"
+#include "Tudat/Astrodynamics/ObservationModels/linkTypeDefs.h"
+#include "Tudat/Astrodynamics/ObservationModels/observableTypes.h"
+
+namespace tudat
+{
+
+namespace observation_partials
+{
+
+//! Function to retrieve the link end types of an observable, in the order in which their states are computed.
+/*!
+ *  Function to retrieve the link end types of an observable, in the order in which their states are returned by
+ *  ObservationModel::computeObservationsWithLinkEndData.
+ *  \param observableType Type of observable for which link end types are to be retrieved.
+ *  \return Link end types of observable, in order of link end states.
+ */
+std::vector< observation_models::LinkEndType > getLinkEndTypesOfObservable(
+        const observation_models::ObservableType observableType );
+
+//! Function to compute the partial of the one-way range w.r.t. the Cartesian states of its link ends.
+/*!
+ *  Function to compute the partial of the one-way range w.r.t. the Cartesian states of its link ends, including the
+ *  first-order effect of the change in light time on the state of the link end at which the time is not fixed.
+ *  Light-time corrections (e.g. relativistic) are not included in the partials.
+ *  \param transmitterState Cartesian state of transmitter at transmission time.
+ *  \param receiverState Cartesian state of receiver at reception time.
+ *  \param isTimeAtReception Boolean denoting whether the observation time is fixed at the receiver (true) or
+ *  transmitter (false).
+ *  \return Partial of one-way range w.r.t. transmitter state (columns 0-5) and receiver state (columns 6-11).
+ */
+Eigen::Matrix< double, 1, 12 > computeOneWayRangePartialWrtLinkEndStates(
+        const Eigen::Vector6d& transmitterState,
+        const Eigen::Vector6d& receiverState,
+        const bool isTimeAtReception );
+
+//! Function to compute the partial of the angular position w.r.t. the Cartesian states of its link ends.
+/*!
+ *  Function to compute the partial of the angular position (right ascension, declination of transmitter, as seen from
+ *  receiver) w.r.t. the Cartesian states of its link ends, including the first-order effect of the change in light time
+ *  on the state of the link end at which the time is not fixed. Light-time corrections (e.g. relativistic) are not
+ *  included in the partials.
+ *  \param transmitterState Cartesian state of transmitter at transmission time.
+ *  \param receiverState Cartesian state of receiver at reception time.
+ *  \param isTimeAtReception Boolean denoting whether the observation time is fixed at the receiver (true) or
+ *  transmitter (false).
+ *  \return Partial of right ascension (row 0) and declination (row 1) w.r.t. transmitter state (columns 0-5) and
+ *  receiver state (columns 6-11).
+ */
+Eigen::Matrix< double, 2, 12 > computeAngularPositionPartialWrtLinkEndStates(
+        const Eigen::Vector6d& transmitterState,
+        const Eigen::Vector6d& receiverState,
+        const bool isTimeAtReception );
+
+//! Function to compute the partial of an observable w.r.t. the Cartesian states of its link ends.
+/*!
+ *  Function to compute the partial of an observable w.r.t. the Cartesian states of its link ends, with the link end
+ *  states in the order in which they are returned by ObservationModel::computeObservationsWithLinkEndData.
+ *  \param observableType Type of observable for which partials are to be computed.
+ *  \param linkEndStates Cartesian states of the link ends at the link end times of the observation.
+ *  \param referenceLinkEnd Link end at which the observation time is fixed.
+ *  \return Partial of observable w.r.t. link end states; columns 6 * j to 6 * j + 5 contain the partial w.r.t. the j-th
+ *  link end state.
+ */
+Eigen::MatrixXd computeObservationPartialWrtLinkEndStates(
+        const observation_models::ObservableType observableType,
+        const std::vector< Eigen::Vector6d >& linkEndStates,
+        const observation_models::LinkEndType referenceLinkEnd );
+
+} // namespace observation_partials
+
+} // namespace tudat
+
+#endif // TUDAT_LINKENDSTATEPARTIALS_H
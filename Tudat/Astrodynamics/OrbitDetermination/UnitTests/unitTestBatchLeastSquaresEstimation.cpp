@@ -0,0 +1,281 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <limits>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+
+#include <Eigen/QR>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Astrodynamics/Ephemerides/tabulatedEphemeris.h"
+#include "Tudat/Astrodynamics/OrbitDetermination/normalEquationsAccumulator.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createBodies.h"
+#include "Tudat/SimulationSetup/PropagationSetup/createNumericalSimulator.h"
+#include "Tudat/SimulationSetup/EstimationSetup/createEstimatableParameters.h"
+#include "Tudat/SimulationSetup/EstimationSetup/batchLeastSquaresEstimator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::simulation_setup;
+using namespace tudat::basic_astrodynamics;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+using namespace tudat::estimatable_parameters;
+using namespace tudat::observation_models;
+using namespace tudat::orbital_element_conversions;
+using namespace tudat::orbit_determination;
+
+BOOST_AUTO_TEST_SUITE( test_batch_least_squares_estimation )
+
+//! Test whether block-wise accumulation of normal equations reproduces the direct least-squares solution.
+BOOST_AUTO_TEST_CASE( testNormalEquationsAccumulator )
+{
+    int numberOfObservations = 200;
+    int numberOfParameters = 8;
+
+    // Create design matrix with badly scaled columns, and weighted observations.
+    Eigen::MatrixXd designMatrix = Eigen::MatrixXd::Random( numberOfObservations, numberOfParameters );
+    for( int i = 0; i < numberOfParameters; i++ )
+    {
+        designMatrix.col( i ) *= std::pow( 10.0, i - 4 );
+    }
+    Eigen::VectorXd residuals = Eigen::VectorXd::Random( numberOfObservations );
+    Eigen::VectorXd weights = Eigen::VectorXd::Random( numberOfObservations ).cwiseAbs( ) +
+            Eigen::VectorXd::Constant( numberOfObservations, 0.5 );
+
+    // Compute direct solution
+    Eigen::VectorXd weightsSquareRoot = weights.cwiseSqrt( );
+    Eigen::MatrixXd weightedDesignMatrix = weightsSquareRoot.asDiagonal( ) * designMatrix;
+    Eigen::VectorXd directSolution = weightedDesignMatrix.colPivHouseholderQr( ).solve(
+                weightsSquareRoot.cwiseProduct( residuals ) );
+    Eigen::MatrixXd directNormalMatrix = designMatrix.transpose( ) * weights.asDiagonal( ) * designMatrix;
+
+    // Accumulate normal equations in blocks of different size, split over two accumulators.
+    NormalEquationsAccumulator firstAccumulator( numberOfParameters );
+    NormalEquationsAccumulator secondAccumulator( numberOfParameters );
+    firstAccumulator.addObservationBlock( designMatrix.topRows( 70 ), residuals.head( 70 ), weights.head( 70 ) );
+    firstAccumulator.addObservationBlock( designMatrix.middleRows( 70, 1 ), residuals.segment( 70, 1 ),
+                                          weights.segment( 70, 1 ) );
+    secondAccumulator.addObservationBlock( designMatrix.bottomRows( 129 ), residuals.tail( 129 ), weights.tail( 129 ) );
+    firstAccumulator.addAccumulator( secondAccumulator );
+
+    Eigen::VectorXd accumulatedSolution;
+    Eigen::MatrixXd accumulatedCovariance;
+    firstAccumulator.solveNormalEquations( accumulatedSolution, accumulatedCovariance );
+
+    BOOST_CHECK_EQUAL( firstAccumulator.getNumberOfObservations( ), numberOfObservations );
+    BOOST_CHECK_CLOSE_FRACTION( firstAccumulator.getWeightedResidualSquareSum( ),
+                                residuals.dot( weights.cwiseProduct( residuals ) ), 1.0E-14 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( firstAccumulator.getNormalMatrix( ), directNormalMatrix, 1.0E-13 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( accumulatedSolution, directSolution, 1.0E-10 );
+    BOOST_CHECK_SMALL( ( accumulatedCovariance * directNormalMatrix -
+                         Eigen::MatrixXd::Identity( numberOfParameters, numberOfParameters ) ).cwiseAbs( ).maxCoeff( ),
+                       1.0E-8 );
+
+    // Check that rank-deficient normal equations are detected.
+    NormalEquationsAccumulator deficientAccumulator( numberOfParameters );
+    deficientAccumulator.addObservationBlock( designMatrix.topRows( numberOfParameters - 1 ),
+                                              residuals.head( numberOfParameters - 1 ),
+                                              weights.head( numberOfParameters - 1 ) );
+    bool isExceptionCaught = false;
+    try
+    {
+        deficientAccumulator.solveNormalEquations( accumulatedSolution, accumulatedCovariance );
+    }
+    catch( const std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK_EQUAL( isExceptionCaught, true );
+}
+
+//! Test estimation of initial state and gravitational parameter from range, angular position and position data.
+BOOST_AUTO_TEST_CASE( testBatchLeastSquaresEstimation )
+{
+    double initialTime = 0.0;
+    double finalTime = 43200.0;
+    double earthGravitationalParameter = 3.986004418E14;
+
+    // Create environment without external data: Earth at origin with point-mass gravity, and vehicle.
+    std::map< std::string, boost::shared_ptr< BodySettings > > bodySettings;
+    bodySettings[ "Earth" ] = boost::make_shared< BodySettings >( );
+    bodySettings[ "Earth" ]->ephemerisSettings = boost::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ), "SSB", "ECLIPJ2000" );
+    bodySettings[ "Earth" ]->gravityFieldSettings =
+            boost::make_shared< CentralGravityFieldSettings >( earthGravitationalParameter );
+    NamedBodyMap bodyMap = createBodies( bodySettings );
+    bodyMap[ "Vehicle" ] = boost::make_shared< Body >( );
+    bodyMap[ "Vehicle" ]->setEphemeris( boost::make_shared< ephemerides::TabulatedCartesianEphemeris< double, double > >(
+                                            boost::shared_ptr< interpolators::OneDimensionalInterpolator<
+                                            double, Eigen::Vector6d > >( ), "Earth", "ECLIPJ2000" ) );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+
+    // Create acceleration models.
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back( boost::make_shared< AccelerationSettings >( central_gravity ) );
+    std::map< std::string, std::string > centralBodyMap;
+    centralBodyMap[ "Vehicle" ] = "Earth";
+    basic_astrodynamics::AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodyMap, accelerationMap, centralBodyMap );
+
+    // Define true initial state.
+    Eigen::Vector6d vehicleKeplerianElements;
+    vehicleKeplerianElements << 8000.0E3, 0.05, 0.6, 1.0, 2.0, 0.5;
+    Eigen::Vector6d trueInitialState = convertKeplerianToCartesianElements(
+                vehicleKeplerianElements, earthGravitationalParameter );
+
+    // Create parameters and variational equations solver.
+    std::vector< boost::shared_ptr< EstimatableParameterSettings > > parameterNames;
+    parameterNames.push_back( boost::make_shared< InitialTranslationalStateEstimatableParameterSettings< double > >(
+                                  "Vehicle", trueInitialState, "Earth" ) );
+    parameterNames.push_back( boost::make_shared< EstimatableParameterSettings >( "Earth", gravitational_parameter ) );
+    boost::shared_ptr< EstimatableParameterSet< double > > parametersToEstimate =
+            createParametersToEstimate( parameterNames, bodyMap, accelerationModelMap );
+
+    std::vector< std::string > centralBodies;
+    centralBodies.push_back( "Earth" );
+    std::vector< std::string > bodiesToIntegrate;
+    bodiesToIntegrate.push_back( "Vehicle" );
+    boost::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+            boost::make_shared< TranslationalStatePropagatorSettings< double > >(
+                centralBodies, accelerationModelMap, bodiesToIntegrate, trueInitialState, finalTime );
+    boost::shared_ptr< IntegratorSettings< > > integratorSettings =
+            boost::make_shared< IntegratorSettings< > >( rungeKutta4, initialTime, 20.0 );
+
+    boost::shared_ptr< SingleArcVariationalEquationsSolver< > > variationalEquationsSolver =
+            boost::make_shared< SingleArcVariationalEquationsSolver< > >(
+                bodyMap, integratorSettings, propagatorSettings, parametersToEstimate );
+
+    // Define links and observation times.
+    LinkEnds rangeLinkEnds;
+    rangeLinkEnds[ transmitter ] = std::make_pair( "Vehicle", "" );
+    rangeLinkEnds[ receiver ] = std::make_pair( "Earth", "" );
+    LinkEnds positionLinkEnds;
+    positionLinkEnds[ observed_body ] = std::make_pair( "Vehicle", "" );
+
+    std::vector< double > observationTimes;
+    for( double currentTime = initialTime + 600.0; currentTime < finalTime - 600.0; currentTime += 60.0 )
+    {
+        observationTimes.push_back( currentTime );
+    }
+
+    // Simulate observations using true parameters.
+    std::vector< boost::shared_ptr< LinkObservationsForEstimation< > > > linkObservations;
+    {
+        SingleLinkObservationBatch< > rangeBatch( oneWayRange, receiver );
+        SingleLinkObservationSimulator< 1 >( ObservationModelCreator< 1 >::createObservationModel(
+                                                 oneWayRange, rangeLinkEnds, bodyMap ) ).simulateObservations(
+                    observationTimes, rangeBatch );
+        SingleLinkObservationBatch< > angularPositionBatch( angular_position, receiver );
+        SingleLinkObservationSimulator< 2 >( ObservationModelCreator< 2 >::createObservationModel(
+                                                 angular_position, rangeLinkEnds, bodyMap ) ).simulateObservations(
+                    observationTimes, angularPositionBatch );
+        SingleLinkObservationBatch< > positionBatch( position_observable, observed_body );
+        SingleLinkObservationSimulator< 3 >( ObservationModelCreator< 3 >::createObservationModel(
+                                                 position_observable, positionLinkEnds, bodyMap ) ).simulateObservations(
+                    observationTimes, positionBatch );
+
+        linkObservations.push_back( createLinkObservationsForEstimation< 1 >(
+                                        oneWayRange, rangeLinkEnds, bodyMap, observationTimes,
+                                        rangeBatch.getObservations( ),
+                                        Eigen::VectorXd::Constant( observationTimes.size( ), 1.0 ) ) );
+        linkObservations.push_back( createLinkObservationsForEstimation< 2 >(
+                                        angular_position, rangeLinkEnds, bodyMap, observationTimes,
+                                        angularPositionBatch.getObservations( ),
+                                        Eigen::VectorXd::Constant( 2 * observationTimes.size( ), 1.0E12 ) ) );
+        linkObservations.push_back( createLinkObservationsForEstimation< 3 >(
+                                        position_observable, positionLinkEnds, bodyMap, observationTimes,
+                                        positionBatch.getObservations( ),
+                                        Eigen::VectorXd::Constant( 3 * observationTimes.size( ), 1.0E-2 ),
+                                        observed_body ) );
+    }
+
+    // Perturb parameters, and estimate them for different numbers of threads.
+    Eigen::VectorXd trueParameters = parametersToEstimate->template getFullParameterValues< double >( );
+    Eigen::VectorXd parameterPerturbation = Eigen::VectorXd::Zero( 7 );
+    parameterPerturbation << 100.0, -50.0, 20.0, 0.05, 0.02, -0.03, 1.0E6;
+
+    std::vector< boost::shared_ptr< BatchLeastSquaresEstimationOutput > > estimationOutputs;
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 3; numberOfThreads += 2 )
+    {
+        variationalEquationsSolver->resetParameterEstimate( trueParameters + parameterPerturbation );
+
+        BatchLeastSquaresEstimator< > estimator(
+                    variationalEquationsSolver, linkObservations, numberOfThreads, 64 );
+        estimationOutputs.push_back( estimator.estimateParameters( 5, 1.0E-3 ) );
+
+        boost::shared_ptr< BatchLeastSquaresEstimationOutput > estimationOutput = estimationOutputs.back( );
+        BOOST_CHECK_EQUAL( estimationOutput->numberOfObservations_, 6 * static_cast< int >( observationTimes.size( ) ) );
+        BOOST_CHECK_EQUAL( estimationOutput->residuals_.rows( ), 6 * static_cast< int >( observationTimes.size( ) ) );
+
+        // Check estimated parameters.
+        Eigen::VectorXd estimationError = estimationOutput->parameterEstimate_ - trueParameters;
+        for( unsigned int i = 0; i < 3; i++ )
+        {
+            BOOST_CHECK_SMALL( estimationError( i ), 1.0E-3 );
+            BOOST_CHECK_SMALL( estimationError( i + 3 ), 1.0E-6 );
+        }
+        BOOST_CHECK_SMALL( estimationError( 6 ) / earthGravitationalParameter, 1.0E-12 );
+        BOOST_CHECK_SMALL( estimationOutput->residuals_.segment( 0, observationTimes.size( ) ).cwiseAbs( ).maxCoeff( ),
+                           1.0E-3 );
+        BOOST_CHECK_EQUAL( estimationOutput->parameterHistory_.front( ), trueParameters + parameterPerturbation );
+    }
+
+    // Check that estimation results are independent of number of threads.
+    BOOST_CHECK_EQUAL( estimationOutputs.at( 0 )->parameterEstimate_, estimationOutputs.at( 1 )->parameterEstimate_ );
+    BOOST_CHECK_EQUAL( estimationOutputs.at( 0 )->parameterCovariance_,
+                       estimationOutputs.at( 1 )->parameterCovariance_ );
+
+    // Estimate parameters using compact, single precision, storage of state transition matrices.
+    boost::shared_ptr< SingleArcVariationalEquationsSolver< > > compactVariationalEquationsSolver =
+            boost::make_shared< SingleArcVariationalEquationsSolver< > >(
+                bodyMap, integratorSettings, propagatorSettings, parametersToEstimate, true,
+                boost::shared_ptr< IntegratorSettings< double > >( ), true, true, compact_single_precision_storage );
+    compactVariationalEquationsSolver->resetParameterEstimate( trueParameters + parameterPerturbation );
+    // Check that matrices are stored in compact form during integration, without creating map of matrices.
+    BOOST_CHECK_EQUAL( compactVariationalEquationsSolver->getNumericalVariationalEquationsSolution( ).at( 0 ).size( ), 0 );
+    BOOST_CHECK_EQUAL( compactVariationalEquationsSolver->getNumericalVariationalEquationsSolution( ).at( 1 ).size( ), 0 );
+    BOOST_CHECK( boost::dynamic_pointer_cast< SingleArcCompactStateTransitionAndSensitivityMatrixInterface< float > >(
+                     compactVariationalEquationsSolver->getStateTransitionMatrixInterface( ) ) != NULL );
+
+    BatchLeastSquaresEstimator< > compactEstimator( compactVariationalEquationsSolver, linkObservations, 1, 64 );
+    boost::shared_ptr< BatchLeastSquaresEstimationOutput > compactEstimationOutput =
+            compactEstimator.estimateParameters( 5, 1.0E-3 );
+
+    // Check that results are consistent with those using full storage.
+    Eigen::VectorXd estimationDifference =
+            compactEstimationOutput->parameterEstimate_ - estimationOutputs.at( 0 )->parameterEstimate_;
+    for( unsigned int i = 0; i < 3; i++ )
+    {
+        BOOST_CHECK_SMALL( estimationDifference( i ), 1.0E-3 );
+        BOOST_CHECK_SMALL( estimationDifference( i + 3 ), 1.0E-6 );
+    }
+    Eigen::VectorXd formalErrorRatio = compactEstimationOutput->getFormalErrors( ).cwiseQuotient(
+                estimationOutputs.at( 0 )->getFormalErrors( ) );
+    for( unsigned int i = 0; i < 7; i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( formalErrorRatio( i ), 1.0, 1.0E-4 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,136 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <stdexcept>
+
+#include <boost/lexical_cast.hpp>
+
+#include <Eigen/Cholesky>
+
+#include "Tudat/Astrodynamics/OrbitDetermination/normalEquationsAccumulator.h"
+
+namespace tudat
+{
+
+namespace orbit_determination
+{
+
+//! Function to reset (to zero) all accumulated values.
+void NormalEquationsAccumulator::resetAccumulator( const int numberOfParameters )
+{
+    normalMatrix_ = Eigen::MatrixXd::Zero( numberOfParameters, numberOfParameters );
+    rightHandSide_ = Eigen::VectorXd::Zero( numberOfParameters );
+    weightedResidualSquareSum_ = 0.0;
+    residualSquareSum_ = 0.0;
+    numberOfObservations_ = 0;
+}
+
+//! Function to add a block of observations to the normal equations.
+void NormalEquationsAccumulator::addObservationBlock( const Eigen::MatrixXd& partials,
+                                                      const Eigen::VectorXd& residuals,
+                                                      const Eigen::VectorXd& weights )
+{
+    if( partials.cols( ) != normalMatrix_.cols( ) || partials.rows( ) != residuals.rows( ) ||
+            residuals.rows( ) != weights.rows( ) )
+    {
+        throw std::runtime_error( "Error when adding observations to normal equations, input sizes are inconsistent" );
+    }
+
+    if( weights.minCoeff( ) < 0.0 )
+    {
+        throw std::runtime_error( "Error when adding observations to normal equations, weights must be non-negative" );
+    }
+
+    // Add contribution to upper triangular part of normal matrix (as rank update), and to right-hand side.
+    Eigen::VectorXd weightsSquareRoot = weights.cwiseSqrt( );
+    Eigen::MatrixXd scaledPartialsTranspose = partials.transpose( ) * weightsSquareRoot.asDiagonal( );
+    normalMatrix_.selfadjointView< Eigen::Upper >( ).rankUpdate( scaledPartialsTranspose );
+    rightHandSide_ += scaledPartialsTranspose * weightsSquareRoot.cwiseProduct( residuals );
+
+    weightedResidualSquareSum_ += residuals.dot( weights.asDiagonal( ) * residuals );
+    residualSquareSum_ += residuals.squaredNorm( );
+    numberOfObservations_ += residuals.rows( );
+}
+
+//! Function to add the normal equations accumulated by another object to those of this object.
+void NormalEquationsAccumulator::addAccumulator( const NormalEquationsAccumulator& otherAccumulator )
+{
+    if( otherAccumulator.getNumberOfParameters( ) != getNumberOfParameters( ) )
+    {
+        throw std::runtime_error( "Error when adding normal equations, number of parameters is inconsistent" );
+    }
+
+    normalMatrix_.triangularView< Eigen::Upper >( ) += otherAccumulator.normalMatrix_;
+    rightHandSide_ += otherAccumulator.rightHandSide_;
+    weightedResidualSquareSum_ += otherAccumulator.weightedResidualSquareSum_;
+    residualSquareSum_ += otherAccumulator.residualSquareSum_;
+    numberOfObservations_ += otherAccumulator.numberOfObservations_;
+}
+
+//! Function to add an a priori information matrix to the normal equations.
+void NormalEquationsAccumulator::addAprioriInformation( const Eigen::MatrixXd& inverseAprioriCovariance,
+                                                        const Eigen::VectorXd& aprioriParameterDifference )
+{
+    if( inverseAprioriCovariance.rows( ) != getNumberOfParameters( ) ||
+            inverseAprioriCovariance.cols( ) != getNumberOfParameters( ) ||
+            aprioriParameterDifference.rows( ) != getNumberOfParameters( ) )
+    {
+        throw std::runtime_error( "Error when adding a priori information to normal equations, sizes are inconsistent" );
+    }
+
+    normalMatrix_.triangularView< Eigen::Upper >( ) += inverseAprioriCovariance;
+    rightHandSide_ += inverseAprioriCovariance * aprioriParameterDifference;
+}
+
+//! Function to solve the accumulated normal equations.
+void NormalEquationsAccumulator::solveNormalEquations( Eigen::VectorXd& parameterCorrection,
+                                                       Eigen::MatrixXd& covarianceMatrix ) const
+{
+    int numberOfParameters = getNumberOfParameters( );
+
+    // Compute normalization terms, to improve conditioning of the normal matrix.
+    Eigen::VectorXd normalizationTerms = normalMatrix_.diagonal( );
+    for( int i = 0; i < numberOfParameters; i++ )
+    {
+        if( !( normalizationTerms( i ) > 0.0 ) )
+        {
+            throw std::runtime_error( "Error when solving normal equations, parameter " +
+                                      boost::lexical_cast< std::string >( i ) + " is not constrained by observations." );
+        }
+        normalizationTerms( i ) = std::sqrt( normalizationTerms( i ) );
+    }
+
+    // Create normalized (symmetric) normal matrix, and compute its Cholesky decomposition.
+    Eigen::MatrixXd normalizedNormalMatrix = normalMatrix_.selfadjointView< Eigen::Upper >( );
+    normalizedNormalMatrix = normalizationTerms.cwiseInverse( ).asDiagonal( ) * normalizedNormalMatrix *
+            normalizationTerms.cwiseInverse( ).asDiagonal( );
+    Eigen::LLT< Eigen::MatrixXd > normalMatrixDecomposition( normalizedNormalMatrix );
+    if( normalMatrixDecomposition.info( ) != Eigen::Success )
+    {
+        throw std::runtime_error( "Error when solving normal equations, normal matrix is not positive definite" );
+    }
+
+    // Solve normalized normal equations, and compute (unnormalized) solution and covariance.
+    parameterCorrection = normalizationTerms.cwiseInverse( ).asDiagonal( ) *
+            normalMatrixDecomposition.solve( normalizationTerms.cwiseInverse( ).asDiagonal( ) * rightHandSide_ );
+    covarianceMatrix = normalizationTerms.cwiseInverse( ).asDiagonal( ) *
+            normalMatrixDecomposition.solve( Eigen::MatrixXd::Identity( numberOfParameters, numberOfParameters ) ) *
+            normalizationTerms.cwiseInverse( ).asDiagonal( );
+}
+
+//! Function to retrieve the accumulated normal matrix.
+Eigen::MatrixXd NormalEquationsAccumulator::getNormalMatrix( ) const
+{
+    return normalMatrix_.selfadjointView< Eigen::Upper >( );
+}
+
+} // namespace orbit_determination
+
+} // namespace tudat
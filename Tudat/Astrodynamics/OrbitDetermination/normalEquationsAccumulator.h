@@ -0,0 +1,173 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_NORMALEQUATIONSACCUMULATOR_H
+#define TUDAT_NORMALEQUATIONSACCUMULATOR_H
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace orbit_determination
+{
+
+//! Class to accumulate the normal equations of a weighted linear least-squares problem, block by block.
+/*!
+ *  Class to accumulate the normal equations of a weighted linear least-squares problem, block by block. For each block of
+ *  observations with partials (design matrix rows) H, residuals r and (diagonal) weights W, the normal matrix
+ *  H^T W H, the right-hand side H^T W r and the weighted square sum of the residuals r^T W r are added to the
+ *  accumulated values. The full design matrix is never stored, so that the memory use of this class scales only with
+ *  the square of the number of parameters. Only the upper triangular part of the normal matrix is updated during
+ *  accumulation.
+ */
+class NormalEquationsAccumulator
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param numberOfParameters Number of parameters of the least-squares problem.
+     */
+    NormalEquationsAccumulator( const int numberOfParameters = 0 )
+    {
+        resetAccumulator( numberOfParameters );
+    }
+
+    //! Function to reset (to zero) all accumulated values.
+    /*!
+     *  Function to reset (to zero) all accumulated values.
+     *  \param numberOfParameters Number of parameters of the least-squares problem.
+     */
+    void resetAccumulator( const int numberOfParameters );
+
+    //! Function to add a block of observations to the normal equations.
+    /*!
+     *  Function to add a block of observations to the normal equations.
+     *  \param partials Partials of observations w.r.t. parameters (one row per observation), i.e. a block of the design
+     *  matrix.
+     *  \param residuals Residuals of the observations (observed minus computed).
+     *  \param weights Weights of the observations (diagonal of the weight matrix).
+     */
+    void addObservationBlock( const Eigen::MatrixXd& partials,
+                              const Eigen::VectorXd& residuals,
+                              const Eigen::VectorXd& weights );
+
+    //! Function to add the normal equations accumulated by another object to those of this object.
+    /*!
+     *  Function to add the normal equations accumulated by another object to those of this object.
+     *  \param otherAccumulator Object with accumulated normal equations that are to be added.
+     */
+    void addAccumulator( const NormalEquationsAccumulator& otherAccumulator );
+
+    //! Function to add an a priori information matrix to the normal equations.
+    /*!
+     *  Function to add an a priori information matrix (inverse a priori covariance) to the normal equations, with the
+     *  a priori parameter values given by the difference w.r.t. the current parameter values.
+     *  \param inverseAprioriCovariance Inverse a priori covariance matrix.
+     *  \param aprioriParameterDifference Difference between a priori and current parameter values.
+     */
+    void addAprioriInformation( const Eigen::MatrixXd& inverseAprioriCovariance,
+                                const Eigen::VectorXd& aprioriParameterDifference );
+
+    //! Function to solve the accumulated normal equations.
+    /*!
+     *  Function to solve the accumulated normal equations using a Cholesky decomposition. The normal equations are
+     *  normalized (using the square root of the diagonal of the normal matrix) before solving, to improve their
+     *  conditioning. An exception is thrown if the normal matrix is not positive definite.
+     *  \param parameterCorrection Least-squares estimate of parameter correction (returned by reference).
+     *  \param covarianceMatrix Covariance matrix of estimated parameters, i.e. inverse of normal matrix
+     *  (returned by reference).
+     */
+    void solveNormalEquations( Eigen::VectorXd& parameterCorrection,
+                               Eigen::MatrixXd& covarianceMatrix ) const;
+
+    //! Function to retrieve the accumulated normal matrix.
+    /*!
+     *  Function to retrieve the accumulated normal matrix (full symmetric matrix).
+     *  \return Accumulated normal matrix.
+     */
+    Eigen::MatrixXd getNormalMatrix( ) const;
+
+    //! Function to retrieve the accumulated right-hand side of the normal equations.
+    /*!
+     *  Function to retrieve the accumulated right-hand side of the normal equations.
+     *  \return Accumulated right-hand side of the normal equations.
+     */
+    const Eigen::VectorXd& getRightHandSide( ) const
+    {
+        return rightHandSide_;
+    }
+
+    //! Function to retrieve the accumulated weighted square sum of the residuals.
+    /*!
+     *  Function to retrieve the accumulated weighted square sum of the residuals.
+     *  \return Accumulated weighted square sum of the residuals.
+     */
+    double getWeightedResidualSquareSum( ) const
+    {
+        return weightedResidualSquareSum_;
+    }
+
+    //! Function to retrieve the accumulated (unweighted) square sum of the residuals.
+    /*!
+     *  Function to retrieve the accumulated (unweighted) square sum of the residuals.
+     *  \return Accumulated (unweighted) square sum of the residuals.
+     */
+    double getResidualSquareSum( ) const
+    {
+        return residualSquareSum_;
+    }
+
+    //! Function to retrieve the number of observations that have been accumulated.
+    /*!
+     *  Function to retrieve the number of observations (rows of design matrix) that have been accumulated.
+     *  \return Number of observations that have been accumulated.
+     */
+    int getNumberOfObservations( ) const
+    {
+        return numberOfObservations_;
+    }
+
+    //! Function to retrieve the number of parameters of the least-squares problem.
+    /*!
+     *  Function to retrieve the number of parameters of the least-squares problem.
+     *  \return Number of parameters of the least-squares problem.
+     */
+    int getNumberOfParameters( ) const
+    {
+        return rightHandSide_.rows( );
+    }
+
+private:
+
+    //! Accumulated normal matrix (only upper triangular part is set).
+    Eigen::MatrixXd normalMatrix_;
+
+    //! Accumulated right-hand side of normal equations.
+    Eigen::VectorXd rightHandSide_;
+
+    //! Accumulated weighted square sum of residuals
+    double weightedResidualSquareSum_;
+
+    //! Accumulated (unweighted) square sum of residuals
+    double residualSquareSum_;
+
+    //! Number of observations that have been accumulated.
+    int numberOfObservations_;
+
+};
+
+} // namespace orbit_determination
+
+} // namespace tudat
+
+#endif // TUDAT_NORMALEQUATIONSACCUMULATOR_H
@@ -0,0 +1,331 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/make_shared.hpp>
+
+#include "Tudat/Mathematics/Interpolators/lagrangeInterpolator.h"
+#include "Tudat/Astrodynamics/Propagators/compactStateTransitionMatrixInterface.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::propagators;
+using namespace tudat::interpolators;
+
+//! Function to compute a combined (3x5) state transition and sensitivity matrix, with a zero last column.
+Eigen::MatrixXd getTestCombinedMatrix( const double time, const bool usePolynomial )
+{
+    Eigen::MatrixXd combinedMatrix = Eigen::MatrixXd::Zero( 3, 5 );
+    for( int i = 0; i < 3; i++ )
+    {
+        for( int j = 0; j < 4; j++ )
+        {
+            double scaledTime = time / 100.0;
+            if( usePolynomial )
+            {
+                combinedMatrix( i, j ) = 1.0 + ( i + 1 ) * scaledTime - ( j + 2 ) * scaledTime * scaledTime +
+                        0.5 * ( i - j ) * scaledTime * scaledTime * scaledTime;
+            }
+            else
+            {
+                combinedMatrix( i, j ) = std::sin( ( i + 1 ) * scaledTime + j ) + ( i == j ? 1.0 : 0.0 );
+            }
+        }
+    }
+    return combinedMatrix;
+}
+
+//! Function to create variational equations solution, from getTestCombinedMatrix, at irregularly spaced epochs.
+std::vector< std::map< double, Eigen::MatrixXd > > getTestVariationalEquationsSolution( const bool usePolynomial )
+{
+    std::vector< std::map< double, Eigen::MatrixXd > > variationalEquationsSolution( 2 );
+    double currentTime = 0.0;
+    for( int i = 0; i < 60; i++ )
+    {
+        Eigen::MatrixXd combinedMatrix = getTestCombinedMatrix( currentTime, usePolynomial );
+        variationalEquationsSolution[ 0 ][ currentTime ] = combinedMatrix.block( 0, 0, 3, 3 );
+        variationalEquationsSolution[ 1 ][ currentTime ] = combinedMatrix.block( 0, 3, 3, 2 );
+        currentTime += 10.0 + 2.0 * std::sin( static_cast< double >( i ) );
+    }
+    return variationalEquationsSolution;
+}
+
+BOOST_AUTO_TEST_SUITE( test_compact_state_transition_matrix_interface )
+
+//! Test whether compact storage reproduces cubic polynomials (which 4-point Lagrange interpolation must do exactly).
+BOOST_AUTO_TEST_CASE( testCompactStateTransitionMatrixPolynomialReproduction )
+{
+    std::vector< std::map< double, Eigen::MatrixXd > > variationalEquationsSolution =
+            getTestVariationalEquationsSolution( true );
+
+    SingleArcCompactStateTransitionAndSensitivityMatrixInterface< double > doubleInterface(
+                variationalEquationsSolution, 3, 5 );
+    SingleArcCompactStateTransitionAndSensitivityMatrixInterface< float > floatInterface(
+                variationalEquationsSolution, 3, 5 );
+
+    // Check that zero column is not stored.
+    BOOST_CHECK_EQUAL( doubleInterface.getStoredColumnIndices( ).size( ), 4 );
+    BOOST_CHECK_EQUAL( doubleInterface.getNumberOfStoredEntries( ), 60 * 3 * 4 );
+    BOOST_CHECK_EQUAL( floatInterface.getStoredColumnIndices( ).size( ), 4 );
+
+    // Create evaluation times, including boundaries and interval before first epoch.
+    double finalTime = doubleInterface.getStoredEpochs( ).back( );
+    std::vector< double > evaluationTimes;
+    evaluationTimes.push_back( 0.0 );
+    for( double currentTime = 1.0; currentTime < finalTime; currentTime += 3.7 )
+    {
+        evaluationTimes.push_back( currentTime );
+    }
+    evaluationTimes.push_back( finalTime );
+
+    std::vector< Eigen::MatrixXd > doubleMatrices, floatMatrices;
+    doubleInterface.getCombinedStateTransitionAndSensitivityMatrices( evaluationTimes, doubleMatrices );
+    floatInterface.getCombinedStateTransitionAndSensitivityMatrices( evaluationTimes, floatMatrices );
+    BOOST_CHECK_EQUAL( doubleMatrices.size( ), evaluationTimes.size( ) );
+
+    for( unsigned int i = 0; i < evaluationTimes.size( ); i++ )
+    {
+        Eigen::MatrixXd expectedMatrix = getTestCombinedMatrix( evaluationTimes.at( i ), true );
+        Eigen::MatrixXd singleDoubleMatrix =
+                doubleInterface.getCombinedStateTransitionAndSensitivityMatrix( evaluationTimes.at( i ) );
+
+        BOOST_CHECK_EQUAL( doubleMatrices.at( i ).rows( ), 3 );
+        BOOST_CHECK_EQUAL( doubleMatrices.at( i ).cols( ), 5 );
+        double matrixScale = expectedMatrix.cwiseAbs( ).maxCoeff( );
+        BOOST_CHECK_SMALL( ( doubleMatrices.at( i ) - expectedMatrix ).cwiseAbs( ).maxCoeff( ), 1.0E-13 * matrixScale );
+        BOOST_CHECK_SMALL( ( floatMatrices.at( i ) - expectedMatrix ).cwiseAbs( ).maxCoeff( ), 1.0E-6 * matrixScale );
+        BOOST_CHECK_EQUAL( ( singleDoubleMatrix - doubleMatrices.at( i ) ).cwiseAbs( ).maxCoeff( ), 0.0 );
+        BOOST_CHECK_EQUAL( doubleMatrices.at( i ).col( 4 ).cwiseAbs( ).maxCoeff( ), 0.0 );
+    }
+
+    // Check unsorted evaluation, and reuse of output matrices.
+    std::vector< double > reversedEvaluationTimes( evaluationTimes.rbegin( ), evaluationTimes.rend( ) );
+    doubleInterface.getCombinedStateTransitionAndSensitivityMatrices( reversedEvaluationTimes, doubleMatrices );
+    for( unsigned int i = 0; i < reversedEvaluationTimes.size( ); i++ )
+    {
+        BOOST_CHECK_SMALL( ( doubleMatrices.at( i ) -
+                             getTestCombinedMatrix( reversedEvaluationTimes.at( i ), true ) ).cwiseAbs( ).maxCoeff( ),
+                           1.0E-12 );
+    }
+}
+
+//! Test whether compact storage is equal to existing map-based interpolation, away from boundaries.
+BOOST_AUTO_TEST_CASE( testCompactStateTransitionMatrixConsistency )
+{
+    std::vector< std::map< double, Eigen::MatrixXd > > variationalEquationsSolution =
+            getTestVariationalEquationsSolution( false );
+
+    // Create map-based interface, as done by variational equations solver.
+    boost::shared_ptr< OneDimensionalInterpolator< double, Eigen::MatrixXd > > stateTransitionMatrixInterpolator =
+            boost::make_shared< LagrangeInterpolator< double, Eigen::MatrixXd > >(
+                variationalEquationsSolution[ 0 ], 4 );
+    boost::shared_ptr< OneDimensionalInterpolator< double, Eigen::MatrixXd > > sensitivityMatrixInterpolator =
+            boost::make_shared< LagrangeInterpolator< double, Eigen::MatrixXd > >(
+                variationalEquationsSolution[ 1 ], 4 );
+    SingleArcCombinedStateTransitionAndSensitivityMatrixInterface mapInterface(
+                stateTransitionMatrixInterpolator, sensitivityMatrixInterpolator, 3, 5 );
+
+    // Create compact interfaces through factory function.
+    boost::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > doubleInterface;
+    boost::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > floatInterface;
+    createOrUpdateCompactStateTransitionAndSensitivityMatrixInterface(
+                doubleInterface, variationalEquationsSolution, compact_double_precision_storage, 3, 5 );
+    createOrUpdateCompactStateTransitionAndSensitivityMatrixInterface(
+                floatInterface, variationalEquationsSolution, compact_single_precision_storage, 3, 5 );
+
+    // Check that update keeps existing object.
+    boost::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > originalDoubleInterface = doubleInterface;
+    createOrUpdateCompactStateTransitionAndSensitivityMatrixInterface(
+                doubleInterface, variationalEquationsSolution, compact_double_precision_storage, 3, 5 );
+    BOOST_CHECK_EQUAL( doubleInterface, originalDoubleInterface );
+
+    // Compare interpolated matrices away from first and last two intervals.
+    std::vector< double > epochs;
+    for( std::map< double, Eigen::MatrixXd >::const_iterator epochIterator = variationalEquationsSolution[ 0 ].begin( );
+         epochIterator != variationalEquationsSolution[ 0 ].end( ); epochIterator++ )
+    {
+        epochs.push_back( epochIterator->first );
+    }
+
+    std::vector< double > evaluationTimes;
+    for( double currentTime = epochs.at( 2 ); currentTime < epochs.at( epochs.size( ) - 3 ); currentTime += 1.3 )
+    {
+        evaluationTimes.push_back( currentTime );
+    }
+
+    std::vector< Eigen::MatrixXd > mapMatrices, doubleMatrices, floatMatrices;
+    mapInterface.getCombinedStateTransitionAndSensitivityMatrices( evaluationTimes, mapMatrices );
+    doubleInterface->getCombinedStateTransitionAndSensitivityMatrices( evaluationTimes, doubleMatrices );
+    floatInterface->getCombinedStateTransitionAndSensitivityMatrices( evaluationTimes, floatMatrices );
+
+    for( unsigned int i = 0; i < evaluationTimes.size( ); i++ )
+    {
+        BOOST_CHECK_SMALL( ( doubleMatrices.at( i ) - mapMatrices.at( i ) ).cwiseAbs( ).maxCoeff( ),
+                           1.0E-13 );
+        BOOST_CHECK_SMALL( ( floatMatrices.at( i ) - mapMatrices.at( i ) ).cwiseAbs( ).maxCoeff( ),
+                           1.0E-6 );
+    }
+}
+
+//! Test accuracy of compact storage w.r.t. map-based interpolation over full interval, including boundary intervals.
+BOOST_AUTO_TEST_CASE( testCompactStateTransitionMatrixAccuracy )
+{
+    std::vector< std::map< double, Eigen::MatrixXd > > variationalEquationsSolution =
+            getTestVariationalEquationsSolution( false );
+
+    boost::shared_ptr< OneDimensionalInterpolator< double, Eigen::MatrixXd > > stateTransitionMatrixInterpolator =
+            boost::make_shared< LagrangeInterpolator< double, Eigen::MatrixXd > >(
+                variationalEquationsSolution[ 0 ], 4 );
+    boost::shared_ptr< OneDimensionalInterpolator< double, Eigen::MatrixXd > > sensitivityMatrixInterpolator =
+            boost::make_shared< LagrangeInterpolator< double, Eigen::MatrixXd > >(
+                variationalEquationsSolution[ 1 ], 4 );
+    SingleArcCombinedStateTransitionAndSensitivityMatrixInterface mapInterface(
+                stateTransitionMatrixInterpolator, sensitivityMatrixInterpolator, 3, 5 );
+    SingleArcCompactStateTransitionAndSensitivityMatrixInterface< double > doubleInterface(
+                variationalEquationsSolution, 3, 5 );
+    SingleArcCompactStateTransitionAndSensitivityMatrixInterface< float > floatInterface(
+                variationalEquationsSolution, 3, 5 );
+
+    // Compute maximum interpolation errors in interior and in first/last interval
+    std::vector< double > epochs = doubleInterface.getStoredEpochs( );
+    double maximumMapInteriorError = 0.0, maximumDoubleInteriorError = 0.0, maximumFloatInteriorError = 0.0;
+    double maximumMapBoundaryError = 0.0, maximumDoubleBoundaryError = 0.0;
+    for( double currentTime = epochs.front( ); currentTime < epochs.back( ); currentTime += 0.7 )
+    {
+        Eigen::MatrixXd expectedMatrix = getTestCombinedMatrix( currentTime, false );
+        double mapError = ( mapInterface.getCombinedStateTransitionAndSensitivityMatrix( currentTime ) -
+                            expectedMatrix ).cwiseAbs( ).maxCoeff( );
+        double doubleError = ( doubleInterface.getCombinedStateTransitionAndSensitivityMatrix( currentTime ) -
+                               expectedMatrix ).cwiseAbs( ).maxCoeff( );
+        double floatError = ( floatInterface.getCombinedStateTransitionAndSensitivityMatrix( currentTime ) -
+                              expectedMatrix ).cwiseAbs( ).maxCoeff( );
+
+        if( currentTime < epochs.at( 1 ) || currentTime >= epochs.at( epochs.size( ) - 2 ) )
+        {
+            maximumMapBoundaryError = std::max( maximumMapBoundaryError, mapError );
+            maximumDoubleBoundaryError = std::max( maximumDoubleBoundaryError, doubleError );
+        }
+        else
+        {
+            maximumMapInteriorError = std::max( maximumMapInteriorError, mapError );
+            maximumDoubleInteriorError = std::max( maximumDoubleInteriorError, doubleError );
+            maximumFloatInteriorError = std::max( maximumFloatInteriorError, floatError );
+        }
+    }
+
+    // Check that interpolation order is equal in interior, and not worse in boundary intervals.
+    BOOST_CHECK_CLOSE_FRACTION( maximumDoubleInteriorError, maximumMapInteriorError, 1.0E-8 );
+    BOOST_CHECK( maximumDoubleBoundaryError <= maximumMapBoundaryError );
+
+    // Check that single precision storage error is dominated by interpolation error for this node spacing.
+    BOOST_CHECK( maximumFloatInteriorError < 1.1 * maximumMapInteriorError );
+}
+
+//! Test whether filling compact storage one epoch at a time is equal to creating it from maps.
+BOOST_AUTO_TEST_CASE( testCompactStateTransitionMatrixIncrementalFilling )
+{
+    std::vector< std::map< double, Eigen::MatrixXd > > variationalEquationsSolution =
+            getTestVariationalEquationsSolution( false );
+
+    SingleArcCompactStateTransitionAndSensitivityMatrixInterface< double > mapCreatedInterface(
+                variationalEquationsSolution, 3, 5 );
+
+    // Fill storage in ascending and descending (as for a backwards propagation) order.
+    boost::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > ascendingInterface;
+    boost::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > descendingInterface;
+    boost::shared_ptr< CompactStateTransitionAndSensitivityMatrixInterface > ascendingCompactInterface =
+            getOrCreateCompactStateTransitionAndSensitivityMatrixInterface(
+                ascendingInterface, compact_double_precision_storage, 3, 5 );
+    boost::shared_ptr< CompactStateTransitionAndSensitivityMatrixInterface > descendingCompactInterface =
+            getOrCreateCompactStateTransitionAndSensitivityMatrixInterface(
+                descendingInterface, compact_double_precision_storage, 3, 5 );
+    BOOST_CHECK_EQUAL( ascendingCompactInterface, ascendingInterface );
+
+    ascendingCompactInterface->clearMatrixHistory( );
+    for( std::map< double, Eigen::MatrixXd >::const_iterator matrixIterator = variationalEquationsSolution[ 0 ].begin( );
+         matrixIterator != variationalEquationsSolution[ 0 ].end( ); matrixIterator++ )
+    {
+        ascendingCompactInterface->addMatrixHistoryEpoch(
+                    matrixIterator->first, matrixIterator->second,
+                    variationalEquationsSolution[ 1 ].at( matrixIterator->first ) );
+    }
+    ascendingCompactInterface->finalizeMatrixHistory( );
+
+    descendingCompactInterface->clearMatrixHistory( );
+    for( std::map< double, Eigen::MatrixXd >::const_reverse_iterator matrixIterator =
+         variationalEquationsSolution[ 0 ].rbegin( ); matrixIterator != variationalEquationsSolution[ 0 ].rend( );
+         matrixIterator++ )
+    {
+        descendingCompactInterface->addMatrixHistoryEpoch(
+                    matrixIterator->first, matrixIterator->second,
+                    variationalEquationsSolution[ 1 ].at( matrixIterator->first ) );
+    }
+    descendingCompactInterface->finalizeMatrixHistory( );
+
+    // Check that zero column is removed in both cases.
+    BOOST_CHECK_EQUAL( boost::dynamic_pointer_cast< SingleArcCompactStateTransitionAndSensitivityMatrixInterface< double > >(
+                           ascendingInterface )->getNumberOfStoredEntries( ), 60 * 3 * 4 );
+    BOOST_CHECK_EQUAL( boost::dynamic_pointer_cast< SingleArcCompactStateTransitionAndSensitivityMatrixInterface< double > >(
+                           descendingInterface )->getNumberOfStoredEntries( ), 60 * 3 * 4 );
+
+    for( double currentTime = 0.0; currentTime < mapCreatedInterface.getStoredEpochs( ).back( ); currentTime += 2.3 )
+    {
+        Eigen::MatrixXd expectedMatrix = mapCreatedInterface.getCombinedStateTransitionAndSensitivityMatrix( currentTime );
+        BOOST_CHECK_EQUAL( ( ascendingInterface->getCombinedStateTransitionAndSensitivityMatrix( currentTime ) -
+                             expectedMatrix ).cwiseAbs( ).maxCoeff( ), 0.0 );
+        BOOST_CHECK_EQUAL( ( descendingInterface->getCombinedStateTransitionAndSensitivityMatrix( currentTime ) -
+                             expectedMatrix ).cwiseAbs( ).maxCoeff( ), 0.0 );
+    }
+
+    // Check that non-monotonic epochs, and evaluation of unfinalized history, are caught.
+    ascendingCompactInterface->clearMatrixHistory( );
+    ascendingCompactInterface->addMatrixHistoryEpoch(
+                0.0, Eigen::MatrixXd::Identity( 3, 3 ), Eigen::MatrixXd::Zero( 3, 2 ) );
+    ascendingCompactInterface->addMatrixHistoryEpoch(
+                10.0, Eigen::MatrixXd::Identity( 3, 3 ), Eigen::MatrixXd::Zero( 3, 2 ) );
+    bool isExceptionCaught = false;
+    try
+    {
+        ascendingCompactInterface->addMatrixHistoryEpoch(
+                    5.0, Eigen::MatrixXd::Identity( 3, 3 ), Eigen::MatrixXd::Zero( 3, 2 ) );
+    }
+    catch( const std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK_EQUAL( isExceptionCaught, true );
+
+    isExceptionCaught = false;
+    try
+    {
+        ascendingInterface->getCombinedStateTransitionAndSensitivityMatrix( 5.0 );
+    }
+    catch( const std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK_EQUAL( isExceptionCaught, true );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
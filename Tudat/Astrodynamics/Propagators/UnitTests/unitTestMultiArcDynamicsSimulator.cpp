@@ -0,0 +1,365 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <limits>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Astrodynamics/Ephemerides/multiArcEphemeris.h"
+#include "Tudat/Astrodynamics/Ephemerides/tabulatedEphemeris.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createBodies.h"
+#include "Tudat/SimulationSetup/PropagationSetup/createNumericalSimulator.h"
+#include "Tudat/SimulationSetup/EstimationSetup/createEstimatableParameters.h"
+#if USE_CSPICE
+#include "Tudat/External/SpiceInterface/spiceEphemeris.h"
+#include "Tudat/External/SpiceInterface/spiceRotationalEphemeris.h"
+#endif
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::simulation_setup;
+using namespace tudat::basic_astrodynamics;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+using namespace tudat::estimatable_parameters;
+using namespace tudat::orbital_element_conversions;
+
+BOOST_AUTO_TEST_SUITE( test_multi_arc_dynamics_simulator )
+
+//! Gravitational parameter of the central body used in the tests.
+const double earthGravitationalParameter = 3.986004418E14;
+
+//! Function to create the environment used in the tests (Earth-like point mass at the origin, and a vehicle).
+NamedBodyMap createTestBodyMap( )
+{
+    std::map< std::string, boost::shared_ptr< BodySettings > > bodySettings;
+    bodySettings[ "Earth" ] = boost::make_shared< BodySettings >( );
+    bodySettings[ "Earth" ]->ephemerisSettings = boost::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ), "SSB", "ECLIPJ2000" );
+    bodySettings[ "Earth" ]->gravityFieldSettings =
+            boost::make_shared< CentralGravityFieldSettings >( earthGravitationalParameter );
+    NamedBodyMap bodyMap = createBodies( bodySettings );
+    bodyMap[ "Vehicle" ] = boost::make_shared< Body >( );
+    bodyMap[ "Vehicle" ]->setEphemeris( boost::make_shared< ephemerides::TabulatedCartesianEphemeris< double, double > >(
+                                            boost::shared_ptr< interpolators::OneDimensionalInterpolator<
+                                            double, Eigen::Vector6d > >( ), "Earth", "ECLIPJ2000" ) );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+    return bodyMap;
+}
+
+//! Function to create the propagator settings used in the tests, for the vehicle around the Earth.
+boost::shared_ptr< TranslationalStatePropagatorSettings< double > > createTestPropagatorSettings(
+        const NamedBodyMap& bodyMap, const Eigen::Vector6d& initialState, const double finalTime )
+{
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back( boost::make_shared< AccelerationSettings >( central_gravity ) );
+    std::map< std::string, std::string > centralBodyMap;
+    centralBodyMap[ "Vehicle" ] = "Earth";
+
+    return boost::make_shared< TranslationalStatePropagatorSettings< double > >(
+                std::vector< std::string >( 1, "Earth" ),
+                createAccelerationModelsMap( bodyMap, accelerationMap, centralBodyMap ),
+                std::vector< std::string >( 1, "Vehicle" ), initialState, finalTime );
+}
+
+//! Function to create the estimated parameters used in the tests (vehicle initial state and Earth gravitational
+//! parameter).
+boost::shared_ptr< EstimatableParameterSet< double > > createTestParameters(
+        const NamedBodyMap& bodyMap,
+        const boost::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings,
+        const Eigen::Vector6d& initialState )
+{
+    std::vector< boost::shared_ptr< EstimatableParameterSettings > > parameterNames;
+    parameterNames.push_back( boost::make_shared< InitialTranslationalStateEstimatableParameterSettings< double > >(
+                                  "Vehicle", initialState, "Earth" ) );
+    parameterNames.push_back( boost::make_shared< EstimatableParameterSettings >( "Earth", gravitational_parameter ) );
+    return createParametersToEstimate( parameterNames, bodyMap, propagatorSettings->accelerationsMap_ );
+}
+
+//! Function to create the arcs used in the tests (consecutive arcs, overlapping by one hour).
+void createTestArcs( const unsigned int numberOfArcs,
+                     std::vector< double >& arcStartTimes,
+                     std::vector< double >& arcEndTimes,
+                     std::vector< Eigen::VectorXd >& arcInitialStates )
+{
+    arcStartTimes.clear( );
+    arcEndTimes.clear( );
+    arcInitialStates.clear( );
+    for( unsigned int i = 0; i < numberOfArcs; i++ )
+    {
+        arcStartTimes.push_back( 21600.0 * i );
+        arcEndTimes.push_back( 21600.0 * ( i + 1 ) + 3600.0 );
+
+        Eigen::Vector6d keplerianElements;
+        keplerianElements << 7000.0E3 + 100.0E3 * i, 0.01 + 0.01 * i, 0.5 + 0.1 * i, 1.0, 2.0 + 0.2 * i, 0.3 * i;
+        arcInitialStates.push_back( convertKeplerianToCartesianElements(
+                                        keplerianElements, earthGravitationalParameter ) );
+    }
+}
+
+//! Test whether multi-arc propagation reproduces single-arc propagation of each arc, for various numbers of threads.
+BOOST_AUTO_TEST_CASE( testMultiArcDynamicsSimulator )
+{
+    std::vector< double > arcStartTimes;
+    std::vector< double > arcEndTimes;
+    std::vector< Eigen::VectorXd > arcInitialStates;
+    createTestArcs( 5, arcStartTimes, arcEndTimes, arcInitialStates );
+
+    boost::shared_ptr< IntegratorSettings< > > integratorSettings =
+            boost::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, 30.0 );
+
+    // Propagate each arc separately.
+    std::vector< std::map< double, Eigen::VectorXd > > singleArcStateHistories;
+    for( unsigned int i = 0; i < arcStartTimes.size( ); i++ )
+    {
+        NamedBodyMap bodyMap = createTestBodyMap( );
+        SingleArcDynamicsSimulator< > singleArcSimulator(
+                    bodyMap, boost::make_shared< IntegratorSettings< > >( rungeKutta4, arcStartTimes.at( i ), 30.0 ),
+                    createTestPropagatorSettings( bodyMap, arcInitialStates.at( i ), arcEndTimes.at( i ) ) );
+        singleArcStateHistories.push_back( singleArcSimulator.getEquationsOfMotionNumericalSolution( ) );
+    }
+
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads *= 2 )
+    {
+        // Create environment and propagator settings for each thread.
+        std::vector< NamedBodyMap > bodyMaps;
+        std::vector< boost::shared_ptr< PropagatorSettings< double > > > propagatorSettings;
+        for( unsigned int i = 0; i < numberOfThreads; i++ )
+        {
+            bodyMaps.push_back( createTestBodyMap( ) );
+            propagatorSettings.push_back( createTestPropagatorSettings(
+                                              bodyMaps.at( i ), arcInitialStates.at( 0 ), arcEndTimes.at( 0 ) ) );
+        }
+
+        // Check that the arcs are propagated concurrently (no Spice models are used).
+        BOOST_CHECK_EQUAL( getNumberOfConcurrentMultiArcThreads( bodyMaps ), numberOfThreads );
+
+        MultiArcDynamicsSimulator< > multiArcSimulator(
+                    bodyMaps, integratorSettings, propagatorSettings, arcStartTimes, arcEndTimes, arcInitialStates );
+
+        // Check that the original integrator settings are not modified.
+        BOOST_CHECK_EQUAL( integratorSettings->initialTime_, 0.0 );
+
+        // Compare state histories of each arc with single-arc propagation.
+        std::vector< std::map< double, Eigen::VectorXd > > multiArcStateHistories =
+                multiArcSimulator.getEquationsOfMotionNumericalSolution( );
+        BOOST_CHECK_EQUAL( multiArcStateHistories.size( ), arcStartTimes.size( ) );
+        for( unsigned int i = 0; i < arcStartTimes.size( ); i++ )
+        {
+            BOOST_CHECK_EQUAL( multiArcStateHistories.at( i ).size( ), singleArcStateHistories.at( i ).size( ) );
+            BOOST_CHECK_EQUAL( multiArcStateHistories.at( i ).begin( )->first, arcStartTimes.at( i ) );
+            BOOST_CHECK( multiArcStateHistories.at( i ).rbegin( )->first >= arcEndTimes.at( i ) );
+            for( std::map< double, Eigen::VectorXd >::const_iterator stateIterator =
+                 singleArcStateHistories.at( i ).begin( ); stateIterator != singleArcStateHistories.at( i ).end( );
+                 stateIterator++ )
+            {
+                TUDAT_CHECK_MATRIX_CLOSE_FRACTION( multiArcStateHistories.at( i ).at( stateIterator->first ),
+                                                   stateIterator->second, std::numeric_limits< double >::epsilon( ) );
+            }
+            BOOST_CHECK_EQUAL( multiArcSimulator.getPropagationTerminationReasons( ).at( i ),
+                               termination_condition_reached );
+        }
+
+        // Check that the ephemeris of each body map switches between the arcs (using the later arc in overlaps).
+        for( unsigned int j = 0; j < numberOfThreads; j++ )
+        {
+            boost::shared_ptr< ephemerides::Ephemeris > vehicleEphemeris = bodyMaps.at( j ).at( "Vehicle" )->getEphemeris( );
+            BOOST_CHECK_EQUAL( ephemerides::isMultiArcEphemeris( vehicleEphemeris ), true );
+            BOOST_CHECK_EQUAL( vehicleEphemeris->getReferenceFrameOrigin( ), "Earth" );
+
+            for( unsigned int i = 0; i < arcStartTimes.size( ); i++ )
+            {
+                double testTime = arcStartTimes.at( i ) + 600.0;
+                TUDAT_CHECK_MATRIX_CLOSE_FRACTION( vehicleEphemeris->getCartesianState( testTime ),
+                                                   singleArcStateHistories.at( i ).at( testTime ), 1.0E-14 );
+            }
+        }
+    }
+
+    // Check that a repeated propagation resets the existing multi-arc ephemeris.
+    {
+        std::vector< NamedBodyMap > bodyMaps( 1, createTestBodyMap( ) );
+        std::vector< boost::shared_ptr< PropagatorSettings< double > > > propagatorSettings(
+                    1, createTestPropagatorSettings( bodyMaps.at( 0 ), arcInitialStates.at( 0 ), arcEndTimes.at( 0 ) ) );
+        MultiArcDynamicsSimulator< > multiArcSimulator(
+                    bodyMaps, integratorSettings, propagatorSettings, arcStartTimes, arcEndTimes, arcInitialStates );
+        boost::shared_ptr< ephemerides::Ephemeris > vehicleEphemeris = bodyMaps.at( 0 ).at( "Vehicle" )->getEphemeris( );
+
+        std::vector< Eigen::VectorXd > perturbedInitialStates = arcInitialStates;
+        perturbedInitialStates.at( 1 )( 0 ) += 1000.0;
+        multiArcSimulator.integrateEquationsOfMotion( perturbedInitialStates );
+
+        BOOST_CHECK_EQUAL( bodyMaps.at( 0 ).at( "Vehicle" )->getEphemeris( ), vehicleEphemeris );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( vehicleEphemeris->getCartesianState( arcStartTimes.at( 1 ) ),
+                                           perturbedInitialStates.at( 1 ), 1.0E-14 );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( vehicleEphemeris->getCartesianState( arcStartTimes.at( 2 ) ),
+                                           arcInitialStates.at( 2 ), 1.0E-14 );
+    }
+
+    // Check that inconsistent input is rejected.
+    {
+        std::vector< NamedBodyMap > bodyMaps( 1, createTestBodyMap( ) );
+        std::vector< boost::shared_ptr< PropagatorSettings< double > > > propagatorSettings(
+                    1, createTestPropagatorSettings( bodyMaps.at( 0 ), arcInitialStates.at( 0 ), arcEndTimes.at( 0 ) ) );
+
+        std::vector< double > unorderedArcStartTimes = arcStartTimes;
+        std::swap( unorderedArcStartTimes.at( 1 ), unorderedArcStartTimes.at( 2 ) );
+        BOOST_CHECK_THROW( MultiArcDynamicsSimulator< >(
+                               bodyMaps, integratorSettings, propagatorSettings, unorderedArcStartTimes, arcEndTimes,
+                               arcInitialStates ), std::runtime_error );
+
+        std::vector< Eigen::VectorXd > missingInitialStates( arcInitialStates.begin( ), arcInitialStates.end( ) - 1 );
+        BOOST_CHECK_THROW( MultiArcDynamicsSimulator< >(
+                               bodyMaps, integratorSettings, propagatorSettings, arcStartTimes, arcEndTimes,
+                               missingInitialStates ), std::runtime_error );
+
+        propagatorSettings.push_back( propagatorSettings.at( 0 ) );
+        BOOST_CHECK_THROW( MultiArcDynamicsSimulator< >(
+                               bodyMaps, integratorSettings, propagatorSettings, arcStartTimes, arcEndTimes,
+                               arcInitialStates ), std::runtime_error );
+    }
+}
+
+#if USE_CSPICE
+//! Test whether arcs are propagated serially if Spice is used during the propagation.
+BOOST_AUTO_TEST_CASE( testMultiArcSpiceDetection )
+{
+    std::vector< NamedBodyMap > bodyMaps;
+    bodyMaps.push_back( createTestBodyMap( ) );
+    bodyMaps.push_back( createTestBodyMap( ) );
+    BOOST_CHECK_EQUAL( doesBodyMapUseSpice( bodyMaps.at( 1 ) ), false );
+    BOOST_CHECK_EQUAL( getNumberOfConcurrentMultiArcThreads( bodyMaps ), 2 );
+
+    // Check detection of ephemeris evaluated from Spice.
+    bodyMaps.at( 1 ).at( "Earth" )->setEphemeris(
+                boost::make_shared< ephemerides::SpiceEphemeris >( "Earth", "SSB", false, false, false, "ECLIPJ2000" ) );
+    BOOST_CHECK_EQUAL( doesBodyMapUseSpice( bodyMaps.at( 1 ) ), true );
+    BOOST_CHECK_EQUAL( getNumberOfConcurrentMultiArcThreads( bodyMaps ), 1 );
+
+    // Check detection of rotation model evaluated from Spice.
+    bodyMaps.at( 1 ) = createTestBodyMap( );
+    bodyMaps.at( 1 ).at( "Earth" )->setRotationalEphemeris(
+                boost::make_shared< ephemerides::SpiceRotationalEphemeris >( "ECLIPJ2000", "IAU_Earth" ) );
+    BOOST_CHECK_EQUAL( doesBodyMapUseSpice( bodyMaps.at( 1 ) ), true );
+    BOOST_CHECK_EQUAL( getNumberOfConcurrentMultiArcThreads( bodyMaps ), 1 );
+}
+#endif
+
+//! Test whether multi-arc variational equations reproduce single-arc variational equations of each arc.
+BOOST_AUTO_TEST_CASE( testMultiArcVariationalEquationsSolver )
+{
+    std::vector< double > arcStartTimes;
+    std::vector< double > arcEndTimes;
+    std::vector< Eigen::VectorXd > arcInitialStates;
+    createTestArcs( 3, arcStartTimes, arcEndTimes, arcInitialStates );
+
+    // Propagate variational equations of each arc separately.
+    std::vector< boost::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > >
+            singleArcStateTransitionInterfaces;
+    for( unsigned int i = 0; i < arcStartTimes.size( ); i++ )
+    {
+        NamedBodyMap bodyMap = createTestBodyMap( );
+        boost::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+                createTestPropagatorSettings( bodyMap, arcInitialStates.at( i ), arcEndTimes.at( i ) );
+        SingleArcVariationalEquationsSolver< > singleArcSolver(
+                    bodyMap, boost::make_shared< IntegratorSettings< > >( rungeKutta4, arcStartTimes.at( i ), 30.0 ),
+                    propagatorSettings, createTestParameters( bodyMap, propagatorSettings, arcInitialStates.at( i ) ) );
+        singleArcStateTransitionInterfaces.push_back( singleArcSolver.getStateTransitionMatrixInterface( ) );
+    }
+
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 2; numberOfThreads++ )
+    {
+        std::vector< NamedBodyMap > bodyMaps;
+        std::vector< boost::shared_ptr< PropagatorSettings< double > > > propagatorSettings;
+        std::vector< boost::shared_ptr< EstimatableParameterSet< double > > > parameterSets;
+        for( unsigned int i = 0; i < numberOfThreads; i++ )
+        {
+            bodyMaps.push_back( createTestBodyMap( ) );
+            boost::shared_ptr< TranslationalStatePropagatorSettings< double > > currentPropagatorSettings =
+                    createTestPropagatorSettings( bodyMaps.at( i ), arcInitialStates.at( 0 ), arcEndTimes.at( 0 ) );
+            propagatorSettings.push_back( currentPropagatorSettings );
+            parameterSets.push_back( createTestParameters(
+                                         bodyMaps.at( i ), currentPropagatorSettings, arcInitialStates.at( 0 ) ) );
+        }
+
+        MultiArcVariationalEquationsSolver< > multiArcSolver(
+                    bodyMaps, boost::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, 30.0 ),
+                    propagatorSettings, parameterSets, arcStartTimes, arcEndTimes, arcInitialStates,
+                    true, false );
+
+        boost::shared_ptr< MultiArcCombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface =
+                boost::dynamic_pointer_cast< MultiArcCombinedStateTransitionAndSensitivityMatrixInterface >(
+                    multiArcSolver.getStateTransitionMatrixInterface( ) );
+        BOOST_CHECK( stateTransitionInterface != NULL );
+        BOOST_CHECK_EQUAL( stateTransitionInterface->getNumberOfArcs( ), 3 );
+        BOOST_CHECK_EQUAL( stateTransitionInterface->getFullParameterVectorSize( ), 3 * 6 + 1 );
+        BOOST_CHECK_EQUAL( multiArcSolver.getNumericalVariationalEquationsSolution( ).size( ), 3 );
+
+        for( unsigned int i = 0; i < arcStartTimes.size( ); i++ )
+        {
+            double testTime = arcStartTimes.at( i ) + 9000.0;
+            BOOST_CHECK_EQUAL( stateTransitionInterface->getCurrentArc( testTime ), static_cast< int >( i ) );
+
+            // Compare matrices of current arc with single-arc solution.
+            Eigen::MatrixXd singleArcMatrix =
+                    singleArcStateTransitionInterfaces.at( i )->getCombinedStateTransitionAndSensitivityMatrix( testTime );
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                        stateTransitionInterface->getCombinedStateTransitionAndSensitivityMatrix( testTime ),
+                        singleArcMatrix, 1.0E-14 );
+
+            // Check that full matrix contains state transition matrix in columns of current arc only.
+            Eigen::MatrixXd fullMatrix = stateTransitionInterface->getFullCombinedStateTransitionAndSensitivityMatrix(
+                        testTime );
+            BOOST_CHECK_EQUAL( fullMatrix.cols( ), 3 * 6 + 1 );
+            for( unsigned int j = 0; j < arcStartTimes.size( ); j++ )
+            {
+                if( j == i )
+                {
+                    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( fullMatrix.block( 0, 6 * j, 6, 6 ),
+                                                       singleArcMatrix.block( 0, 0, 6, 6 ), 1.0E-14 );
+                }
+                else
+                {
+                    BOOST_CHECK_EQUAL( fullMatrix.block( 0, 6 * j, 6, 6 ).cwiseAbs( ).maxCoeff( ), 0.0 );
+                }
+            }
+            TUDAT_CHECK_MATRIX_CLOSE_FRACTION( fullMatrix.rightCols( 1 ), singleArcMatrix.rightCols( 1 ), 1.0E-14 );
+        }
+
+        // Check that the propagated states are set in the environment.
+        for( unsigned int j = 0; j < numberOfThreads; j++ )
+        {
+            boost::shared_ptr< ephemerides::Ephemeris > vehicleEphemeris = bodyMaps.at( j ).at( "Vehicle" )->getEphemeris( );
+            BOOST_CHECK_EQUAL( ephemerides::isMultiArcEphemeris( vehicleEphemeris ), true );
+            for( unsigned int i = 0; i < arcStartTimes.size( ); i++ )
+            {
+                TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                            vehicleEphemeris->getCartesianState( arcStartTimes.at( i ) + 1800.0 ),
+                            multiArcSolver.getEquationsOfMotionNumericalSolution( ).at( i ).at(
+                                arcStartTimes.at( i ) + 1800.0 ), 1.0E-14 );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
@@ -0,0 +1,345 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Ephemerides/tabulatedEphemeris.h"
+#include "Tudat/Astrodynamics/Propagators/nBodyCowellStateDerivative.h"
+#include "Tudat/Basics/parallelization.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createBodies.h"
+#include "Tudat/SimulationSetup/PropagationSetup/createNumericalSimulator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace propagators;
+
+//! Class to create a Cowell state derivative model for a constellation of satellites around an Earth-like body.
+/*!
+ *  Class to create a Cowell state derivative model for a constellation of satellites around an Earth-like body
+ *  (with spherical harmonic gravity field, located at the origin), perturbed by a Moon-like point mass. The positions
+ *  of the satellites used by the acceleration models are stored in this object, and set from the propagated state by
+ *  the computeStateDerivative function.
+ */
+class ConstellationStateDerivativeModel
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param numberOfSatellites Number of satellites in constellation.
+     *  \param maximumDegree Maximum degree (and order) of the spherical harmonic gravity field.
+     */
+    ConstellationStateDerivativeModel( const unsigned int numberOfSatellites, const int maximumDegree )
+    {
+        const double earthGravitationalParameter = 3.986004418E14;
+        const double moonGravitationalParameter = 4.9028E12;
+        const Eigen::Vector3d moonPosition = ( Eigen::Vector3d( ) << 3.0E8, 2.4E8, 1.0E7 ).finished( );
+
+        // Set (arbitrary, but deterministic) spherical harmonic coefficients.
+        Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 1 );
+        Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumDegree + 1 );
+        cosineCoefficients( 0, 0 ) = 1.0;
+        for( int n = 2; n <= maximumDegree; n++ )
+        {
+            for( int m = 0; m <= n; m++ )
+            {
+                cosineCoefficients( n, m ) = 1.0E-6 * std::cos( static_cast< double >( 3 * n + m ) ) / ( n * n );
+                if( m > 0 )
+                {
+                    sineCoefficients( n, m ) = 1.0E-6 * std::sin( static_cast< double >( n + 5 * m ) ) / ( n * n );
+                }
+            }
+        }
+
+        // Set initial states of satellites in circular orbits, with varying altitude, inclination and node.
+        satellitePositions_.resize( numberOfSatellites );
+        initialState_.resize( 6 * numberOfSatellites );
+        std::vector< std::string > centralBodies;
+        basic_astrodynamics::AccelerationMap accelerationMap;
+        for( unsigned int i = 0; i < numberOfSatellites; i++ )
+        {
+            const double radius = 6.9E6 + 1.0E3 * static_cast< double >( i % 500 );
+            const double inclination = 0.1 + 0.01 * static_cast< double >( i % 150 );
+            const double node = 0.37 * static_cast< double >( i );
+            const double velocity = std::sqrt( earthGravitationalParameter / radius );
+
+            initialState_.segment( 6 * i, 3 ) =
+                    radius * Eigen::Vector3d( std::cos( node ), std::sin( node ), 0.0 );
+            initialState_.segment( 6 * i + 3, 3 ) = velocity * Eigen::Vector3d(
+                        -std::sin( node ) * std::cos( inclination ), std::cos( node ) * std::cos( inclination ),
+                        std::sin( inclination ) );
+
+            const std::string satelliteName = "Satellite" + boost::lexical_cast< std::string >( i );
+            bodiesToPropagate_.push_back( satelliteName );
+            centralBodies.push_back( "SSB" );
+
+            boost::function< Eigen::Vector3d( ) > satellitePositionFunction =
+                    [ this, i ]( ){ return satellitePositions_[ i ]; };
+            accelerationMap[ satelliteName ][ "Earth" ].push_back(
+                        boost::make_shared< gravitation::SphericalHarmonicsGravitationalAccelerationModel >(
+                            satellitePositionFunction, earthGravitationalParameter, 6378137.0,
+                            cosineCoefficients, sineCoefficients ) );
+            accelerationMap[ satelliteName ][ "Moon" ].push_back(
+                        boost::make_shared< gravitation::CentralGravitationalAccelerationModel3d >(
+                            satellitePositionFunction, moonGravitationalParameter,
+                            [ moonPosition ]( ){ return moonPosition; } ) );
+        }
+
+        stateDerivativeModel_ = boost::make_shared< NBodyCowellStateDerivative< double, double > >(
+                    accelerationMap, boost::make_shared< CentralBodyData< double, double > >(
+                        centralBodies, bodiesToPropagate_,
+                        std::map< std::string, boost::function< Eigen::Vector6d( const double ) > >( ) ),
+                    bodiesToPropagate_ );
+    }
+
+    //! Function to compute the state derivative, updating the environment and acceleration models.
+    /*!
+     *  Function to compute the state derivative, updating the environment and acceleration models.
+     *  \param time Current time.
+     *  \param state Current state of constellation.
+     *  \return State derivative of constellation.
+     */
+    Eigen::VectorXd computeStateDerivative( const double time, const Eigen::VectorXd& state )
+    {
+        for( unsigned int i = 0; i < satellitePositions_.size( ); i++ )
+        {
+            satellitePositions_[ i ] = state.segment( 6 * i, 3 );
+        }
+
+        Eigen::MatrixXd stateDerivative = Eigen::MatrixXd::Zero( state.rows( ), 1 );
+        stateDerivativeModel_->clearStateDerivativeModel( );
+        stateDerivativeModel_->updateStateDerivativeModel( time );
+        stateDerivativeModel_->calculateSystemStateDerivative(
+                    time, state, stateDerivative.block( 0, 0, state.rows( ), 1 ) );
+        return stateDerivative;
+    }
+
+    //! Translational state derivative model of constellation.
+    boost::shared_ptr< NBodyCowellStateDerivative< double, double > > stateDerivativeModel_;
+
+    //! Initial state of constellation.
+    Eigen::VectorXd initialState_;
+
+    //! Names of propagated satellites.
+    std::vector< std::string > bodiesToPropagate_;
+
+    //! Current positions of satellites, used by acceleration models.
+    std::vector< Eigen::Vector3d > satellitePositions_;
+};
+
+BOOST_AUTO_TEST_SUITE( test_parallel_n_body_state_derivative )
+
+//! Test whether the state derivative is independent of the number of threads.
+BOOST_AUTO_TEST_CASE( testParallelStateDerivativeDeterminism )
+{
+    ConstellationStateDerivativeModel constellationModel( 57, 6 );
+    BOOST_CHECK_EQUAL( constellationModel.stateDerivativeModel_->getNumberOfThreads( ), 1 );
+    BOOST_CHECK_EQUAL( constellationModel.stateDerivativeModel_->isEvaluationParallel( ), false );
+
+    // Compute state derivatives along a number of fixed (Euler) steps, using serial evaluation.
+    std::vector< Eigen::VectorXd > serialStateDerivatives;
+    Eigen::VectorXd currentState = constellationModel.initialState_;
+    for( unsigned int i = 0; i < 5; i++ )
+    {
+        serialStateDerivatives.push_back(
+                    constellationModel.computeStateDerivative( 10.0 * static_cast< double >( i ), currentState ) );
+        currentState += 10.0 * serialStateDerivatives.back( );
+    }
+
+    // Check that parallel evaluation gives identical results, including a number of threads exceeding the number of
+    // propagated bodies.
+    std::vector< unsigned int > numbersOfThreads = { 2, 3, 8, 64, 1 };
+    for( unsigned int j = 0; j < numbersOfThreads.size( ); j++ )
+    {
+        constellationModel.stateDerivativeModel_->setNumberOfThreads( numbersOfThreads.at( j ) );
+        BOOST_CHECK_EQUAL( constellationModel.stateDerivativeModel_->isEvaluationParallel( ),
+                           ( numbersOfThreads.at( j ) > 1 ) );
+
+        currentState = constellationModel.initialState_;
+        for( unsigned int i = 0; i < serialStateDerivatives.size( ); i++ )
+        {
+            Eigen::VectorXd stateDerivative =
+                    constellationModel.computeStateDerivative( 10.0 * static_cast< double >( i ), currentState );
+            for( int k = 0; k < stateDerivative.rows( ); k++ )
+            {
+                BOOST_CHECK_EQUAL( stateDerivative( k ), serialStateDerivatives.at( i )( k ) );
+            }
+            currentState += 10.0 * stateDerivative;
+        }
+
+        // Check total acceleration output, used for dependent variables.
+        BOOST_CHECK_EQUAL(
+                    ( constellationModel.stateDerivativeModel_->getTotalAccelerationForBody( "Satellite5" ) -
+                      serialStateDerivatives.back( ).segment( 6 * 5 + 3, 3 ) ).norm( ), 0.0 );
+    }
+}
+
+//! Test whether evaluation is only distributed over threads above the minimum number of propagated bodies.
+BOOST_AUTO_TEST_CASE( testParallelStateDerivativeBreakEven )
+{
+    ConstellationStateDerivativeModel smallConstellationModel( defaultMinimumNumberOfParallelBodies - 1, 2 );
+    smallConstellationModel.stateDerivativeModel_->setNumberOfThreads( 4 );
+    BOOST_CHECK_EQUAL( smallConstellationModel.stateDerivativeModel_->getNumberOfThreads( ), 4 );
+    BOOST_CHECK_EQUAL( smallConstellationModel.stateDerivativeModel_->isEvaluationParallel( ), false );
+
+    ConstellationStateDerivativeModel largeConstellationModel( defaultMinimumNumberOfParallelBodies, 2 );
+    largeConstellationModel.stateDerivativeModel_->setNumberOfThreads( 4 );
+    BOOST_CHECK_EQUAL( largeConstellationModel.stateDerivativeModel_->isEvaluationParallel( ), true );
+
+    // Check user-defined minimum number of bodies.
+    largeConstellationModel.stateDerivativeModel_->setNumberOfThreads( 4, defaultMinimumNumberOfParallelBodies + 1 );
+    BOOST_CHECK_EQUAL( largeConstellationModel.stateDerivativeModel_->isEvaluationParallel( ), false );
+    smallConstellationModel.stateDerivativeModel_->setNumberOfThreads( 4, 2 );
+    BOOST_CHECK_EQUAL( smallConstellationModel.stateDerivativeModel_->isEvaluationParallel( ), true );
+}
+
+//! Test whether the state derivative of a large constellation is independent of the number of threads (1 to 64), with
+//! the threads reused for repeated evaluations.
+BOOST_AUTO_TEST_CASE( testParallelStateDerivativeLargeConstellation )
+{
+    ConstellationStateDerivativeModel constellationModel( 1000, 8 );
+
+    Eigen::VectorXd serialStateDerivative;
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 64; numberOfThreads *= 2 )
+    {
+        constellationModel.stateDerivativeModel_->setNumberOfThreads( numberOfThreads );
+
+        Eigen::VectorXd stateDerivative;
+        for( unsigned int i = 0; i < 5; i++ )
+        {
+            stateDerivative = constellationModel.computeStateDerivative(
+                        static_cast< double >( i ), constellationModel.initialState_ );
+        }
+
+        if( numberOfThreads == 1 )
+        {
+            serialStateDerivative = stateDerivative;
+        }
+        BOOST_CHECK_EQUAL( ( stateDerivative - serialStateDerivative ).norm( ), 0.0 );
+    }
+}
+
+//! Test whether propagation of satellites, with acceleration models created from settings (acting between shared Body
+//! objects), is independent of the number of threads.
+BOOST_AUTO_TEST_CASE( testParallelStateDerivativeFromAccelerationSettings )
+{
+    using namespace simulation_setup;
+    using namespace numerical_integrators;
+
+    const unsigned int numberOfSatellites = 24;
+    const double earthGravitationalParameter = 3.986004418E14;
+
+    // Create Earth (spherical harmonic gravity, rotating) and Moon (point mass) with constant ephemerides.
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( 5, 5 );
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( 5, 5 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    cosineCoefficients( 2, 0 ) = -4.84E-4;
+    cosineCoefficients( 2, 2 ) = 2.44E-6;
+    sineCoefficients( 2, 2 ) = -1.40E-6;
+    cosineCoefficients( 4, 1 ) = -5.36E-7;
+    sineCoefficients( 4, 3 ) = -2.12E-7;
+
+    std::map< std::string, boost::shared_ptr< BodySettings > > bodySettings;
+    bodySettings[ "Earth" ] = boost::make_shared< BodySettings >( );
+    bodySettings[ "Earth" ]->ephemerisSettings = boost::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ), "SSB", "ECLIPJ2000" );
+    bodySettings[ "Earth" ]->rotationModelSettings = boost::make_shared< SimpleRotationModelSettings >(
+                "ECLIPJ2000", "IAU_Earth", Eigen::Quaterniond( Eigen::AngleAxisd( 0.4, Eigen::Vector3d::UnitX( ) ) ),
+                0.0, 7.292115E-5 );
+    bodySettings[ "Earth" ]->gravityFieldSettings = boost::make_shared< SphericalHarmonicsGravityFieldSettings >(
+                earthGravitationalParameter, 6378137.0, cosineCoefficients, sineCoefficients, "IAU_Earth" );
+    bodySettings[ "Moon" ] = boost::make_shared< BodySettings >( );
+    bodySettings[ "Moon" ]->ephemerisSettings = boost::make_shared< ConstantEphemerisSettings >(
+                ( Eigen::Vector6d( ) << 3.0E8, 2.4E8, 1.0E7, 0.0, 0.0, 0.0 ).finished( ), "SSB", "ECLIPJ2000" );
+    bodySettings[ "Moon" ]->gravityFieldSettings = boost::make_shared< CentralGravityFieldSettings >( 4.9028E12 );
+    NamedBodyMap bodyMap = createBodies( bodySettings );
+
+    // Create satellites and their accelerations.
+    SelectedAccelerationMap accelerationSettings;
+    std::map< std::string, std::string > centralBodyMap;
+    std::vector< std::string > bodiesToPropagate;
+    std::vector< std::string > centralBodies;
+    Eigen::VectorXd initialState = Eigen::VectorXd( 6 * numberOfSatellites );
+    for( unsigned int i = 0; i < numberOfSatellites; i++ )
+    {
+        const std::string satelliteName = "Satellite" + boost::lexical_cast< std::string >( i );
+        bodyMap[ satelliteName ] = boost::make_shared< Body >( );
+        bodyMap[ satelliteName ]->setEphemeris(
+                    boost::make_shared< ephemerides::TabulatedCartesianEphemeris< double, double > >(
+                        boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::Vector6d > >( ),
+                        "Earth", "ECLIPJ2000" ) );
+
+        accelerationSettings[ satelliteName ][ "Earth" ].push_back(
+                    boost::make_shared< SphericalHarmonicAccelerationSettings >( 4, 4 ) );
+        accelerationSettings[ satelliteName ][ "Moon" ].push_back(
+                    boost::make_shared< AccelerationSettings >( basic_astrodynamics::central_gravity ) );
+        centralBodyMap[ satelliteName ] = "Earth";
+        bodiesToPropagate.push_back( satelliteName );
+        centralBodies.push_back( "Earth" );
+
+        const double radius = 7.0E6 + 5.0E3 * static_cast< double >( i );
+        const double inclination = 0.2 + 0.05 * static_cast< double >( i );
+        const double node = 0.37 * static_cast< double >( i );
+        const double velocity = std::sqrt( earthGravitationalParameter / radius );
+        initialState.segment( 6 * i, 3 ) = radius * Eigen::Vector3d( std::cos( node ), std::sin( node ), 0.0 );
+        initialState.segment( 6 * i + 3, 3 ) = velocity * Eigen::Vector3d(
+                    -std::sin( node ) * std::cos( inclination ), std::cos( node ) * std::cos( inclination ),
+                    std::sin( inclination ) );
+    }
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+    basic_astrodynamics::AccelerationMap accelerationModelMap = createAccelerationModelsMap(
+                bodyMap, accelerationSettings, centralBodyMap );
+
+    // Propagate satellites for various numbers of threads.
+    std::map< double, Eigen::VectorXd > serialStateHistory;
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads *= 2 )
+    {
+        SingleArcDynamicsSimulator< > dynamicsSimulator(
+                    bodyMap, boost::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, 10.0 ),
+                    boost::make_shared< TranslationalStatePropagatorSettings< double > >(
+                        centralBodies, accelerationModelMap, bodiesToPropagate, initialState, 600.0, cowell,
+                        boost::shared_ptr< DependentVariableSaveSettings >( ), TUDAT_NAN, numberOfThreads ) );
+        std::map< double, Eigen::VectorXd > stateHistory = dynamicsSimulator.getEquationsOfMotionNumericalSolution( );
+
+        if( numberOfThreads == 1 )
+        {
+            serialStateHistory = stateHistory;
+        }
+
+        BOOST_CHECK_EQUAL( stateHistory.size( ), serialStateHistory.size( ) );
+        for( std::map< double, Eigen::VectorXd >::const_iterator stateIterator = stateHistory.begin( );
+             stateIterator != stateHistory.end( ); stateIterator++ )
+        {
+            BOOST_CHECK_EQUAL( ( stateIterator->second - serialStateHistory.at( stateIterator->first ) ).norm( ), 0.0 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
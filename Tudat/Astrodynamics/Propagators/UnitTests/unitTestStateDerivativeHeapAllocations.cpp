@@ -0,0 +1,216 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Notes
+ *      This test is compiled with Tudat/Basics/allocationAuditHooks.cpp (see CMakeLists.txt), so that all heap
+ *      allocations in the test executable are counted.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/allocationAudit.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
+#include "Tudat/Astrodynamics/Ephemerides/keplerEphemeris.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createBodies.h"
+#include "Tudat/SimulationSetup/PropagationSetup/createNumericalSimulator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace tudat::simulation_setup;
+using namespace tudat::basic_astrodynamics;
+using namespace tudat::propagators;
+using namespace tudat::numerical_integrators;
+using namespace tudat::orbital_element_conversions;
+using namespace tudat::utilities;
+
+BOOST_AUTO_TEST_SUITE( test_state_derivative_heap_allocations )
+
+//! Gravitational parameter of the central body used in the tests.
+const double earthGravitationalParameter = 3.986004418E14;
+
+//! Function to create the environment used in the tests (Earth with spherical harmonic gravity field, Moon and Sun
+//! point masses and a vehicle), without using Spice.
+NamedBodyMap createTestBodyMap( )
+{
+    // Create (arbitrary) normalized spherical harmonic coefficients up to degree and order 8.
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( 9, 9 );
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( 9, 9 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    for( unsigned int i = 2; i < 9; i++ )
+    {
+        for( unsigned int j = 0; j <= i; j++ )
+        {
+            cosineCoefficients( i, j ) = 1.0E-6 / static_cast< double >( i * i + j + 1 );
+            if( j > 0 )
+            {
+                sineCoefficients( i, j ) = -0.5E-6 / static_cast< double >( i * i + j + 1 );
+            }
+        }
+    }
+    cosineCoefficients( 2, 0 ) = -4.84E-4;
+
+    std::map< std::string, boost::shared_ptr< BodySettings > > bodySettings;
+    bodySettings[ "Earth" ] = boost::make_shared< BodySettings >( );
+    bodySettings[ "Earth" ]->ephemerisSettings = boost::make_shared< ConstantEphemerisSettings >(
+                Eigen::Vector6d::Zero( ), "SSB", "ECLIPJ2000" );
+    bodySettings[ "Earth" ]->gravityFieldSettings = boost::make_shared< SphericalHarmonicsGravityFieldSettings >(
+                earthGravitationalParameter, 6378.0E3, cosineCoefficients, sineCoefficients, "IAU_Earth" );
+    bodySettings[ "Earth" ]->rotationModelSettings = boost::make_shared< SimpleRotationModelSettings >(
+                "ECLIPJ2000", "IAU_Earth", Eigen::Quaterniond( Eigen::AngleAxisd( 0.4, Eigen::Vector3d::UnitX( ) ) ),
+                0.0, 7.292115E-5 );
+
+    // Create tabulated ephemeris for Moon from a Kepler orbit.
+    Eigen::Vector6d moonKeplerianElements;
+    moonKeplerianElements << 384.4E6, 0.055, 0.09, 1.0, 2.0, 3.0;
+    ephemerides::KeplerEphemeris moonKeplerEphemeris(
+                moonKeplerianElements, 0.0, earthGravitationalParameter, "Earth", "ECLIPJ2000" );
+    std::map< double, Eigen::Vector6d > moonStateHistory;
+    for( int i = -10; i < 50; i++ )
+    {
+        moonStateHistory[ 300.0 * i ] = moonKeplerEphemeris.getCartesianState( 300.0 * i );
+    }
+    bodySettings[ "Moon" ] = boost::make_shared< BodySettings >( );
+    bodySettings[ "Moon" ]->ephemerisSettings = boost::make_shared< TabulatedEphemerisSettings >(
+                moonStateHistory, "Earth", "ECLIPJ2000" );
+    bodySettings[ "Moon" ]->gravityFieldSettings = boost::make_shared< CentralGravityFieldSettings >( 4.9028E12 );
+
+    Eigen::Vector6d sunState = Eigen::Vector6d::Zero( );
+    sunState( 0 ) = 1.496E11;
+    bodySettings[ "Sun" ] = boost::make_shared< BodySettings >( );
+    bodySettings[ "Sun" ]->ephemerisSettings = boost::make_shared< ConstantEphemerisSettings >(
+                sunState, "SSB", "ECLIPJ2000" );
+    bodySettings[ "Sun" ]->gravityFieldSettings = boost::make_shared< CentralGravityFieldSettings >( 1.32712440018E20 );
+
+    NamedBodyMap bodyMap = createBodies( bodySettings );
+    bodyMap[ "Vehicle" ] = boost::make_shared< Body >( );
+    bodyMap[ "Vehicle" ]->setConstantBodyMass( 1000.0 );
+    setGlobalFrameBodyEphemerides( bodyMap, "SSB", "ECLIPJ2000" );
+    return bodyMap;
+}
+
+//! Test whether heap allocations are counted by the allocation audit.
+BOOST_AUTO_TEST_CASE( testHeapAllocationCounter )
+{
+    BOOST_CHECK_EQUAL( isHeapAllocationAuditActive( ), true );
+
+    HeapAllocationCounter allocationCounter;
+    {
+        std::vector< double > vector( 10 );
+        Eigen::VectorXd eigenVector = Eigen::VectorXd::Zero( 20 );
+        BOOST_CHECK_EQUAL( vector.size( ), 10 );
+        BOOST_CHECK_EQUAL( eigenVector.rows( ), 20 );
+    }
+    BOOST_CHECK_EQUAL( allocationCounter.getNumberOfAllocations( ), 2 );
+
+    allocationCounter.reset( );
+    Eigen::Vector3d fixedSizeVector = Eigen::Vector3d::Ones( );
+    fixedSizeVector *= 2.0;
+    BOOST_CHECK_EQUAL( allocationCounter.getNumberOfAllocations( ), 0 );
+    BOOST_CHECK_EQUAL( fixedSizeVector( 0 ), 2.0 );
+}
+
+//! Test whether the evaluation of the state derivative of a Cowell propagation does not allocate memory in
+//! steady-state.
+BOOST_AUTO_TEST_CASE( testCowellStateDerivativeAllocations )
+{
+    NamedBodyMap bodyMap = createTestBodyMap( );
+
+    // Create acceleration models.
+    SelectedAccelerationMap accelerationMap;
+    accelerationMap[ "Vehicle" ][ "Earth" ].push_back( boost::make_shared< SphericalHarmonicAccelerationSettings >( 8, 8 ) );
+    accelerationMap[ "Vehicle" ][ "Moon" ].push_back( boost::make_shared< AccelerationSettings >( central_gravity ) );
+    accelerationMap[ "Vehicle" ][ "Sun" ].push_back( boost::make_shared< AccelerationSettings >( central_gravity ) );
+    std::map< std::string, std::string > centralBodyMap;
+    centralBodyMap[ "Vehicle" ] = "Earth";
+    AccelerationMap accelerationModelMap = createAccelerationModelsMap( bodyMap, accelerationMap, centralBodyMap );
+
+    // Define dependent variables.
+    std::vector< boost::shared_ptr< SingleDependentVariableSaveSettings > > dependentVariables;
+    dependentVariables.push_back( boost::make_shared< SingleDependentVariableSaveSettings >(
+                                      relative_distance_dependent_variable, "Vehicle", "Earth" ) );
+    dependentVariables.push_back( boost::make_shared< SingleDependentVariableSaveSettings >(
+                                      relative_position_dependent_variable, "Vehicle", "Moon" ) );
+    dependentVariables.push_back( boost::make_shared< SingleAccelerationDependentVariableSaveSettings >(
+                                      spherical_harmonic_gravity, "Vehicle", "Earth" ) );
+
+    Eigen::Vector6d keplerianElements;
+    keplerianElements << 7000.0E3, 0.01, 0.9, 1.0, 2.0, 0.3;
+    Eigen::VectorXd initialState = convertKeplerianToCartesianElements( keplerianElements, earthGravitationalParameter );
+
+    boost::shared_ptr< TranslationalStatePropagatorSettings< double > > propagatorSettings =
+            boost::make_shared< TranslationalStatePropagatorSettings< double > >(
+                std::vector< std::string >( 1, "Earth" ), accelerationModelMap, std::vector< std::string >( 1, "Vehicle" ),
+                initialState, 600.0, cowell, boost::make_shared< DependentVariableSaveSettings >(
+                    dependentVariables, false ) );
+
+    // Propagate orbit, to set up all models and caches.
+    SingleArcDynamicsSimulator< > dynamicsSimulator(
+                bodyMap, boost::make_shared< IntegratorSettings< > >( rungeKutta4, 0.0, 10.0 ), propagatorSettings );
+    Eigen::MatrixXd currentState = dynamicsSimulator.getEquationsOfMotionNumericalSolution( ).rbegin( )->second;
+
+    boost::shared_ptr< DynamicsStateDerivativeModel< double, double > > stateDerivativeModel =
+            dynamicsSimulator.getDynamicsStateDerivative( );
+    boost::function< Eigen::VectorXd( ) > dependentVariableFunction =
+            createDependentVariableListFunction< double, double >(
+                propagatorSettings->getDependentVariablesToSave( ), bodyMap,
+                stateDerivativeModel->getStateDerivativeModels( ) ).first;
+
+    // Evaluate state derivative a number of times, at different times.
+    const unsigned int numberOfEvaluations = 1000;
+    Eigen::MatrixXd stateDerivative = Eigen::MatrixXd::Zero( 6, 1 );
+
+    // Perform a single evaluation before counting, so that one-time lazy initialization is excluded.
+    stateDerivativeModel->computeStateDerivative( 599.5, currentState, stateDerivative );
+    dependentVariableFunction( );
+
+    HeapAllocationCounter allocationCounter;
+    for( unsigned int i = 0; i < numberOfEvaluations; i++ )
+    {
+        stateDerivativeModel->computeStateDerivative( 600.0 + static_cast< double >( i ), currentState, stateDerivative );
+    }
+    unsigned long long numberOfStateDerivativeAllocations = allocationCounter.getNumberOfAllocations( );
+
+    // Check that no heap memory is allocated during state derivative evaluation.
+    BOOST_CHECK_EQUAL( numberOfStateDerivativeAllocations, 0 );
+    BOOST_CHECK_EQUAL( ( stateDerivative.block( 0, 0, 3, 1 ) - currentState.block( 3, 0, 3, 1 ) ).norm( ), 0.0 );
+    BOOST_CHECK( stateDerivative.block( 3, 0, 3, 1 ).norm( ) > 0.0 );
+
+    // Check that the state derivative returned by value is identical.
+    BOOST_CHECK( stateDerivativeModel->computeStateDerivative(
+                     600.0 + static_cast< double >( numberOfEvaluations - 1 ), currentState ) == stateDerivative );
+
+    // Evaluate dependent variables a number of times.
+    Eigen::VectorXd dependentVariableValues;
+    allocationCounter.reset( );
+    for( unsigned int i = 0; i < numberOfEvaluations; i++ )
+    {
+        stateDerivativeModel->computeStateDerivative( 2000.0 + static_cast< double >( i ), currentState, stateDerivative );
+        dependentVariableValues = dependentVariableFunction( );
+    }
+    unsigned long long numberOfDependentVariableAllocations = allocationCounter.getNumberOfAllocations( );
+
+    // Check that only the dependent variable vectors that are returned by value are allocated (at most three per
+    // evaluation).
+    BOOST_CHECK( numberOfDependentVariableAllocations <= 3 * numberOfEvaluations );
+    BOOST_CHECK_EQUAL( dependentVariableValues.rows( ), 7 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
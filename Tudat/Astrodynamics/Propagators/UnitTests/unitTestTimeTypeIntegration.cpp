@@ -0,0 +1,192 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <map>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Propagators/integrateEquations.h"
+#include "Tudat/Basics/timeType.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace numerical_integrators;
+using namespace propagators;
+
+typedef Eigen::Matrix< double, 6, 1 > StateType;
+
+//! Function to compute the state derivative of a Kepler orbit (mu = 1), with a periodic forcing along the x-axis.
+/*!
+ *  Function to compute the state derivative of a Kepler orbit (mu = 1), with a periodic forcing along the x-axis, of
+ *  which the phase is computed from the time since a reference epoch.
+ *  \param currentTime Current time
+ *  \param currentState Current Cartesian state
+ *  \param referenceEpoch Epoch at which the phase of the forcing is zero
+ *  \return Current state derivative
+ */
+template< typename TimeType >
+StateType computeForcedKeplerStateDerivative(
+        const TimeType currentTime, const StateType& currentState, const TimeType referenceEpoch )
+{
+    StateType stateDerivative;
+    stateDerivative.segment( 0, 3 ) = currentState.segment( 3, 3 );
+
+    const double distance = currentState.segment( 0, 3 ).norm( );
+    stateDerivative.segment( 3, 3 ) = -currentState.segment( 0, 3 ) / ( distance * distance * distance );
+    stateDerivative( 3 ) += 1.0E-3 * std::cos( 10.0 * static_cast< double >( currentTime - referenceEpoch ) );
+    return stateDerivative;
+}
+
+//! Function to stop the propagation when a given end time is reached.
+bool stopPropagationAtTime( const double currentTime, const double endTime )
+{
+    return currentTime >= endTime;
+}
+
+//! Function to propagate the forced Kepler orbit with integrateEquations, and return the state history.
+template< typename TimeType >
+std::map< TimeType, StateType > propagateForcedKeplerOrbit(
+        const boost::shared_ptr< IntegratorSettings< TimeType > > integratorSettings,
+        const double propagationDuration )
+{
+    StateType initialState;
+    initialState << 1.0, 0.0, 0.0, 0.0, 1.1, 0.0;
+
+    std::map< TimeType, StateType > stateHistory;
+    std::map< TimeType, Eigen::VectorXd > dependentVariableHistory;
+
+    EquationIntegrationInterface< StateType, TimeType >::integrateEquations(
+                boost::bind( &computeForcedKeplerStateDerivative< TimeType >, _1, _2,
+                             integratorSettings->initialTime_ ),
+                stateHistory, initialState, integratorSettings,
+                boost::bind( &stopPropagationAtTime, _1,
+                             static_cast< double >( integratorSettings->initialTime_ ) + propagationDuration ),
+                dependentVariableHistory );
+
+    return stateHistory;
+}
+
+BOOST_AUTO_TEST_SUITE( test_time_type_integration )
+
+//! Test whether propagation with Time at a distant epoch reproduces propagation with double at zero epoch.
+BOOST_AUTO_TEST_CASE( testTimeTypeIntegrationAtDistantEpoch )
+{
+    const double timeStep = 0.01;
+    const int numberOfSteps = 20000;
+    const double propagationDuration = timeStep * ( static_cast< double >( numberOfSteps ) - 0.5 );
+
+    // Propagate reference solution, starting at t=0.
+    std::map< double, StateType > referenceStateHistory = propagateForcedKeplerOrbit< double >(
+                boost::make_shared< IntegratorSettings< double > >( rungeKutta4, 0.0, timeStep ),
+                propagationDuration );
+
+    // Propagate with Time and double, starting about 30 years after epoch.
+    const long double initialTime = 1.0E9L + 0.123456789L;
+    std::map< Time, StateType > timeStateHistory = propagateForcedKeplerOrbit< Time >(
+                boost::make_shared< IntegratorSettings< Time > >(
+                    rungeKutta4, Time( initialTime ), Time( timeStep ) ), propagationDuration );
+    std::map< double, StateType > doubleStateHistory = propagateForcedKeplerOrbit< double >(
+                boost::make_shared< IntegratorSettings< double > >(
+                    rungeKutta4, static_cast< double >( initialTime ), timeStep ), propagationDuration );
+
+    BOOST_CHECK_EQUAL( referenceStateHistory.size( ), static_cast< unsigned int >( numberOfSteps + 1 ) );
+    BOOST_CHECK_EQUAL( timeStateHistory.size( ), referenceStateHistory.size( ) );
+
+    // Check that Time epochs are accumulated without loss of resolution, and that states are equal to reference.
+    Time expectedTime( initialTime );
+    std::map< double, StateType >::const_iterator referenceIterator = referenceStateHistory.begin( );
+    for( std::map< Time, StateType >::const_iterator stateIterator = timeStateHistory.begin( );
+         stateIterator != timeStateHistory.end( ); stateIterator++, referenceIterator++ )
+    {
+        BOOST_CHECK( stateIterator->first == expectedTime );
+        BOOST_CHECK_SMALL( ( stateIterator->second - referenceIterator->second ).cwiseAbs( ).maxCoeff( ), 1.0E-11 );
+        expectedTime += timeStep;
+    }
+
+    double timeError = ( timeStateHistory.rbegin( )->second - referenceStateHistory.rbegin( )->second ).
+            cwiseAbs( ).maxCoeff( );
+    double doubleError = ( doubleStateHistory.rbegin( )->second - referenceStateHistory.rbegin( )->second ).
+            cwiseAbs( ).maxCoeff( );
+    BOOST_CHECK( timeError < doubleError );
+}
+
+//! Test propagation with fixed and variable step size integrators, and state history storage, using Time.
+BOOST_AUTO_TEST_CASE( testTimeTypeIntegrationAndStorage )
+{
+    const double initialTime = 1.0E9;
+    const double fixedStepDuration = 2000.0 - 0.005;
+    const double variableStepDuration = 20000.0;
+
+    // Propagate with RK4 and RKF7(8) integrators, with double and Time independent variable.
+    std::map< double, StateType > doubleRungeKutta4StateHistory = propagateForcedKeplerOrbit< double >(
+                boost::make_shared< IntegratorSettings< double > >( rungeKutta4, initialTime, 0.01 ),
+                fixedStepDuration );
+    std::map< Time, StateType > timeRungeKutta4StateHistory = propagateForcedKeplerOrbit< Time >(
+                boost::make_shared< IntegratorSettings< Time > >( rungeKutta4, Time( initialTime ), Time( 0.01 ) ),
+                fixedStepDuration );
+
+    std::map< double, StateType > doubleRungeKutta78StateHistory = propagateForcedKeplerOrbit< double >(
+                boost::make_shared< RungeKuttaVariableStepSizeSettings< double > >(
+                    rungeKuttaVariableStepSize, initialTime, 0.01, RungeKuttaCoefficients::rungeKuttaFehlberg78,
+                    1.0E-6, 1.0, 1.0E-14, 1.0E-14 ), variableStepDuration );
+    std::map< Time, StateType > timeRungeKutta78StateHistory = propagateForcedKeplerOrbit< Time >(
+                boost::make_shared< RungeKuttaVariableStepSizeSettings< Time > >(
+                    rungeKuttaVariableStepSize, Time( initialTime ), Time( 0.01 ),
+                    RungeKuttaCoefficients::rungeKuttaFehlberg78, Time( 1.0E-6 ), Time( 1.0 ), Time( 1.0E-14 ),
+                    Time( 1.0E-14 ) ), variableStepDuration );
+
+    BOOST_CHECK_EQUAL( doubleRungeKutta4StateHistory.size( ), timeRungeKutta4StateHistory.size( ) );
+    BOOST_CHECK( timeRungeKutta78StateHistory.size( ) > 0 );
+
+    // Check insertion into, and retrieval from, ordered and unordered Time-keyed containers.
+    const int numberOfEntries = 50000;
+    std::map< Time, double > orderedTimeMap;
+    boost::unordered_map< Time, double > unorderedTimeMap;
+
+    for( int i = 0; i < numberOfEntries; i++ )
+    {
+        orderedTimeMap[ Time( initialTime ) + 0.37 * static_cast< double >( i ) ] = static_cast< double >( i );
+    }
+    double orderedMapSum = 0.0;
+    for( int i = 0; i < numberOfEntries; i++ )
+    {
+        orderedMapSum += orderedTimeMap.lower_bound( Time( initialTime ) + 0.37 * static_cast< double >( i ) )->second;
+    }
+
+    for( int i = 0; i < numberOfEntries; i++ )
+    {
+        unorderedTimeMap[ Time( initialTime ) + 0.37 * static_cast< double >( i ) ] = static_cast< double >( i );
+    }
+    double unorderedMapSum = 0.0;
+    for( int i = 0; i < numberOfEntries; i++ )
+    {
+        unorderedMapSum += unorderedTimeMap.at( Time( initialTime ) + 0.37 * static_cast< double >( i ) );
+    }
+
+    BOOST_CHECK_EQUAL( orderedTimeMap.size( ), static_cast< unsigned int >( numberOfEntries ) );
+    BOOST_CHECK_EQUAL( unorderedTimeMap.size( ), static_cast< unsigned int >( numberOfEntries ) );
+    BOOST_CHECK_EQUAL( orderedMapSum, unorderedMapSum );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
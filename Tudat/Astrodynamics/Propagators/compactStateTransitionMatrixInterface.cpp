@@ -0,0 +1,79 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <boost/make_shared.hpp>
+
+#include "Tudat/Astrodynamics/Propagators/compactStateTransitionMatrixInterface.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Function to retrieve a compact state transition and sensitivity matrix interface of a given storage type.
+boost::shared_ptr< CompactStateTransitionAndSensitivityMatrixInterface >
+getOrCreateCompactStateTransitionAndSensitivityMatrixInterface(
+        boost::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface >& stateTransitionInterface,
+        const StateTransitionMatrixStorageType storageType,
+        const int numberOfInitialDynamicalParameters,
+        const int numberOfParameters )
+{
+    switch( storageType )
+    {
+    case compact_double_precision_storage:
+    {
+        if( boost::dynamic_pointer_cast< SingleArcCompactStateTransitionAndSensitivityMatrixInterface< double > >(
+                    stateTransitionInterface ) == NULL )
+        {
+            stateTransitionInterface =
+                    boost::make_shared< SingleArcCompactStateTransitionAndSensitivityMatrixInterface< double > >(
+                        numberOfInitialDynamicalParameters, numberOfParameters );
+        }
+        break;
+    }
+    case compact_single_precision_storage:
+    {
+        if( boost::dynamic_pointer_cast< SingleArcCompactStateTransitionAndSensitivityMatrixInterface< float > >(
+                    stateTransitionInterface ) == NULL )
+        {
+            stateTransitionInterface =
+                    boost::make_shared< SingleArcCompactStateTransitionAndSensitivityMatrixInterface< float > >(
+                        numberOfInitialDynamicalParameters, numberOfParameters );
+        }
+        break;
+    }
+    default:
+        throw std::runtime_error( "Error, state transition matrix storage type " +
+                                  boost::lexical_cast< std::string >( storageType ) + " is not compact" );
+    }
+
+    return boost::dynamic_pointer_cast< CompactStateTransitionAndSensitivityMatrixInterface >(
+                stateTransitionInterface );
+}
+
+//! Function to create or update a compact state transition and sensitivity matrix interface.
+void createOrUpdateCompactStateTransitionAndSensitivityMatrixInterface(
+        boost::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface >& stateTransitionInterface,
+        const std::vector< std::map< double, Eigen::MatrixXd > >& variationalEquationsSolution,
+        const StateTransitionMatrixStorageType storageType,
+        const int numberOfInitialDynamicalParameters,
+        const int numberOfParameters )
+{
+    boost::shared_ptr< CompactStateTransitionAndSensitivityMatrixInterface > compactInterface =
+            getOrCreateCompactStateTransitionAndSensitivityMatrixInterface(
+                stateTransitionInterface, storageType, numberOfInitialDynamicalParameters, numberOfParameters );
+
+    compactInterface->updateMatrixHistory( variationalEquationsSolution );
+}
+
+} // namespace propagators
+
+} // namespace tudat
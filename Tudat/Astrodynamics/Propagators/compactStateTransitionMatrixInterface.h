@@ -0,0 +1,640 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+#ifndef TUDAT_COMPACTSTATETRANSITIONMATRIXINTERFACE_H
+#define TUDAT_COMPACTSTATETRANSITIONMATRIXINTERFACE_H
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Propagators/stateTransitionMatrixInterface.h"
+
+namespace tudat
+{
+
+namespace propagators
+{
+
+//! Enum defining the manner in which the history of the state transition and sensitivity matrices is stored.
+enum StateTransitionMatrixStorageType
+{
+    //! Separate Lagrange interpolators for state transition and sensitivity matrices, using maps of dense matrices.
+    interpolated_matrix_map_storage,
+    //! Contiguous storage of non-zero columns of combined matrices (see SingleArcCompactStateTransitionAndSensitivityMatrixInterface)
+    compact_double_precision_storage,
+    //! Same as compact_double_precision_storage, but with matrix entries stored in single precision.
+    compact_single_precision_storage
+};
+
+//! Base class for state transition and sensitivity matrix interfaces that store the matrix history in compact form.
+/*!
+ *  Base class for state transition and sensitivity matrix interfaces that store the matrix history in compact form, and
+ *  that can be filled one epoch at a time (e.g. directly from the numerical integration of the variational equations),
+ *  without first creating a map of dense matrices. This base class is used to allow compact interfaces with different
+ *  storage types to be filled through the same interface.
+ */
+class CompactStateTransitionAndSensitivityMatrixInterface: public CombinedStateTransitionAndSensitivityMatrixInterface
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param numberOfInitialDynamicalParameters Size of the estimated initial state vector (and size of square
+     * state transition matrix.
+     * \param numberOfParameters Total number of estimated parameters (initial states and other parameters).
+     */
+    CompactStateTransitionAndSensitivityMatrixInterface(
+            const int numberOfInitialDynamicalParameters,
+            const int numberOfParameters ):
+        CombinedStateTransitionAndSensitivityMatrixInterface( numberOfInitialDynamicalParameters, numberOfParameters ){ }
+
+    //! Destructor.
+    virtual ~CompactStateTransitionAndSensitivityMatrixInterface( ){ }
+
+    //! Function to reset the stored state transition and sensitivity matrix history
+    /*!
+     * Function to reset the stored state transition and sensitivity matrix history, from the numerical solution of the
+     * variational equations. The determination of which columns need to be stored is redone by this function.
+     * \param variationalEquationsSolution Vector of two matrix histories. First vector entry is state transition matrix
+     * history, second entry is sensitivity matrix history.
+     */
+    void updateMatrixHistory( const std::vector< std::map< double, Eigen::MatrixXd > >& variationalEquationsSolution )
+    {
+        if( variationalEquationsSolution.size( ) != 2 )
+        {
+            throw std::runtime_error( "Error when creating compact state transition matrix history, expected 2 matrix histories, found " +
+                                      boost::lexical_cast< std::string >( variationalEquationsSolution.size( ) ) );
+        }
+
+        const std::map< double, Eigen::MatrixXd >& stateTransitionMatrixHistory = variationalEquationsSolution.at( 0 );
+        const std::map< double, Eigen::MatrixXd >& sensitivityMatrixHistory = variationalEquationsSolution.at( 1 );
+        if( stateTransitionMatrixHistory.size( ) < 4 )
+        {
+            throw std::runtime_error( "Error when creating compact state transition matrix history, at least 4 epochs are required" );
+        }
+        if( sensitivityMatrixSize_ > 0 && sensitivityMatrixHistory.size( ) != stateTransitionMatrixHistory.size( ) )
+        {
+            throw std::runtime_error( "Error when creating compact state transition matrix history, sizes of state transition and sensitivity matrix histories are inconsistent" );
+        }
+
+        // Add matrices of all epochs to storage.
+        clearMatrixHistory( );
+        std::map< double, Eigen::MatrixXd >::const_iterator sensitivityIterator = sensitivityMatrixHistory.begin( );
+        for( std::map< double, Eigen::MatrixXd >::const_iterator stateTransitionIterator =
+             stateTransitionMatrixHistory.begin( ); stateTransitionIterator != stateTransitionMatrixHistory.end( );
+             stateTransitionIterator++ )
+        {
+            if( sensitivityMatrixSize_ > 0 )
+            {
+                if( sensitivityIterator->first != stateTransitionIterator->first )
+                {
+                    throw std::runtime_error( "Error when creating compact state transition matrix history, sensitivity matrix history is inconsistent" );
+                }
+                addMatrixHistoryEpoch( stateTransitionIterator->first, stateTransitionIterator->second,
+                                       sensitivityIterator->second );
+                sensitivityIterator++;
+            }
+            else
+            {
+                addMatrixHistoryEpoch( stateTransitionIterator->first, stateTransitionIterator->second,
+                                       Eigen::MatrixXd::Zero( stateTransitionMatrixSize_, 0 ) );
+            }
+        }
+        finalizeMatrixHistory( );
+    }
+
+    //! Function to clear the stored matrix history, before adding new matrices one epoch at a time.
+    /*!
+     * Function to clear the stored matrix history, before adding new matrices one epoch at a time using
+     * addMatrixHistoryEpoch. After all epochs have been added, finalizeMatrixHistory must be called before the
+     * interface can be used.
+     */
+    virtual void clearMatrixHistory( ) = 0;
+
+    //! Function to add the state transition and sensitivity matrices at a single epoch to the stored matrix history.
+    /*!
+     * Function to add the state transition and sensitivity matrices at a single epoch to the stored matrix history. The
+     * epochs must be added in strictly ascending or strictly descending order.
+     * \param epoch Epoch at which the matrices are valid.
+     * \param stateTransitionMatrix State transition matrix at epoch.
+     * \param sensitivityMatrix Sensitivity matrix at epoch.
+     */
+    virtual void addMatrixHistoryEpoch(
+            const double epoch,
+            const Eigen::Ref< const Eigen::MatrixXd >& stateTransitionMatrix,
+            const Eigen::Ref< const Eigen::MatrixXd >& sensitivityMatrix ) = 0;
+
+    //! Function to finalize the stored matrix history, after all epochs have been added.
+    /*!
+     * Function to finalize the stored matrix history, after all epochs have been added by addMatrixHistoryEpoch. The
+     * epochs are sorted in ascending order, and all columns that are zero at each epoch are removed from the storage.
+     */
+    virtual void finalizeMatrixHistory( ) = 0;
+
+};
+
+//! Interface object for interpolation of state transition and sensitivity matrices, stored in a compact contiguous form.
+/*!
+ *  Interface object for interpolation of state transition and sensitivity matrices for single-arc estimation, which
+ *  stores the matrix history in a single contiguous block of memory, instead of a map of dense matrices. For each epoch,
+ *  only the columns of the combined (state transition and sensitivity) matrix that are non-zero at any epoch are stored.
+ *  The matrix history can be set from maps of dense matrices (updateMatrixHistory), or be filled one epoch at a time
+ *  during the numerical integration (see CompactStateTransitionAndSensitivityMatrixInterface), in which case no map of
+ *  dense matrices is created at all.
+ *
+ *  Matrices are evaluated using Lagrange interpolation with the same number of points (4, i.e. a cubic interpolant) as
+ *  the interpolators created by createStateTransitionAndSensitivityMatrixInterpolator for the map-based
+ *  SingleArcCombinedStateTransitionAndSensitivityMatrixInterface, so that the order of the interpolation is equal for
+ *  both storage types. Away from the boundaries, the results of both are identical (to within rounding errors). In the
+ *  first and last interval, the map-based interface uses a natural cubic spline, whereas this interface uses the
+ *  4-point Lagrange stencil shifted inwards, which retains the order of the interpolation up to the boundaries. The
+ *  interval is found by a hunting algorithm, initialized with the interval of the previous evaluation, so that
+ *  evaluation at (nearly) sorted times requires (nearly) no search.
+ *  \tparam StorageScalarType Scalar type in which the matrix entries are stored. Using float halves the memory use, at the
+ *  expense of a relative precision of about 1.0E-7, which is sufficient for e.g. coarse covariance analysis.
+ */
+template< typename StorageScalarType = double >
+class SingleArcCompactStateTransitionAndSensitivityMatrixInterface:
+        public CompactStateTransitionAndSensitivityMatrixInterface
+{
+public:
+
+    //! Typedef for (mapped) column of stored combined matrix.
+    typedef Eigen::Matrix< StorageScalarType, Eigen::Dynamic, 1 > StoredColumnType;
+
+    //! Constructor, creating an interface with an empty matrix history.
+    /*!
+     * Constructor, creating an interface with an empty matrix history, which is to be filled by updateMatrixHistory or by
+     * clearMatrixHistory, addMatrixHistoryEpoch and finalizeMatrixHistory.
+     * \param numberOfInitialDynamicalParameters Size of the estimated initial state vector (and size of square
+     * state transition matrix.
+     * \param numberOfParameters Total number of estimated parameters (initial states and other parameters).
+     */
+    SingleArcCompactStateTransitionAndSensitivityMatrixInterface(
+            const int numberOfInitialDynamicalParameters,
+            const int numberOfParameters ):
+        CompactStateTransitionAndSensitivityMatrixInterface( numberOfInitialDynamicalParameters, numberOfParameters ),
+        previousNearestLowerIndex_( 0 )
+    {
+        combinedStateTransitionMatrix_ = Eigen::MatrixXd::Zero(
+                    stateTransitionMatrixSize_, stateTransitionMatrixSize_ + sensitivityMatrixSize_ );
+        clearMatrixHistory( );
+    }
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param variationalEquationsSolution Vector of two matrix histories. First vector entry is state transition matrix
+     * history, second entry is sensitivity matrix history.
+     * \param numberOfInitialDynamicalParameters Size of the estimated initial state vector (and size of square
+     * state transition matrix.
+     * \param numberOfParameters Total number of estimated parameters (initial states and other parameters).
+     */
+    SingleArcCompactStateTransitionAndSensitivityMatrixInterface(
+            const std::vector< std::map< double, Eigen::MatrixXd > >& variationalEquationsSolution,
+            const int numberOfInitialDynamicalParameters,
+            const int numberOfParameters ):
+        CompactStateTransitionAndSensitivityMatrixInterface( numberOfInitialDynamicalParameters, numberOfParameters ),
+        previousNearestLowerIndex_( 0 )
+    {
+        combinedStateTransitionMatrix_ = Eigen::MatrixXd::Zero(
+                    stateTransitionMatrixSize_, stateTransitionMatrixSize_ + sensitivityMatrixSize_ );
+        updateMatrixHistory( variationalEquationsSolution );
+    }
+
+    //! Destructor.
+    ~SingleArcCompactStateTransitionAndSensitivityMatrixInterface( ){ }
+
+    //! Function to clear the stored matrix history, before adding new matrices one epoch at a time.
+    /*!
+     * Function to clear the stored matrix history, before adding new matrices one epoch at a time using
+     * addMatrixHistoryEpoch. Until finalizeMatrixHistory is called, all columns of the combined matrix are stored.
+     */
+    void clearMatrixHistory( )
+    {
+        int numberOfColumns = stateTransitionMatrixSize_ + sensitivityMatrixSize_;
+        storedColumnIndices_.resize( numberOfColumns );
+        for( int i = 0; i < numberOfColumns; i++ )
+        {
+            storedColumnIndices_[ i ] = i;
+        }
+        storedBlockSize_ = stateTransitionMatrixSize_ * numberOfColumns;
+
+        epochs_.clear( );
+        matrixHistory_.clear( );
+        previousNearestLowerIndex_ = 0;
+        isMatrixHistoryFinalized_ = false;
+    }
+
+    //! Function to add the state transition and sensitivity matrices at a single epoch to the stored matrix history.
+    /*!
+     * Function to add the state transition and sensitivity matrices at a single epoch to the stored matrix history,
+     * converted to the storage scalar type. The epochs must be added in strictly ascending or strictly descending order.
+     * \param epoch Epoch at which the matrices are valid.
+     * \param stateTransitionMatrix State transition matrix at epoch.
+     * \param sensitivityMatrix Sensitivity matrix at epoch.
+     */
+    void addMatrixHistoryEpoch(
+            const double epoch,
+            const Eigen::Ref< const Eigen::MatrixXd >& stateTransitionMatrix,
+            const Eigen::Ref< const Eigen::MatrixXd >& sensitivityMatrix )
+    {
+        if( stateTransitionMatrix.rows( ) != stateTransitionMatrixSize_ ||
+                stateTransitionMatrix.cols( ) != stateTransitionMatrixSize_ )
+        {
+            throw std::runtime_error( "Error when creating compact state transition matrix history, state transition matrix size is inconsistent" );
+        }
+        if( sensitivityMatrixSize_ > 0 && ( sensitivityMatrix.rows( ) != stateTransitionMatrixSize_ ||
+                                            sensitivityMatrix.cols( ) != sensitivityMatrixSize_ ) )
+        {
+            throw std::runtime_error( "Error when creating compact state transition matrix history, sensitivity matrix history is inconsistent" );
+        }
+        if( isMatrixHistoryFinalized_ )
+        {
+            throw std::runtime_error( "Error when adding epoch to compact state transition matrix history, history has already been finalized" );
+        }
+
+        // Check that epochs are added in monotonic order.
+        int numberOfEpochs = epochs_.size( );
+        if( numberOfEpochs > 0 && ( epoch == epochs_.back( ) || ( numberOfEpochs > 1 &&
+                ( epoch > epochs_.back( ) ) != ( epochs_.back( ) > epochs_.front( ) ) ) ) )
+        {
+            throw std::runtime_error( "Error when adding epoch to compact state transition matrix history, epochs must be strictly monotonic" );
+        }
+
+        // Copy all columns to end of contiguous storage.
+        epochs_.push_back( epoch );
+        matrixHistory_.resize( matrixHistory_.size( ) + storedBlockSize_ );
+        StorageScalarType* epochData = &matrixHistory_[ numberOfEpochs * storedBlockSize_ ];
+        Eigen::Map< Eigen::Matrix< StorageScalarType, Eigen::Dynamic, Eigen::Dynamic > >(
+                    epochData, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ) =
+                stateTransitionMatrix.template cast< StorageScalarType >( );
+        if( sensitivityMatrixSize_ > 0 )
+        {
+            Eigen::Map< Eigen::Matrix< StorageScalarType, Eigen::Dynamic, Eigen::Dynamic > >(
+                        epochData + stateTransitionMatrixSize_ * stateTransitionMatrixSize_,
+                        stateTransitionMatrixSize_, sensitivityMatrixSize_ ) =
+                    sensitivityMatrix.template cast< StorageScalarType >( );
+        }
+    }
+
+    //! Function to finalize the stored matrix history, after all epochs have been added.
+    /*!
+     * Function to finalize the stored matrix history, after all epochs have been added by addMatrixHistoryEpoch. The
+     * epochs are sorted in ascending order, and the columns of the combined matrix that are zero at all epochs are
+     * removed from the (in-place compacted) storage.
+     */
+    void finalizeMatrixHistory( )
+    {
+        int numberOfEpochs = epochs_.size( );
+        if( numberOfEpochs < 4 )
+        {
+            throw std::runtime_error( "Error when creating compact state transition matrix history, at least 4 epochs are required" );
+        }
+
+        // Reverse order of epochs if added in descending order (e.g. backwards propagation).
+        if( epochs_.front( ) > epochs_.back( ) )
+        {
+            std::reverse( epochs_.begin( ), epochs_.end( ) );
+            for( int i = 0; i < numberOfEpochs / 2; i++ )
+            {
+                std::swap_ranges( matrixHistory_.begin( ) + i * storedBlockSize_,
+                                  matrixHistory_.begin( ) + ( i + 1 ) * storedBlockSize_,
+                                  matrixHistory_.begin( ) + ( numberOfEpochs - 1 - i ) * storedBlockSize_ );
+            }
+        }
+
+        // Determine which of the stored columns are non-zero at any epoch.
+        std::vector< int > nonZeroColumns;
+        for( unsigned int i = 0; i < storedColumnIndices_.size( ); i++ )
+        {
+            bool isColumnNonZero = false;
+            for( int j = 0; ( j < numberOfEpochs ) && !isColumnNonZero; j++ )
+            {
+                isColumnNonZero = ( Eigen::Map< const StoredColumnType >(
+                                        &matrixHistory_[ j * storedBlockSize_ + i * stateTransitionMatrixSize_ ],
+                                    stateTransitionMatrixSize_ ).array( ) != 0.0 ).any( );
+            }
+            if( isColumnNonZero )
+            {
+                nonZeroColumns.push_back( i );
+            }
+        }
+
+        // Remove zero columns from storage (in place: data is only moved towards the start of the storage).
+        int compactedBlockSize = stateTransitionMatrixSize_ * nonZeroColumns.size( );
+        std::vector< int > compactedColumnIndices;
+        for( unsigned int i = 0; i < nonZeroColumns.size( ); i++ )
+        {
+            compactedColumnIndices.push_back( storedColumnIndices_[ nonZeroColumns[ i ] ] );
+        }
+        if( compactedBlockSize != storedBlockSize_ )
+        {
+            for( int j = 0; j < numberOfEpochs; j++ )
+            {
+                for( unsigned int i = 0; i < nonZeroColumns.size( ); i++ )
+                {
+                    typename std::vector< StorageScalarType >::iterator columnStart =
+                            matrixHistory_.begin( ) + j * storedBlockSize_ + nonZeroColumns[ i ] * stateTransitionMatrixSize_;
+                    typename std::vector< StorageScalarType >::iterator compactedColumnStart =
+                            matrixHistory_.begin( ) + j * compactedBlockSize + i * stateTransitionMatrixSize_;
+                    if( compactedColumnStart != columnStart )
+                    {
+                        std::copy( columnStart, columnStart + stateTransitionMatrixSize_, compactedColumnStart );
+                    }
+                }
+            }
+            matrixHistory_.resize( numberOfEpochs * compactedBlockSize );
+        }
+        matrixHistory_.shrink_to_fit( );
+        epochs_.shrink_to_fit( );
+
+        storedColumnIndices_ = compactedColumnIndices;
+        storedBlockSize_ = compactedBlockSize;
+        previousNearestLowerIndex_ = 0;
+        isMatrixHistoryFinalized_ = true;
+    }
+
+    //! Function to get the concatenated state transition and sensitivity matrix at a given time.
+    /*!
+     *  Function to get the concatenated state transition and sensitivity matrix at a given time.
+     *  \param evaluationTime Time at which to evaluate matrix interpolators
+     *  \return Concatenated state transition and sensitivity matrices.
+     */
+    Eigen::MatrixXd getCombinedStateTransitionAndSensitivityMatrix( const double evaluationTime )
+    {
+        interpolateCombinedMatrix( evaluationTime, previousNearestLowerIndex_, combinedStateTransitionMatrix_ );
+        return combinedStateTransitionMatrix_;
+    }
+
+    //! Function to get the concatenated state transition and sensitivity matrix at a given time.
+    /*!
+     *  Function to get the concatenated state transition and sensitivity matrix at a given time
+     *  (functionality equal to getCombinedStateTransitionAndSensitivityMatrix for single-arc case).
+     *  \param evaluationTime Time at which to evaluate matrix interpolators
+     *  \return Concatenated state transition and sensitivity matrices.
+     */
+    Eigen::MatrixXd getFullCombinedStateTransitionAndSensitivityMatrix( const double evaluationTime )
+    {
+        return getCombinedStateTransitionAndSensitivityMatrix( evaluationTime );
+    }
+
+    //! Function to get the concatenated state transition and sensitivity matrices at a list of times.
+    /*!
+     *  Function to get the concatenated state transition and sensitivity matrices at a list of times. Matrices already
+     *  present in the output vector are reused (no reallocation takes place if they have the correct size). The search
+     *  index is local to this function call, so that this function does not modify the object, and may be called
+     *  concurrently from different threads.
+     *  \param evaluationTimes Times at which to evaluate matrices, preferably sorted in ascending order.
+     *  \param combinedStateTransitionMatrices Concatenated state transition and sensitivity matrices at evaluationTimes
+     *  (returned by reference).
+     */
+    void getCombinedStateTransitionAndSensitivityMatrices(
+            const std::vector< double >& evaluationTimes,
+            std::vector< Eigen::MatrixXd >& combinedStateTransitionMatrices )
+    {
+        combinedStateTransitionMatrices.resize( evaluationTimes.size( ) );
+
+        int nearestLowerIndex = 0;
+        for( unsigned int i = 0; i < evaluationTimes.size( ); i++ )
+        {
+            interpolateCombinedMatrix( evaluationTimes[ i ], nearestLowerIndex, combinedStateTransitionMatrices[ i ] );
+        }
+    }
+
+    //! Function to get the size of the total parameter vector.
+    /*!
+     * Function to get the size of the total parameter vector. For single-arc, this is simply the combination of
+     * the size of the state transition and sensitivity matrices.
+     * \return Size of the total parameter vector.
+     */
+    int getFullParameterVectorSize( )
+    {
+        return sensitivityMatrixSize_ + stateTransitionMatrixSize_;
+    }
+
+    //! Function to get the epochs at which the matrices are stored.
+    /*!
+     * Function to get the epochs at which the matrices are stored.
+     * \return Epochs at which the matrices are stored.
+     */
+    const std::vector< double >& getStoredEpochs( )
+    {
+        return epochs_;
+    }
+
+    //! Function to get the indices of the columns of the combined matrix that are stored.
+    /*!
+     * Function to get the indices of the columns of the combined matrix that are stored (all other columns are zero).
+     * \return Indices of the columns of the combined matrix that are stored.
+     */
+    const std::vector< int >& getStoredColumnIndices( )
+    {
+        return storedColumnIndices_;
+    }
+
+    //! Function to get the number of matrix entries that are stored.
+    /*!
+     * Function to get the number of matrix entries that are stored (for all epochs combined).
+     * \return Number of matrix entries that are stored.
+     */
+    int getNumberOfStoredEntries( )
+    {
+        return matrixHistory_.size( );
+    }
+
+private:
+
+    //! Function to update the index of the nearest lower epoch, using a hunting algorithm.
+    /*!
+     * Function to update the index of the nearest lower epoch, using a hunting algorithm: the search interval is
+     * expanded from the current index, after which a binary search is performed in the resulting interval. For times
+     * outside of the stored interval, the index of the first/last interval is returned.
+     * \param evaluationTime Time for which the nearest lower epoch is to be found.
+     * \param nearestLowerIndex Initial guess of index of nearest lower epoch; updated value returned by reference.
+     */
+    void updateNearestLowerIndex( const double evaluationTime, int& nearestLowerIndex ) const
+    {
+        int numberOfEpochs = epochs_.size( );
+        if( nearestLowerIndex < 0 || nearestLowerIndex > numberOfEpochs - 2 )
+        {
+            nearestLowerIndex = 0;
+        }
+
+        // Check if current interval is correct (most common case for sorted evaluation times).
+        if( evaluationTime >= epochs_[ nearestLowerIndex ] && evaluationTime < epochs_[ nearestLowerIndex + 1 ] )
+        {
+            return;
+        }
+
+        // Expand search interval, with increasing step size.
+        int lowerBound, upperBound;
+        int stepSize = 1;
+        if( evaluationTime >= epochs_[ nearestLowerIndex ] )
+        {
+            lowerBound = nearestLowerIndex;
+            upperBound = std::min( lowerBound + stepSize, numberOfEpochs );
+            while( upperBound < numberOfEpochs && evaluationTime >= epochs_[ upperBound ] )
+            {
+                lowerBound = upperBound;
+                stepSize *= 2;
+                upperBound = std::min( lowerBound + stepSize, numberOfEpochs );
+            }
+        }
+        else
+        {
+            upperBound = nearestLowerIndex;
+            lowerBound = std::max( upperBound - stepSize, 0 );
+            while( lowerBound > 0 && evaluationTime < epochs_[ lowerBound ] )
+            {
+                upperBound = lowerBound;
+                stepSize *= 2;
+                lowerBound = std::max( upperBound - stepSize, 0 );
+            }
+        }
+
+        nearestLowerIndex = static_cast< int >(
+                    std::upper_bound( epochs_.begin( ) + lowerBound, epochs_.begin( ) + upperBound, evaluationTime ) -
+                    epochs_.begin( ) ) - 1;
+        nearestLowerIndex = std::min( std::max( nearestLowerIndex, 0 ), numberOfEpochs - 2 );
+    }
+
+    //! Function to interpolate the combined state transition and sensitivity matrix.
+    /*!
+     * Function to interpolate the combined state transition and sensitivity matrix, writing the result into an
+     * existing matrix (which is only resized if it does not yet have the correct size).
+     * \param evaluationTime Time at which the matrix is to be computed.
+     * \param nearestLowerIndex Initial guess of index of nearest lower epoch; updated value returned by reference.
+     * \param combinedMatrix Concatenated state transition and sensitivity matrices (returned by reference).
+     */
+    void interpolateCombinedMatrix( const double evaluationTime, int& nearestLowerIndex,
+                                    Eigen::MatrixXd& combinedMatrix ) const
+    {
+        if( !isMatrixHistoryFinalized_ )
+        {
+            throw std::runtime_error( "Error when interpolating compact state transition matrix history, history has not been finalized" );
+        }
+        updateNearestLowerIndex( evaluationTime, nearestLowerIndex );
+
+        // Compute Lagrange weights for 4-point stencil around current interval.
+        int numberOfEpochs = epochs_.size( );
+        int firstStencilIndex = std::min( std::max( nearestLowerIndex - 1, 0 ), numberOfEpochs - 4 );
+        double weights[ 4 ];
+        for( int i = 0; i < 4; i++ )
+        {
+            weights[ i ] = 1.0;
+            for( int j = 0; j < 4; j++ )
+            {
+                if( i != j )
+                {
+                    weights[ i ] *= ( evaluationTime - epochs_[ firstStencilIndex + j ] ) /
+                            ( epochs_[ firstStencilIndex + i ] - epochs_[ firstStencilIndex + j ] );
+                }
+            }
+        }
+
+        int numberOfColumns = stateTransitionMatrixSize_ + sensitivityMatrixSize_;
+        if( combinedMatrix.rows( ) != stateTransitionMatrixSize_ || combinedMatrix.cols( ) != numberOfColumns )
+        {
+            combinedMatrix.resize( stateTransitionMatrixSize_, numberOfColumns );
+        }
+        if( static_cast< int >( storedColumnIndices_.size( ) ) != numberOfColumns )
+        {
+            combinedMatrix.setZero( );
+        }
+
+        // Interpolate stored columns.
+        const StorageScalarType* firstStencilData = &matrixHistory_[ firstStencilIndex * storedBlockSize_ ];
+        for( unsigned int i = 0; i < storedColumnIndices_.size( ); i++ )
+        {
+            const StorageScalarType* columnData = firstStencilData + i * stateTransitionMatrixSize_;
+            combinedMatrix.col( storedColumnIndices_[ i ] ) =
+                    weights[ 0 ] * Eigen::Map< const StoredColumnType >(
+                        columnData, stateTransitionMatrixSize_ ).template cast< double >( ) +
+                    weights[ 1 ] * Eigen::Map< const StoredColumnType >(
+                        columnData + storedBlockSize_, stateTransitionMatrixSize_ ).template cast< double >( ) +
+                    weights[ 2 ] * Eigen::Map< const StoredColumnType >(
+                        columnData + 2 * storedBlockSize_, stateTransitionMatrixSize_ ).template cast< double >( ) +
+                    weights[ 3 ] * Eigen::Map< const StoredColumnType >(
+                        columnData + 3 * storedBlockSize_, stateTransitionMatrixSize_ ).template cast< double >( );
+        }
+    }
+
+    //! Predefined matrix to use as return value when calling getCombinedStateTransitionAndSensitivityMatrix.
+    Eigen::MatrixXd combinedStateTransitionMatrix_;
+
+    //! Epochs at which the matrices are stored, sorted in ascending order.
+    std::vector< double > epochs_;
+
+    //! Stored non-zero columns of combined matrices, for all epochs (epoch-major, column-major per epoch).
+    std::vector< StorageScalarType > matrixHistory_;
+
+    //! Indices of columns of combined matrix that are stored in matrixHistory_.
+    std::vector< int > storedColumnIndices_;
+
+    //! Number of entries in matrixHistory_ per epoch.
+    int storedBlockSize_;
+
+    //! Index of nearest lower epoch at previous call of getCombinedStateTransitionAndSensitivityMatrix.
+    int previousNearestLowerIndex_;
+
+    //! Boolean denoting whether the matrix history is finalized (i.e. no epochs are being added).
+    bool isMatrixHistoryFinalized_;
+};
+
+//! Function to retrieve a compact state transition and sensitivity matrix interface of a given storage type.
+/*!
+ * Function to retrieve a compact state transition and sensitivity matrix interface of a given storage type: the input
+ * interface is returned if it is of the requested type, otherwise a new interface, with an empty matrix history, is
+ * created and assigned to the input interface.
+ * \param stateTransitionInterface Interface that is to be retrieved or created (returned by reference).
+ * \param storageType Type of compact storage that is to be used.
+ * \param numberOfInitialDynamicalParameters Size of the estimated initial state vector (and size of square
+ * state transition matrix.
+ * \param numberOfParameters Total number of estimated parameters (initial states and other parameters).
+ * \return Compact state transition and sensitivity matrix interface of requested storage type.
+ */
+boost::shared_ptr< CompactStateTransitionAndSensitivityMatrixInterface >
+getOrCreateCompactStateTransitionAndSensitivityMatrixInterface(
+        boost::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface >& stateTransitionInterface,
+        const StateTransitionMatrixStorageType storageType,
+        const int numberOfInitialDynamicalParameters,
+        const int numberOfParameters );
+
+//! Function to create or update a compact state transition and sensitivity matrix interface.
+/*!
+ * Function to create (if the input interface is NULL) or update a compact state transition and sensitivity matrix
+ * interface from the numerical solution of the variational equations.
+ * \param stateTransitionInterface Interface that is to be created or updated (returned by reference).
+ * \param variationalEquationsSolution Vector of two matrix histories. First vector entry is state transition matrix
+ * history, second entry is sensitivity matrix history.
+ * \param storageType Type of compact storage that is to be used.
+ * \param numberOfInitialDynamicalParameters Size of the estimated initial state vector (and size of square
+ * state transition matrix.
+ * \param numberOfParameters Total number of estimated parameters (initial states and other parameters).
+ */
+void createOrUpdateCompactStateTransitionAndSensitivityMatrixInterface(
+        boost::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface >& stateTransitionInterface,
+        const std::vector< std::map< double, Eigen::MatrixXd > >& variationalEquationsSolution,
+        const StateTransitionMatrixStorageType storageType,
+        const int numberOfInitialDynamicalParameters,
+        const int numberOfParameters );
+
+} // namespace propagators
+
+} // namespace tudat
+
+#endif // TUDAT_COMPACTSTATETRANSITIONMATRIXINTERFACE_H
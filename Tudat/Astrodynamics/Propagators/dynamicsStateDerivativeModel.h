@@ -115,6 +115,11 @@ public:
             currentStatesPerTypeInConventionalRepresentation_[ stateDerivativeModels.at( i )->getIntegratedStateType( )  ] =
                     Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >::Zero(
                         stateTypeSize_.at( stateDerivativeModels.at( i )->getIntegratedStateType( )  ), 1 );
+
+            // Allocate buffer for the state of current model.
+            currentStateSegments_[ stateDerivativeModels.at( i )->getIntegratedStateType( ) ].push_back(
+                        Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >::Zero(
+                            stateDerivativeModels.at( i )->getStateSize( ) ) );
         }
     }
 
@@ -125,17 +130,34 @@ public:
      *  setPropagationSettings function.  Dimensions of state must be consistent with these
      *  settings. Depending on the settings, this function may calculate the dynamical equations
      *  and/or variational equations for a subset of the dynamical equation types that are set in
-     *  the stateDerivativeModels_ map.     
+     *  the stateDerivativeModels_ map.
      *  \param time Current time.
      *  \param state Current complete state.
      *  \return Calculated state derivative.
      */
     StateType computeStateDerivative( const TimeType time, const StateType& state )
+    {
+        computeStateDerivative( time, state, stateDerivative_ );
+        return stateDerivative_;
+    }
+
+    //! Function to calculate the system state derivative, and set it in an existing matrix
+    /*!
+     *  Function to calculate the system state derivative, and set it in an existing matrix (see computeStateDerivative
+     *  function returning the state derivative). The state of each of the state derivative models is passed through a
+     *  buffer that is allocated upon construction, so that no memory is allocated by this function in steady-state if
+     *  the size of stateDerivative is consistent with that of state.
+     *  \param time Current time.
+     *  \param state Current complete state.
+     *  \param stateDerivative Calculated state derivative (returned by reference, resized if its size is not consistent
+     *  with that of state).
+     */
+    void computeStateDerivative( const TimeType time, const StateType& state, StateType& stateDerivative )
     {
         // Initialize state derivative
-        if( stateDerivative_.rows( ) != state.rows( ) || stateDerivative_.cols( ) != state.cols( )  )
+        if( stateDerivative.rows( ) != state.rows( ) || stateDerivative.cols( ) != state.cols( )  )
         {
-            stateDerivative_.resize( state.rows( ), state.cols( ) );
+            stateDerivative.resize( state.rows( ), state.cols( ) );
         }
 
         // If dynamical equations are integrated, update the environment with the current state.
@@ -197,9 +219,14 @@ public:
                     // Evaluate and set current dynamical state derivative
                     currentIndices = stateIndices_.at( stateDerivativeModelsIterator_->first ).at( i );
 
+                    Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& currentStateSegment =
+                            currentStateSegments_.at( stateDerivativeModelsIterator_->first ).at( i );
+                    currentStateSegment = state.block(
+                                currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 );
+
                     stateDerivativeModelsIterator_->second.at( i )->calculateSystemStateDerivative(
-                                time, state.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ),
-                                stateDerivative_.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ) );
+                                time, currentStateSegment,
+                                stateDerivative.block( currentIndices.first, dynamicsStartColumn_, currentIndices.second, 1 ) );
 
                 }
             }
@@ -213,10 +240,8 @@ public:
 
             variationalEquations_->evaluateVariationalEquations< StateScalarType >(
                         time, state.block( 0, 0, totalStateSize_, variationalEquations_->getNumberOfParameterValues( ) ),
-                        stateDerivative_.block( 0, 0, totalStateSize_, variationalEquations_->getNumberOfParameterValues( ) )  );
+                        stateDerivative.block( 0, 0, totalStateSize_, variationalEquations_->getNumberOfParameterValues( ) )  );
         }
-
-        return stateDerivative_;
     }
 
     //! Function to calculate the system state derivative with double precision, regardless of template arguments
@@ -485,8 +510,11 @@ private:
                 currentIndices = stateIndices_.at( stateDerivativeModelsIterator_->first ).at( i );
 
                 // Set current block in split state (in global form)
+                Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& currentStateSegment =
+                        currentStateSegments_.at( stateDerivativeModelsIterator_->first ).at( i );
+                currentStateSegment = state.block( currentIndices.first, startColumn, currentIndices.second, 1 );
                 stateDerivativeModelsIterator_->second.at( i )->convertCurrentStateToGlobalRepresentation(
-                            state.block( currentIndices.first, startColumn, currentIndices.second, 1 ), time,
+                            currentStateSegment, time,
                             currentStatesPerTypeInConventionalRepresentation_.at(
                                 stateDerivativeModelsIterator_->first ).block(
                                 currentStateTypeSize, 0, currentIndices.second, 1 ) );
@@ -546,6 +574,11 @@ private:
     //! convertCurrentStateToGlobalRepresentationPerType
     std::unordered_map< IntegratedStateType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >
             currentStatesPerTypeInConventionalRepresentation_;
+
+    //! Buffers for the current state of each state derivative model (in propagator-specific form), in the same order as
+    //! stateDerivativeModels_, used to pass the state to the models without allocating memory for each evaluation.
+    std::unordered_map< IntegratedStateType, std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
+            currentStateSegments_;
 };
 
 //! Function to retrieve a single given acceleration model from a list of models
@@ -47,6 +47,9 @@ namespace propagators
  *  \param saveFrequency Frequency at which to save the numerical integrated states (in units of i.e. per n integration time
  *  steps, with n = saveFrequency).
  *  \param printInterval Frequency with which to print progress to console (nan = never).
+ *  \param saveSolutionFunction Function to which each state that is to be saved is passed (with the current time),
+ *  instead of storing it in solutionHistory (which is then left empty). If empty (default), the states are stored in
+ *  solutionHistory.
  *  \return Event that triggered the termination of the propagation
  */
 template< typename StateType = Eigen::MatrixXd, typename TimeType = double, typename TimeStepType = TimeType  >
@@ -59,7 +62,9 @@ PropagationTerminationReason integrateEquationsFromIntegrator(
         const boost::function< Eigen::VectorXd( ) > dependentVariableFunction =
         boost::function< Eigen::VectorXd( ) >( ),
         const int saveFrequency = TUDAT_NAN,
-        const TimeType printInterval = TUDAT_NAN )
+        const TimeType printInterval = TUDAT_NAN,
+        const boost::function< void( const TimeType, const StateType& ) > saveSolutionFunction =
+        boost::function< void( const TimeType, const StateType& ) >( ) )
 {
     PropagationTerminationReason propagationTerminationReason;
 
@@ -70,7 +75,14 @@ PropagationTerminationReason integrateEquationsFromIntegrator(
 
     // Initialization of numerical solutions for variational equations
     solutionHistory.clear( );
-    solutionHistory[ currentTime ] = newState;
+    if( saveSolutionFunction.empty( ) )
+    {
+        solutionHistory[ currentTime ] = newState;
+    }
+    else
+    {
+        saveSolutionFunction( currentTime, newState );
+    }
     dependentVariableHistory.clear( );
 
 
@@ -105,7 +117,14 @@ PropagationTerminationReason integrateEquationsFromIntegrator(
             saveIndex = saveIndex % saveFrequency;
             if( saveIndex == 0 )
             {
-                solutionHistory[ currentTime ] = newState;
+                if( saveSolutionFunction.empty( ) )
+                {
+                    solutionHistory[ currentTime ] = newState;
+                }
+                else
+                {
+                    saveSolutionFunction( currentTime, newState );
+                }
 
                 if( !dependentVariableFunction.empty( ) )
                 {
@@ -176,6 +195,8 @@ public:
      *  \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
      *  derivative model).
      *  \param printInterval Frequency with which to print progress to console (nan = never).
+     *  \param saveSolutionFunction Function to which each state that is to be saved is passed, instead of storing it in
+     *  solutionHistory (see integrateEquationsFromIntegrator).
      *  \return Event that triggered the termination of the propagation
      */
     static PropagationTerminationReason integrateEquations(
@@ -187,7 +208,9 @@ public:
             std::map< TimeType, Eigen::VectorXd >& dependentVariableHistory,
             const boost::function< Eigen::VectorXd( ) > dependentVariableFunction =
             boost::function< Eigen::VectorXd( ) >( ),
-            const TimeType printInterval = TUDAT_NAN );
+            const TimeType printInterval = TUDAT_NAN,
+            const boost::function< void( const TimeType, const StateType& ) > saveSolutionFunction =
+            boost::function< void( const TimeType, const StateType& ) >( ) );
 };
 
 //! Interface class for integrating some state derivative function.
@@ -210,6 +233,8 @@ public:
      *  \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
      *  derivative model).
      *  \param printInterval Frequency with which to print progress to console (nan = never).
+     *  \param saveSolutionFunction Function to which each state that is to be saved is passed, instead of storing it in
+     *  solutionHistory (see integrateEquationsFromIntegrator).
      *  \return Event that triggered the termination of the propagation
      */
     static PropagationTerminationReason integrateEquations(
@@ -221,7 +246,9 @@ public:
             std::map< double, Eigen::VectorXd >& dependentVariableHistory,
             const boost::function< Eigen::VectorXd( ) > dependentVariableFunction =
             boost::function< Eigen::VectorXd( ) >( ),
-            const double printInterval = TUDAT_NAN )
+            const double printInterval = TUDAT_NAN,
+            const boost::function< void( const double, const StateType& ) > saveSolutionFunction =
+            boost::function< void( const double, const StateType& ) >( ) )
     {
         // Create numerical integrator.
         boost::shared_ptr< numerical_integrators::NumericalIntegrator< double, StateType, StateType > > integrator =
@@ -232,11 +259,15 @@ public:
                     integrator, integratorSettings->initialTimeStep_, stopPropagationFunction, solutionHistory,
                     dependentVariableHistory,
                     dependentVariableFunction,
-                    integratorSettings->saveFrequency_, printInterval );
+                    integratorSettings->saveFrequency_, printInterval, saveSolutionFunction );
     }
 };
 
 //! Interface class for integrating some state derivative function.
+/*!
+ *  Interface class for integrating some state derivative function, with Time as independent variable. The time step is
+ *  represented as a long double.
+ */
 template< typename StateType >
 class EquationIntegrationInterface< StateType, Time >
 {
@@ -256,6 +287,8 @@ public:
      *  \param dependentVariableFunction Function returning dependent variables (obtained from environment and state
      *  derivative model).
      *  \param printInterval Frequency with which to print progress to console (nan = never).
+     *  \param saveSolutionFunction Function to which each state that is to be saved is passed, instead of storing it in
+     *  solutionHistory (see integrateEquationsFromIntegrator).
      *  \return Event that triggered the termination of the propagation
      */
     static PropagationTerminationReason integrateEquations(
@@ -267,7 +300,9 @@ public:
             std::map< Time, Eigen::VectorXd >& dependentVariableHistory,
             const boost::function< Eigen::VectorXd( ) > dependentVariableFunction =
             boost::function< Eigen::VectorXd( ) >( ),
-            const Time printInterval = TUDAT_NAN )
+            const Time printInterval = TUDAT_NAN,
+            const boost::function< void( const Time, const StateType& ) > saveSolutionFunction =
+            boost::function< void( const Time, const StateType& ) >( ) )
     {
         // Create numerical integrator.
         boost::shared_ptr< numerical_integrators::NumericalIntegrator< Time, StateType, StateType, long double > > integrator =
@@ -278,7 +313,7 @@ public:
                     integrator, integratorSettings->initialTimeStep_, stopPropagationFunction, solutionHistory,
                     dependentVariableHistory,
                     dependentVariableFunction,
-                    integratorSettings->saveFrequency_, printInterval );
+                    integratorSettings->saveFrequency_, printInterval, saveSolutionFunction );
     }
 };
 
@@ -16,9 +16,11 @@
 #include <string>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/function.hpp>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Basics/parallelization.h"
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModelTypes.h"
 #include "Tudat/Astrodynamics/Propagators/centralBodyData.h"
@@ -52,6 +54,16 @@ std::vector< std::string > determineEphemerisUpdateorder( std::vector< std::stri
                                                           std::vector< std::string > centralBodies,
                                                           std::vector< std::string > ephemerisOrigins );
 
+//! Default minimum number of propagated bodies for which NBodyStateDerivative distributes the accelerations over threads.
+/*!
+ * Default minimum number of propagated bodies for which NBodyStateDerivative distributes the evaluation of the
+ * accelerations over threads (see NBodyStateDerivative::setNumberOfThreads). Handing the bodies to the threads (and
+ * waiting for them) costs about 5 microseconds per state derivative evaluation, while updating a low-degree spherical
+ * harmonic and a point-mass acceleration costs about 1 microsecond per body, so that distributing fewer bodies (break-even
+ * at about 11 bodies for 2 threads) is slower than serial evaluation.
+ */
+const unsigned int defaultMinimumNumberOfParallelBodies = 16;
+
 //! State derivative for the translational dynamics of N bodies
 /*!
  * This class calculates the trabnslational state derivative of any
@@ -94,7 +106,9 @@ public:
         accelerationModelsPerBody_( accelerationModelsPerBody ),
         centralBodyData_( centralBodyData ),
         propagatorType_( propagatorType ),
-        bodiesToBeIntegratedNumerically_( bodiesToIntegrate )
+        bodiesToBeIntegratedNumerically_( bodiesToIntegrate ),
+        numberOfThreads_( 1 ),
+        minimumNumberOfParallelBodies_( defaultMinimumNumberOfParallelBodies )
     {
         // Add empty acceleration map if body is to be propagated with no accelerations.
         for( unsigned int i = 0; i < bodiesToBeIntegratedNumerically_.size( ); i++ )
@@ -164,10 +178,83 @@ public:
      */
     void updateStateDerivativeModel( const TimeType currentTime )
     {
-        for( unsigned int i = 0; i < accelerationModelList_.size( ); i++ )
+        if( threadPool_ == NULL )
         {
-            accelerationModelList_.at( i )->updateMembers( currentTime );
+            for( unsigned int i = 0; i < accelerationModelList_.size( ); i++ )
+            {
+                accelerationModelList_.at( i )->updateMembers( currentTime );
+            }
         }
+        else
+        {
+            // Update and sum accelerations per propagated body, distributing the bodies over the threads.
+            threadPool_->executeParallelLoop(
+                        accelerationModelsPerPropagatedBody_.size( ),
+                        [ this, currentTime ]( const unsigned int i )
+            {
+                totalAccelerationsPerPropagatedBody_[ i ].setZero( );
+                for( unsigned int j = 0; j < accelerationModelsPerPropagatedBody_[ i ].size( ); j++ )
+                {
+                    accelerationModelsPerPropagatedBody_[ i ][ j ]->updateMembers( currentTime );
+                    totalAccelerationsPerPropagatedBody_[ i ] +=
+                            accelerationModelsPerPropagatedBody_[ i ][ j ]->getAcceleration( ).
+                            template cast< StateScalarType >( );
+                }
+            } );
+        }
+    }
+
+    //! Function to set the number of threads over which the acceleration evaluations are distributed.
+    /*!
+     * Function to set the number of threads over which the acceleration evaluations are distributed (default 1).
+     * For more than one thread, the accelerations acting on each propagated body are updated and summed on a single
+     * thread (in the same order as for serial evaluation), with the propagated bodies distributed over the threads, so
+     * that the state derivative is independent of the number of threads. This requires that the acceleration models
+     * acting on different bodies do not modify any shared objects when they are updated, and that the environment is
+     * updated before the state derivative model (as is done by the DynamicsStateDerivativeModel).
+     * The threads are created by this function, and kept alive for the lifetime of this object (or until this function is
+     * called again). Since handing the bodies to the threads (and waiting for them to finish) has a fixed cost per state
+     * derivative evaluation, the evaluation is only distributed if the number of propagated bodies is at least
+     * minimumNumberOfParallelBodies; for fewer bodies, the serial evaluation is used and no threads are created.
+     * \param numberOfThreads Number of threads over which the acceleration evaluations are distributed.
+     * \param minimumNumberOfParallelBodies Minimum number of propagated bodies for which the acceleration evaluations are
+     * distributed over the threads (default defaultMinimumNumberOfParallelBodies).
+     */
+    void setNumberOfThreads( const unsigned int numberOfThreads,
+                             const unsigned int minimumNumberOfParallelBodies = defaultMinimumNumberOfParallelBodies )
+    {
+        numberOfThreads_ = numberOfThreads;
+        minimumNumberOfParallelBodies_ = minimumNumberOfParallelBodies;
+
+        threadPool_.reset( );
+        unsigned int numberOfPropagatedBodies = accelerationModelsPerPropagatedBody_.size( );
+        if( numberOfThreads_ > 1 && numberOfPropagatedBodies > 1 &&
+                numberOfPropagatedBodies >= minimumNumberOfParallelBodies_ )
+        {
+            threadPool_ = boost::make_shared< utilities::ThreadPool >(
+                        std::min( numberOfThreads_, numberOfPropagatedBodies ) );
+        }
+    }
+
+    //! Function to retrieve the number of threads over which the acceleration evaluations are distributed.
+    /*!
+     * Function to retrieve the number of threads over which the acceleration evaluations are distributed.
+     * \return Number of threads over which the acceleration evaluations are distributed.
+     */
+    unsigned int getNumberOfThreads( )
+    {
+        return numberOfThreads_;
+    }
+
+    //! Function to retrieve whether the acceleration evaluations are distributed over multiple threads.
+    /*!
+     * Function to retrieve whether the acceleration evaluations are distributed over multiple threads, i.e. whether more
+     * than one thread is set and the number of propagated bodies is at least the minimum set by setNumberOfThreads.
+     * \return True if the acceleration evaluations are distributed over multiple threads.
+     */
+    bool isEvaluationParallel( )
+    {
+        return ( threadPool_ != NULL );
     }
 
     //! Function to convert the propagator-specific form of the state to the conventional form in the global frame.
@@ -186,14 +273,17 @@ public:
             const Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 >& internalSolution, const TimeType& time,
             Eigen::Block< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > currentCartesianLocalSoluton )
     {
-        this->convertToOutputSolution( internalSolution, time, currentCartesianLocalSoluton );
+        // Copy input and output through member buffers, to prevent temporaries from being allocated.
+        internalSolutionBuffer_ = internalSolution;
+        this->convertToOutputSolution( internalSolutionBuffer_, time, currentCartesianLocalSoluton );
 
+        currentCartesianLocalSolutionBuffer_ = currentCartesianLocalSoluton;
         centralBodyData_->getReferenceFrameOriginInertialStates(
-                    currentCartesianLocalSoluton, time, centralBodyInertialStates_, true );
+                    currentCartesianLocalSolutionBuffer_, time, centralBodyInertialStates_, true );
 
         for( unsigned int i = 0; i < centralBodyInertialStates_.size( ); i++ )
         {
-            currentCartesianLocalSoluton.segment( i * 6, 6 ) += centralBodyInertialStates_[ i ];
+            currentCartesianLocalSoluton.block( i * 6, 0, 6, 1 ) += centralBodyInertialStates_[ i ];
         }
     }
 
@@ -311,10 +401,15 @@ protected:
     void createAccelerationModelList( )
     {
         accelerationModelList_.clear( );
+        accelerationModelsPerPropagatedBody_.clear( );
+
         // Iterate over all accelerations and update their internal state.
         for( outerAccelerationIterator = accelerationModelsPerBody_.begin( );
              outerAccelerationIterator != accelerationModelsPerBody_.end( ); outerAccelerationIterator++ )
         {
+            accelerationModelsPerPropagatedBody_.push_back(
+                        std::vector< boost::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > >( ) );
+
             // Iterate over all accelerations acting on body
             for( innerAccelerationIterator  = outerAccelerationIterator->second.begin( );
                  innerAccelerationIterator != outerAccelerationIterator->second.end( );
@@ -324,16 +419,20 @@ protected:
                 for( unsigned int j = 0; j < innerAccelerationIterator->second.size( ); j++ )
                 {
                     accelerationModelList_.push_back( innerAccelerationIterator->second.at( j ) );
+                    accelerationModelsPerPropagatedBody_.back( ).push_back( innerAccelerationIterator->second.at( j ) );
                 }
             }
         }
+
+        totalAccelerationsPerPropagatedBody_.resize( accelerationModelsPerPropagatedBody_.size( ) );
     }
 
     //! Function to get the state derivative of the system in Cartesian coordinates.
     /*!
      * Function to get the state derivative of the system in Cartesian coordinates. The environment
      * and acceleration models must have been updated to the current state before calling this
-     * function.
+     * function. If the evaluation is parallel, the accelerations summed by the updateStateDerivativeModel
+     * function are used.
      * \param stateOfSystemToBeIntegrated Current Cartesian state of the system.
      * \param stateDerivative State derivative of the system in Cartesian coordinates (returned by reference).
      */
@@ -345,6 +444,20 @@ protected:
 
         stateDerivative.setZero( );
 
+        // Set accelerations as computed during (parallel) update of acceleration models.
+        if( threadPool_ != NULL )
+        {
+            int currentBodyIndex = 0;
+            for( unsigned int i = 0; i < totalAccelerationsPerPropagatedBody_.size( ); i++ )
+            {
+                currentBodyIndex = bodyOrder_[ i ];
+                stateDerivative.block( currentBodyIndex * 6 + 3, 0, 3, 1 ) = totalAccelerationsPerPropagatedBody_[ i ];
+                stateDerivative.block( currentBodyIndex * 6, 0, 3, 1 ) =
+                        ( stateOfSystemToBeIntegrated.segment( currentBodyIndex * 6 + 3, 3 ) );
+            }
+            return;
+        }
+
         int currentBodyIndex = 0;
         int currentAccelerationIndex = 0;
 
@@ -390,6 +503,13 @@ protected:
     //! Vector of acceleration models, containing all entries of accelerationModelsPerBody_.
     std::vector< boost::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > > accelerationModelList_;
 
+    //! Acceleration models acting on each propagated body, in the order of accelerationModelsPerBody_ (see bodyOrder_).
+    std::vector< std::vector< boost::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > > >
+    accelerationModelsPerPropagatedBody_;
+
+    //! Total acceleration acting on each propagated body, as computed by parallel update of acceleration models.
+    std::vector< Eigen::Matrix< StateScalarType, 3, 1 > > totalAccelerationsPerPropagatedBody_;
+
     //! Object responsible for providing the current integration origins from the global origins.
     boost::shared_ptr< CentralBodyData< StateScalarType, TimeType > > centralBodyData_;
 
@@ -401,6 +521,15 @@ protected:
 
     std::vector< int > bodyOrder_;
 
+    //! Number of threads over which the acceleration evaluations are distributed.
+    unsigned int numberOfThreads_;
+
+    //! Minimum number of propagated bodies for which the acceleration evaluations are distributed over the threads.
+    unsigned int minimumNumberOfParallelBodies_;
+
+    //! Threads over which the acceleration evaluations are distributed (NULL if evaluation is serial).
+    boost::shared_ptr< utilities::ThreadPool > threadPool_;
+
     //! Predefined iterator to save (de-)allocation time.
     std::unordered_map< std::string, std::vector<
     boost::shared_ptr< basic_astrodynamics::AccelerationModel< Eigen::Vector3d > > > >::iterator innerAccelerationIterator;
@@ -411,6 +540,12 @@ protected:
 
     //! List of states of teh central bodies of the propagated bodies.
     std::vector< Eigen::Matrix< StateScalarType, 6, 1 >  > centralBodyInertialStates_;
+
+    //! Buffer for the propagator-specific state in convertCurrentStateToGlobalRepresentation.
+    Eigen::Matrix< StateScalarType, Eigen::Dynamic, Eigen::Dynamic > internalSolutionBuffer_;
+
+    //! Buffer for the local Cartesian state in convertCurrentStateToGlobalRepresentation.
+    Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > currentCartesianLocalSolutionBuffer_;
 };
 
 } // namespace propagators
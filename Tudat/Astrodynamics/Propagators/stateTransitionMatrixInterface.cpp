@@ -7,6 +7,9 @@
  *    a copy of the license with this file. If not, please or visit:
  *    http://tudat.tudelft.nl/LICENSE.
  */
+#include <algorithm>
+
+#include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
 #include "Tudat/Astrodynamics/Propagators/stateTransitionMatrixInterface.h"
@@ -17,6 +20,18 @@ namespace tudat
 namespace propagators
 {
 
+//! Function to get the concatenated state transition and sensitivity matrices at a list of times.
+void CombinedStateTransitionAndSensitivityMatrixInterface::getCombinedStateTransitionAndSensitivityMatrices(
+        const std::vector< double >& evaluationTimes,
+        std::vector< Eigen::MatrixXd >& combinedStateTransitionMatrices )
+{
+    combinedStateTransitionMatrices.resize( evaluationTimes.size( ) );
+    for( unsigned int i = 0; i < evaluationTimes.size( ); i++ )
+    {
+        combinedStateTransitionMatrices[ i ] = getCombinedStateTransitionAndSensitivityMatrix( evaluationTimes[ i ] );
+    }
+}
+
 //! Function to reset the state transition and sensitivity matrix interpolators
 void SingleArcCombinedStateTransitionAndSensitivityMatrixInterface::updateMatrixInterpolators(
         const boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > stateTransitionMatrixInterpolator,
@@ -45,6 +60,77 @@ Eigen::MatrixXd SingleArcCombinedStateTransitionAndSensitivityMatrixInterface::g
     return combinedStateTransitionMatrix_;
 }
 
+//! Function to reset the state transition and sensitivity matrix interpolators
+void MultiArcCombinedStateTransitionAndSensitivityMatrixInterface::updateMatrixInterpolators(
+        const std::vector< boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > >
+        stateTransitionMatrixInterpolators,
+        const std::vector< boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > >
+        sensitivityMatrixInterpolators,
+        const std::vector< double >& arcStartTimes )
+{
+    if( arcStartTimes.size( ) == 0 || stateTransitionMatrixInterpolators.size( ) != arcStartTimes.size( ) ||
+            sensitivityMatrixInterpolators.size( ) != arcStartTimes.size( ) )
+    {
+        throw std::runtime_error( "Error when setting multi-arc state transition matrix interface, number of "
+                                  "interpolators is inconsistent with number of arcs (" +
+                                  boost::lexical_cast< std::string >( arcStartTimes.size( ) ) + ")." );
+    }
+
+    stateTransitionMatrixInterpolators_ = stateTransitionMatrixInterpolators;
+    sensitivityMatrixInterpolators_ = sensitivityMatrixInterpolators;
+    arcStartTimes_ = arcStartTimes;
+}
+
+//! Function to get the index of the arc that contains the given time.
+int MultiArcCombinedStateTransitionAndSensitivityMatrixInterface::getCurrentArc( const double evaluationTime )
+{
+    std::vector< double >::iterator nextArcIterator =
+            std::upper_bound( arcStartTimes_.begin( ), arcStartTimes_.end( ), evaluationTime );
+    return ( nextArcIterator == arcStartTimes_.begin( ) ) ?
+                0 : static_cast< int >( std::distance( arcStartTimes_.begin( ), nextArcIterator ) - 1 );
+}
+
+//! Function to get the concatenated state transition and sensitivity matrix at a given time.
+Eigen::MatrixXd MultiArcCombinedStateTransitionAndSensitivityMatrixInterface::getCombinedStateTransitionAndSensitivityMatrix(
+        const double evaluationTime )
+{
+    int currentArc = getCurrentArc( evaluationTime );
+    Eigen::MatrixXd combinedStateTransitionMatrix = Eigen::MatrixXd::Zero(
+                stateTransitionMatrixSize_, stateTransitionMatrixSize_ + sensitivityMatrixSize_ );
+
+    // Set Phi and S matrices of current arc.
+    combinedStateTransitionMatrix.block( 0, 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ) =
+            stateTransitionMatrixInterpolators_.at( currentArc )->interpolate( evaluationTime );
+    if( sensitivityMatrixSize_ > 0 )
+    {
+        combinedStateTransitionMatrix.block( 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_, sensitivityMatrixSize_ ) =
+                sensitivityMatrixInterpolators_.at( currentArc )->interpolate( evaluationTime );
+    }
+
+    return combinedStateTransitionMatrix;
+}
+
+//! Function to get the concatenated state transition and sensitivity matrix at a given time, including inactive arcs.
+Eigen::MatrixXd MultiArcCombinedStateTransitionAndSensitivityMatrixInterface::getFullCombinedStateTransitionAndSensitivityMatrix(
+        const double evaluationTime )
+{
+    int currentArc = getCurrentArc( evaluationTime );
+    Eigen::MatrixXd combinedStateTransitionMatrix = Eigen::MatrixXd::Zero(
+                stateTransitionMatrixSize_, getFullParameterVectorSize( ) );
+
+    // Set Phi of current arc in columns of its initial state, and S in columns of the other parameters.
+    combinedStateTransitionMatrix.block(
+                0, currentArc * stateTransitionMatrixSize_, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ) =
+            stateTransitionMatrixInterpolators_.at( currentArc )->interpolate( evaluationTime );
+    if( sensitivityMatrixSize_ > 0 )
+    {
+        combinedStateTransitionMatrix.rightCols( sensitivityMatrixSize_ ) =
+                sensitivityMatrixInterpolators_.at( currentArc )->interpolate( evaluationTime );
+    }
+
+    return combinedStateTransitionMatrix;
+}
+
 }
 
 }
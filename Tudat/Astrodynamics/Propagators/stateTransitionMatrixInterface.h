@@ -70,6 +70,19 @@ public:
      */
     virtual Eigen::MatrixXd getFullCombinedStateTransitionAndSensitivityMatrix( const double evaluationTime ) = 0;
 
+    //! Function to get the concatenated state transition and sensitivity matrices at a list of times.
+    /*!
+     *  Function to get the concatenated state transition and sensitivity matrices at a list of times. This base class
+     *  implementation calls getCombinedStateTransitionAndSensitivityMatrix for each time; derived classes may
+     *  override it with a more efficient implementation.
+     *  \param evaluationTimes Times at which to evaluate matrices, preferably sorted in ascending order.
+     *  \param combinedStateTransitionMatrices Concatenated state transition and sensitivity matrices at evaluationTimes
+     *  (returned by reference).
+     */
+    virtual void getCombinedStateTransitionAndSensitivityMatrices(
+            const std::vector< double >& evaluationTimes,
+            std::vector< Eigen::MatrixXd >& combinedStateTransitionMatrices );
+
     //! Function to get the size of state transition matrix
     /*!
      * Function to get the size of state transition matrix
@@ -220,6 +233,124 @@ private:
     sensitivityMatrixInterpolator_;
 };
 
+//! Interface object of interpolation of numerically propagated state transition and sensitivity matrices for multi-arc
+//! estimation.
+/*!
+ *  Interface object of interpolation of numerically propagated state transition and sensitivity matrices for multi-arc
+ *  estimation, in which each arc has its own initial state, while the other parameters are shared between arcs. The
+ *  matrices at a given time are retrieved from the arc that contains that time (the last arc that starts at or before
+ *  it). In the full parameter vector, the initial states of all arcs are followed by the other parameters.
+ */
+class MultiArcCombinedStateTransitionAndSensitivityMatrixInterface:
+        public CombinedStateTransitionAndSensitivityMatrixInterface
+{
+public:
+
+    //! Constructor
+    /*!
+     * Constructor
+     * \param stateTransitionMatrixInterpolators Interpolators returning the state transition matrix as a function of
+     * time, one per arc.
+     * \param sensitivityMatrixInterpolators Interpolators returning the sensitivity matrix as a function of time, one per
+     * arc.
+     * \param arcStartTimes Start times of the arcs (in ascending order).
+     * \param numberOfInitialDynamicalParameters Size of the estimated initial state vector of a single arc (and size of
+     * square state transition matrix).
+     * \param numberOfParameters Total number of estimated parameters in a single arc (initial states of the arc and other
+     * parameters).
+     * \throws std::runtime_error If the number of interpolators is inconsistent with the number of arcs.
+     */
+    MultiArcCombinedStateTransitionAndSensitivityMatrixInterface(
+            const std::vector< boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > >
+            stateTransitionMatrixInterpolators,
+            const std::vector< boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > >
+            sensitivityMatrixInterpolators,
+            const std::vector< double >& arcStartTimes,
+            const int numberOfInitialDynamicalParameters,
+            const int numberOfParameters ):
+        CombinedStateTransitionAndSensitivityMatrixInterface( numberOfInitialDynamicalParameters, numberOfParameters )
+    {
+        updateMatrixInterpolators( stateTransitionMatrixInterpolators, sensitivityMatrixInterpolators, arcStartTimes );
+    }
+
+    //! Destructor.
+    ~MultiArcCombinedStateTransitionAndSensitivityMatrixInterface( ){ }
+
+    //! Function to reset the state transition and sensitivity matrix interpolators
+    /*!
+     * Function to reset the state transition and sensitivity matrix interpolators, and the arcs to which they apply.
+     * \param stateTransitionMatrixInterpolators New interpolators returning the state transition matrix as a function of
+     * time, one per arc.
+     * \param sensitivityMatrixInterpolators New interpolators returning the sensitivity matrix as a function of time, one
+     * per arc.
+     * \param arcStartTimes Start times of the arcs (in ascending order).
+     * \throws std::runtime_error If the number of interpolators is inconsistent with the number of arcs.
+     */
+    void updateMatrixInterpolators(
+            const std::vector< boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > >
+            stateTransitionMatrixInterpolators,
+            const std::vector< boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > >
+            sensitivityMatrixInterpolators,
+            const std::vector< double >& arcStartTimes );
+
+    //! Function to get the concatenated state transition and sensitivity matrix at a given time.
+    /*!
+     *  Function to get the concatenated state transition and sensitivity matrix of the arc that contains the given time.
+     *  \param evaluationTime Time at which to evaluate matrix interpolators
+     *  \return Concatenated state transition and sensitivity matrices.
+     */
+    Eigen::MatrixXd getCombinedStateTransitionAndSensitivityMatrix( const double evaluationTime );
+
+    //! Function to get the concatenated state transition and sensitivity matrix at a given time, which includes
+    //! zero values for parameters not active in current arc.
+    /*!
+     *  Function to get the concatenated state transition and sensitivity matrix at a given time, which includes
+     *  zero values for the initial states of all arcs other than the one that contains the given time.
+     *  \param evaluationTime Time at which to evaluate matrix interpolators
+     *  \return Concatenated state transition and sensitivity matrices, including inactive parameters at
+     *  evaluationTime.
+     */
+    Eigen::MatrixXd getFullCombinedStateTransitionAndSensitivityMatrix( const double evaluationTime );
+
+    //! Function to get the size of the total parameter vector.
+    /*!
+     * Function to get the size of the total parameter vector: the initial states of all arcs and the other parameters.
+     * \return Size of the total parameter vector.
+     */
+    int getFullParameterVectorSize( )
+    {
+        return static_cast< int >( arcStartTimes_.size( ) ) * stateTransitionMatrixSize_ + sensitivityMatrixSize_;
+    }
+
+    //! Function to get the index of the arc that contains the given time.
+    /*!
+     *  Function to get the index of the arc that contains the given time: the last arc that starts at or before the
+     *  given time, or the first arc if the time is before the start of all arcs.
+     *  \param evaluationTime Time for which the arc is to be determined.
+     *  \return Index of the arc that contains the given time.
+     */
+    int getCurrentArc( const double evaluationTime );
+
+    //! Function to get the number of arcs.
+    int getNumberOfArcs( )
+    {
+        return static_cast< int >( arcStartTimes_.size( ) );
+    }
+
+private:
+
+    //! Interpolators returning the state transition matrix as a function of time, one per arc.
+    std::vector< boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > >
+    stateTransitionMatrixInterpolators_;
+
+    //! Interpolators returning the sensitivity matrix as a function of time, one per arc.
+    std::vector< boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > >
+    sensitivityMatrixInterpolators_;
+
+    //! Start times of the arcs.
+    std::vector< double > arcStartTimes_;
+};
+
 } // namespace propagators
 
 } // namespace tudat
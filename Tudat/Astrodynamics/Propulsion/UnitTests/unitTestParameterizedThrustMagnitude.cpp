@@ -0,0 +1,289 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/multi_array.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Propulsion/thrustFunctions.h"
+#include "Tudat/Astrodynamics/Propulsion/thrustMagnitudeWrapper.h"
+#include "Tudat/Mathematics/Interpolators/multiLinearInterpolator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace propulsion;
+using namespace interpolators;
+
+//! Class to provide (time-dependent) input variables for a parameterized thrust, counting the number of evaluations.
+class ThrustInputVariables
+{
+public:
+
+    //! Constructor
+    ThrustInputVariables( ):
+        currentTime_( 0.0 ), numberOfMachNumberCalls_( 0 ), numberOfAltitudeCalls_( 0 ){ }
+
+    //! Function to set the current time, from which the input variables are computed.
+    void setCurrentTime( const double currentTime )
+    {
+        currentTime_ = currentTime;
+    }
+
+    //! Function to compute the current Mach number.
+    double getMachNumber( )
+    {
+        numberOfMachNumberCalls_++;
+        return 3.0 + 2.5 * std::sin( 1.0E-3 * currentTime_ );
+    }
+
+    //! Function to compute the current altitude.
+    double getAltitude( )
+    {
+        numberOfAltitudeCalls_++;
+        return 5.0E4 + 4.0E4 * std::cos( 1.3E-3 * currentTime_ );
+    }
+
+    //! Current time, from which the input variables are computed.
+    double currentTime_;
+
+    //! Number of calls to getMachNumber function.
+    int numberOfMachNumberCalls_;
+
+    //! Number of calls to getAltitude function.
+    int numberOfAltitudeCalls_;
+};
+
+//! Function to create a 2-dimensional table of thrust and specific impulse, as function of Mach number and altitude.
+void createThrustTables(
+        std::vector< std::vector< double > >& independentValues,
+        boost::multi_array< double, 2 >& thrustTable,
+        boost::multi_array< double, 2 >& specificImpulseTable,
+        boost::multi_array< Eigen::Vector2d, 2 >& combinedTable )
+{
+    const int numberOfMachNumbers = 41;
+    const int numberOfAltitudes = 61;
+
+    independentValues.resize( 2 );
+    for( int i = 0; i < numberOfMachNumbers; i++ )
+    {
+        independentValues[ 0 ].push_back( 0.15 * static_cast< double >( i ) );
+    }
+    for( int i = 0; i < numberOfAltitudes; i++ )
+    {
+        independentValues[ 1 ].push_back( 1.5E3 * static_cast< double >( i ) );
+    }
+
+    thrustTable.resize( boost::extents[ numberOfMachNumbers ][ numberOfAltitudes ] );
+    specificImpulseTable.resize( boost::extents[ numberOfMachNumbers ][ numberOfAltitudes ] );
+    combinedTable.resize( boost::extents[ numberOfMachNumbers ][ numberOfAltitudes ] );
+    for( int i = 0; i < numberOfMachNumbers; i++ )
+    {
+        for( int j = 0; j < numberOfAltitudes; j++ )
+        {
+            thrustTable[ i ][ j ] = 1.0E5 * ( 1.0 + 0.1 * independentValues[ 0 ][ i ] ) *
+                    std::exp( -independentValues[ 1 ][ j ] / 3.0E4 );
+            specificImpulseTable[ i ][ j ] = 300.0 + 20.0 * std::sin( independentValues[ 0 ][ i ] ) +
+                    1.0E-3 * independentValues[ 1 ][ j ];
+            combinedTable[ i ][ j ] = Eigen::Vector2d( thrustTable[ i ][ j ], specificImpulseTable[ i ][ j ] );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( test_parameterized_thrust_magnitude )
+
+//! Test whether the thrust and specific impulse are computed once per time, with environment inputs retrieved once.
+BOOST_AUTO_TEST_CASE( testParameterizedThrustMagnitudeEvaluations )
+{
+    std::vector< std::vector< double > > independentValues;
+    boost::multi_array< double, 2 > thrustTable, specificImpulseTable;
+    boost::multi_array< Eigen::Vector2d, 2 > combinedTable;
+    createThrustTables( independentValues, thrustTable, specificImpulseTable, combinedTable );
+
+    boost::shared_ptr< Interpolator< double, double > > thrustInterpolator =
+            boost::make_shared< MultiLinearInterpolator< double, double, 2 > >( independentValues, thrustTable );
+    boost::shared_ptr< Interpolator< double, double > > specificImpulseInterpolator =
+            boost::make_shared< MultiLinearInterpolator< double, double, 2 > >(
+                independentValues, specificImpulseTable );
+    boost::shared_ptr< Interpolator< double, Eigen::Vector2d > > combinedInterpolator =
+            boost::make_shared< MultiLinearInterpolator< double, Eigen::Vector2d, 2 > >(
+                independentValues, combinedTable );
+
+    boost::shared_ptr< ThrustInputVariables > separateInputVariables = boost::make_shared< ThrustInputVariables >( );
+    boost::shared_ptr< ThrustInputVariables > combinedInputVariables = boost::make_shared< ThrustInputVariables >( );
+
+    // Create thrust model with separate thrust and specific impulse interpolators, both depending on Mach number and
+    // altitude (in different order).
+    std::vector< boost::function< double( ) > > thrustInputVariableFunctions;
+    thrustInputVariableFunctions.push_back( boost::bind( &ThrustInputVariables::getMachNumber, separateInputVariables ) );
+    thrustInputVariableFunctions.push_back( boost::bind( &ThrustInputVariables::getAltitude, separateInputVariables ) );
+    std::vector< boost::function< double( ) > > specificImpulseInputVariableFunctions;
+    specificImpulseInputVariableFunctions.push_back(
+                boost::bind( &ThrustInputVariables::getMachNumber, separateInputVariables ) );
+    specificImpulseInputVariableFunctions.push_back(
+                boost::bind( &ThrustInputVariables::getAltitude, separateInputVariables ) );
+    std::vector< ThrustIndependentVariables > independentVariables =
+    { mach_number_dependent_thrust, altitude_dependent_thrust };
+
+    ParameterizedThrustMagnitudeWrapper separateThrustModel(
+                boost::bind( &Interpolator< double, double >::interpolate, thrustInterpolator, _1 ),
+                boost::bind( &Interpolator< double, double >::interpolate, specificImpulseInterpolator, _1 ),
+                thrustInputVariableFunctions, specificImpulseInputVariableFunctions,
+                independentVariables, independentVariables,
+                boost::bind( &ThrustInputVariables::setCurrentTime, separateInputVariables, _1 ) );
+    BOOST_CHECK_EQUAL( separateThrustModel.getNumberOfInputVariables( ), 2 );
+
+    // Create thrust model with single interpolator for thrust and specific impulse.
+    std::vector< boost::function< double( ) > > combinedInputVariableFunctions;
+    combinedInputVariableFunctions.push_back(
+                boost::bind( &ThrustInputVariables::getMachNumber, combinedInputVariables ) );
+    combinedInputVariableFunctions.push_back(
+                boost::bind( &ThrustInputVariables::getAltitude, combinedInputVariables ) );
+
+    ParameterizedThrustMagnitudeWrapper combinedThrustModel(
+                boost::bind( &Interpolator< double, Eigen::Vector2d >::interpolate, combinedInterpolator, _1 ),
+                combinedInputVariableFunctions, independentVariables,
+                boost::bind( &ThrustInputVariables::setCurrentTime, combinedInputVariables, _1 ) );
+
+    for( int i = 0; i < 100; i++ )
+    {
+        const double currentTime = 37.0 * static_cast< double >( i );
+
+        // Update models as done by thrust acceleration and mass rate models.
+        separateThrustModel.update( currentTime );
+        separateThrustModel.update( currentTime );
+        combinedThrustModel.update( currentTime );
+        combinedThrustModel.update( currentTime );
+
+        // Check that each input variable is retrieved only once per time.
+        BOOST_CHECK_EQUAL( separateInputVariables->numberOfMachNumberCalls_, i + 1 );
+        BOOST_CHECK_EQUAL( separateInputVariables->numberOfAltitudeCalls_, i + 1 );
+        BOOST_CHECK_EQUAL( combinedInputVariables->numberOfMachNumberCalls_, i + 1 );
+        BOOST_CHECK_EQUAL( combinedInputVariables->numberOfAltitudeCalls_, i + 1 );
+
+        // Compare against direct interpolation.
+        std::vector< double > currentInput = { separateInputVariables->getMachNumber( ),
+                                               separateInputVariables->getAltitude( ) };
+        separateInputVariables->numberOfMachNumberCalls_--;
+        separateInputVariables->numberOfAltitudeCalls_--;
+
+        const double expectedThrust = thrustInterpolator->interpolate( currentInput );
+        const double expectedSpecificImpulse = specificImpulseInterpolator->interpolate( currentInput );
+        BOOST_CHECK_EQUAL( separateThrustModel.getCurrentThrustMagnitude( ), expectedThrust );
+        BOOST_CHECK_EQUAL( separateThrustModel.getCurrentSpecificImpulse( ), expectedSpecificImpulse );
+        BOOST_CHECK_EQUAL( separateThrustModel.getCurrentMassRate( ),
+                           computePropellantMassRateFromSpecificImpulse( expectedThrust, expectedSpecificImpulse ) );
+
+        BOOST_CHECK_CLOSE_FRACTION( combinedThrustModel.getCurrentThrustMagnitude( ), expectedThrust,
+                                    10.0 * std::numeric_limits< double >::epsilon( ) );
+        BOOST_CHECK_CLOSE_FRACTION( combinedThrustModel.getCurrentSpecificImpulse( ), expectedSpecificImpulse,
+                                    10.0 * std::numeric_limits< double >::epsilon( ) );
+        BOOST_CHECK_CLOSE_FRACTION( combinedThrustModel.getCurrentMassRate( ), separateThrustModel.getCurrentMassRate( ),
+                                    10.0 * std::numeric_limits< double >::epsilon( ) );
+    }
+
+    // Check that resetting the time forces a recomputation at the same time.
+    separateThrustModel.resetCurrentTime( );
+    separateThrustModel.update( 37.0 * 99.0 );
+    BOOST_CHECK_EQUAL( separateInputVariables->numberOfMachNumberCalls_, 101 );
+}
+
+//! Test whether user-defined guidance inputs are always retrieved separately for thrust and specific impulse.
+BOOST_AUTO_TEST_CASE( testParameterizedThrustMagnitudeGuidanceInput )
+{
+    std::vector< boost::function< double( ) > > thrustInputVariableFunctions =
+    { [ ]( ){ return 2.0; }, [ ]( ){ return 3.0; } };
+    std::vector< boost::function< double( ) > > specificImpulseInputVariableFunctions =
+    { [ ]( ){ return 5.0; }, [ ]( ){ return 7.0; } };
+
+    ParameterizedThrustMagnitudeWrapper thrustModel(
+                [ ]( const std::vector< double >& input ){ return input.at( 0 ) * input.at( 1 ); },
+                [ ]( const std::vector< double >& input ){ return input.at( 0 ) + input.at( 1 ); },
+                thrustInputVariableFunctions, specificImpulseInputVariableFunctions,
+                { guidance_input_dependent_thrust, altitude_dependent_thrust },
+                { guidance_input_dependent_thrust, altitude_dependent_thrust } );
+    BOOST_CHECK_EQUAL( thrustModel.getNumberOfInputVariables( ), 3 );
+
+    // Altitude input for specific impulse is taken from that of the thrust (value 3.0).
+    thrustModel.update( 0.0 );
+    BOOST_CHECK_EQUAL( thrustModel.getCurrentThrustMagnitude( ), 6.0 );
+    BOOST_CHECK_EQUAL( thrustModel.getCurrentSpecificImpulse( ), 8.0 );
+}
+
+//! Test whether separate and combined thrust and specific impulse evaluation give consistent results.
+BOOST_AUTO_TEST_CASE( testParameterizedThrustMagnitudeSeparateAndCombined )
+{
+    std::vector< std::vector< double > > independentValues;
+    boost::multi_array< double, 2 > thrustTable, specificImpulseTable;
+    boost::multi_array< Eigen::Vector2d, 2 > combinedTable;
+    createThrustTables( independentValues, thrustTable, specificImpulseTable, combinedTable );
+
+    boost::shared_ptr< Interpolator< double, double > > thrustInterpolator =
+            boost::make_shared< MultiLinearInterpolator< double, double, 2 > >( independentValues, thrustTable );
+    boost::shared_ptr< Interpolator< double, double > > specificImpulseInterpolator =
+            boost::make_shared< MultiLinearInterpolator< double, double, 2 > >(
+                independentValues, specificImpulseTable );
+    boost::shared_ptr< Interpolator< double, Eigen::Vector2d > > combinedInterpolator =
+            boost::make_shared< MultiLinearInterpolator< double, Eigen::Vector2d, 2 > >(
+                independentValues, combinedTable );
+
+    boost::shared_ptr< ThrustInputVariables > inputVariables = boost::make_shared< ThrustInputVariables >( );
+    std::vector< boost::function< double( ) > > inputVariableFunctions;
+    inputVariableFunctions.push_back( boost::bind( &ThrustInputVariables::getMachNumber, inputVariables ) );
+    inputVariableFunctions.push_back( boost::bind( &ThrustInputVariables::getAltitude, inputVariables ) );
+    std::vector< ThrustIndependentVariables > independentVariables =
+    { mach_number_dependent_thrust, altitude_dependent_thrust };
+
+    ParameterizedThrustMagnitudeWrapper separateThrustModel(
+                boost::bind( &Interpolator< double, double >::interpolate, thrustInterpolator, _1 ),
+                boost::bind( &Interpolator< double, double >::interpolate, specificImpulseInterpolator, _1 ),
+                inputVariableFunctions, inputVariableFunctions, independentVariables, independentVariables,
+                boost::bind( &ThrustInputVariables::setCurrentTime, inputVariables, _1 ) );
+    ParameterizedThrustMagnitudeWrapper combinedThrustModel(
+                boost::bind( &Interpolator< double, Eigen::Vector2d >::interpolate, combinedInterpolator, _1 ),
+                inputVariableFunctions, independentVariables,
+                boost::bind( &ThrustInputVariables::setCurrentTime, inputVariables, _1 ) );
+
+    // Evaluate thrust and mass rate, as done by a thrust acceleration and mass rate model during a propagation.
+    const int numberOfEvaluations = 20000;
+    std::vector< ParameterizedThrustMagnitudeWrapper* > thrustModels = { &separateThrustModel, &combinedThrustModel };
+    std::vector< double > totalMassRates;
+    for( unsigned int j = 0; j < thrustModels.size( ); j++ )
+    {
+        double totalMassRate = 0.0;
+        for( int i = 0; i < numberOfEvaluations; i++ )
+        {
+            thrustModels.at( j )->resetCurrentTime( );
+            thrustModels.at( j )->update( static_cast< double >( i ) );
+            totalMassRate += thrustModels.at( j )->getCurrentThrustMagnitude( );
+            thrustModels.at( j )->update( static_cast< double >( i ) );
+            totalMassRate += thrustModels.at( j )->getCurrentMassRate( );
+        }
+        totalMassRates.push_back( totalMassRate );
+    }
+    BOOST_CHECK_CLOSE_FRACTION( totalMassRates.at( 0 ), totalMassRates.at( 1 ), 1.0E-12 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
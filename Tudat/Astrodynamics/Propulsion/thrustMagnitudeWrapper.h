@@ -15,6 +15,8 @@
 #include <boost/function.hpp>
 #include <boost/lambda/lambda.hpp>
 
+#include <Eigen/Core>
+
 #include "Tudat/Astrodynamics/SystemModels/engineModel.h"
 #include "Tudat/Mathematics/Interpolators/interpolator.h"
 
@@ -327,12 +329,18 @@ enum ThrustIndependentVariables
  *  throttle_dependent_thrust. Note that a throttle_dependent_thrust may not be used as one of the independent variables
  *  of the thrust magnitude for this class. This setting is parsed through the ParameterizedThrustMagnitudeSettings
  *  class, which is the class that is typically used to create this class.
+ *  The thrust and specific impulse are either computed from two separate functions, or from a single function
+ *  returning both (typically a single multi-output interpolator). In both cases, all independent variables are
+ *  retrieved once per update into a buffer that is allocated upon construction. Environment-dependent variables that
+ *  are used by both the thrust and the specific impulse function are retrieved only once. The thrust and specific
+ *  impulse are recomputed only when the model is updated to a new time (or after a call to resetCurrentTime), so
+ *  that the thrust acceleration and mass rate models using this object share a single evaluation.
  */
 class ParameterizedThrustMagnitudeWrapper: public ThrustMagnitudeWrapper
 {
 public:
 
-    //! Constructor for parameterized thrust and specific impulse.
+    //! Constructor for parameterized thrust and specific impulse, computed by separate functions.
     /*!
      * Constructor, defines the functions for thrust and specific impulse, as well as the physical meaning of each of the
      * independent variables.
@@ -349,8 +357,6 @@ public:
      * the thrustMagnitudeFunction function.
      * \param specificImpulseDependentVariables List of identifiers for the physical meaning of each of the entries of the
      * input to the specificImpulseDependentVariables function.
-     * \param specificImpulseDependentVariables List of identifiers for the physical meaning of each of the entries of the
-     * input to the specificImpulseDependentVariables function.
      * \param inputUpdateFunction Function that is called to update the user-defined guidance to the current time
      * (empty by default).
      */
@@ -365,26 +371,68 @@ public:
             boost::function< void( const double) >( ) ):
         thrustMagnitudeFunction_( thrustMagnitudeFunction ),
         specificImpulseFunction_( specificImpulseFunction ),
-        thrustInputVariableFunctions_( thrustInputVariableFunctions ),
-        specificImpulseInputVariableFunctions_( specificImpulseInputVariableFunctions ),
         thrustIndependentVariables_( thrustIndependentVariables ),
         specificImpulseDependentVariables_( specificImpulseDependentVariables ),
         inputUpdateFunction_( inputUpdateFunction ),
         currentThrustMagnitude_( TUDAT_NAN ),
         currentSpecificImpulse_( TUDAT_NAN )
     {
-        if( thrustInputVariableFunctions_.size( ) != thrustIndependentVariables_.size( ) )
+        if( thrustInputVariableFunctions.size( ) != thrustIndependentVariables_.size( ) )
         {
             throw std::runtime_error( "Error in parameterized thrust, inconsistent number of user-defined input variables for thrust" );
         }
 
-        if( specificImpulseInputVariableFunctions_.size( ) != specificImpulseDependentVariables_.size( ) )
+        if( specificImpulseInputVariableFunctions.size( ) != specificImpulseDependentVariables_.size( ) )
         {
             throw std::runtime_error( "Error in parameterized thrust, inconsistent number of user-defined input variables for Isp" );
         }
 
-        currentThrustInputVariables_.resize( thrustInputVariableFunctions.size( ) );
-        currentSpecificImpulseInputVariables_.resize( specificImpulseInputVariableFunctions.size( ) );
+        // Set list of unique input variables, and the indices of the thrust and specific impulse inputs in this list.
+        addInputVariables( thrustInputVariableFunctions, thrustIndependentVariables_, thrustInputIndices_ );
+        addInputVariables( specificImpulseInputVariableFunctions, specificImpulseDependentVariables_,
+                           specificImpulseInputIndices_ );
+
+        currentInputVariables_.resize( inputVariableFunctions_.size( ) );
+        currentThrustInputVariables_.resize( thrustInputIndices_.size( ) );
+        currentSpecificImpulseInputVariables_.resize( specificImpulseInputIndices_.size( ) );
+    }
+
+    //! Constructor for parameterized thrust and specific impulse, computed by a single function.
+    /*!
+     * Constructor, defines a single function for thrust and specific impulse, as well as the physical meaning of each of
+     * the independent variables.
+     * \param thrustMagnitudeAndSpecificImpulseFunction Function returning the current thrust (first entry) and
+     * specific impulse (second entry) as a function of the independent variables.
+     * \param inputVariableFunctions List of functions returning input variables for the thrust and specific impulse.
+     * The order of the functions in this vector is passed to the thrustMagnitudeAndSpecificImpulseFunction in the same
+     * order as entries of this vector.
+     * \param independentVariables List of identifiers for the physical meaning of each of the entries of the input to
+     * the thrustMagnitudeAndSpecificImpulseFunction function.
+     * \param inputUpdateFunction Function that is called to update the user-defined guidance to the current time
+     * (empty by default).
+     */
+    ParameterizedThrustMagnitudeWrapper(
+            const boost::function< Eigen::Vector2d( const std::vector< double >& ) >
+            thrustMagnitudeAndSpecificImpulseFunction,
+            const std::vector< boost::function< double( ) > > inputVariableFunctions,
+            const std::vector< propulsion::ThrustIndependentVariables > independentVariables,
+            const boost::function< void( const double) > inputUpdateFunction =
+            boost::function< void( const double) >( ) ):
+        thrustMagnitudeAndSpecificImpulseFunction_( thrustMagnitudeAndSpecificImpulseFunction ),
+        inputVariableFunctions_( inputVariableFunctions ),
+        inputVariableIdentifiers_( independentVariables ),
+        thrustIndependentVariables_( independentVariables ),
+        specificImpulseDependentVariables_( independentVariables ),
+        inputUpdateFunction_( inputUpdateFunction ),
+        currentThrustMagnitude_( TUDAT_NAN ),
+        currentSpecificImpulse_( TUDAT_NAN )
+    {
+        if( inputVariableFunctions_.size( ) != independentVariables.size( ) )
+        {
+            throw std::runtime_error( "Error in parameterized thrust, inconsistent number of user-defined input variables for thrust and Isp" );
+        }
+
+        currentInputVariables_.resize( inputVariableFunctions_.size( ) );
     }
 
     //! Destructor.
@@ -392,7 +440,8 @@ public:
 
     //! Function to update the thrust magnitude to the current time.
     /*!
-     *  Function to update the thrust magnitude to the current time.
+     *  Function to update the thrust magnitude and specific impulse to the current time. No computations are performed
+     *  if the model is already updated to the requested time.
      *  \param time Time to which the model is to be updated.
      */
     void update( const double time )
@@ -403,23 +452,40 @@ public:
             {
                 inputUpdateFunction_( time );
             }
-            // Retrieve thrust independent variables
-            for( unsigned int i = 0; i < thrustInputVariableFunctions_.size( ); i++ )
+
+            // Retrieve all independent variables
+            for( unsigned int i = 0; i < inputVariableFunctions_.size( ); i++ )
             {
-                currentThrustInputVariables_[ i ] = thrustInputVariableFunctions_.at( i )( );
+                currentInputVariables_[ i ] = inputVariableFunctions_[ i ]( );
             }
 
-            // Compute thrust
-            currentThrustMagnitude_ = thrustMagnitudeFunction_( currentThrustInputVariables_ );
-
-            // Retrieve specific impulse independent variables
-            for( unsigned int i = 0; i < specificImpulseInputVariableFunctions_.size( ); i++ )
+            if( !thrustMagnitudeAndSpecificImpulseFunction_.empty( ) )
+            {
+                // Compute thrust and specific impulse
+                const Eigen::Vector2d thrustMagnitudeAndSpecificImpulse =
+                        thrustMagnitudeAndSpecificImpulseFunction_( currentInputVariables_ );
+                currentThrustMagnitude_ = thrustMagnitudeAndSpecificImpulse( 0 );
+                currentSpecificImpulse_ = thrustMagnitudeAndSpecificImpulse( 1 );
+            }
+            else
             {
-                currentSpecificImpulseInputVariables_[ i ] = specificImpulseInputVariableFunctions_.at( i )( );
+                // Compute thrust
+                for( unsigned int i = 0; i < thrustInputIndices_.size( ); i++ )
+                {
+                    currentThrustInputVariables_[ i ] = currentInputVariables_[ thrustInputIndices_[ i ] ];
+                }
+                currentThrustMagnitude_ = thrustMagnitudeFunction_( currentThrustInputVariables_ );
+
+                // Compute specific impulse
+                for( unsigned int i = 0; i < specificImpulseInputIndices_.size( ); i++ )
+                {
+                    currentSpecificImpulseInputVariables_[ i ] =
+                            currentInputVariables_[ specificImpulseInputIndices_[ i ] ];
+                }
+                currentSpecificImpulse_ = specificImpulseFunction_( currentSpecificImpulseInputVariables_ );
             }
 
-            // Compute specific impulse
-            currentSpecificImpulse_ = specificImpulseFunction_( currentSpecificImpulseInputVariables_ );
+            currentTime_ = time;
         }
     }
 
@@ -458,19 +524,92 @@ public:
                     currentThrustMagnitude_, currentSpecificImpulse_ );
     }
 
+    //! Function to return the current specific impulse
+    /*!
+     * Function to return the current specific impulse, as computed by last call to update member function.
+     * \return Current specific impulse
+     */
+    double getCurrentSpecificImpulse( )
+    {
+        return currentSpecificImpulse_;
+    }
+
+    //! Function to return the number of (unique) input variables that are retrieved per update.
+    /*!
+     * Function to return the number of (unique) input variables that are retrieved per update.
+     * \return Number of (unique) input variables that are retrieved per update.
+     */
+    int getNumberOfInputVariables( )
+    {
+        return inputVariableFunctions_.size( );
+    }
+
 private:
 
+    //! Function to add input variable functions to the list of unique input variables.
+    /*!
+     * Function to add input variable functions to the list of unique input variables. An environment-dependent
+     * variable that is already in the list (as identified by its ThrustIndependentVariables entry) is not added a second
+     * time. User-defined guidance inputs are always added.
+     * \param newInputVariableFunctions List of functions returning input variables that are to be added.
+     * \param newIndependentVariables List of identifiers for the physical meaning of each of the entries of
+     * newInputVariableFunctions.
+     * \param inputIndices Indices in inputVariableFunctions_ of the functions in newInputVariableFunctions
+     * (returned by reference).
+     */
+    void addInputVariables(
+            const std::vector< boost::function< double( ) > >& newInputVariableFunctions,
+            const std::vector< propulsion::ThrustIndependentVariables >& newIndependentVariables,
+            std::vector< int >& inputIndices )
+    {
+        inputIndices.clear( );
+        for( unsigned int i = 0; i < newInputVariableFunctions.size( ); i++ )
+        {
+            int inputIndex = -1;
+            if( newIndependentVariables.at( i ) != guidance_input_dependent_thrust &&
+                    newIndependentVariables.at( i ) != throttle_dependent_thrust )
+            {
+                for( unsigned int j = 0; j < inputVariableIdentifiers_.size( ); j++ )
+                {
+                    if( inputVariableIdentifiers_.at( j ) == newIndependentVariables.at( i ) )
+                    {
+                        inputIndex = j;
+                        break;
+                    }
+                }
+            }
+
+            if( inputIndex < 0 )
+            {
+                inputIndex = inputVariableFunctions_.size( );
+                inputVariableFunctions_.push_back( newInputVariableFunctions.at( i ) );
+                inputVariableIdentifiers_.push_back( newIndependentVariables.at( i ) );
+            }
+            inputIndices.push_back( inputIndex );
+        }
+    }
+
     //! Function returning the current thrust as a function of its independent variables
     boost::function< double( const std::vector< double >& ) > thrustMagnitudeFunction_;
 
     //! Function returning the current specific impulse as a function of its independent variables
     boost::function< double( const std::vector< double >& ) > specificImpulseFunction_;
 
-    //!  List of functions returning input variables for thrustMagnitudeFunction_.
-    std::vector< boost::function< double( ) > > thrustInputVariableFunctions_;
+    //! Function returning the current thrust and specific impulse as a function of their independent variables
+    //! (empty if thrustMagnitudeFunction_ and specificImpulseFunction_ are used).
+    boost::function< Eigen::Vector2d( const std::vector< double >& ) > thrustMagnitudeAndSpecificImpulseFunction_;
+
+    //! List of functions returning the (unique) input variables, which are retrieved once per update.
+    std::vector< boost::function< double( ) > > inputVariableFunctions_;
 
-    //!  List of functions returning input variables for specificImpulseFunction_.
-    std::vector< boost::function< double( ) > > specificImpulseInputVariableFunctions_;
+    //! List of identifiers for the physical meaning of each of the entries of inputVariableFunctions_.
+    std::vector< propulsion::ThrustIndependentVariables > inputVariableIdentifiers_;
+
+    //! Indices in currentInputVariables_ of the input variables to thrustMagnitudeFunction_.
+    std::vector< int > thrustInputIndices_;
+
+    //! Indices in currentInputVariables_ of the input variables to specificImpulseFunction_.
+    std::vector< int > specificImpulseInputIndices_;
 
     //! List of identifiers for the physical meaning of each of the entries of the input to the thrustMagnitudeFunction
     //! function.
@@ -480,6 +619,9 @@ private:
     //! specificImpulseDependentVariables function.
     std::vector< propulsion::ThrustIndependentVariables > specificImpulseDependentVariables_;
 
+    //! List of current values of the (unique) input variables.
+    std::vector< double > currentInputVariables_;
+
     //! List of current input data to thrust function
     std::vector< double > currentThrustInputVariables_;
 
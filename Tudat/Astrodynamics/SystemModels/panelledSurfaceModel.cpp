@@ -0,0 +1,138 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <stdexcept>
+
+#include "Tudat/Astrodynamics/SystemModels/panelledSurfaceModel.h"
+
+namespace tudat
+{
+
+namespace system_models
+{
+
+//! Constructor
+PanelledSurfaceModel::PanelledSurfaceModel(
+        const std::vector< Eigen::Vector3d >& panelNormals,
+        const std::vector< double >& panelAreas,
+        const std::vector< double >& specularReflectivities,
+        const std::vector< double >& diffuseReflectivities,
+        const std::vector< double >& normalAccommodationCoefficients,
+        const std::vector< double >& tangentialAccommodationCoefficients )
+{
+    // Check input consistency
+    const unsigned int numberOfPanels = panelNormals.size( );
+    if( panelAreas.size( ) != numberOfPanels || specularReflectivities.size( ) != numberOfPanels ||
+            diffuseReflectivities.size( ) != numberOfPanels )
+    {
+        throw std::runtime_error( "Error when creating panelled surface model, panel property sizes are inconsistent" );
+    }
+
+    if( ( normalAccommodationCoefficients.size( ) != 0 &&
+          normalAccommodationCoefficients.size( ) != numberOfPanels ) ||
+            ( tangentialAccommodationCoefficients.size( ) != 0 &&
+              tangentialAccommodationCoefficients.size( ) != numberOfPanels ) )
+    {
+        throw std::runtime_error(
+                    "Error when creating panelled surface model, accommodation coefficient sizes are inconsistent" );
+    }
+
+    // Set panel properties as contiguous arrays.
+    panelNormals_.resize( 3, numberOfPanels );
+    panelAreas_.resize( numberOfPanels );
+    specularReflectivities_.resize( numberOfPanels );
+    diffuseReflectivities_.resize( numberOfPanels );
+    normalAccommodationCoefficients_.setOnes( numberOfPanels );
+    tangentialAccommodationCoefficients_.setOnes( numberOfPanels );
+
+    for( unsigned int i = 0; i < numberOfPanels; i++ )
+    {
+        if( !( panelNormals.at( i ).norm( ) > 0.0 ) )
+        {
+            throw std::runtime_error( "Error when creating panelled surface model, panel normal has zero length" );
+        }
+
+        if( specularReflectivities.at( i ) < 0.0 || diffuseReflectivities.at( i ) < 0.0 ||
+                specularReflectivities.at( i ) + diffuseReflectivities.at( i ) > 1.0 )
+        {
+            throw std::runtime_error( "Error when creating panelled surface model, panel reflectivities are invalid" );
+        }
+
+        panelNormals_.col( i ) = panelNormals.at( i ).normalized( );
+        panelAreas_( i ) = panelAreas.at( i );
+        specularReflectivities_( i ) = specularReflectivities.at( i );
+        diffuseReflectivities_( i ) = diffuseReflectivities.at( i );
+
+        if( normalAccommodationCoefficients.size( ) > 0 )
+        {
+            normalAccommodationCoefficients_( i ) = normalAccommodationCoefficients.at( i );
+        }
+
+        if( tangentialAccommodationCoefficients.size( ) > 0 )
+        {
+            tangentialAccommodationCoefficients_( i ) = tangentialAccommodationCoefficients.at( i );
+        }
+    }
+
+    // Precompute per-panel force factors.
+    radiationPressureSourceDirectionFactors_ = panelAreas_ * ( 1.0 - specularReflectivities_ );
+    radiationPressureSpecularNormalFactors_ = 2.0 * panelAreas_ * specularReflectivities_;
+    radiationPressureDiffuseNormalFactors_ = 2.0 / 3.0 * panelAreas_ * diffuseReflectivities_;
+
+    dragFlowDirectionFactors_ = panelAreas_ * tangentialAccommodationCoefficients_;
+    dragNormalFactors_ = panelAreas_ * ( 2.0 - normalAccommodationCoefficients_ - tangentialAccommodationCoefficients_ );
+}
+
+//! Function to create a box-wing panelled surface model.
+PanelledSurfaceModel createBoxWingPanelledSurfaceModel(
+        const Eigen::Vector3d& boxDimensions,
+        const double solarArrayArea,
+        const Eigen::Vector3d& solarArrayNormal,
+        const double boxSpecularReflectivity,
+        const double boxDiffuseReflectivity,
+        const double solarArrayFrontSpecularReflectivity,
+        const double solarArrayFrontDiffuseReflectivity,
+        const double solarArrayBackSpecularReflectivity,
+        const double solarArrayBackDiffuseReflectivity )
+{
+    std::vector< Eigen::Vector3d > panelNormals;
+    std::vector< double > panelAreas;
+    std::vector< double > specularReflectivities;
+    std::vector< double > diffuseReflectivities;
+
+    // Add faces of box, with the area of each face the product of the two dimensions perpendicular to its normal.
+    for( unsigned int i = 0; i < 3; i++ )
+    {
+        for( int sign = 1; sign >= -1; sign -= 2 )
+        {
+            panelNormals.push_back( sign * Eigen::Vector3d::Unit( i ) );
+            panelAreas.push_back( boxDimensions( ( i + 1 ) % 3 ) * boxDimensions( ( i + 2 ) % 3 ) );
+            specularReflectivities.push_back( boxSpecularReflectivity );
+            diffuseReflectivities.push_back( boxDiffuseReflectivity );
+        }
+    }
+
+    // Add front and back of solar array.
+    panelNormals.push_back( solarArrayNormal );
+    panelAreas.push_back( solarArrayArea );
+    specularReflectivities.push_back( solarArrayFrontSpecularReflectivity );
+    diffuseReflectivities.push_back( solarArrayFrontDiffuseReflectivity );
+
+    panelNormals.push_back( -solarArrayNormal );
+    panelAreas.push_back( solarArrayArea );
+    specularReflectivities.push_back( solarArrayBackSpecularReflectivity );
+    diffuseReflectivities.push_back( solarArrayBackDiffuseReflectivity );
+
+    return PanelledSurfaceModel( panelNormals, panelAreas, specularReflectivities, diffuseReflectivities );
+}
+
+} // namespace system_models
+
+} // namespace tudat
@@ -0,0 +1,258 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Montenbruck, O. and Gill, E. Satellite Orbits, Springer, 2000.
+ *      Doornbos, E. Thermospheric Density and Wind Determination from Satellite Dynamics, Springer, 2012.
+ *
+ */
+
+#ifndef TUDAT_PANELLEDSURFACEMODEL_H
+#define TUDAT_PANELLEDSURFACEMODEL_H
+
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+
+namespace system_models
+{
+
+//! Class defining the outer surface of a vehicle as a set of flat panels.
+/*!
+ *  Class defining the outer surface of a vehicle as a set of flat panels (e.g. a box-wing model), for use in
+ *  radiation pressure and (free molecular flow) drag computations. Each panel is defined by its outward normal in the
+ *  body-fixed frame of the vehicle, its area, its specular and diffuse reflectivity and its normal and tangential
+ *  accommodation coefficients. Self-shadowing of panels is not taken into account.
+ *  The panel properties are stored as contiguous arrays (one entry per panel), and the combinations of properties that
+ *  are needed in the force models are precomputed, so that the force summation over the panels can be evaluated as a
+ *  small number of (vectorized) Eigen matrix and array operations.
+ */
+class PanelledSurfaceModel
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param panelNormals Outward normals of the panels, in the body-fixed frame of the vehicle (normalized upon input).
+     *  \param panelAreas Areas of the panels
+     *  \param specularReflectivities Specular reflectivities of the panels
+     *  \param diffuseReflectivities Diffuse reflectivities of the panels (fraction of radiation that is absorbed is
+     *  1 - specular - diffuse reflectivity)
+     *  \param normalAccommodationCoefficients Normal momentum accommodation coefficients of the panels (all equal to 1,
+     *  i.e. fully diffuse re-emission, if empty).
+     *  \param tangentialAccommodationCoefficients Tangential momentum accommodation coefficients of the panels (all equal
+     *  to 1 if empty).
+     */
+    PanelledSurfaceModel(
+            const std::vector< Eigen::Vector3d >& panelNormals,
+            const std::vector< double >& panelAreas,
+            const std::vector< double >& specularReflectivities,
+            const std::vector< double >& diffuseReflectivities,
+            const std::vector< double >& normalAccommodationCoefficients = std::vector< double >( ),
+            const std::vector< double >& tangentialAccommodationCoefficients = std::vector< double >( ) );
+
+    //! Destructor
+    ~PanelledSurfaceModel( ){ }
+
+    //! Function to retrieve the number of panels
+    /*!
+     *  Function to retrieve the number of panels
+     *  \return Number of panels
+     */
+    int getNumberOfPanels( )
+    {
+        return panelAreas_.rows( );
+    }
+
+    //! Function to retrieve the outward panel normals
+    /*!
+     *  Function to retrieve the outward panel normals, in the body-fixed frame of the vehicle (one column per panel).
+     *  \return Outward panel normals
+     */
+    const Eigen::Matrix3Xd& getPanelNormals( )
+    {
+        return panelNormals_;
+    }
+
+    //! Function to retrieve the panel areas
+    /*!
+     *  Function to retrieve the panel areas
+     *  \return Panel areas
+     */
+    const Eigen::ArrayXd& getPanelAreas( )
+    {
+        return panelAreas_;
+    }
+
+    //! Function to retrieve the specular reflectivities of the panels
+    /*!
+     *  Function to retrieve the specular reflectivities of the panels
+     *  \return Specular reflectivities of the panels
+     */
+    const Eigen::ArrayXd& getSpecularReflectivities( )
+    {
+        return specularReflectivities_;
+    }
+
+    //! Function to retrieve the diffuse reflectivities of the panels
+    /*!
+     *  Function to retrieve the diffuse reflectivities of the panels
+     *  \return Diffuse reflectivities of the panels
+     */
+    const Eigen::ArrayXd& getDiffuseReflectivities( )
+    {
+        return diffuseReflectivities_;
+    }
+
+    //! Function to retrieve the normal accommodation coefficients of the panels
+    /*!
+     *  Function to retrieve the normal accommodation coefficients of the panels
+     *  \return Normal accommodation coefficients of the panels
+     */
+    const Eigen::ArrayXd& getNormalAccommodationCoefficients( )
+    {
+        return normalAccommodationCoefficients_;
+    }
+
+    //! Function to retrieve the tangential accommodation coefficients of the panels
+    /*!
+     *  Function to retrieve the tangential accommodation coefficients of the panels
+     *  \return Tangential accommodation coefficients of the panels
+     */
+    const Eigen::ArrayXd& getTangentialAccommodationCoefficients( )
+    {
+        return tangentialAccommodationCoefficients_;
+    }
+
+    //! Function to retrieve the per-panel radiation pressure force factors along the source direction.
+    /*!
+     *  Function to retrieve the per-panel radiation pressure force factors along the source direction, equal to
+     *  A * ( 1 - specular reflectivity ) (Montenbruck and Gill, 2000, eq. 3.79).
+     *  \return Per-panel radiation pressure force factors along the source direction.
+     */
+    const Eigen::ArrayXd& getRadiationPressureSourceDirectionFactors( )
+    {
+        return radiationPressureSourceDirectionFactors_;
+    }
+
+    //! Function to retrieve the per-panel specular radiation pressure force factors along the panel normal.
+    /*!
+     *  Function to retrieve the per-panel specular radiation pressure force factors along the panel normal, equal to
+     *  2 * A * specular reflectivity (multiplied by the squared cosine of the incidence angle in the force model).
+     *  \return Per-panel specular radiation pressure force factors along the panel normal.
+     */
+    const Eigen::ArrayXd& getRadiationPressureSpecularNormalFactors( )
+    {
+        return radiationPressureSpecularNormalFactors_;
+    }
+
+    //! Function to retrieve the per-panel diffuse radiation pressure force factors along the panel normal.
+    /*!
+     *  Function to retrieve the per-panel diffuse radiation pressure force factors along the panel normal, equal to
+     *  2 / 3 * A * diffuse reflectivity (multiplied by the cosine of the incidence angle in the force model).
+     *  \return Per-panel diffuse radiation pressure force factors along the panel normal.
+     */
+    const Eigen::ArrayXd& getRadiationPressureDiffuseNormalFactors( )
+    {
+        return radiationPressureDiffuseNormalFactors_;
+    }
+
+    //! Function to retrieve the per-panel drag force factors along the flow direction.
+    /*!
+     *  Function to retrieve the per-panel drag force factors along the flow direction, equal to
+     *  A * tangential accommodation coefficient.
+     *  \return Per-panel drag force factors along the flow direction.
+     */
+    const Eigen::ArrayXd& getDragFlowDirectionFactors( )
+    {
+        return dragFlowDirectionFactors_;
+    }
+
+    //! Function to retrieve the per-panel drag force factors along the panel normal.
+    /*!
+     *  Function to retrieve the per-panel drag force factors along the panel normal, equal to
+     *  A * ( 2 - normal accommodation coefficient - tangential accommodation coefficient ).
+     *  \return Per-panel drag force factors along the panel normal.
+     */
+    const Eigen::ArrayXd& getDragNormalFactors( )
+    {
+        return dragNormalFactors_;
+    }
+
+private:
+
+    //! Outward normals of the panels, in the body-fixed frame of the vehicle (one column per panel).
+    Eigen::Matrix3Xd panelNormals_;
+
+    //! Areas of the panels
+    Eigen::ArrayXd panelAreas_;
+
+    //! Specular reflectivities of the panels
+    Eigen::ArrayXd specularReflectivities_;
+
+    //! Diffuse reflectivities of the panels
+    Eigen::ArrayXd diffuseReflectivities_;
+
+    //! Normal accommodation coefficients of the panels
+    Eigen::ArrayXd normalAccommodationCoefficients_;
+
+    //! Tangential accommodation coefficients of the panels
+    Eigen::ArrayXd tangentialAccommodationCoefficients_;
+
+    //! Per-panel radiation pressure force factors along the source direction.
+    Eigen::ArrayXd radiationPressureSourceDirectionFactors_;
+
+    //! Per-panel specular radiation pressure force factors along the panel normal.
+    Eigen::ArrayXd radiationPressureSpecularNormalFactors_;
+
+    //! Per-panel diffuse radiation pressure force factors along the panel normal.
+    Eigen::ArrayXd radiationPressureDiffuseNormalFactors_;
+
+    //! Per-panel drag force factors along the flow direction.
+    Eigen::ArrayXd dragFlowDirectionFactors_;
+
+    //! Per-panel drag force factors along the panel normal.
+    Eigen::ArrayXd dragNormalFactors_;
+};
+
+//! Function to create a box-wing panelled surface model.
+/*!
+ *  Function to create a box-wing panelled surface model, consisting of a rectangular box (with faces along the
+ *  body-fixed axes) and a flat, double-sided solar array.
+ *  \param boxDimensions Dimensions of the box along the body-fixed x-, y- and z-axes.
+ *  \param solarArrayArea Area of the solar array (per side).
+ *  \param solarArrayNormal Normal of the front side of the solar array, in the body-fixed frame.
+ *  \param boxSpecularReflectivity Specular reflectivity of the faces of the box.
+ *  \param boxDiffuseReflectivity Diffuse reflectivity of the faces of the box.
+ *  \param solarArrayFrontSpecularReflectivity Specular reflectivity of the front side of the solar array.
+ *  \param solarArrayFrontDiffuseReflectivity Diffuse reflectivity of the front side of the solar array.
+ *  \param solarArrayBackSpecularReflectivity Specular reflectivity of the back side of the solar array.
+ *  \param solarArrayBackDiffuseReflectivity Diffuse reflectivity of the back side of the solar array.
+ *  \return Box-wing panelled surface model (with unit accommodation coefficients).
+ */
+PanelledSurfaceModel createBoxWingPanelledSurfaceModel(
+        const Eigen::Vector3d& boxDimensions,
+        const double solarArrayArea,
+        const Eigen::Vector3d& solarArrayNormal,
+        const double boxSpecularReflectivity,
+        const double boxDiffuseReflectivity,
+        const double solarArrayFrontSpecularReflectivity,
+        const double solarArrayFrontDiffuseReflectivity,
+        const double solarArrayBackSpecularReflectivity,
+        const double solarArrayBackDiffuseReflectivity );
+
+} // namespace system_models
+
+} // namespace tudat
+
+#endif // TUDAT_PANELLEDSURFACEMODEL_H
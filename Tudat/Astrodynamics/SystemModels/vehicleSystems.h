@@ -16,6 +16,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include "Tudat/Astrodynamics/SystemModels/engineModel.h"
+#include "Tudat/Astrodynamics/SystemModels/panelledSurfaceModel.h"
 
 namespace tudat
 {
@@ -146,6 +147,26 @@ public:
         return wallEmissivity_;
     }
 
+    //! Function to (re)set the panelled surface model of the vehicle
+    /*!
+     * Function to (re)set the panelled surface model of the vehicle
+     * \param panelledSurfaceModel The panelled surface model that is to be set
+     */
+    void setPanelledSurfaceModel( const boost::shared_ptr< PanelledSurfaceModel > panelledSurfaceModel )
+    {
+        panelledSurfaceModel_ = panelledSurfaceModel;
+    }
+
+    //! Function to retrieve the panelled surface model of the vehicle
+    /*!
+     * Function to retrieve the panelled surface model of the vehicle
+     * \return The panelled surface model of the vehicle (NULL if not set)
+     */
+    boost::shared_ptr< PanelledSurfaceModel > getPanelledSurfaceModel( )
+    {
+        return panelledSurfaceModel_;
+    }
+
 private:
 
     //! Named list of engine models in the vehicle
@@ -162,6 +183,9 @@ private:
 
     //! Wall emissivity of the vehicle (used for heating computations)
     double wallEmissivity_;
+
+    //! Panelled surface model of the vehicle (used for panelled radiation pressure and drag computations)
+    boost::shared_ptr< PanelledSurfaceModel > panelledSurfaceModel_;
 };
 
 
@@ -12,8 +12,11 @@
 
 #include <boost/format.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/unordered_map.hpp>
 
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 #include "Tudat/Basics/testMacros.h"
 #include "Tudat/Basics/timeType.h"
@@ -409,6 +412,68 @@ BOOST_AUTO_TEST_CASE( testComparisonOperators )
 }
 
 
+//! Test fixed-point representation of Time: resolution, round trips, ordering, NaN handling and hashing.
+BOOST_AUTO_TEST_CASE( testFixedPointRepresentation )
+{
+    // Check that double values are exactly recovered, also for negative values and values close to an hour.
+    std::vector< double > testValues;
+    testValues.push_back( 0.0 );
+    testValues.push_back( 0.1 );
+    testValues.push_back( -0.1 );
+    testValues.push_back( 3599.999999999999 );
+    testValues.push_back( -3599.999999999999 );
+    testValues.push_back( 1.0E9 + 0.123456789 );
+    testValues.push_back( -1.0E9 - 0.123456789 );
+    testValues.push_back( 4.0E15 + 0.5 );
+    for( unsigned int i = 0; i < testValues.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( Time( testValues.at( i ) ).getSeconds< double >( ), testValues.at( i ) );
+        BOOST_CHECK_EQUAL( Time( testValues.at( i ) ).getFullSeconds( ),
+                           static_cast< long long >( std::floor( testValues.at( i ) ) ) );
+    }
+
+    // Check that sub-femtosecond increments are retained at an epoch about 30 years from zero.
+    Time distantTime = Time( 1.0E9 );
+    Time incrementedTime = distantTime;
+    for( int i = 0; i < 1000; i++ )
+    {
+        incrementedTime += 1.0E-16;
+    }
+    BOOST_CHECK( incrementedTime > distantTime );
+    BOOST_CHECK_SMALL( static_cast< double >( incrementedTime - distantTime ) - 1.0E-13, 1.0E-16 );
+    BOOST_CHECK_EQUAL( incrementedTime.getFullSeconds( ), distantTime.getFullSeconds( ) );
+
+    // Check ordering of times where full periods and seconds into full period compare differently.
+    Time laterTime = Time( 2, 10.0L );
+    Time earlierTime = Time( 1, 3000.0L );
+    BOOST_CHECK( laterTime >= earlierTime );
+    BOOST_CHECK( earlierTime <= laterTime );
+    BOOST_CHECK( !( laterTime <= earlierTime ) );
+    BOOST_CHECK( !( earlierTime >= laterTime ) );
+
+    // Check NaN handling.
+    Time nanTime = Time( TUDAT_NAN );
+    BOOST_CHECK( nanTime.isNan( ) );
+    BOOST_CHECK( ( nanTime + 1.0 ).isNan( ) );
+    BOOST_CHECK( ( distantTime - nanTime ).isNan( ) );
+    BOOST_CHECK( ( nanTime * 2.0 ).isNan( ) );
+    BOOST_CHECK( ( nanTime / 2.0 ).isNan( ) );
+    BOOST_CHECK( !( nanTime == nanTime ) );
+    BOOST_CHECK( !( nanTime < distantTime ) );
+    BOOST_CHECK( !( nanTime >= distantTime ) );
+    BOOST_CHECK( nanTime.getSeconds< double >( ) != nanTime.getSeconds< double >( ) );
+
+    // Check that equal times hash equally, and can be used as keys of unordered containers.
+    BOOST_CHECK_EQUAL( std::hash< Time >( )( Time( 1, 1.5L ) ), std::hash< Time >( )( Time( 3601.5 ) ) );
+    boost::unordered_map< Time, int > timeMap;
+    for( int i = 0; i < 100; i++ )
+    {
+        timeMap[ distantTime + 0.1 * static_cast< double >( i ) ] = i;
+    }
+    BOOST_CHECK_EQUAL( timeMap.size( ), 100 );
+    BOOST_CHECK_EQUAL( timeMap.at( distantTime + 0.1 * 42.0 ), 42 );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 
@@ -0,0 +1,59 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <atomic>
+
+#include "Tudat/Basics/allocationAudit.h"
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+namespace
+{
+
+//! Total number of registered heap allocations (constant-initialized, so that it may be used before static
+//! initialization of the program).
+std::atomic< unsigned long long > numberOfHeapAllocations( 0 );
+
+//! Boolean denoting whether the allocation audit is active.
+std::atomic< bool > isAuditActive( false );
+
+} // namespace
+
+//! Function to register a single heap allocation in the allocation audit.
+void registerHeapAllocation( )
+{
+    numberOfHeapAllocations.fetch_add( 1, std::memory_order_relaxed );
+}
+
+//! Function to set the allocation audit to active.
+void setHeapAllocationAuditActive( )
+{
+    isAuditActive = true;
+}
+
+//! Function to check whether heap allocations are counted in the current executable.
+bool isHeapAllocationAuditActive( )
+{
+    return isAuditActive;
+}
+
+//! Function to retrieve the total number of heap allocations since the start of the program.
+unsigned long long getNumberOfHeapAllocations( )
+{
+    return numberOfHeapAllocations.load( std::memory_order_relaxed );
+}
+
+} // namespace utilities
+
+} // namespace tudat
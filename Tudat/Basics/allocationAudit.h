@@ -0,0 +1,90 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_ALLOCATIONAUDIT_H
+#define TUDAT_ALLOCATIONAUDIT_H
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Function to register a single heap allocation in the allocation audit.
+/*!
+ *  Function to register a single heap allocation in the allocation audit. This function is called by the allocation
+ *  hooks in allocationAuditHooks.cpp, and is not intended to be called directly from user code.
+ */
+void registerHeapAllocation( );
+
+//! Function to set the allocation audit to active.
+/*!
+ *  Function to set the allocation audit to active, signalling that heap allocations are registered by
+ *  registerHeapAllocation. This function is called by the allocation hooks in allocationAuditHooks.cpp upon static
+ *  initialization.
+ */
+void setHeapAllocationAuditActive( );
+
+//! Function to check whether heap allocations are counted in the current executable.
+/*!
+ *  Function to check whether heap allocations are counted in the current executable. Counting of heap allocations
+ *  (allocation audit mode) is enabled by adding the file Tudat/Basics/allocationAuditHooks.cpp to the sources of an
+ *  executable, which replaces the malloc family of functions by counting versions (supported with the GNU C library
+ *  only). If the audit is not active, the number of heap allocations retrieved by getNumberOfHeapAllocations is always 0.
+ *  \return True if heap allocations are counted, false otherwise.
+ */
+bool isHeapAllocationAuditActive( );
+
+//! Function to retrieve the total number of heap allocations since the start of the program.
+/*!
+ *  Function to retrieve the total number of heap allocations (calls to malloc, calloc and realloc, which includes all
+ *  allocations by operator new and by Eigen) since the start of the program, summed over all threads.
+ *  \return Total number of heap allocations since the start of the program (0 if the audit is not active).
+ */
+unsigned long long getNumberOfHeapAllocations( );
+
+//! Class to count the number of heap allocations in a section of code.
+/*!
+ *  Class to count the number of heap allocations in a section of code, for instance to verify that a function
+ *  evaluation does not allocate memory in steady-state. The count starts upon construction (or a call to reset), and the
+ *  number of allocations since then is retrieved by getNumberOfAllocations. Note that the allocations of all threads are
+ *  counted, and that counts are only registered if the allocation audit is active (see isHeapAllocationAuditActive).
+ */
+class HeapAllocationCounter
+{
+public:
+
+    //! Constructor, starts the count.
+    HeapAllocationCounter( ):
+        numberOfAllocationsAtStart_( getNumberOfHeapAllocations( ) ){ }
+
+    //! Function to restart the count.
+    void reset( )
+    {
+        numberOfAllocationsAtStart_ = getNumberOfHeapAllocations( );
+    }
+
+    //! Function to retrieve the number of heap allocations since construction or the last call to reset.
+    unsigned long long getNumberOfAllocations( ) const
+    {
+        return getNumberOfHeapAllocations( ) - numberOfAllocationsAtStart_;
+    }
+
+private:
+
+    //! Total number of heap allocations at the start of the count.
+    unsigned long long numberOfAllocationsAtStart_;
+};
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDAT_ALLOCATIONAUDIT_H
@@ -0,0 +1,68 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Notes
+ *      This file is not part of any Tudat library. It is added to the sources of an executable to enable the
+ *      allocation audit mode (see allocationAudit.h) for that executable only. The malloc, calloc and realloc functions
+ *      defined here take precedence over those of the C library for the complete process (including the allocations
+ *      made by shared libraries), and forward to the GNU C library implementations after registering the allocation.
+ *      On other C libraries, the file has no effect and the audit remains inactive.
+ */
+
+#include <cstddef>
+
+#include "Tudat/Basics/allocationAudit.h"
+
+#if defined( __GLIBC__ )
+
+extern "C"
+{
+
+void* __libc_malloc( size_t size );
+void* __libc_calloc( size_t numberOfElements, size_t elementSize );
+void* __libc_realloc( void* pointer, size_t size );
+
+//! Counting replacement of malloc.
+void* malloc( size_t size )
+{
+    tudat::utilities::registerHeapAllocation( );
+    return __libc_malloc( size );
+}
+
+//! Counting replacement of calloc.
+void* calloc( size_t numberOfElements, size_t elementSize )
+{
+    tudat::utilities::registerHeapAllocation( );
+    return __libc_calloc( numberOfElements, elementSize );
+}
+
+//! Counting replacement of realloc.
+void* realloc( void* pointer, size_t size )
+{
+    tudat::utilities::registerHeapAllocation( );
+    return __libc_realloc( pointer, size );
+}
+
+} // extern "C"
+
+namespace
+{
+
+//! Object that activates the allocation audit upon static initialization.
+struct HeapAllocationAuditActivator
+{
+    HeapAllocationAuditActivator( )
+    {
+        tudat::utilities::setHeapAllocationAuditActive( );
+    }
+} heapAllocationAuditActivator;
+
+} // namespace
+
+#endif
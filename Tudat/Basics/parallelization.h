@@ -0,0 +1,334 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_PARALLELIZATION_H
+#define TUDAT_PARALLELIZATION_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tudat
+{
+
+namespace utilities
+{
+
+//! Function to retrieve the number of concurrent threads supported by the hardware.
+/*!
+ *  Function to retrieve the number of concurrent threads supported by the hardware. If this number cannot be determined,
+ *  a value of 1 is returned.
+ *  \return Number of concurrent threads supported by the hardware.
+ */
+inline unsigned int getNumberOfHardwareThreads( )
+{
+    unsigned int numberOfThreads = std::thread::hardware_concurrency( );
+    return ( numberOfThreads == 0 ) ? 1 : numberOfThreads;
+}
+
+//! Function to evaluate a loop body for a range of indices, distributed over a number of threads.
+/*!
+ *  Function to evaluate a loop body for all indices in the range [0, numberOfIterations), distributed over a number of
+ *  threads. The indices are divided into contiguous blocks (one per thread), so that the order in which each thread
+ *  processes its indices is fixed. The loop body must be safe to call concurrently for different indices, i.e. it should
+ *  only write to data associated with its own index. If the loop body throws an exception for any of the indices, the
+ *  first exception (in order of thread blocks) is rethrown after all threads have finished. For a single thread (or a
+ *  single iteration), the loop is evaluated on the calling thread, without any thread being created.
+ *  \param numberOfIterations Number of iterations of the loop.
+ *  \param loopBody Function object (with unsigned int index as input) that is evaluated for each index.
+ *  \param numberOfThreads Maximum number of threads that is to be used.
+ */
+template< typename LoopBodyType >
+void executeParallelLoop( const unsigned int numberOfIterations,
+                          const LoopBodyType& loopBody,
+                          const unsigned int numberOfThreads = 1 )
+{
+    // Determine number of threads that is actually used.
+    unsigned int numberOfUsedThreads = std::min( std::max( numberOfThreads, 1U ), numberOfIterations );
+
+    if( numberOfUsedThreads <= 1 )
+    {
+        for( unsigned int i = 0; i < numberOfIterations; i++ )
+        {
+            loopBody( i );
+        }
+    }
+    else
+    {
+        std::vector< std::thread > threads;
+        std::vector< std::exception_ptr > threadExceptions( numberOfUsedThreads );
+
+        // Start a thread for each contiguous block of indices.
+        for( unsigned int threadIndex = 0; threadIndex < numberOfUsedThreads; threadIndex++ )
+        {
+            unsigned int startIndex = static_cast< unsigned int >(
+                        ( static_cast< unsigned long long >( threadIndex ) * numberOfIterations ) / numberOfUsedThreads );
+            unsigned int endIndex = static_cast< unsigned int >(
+                        ( static_cast< unsigned long long >( threadIndex + 1 ) * numberOfIterations ) / numberOfUsedThreads );
+            std::exception_ptr& currentException = threadExceptions[ threadIndex ];
+
+            threads.push_back( std::thread( [ startIndex, endIndex, &loopBody, &currentException ]( )
+            {
+                try
+                {
+                    for( unsigned int i = startIndex; i < endIndex; i++ )
+                    {
+                        loopBody( i );
+                    }
+                }
+                catch( ... )
+                {
+                    currentException = std::current_exception( );
+                }
+            } ) );
+        }
+
+        // Wait for all threads to finish.
+        for( unsigned int threadIndex = 0; threadIndex < threads.size( ); threadIndex++ )
+        {
+            threads[ threadIndex ].join( );
+        }
+
+        // Rethrow first exception that occured.
+        for( unsigned int threadIndex = 0; threadIndex < threadExceptions.size( ); threadIndex++ )
+        {
+            if( threadExceptions[ threadIndex ] )
+            {
+                std::rethrow_exception( threadExceptions[ threadIndex ] );
+            }
+        }
+    }
+}
+
+//! Class to evaluate loops over a range of indices on a persistent set of threads.
+/*!
+ *  Class to evaluate loops over a range of indices on a persistent set of threads. Contrary to the executeParallelLoop
+ *  function, the worker threads are created once (in the constructor) and joined only when the object is destroyed, so
+ *  that repeated loop evaluations (e.g. once per state derivative evaluation) do not incur the cost of creating and
+ *  joining threads. The indices are divided into the same contiguous blocks as in the executeParallelLoop function, with
+ *  the first block evaluated on the calling thread. A loop evaluation does not allocate memory. The executeParallelLoop
+ *  member function may not be called concurrently (or recursively from the loop body) for the same object.
+ */
+class ThreadPool
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor, starts the worker threads.
+     *  \param numberOfThreads Number of threads (including the calling thread) over which loops are distributed.
+     */
+    explicit ThreadPool( const unsigned int numberOfThreads ):
+        numberOfThreads_( std::max( numberOfThreads, 1U ) ),
+        blockExceptions_( numberOfThreads_ ),
+        loopBody_( NULL ),
+        blockFunction_( NULL ),
+        numberOfIterations_( 0 ),
+        numberOfBlocks_( 0 ),
+        numberOfPendingWorkers_( 0 ),
+        loopIndex_( 0 ),
+        isStopped_( false )
+    {
+        for( unsigned int threadIndex = 1; threadIndex < numberOfThreads_; threadIndex++ )
+        {
+            workerThreads_.push_back( std::thread( &ThreadPool::executeWorkerLoop, this, threadIndex ) );
+        }
+    }
+
+    //! Destructor, stops and joins the worker threads.
+    ~ThreadPool( )
+    {
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            isStopped_ = true;
+        }
+        startCondition_.notify_all( );
+
+        for( unsigned int threadIndex = 0; threadIndex < workerThreads_.size( ); threadIndex++ )
+        {
+            workerThreads_[ threadIndex ].join( );
+        }
+    }
+
+    //! Function to retrieve the number of threads (including the calling thread) over which loops are distributed.
+    /*!
+     *  Function to retrieve the number of threads (including the calling thread) over which loops are distributed.
+     *  \return Number of threads over which loops are distributed.
+     */
+    unsigned int getNumberOfThreads( ) const
+    {
+        return numberOfThreads_;
+    }
+
+    //! Function to evaluate a loop body for a range of indices, distributed over the threads of the pool.
+    /*!
+     *  Function to evaluate a loop body for all indices in the range [0, numberOfIterations), distributed over the threads
+     *  of the pool, with the same requirements on the loop body and exception handling as the executeParallelLoop
+     *  function. The function returns when all indices have been evaluated.
+     *  \param numberOfIterations Number of iterations of the loop.
+     *  \param loopBody Function object (with unsigned int index as input) that is evaluated for each index.
+     */
+    template< typename LoopBodyType >
+    void executeParallelLoop( const unsigned int numberOfIterations, const LoopBodyType& loopBody )
+    {
+        unsigned int numberOfBlocks = std::min( numberOfThreads_, numberOfIterations );
+        if( numberOfBlocks <= 1 )
+        {
+            for( unsigned int i = 0; i < numberOfIterations; i++ )
+            {
+                loopBody( i );
+            }
+            return;
+        }
+
+        // Set loop that is to be evaluated, and wake up worker threads.
+        {
+            std::lock_guard< std::mutex > lock( mutex_ );
+            loopBody_ = &loopBody;
+            blockFunction_ = &executeLoopBlock< LoopBodyType >;
+            numberOfIterations_ = numberOfIterations;
+            numberOfBlocks_ = numberOfBlocks;
+            numberOfPendingWorkers_ = workerThreads_.size( );
+            std::fill( blockExceptions_.begin( ), blockExceptions_.end( ), std::exception_ptr( ) );
+            loopIndex_++;
+        }
+        startCondition_.notify_all( );
+
+        // Evaluate first block on calling thread, and wait for worker threads to finish.
+        executeBlock( 0 );
+        {
+            std::unique_lock< std::mutex > lock( mutex_ );
+            finishCondition_.wait( lock, [ this ]( ){ return numberOfPendingWorkers_ == 0; } );
+        }
+
+        // Rethrow first exception that occured.
+        for( unsigned int blockIndex = 0; blockIndex < numberOfBlocks; blockIndex++ )
+        {
+            if( blockExceptions_[ blockIndex ] )
+            {
+                std::rethrow_exception( blockExceptions_[ blockIndex ] );
+            }
+        }
+    }
+
+private:
+
+    //! Function to evaluate a loop body (of given type) for a contiguous block of indices.
+    template< typename LoopBodyType >
+    static void executeLoopBlock( const void* loopBody, const unsigned int startIndex, const unsigned int endIndex )
+    {
+        const LoopBodyType& typedLoopBody = *static_cast< const LoopBodyType* >( loopBody );
+        for( unsigned int i = startIndex; i < endIndex; i++ )
+        {
+            typedLoopBody( i );
+        }
+    }
+
+    //! Function to evaluate the current loop for a single block of indices, storing any exception that is thrown.
+    void executeBlock( const unsigned int blockIndex )
+    {
+        if( blockIndex < numberOfBlocks_ )
+        {
+            unsigned int startIndex = static_cast< unsigned int >(
+                        ( static_cast< unsigned long long >( blockIndex ) * numberOfIterations_ ) / numberOfBlocks_ );
+            unsigned int endIndex = static_cast< unsigned int >(
+                        ( static_cast< unsigned long long >( blockIndex + 1 ) * numberOfIterations_ ) / numberOfBlocks_ );
+            try
+            {
+                blockFunction_( loopBody_, startIndex, endIndex );
+            }
+            catch( ... )
+            {
+                blockExceptions_[ blockIndex ] = std::current_exception( );
+            }
+        }
+    }
+
+    //! Function run by each worker thread: waits for a new loop, evaluates its block, and signals completion.
+    void executeWorkerLoop( const unsigned int threadIndex )
+    {
+        unsigned long long lastLoopIndex = 0;
+        while( true )
+        {
+            {
+                std::unique_lock< std::mutex > lock( mutex_ );
+                startCondition_.wait( lock, [ this, lastLoopIndex ]( ){ return isStopped_ || loopIndex_ != lastLoopIndex; } );
+                if( isStopped_ )
+                {
+                    return;
+                }
+                lastLoopIndex = loopIndex_;
+            }
+
+            executeBlock( threadIndex );
+
+            std::lock_guard< std::mutex > lock( mutex_ );
+            numberOfPendingWorkers_--;
+            if( numberOfPendingWorkers_ == 0 )
+            {
+                finishCondition_.notify_one( );
+            }
+        }
+    }
+
+    //! Copy constructor, deleted (worker threads refer to this object).
+    ThreadPool( const ThreadPool& );
+
+    //! Assignment operator, deleted (worker threads refer to this object).
+    ThreadPool& operator=( const ThreadPool& );
+
+    //! Number of threads (including the calling thread) over which loops are distributed.
+    unsigned int numberOfThreads_;
+
+    //! Worker threads (numberOfThreads_ - 1 entries), evaluating all but the first block of indices.
+    std::vector< std::thread > workerThreads_;
+
+    //! Exceptions thrown during evaluation of each block of the current loop.
+    std::vector< std::exception_ptr > blockExceptions_;
+
+    //! Loop body of the current loop (type-erased, evaluated through blockFunction_).
+    const void* loopBody_;
+
+    //! Function evaluating the current loop body for a contiguous block of indices.
+    void ( *blockFunction_ )( const void*, const unsigned int, const unsigned int );
+
+    //! Number of iterations of the current loop.
+    unsigned int numberOfIterations_;
+
+    //! Number of blocks into which the indices of the current loop are divided.
+    unsigned int numberOfBlocks_;
+
+    //! Number of worker threads that have not yet finished the current loop.
+    unsigned int numberOfPendingWorkers_;
+
+    //! Index of the current loop, incremented for each loop evaluation to wake up the worker threads.
+    unsigned long long loopIndex_;
+
+    //! Boolean denoting whether the worker threads are to be stopped.
+    bool isStopped_;
+
+    //! Mutex protecting the loop settings and counters.
+    std::mutex mutex_;
+
+    //! Condition variable on which the worker threads wait for a new loop.
+    std::condition_variable startCondition_;
+
+    //! Condition variable on which the calling thread waits for the worker threads to finish.
+    std::condition_variable finishCondition_;
+};
+
+} // namespace utilities
+
+} // namespace tudat
+
+#endif // TUDAT_PARALLELIZATION_H
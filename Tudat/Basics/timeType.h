@@ -13,6 +13,12 @@
 
 #include <cmath>
 #include <algorithm>
+#include <functional>
+#include <iostream>
+#include <limits>
+
+#include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
 
 #include <Eigen/Core>
 
@@ -23,22 +29,40 @@ namespace tudat
 
 static const long double TIME_NORMALIZATION_TERM = 3600.0L;
 
+//! Number of seconds in a full period (hour), as integer.
+static const boost::int64_t TIME_NORMALIZATION_INTEGER_TERM = 3600;
+
+//! Number of units of the fraction of a second in one second (2^64), used in the internal representation of Time.
+static const long double TIME_FRACTION_UNITS_PER_SECOND = 18446744073709551616.0L;
+
+//! Number of seconds in one unit of the fraction of a second (2^-64), used in the internal representation of Time.
+static const long double TIME_FRACTION_UNIT = 5.42101086242752217003726400434970855712890625E-20L;
+
+//! Maximum absolute number of seconds since epoch that can be represented by a Time object (about 2^62).
+static const double TIME_MAXIMUM_SECONDS = 4.6E18;
+
 //! Class for defining time with a resolution that is sub-fs for very long periods of time.
 /*!
  *  Class for defining time with a resolution that is sub-fs for very long periods of time. Using double or long double
  *  precision as a representation of time, the issue of reduced quality will occur that over long time-period. For instance,
  *  over a period of 10^8 seconds (about 3 years), double and long double representations have resolution of about 10^-8 and
- *  10^-11 s respectively, which is insufficient for various applications. This type uses an int to represent the number of
- *  hours since an epoch, and long double to represent the number of seconds into the present hour. This provides a
- *  resulution of < 1 femtosecond, over a range of 2147483647 hours (about 300,000 years), which is more than sufficient for
- *  practical applications.
+ *  10^-11 s respectively, which is insufficient for various applications. This type uses a 64-bit integer to represent the
+ *  number of full seconds since an epoch, and a 64-bit unsigned integer to represent the fraction of the present second, in
+ *  units of 2^-64 s. This provides a fixed resolution of about 5.4E-20 s over a range of 2^62 seconds (about 10^11 years),
+ *  which is more than sufficient for practical applications.
+ *  Since the representation is fixed-point, addition, subtraction and comparison of Time objects are exact integer
+ *  operations with constant cost, and no renormalization is required. Conversions to and from double precision are
+ *  performed without extended precision arithmetic; the decomposition into full hours and seconds into the current hour
+ *  (see getFullPeriods and getSecondsIntoFullPeriod) is computed on request. A Time object constructed from a NaN (or
+ *  from a value that is out of range) is NaN: it compares unequal to any time (including itself), and propagates through
+ *  arithmetic operations.
  */
 class Time
 {
 public:
 
     //! Constructor, initialize time to 0
-    Time( ):fullPeriods_( 0 ), secondsIntoFullPeriod_( 0.0L ){ }
+    Time( ):fullSeconds_( 0 ), secondFraction_( 0 ){ }
 
     //! Constructor, sets current hour and time into current hour directly
     /*!
@@ -48,10 +72,13 @@ public:
      * between 0 and 3600: the time representation is normalized upon construction to ensure that the internal representation
      * is in this range.
      */
-    Time( const int fullPeriods, const long double secondsIntoFullPeriod ):
-        fullPeriods_( fullPeriods ), secondsIntoFullPeriod_( secondsIntoFullPeriod )
+    Time( const int fullPeriods, const long double secondsIntoFullPeriod )
     {
-        normalizeMembers( );
+        setSeconds( secondsIntoFullPeriod );
+        if( !isNan( ) )
+        {
+            fullSeconds_ += static_cast< boost::int64_t >( fullPeriods ) * TIME_NORMALIZATION_INTEGER_TERM;
+        }
     }
 
     //! Constructor, sets number of seconds sicne epoch (with long double representation as input)
@@ -59,10 +86,9 @@ public:
      * Constructor, sets number of seconds sicne epoch (with long double representation as input)
      * \param numberOfSeconds Number of seconds since epoch.
      */
-    Time( const long double numberOfSeconds ):
-        fullPeriods_( 0 ), secondsIntoFullPeriod_( numberOfSeconds )
+    Time( const long double numberOfSeconds )
     {
-        normalizeMembers( );
+        setSeconds( numberOfSeconds );
     }
 
     //! Constructor, sets number of seconds sicne epoch (with double representation as input)
@@ -70,10 +96,9 @@ public:
      * Constructor, sets number of seconds sicne epoch (with double representation as input)
      * \param secondsIntoFullPeriod Number of seconds since epoch.
      */
-    Time( const double secondsIntoFullPeriod ):
-        fullPeriods_( 0 ), secondsIntoFullPeriod_( static_cast< long double >( secondsIntoFullPeriod ) )
+    Time( const double secondsIntoFullPeriod )
     {
-        normalizeMembers( );
+        setSeconds( secondsIntoFullPeriod );
     }
 
     //! Constructor, sets number of seconds sicne epoch (with int representation as input)
@@ -82,43 +107,7 @@ public:
      * \param secondsIntoFullPeriod Number of seconds since epoch.
      */
     Time( const int secondsIntoFullPeriod ):
-        fullPeriods_( 0 ), secondsIntoFullPeriod_( static_cast< long double >( secondsIntoFullPeriod ) )
-    {
-        normalizeMembers( );
-    }
-
-    //! Copy constructor
-    /*!
-     * Copy constructor
-     * \param otherTime Time that is to be copied.
-     */
-    Time( const Time& otherTime ):
-        fullPeriods_( otherTime.fullPeriods_ ), secondsIntoFullPeriod_( otherTime.secondsIntoFullPeriod_ )
-    {
-        normalizeMembers( );
-    }
-
-    //! Definition of = operator for Time type
-    /*!
-     * Definition of = operator for Time type
-     * \param timeToCopy Time that is to be copied by operator
-     * \return Assigned Time object
-     */
-    Time& operator=( const Time& timeToCopy )
-    {
-        if( this == &timeToCopy )
-        {
-            return *this;
-        }
-        else
-        {
-            secondsIntoFullPeriod_ = timeToCopy.secondsIntoFullPeriod_;
-            fullPeriods_ = timeToCopy.fullPeriods_;
-            normalizeMembers( );
-            return *this;
-        }
-    }
-
+        fullSeconds_( static_cast< boost::int64_t >( secondsIntoFullPeriod ) ), secondFraction_( 0 ){ }
 
     //! Addition operator for two Time objects
     /*!
@@ -129,8 +118,9 @@ public:
      */
     friend Time operator+( const Time& timeToAdd1, const Time& timeToAdd2 )
     {
-        return Time( timeToAdd1.fullPeriods_ + timeToAdd2.fullPeriods_,
-                     timeToAdd1.secondsIntoFullPeriod_ + timeToAdd2.secondsIntoFullPeriod_ );
+        Time addedTime = timeToAdd1;
+        addedTime += timeToAdd2;
+        return addedTime;
     }
 
     //! Addition operator for double variable with Time object.
@@ -142,7 +132,7 @@ public:
      */
     friend Time operator+( const double& timeToAdd1, const Time& timeToAdd2 )
     {
-        return Time( timeToAdd2.fullPeriods_, timeToAdd2.secondsIntoFullPeriod_ + static_cast< long double >( timeToAdd1 ) );
+        return timeToAdd2 + Time( timeToAdd1 );
     }
 
     //! Addition operator for long double variable with Time object.
@@ -154,7 +144,7 @@ public:
      */
     friend  Time operator+( const long double& timeToAdd1, const Time& timeToAdd2 )
     {
-        return Time( timeToAdd2.fullPeriods_, timeToAdd2.secondsIntoFullPeriod_ + timeToAdd1 );
+        return timeToAdd2 + Time( timeToAdd1 );
     }
 
     //! Addition operator for Time object with double variable
@@ -192,9 +182,9 @@ public:
      */
     friend Time operator-( const Time& timeToSubtract1, const Time& timeToSubtract2 )
     {
-
-        return Time( timeToSubtract1.fullPeriods_ - timeToSubtract2.fullPeriods_,
-                     timeToSubtract1.secondsIntoFullPeriod_ - timeToSubtract2.secondsIntoFullPeriod_ );
+        Time subtractedTime = timeToSubtract1;
+        subtractedTime -= timeToSubtract2;
+        return subtractedTime;
     }
 
     //! Subtraction operator for double from Time object
@@ -206,8 +196,7 @@ public:
      */
     friend Time operator-( const Time& timeToSubtract1, const double timeToSubtract2 )
     {
-        return Time( timeToSubtract1.fullPeriods_,
-                     timeToSubtract1.secondsIntoFullPeriod_ - static_cast< long double >( timeToSubtract2 ) );
+        return timeToSubtract1 - Time( timeToSubtract2 );
     }
 
     //! Subtraction operator for double from Time object
@@ -219,7 +208,7 @@ public:
      */
     friend Time operator-( const Time& timeToSubtract1, const long double timeToSubtract2 )
     {
-        return Time( timeToSubtract1.fullPeriods_, timeToSubtract1.secondsIntoFullPeriod_ - timeToSubtract2 );
+        return timeToSubtract1 - Time( timeToSubtract2 );
     }
 
     //! Subtraction operator for Time object from double
@@ -231,8 +220,7 @@ public:
      */
     friend Time operator-( const double timeToSubtract1, const Time& timeToSubtract2 )
     {
-        return Time( -timeToSubtract2.fullPeriods_,
-                     static_cast< long double >( timeToSubtract1 ) - timeToSubtract2.secondsIntoFullPeriod_ );
+        return Time( timeToSubtract1 ) - timeToSubtract2;
     }
 
     //! Subtraction operator for Time object from long double
@@ -244,27 +232,31 @@ public:
      */
     friend Time operator-( const long double timeToSubtract1, const Time& timeToSubtract2 )
     {
-        return Time( -timeToSubtract2.fullPeriods_, timeToSubtract1 - timeToSubtract2.secondsIntoFullPeriod_ );
+        return Time( timeToSubtract1 ) - timeToSubtract2;
     }
 
 
     //! Multiplication operator of a long double with a Time object (i.e. to rescale time)
     /*!
-     * Multiplication operator of a long double with a Time object (i.e. to rescale time)
+     * Multiplication operator of a long double with a Time object (i.e. to rescale time). The full seconds and the
+     * fraction of a second are multiplied separately, in long double precision.
      * \param timeToMultiply1 Value by which Time is to be multiplied
      * \param timeToMultiply2 Time that is to be multiplied by first input argument
      * \return Multiplied Time object.
      */
     friend Time operator*( const long double timeToMultiply1, const Time& timeToMultiply2 )
     {
-        long double newPeriods = timeToMultiply1 * static_cast< long double >( timeToMultiply2.fullPeriods_ );
-        long double roundedNewPeriods = static_cast< long double >( std::floor( newPeriods ) );
-
-        int newfullPeriods = static_cast< int >( std::round( roundedNewPeriods ) );
-        long double newSecondsIntoFullPeriod_ = timeToMultiply2.secondsIntoFullPeriod_ * timeToMultiply1;
-        newSecondsIntoFullPeriod_ += ( newPeriods - roundedNewPeriods ) * TIME_NORMALIZATION_TERM;
-
-        return Time( newfullPeriods, newSecondsIntoFullPeriod_ );
+        Time multipliedTime;
+        if( timeToMultiply2.isNan( ) )
+        {
+            multipliedTime.setNan( );
+        }
+        else
+        {
+            multipliedTime = Time( static_cast< long double >( timeToMultiply2.fullSeconds_ ) * timeToMultiply1 );
+            multipliedTime += Time( timeToMultiply2.getSecondFraction< long double >( ) * timeToMultiply1 );
+        }
+        return multipliedTime;
     }
 
     //! Multiplication operator of a long double with a Time object (i.e. to rescale time)
@@ -288,16 +280,7 @@ public:
      */
     friend Time operator*( const double timeToMultiply1, const Time& timeToMultiply2 )
     {
-        long double newPeriods = static_cast< long double >( timeToMultiply1 ) *
-                static_cast< long double >( timeToMultiply2.fullPeriods_ );
-        long double roundedNewPeriods = std::floor( newPeriods );
-
-        int newfullPeriods = static_cast< int >( std::round( roundedNewPeriods ) );
-        long double newSecondsIntoFullPeriod_ = timeToMultiply2.secondsIntoFullPeriod_ *
-                static_cast< long double >( timeToMultiply1 );
-        newSecondsIntoFullPeriod_ += ( newPeriods - roundedNewPeriods ) * TIME_NORMALIZATION_TERM;
-
-        return Time( newfullPeriods, newSecondsIntoFullPeriod_ );
+        return static_cast< long double >( timeToMultiply1 ) * timeToMultiply2;
     }
 
     //! Multiplication operator of a double with a Time object (i.e. to rescale time)
@@ -321,38 +304,41 @@ public:
      */
     friend const Time operator/( const Time& original, const double doubleToDivideBy )
     {
-        long double newPeriods =  static_cast< long double >( original.fullPeriods_ ) /
-                static_cast< long double >( doubleToDivideBy );
-
-        long double roundedNewPeriods = std::floor( newPeriods );
-
-        int newfullPeriods = static_cast< int >( std::round( roundedNewPeriods ) );
-        long double newSecondsIntoFullPeriod_ = original.secondsIntoFullPeriod_ /
-                static_cast< long double >( doubleToDivideBy );
-        newSecondsIntoFullPeriod_ += ( newPeriods - roundedNewPeriods ) * TIME_NORMALIZATION_TERM;
-
-        return Time( newfullPeriods, newSecondsIntoFullPeriod_ );
+        return original / static_cast< long double >( doubleToDivideBy );
     }
 
 
     //! Division operator of a Time object with a long double (i.e. to rescale time)
     /*!
-     * Division operator of a Time object with a long double (i.e. to rescale time)
+     * Division operator of a Time object with a long double (i.e. to rescale time). If the divisor is an integer, the
+     * number of full seconds is divided exactly in integer arithmetic, and only the remainder is divided in long double
+     * precision.
      * \param original Time that is to be divided by second input argument
      * \param doubleToDivideBy Value by which first argument is to be divided.
      * \return Divided Time object.
      */
     friend const Time operator/( const Time& original, const long double doubleToDivideBy )
     {
-        long double newPeriods =  static_cast< long double >( original.fullPeriods_ ) / doubleToDivideBy;
-
-        long double roundedNewPeriods = std::floor( newPeriods );
-
-        int newfullPeriods = static_cast< int >( std::round( roundedNewPeriods ) );
-        long double newSecondsIntoFullPeriod_ = original.secondsIntoFullPeriod_ /  doubleToDivideBy;
-        newSecondsIntoFullPeriod_ += ( newPeriods - roundedNewPeriods ) * TIME_NORMALIZATION_TERM;
-
-        return Time( newfullPeriods, newSecondsIntoFullPeriod_ );
+        Time dividedTime;
+        if( original.isNan( ) )
+        {
+            dividedTime.setNan( );
+        }
+        else if( std::fabs( doubleToDivideBy ) < TIME_MAXIMUM_SECONDS &&
+                static_cast< long double >( static_cast< boost::int64_t >( doubleToDivideBy ) ) == doubleToDivideBy &&
+                doubleToDivideBy != 0.0L )
+        {
+            const boost::int64_t integerDivisor = static_cast< boost::int64_t >( doubleToDivideBy );
+            dividedTime.fullSeconds_ = original.fullSeconds_ / integerDivisor;
+            dividedTime += Time( ( static_cast< long double >( original.fullSeconds_ % integerDivisor ) +
+                                   original.getSecondFraction< long double >( ) ) / doubleToDivideBy );
+        }
+        else
+        {
+            dividedTime = Time( static_cast< long double >( original.fullSeconds_ ) / doubleToDivideBy );
+            dividedTime += Time( original.getSecondFraction< long double >( ) / doubleToDivideBy );
+        }
+        return dividedTime;
     }
 
 
@@ -363,9 +349,17 @@ public:
      */
     void operator+=( const Time& timeToAdd )
     {
-        fullPeriods_ += timeToAdd.fullPeriods_;
-        secondsIntoFullPeriod_ += timeToAdd.secondsIntoFullPeriod_;
-        normalizeMembers( );
+        if( isNan( ) || timeToAdd.isNan( ) )
+        {
+            setNan( );
+        }
+        else
+        {
+            // Add fractions of seconds, and carry full second in case of overflow.
+            const boost::uint64_t previousSecondFraction = secondFraction_;
+            secondFraction_ += timeToAdd.secondFraction_;
+            fullSeconds_ += timeToAdd.fullSeconds_ + ( secondFraction_ < previousSecondFraction ? 1 : 0 );
+        }
     }
 
     //! Add and assign operator for adding a double
@@ -375,8 +369,7 @@ public:
      */
     void operator+=( const double timeToAdd )
     {
-        secondsIntoFullPeriod_ += static_cast< long double >( timeToAdd );
-        normalizeMembers( );
+        operator+=( Time( timeToAdd ) );
     }
 
     //! Add and assign operator for adding a double
@@ -386,8 +379,7 @@ public:
      */
     void operator+=( const long double timeToAdd )
     {
-        secondsIntoFullPeriod_ += timeToAdd;
-        normalizeMembers( );
+        operator+=( Time( timeToAdd ) );
     }
 
     //! Subtract and assign operator for adding a Time
@@ -397,9 +389,17 @@ public:
      */
     void operator-=( const Time& timeToSubtract )
     {
-        fullPeriods_ -= timeToSubtract.fullPeriods_;
-        secondsIntoFullPeriod_ -= timeToSubtract.secondsIntoFullPeriod_;
-        normalizeMembers( );
+        if( isNan( ) || timeToSubtract.isNan( ) )
+        {
+            setNan( );
+        }
+        else
+        {
+            // Subtract fractions of seconds, and borrow full second in case of underflow.
+            const boost::uint64_t previousSecondFraction = secondFraction_;
+            secondFraction_ -= timeToSubtract.secondFraction_;
+            fullSeconds_ -= timeToSubtract.fullSeconds_ + ( secondFraction_ > previousSecondFraction ? 1 : 0 );
+        }
     }
 
     //! Subtract and assign operator for adding a double
@@ -409,8 +409,7 @@ public:
      */
     void operator-=( const double timeToSubtract )
     {
-        secondsIntoFullPeriod_ -= static_cast< long double >( timeToSubtract );
-        normalizeMembers( );
+        operator-=( Time( timeToSubtract ) );
     }
 
     //! Subtract and assign operator for adding a long double
@@ -420,8 +419,7 @@ public:
      */
     void operator-=( const long double timeToSubtract )
     {
-        secondsIntoFullPeriod_ -= timeToSubtract;
-        normalizeMembers( );
+        operator-=( Time( timeToSubtract ) );
     }
 
     //! Multiply and assign operator for multiplying by double
@@ -431,14 +429,7 @@ public:
      */
     void operator*=( const double timeToMultiply )
     {
-        long double newPeriods = static_cast< long double >( timeToMultiply ) * static_cast< long double >( fullPeriods_ );
-        long double roundedNewPeriods = std::floor( newPeriods );
-
-        fullPeriods_ = static_cast< int >( std::round( roundedNewPeriods ) );
-        secondsIntoFullPeriod_ *= static_cast< long double >( timeToMultiply );
-        secondsIntoFullPeriod_ += ( newPeriods - roundedNewPeriods ) * TIME_NORMALIZATION_TERM;
-
-        normalizeMembers( );
+        *this = timeToMultiply * *this;
     }
 
     //! Multiply and assign operator for multiplying by long double
@@ -448,14 +439,7 @@ public:
      */
     void operator*=( const long double timeToMultiply )
     {
-        long double newPeriods = timeToMultiply * static_cast< long double >( fullPeriods_ );
-        long double roundedNewPeriods = std::floor( newPeriods );
-
-        fullPeriods_ = static_cast< int >( std::round( roundedNewPeriods ) );
-        secondsIntoFullPeriod_ *= timeToMultiply;
-        secondsIntoFullPeriod_ += ( newPeriods - roundedNewPeriods ) * TIME_NORMALIZATION_TERM;
-
-        normalizeMembers( );
+        *this = timeToMultiply * *this;
     }
 
     //! Divided and assign operator for dividing by double
@@ -465,14 +449,7 @@ public:
      */
     void operator/=( const double timeToDivide )
     {
-        long double newPeriods = static_cast< long double >( timeToDivide ) / static_cast< long double >( fullPeriods_ );
-        long double roundedNewPeriods = std::floor( newPeriods );
-
-        fullPeriods_ = static_cast< int >( std::round( roundedNewPeriods ) );
-        secondsIntoFullPeriod_ *= timeToDivide;
-        secondsIntoFullPeriod_ += ( newPeriods - roundedNewPeriods );
-
-        normalizeMembers( );
+        *this = *this / timeToDivide;
     }
 
     //! Divided and assign operator for dividing by long double
@@ -482,14 +459,7 @@ public:
      */
     void operator/=( const long double timeToDivide )
     {
-        long double newPeriods = timeToDivide / static_cast< long double >( fullPeriods_ );
-        long double roundedNewPeriods = std::floor( newPeriods );
-
-        fullPeriods_ = static_cast< int >( std::round( roundedNewPeriods ) );
-        secondsIntoFullPeriod_ *= timeToDivide;
-        secondsIntoFullPeriod_ += ( newPeriods - roundedNewPeriods );
-
-        normalizeMembers( );
+        *this = *this / timeToDivide;
     }
 
 
@@ -502,8 +472,9 @@ public:
      */
     friend bool operator==( const Time& timeToCompare1, const Time& timeToCompare2 )
     {
-        return ( ( timeToCompare1.getFullPeriods( ) == timeToCompare2.getFullPeriods( ) ) &&
-                 ( timeToCompare1.getSecondsIntoFullPeriod( ) == timeToCompare2.getSecondsIntoFullPeriod( ) ) );
+        return ( ( timeToCompare1.fullSeconds_ == timeToCompare2.fullSeconds_ ) &&
+                 ( timeToCompare1.secondFraction_ == timeToCompare2.secondFraction_ ) &&
+                 !timeToCompare1.isNan( ) );
     }
 
     //! Inequality operator for two Time objects
@@ -631,19 +602,7 @@ public:
      */
     friend bool operator> ( const Time& timeToCompare1, const Time& timeToCompare2 )
     {
-        if( timeToCompare1.getFullPeriods( ) > timeToCompare2.getFullPeriods( ) )
-        {
-            return true;
-        }
-        else if( ( timeToCompare1.getFullPeriods( ) == timeToCompare2.getFullPeriods( ) ) &&
-                 ( timeToCompare1.getSecondsIntoFullPeriod( ) > timeToCompare2.getSecondsIntoFullPeriod( ) ) )
-        {
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        return timeToCompare2 < timeToCompare1;
     }
 
     //! Greater-than-or-equal-to operator for two Time objects
@@ -655,19 +614,7 @@ public:
      */
     friend bool operator>= ( const Time& timeToCompare1, const Time& timeToCompare2 )
     {
-        if( timeToCompare1.getFullPeriods( ) >= timeToCompare2.getFullPeriods( ) )
-        {
-            return true;
-        }
-        else if( ( timeToCompare1.getFullPeriods( ) == timeToCompare2.getFullPeriods( ) ) &&
-                 ( timeToCompare1.getSecondsIntoFullPeriod( ) >= timeToCompare2.getSecondsIntoFullPeriod( ) ) )
-        {
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        return timeToCompare2 <= timeToCompare1;
     }
 
     //! Smaller-than operator for two Time objects
@@ -679,19 +626,11 @@ public:
      */
     friend bool operator< ( const Time& timeToCompare1, const Time& timeToCompare2 )
     {
-        if( timeToCompare1.getFullPeriods( ) < timeToCompare2.getFullPeriods( ) )
-        {
-            return true;
-        }
-        else if( ( timeToCompare1.getFullPeriods( ) == timeToCompare2.getFullPeriods( ) ) &&
-                 ( timeToCompare1.getSecondsIntoFullPeriod( ) < timeToCompare2.getSecondsIntoFullPeriod( ) ) )
-        {
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        // NaN is represented by the smallest number of full seconds, so that only the first argument is checked.
+        return ( ( timeToCompare1.fullSeconds_ < timeToCompare2.fullSeconds_ ) ||
+                 ( ( timeToCompare1.fullSeconds_ == timeToCompare2.fullSeconds_ ) &&
+                   ( timeToCompare1.secondFraction_ < timeToCompare2.secondFraction_ ) ) ) &&
+                !timeToCompare1.isNan( );
     }
 
     //! Smaller-than-or-equal-to operator for two Time objects
@@ -703,19 +642,10 @@ public:
      */
     friend bool operator<= ( const Time& timeToCompare1, const Time& timeToCompare2 )
     {
-        if( timeToCompare1.getFullPeriods( ) <= timeToCompare2.getFullPeriods( ) )
-        {
-            return true;
-        }
-        else if( ( timeToCompare1.getFullPeriods( ) == timeToCompare2.getFullPeriods( ) ) &&
-                 ( timeToCompare1.getSecondsIntoFullPeriod( ) <= timeToCompare2.getSecondsIntoFullPeriod( ) ) )
-        {
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        return ( ( timeToCompare1.fullSeconds_ < timeToCompare2.fullSeconds_ ) ||
+                 ( ( timeToCompare1.fullSeconds_ == timeToCompare2.fullSeconds_ ) &&
+                   ( timeToCompare1.secondFraction_ <= timeToCompare2.secondFraction_ ) ) ) &&
+                !timeToCompare1.isNan( ) && !timeToCompare2.isNan( );
     }
 
         //! Smaller-than operator for Time object with double
@@ -917,6 +847,21 @@ public:
         return stream;
     }
 
+    //! Function to compute the hash value of a Time object
+    /*!
+     *  Function to compute the hash value of a Time object, from its (exact) internal representation, so that Time can be
+     *  used as key in unordered (hashed) containers, such as boost::unordered_map and std::unordered_map.
+     *  \param timeToHash Time for which the hash value is to be computed
+     *  \return Hash value of Time
+     */
+    friend std::size_t hash_value( const Time& timeToHash )
+    {
+        std::size_t hashValue = 0;
+        boost::hash_combine( hashValue, timeToHash.fullSeconds_ );
+        boost::hash_combine( hashValue, timeToHash.secondFraction_ );
+        return hashValue;
+    }
+
     //! Function to get the total seconds since epoch, in templated precision
     /*!
      *  Function to get the total seconds since epoch, in templated precision
@@ -925,8 +870,9 @@ public:
     template< typename ScalarType >
     ScalarType getSeconds( ) const
     {
-        return static_cast< ScalarType >(
-                    static_cast< long double >( fullPeriods_ ) * TIME_NORMALIZATION_TERM + secondsIntoFullPeriod_ );
+        ScalarType numberOfSeconds;
+        computeSeconds( numberOfSeconds );
+        return numberOfSeconds;
     }
 
     //! Function to get the total seconds since epoch, in int precision (cast of Time to int)
@@ -966,7 +912,12 @@ public:
      */
     int getFullPeriods( ) const
     {
-        return fullPeriods_;
+        boost::int64_t fullPeriods = fullSeconds_ / TIME_NORMALIZATION_INTEGER_TERM;
+        if( fullSeconds_ % TIME_NORMALIZATION_INTEGER_TERM < 0 )
+        {
+            fullPeriods--;
+        }
+        return static_cast< int >( fullPeriods );
     }
 
     //! Function to get the number of seconds into current hour
@@ -976,32 +927,188 @@ public:
      */
     long double getSecondsIntoFullPeriod( ) const
     {
-        return secondsIntoFullPeriod_;
+        if( isNan( ) )
+        {
+            return std::numeric_limits< long double >::quiet_NaN( );
+        }
+        return static_cast< long double >(
+                    fullSeconds_ - static_cast< boost::int64_t >( getFullPeriods( ) ) * TIME_NORMALIZATION_INTEGER_TERM ) +
+                getSecondFraction< long double >( );
+    }
+
+    //! Function to get the number of full seconds since epoch
+    /*!
+     * Function to get the number of full seconds since epoch (i.e. the total number of seconds, rounded down).
+     * \return Number of full seconds since epoch
+     */
+    boost::int64_t getFullSeconds( ) const
+    {
+        return fullSeconds_;
+    }
+
+    //! Function to get the fraction of the current second, in templated precision
+    /*!
+     * Function to get the fraction of the current second (between 0 and 1), in templated precision
+     * \return Fraction of the current second
+     */
+    template< typename ScalarType >
+    ScalarType getSecondFraction( ) const
+    {
+        return static_cast< ScalarType >( static_cast< long double >( secondFraction_ ) * TIME_FRACTION_UNIT );
+    }
+
+    //! Function to check whether the Time object is NaN
+    /*!
+     * Function to check whether the Time object is NaN, i.e. whether it was created from a NaN (or out-of-range) value,
+     * or from an arithmetic operation involving a NaN Time.
+     * \return True if Time object is NaN, false otherwise.
+     */
+    bool isNan( ) const
+    {
+        return fullSeconds_ == std::numeric_limits< boost::int64_t >::min( );
     }
 
 protected:
-    //! Function to renormalize the members of the Time object, so that secondsIntoFullPeriod_ is between 0 and 3600
-    void normalizeMembers( )
+
+    //! Function to set the members of the Time object from a number of seconds (in double precision)
+    /*!
+     * Function to set the members of the Time object from a number of seconds (in double precision). The conversion is
+     * exact, except for the truncation of values with a resolution below that of the fraction of a second.
+     * \param numberOfSeconds Number of seconds since epoch
+     */
+    void setSeconds( const double numberOfSeconds )
+    {
+        if( !( std::fabs( numberOfSeconds ) < TIME_MAXIMUM_SECONDS ) )
+        {
+            setNan( );
+        }
+        else
+        {
+            // Truncate to full seconds, and compute (exact) remaining fraction of a second, scaled to fraction units.
+            fullSeconds_ = static_cast< boost::int64_t >( numberOfSeconds );
+            const double scaledSecondFraction = ( numberOfSeconds - static_cast< double >( fullSeconds_ ) ) *
+                    static_cast< double >( TIME_FRACTION_UNITS_PER_SECOND );
+            if( scaledSecondFraction >= 0.0 )
+            {
+                secondFraction_ = static_cast< boost::uint64_t >( scaledSecondFraction );
+            }
+            else
+            {
+                // For negative fraction, borrow a full second (fraction becomes 2^64 minus the absolute fraction).
+                secondFraction_ = static_cast< boost::uint64_t >( -scaledSecondFraction );
+                if( secondFraction_ != 0 )
+                {
+                    secondFraction_ = ~secondFraction_ + 1;
+                    fullSeconds_--;
+                }
+            }
+        }
+    }
+
+    //! Function to set the members of the Time object from a number of seconds (in long double precision)
+    /*!
+     * Function to set the members of the Time object from a number of seconds (in long double precision). The input is
+     * split into two double precision numbers (which is exact), which are then converted separately, to limit the use of
+     * extended precision arithmetic.
+     * \param numberOfSeconds Number of seconds since epoch
+     */
+    void setSeconds( const long double numberOfSeconds )
     {
-        if( secondsIntoFullPeriod_ < 0.0L || secondsIntoFullPeriod_ >= TIME_NORMALIZATION_TERM )
+        const double leadingNumberOfSeconds = static_cast< double >( numberOfSeconds );
+        setSeconds( leadingNumberOfSeconds );
+
+        const double remainingNumberOfSeconds =
+                static_cast< double >( numberOfSeconds - static_cast< long double >( leadingNumberOfSeconds ) );
+        if( remainingNumberOfSeconds != 0.0 )
         {
-            basic_mathematics::computeModuloAndRemainder< long double >(
-                        secondsIntoFullPeriod_,TIME_NORMALIZATION_TERM, secondsIntoFullPeriod_, daysToAdd );
-            fullPeriods_ += daysToAdd;
+            operator+=( Time( remainingNumberOfSeconds ) );
         }
     }
 
-    //! Pre-declared variable used in often-called normalizeMembers function
-    int daysToAdd;
+    //! Function to compute the total seconds since epoch, in templated precision
+    /*!
+     *  Function to compute the total seconds since epoch, in templated precision, by casting the long double value.
+     *  \param numberOfSeconds Total seconds since epoch (returned by reference).
+     */
+    template< typename ScalarType >
+    void computeSeconds( ScalarType& numberOfSeconds ) const
+    {
+        numberOfSeconds = static_cast< ScalarType >( getSeconds< long double >( ) );
+    }
 
-    //! Number of full hours since epoch
-    int fullPeriods_;
+    //! Function to compute the total seconds since epoch, in double precision
+    /*!
+     *  Function to compute the total seconds since epoch, in double precision. Computed directly in double precision,
+     *  with the full seconds and fraction of a second added with consistent sign, so that conversion of a double to a
+     *  Time and back is exact.
+     *  \param numberOfSeconds Total seconds since epoch (returned by reference).
+     */
+    void computeSeconds( double& numberOfSeconds ) const
+    {
+        if( isNan( ) )
+        {
+            numberOfSeconds = std::numeric_limits< double >::quiet_NaN( );
+        }
+        else if( fullSeconds_ >= 0 || secondFraction_ == 0 )
+        {
+            numberOfSeconds = static_cast< double >( fullSeconds_ ) +
+                    static_cast< double >( secondFraction_ ) * static_cast< double >( TIME_FRACTION_UNIT );
+        }
+        else
+        {
+            numberOfSeconds = -( static_cast< double >( -( fullSeconds_ + 1 ) ) +
+                                 static_cast< double >( ~secondFraction_ + 1 ) *
+                                 static_cast< double >( TIME_FRACTION_UNIT ) );
+        }
+    }
 
-    //! Number of seconds into current hour
-    long double secondsIntoFullPeriod_;
+    //! Function to compute the total seconds since epoch, in long double precision
+    /*!
+     *  Function to compute the total seconds since epoch, in long double precision
+     *  \param numberOfSeconds Total seconds since epoch (returned by reference).
+     */
+    void computeSeconds( long double& numberOfSeconds ) const
+    {
+        if( isNan( ) )
+        {
+            numberOfSeconds = std::numeric_limits< long double >::quiet_NaN( );
+        }
+        else
+        {
+            numberOfSeconds = static_cast< long double >( fullSeconds_ ) + getSecondFraction< long double >( );
+        }
+    }
+
+    //! Function to set the Time object to NaN
+    void setNan( )
+    {
+        fullSeconds_ = std::numeric_limits< boost::int64_t >::min( );
+        secondFraction_ = 0;
+    }
+
+    //! Number of full seconds since epoch
+    boost::int64_t fullSeconds_;
+
+    //! Fraction of current second, in units of 2^-64 seconds
+    boost::uint64_t secondFraction_;
 
 };
 
 } // namespace tudat
 
+namespace std
+{
+
+//! Hash function for Time, to allow its use as key in std::unordered_map and std::unordered_set.
+template< >
+struct hash< tudat::Time >
+{
+    std::size_t operator( )( const tudat::Time& timeToHash ) const
+    {
+        return hash_value( timeToHash );
+    }
+};
+
+} // namespace std
+
 #endif // TUDAT_TIMETYPE_H
@@ -0,0 +1,71 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/InputOutput/memoryMappedFile.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_memory_mapped_file )
+
+//! Test mapping of entire file, of the first part of a file, and of an empty file.
+BOOST_AUTO_TEST_CASE( testMemoryMappedFile )
+{
+    const std::string filePath =
+            ( boost::filesystem::temp_directory_path( ) / boost::filesystem::unique_path( ) ).string( );
+    const std::string fileContents = "1 2 3\r\n4 5 6\n";
+    {
+        std::ofstream fileStream( filePath.c_str( ), std::ios::binary );
+        fileStream << fileContents;
+    }
+
+    {
+        const input_output::MemoryMappedFile mappedFile( filePath );
+        BOOST_CHECK_EQUAL( mappedFile.size( ), fileContents.size( ) );
+        BOOST_CHECK_EQUAL( std::string( mappedFile.data( ), mappedFile.size( ) ), fileContents );
+
+        const input_output::MemoryMappedFile partiallyMappedFile( filePath, 5 );
+        BOOST_CHECK_EQUAL( partiallyMappedFile.size( ), 5 );
+        BOOST_CHECK_EQUAL( std::string( partiallyMappedFile.data( ), partiallyMappedFile.size( ) ), "1 2 3" );
+
+        BOOST_CHECK_THROW( input_output::MemoryMappedFile tooLongMappedFile( filePath, fileContents.size( ) + 1 ),
+                           std::runtime_error );
+    }
+
+    // Check that an empty file results in an empty range.
+    {
+        std::ofstream fileStream( filePath.c_str( ), std::ios::binary | std::ios::trunc );
+    }
+    {
+        const input_output::MemoryMappedFile mappedFile( filePath );
+        BOOST_CHECK_EQUAL( mappedFile.size( ), 0 );
+        BOOST_CHECK( mappedFile.data( ) == NULL );
+    }
+    boost::filesystem::remove( filePath );
+
+    // Check that a nonexistent file is rejected.
+    BOOST_CHECK_THROW( input_output::MemoryMappedFile nonexistentFile( filePath ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
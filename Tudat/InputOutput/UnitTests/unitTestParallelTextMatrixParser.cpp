@@ -0,0 +1,236 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/InputOutput/matrixTextFileReader.h"
+#include "Tudat/InputOutput/multiDimensionalArrayReader.h"
+#include "Tudat/InputOutput/parallelTextMatrixParser.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace input_output;
+
+//! Function to create a matrix with entries that are not exactly representable in short decimal notation.
+Eigen::MatrixXd createTestMatrix( const int numberOfRows, const int numberOfColumns )
+{
+    Eigen::MatrixXd testMatrix( numberOfRows, numberOfColumns );
+    for( int i = 0; i < numberOfRows; i++ )
+    {
+        for( int j = 0; j < numberOfColumns; j++ )
+        {
+            testMatrix( i, j ) = std::sin( 0.1 * i + j ) * std::pow( 10.0, ( i + j ) % 11 - 5 );
+        }
+    }
+    return testMatrix;
+}
+
+//! Function to write a matrix to a text file, with full precision and the given separator.
+void writeTestMatrixFile( const std::string& fileName, const Eigen::MatrixXd& matrix, const std::string& separator )
+{
+    std::ofstream file( fileName.c_str( ) );
+    file << std::setprecision( 17 ) << "% Test matrix" << std::endl;
+    for( int i = 0; i < matrix.rows( ); i++ )
+    {
+        for( int j = 0; j < matrix.cols( ); j++ )
+        {
+            file << ( j == 0 ? "" : separator ) << matrix( i, j );
+        }
+        file << std::endl;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( test_parallel_text_matrix_parser )
+
+//! Test parsing of small blocks of text, including comments, blank lines and errors.
+BOOST_AUTO_TEST_CASE( testTextParsing )
+{
+    const std::string text = "% Header\n"
+                             "  1.0; 2.5 ,3 % Trailing comment\r\n"
+                             "\n"
+                             "   \t \r\n"
+                             "-4.0E1\t5.0D-1;;6\n"
+                             "7,8,9%# Comment\n"
+                             "1e300 -0 .5";
+    const Eigen::MatrixXd expectedMatrix = ( Eigen::MatrixXd( 4, 3 ) <<
+                                             1.0, 2.5, 3.0,
+                                             -40.0, 0.5, 6.0,
+                                             7.0, 8.0, 9.0,
+                                             1.0E300, 0.0, 0.5 ).finished( );
+
+    // Comments removed from line ends.
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads++ )
+    {
+        BOOST_CHECK( parseTextToMatrix( text.data( ), text.data( ) + text.size( ), "\t;,", "%", true, -1,
+                                        numberOfThreads ) == expectedMatrix );
+    }
+
+    // Comment characters only at line start: '%' and '#' lines are removed, trailing comments are not allowed.
+    BOOST_CHECK_THROW( parseTextToMatrix( text.data( ), text.data( ) + text.size( ), "\t;,", "%#", false ),
+                       std::runtime_error );
+    const std::string textWithoutTrailingComment = "% 1 2\n 1 2\n  # 3 4\n5 6\n";
+    const Eigen::MatrixXd parsedMatrix =
+            parseTextToMatrix( textWithoutTrailingComment.data( ),
+                               textWithoutTrailingComment.data( ) + textWithoutTrailingComment.size( ), "", "%#",
+                               false );
+    BOOST_CHECK( parsedMatrix == ( Eigen::MatrixXd( 2, 2 ) << 1.0, 2.0, 5.0, 6.0 ).finished( ) );
+
+    // Check empty text and text without data.
+    const std::string commentText = "% Only a comment\n\n";
+    BOOST_CHECK_EQUAL( parseTextToMatrix( commentText.data( ), commentText.data( ), ";", "%", true ).size( ), 0 );
+    BOOST_CHECK_EQUAL( parseTextToMatrix( commentText.data( ), commentText.data( ) + commentText.size( ), ";", "%",
+                                          true ).size( ), 0 );
+
+    // Check errors on inconsistent number of columns and invalid numbers.
+    const std::string inconsistentText = "1 2 3\n4 5\n";
+    BOOST_CHECK_THROW( parseTextToMatrix( inconsistentText.data( ), inconsistentText.data( ) + inconsistentText.size( ),
+                                          "", "%", true ), std::runtime_error );
+    BOOST_CHECK_THROW( parseTextToMatrix( inconsistentText.data( ), inconsistentText.data( ) + 6, "", "%", true, 2 ),
+                       std::runtime_error );
+    const std::string invalidText = "1 2 3\n4 5 six\n";
+    BOOST_CHECK_THROW( parseTextToMatrix( invalidText.data( ), invalidText.data( ) + invalidText.size( ),
+                                          "", "%", true ), std::runtime_error );
+}
+
+//! Test parallel reading of a large matrix file, and the binary cache file.
+BOOST_AUTO_TEST_CASE( testLargeMatrixFile )
+{
+    const boost::filesystem::path temporaryDirectory =
+            boost::filesystem::temp_directory_path( ) / boost::filesystem::unique_path( );
+    boost::filesystem::create_directories( temporaryDirectory );
+    const std::string fileName = ( temporaryDirectory / "largeMatrix.txt" ).string( );
+
+    // Create file of about 8 MB, so that it is split into multiple chunks.
+    const Eigen::MatrixXd expectedMatrix = createTestMatrix( 40000, 10 );
+    writeTestMatrixFile( fileName, expectedMatrix, ", " );
+
+    // Read file with different numbers of threads.
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads *= 2 )
+    {
+        const Eigen::MatrixXd readMatrix = readMatrixFromFile( fileName, ",", "%", numberOfThreads );
+        BOOST_CHECK( readMatrix == expectedMatrix );
+    }
+
+    // Create cache file, and check that it is used on the next read.
+    BOOST_CHECK( !boost::filesystem::exists( getMatrixCacheFilePath( fileName ) ) );
+    BOOST_CHECK( readMatrixFromFile( fileName, ",", "%", 1, true ) == expectedMatrix );
+    BOOST_CHECK( boost::filesystem::exists( getMatrixCacheFilePath( fileName ) ) );
+    BOOST_CHECK( readMatrixFromFile( fileName, ",", "%", 1, true ) == expectedMatrix );
+
+    // Modify the first entry in the cache file, and check that it is read from there.
+    {
+        std::fstream cacheFile( getMatrixCacheFilePath( fileName ).c_str( ),
+                                std::ios::in | std::ios::out | std::ios::binary );
+        cacheFile.seekp( 56 );
+        const double modifiedEntry = -123.0;
+        cacheFile.write( reinterpret_cast< const char* >( &modifiedEntry ), sizeof( double ) );
+    }
+    BOOST_CHECK_EQUAL( readMatrixFromFile( fileName, ",", "%", 1, true )( 0, 0 ), -123.0 );
+
+    // Check that cache file is not used with different settings, or without cache.
+    BOOST_CHECK_EQUAL( readMatrixFromFile( fileName, ",", "%", 1, false )( 0, 0 ), expectedMatrix( 0, 0 ) );
+    BOOST_CHECK_EQUAL( readMatrixFromFile( fileName, ",;", "%", 1, true )( 0, 0 ), expectedMatrix( 0, 0 ) );
+
+    // Check that cache file is updated when the text file changes.
+    const Eigen::MatrixXd modifiedMatrix = createTestMatrix( 100, 3 );
+    writeTestMatrixFile( fileName, modifiedMatrix, ";" );
+    BOOST_CHECK( readMatrixFromFile( fileName, ",;", "%", 2, true ) == modifiedMatrix );
+    BOOST_CHECK( readMatrixFromFile( fileName, ",;", "%", 2, true ) == modifiedMatrix );
+
+    // Check that an empty file gives an empty matrix, and a missing file an error.
+    std::ofstream( ( temporaryDirectory / "empty.txt" ).string( ).c_str( ) );
+    BOOST_CHECK_EQUAL( readMatrixFromFile( ( temporaryDirectory / "empty.txt" ).string( ) ).size( ), 0 );
+    BOOST_CHECK_THROW( readMatrixFromFile( ( temporaryDirectory / "missing.txt" ).string( ) ), std::runtime_error );
+
+    boost::filesystem::remove_all( temporaryDirectory );
+}
+
+//! Test parallel reading of a coefficient file.
+BOOST_AUTO_TEST_CASE( testCoefficientFile )
+{
+    const boost::filesystem::path temporaryDirectory =
+            boost::filesystem::temp_directory_path( ) / boost::filesystem::unique_path( );
+    boost::filesystem::create_directories( temporaryDirectory );
+    const std::string fileName = ( temporaryDirectory / "coefficients.txt" ).string( );
+
+    // Create file with three independent variables (of sizes 20, 12 and 400).
+    const Eigen::MatrixXd expectedCoefficients = createTestMatrix( 20 * 400, 12 );
+    {
+        std::ofstream file( fileName.c_str( ) );
+        file << std::setprecision( 17 ) << "# Test coefficients" << std::endl << "  3" << std::endl << std::endl;
+        const int independentVariableSizes[ 3 ] = { 20, 12, 400 };
+        for( int i = 0; i < 3; i++ )
+        {
+            for( int j = 0; j < independentVariableSizes[ i ]; j++ )
+            {
+                file << ( j == 0 ? "" : "\t" ) << 0.5 * j + i;
+            }
+            file << std::endl;
+        }
+        for( int i = 0; i < expectedCoefficients.rows( ); i++ )
+        {
+            if( i % 20 == 0 )
+            {
+                file << std::endl << "# Block " << i / 20 << std::endl;
+            }
+            for( int j = 0; j < expectedCoefficients.cols( ); j++ )
+            {
+                file << ( j == 0 ? "" : " " ) << expectedCoefficients( i, j );
+            }
+            file << std::endl;
+        }
+    }
+
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads *= 2 )
+    {
+        std::vector< std::vector< double > > independentVariables;
+        Eigen::MatrixXd coefficientBlock;
+        readCoefficientsFile( fileName, independentVariables, coefficientBlock, numberOfThreads );
+
+        BOOST_CHECK_EQUAL( independentVariables.size( ), 3 );
+        BOOST_CHECK_EQUAL( independentVariables.at( 0 ).size( ), 20 );
+        BOOST_CHECK_EQUAL( independentVariables.at( 1 ).size( ), 12 );
+        BOOST_CHECK_EQUAL( independentVariables.at( 2 ).size( ), 400 );
+        BOOST_CHECK_EQUAL( independentVariables.at( 2 ).at( 3 ), 3.5 );
+        BOOST_CHECK( coefficientBlock == expectedCoefficients );
+    }
+
+    // Check that a missing row is detected.
+    {
+        std::ofstream file( fileName.c_str( ), std::ios::app );
+        file << "1 2 3 4 5 6 7 8 9 10 11 12" << std::endl;
+    }
+    std::vector< std::vector< double > > independentVariables;
+    Eigen::MatrixXd coefficientBlock;
+    BOOST_CHECK_THROW( readCoefficientsFile( fileName, independentVariables, coefficientBlock, 2 ),
+                       std::runtime_error );
+
+    boost::filesystem::remove_all( temporaryDirectory );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,223 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Celestrak (c). NORAD Two-Line Element Set Format,
+ *          http://celestrak.com/NORAD/documentation/tle-fmt.asp, 2004. Last
+ *          accessed: 5 August, 2011.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/timeConversions.h"
+#include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/InputOutput/twoLineElementCatalog.h"
+#include "Tudat/InputOutput/twoLineElementsTextFileReader.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Function to set the modulo-10 checksum of a TLE line.
+void setChecksum( std::string& line )
+{
+    unsigned int checksum = 0;
+    for( unsigned int i = 0; i < 68; i++ )
+    {
+        if( line[ i ] >= '0' && line[ i ] <= '9' )
+        {
+            checksum += line[ i ] - '0';
+        }
+        else if( line[ i ] == '-' )
+        {
+            checksum++;
+        }
+    }
+    line[ 68 ] = static_cast< char >( '0' + checksum % 10 );
+}
+
+BOOST_AUTO_TEST_SUITE( test_two_line_element_catalog )
+
+//! Test columnar catalog against TLE text file reader, for 2-line and 3-line files.
+BOOST_AUTO_TEST_CASE( testTwoLineElementCatalogAgainstTextFileReader )
+{
+    using input_output::TwoLineElementsTextFileReader;
+
+    for( unsigned int numberOfLines = 2; numberOfLines <= 3; numberOfLines++ )
+    {
+        const std::string fileName = ( numberOfLines == 2 ) ? "testTwoLineElementsTextFile2Line.txt" :
+                                                              "testTwoLineElementsTextFile3Line.txt";
+
+        // Read file with TLE text file reader, and remove corrupted element sets.
+        TwoLineElementsTextFileReader textFileReader;
+        textFileReader.setLineNumberTypeForTwoLineElementInputData(
+                    ( numberOfLines == 2 ) ? TwoLineElementsTextFileReader::twoLineType :
+                                             TwoLineElementsTextFileReader::threeLineType );
+        textFileReader.setRelativeDirectoryPath( "InputOutput/UnitTests/" );
+        textFileReader.setFileName( fileName );
+        textFileReader.openFile( );
+        textFileReader.readAndStoreData( );
+        textFileReader.closeFile( );
+        textFileReader.setCurrentYear( 2011 );
+        textFileReader.storeTwoLineElementData( );
+        textFileReader.checkTwoLineElementsFileIntegrity( );
+        const std::vector< input_output::TwoLineElementData > twoLineElementData =
+                textFileReader.getTwoLineElementData( );
+
+        // Read file with catalog.
+        const input_output::TwoLineElementCatalog catalog(
+                    input_output::getTudatRootPath( ) + "InputOutput/UnitTests/" + fileName );
+
+        BOOST_CHECK_EQUAL( catalog.getNumberOfElementSets( ), 3 );
+        BOOST_CHECK_EQUAL( catalog.getNumberOfCorruptedElementSets( ), 7 );
+        BOOST_CHECK_EQUAL( catalog.getObjectCatalogNumbers( ).size( ), 3 );
+
+        // Compare all variables of valid element sets (which are in the same order for both).
+        for( unsigned int i = 0; i < 3; i++ )
+        {
+            BOOST_CHECK_EQUAL( catalog.getCatalogNumbers( )[ i ], twoLineElementData[ i ].objectIdentificationNumber );
+            BOOST_CHECK_EQUAL( catalog.getClassifications( )[ i ], twoLineElementData[ i ].tleClassification );
+            BOOST_CHECK_EQUAL( catalog.getFirstDerivativesOfMeanMotionDividedByTwo( )[ i ],
+                               twoLineElementData[ i ].firstDerivativeOfMeanMotionDividedByTwo );
+            BOOST_CHECK_EQUAL( catalog.getSecondDerivativesOfMeanMotionDividedBySix( )[ i ],
+                               twoLineElementData[ i ].secondDerivativeOfMeanMotionDividedBySix );
+            BOOST_CHECK_EQUAL( catalog.getBStars( )[ i ], twoLineElementData[ i ].bStar );
+            BOOST_CHECK_EQUAL( catalog.getElementSetNumbers( )[ i ], twoLineElementData[ i ].tleNumber );
+            BOOST_CHECK_EQUAL( catalog.getInclinations( )[ i ], twoLineElementData[ i ].TLEKeplerianElements(
+                                   orbital_element_conversions::inclinationIndex ) );
+            BOOST_CHECK_EQUAL( catalog.getRightAscensionsOfAscendingNode( )[ i ],
+                               twoLineElementData[ i ].TLEKeplerianElements(
+                                   orbital_element_conversions::longitudeOfAscendingNodeIndex ) );
+            BOOST_CHECK_EQUAL( catalog.getEccentricities( )[ i ], twoLineElementData[ i ].TLEKeplerianElements(
+                                   orbital_element_conversions::eccentricityIndex ) );
+            BOOST_CHECK_EQUAL( catalog.getArgumentsOfPerigee( )[ i ], twoLineElementData[ i ].TLEKeplerianElements(
+                                   orbital_element_conversions::argumentOfPeriapsisIndex ) );
+            BOOST_CHECK_EQUAL( catalog.getMeanAnomalies( )[ i ], twoLineElementData[ i ].meanAnomaly );
+            BOOST_CHECK_EQUAL( catalog.getMeanMotions( )[ i ], twoLineElementData[ i ].meanMotionInRevolutionsPerDay );
+            BOOST_CHECK_EQUAL( catalog.getRevolutionNumbers( )[ i ], twoLineElementData[ i ].revolutionNumber );
+
+            // Check epoch against calendar date conversion.
+            const double expectedEpoch = ( basic_astrodynamics::convertCalendarDateToJulianDay(
+                                               static_cast< int >( twoLineElementData[ i ].fourDigitEpochYear ), 1, 1,
+                                               0, 0, 0.0 ) + twoLineElementData[ i ].epochDay - 1.0 -
+                                           basic_astrodynamics::JULIAN_DAY_ON_J2000 ) * physical_constants::JULIAN_DAY;
+            BOOST_CHECK_SMALL( catalog.getEpochs( )[ i ] - expectedEpoch, 1.0E-3 );
+        }
+
+        // Check index of objects.
+        BOOST_CHECK( catalog.getElementSetIndexRange( 29 ) == std::make_pair( 1U, 2U ) );
+        BOOST_CHECK_EQUAL( catalog.getElementSetIndexRange( 58 ).first, catalog.getElementSetIndexRange( 58 ).second );
+        BOOST_CHECK_EQUAL( catalog.getElementSetIndex( 37243, 0.0 ), 2 );
+        BOOST_CHECK_EQUAL( catalog.getElementSetIndex( 16, 0.0 ), -1 );
+    }
+
+    BOOST_CHECK_THROW( input_output::TwoLineElementCatalog( input_output::getTudatRootPath( ) + "nonExistingFile.txt" ),
+                       std::runtime_error );
+}
+
+//! Test parsing of a large file in chunks, and the sorting of element sets by catalog number and epoch.
+BOOST_AUTO_TEST_CASE( testTwoLineElementCatalogMultithreaded )
+{
+    // Create file with element sets of 1000 objects (including Alpha-5 catalog numbers), with epochs that are not in
+    // chronological order, and Windows line endings.
+    const std::string filePath = ( boost::filesystem::temp_directory_path( ) /
+                                   boost::filesystem::unique_path( "tudatTleCatalog%%%%%%%%.txt" ) ).string( );
+    const std::string objectNameLine = "VANGUARD 1              ";
+    const std::string line1Template = "1 00005U 58002B   11010.22613693  .00000290  00000-0  36608-3 0  7125";
+    const std::string line2Template = "2 00005  34.2587  38.6665 1850627 332.9238  18.5535 10.84016246831189";
+    const unsigned int numberOfElementSets = 40000;
+    const unsigned int numberOfObjects = 1000;
+    {
+        std::ofstream fileStream( filePath.c_str( ), std::ios::binary );
+        char catalogNumberField[ 6 ];
+        char epochDayField[ 13 ];
+        for( unsigned int i = 0; i < numberOfElementSets; i++ )
+        {
+            const unsigned int objectIndex = ( 7 * i ) % numberOfObjects;
+            if( objectIndex < 900 )
+            {
+                std::sprintf( catalogNumberField, "%05u", 20000 + objectIndex );
+            }
+            else
+            {
+                std::sprintf( catalogNumberField, "A%04u", objectIndex );
+            }
+            std::sprintf( epochDayField, "%012.8f", 1.0 + static_cast< double >( ( 13 * i ) % 360 ) + 0.001 * i / 40.0 );
+
+            std::string line1 = line1Template, line2 = line2Template;
+            line1.replace( 2, 5, catalogNumberField );
+            line2.replace( 2, 5, catalogNumberField );
+            line1.replace( 20, 12, epochDayField );
+            setChecksum( line1 );
+            setChecksum( line2 );
+            fileStream << objectNameLine << "\r\n" << line1 << "\r\n" << line2 << "\r\n";
+        }
+    }
+
+    // Parse file with different numbers of threads.
+    std::vector< input_output::TwoLineElementCatalogPointer > catalogs;
+    for( unsigned int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads *= 2 )
+    {
+        catalogs.push_back( boost::make_shared< input_output::TwoLineElementCatalog >( filePath, numberOfThreads ) );
+    }
+    boost::filesystem::remove( filePath );
+
+    for( unsigned int i = 0; i < catalogs.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( catalogs[ i ]->getNumberOfElementSets( ), numberOfElementSets );
+        BOOST_CHECK_EQUAL( catalogs[ i ]->getNumberOfCorruptedElementSets( ), 0 );
+        BOOST_CHECK_EQUAL( catalogs[ i ]->getObjectCatalogNumbers( ).size( ), numberOfObjects );
+
+        // Check that results are independent of number of threads.
+        BOOST_CHECK( catalogs[ i ]->getCatalogNumbers( ) == catalogs[ 0 ]->getCatalogNumbers( ) );
+        BOOST_CHECK( catalogs[ i ]->getEpochs( ) == catalogs[ 0 ]->getEpochs( ) );
+        BOOST_CHECK( catalogs[ i ]->getBStars( ) == catalogs[ 0 ]->getBStars( ) );
+        BOOST_CHECK( catalogs[ i ]->getMeanMotions( ) == catalogs[ 0 ]->getMeanMotions( ) );
+    }
+
+    // Check sorting by catalog number and epoch.
+    const input_output::TwoLineElementCatalog& catalog = *catalogs[ 0 ];
+    for( unsigned int i = 1; i < numberOfElementSets; i++ )
+    {
+        BOOST_CHECK( catalog.getCatalogNumbers( )[ i - 1 ] < catalog.getCatalogNumbers( )[ i ] ||
+                     ( catalog.getCatalogNumbers( )[ i - 1 ] == catalog.getCatalogNumbers( )[ i ] &&
+                       catalog.getEpochs( )[ i - 1 ] <= catalog.getEpochs( )[ i ] ) );
+    }
+
+    // Check Alpha-5 catalog numbers (A = 10).
+    BOOST_CHECK_EQUAL( catalog.getObjectCatalogNumbers( ).back( ), 100999 );
+    BOOST_CHECK_EQUAL( catalog.getElementSetIndexRange( 100950 ).second -
+                       catalog.getElementSetIndexRange( 100950 ).first, numberOfElementSets / numberOfObjects );
+
+    // Check retrieval of element set at epoch.
+    const std::pair< unsigned int, unsigned int > indexRange = catalog.getElementSetIndexRange( 20123 );
+    for( unsigned int i = indexRange.first; i < indexRange.second; i++ )
+    {
+        BOOST_CHECK_EQUAL( catalog.getElementSetIndex( 20123, catalog.getEpochs( )[ i ] + 1.0 ), static_cast< int >( i ) );
+    }
+    BOOST_CHECK_EQUAL( catalog.getElementSetIndex( 20123, -1.0E10 ), static_cast< int >( indexRange.first ) );
+    BOOST_CHECK_EQUAL( catalog.getElementSetIndex( 20123, 1.0E10 ), static_cast< int >( indexRange.second - 1 ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
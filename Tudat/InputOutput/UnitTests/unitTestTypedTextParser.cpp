@@ -0,0 +1,363 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/InputOutput/extractSolarActivityData.h"
+#include "Tudat/InputOutput/parseSolarActivityData.h"
+#include "Tudat/InputOutput/parsedDataVectorUtilities.h"
+#include "Tudat/InputOutput/solarActivityData.h"
+#include "Tudat/InputOutput/textFieldConversions.h"
+#include "Tudat/InputOutput/typedTextParser.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace input_output;
+
+//! Function to convert a string to a double with the typed text field conversion (NaN if conversion fails).
+double convertStringToDouble( const std::string& text )
+{
+    double value = std::numeric_limits< double >::quiet_NaN( );
+    if( !convertTextToDouble( text.data( ), text.data( ) + text.size( ), value ) )
+    {
+        return std::numeric_limits< double >::quiet_NaN( );
+    }
+    return value;
+}
+
+//! Function to append the rows of a chunk to vectors of the values of its columns (used to test chunked parsing).
+void appendChunk( const TypedTextTable& chunk, std::vector< int >& integerValues, std::vector< double >& doubleValues,
+                  std::vector< unsigned int >& chunkSizes )
+{
+    integerValues.insert( integerValues.end( ), chunk.getIntegerColumn( 0 ).begin( ),
+                          chunk.getIntegerColumn( 0 ).end( ) );
+    doubleValues.insert( doubleValues.end( ), chunk.getDoubleColumn( 2 ).begin( ), chunk.getDoubleColumn( 2 ).end( ) );
+    chunkSizes.push_back( chunk.getNumberOfRows( ) );
+}
+
+//! Function to check that two solar activity data objects are equal.
+void checkSolarActivityDataEqual( const solar_activity::SolarActivityData& data,
+                                  const solar_activity::SolarActivityData& expectedData,
+                                  const bool checkDataType )
+{
+    BOOST_CHECK_EQUAL( data.year, expectedData.year );
+    BOOST_CHECK_EQUAL( data.month, expectedData.month );
+    BOOST_CHECK_EQUAL( data.day, expectedData.day );
+    BOOST_CHECK_EQUAL( data.bartelsSolarRotationNumber, expectedData.bartelsSolarRotationNumber );
+    BOOST_CHECK_EQUAL( data.dayOfBartelsCycle, expectedData.dayOfBartelsCycle );
+    for( unsigned int i = 0; i < 8; i++ )
+    {
+        BOOST_CHECK_EQUAL( data.planetaryRangeIndexVector( i ), expectedData.planetaryRangeIndexVector( i ) );
+        BOOST_CHECK_EQUAL( data.planetaryEquivalentAmplitudeVector( i ),
+                           expectedData.planetaryEquivalentAmplitudeVector( i ) );
+    }
+    BOOST_CHECK_EQUAL( data.planetaryRangeIndexSum, expectedData.planetaryRangeIndexSum );
+    BOOST_CHECK_EQUAL( data.planetaryEquivalentAmplitudeAverage, expectedData.planetaryEquivalentAmplitudeAverage );
+    BOOST_CHECK_EQUAL( data.planetaryDailyCharacterFigure, expectedData.planetaryDailyCharacterFigure );
+    BOOST_CHECK_EQUAL( data.planetaryDailyCharacterFigureConverted,
+                       expectedData.planetaryDailyCharacterFigureConverted );
+    BOOST_CHECK_EQUAL( data.internationalSunspotNumber, expectedData.internationalSunspotNumber );
+    BOOST_CHECK_EQUAL( data.solarRadioFlux107Adjusted, expectedData.solarRadioFlux107Adjusted );
+    BOOST_CHECK_EQUAL( data.fluxQualifier, expectedData.fluxQualifier );
+    BOOST_CHECK_EQUAL( data.centered81DaySolarRadioFlux107Adjusted,
+                       expectedData.centered81DaySolarRadioFlux107Adjusted );
+    BOOST_CHECK_EQUAL( data.last81DaySolarRadioFlux107Adjusted, expectedData.last81DaySolarRadioFlux107Adjusted );
+    BOOST_CHECK_EQUAL( data.solarRadioFlux107Observed, expectedData.solarRadioFlux107Observed );
+    BOOST_CHECK_EQUAL( data.centered81DaySolarRadioFlux107Observed,
+                       expectedData.centered81DaySolarRadioFlux107Observed );
+    BOOST_CHECK_EQUAL( data.last81DaySolarRadioFlux107Observed, expectedData.last81DaySolarRadioFlux107Observed );
+    if( checkDataType )
+    {
+        BOOST_CHECK_EQUAL( data.dataType, expectedData.dataType );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( test_typed_text_parser )
+
+//! Test conversion of text fields to integers and doubles.
+BOOST_AUTO_TEST_CASE( testTextFieldConversions )
+{
+    // Check integer conversion.
+    std::vector< std::string > validIntegers;
+    validIntegers.push_back( "0" );
+    validIntegers.push_back( "  42" );
+    validIntegers.push_back( "-17  " );
+    validIntegers.push_back( "+5" );
+    validIntegers.push_back( "2147483647" );
+    validIntegers.push_back( "-2147483648" );
+    for( unsigned int i = 0; i < validIntegers.size( ); i++ )
+    {
+        int value;
+        BOOST_CHECK( convertTextToInteger( validIntegers[ i ].data( ),
+                                           validIntegers[ i ].data( ) + validIntegers[ i ].size( ), value ) );
+        BOOST_CHECK_EQUAL( value, std::atol( validIntegers[ i ].c_str( ) ) );
+    }
+
+    std::vector< std::string > invalidIntegers;
+    invalidIntegers.push_back( "" );
+    invalidIntegers.push_back( "  " );
+    invalidIntegers.push_back( "-" );
+    invalidIntegers.push_back( "1.0" );
+    invalidIntegers.push_back( "1 2" );
+    invalidIntegers.push_back( "12a" );
+    invalidIntegers.push_back( "2147483648" );
+    invalidIntegers.push_back( "-2147483649" );
+    for( unsigned int i = 0; i < invalidIntegers.size( ); i++ )
+    {
+        int value;
+        BOOST_CHECK( !convertTextToInteger( invalidIntegers[ i ].data( ),
+                                            invalidIntegers[ i ].data( ) + invalidIntegers[ i ].size( ), value ) );
+    }
+
+    // Check that doubles are converted exactly as by strtod, for numbers printed in various formats.
+    std::srand( 42 );
+    const char* formats[ ] = { "%.17g", "%.6g", "%.3f", "%.10e", "%.15e", "%.20e", "%.1f" };
+    for( unsigned int i = 0; i < 20000; i++ )
+    {
+        const double number = ( static_cast< double >( std::rand( ) ) / RAND_MAX - 0.5 ) *
+                std::pow( 10.0, static_cast< int >( std::rand( ) % 60 ) - 30 );
+        char buffer[ 64 ];
+        std::sprintf( buffer, formats[ i % 7 ], number );
+        BOOST_CHECK_EQUAL( convertStringToDouble( buffer ), std::strtod( buffer, NULL ) );
+    }
+
+    // Check special formats.
+    BOOST_CHECK_EQUAL( convertStringToDouble( "  1.5  " ), 1.5 );
+    BOOST_CHECK_EQUAL( convertStringToDouble( "-.25" ), -0.25 );
+    BOOST_CHECK_EQUAL( convertStringToDouble( "3." ), 3.0 );
+    BOOST_CHECK_EQUAL( convertStringToDouble( "1.0D-3" ), 1.0E-3 );
+    BOOST_CHECK_EQUAL( convertStringToDouble( "-2.5d+2" ), -250.0 );
+    BOOST_CHECK_EQUAL( convertStringToDouble( "1E400" ), std::strtod( "1E400", NULL ) );
+    BOOST_CHECK_EQUAL( convertStringToDouble( "0.000000000000000000000000001" ), 1.0E-27 );
+    BOOST_CHECK_EQUAL( convertStringToDouble( "12345678901234567890" ), 12345678901234567890.0 );
+
+    std::vector< std::string > invalidDoubles;
+    invalidDoubles.push_back( "" );
+    invalidDoubles.push_back( "." );
+    invalidDoubles.push_back( "-" );
+    invalidDoubles.push_back( "1.2.3" );
+    invalidDoubles.push_back( "1e" );
+    invalidDoubles.push_back( "1e 5" );
+    invalidDoubles.push_back( "1 5" );
+    invalidDoubles.push_back( "abc" );
+    invalidDoubles.push_back( "1.0x" );
+    for( unsigned int i = 0; i < invalidDoubles.size( ); i++ )
+    {
+        BOOST_CHECK( convertStringToDouble( invalidDoubles[ i ] ) != convertStringToDouble( invalidDoubles[ i ] ) );
+    }
+}
+
+//! Test parsing of fixed-width lines.
+BOOST_AUTO_TEST_CASE( testFixedWidthParsing )
+{
+    std::vector< TypedTextColumn > columns;
+    columns.push_back( TypedTextColumn( integer_column, 4 ) );
+    columns.push_back( TypedTextColumn( ignored_column, 3 ) );
+    columns.push_back( TypedTextColumn( double_column, 8 ) );
+    columns.push_back( TypedTextColumn( integer_column, 3, -1.0 ) );
+    columns.push_back( TypedTextColumn( double_column, 6, 0.5 ) );
+    TypedTextParser parser( columns );
+
+    TypedTextTable table;
+    parser.parseLine( "2001abc  3.1415 12   2.5", table );
+    parser.parseLine( "  -7xyz-1.0E+02      ", table );
+    parser.parseLine( "  12   0.125", table );
+
+    BOOST_CHECK_EQUAL( table.getNumberOfRows( ), 3 );
+    BOOST_CHECK_EQUAL( table.getNumberOfColumns( ), 5 );
+    BOOST_CHECK_EQUAL( table.getIntegerColumn( 0 ).at( 0 ), 2001 );
+    BOOST_CHECK_EQUAL( table.getIntegerColumn( 0 ).at( 1 ), -7 );
+    BOOST_CHECK_EQUAL( table.getIntegerColumn( 0 ).at( 2 ), 12 );
+    BOOST_CHECK_EQUAL( table.getDoubleColumn( 2 ).at( 0 ), 3.1415 );
+    BOOST_CHECK_EQUAL( table.getDoubleColumn( 2 ).at( 1 ), -100.0 );
+    BOOST_CHECK_EQUAL( table.getDoubleColumn( 2 ).at( 2 ), 0.125 );
+    BOOST_CHECK_EQUAL( table.getIntegerColumn( 3 ).at( 0 ), 12 );
+    BOOST_CHECK_EQUAL( table.getIntegerColumn( 3 ).at( 1 ), -1 );
+    BOOST_CHECK_EQUAL( table.getIntegerColumn( 3 ).at( 2 ), -1 );
+    BOOST_CHECK_EQUAL( table.getDoubleColumn( 4 ).at( 0 ), 2.5 );
+    BOOST_CHECK_EQUAL( table.getDoubleColumn( 4 ).at( 1 ), 0.5 );
+    BOOST_CHECK_EQUAL( table.getDoubleColumn( 4 ).at( 2 ), 0.5 );
+
+    // Check that columns of the wrong type can not be retrieved.
+    BOOST_CHECK_THROW( table.getDoubleColumn( 0 ), std::runtime_error );
+    BOOST_CHECK_THROW( table.getIntegerColumn( 1 ), std::runtime_error );
+    BOOST_CHECK_THROW( table.getIntegerColumn( 5 ), std::runtime_error );
+
+    // Check that invalid and (non-allowed) blank fields are reported, and leave the table unmodified.
+    BOOST_CHECK_THROW( parser.parseLine( "2001abc  3.14x5 12", table ), std::runtime_error );
+    BOOST_CHECK_THROW( parser.parseLine( "2001abc         12", table ), std::runtime_error );
+    BOOST_CHECK_THROW( parser.parseLine( "2001abc  3.1415 1.", table ), std::runtime_error );
+    BOOST_CHECK_EQUAL( table.getNumberOfRows( ), 3 );
+    BOOST_CHECK_EQUAL( table.getIntegerColumn( 0 ).size( ), 3 );
+    BOOST_CHECK_EQUAL( table.getDoubleColumn( 2 ).size( ), 3 );
+    BOOST_CHECK_EQUAL( table.getIntegerColumn( 3 ).size( ), 3 );
+
+    // Check that clearing the table removes all rows, but retains the columns.
+    table.clear( );
+    BOOST_CHECK_EQUAL( table.getNumberOfRows( ), 0 );
+    BOOST_CHECK_EQUAL( table.getIntegerColumn( 0 ).size( ), 0 );
+    BOOST_CHECK_EQUAL( table.getNumberOfColumns( ), 5 );
+
+    // Check that non-positive widths are rejected.
+    columns.push_back( TypedTextColumn( double_column ) );
+    BOOST_CHECK_THROW( TypedTextParser invalidParser( columns ), std::runtime_error );
+}
+
+//! Test parsing of separated streams, including header and comment lines and chunked parsing.
+BOOST_AUTO_TEST_CASE( testSeparatedParsing )
+{
+    std::vector< TypedTextColumn > columns;
+    columns.push_back( TypedTextColumn( integer_column ) );
+    columns.push_back( TypedTextColumn( ignored_column ) );
+    columns.push_back( TypedTextColumn( double_column, 0, 0.0 ) );
+
+    // Check whitespace-separated parsing (consecutive separators are merged).
+    {
+        TypedTextParser parser( columns, " \t" );
+        parser.setNumberOfHeaderLines( 1 );
+
+        std::stringstream stream;
+        stream << "index name value\n" << "1 a 0.5\r\n" << "\n" << "# comment\n" << "  2\tb    -1.5e3  extra\n"
+               << "   % comment\n" << "3 c\n" << "4";
+        TypedTextTable table = parser.parse( stream );
+
+        BOOST_CHECK_EQUAL( table.getNumberOfRows( ), 4 );
+        for( unsigned int i = 0; i < 4; i++ )
+        {
+            BOOST_CHECK_EQUAL( table.getIntegerColumn( 0 ).at( i ), static_cast< int >( i + 1 ) );
+        }
+        BOOST_CHECK_EQUAL( table.getDoubleColumn( 2 ).at( 0 ), 0.5 );
+        BOOST_CHECK_EQUAL( table.getDoubleColumn( 2 ).at( 1 ), -1500.0 );
+        BOOST_CHECK_EQUAL( table.getDoubleColumn( 2 ).at( 2 ), 0.0 );
+        BOOST_CHECK_EQUAL( table.getDoubleColumn( 2 ).at( 3 ), 0.0 );
+    }
+
+    // Check comma-separated parsing (empty fields are blank), and reporting of the line of an error.
+    {
+        TypedTextParser parser( columns, "," );
+        std::stringstream stream;
+        stream << "1, a, 2.5\n" << "2,,\n" << "3 ,b, 4.0D0\n";
+        TypedTextTable table = parser.parse( stream );
+
+        BOOST_CHECK_EQUAL( table.getNumberOfRows( ), 3 );
+        BOOST_CHECK_EQUAL( table.getIntegerColumn( 0 ).at( 2 ), 3 );
+        BOOST_CHECK_EQUAL( table.getDoubleColumn( 2 ).at( 0 ), 2.5 );
+        BOOST_CHECK_EQUAL( table.getDoubleColumn( 2 ).at( 1 ), 0.0 );
+        BOOST_CHECK_EQUAL( table.getDoubleColumn( 2 ).at( 2 ), 4.0 );
+
+        std::stringstream invalidStream;
+        invalidStream << "1, a, 2.5\n" << "# comment\n" << "x, b, 3.5\n";
+        bool isExceptionCaught = false;
+        try
+        {
+            parser.parse( invalidStream );
+        }
+        catch( std::runtime_error& error )
+        {
+            isExceptionCaught = true;
+            BOOST_CHECK( std::string( error.what( ) ).find( "line 3" ) != std::string::npos );
+        }
+        BOOST_CHECK( isExceptionCaught );
+    }
+
+    // Check that chunked parsing gives the same result as parsing of the full stream.
+    {
+        TypedTextParser parser( columns, " " );
+        std::stringstream stream;
+        for( unsigned int i = 0; i < 1000; i++ )
+        {
+            stream << i << " x " << 0.25 * i << "\n";
+        }
+
+        const TypedTextTable fullTable = parser.parse( stream );
+        stream.clear( );
+        stream.seekg( 0 );
+
+        std::vector< int > integerValues;
+        std::vector< double > doubleValues;
+        std::vector< unsigned int > chunkSizes;
+        const unsigned int numberOfRows = parser.parse(
+                    stream, boost::bind( &appendChunk, _1, boost::ref( integerValues ), boost::ref( doubleValues ),
+                                         boost::ref( chunkSizes ) ), 300 );
+
+        BOOST_CHECK_EQUAL( numberOfRows, 1000 );
+        BOOST_CHECK_EQUAL( chunkSizes.size( ), 4 );
+        BOOST_CHECK_EQUAL( chunkSizes.at( 0 ), 300 );
+        BOOST_CHECK_EQUAL( chunkSizes.at( 3 ), 100 );
+        BOOST_CHECK( integerValues == fullTable.getIntegerColumn( 0 ) );
+        BOOST_CHECK( doubleValues == fullTable.getDoubleColumn( 2 ) );
+    }
+}
+
+//! Test that solar activity data read with the typed parser are equal to those from the ParsedDataVector pipeline.
+BOOST_AUTO_TEST_CASE( testSolarActivityDataConsistency )
+{
+    const std::string cppPath( __FILE__ );
+    const std::string folder = cppPath.substr( 0, cppPath.find_last_of( "/\\" ) + 1 );
+
+    std::vector< std::string > filePaths;
+    filePaths.push_back( folder + "testSolarActivity.txt" );
+    filePaths.push_back( folder + "../../Astrodynamics/Aerodynamics/sw19571001.txt" );
+
+    for( unsigned int i = 0; i < filePaths.size( ); i++ )
+    {
+        // Read data with the ParsedDataVector pipeline.
+        std::ifstream dataFile( filePaths[ i ].c_str( ) );
+        solar_activity::ParseSolarActivityData solarActivityParser;
+        solar_activity::ExtractSolarActivityData solarActivityExtractor;
+        parsed_data_vector_utilities::ParsedDataVectorPtr parsedDataVector = solarActivityParser.parse( dataFile );
+        std::vector< solar_activity::SolarActivityDataPtr > expectedData;
+        for( unsigned int j = 0; j < parsedDataVector->size( ); j++ )
+        {
+            expectedData.push_back( solarActivityExtractor.extract( parsedDataVector->at( j ) ) );
+        }
+
+        // Read data with the typed parser.
+        const solar_activity::SolarActivityDataMap dataMap = solar_activity::readSolarActivityData( filePaths[ i ] );
+
+        // Compare data (all dates are unique, so that the map contains all lines in order). The data type can not be
+        // compared for the CRLF file, for which the pipeline fails to extract it.
+        BOOST_CHECK_EQUAL( dataMap.size( ), expectedData.size( ) );
+        unsigned int j = 0;
+        for( solar_activity::SolarActivityDataMap::const_iterator dataIterator = dataMap.begin( );
+             dataIterator != dataMap.end( ) && j < expectedData.size( ); dataIterator++, j++ )
+        {
+            const bool checkDataType = ( expectedData[ j ]->dataType != std::numeric_limits< unsigned int >::max( ) );
+            checkSolarActivityDataEqual( *dataIterator->second, *expectedData[ j ], checkDataType );
+            BOOST_CHECK( dataIterator->second->dataType >= 1 && dataIterator->second->dataType <= 4 );
+        }
+    }
+
+    // Check that a missing file is reported (rather than resulting in an empty map, as with the ParsedDataVector
+    // pipeline).
+    BOOST_CHECK_THROW( solar_activity::readSolarActivityData( folder + "nonExistingFile.txt" ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -12,124 +12,176 @@
  *
  */
 
-#include <vector>
+#include <cstring>
 #include <fstream>
-#include <sstream>
+#include <stdexcept>
 
-#include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string/trim.hpp>
-#include <boost/algorithm/string/trim_all.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/format.hpp>
-#include <boost/iostreams/device/file.hpp>
-#include <boost/iostreams/copy.hpp>
-#include <boost/iostreams/filtering_stream.hpp>
-#include <boost/lexical_cast.hpp>
 #include <boost/throw_exception.hpp>
 
 #include "Tudat/InputOutput/matrixTextFileReader.h"
-#include "Tudat/InputOutput/streamFilters.h"
+#include "Tudat/InputOutput/memoryMappedFile.h"
+#include "Tudat/InputOutput/parallelTextMatrixParser.h"
 
 namespace tudat
 {
 namespace input_output
 {
 
-//! Read the file and return the data matrix.
-Eigen::MatrixXd readMatrixFromFile( const std::string& relativePath, const std::string& separators,
-                                    const std::string& skipLinesCharacter )
+namespace
 {
-    // Open input and output.
-    std::fstream file( relativePath.c_str( ), std::ios::in );
-    if ( file.fail( ) )
-    {
-        boost::throw_exception(
-                    std::runtime_error(
-                                    boost::str(
-                            boost::format( "Data file '%s' could not be opened." )
-                            % relativePath.c_str( ) ) ) );
-    }
 
-    std::stringstream filteredStream( std::ios::in | std::ios::out );
+//! Identifier at the start of a binary matrix cache file.
+const char MATRIX_CACHE_FILE_IDENTIFIER[ 8 ] = { 'T', 'U', 'D', 'A', 'T', 'M', 'T', 'X' };
+
+//! Version of the binary matrix cache file format.
+const boost::uint32_t MATRIX_CACHE_FILE_VERSION = 1;
+
+//! Header of a binary matrix cache file, which is followed by the entries of the matrix (column-major).
+struct MatrixCacheFileHeader
+{
+    char fileIdentifier[ 8 ];
+    boost::uint32_t formatVersion;
+    boost::uint32_t padding;
+    boost::uint64_t sourceFileSize;
+    boost::int64_t sourceFileModificationTime;
+    boost::uint64_t readSettingsHash;
+    boost::uint64_t numberOfRows;
+    boost::uint64_t numberOfColumns;
+};
+
+//! Function to compute a hash (FNV-1a) of the settings with which a text file is read.
+boost::uint64_t computeReadSettingsHash( const std::string& separators, const std::string& skipLinesCharacter )
+{
+    const std::string settings = separators + '\n' + skipLinesCharacter;
+    boost::uint64_t hash = 14695981039346656037ULL;
+    for( unsigned int i = 0; i < settings.size( ); i++ )
     {
-        // Filter the file stream. This needs to be in its own scope, because filtering_stream::
-        // flush( ) does not work if the underlying end point is a stringstream, so the flush has
-        // to be forced by letting the filtering_stream go out of scope.
-        boost::iostreams::filtering_ostream filterProcessor;
-        for ( unsigned int i = 0; i < skipLinesCharacter.size( ); i++ )
-        {
-            // Remove all comments from the stream.
-            filterProcessor.push( input_output::stream_filters::RemoveComment(
-                                      skipLinesCharacter[ i ], true ) );
-        }
+        hash ^= static_cast< unsigned char >( settings[ i ] );
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
 
-        // Add the output to the filter chain.
-        filterProcessor.push( filteredStream );
+//! Function to create the header of the cache file for a text file.
+MatrixCacheFileHeader createMatrixCacheFileHeader( const std::string& relativePath, const std::string& separators,
+                                                   const std::string& skipLinesCharacter )
+{
+    MatrixCacheFileHeader header;
+    std::memset( &header, 0, sizeof( header ) );
+    std::memcpy( header.fileIdentifier, MATRIX_CACHE_FILE_IDENTIFIER, 8 );
+    header.formatVersion = MATRIX_CACHE_FILE_VERSION;
+    header.sourceFileSize = boost::filesystem::file_size( relativePath );
+    header.sourceFileModificationTime = static_cast< boost::int64_t >(
+                boost::filesystem::last_write_time( relativePath ) );
+    header.readSettingsHash = computeReadSettingsHash( separators, skipLinesCharacter );
+    return header;
+}
 
-        // Copy the input to the filter.
-        boost::iostreams::copy( file, filterProcessor );
+//! Function to read a matrix from a cache file, if it is consistent with the text file it was created from.
+bool readMatrixFromCacheFile( const std::string& cacheFilePath, const MatrixCacheFileHeader& expectedHeader,
+                              Eigen::MatrixXd& dataMatrix )
+{
+    std::ifstream cacheFile( cacheFilePath.c_str( ), std::ios::binary );
+    MatrixCacheFileHeader header;
+    if( !cacheFile.read( reinterpret_cast< char* >( &header ), sizeof( header ) ) ||
+            std::memcmp( header.fileIdentifier, expectedHeader.fileIdentifier, 8 ) != 0 ||
+            header.formatVersion != expectedHeader.formatVersion ||
+            header.sourceFileSize != expectedHeader.sourceFileSize ||
+            header.sourceFileModificationTime != expectedHeader.sourceFileModificationTime ||
+            header.readSettingsHash != expectedHeader.readSettingsHash ||
+            boost::filesystem::file_size( cacheFilePath ) !=
+            sizeof( header ) + header.numberOfRows * header.numberOfColumns * sizeof( double ) )
+    {
+        return false;
     }
 
-    // Seek stream back to start.
-    filteredStream.seekg( 0, std::ios::beg );
+    dataMatrix.resize( static_cast< int >( header.numberOfRows ), static_cast< int >( header.numberOfColumns ) );
+    return static_cast< bool >(
+                cacheFile.read( reinterpret_cast< char* >( dataMatrix.data( ) ),
+                                static_cast< std::streamsize >( dataMatrix.size( ) * sizeof( double ) ) ) );
+}
+
+//! Function to write a matrix to a cache file (failures are ignored, as the cache is only an optimization).
+void writeMatrixToCacheFile( const std::string& cacheFilePath, MatrixCacheFileHeader header,
+                             const Eigen::MatrixXd& dataMatrix )
+{
+    header.numberOfRows = static_cast< boost::uint64_t >( dataMatrix.rows( ) );
+    header.numberOfColumns = static_cast< boost::uint64_t >( dataMatrix.cols( ) );
 
-    // Read the filtered stream into lines.
-    std::vector< std::string > lines_;
-    while ( !filteredStream.eof( ) )
+    // Write to temporary file first, so that a concurrent reader never sees a partial cache file.
+    const std::string temporaryFilePath =
+            cacheFilePath + "." + boost::filesystem::unique_path( ).string( ) + ".tmp";
+    bool isWritten = false;
     {
-        std::string line_;
-        getline( filteredStream, line_ );
-        if ( !line_.empty( ) )
-        {
-            boost::trim_all( line_ );
-            lines_.push_back( line_ );
-        }
+        std::ofstream cacheFile( temporaryFilePath.c_str( ), std::ios::binary );
+        cacheFile.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+        cacheFile.write( reinterpret_cast< const char* >( dataMatrix.data( ) ),
+                         static_cast< std::streamsize >( dataMatrix.size( ) * sizeof( double ) ) );
+        cacheFile.close( );
+        isWritten = !cacheFile.fail( );
     }
 
-    // If there are no lines, return an empty matrix.
-    if ( lines_.empty( ) )
+    boost::system::error_code errorCode;
+    if( isWritten )
+    {
+        boost::filesystem::rename( temporaryFilePath, cacheFilePath, errorCode );
+    }
+    if( !isWritten || errorCode )
     {
-        return Eigen::MatrixXd( );
+        boost::filesystem::remove( temporaryFilePath, errorCode );
     }
+}
 
-    const std::string realSeparators = std::string( separators ) + " ";
+} // namespace
 
-    // Determine the number of columns from.
-    std::vector< std::string > lineSplit_;
-    boost::algorithm::split( lineSplit_, lines_[ 0 ], boost::is_any_of( realSeparators ),
-                             boost::algorithm::token_compress_on );
-    const unsigned int numberOfColumns = lineSplit_.size( );
+//! Function to retrieve the path of the binary sidecar file in which readMatrixFromFile caches a matrix.
+std::string getMatrixCacheFilePath( const std::string& relativePath )
+{
+    return relativePath + ".matrixcache";
+}
 
-    // Initialize the matrix with sizes obtained from the number of lines and the entries in the
-    // first line.
-    Eigen::MatrixXd dataMatrix_( lines_.size( ), numberOfColumns );
-    for ( int rowIndex = 0; rowIndex < dataMatrix_.rows( ); rowIndex++ )
+//! Read the file and return the data matrix.
+Eigen::MatrixXd readMatrixFromFile( const std::string& relativePath, const std::string& separators,
+                                    const std::string& skipLinesCharacter, const unsigned int numberOfThreads,
+                                    const bool useBinaryCache )
+{
+    if ( !boost::filesystem::is_regular_file( relativePath ) )
     {
-        lineSplit_.clear( );
+        boost::throw_exception(
+                    std::runtime_error(
+                                    boost::str(
+                            boost::format( "Data file '%s' could not be opened." )
+                            % relativePath.c_str( ) ) ) );
+    }
 
-        // Read current line and split into separate entries.
-        boost::algorithm::split( lineSplit_, lines_[ rowIndex ],
-                                 boost::is_any_of( realSeparators ),
-                                 boost::algorithm::token_compress_on );
+    // Use cached matrix, if available and up to date.
+    MatrixCacheFileHeader cacheFileHeader;
+    if ( useBinaryCache )
+    {
+        cacheFileHeader = createMatrixCacheFileHeader( relativePath, separators, skipLinesCharacter );
 
-        // Check if number of column entries in line matches the number of columns in the matrix.
-        // If not, throw a runtime error.
-        if ( lineSplit_.size( ) != numberOfColumns )
+        Eigen::MatrixXd cachedDataMatrix;
+        if ( readMatrixFromCacheFile( getMatrixCacheFilePath( relativePath ), cacheFileHeader, cachedDataMatrix ) )
         {
-            boost::throw_exception(
-                        std::runtime_error(
-                            boost::str(
-                                boost::format(
-                                    "Number of columns in row %1% is %2%; should be %3%." )
-                                % rowIndex % lineSplit_.size( ) % numberOfColumns ) ) );
+            return cachedDataMatrix;
         }
+    }
 
-        // Put single line entries into matrix as doubles.
-        for ( int columnIndex = 0; columnIndex < dataMatrix_.cols( ); columnIndex++ )
-        {
-            boost::trim( lineSplit_.at( columnIndex ) );
-            dataMatrix_( rowIndex, columnIndex ) =
-                    boost::lexical_cast< double >( lineSplit_.at( columnIndex ) );
-        }
+    // Memory-map file and parse it (an empty file cannot be mapped, and contains no data).
+    Eigen::MatrixXd dataMatrix_;
+    if ( boost::filesystem::file_size( relativePath ) > 0 )
+    {
+        const MemoryMappedFile mappedFile( relativePath );
+        dataMatrix_ = parseTextToMatrix( mappedFile.data( ), mappedFile.data( ) + mappedFile.size( ),
+                                         separators, skipLinesCharacter, true, -1, numberOfThreads );
+    }
+
+    if ( useBinaryCache )
+    {
+        writeMatrixToCacheFile( getMatrixCacheFilePath( relativePath ), cacheFileHeader, dataMatrix_ );
     }
 
     return dataMatrix_;
@@ -28,15 +28,30 @@ namespace input_output
 /*!
  * Read a textfile whith separated (space, tab, comma etc...) numbers. The class returns these
  * numbers as a matrixXd. The first line with numbers is used to define the number of columns.
+ * The file is memory-mapped and parsed in chunks of lines, which are converted concurrently
+ * directly into the (once allocated) matrix, see parseTextToMatrix.
+ *
+ * Optionally, the matrix is cached in a binary sidecar file (the path to the file, appended with
+ * ".matrixcache"), which is used instead of the text file on subsequent calls, as long as the
+ * size and modification time of the text file, and the separators and skip characters, are
+ * unchanged. Failure to write the sidecar file (e.g. in a read-only directory) is not an error.
  * \param relativePath Relative path to file.
  * \param separators Separators used, every character in the string will be used as separators.
  *         (multiple seperators possible).
  * \param skipLinesCharacter Skip lines starting with this character.
+ * \param numberOfThreads Number of threads that is used to parse the file.
+ * \param useBinaryCache Boolean denoting whether the binary sidecar file is used (and created, if
+ *         it does not exist or is outdated).
  * \return The datamatrix.
  */
 Eigen::MatrixXd readMatrixFromFile( const std::string& relativePath,
                                     const std::string& separators = "\t ;,",
-                                    const std::string& skipLinesCharacter = "%" );
+                                    const std::string& skipLinesCharacter = "%",
+                                    const unsigned int numberOfThreads = 1,
+                                    const bool useBinaryCache = false );
+
+//! Function to retrieve the path of the binary sidecar file in which readMatrixFromFile caches a matrix.
+std::string getMatrixCacheFilePath( const std::string& relativePath );
 
 } // namespace input_output
 } // namespace tudat
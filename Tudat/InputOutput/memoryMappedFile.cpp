@@ -0,0 +1,108 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#include <stdexcept>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define TUDAT_USE_POSIX_MEMORY_MAPPING
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+#include "Tudat/InputOutput/memoryMappedFile.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Constructor.
+MemoryMappedFile::MemoryMappedFile( const std::string& filePath, const std::size_t length ):
+    data_( NULL ), size_( 0 )
+{
+#if defined( TUDAT_USE_POSIX_MEMORY_MAPPING )
+    const int fileDescriptor = open( filePath.c_str( ), O_RDONLY );
+    if( fileDescriptor < 0 )
+    {
+        throw std::runtime_error( "Error, file " + filePath + " could not be opened." );
+    }
+
+    struct stat fileStatus;
+    if( fstat( fileDescriptor, &fileStatus ) != 0 )
+    {
+        close( fileDescriptor );
+        throw std::runtime_error( "Error, size of file " + filePath + " could not be determined." );
+    }
+    const std::size_t fileSize = static_cast< std::size_t >( fileStatus.st_size );
+#else
+    std::ifstream fileStream( filePath.c_str( ), std::ios::in | std::ios::binary );
+    if( !fileStream.is_open( ) )
+    {
+        throw std::runtime_error( "Error, file " + filePath + " could not be opened." );
+    }
+    fileStream.seekg( 0, std::ios::end );
+    const std::size_t fileSize = static_cast< std::size_t >( fileStream.tellg( ) );
+#endif
+
+    if( length > fileSize )
+    {
+#if defined( TUDAT_USE_POSIX_MEMORY_MAPPING )
+        close( fileDescriptor );
+#endif
+        throw std::runtime_error( "Error, file " + filePath + " is shorter than the requested length." );
+    }
+    size_ = ( length == 0 ) ? fileSize : length;
+
+#if defined( TUDAT_USE_POSIX_MEMORY_MAPPING )
+    // An empty range cannot be mapped (and does not need to be).
+    if( size_ > 0 )
+    {
+        void* mappedData = mmap( NULL, size_, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+        if( mappedData == MAP_FAILED )
+        {
+            close( fileDescriptor );
+            throw std::runtime_error( "Error, file " + filePath + " could not be mapped to memory." );
+        }
+        data_ = static_cast< const char* >( mappedData );
+    }
+
+    // The mapping remains valid after the file is closed.
+    close( fileDescriptor );
+#else
+    if( size_ > 0 )
+    {
+        buffer_.resize( size_ );
+        fileStream.seekg( 0, std::ios::beg );
+        if( !fileStream.read( &buffer_[ 0 ], size_ ) )
+        {
+            throw std::runtime_error( "Error, file " + filePath + " could not be read." );
+        }
+        data_ = &buffer_[ 0 ];
+    }
+#endif
+}
+
+//! Destructor.
+MemoryMappedFile::~MemoryMappedFile( )
+{
+#if defined( TUDAT_USE_POSIX_MEMORY_MAPPING )
+    if( data_ != NULL )
+    {
+        munmap( const_cast< char* >( data_ ), size_ );
+    }
+#endif
+}
+
+} // namespace input_output
+} // namespace tudat
@@ -0,0 +1,84 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_MEMORY_MAPPED_FILE_H
+#define TUDAT_MEMORY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Read-only view of the contents of a file.
+/*!
+ *  Read-only view of the contents (or of the first part) of a file, as a contiguous range of characters that remains
+ *  valid for the lifetime of the object. On POSIX systems, the file is memory-mapped (with mmap), so that only the parts
+ *  of the file that are accessed are read from disk. On other systems, the file is read into a buffer with an
+ *  std::ifstream. Note that the range is not null-terminated.
+ */
+class MemoryMappedFile: boost::noncopyable
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor, maps (or reads) the file.
+     *  \param filePath Path to the file.
+     *  \param length Number of characters from the start of the file that are to be mapped (entire file if 0). Must not
+     *  exceed the size of the file.
+     *  \throws std::runtime_error If the file could not be opened or mapped, or is shorter than the requested length.
+     */
+    MemoryMappedFile( const std::string& filePath, const std::size_t length = 0 );
+
+    //! Destructor, unmaps the file.
+    ~MemoryMappedFile( );
+
+    //! Function to retrieve the start of the contents of the file.
+    /*!
+     *  Function to retrieve the start of the contents of the file (NULL if the mapped range is empty).
+     *  \return Pointer to the first character of the file.
+     */
+    const char* data( ) const
+    {
+        return data_;
+    }
+
+    //! Function to retrieve the number of characters in the mapped range.
+    /*!
+     *  Function to retrieve the number of characters in the mapped range.
+     *  \return Number of characters in the mapped range.
+     */
+    std::size_t size( ) const
+    {
+        return size_;
+    }
+
+private:
+
+    //! Start of the contents of the file.
+    const char* data_;
+
+    //! Number of characters in the mapped range.
+    std::size_t size_;
+
+    //! Buffer containing the contents of the file, if the file is not memory-mapped.
+    std::vector< char > buffer_;
+};
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_MEMORY_MAPPED_FILE_H
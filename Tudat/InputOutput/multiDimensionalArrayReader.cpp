@@ -9,6 +9,7 @@
  */
 
 
+#include <cstring>
 #include <map>
 #include <fstream>
 #include <sstream>
@@ -19,9 +20,12 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 
+#include "Tudat/InputOutput/memoryMappedFile.h"
 #include "Tudat/InputOutput/multiDimensionalArrayReader.h"
+#include "Tudat/InputOutput/parallelTextMatrixParser.h"
 
 namespace tudat
 {
@@ -124,35 +128,35 @@ boost::multi_array< double, 3 > parseRawThreeDimensionalCoefficientsFromFile(
 void readCoefficientsFile(
         const std::string fileName,
         std::vector< std::vector< double > >& independentVariables,
-        Eigen::MatrixXd& coefficientBlock )
+        Eigen::MatrixXd& coefficientBlock,
+        const unsigned int numberOfThreads )
 {
-    // Open file and create file stream.
-    std::fstream stream( fileName.c_str( ), std::ios::in );
-
-    // Check if file opened correctly.
-    if ( stream.fail( ) )
+    // Check if file exists (an empty file cannot be memory-mapped, and contains no header).
+    if ( !boost::filesystem::is_regular_file( fileName ) || boost::filesystem::file_size( fileName ) == 0 )
     {
         boost::throw_exception( std::runtime_error( boost::str(
                                                         boost::format( "Data file '%s' could not be opened." ) %
                                                         fileName.c_str( ) ) ) );
     }
 
-    // Initialize boolean that gets set to true once the file header is passed.
-    bool isHeaderPassed = 0;
-    bool isFirstLinePassed = 0;
+    const MemoryMappedFile mappedFile( fileName );
+    const char* fileEnd = mappedFile.data( ) + mappedFile.size( );
 
-
-    // Line based parsing
+    // Parse header line-by-line, until all independent variables have been read.
     std::string line;
     std::vector< std::string > vectorOfIndividualStrings;
-
-    // Read file line-by-line
-    int numberOfDataLinesParsed = 0;
     int numberOfIndependentVariables = -1;
-    while ( !stream.fail( ) && !stream.eof( ) )
+    const char* lineStart = mappedFile.data( );
+    while( lineStart < fileEnd && static_cast< int >( independentVariables.size( ) ) != numberOfIndependentVariables )
     {
-        // Get line from stream
-        std::getline( stream, line );
+        // Get line from file, and move to start of next line
+        const char* lineEnd = static_cast< const char* >( std::memchr( lineStart, '\n', fileEnd - lineStart ) );
+        if( lineEnd == NULL )
+        {
+            lineEnd = fileEnd;
+        }
+        line.assign( lineStart, lineEnd );
+        lineStart = ( lineEnd < fileEnd ) ? lineEnd + 1 : fileEnd;
 
         // Trim input string (removes all leading and trailing whitespaces).
         boost::algorithm::trim( line );
@@ -167,17 +171,16 @@ void readCoefficientsFile(
                                      boost::algorithm::token_compress_on );
 
             // If this is the first line that is read, it should contain the number of independent variables
-            if( !isFirstLinePassed )
+            if( numberOfIndependentVariables < 0 )
             {
                 if( vectorOfIndividualStrings.size( ) != 1 )
                 {
                     throw std::runtime_error( "Error when reading multi-array, expected number of independent variables" );
                 }
                 numberOfIndependentVariables = boost::lexical_cast< int >( vectorOfIndividualStrings.at( 0 ) );
-                isFirstLinePassed = true;
-            }            
-            // If the file header is not passed, this should contain the independent variables
-            else if( !isHeaderPassed )
+            }
+            // Otherwise, this should contain the independent variables
+            else
             {
                 std::vector< double > currentDataPoints;
                 for( unsigned int i = 0; i < vectorOfIndividualStrings.size( ); i++ )
@@ -186,70 +189,51 @@ void readCoefficientsFile(
                 }
                 independentVariables.push_back( currentDataPoints );
             }
-            else if( isHeaderPassed )
-            {
-                // Check line consistency
-                if( vectorOfIndividualStrings.size( ) != static_cast< unsigned int >( coefficientBlock.cols( ) ) )
-                {
-                    throw std::runtime_error(
-                                "Error on data line " + boost::lexical_cast< std::string >( numberOfDataLinesParsed ) +
-                                " found " + boost::lexical_cast< std::string >( vectorOfIndividualStrings.size( ) ) +
-                                " columns, but expected " + boost::lexical_cast< std::string >( coefficientBlock.cols( ) ) );
-                }
-                else if( numberOfDataLinesParsed > coefficientBlock.rows( ) )
-                {
-                    throw std::runtime_error(
-                                "Error on data line " + boost::lexical_cast< std::string >( numberOfDataLinesParsed ) +
-                                " expected " +  boost::lexical_cast< std::string >( coefficientBlock.rows( ) ) + "rows" );
-                }
-                else
-                {
-                    // Parse data from current line into output matrix.
-                    for( unsigned int i = 0; i < vectorOfIndividualStrings.size( ); i++ )
-                    {
-                        coefficientBlock( numberOfDataLinesParsed, i ) =
-                                boost::lexical_cast< double >( vectorOfIndividualStrings.at( i ) );
-                    }
-                    numberOfDataLinesParsed++;
-                }
-            }
+        }
+    }
 
-            // If the number of independent variables read is the same as the number of independent variables that
-            // should be defined, allocate memory for output matrix.
-            if( ( static_cast< int >( independentVariables.size( ) ) == numberOfIndependentVariables ) && !isHeaderPassed )
-            {
-                // Check input consistency
-                if( independentVariables.size( ) == 0 )
-                {
-                    throw std::runtime_error( "Error when reading multi-array, no header found" );
-                }
-                else
-                {
-                    // Define size of output matrix, and allocate memory
-                    int numberOfRows = independentVariables.at( 0 ).size( );
-                    int numberOfColumns = 1;
-                    if( independentVariables.size( ) > 1 )
-                    {
-                        numberOfColumns = independentVariables.at( 1 ).size( );
-                        for( unsigned int i = 2; i < independentVariables.size( ); i++ )
-                        {
-                            numberOfRows *= independentVariables.at( i ).size( );
-                        }
-                    }
-                    coefficientBlock.setZero( numberOfRows, numberOfColumns );
-                }
-                isHeaderPassed = true;
-            }
+    // Check input consistency
+    if( independentVariables.size( ) == 0 ||
+            static_cast< int >( independentVariables.size( ) ) != numberOfIndependentVariables )
+    {
+        throw std::runtime_error( "Error when reading multi-array, no header found" );
+    }
 
+    // Define size of output matrix
+    int numberOfRows = independentVariables.at( 0 ).size( );
+    int numberOfColumns = 1;
+    if( independentVariables.size( ) > 1 )
+    {
+        numberOfColumns = independentVariables.at( 1 ).size( );
+        for( unsigned int i = 2; i < independentVariables.size( ); i++ )
+        {
+            numberOfRows *= independentVariables.at( i ).size( );
         }
     }
 
-    if( numberOfDataLinesParsed != coefficientBlock.rows( ) )
+    // Parse remainder of file (in parallel) directly into output matrix.
+    Eigen::MatrixXd parsedCoefficients;
+    try
+    {
+        parsedCoefficients = parseTextToMatrix( lineStart, fileEnd, "\t;,", "#", false, numberOfColumns,
+                                                numberOfThreads );
+    }
+    catch( std::runtime_error& error )
+    {
+        throw std::runtime_error( "Error when reading coefficient file " + fileName + ": " + error.what( ) );
+    }
+
+    if( parsedCoefficients.rows( ) != numberOfRows )
     {
         throw std::runtime_error(
                     "Error at end of coefficient file reader, found " +
-                    boost::lexical_cast< std::string >( numberOfDataLinesParsed ) +
-                    " lines, but expected " +  boost::lexical_cast< std::string >( coefficientBlock.rows( ) ) + "rows" );
+                    boost::lexical_cast< std::string >( parsedCoefficients.rows( ) ) +
+                    " lines, but expected " +  boost::lexical_cast< std::string >( numberOfRows ) + "rows" );
+    }
+    coefficientBlock.setZero( numberOfRows, numberOfColumns );
+    if( numberOfRows > 0 )
+    {
+        coefficientBlock = parsedCoefficients;
     }
 }
 
@@ -61,15 +61,18 @@ boost::multi_array< double, 3 > parseRawThreeDimensionalCoefficientsFromFile(
 /*!
  * Function to read a coefficient file (data on a structured grid as a function of N independent variables). This function
  * reads the file as raw data, converting teh data into a multi-array of the correct size can be done using the
- * MultiArrayFileReader class if needed. The file format is defined in the Tudat wiki.
+ * MultiArrayFileReader class if needed. The file format is defined in the Tudat wiki. The file is memory-mapped, and the
+ * block of coefficients following the header is parsed in chunks of lines concurrently (see parseTextToMatrix).
  * \param fileName Name of file containing coefficients,
  * \param independentVariables Independent variables of coefficients, as read from file (returned by reference)
  * \param coefficientBlock Block of coefficients, as read from file (returned by reference)
+ * \param numberOfThreads Number of threads that is used to parse the block of coefficients.
  */
 void readCoefficientsFile(
         const std::string fileName,
         std::vector< std::vector< double > >& independentVariables,
-        Eigen::MatrixXd& coefficientBlock );
+        Eigen::MatrixXd& coefficientBlock,
+        const unsigned int numberOfThreads = 1 );
 
 //! Function to retrieve the number of independent variables that the coefficients in a file are given for.
 /*!
@@ -0,0 +1,279 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include "Tudat/Basics/parallelization.h"
+#include "Tudat/InputOutput/parallelTextMatrixParser.h"
+#include "Tudat/InputOutput/textFieldConversions.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+namespace
+{
+
+//! Minimum size of a chunk of text that is parsed by a separate thread.
+const std::ptrdiff_t MINIMUM_CHUNK_SIZE = 1 << 20;
+
+//! Function to find the end of a line (position of the newline character, or end of text).
+const char* findLineEnd( const char* lineStart, const char* textEnd )
+{
+    const char* lineEnd = static_cast< const char* >( std::memchr( lineStart, '\n', textEnd - lineStart ) );
+    return ( lineEnd == NULL ) ? textEnd : lineEnd;
+}
+
+//! Function to find the start of the line following a line end (or end of text).
+const char* getNextLineStart( const char* lineEnd, const char* textEnd )
+{
+    return ( lineEnd < textEnd ) ? lineEnd + 1 : textEnd;
+}
+
+//! Class to determine the data part of lines of text, and split it into fields.
+class TextLineSplitter
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor.
+     *  \param separators Characters that separate the fields (in addition to spaces and carriage returns).
+     *  \param commentCharacters Characters that start a comment.
+     *  \param areCommentsRemovedFromLineEnds Boolean denoting whether a comment character removes the remainder of
+     *  the line wherever it occurs, or only if it is the first non-whitespace character.
+     */
+    TextLineSplitter( const std::string& separators, const std::string& commentCharacters,
+                      const bool areCommentsRemovedFromLineEnds ):
+        areCommentsRemovedFromLineEnds_( areCommentsRemovedFromLineEnds )
+    {
+        std::fill( isSeparator_, isSeparator_ + 256, false );
+        std::fill( isCommentCharacter_, isCommentCharacter_ + 256, false );
+        for( unsigned int i = 0; i < separators.size( ); i++ )
+        {
+            isSeparator_[ static_cast< unsigned char >( separators[ i ] ) ] = true;
+        }
+        isSeparator_[ static_cast< unsigned char >( ' ' ) ] = true;
+        isSeparator_[ static_cast< unsigned char >( '\r' ) ] = true;
+        for( unsigned int i = 0; i < commentCharacters.size( ); i++ )
+        {
+            isCommentCharacter_[ static_cast< unsigned char >( commentCharacters[ i ] ) ] = true;
+        }
+    }
+
+    //! Function to determine the end of the data in a line.
+    /*!
+     *  Function to determine the end of the data in a line (start of a trailing comment, or end of the line).
+     *  \param lineStart Pointer to the start of the line.
+     *  \param lineEnd Pointer to the end of the line.
+     *  \return Pointer to the end of the data in the line, or NULL if the line contains no data.
+     */
+    const char* getDataEnd( const char* lineStart, const char* lineEnd ) const
+    {
+        const char* dataEnd = lineEnd;
+        for( const char* position = lineStart; position < lineEnd; position++ )
+        {
+            if( isCommentCharacter( *position ) )
+            {
+                dataEnd = position;
+                break;
+            }
+            else if( !areCommentsRemovedFromLineEnds_ && *position != ' ' && *position != '\t' )
+            {
+                break;
+            }
+        }
+
+        for( const char* position = lineStart; position < dataEnd; position++ )
+        {
+            if( !isSeparator( *position ) && *position != '\t' )
+            {
+                return dataEnd;
+            }
+        }
+        return NULL;
+    }
+
+    //! Function to retrieve the next field in the data of a line.
+    /*!
+     *  Function to retrieve the next field in the data of a line, skipping any separators.
+     *  \param position Current position in the line, moved to the end of the field (modified by this function).
+     *  \param dataEnd End of the data in the line.
+     *  \param fieldStart Start of the field (returned by reference).
+     *  \return True if a field was found, false if the end of the data was reached.
+     */
+    bool getNextField( const char*& position, const char* dataEnd, const char*& fieldStart ) const
+    {
+        while( position < dataEnd && isSeparator( *position ) )
+        {
+            position++;
+        }
+        if( position == dataEnd )
+        {
+            return false;
+        }
+
+        fieldStart = position;
+        while( position < dataEnd && !isSeparator( *position ) )
+        {
+            position++;
+        }
+        return true;
+    }
+
+private:
+
+    //! Function to determine whether a character is a separator.
+    bool isSeparator( const char character ) const
+    {
+        return isSeparator_[ static_cast< unsigned char >( character ) ];
+    }
+
+    //! Function to determine whether a character starts a comment.
+    bool isCommentCharacter( const char character ) const
+    {
+        return isCommentCharacter_[ static_cast< unsigned char >( character ) ];
+    }
+
+    //! Boolean denoting whether a comment character removes the remainder of the line wherever it occurs.
+    bool areCommentsRemovedFromLineEnds_;
+
+    //! Lookup table of separator characters.
+    bool isSeparator_[ 256 ];
+
+    //! Lookup table of comment characters.
+    bool isCommentCharacter_[ 256 ];
+};
+
+} // namespace
+
+//! Function to parse a block of text with separated numbers into a matrix, in parallel.
+Eigen::MatrixXd parseTextToMatrix( const char* textStart, const char* textEnd,
+                                   const std::string& separators,
+                                   const std::string& commentCharacters,
+                                   const bool areCommentsRemovedFromLineEnds,
+                                   const int numberOfColumns,
+                                   const unsigned int numberOfThreads )
+{
+    const TextLineSplitter lineSplitter( separators, commentCharacters, areCommentsRemovedFromLineEnds );
+
+    // Determine number of columns from first data line, if required.
+    int matrixColumns = numberOfColumns;
+    if( matrixColumns < 0 )
+    {
+        matrixColumns = 0;
+        for( const char* lineStart = textStart; lineStart < textEnd; )
+        {
+            const char* lineEnd = findLineEnd( lineStart, textEnd );
+            const char* dataEnd = lineSplitter.getDataEnd( lineStart, lineEnd );
+            if( dataEnd != NULL )
+            {
+                const char* fieldStart;
+                while( lineSplitter.getNextField( lineStart, dataEnd, fieldStart ) )
+                {
+                    matrixColumns++;
+                }
+                break;
+            }
+            lineStart = getNextLineStart( lineEnd, textEnd );
+        }
+    }
+
+    // Split text into chunks at line boundaries (each chunk contains the lines that start in it).
+    const std::ptrdiff_t textSize = textEnd - textStart;
+    const unsigned int numberOfChunks = static_cast< unsigned int >(
+                std::max( static_cast< std::ptrdiff_t >( 1 ),
+                          std::min( static_cast< std::ptrdiff_t >( numberOfThreads ),
+                                    textSize / MINIMUM_CHUNK_SIZE ) ) );
+    std::vector< const char* > chunkStarts( numberOfChunks + 1, textEnd );
+    chunkStarts[ 0 ] = textStart;
+    for( unsigned int i = 1; i < numberOfChunks; i++ )
+    {
+        const char* chunkStart = getNextLineStart(
+                    findLineEnd( textStart + i * ( textSize / numberOfChunks ), textEnd ), textEnd );
+        chunkStarts[ i ] = std::max( chunkStart, chunkStarts[ i - 1 ] );
+    }
+
+    // Count data lines in each chunk.
+    std::vector< int > numberOfChunkRows( numberOfChunks, 0 );
+    utilities::executeParallelLoop( numberOfChunks, [ & ]( const unsigned int chunkIndex )
+    {
+        for( const char* lineStart = chunkStarts[ chunkIndex ]; lineStart < chunkStarts[ chunkIndex + 1 ]; )
+        {
+            const char* lineEnd = findLineEnd( lineStart, textEnd );
+            if( lineSplitter.getDataEnd( lineStart, lineEnd ) != NULL )
+            {
+                numberOfChunkRows[ chunkIndex ]++;
+            }
+            lineStart = getNextLineStart( lineEnd, textEnd );
+        }
+    }, numberOfThreads );
+
+    std::vector< int > chunkFirstRows( numberOfChunks + 1, 0 );
+    for( unsigned int i = 0; i < numberOfChunks; i++ )
+    {
+        chunkFirstRows[ i + 1 ] = chunkFirstRows[ i ] + numberOfChunkRows[ i ];
+    }
+    if( chunkFirstRows[ numberOfChunks ] == 0 )
+    {
+        return Eigen::MatrixXd( );
+    }
+
+    // Parse fields of each chunk directly into its rows of the matrix.
+    Eigen::MatrixXd dataMatrix( chunkFirstRows[ numberOfChunks ], matrixColumns );
+    utilities::executeParallelLoop( numberOfChunks, [ & ]( const unsigned int chunkIndex )
+    {
+        int rowIndex = chunkFirstRows[ chunkIndex ];
+        for( const char* lineStart = chunkStarts[ chunkIndex ]; lineStart < chunkStarts[ chunkIndex + 1 ]; )
+        {
+            const char* lineEnd = findLineEnd( lineStart, textEnd );
+            const char* dataEnd = lineSplitter.getDataEnd( lineStart, lineEnd );
+            if( dataEnd != NULL )
+            {
+                const char* position = lineStart;
+                const char* fieldStart;
+                int columnIndex = 0;
+                while( lineSplitter.getNextField( position, dataEnd, fieldStart ) )
+                {
+                    if( columnIndex < matrixColumns &&
+                            !convertTextToDouble( fieldStart, position, dataMatrix( rowIndex, columnIndex ) ) )
+                    {
+                        throw std::runtime_error(
+                                    boost::str( boost::format( "Could not convert entry '%1%' in row %2% to a "
+                                                               "number." )
+                                                % std::string( fieldStart, position ) % rowIndex ) );
+                    }
+                    columnIndex++;
+                }
+
+                if( columnIndex != matrixColumns )
+                {
+                    throw std::runtime_error(
+                                boost::str( boost::format( "Number of columns in row %1% is %2%; should be %3%." )
+                                            % rowIndex % columnIndex % matrixColumns ) );
+                }
+                rowIndex++;
+            }
+            lineStart = getNextLineStart( lineEnd, textEnd );
+        }
+    }, numberOfThreads );
+
+    return dataMatrix;
+}
+
+} // namespace input_output
+} // namespace tudat
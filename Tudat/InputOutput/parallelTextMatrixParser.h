@@ -0,0 +1,58 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_PARALLEL_TEXT_MATRIX_PARSER_H
+#define TUDAT_PARALLEL_TEXT_MATRIX_PARSER_H
+
+#include <string>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Function to parse a block of text with separated numbers into a matrix, in parallel.
+/*!
+ *  Function to parse a block of text (typically a memory-mapped file, or part of it) with separated numbers into a
+ *  matrix, in which each data line of the text becomes a row. The text is split at line boundaries into chunks, which
+ *  are parsed concurrently: the data lines of all chunks are first counted, after which the matrix is allocated once
+ *  and each chunk converts its fields (without creating intermediate strings, see textFieldConversions.h) directly
+ *  into its rows of the matrix.
+ *
+ *  Fields are separated by any number of separator characters (consecutive separators are merged, and leading and
+ *  trailing separators are ignored); spaces and carriage returns are always separators. Lines that are blank after the
+ *  removal of comments are skipped.
+ *  \param textStart Pointer to the start of the text.
+ *  \param textEnd Pointer to one beyond the end of the text.
+ *  \param separators Characters that separate the fields (in addition to spaces).
+ *  \param commentCharacters Characters that start a comment.
+ *  \param areCommentsRemovedFromLineEnds Boolean denoting whether a comment character removes the remainder of the
+ *  line wherever it occurs (true), or only marks the line as comment if it is its first non-whitespace character.
+ *  \param numberOfColumns Number of columns of the matrix; if negative, the number of fields in the first data line
+ *  is used.
+ *  \param numberOfThreads Number of threads that is used to parse the text.
+ *  \return Matrix with one row per data line (empty matrix if the text contains no data lines).
+ *  \throws std::runtime_error If a data line has a number of fields different from the number of columns, or a field
+ *  could not be converted to a double (the message of the first error in the text is used).
+ */
+Eigen::MatrixXd parseTextToMatrix( const char* textStart, const char* textEnd,
+                                   const std::string& separators,
+                                   const std::string& commentCharacters,
+                                   const bool areCommentsRemovedFromLineEnds,
+                                   const int numberOfColumns = -1,
+                                   const unsigned int numberOfThreads = 1 );
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_PARALLEL_TEXT_MATRIX_PARSER_H
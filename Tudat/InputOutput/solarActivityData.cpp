@@ -15,20 +15,18 @@
  *
  */
 
+#include <fstream>
 #include <istream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
-#include <boost/test/unit_test.hpp>
 
-#include "Tudat/Basics/testMacros.h"
 #include "Tudat/InputOutput/solarActivityData.h"
-#include "Tudat/InputOutput/solarActivityData.h"
-#include "Tudat/InputOutput/parsedDataVectorUtilities.h"
-#include "Tudat/InputOutput/parseSolarActivityData.h"
-#include "Tudat/InputOutput/extractSolarActivityData.h"
-#include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/InputOutput/typedTextParser.h"
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
 
 namespace tudat
@@ -95,39 +93,191 @@ std::ostream& operator<<( std::ostream& stream,
     return stream;
 }
 
+namespace
+{
+
+//! Function to create the parser for the data lines of a space weather file.
+/*!
+ *  Function to create the parser for the data lines of a space weather file, with the columns and widths of the
+ *  fields as in ParseSolarActivityData (excluding the data type, which is determined from the section of the file). The
+ *  first Kp field and the Cp field have a negative blank value, by which blank fields are detected.
+ */
+TypedTextParser createSolarActivityDataParser( )
+{
+    std::vector< TypedTextColumn > columns;
+
+    // Year, month, day, Bartels solar rotation number and day of Bartels cycle.
+    columns.push_back( TypedTextColumn( integer_column, 4 ) );
+    columns.push_back( TypedTextColumn( integer_column, 3 ) );
+    columns.push_back( TypedTextColumn( integer_column, 3 ) );
+    columns.push_back( TypedTextColumn( integer_column, 5 ) );
+    columns.push_back( TypedTextColumn( integer_column, 3 ) );
+
+    // Kp values and sum, Ap values and average.
+    columns.push_back( TypedTextColumn( integer_column, 3, -1.0 ) );
+    for( unsigned int i = 1; i < 8; i++ )
+    {
+        columns.push_back( TypedTextColumn( integer_column, 3, 0.0 ) );
+    }
+    for( unsigned int i = 0; i < 10; i++ )
+    {
+        columns.push_back( TypedTextColumn( integer_column, 4, 0.0 ) );
+    }
+
+    // Cp, C9, ISN, F10.7 (adjusted), Q, and 81-day averages and F10.7 (observed).
+    columns.push_back( TypedTextColumn( double_column, 4, -1.0 ) );
+    columns.push_back( TypedTextColumn( integer_column, 2, 0.0 ) );
+    columns.push_back( TypedTextColumn( integer_column, 4, 0.0 ) );
+    columns.push_back( TypedTextColumn( double_column, 6, -0.0 ) );
+    columns.push_back( TypedTextColumn( integer_column, 2, 0.0 ) );
+    for( unsigned int i = 0; i < 5; i++ )
+    {
+        columns.push_back( TypedTextColumn( double_column, 6, -0.0 ) );
+    }
+
+    return TypedTextParser( columns );
+}
+
+//! Function to determine the data type of the section started by a line of a space weather file.
+/*!
+ *  Function to determine the data type of the section started by a line of a space weather file.
+ *  \param line Line of the space weather file.
+ *  \return Data type of the section started by the line (1: observed, 2: daily predicted, 3: monthly predicted,
+ *  4: monthly fit), 0 if the line ends a section, -1 if the line neither starts nor ends a section.
+ */
+int getSectionDataType( const std::string& line )
+{
+    if( line.compare( 0, 14, "BEGIN OBSERVED" ) == 0 )
+    {
+        return 1;
+    }
+    else if( line.compare( 0, 21, "BEGIN DAILY_PREDICTED" ) == 0 )
+    {
+        return 2;
+    }
+    else if( line.compare( 0, 23, "BEGIN MONTHLY_PREDICTED" ) == 0 )
+    {
+        return 3;
+    }
+    else if( line.compare( 0, 17, "BEGIN MONTHLY_FIT" ) == 0 )
+    {
+        return 4;
+    }
+    else if( line.compare( 0, 12, "END OBSERVED" ) == 0 || line.compare( 0, 19, "END DAILY_PREDICTED" ) == 0 ||
+             line.compare( 0, 21, "END MONTHLY_PREDICTED" ) == 0 || line.compare( 0, 15, "END MONTHLY_FIT" ) == 0 )
+    {
+        return 0;
+    }
+    return -1;
+}
+
+} // namespace
+
 //! This function reads a SpaceWeather data file and returns a map with SolarActivityData
 SolarActivityDataMap readSolarActivityData( std::string filePath )
 {
-    // Data Vector container
-    tudat::input_output::parsed_data_vector_utilities::ParsedDataVectorPtr parsedDataVector;
+    std::ifstream dataFile( filePath.c_str( ), std::ios::binary );
+    if( !dataFile.good( ) )
+    {
+        throw std::runtime_error( "Error, space weather file " + filePath + " could not be opened." );
+    }
 
-    // datafile Parser and Extractor
-    tudat::input_output::solar_activity::ParseSolarActivityData solarActivityParser;
-    tudat::input_output::solar_activity::ExtractSolarActivityData solarActivityExtractor;
+    // Parse the data lines of all sections into typed columns.
+    const TypedTextParser solarActivityParser = createSolarActivityDataParser( );
+    TypedTextTable dataTable;
+    std::vector< unsigned int > dataTypes;
 
+    std::string line;
+    unsigned int lineNumber = 0;
+    unsigned int dataType = 0;
+    while( std::getline( dataFile, line ) )
+    {
+        lineNumber++;
+        if( !line.empty( ) && line[ line.size( ) - 1 ] == '\r' )
+        {
+            line.resize( line.size( ) - 1 );
+        }
 
-    // Open dataFile and Parse
-    std::ifstream dataFile;
-    dataFile.open( filePath.c_str( ), std::ifstream::in );
-    parsedDataVector = solarActivityParser.parse( dataFile );
-    dataFile.close( );
+        const int sectionDataType = getSectionDataType( line );
+        if( sectionDataType >= 0 )
+        {
+            dataType = static_cast< unsigned int >( sectionDataType );
+        }
+        else if( dataType > 0 )
+        {
+            try
+            {
+                solarActivityParser.parseLine( line, dataTable );
+            }
+            catch( std::runtime_error& error )
+            {
+                throw std::runtime_error( "Error when parsing line " + boost::lexical_cast< std::string >( lineNumber ) +
+                                          " of space weather file " + filePath + ": " + error.what( ) );
+            }
+            dataTypes.push_back( dataType );
+        }
+    }
+
+    // Create solar activity data from the columns.
+    std::vector< const std::vector< int >* > integerColumns( 33, NULL );
+    std::vector< const std::vector< double >* > doubleColumns( 33, NULL );
+    for( unsigned int i = 0; i < 33; i++ )
+    {
+        if( i == 23 || i == 26 || i >= 28 )
+        {
+            doubleColumns[ i ] = &dataTable.getDoubleColumn( i );
+        }
+        else
+        {
+            integerColumns[ i ] = &dataTable.getIntegerColumn( i );
+        }
+    }
 
-    int numberOfLines = parsedDataVector->size( );
     SolarActivityDataMap dataMap;
-    double julianDate = TUDAT_NAN;
-
-    // Save each line to datamap
-    for(int i = 0 ; i < numberOfLines ; i++ ){
-        julianDate = tudat::basic_astrodynamics::convertCalendarDateToJulianDay(
-                    solarActivityExtractor.extract( parsedDataVector->at( i ) )->year,
-                    solarActivityExtractor.extract( parsedDataVector->at( i ) )->month,
-                    solarActivityExtractor.extract( parsedDataVector->at( i ) )->day,
-                    0, 0, 0.0 ) ;
-        dataMap[ julianDate ] = solarActivityExtractor.extract( parsedDataVector->at( i ) ) ;
+    for( unsigned int j = 0; j < dataTable.getNumberOfRows( ); j++ )
+    {
+        SolarActivityDataPtr solarActivityData = boost::make_shared< SolarActivityData >( );
+        solarActivityData->year = ( *integerColumns[ 0 ] )[ j ];
+        solarActivityData->month = ( *integerColumns[ 1 ] )[ j ];
+        solarActivityData->day = ( *integerColumns[ 2 ] )[ j ];
+        solarActivityData->bartelsSolarRotationNumber = ( *integerColumns[ 3 ] )[ j ];
+        solarActivityData->dayOfBartelsCycle = ( *integerColumns[ 4 ] )[ j ];
+
+        // Kp and Ap values are only set if the first Kp field is not blank.
+        if( ( *integerColumns[ 5 ] )[ j ] >= 0 )
+        {
+            for( unsigned int i = 0; i < 8; i++ )
+            {
+                solarActivityData->planetaryRangeIndexVector( i ) = ( *integerColumns[ 5 + i ] )[ j ];
+                solarActivityData->planetaryEquivalentAmplitudeVector( i ) = ( *integerColumns[ 14 + i ] )[ j ];
+            }
+            solarActivityData->planetaryRangeIndexSum = ( *integerColumns[ 13 ] )[ j ];
+            solarActivityData->planetaryEquivalentAmplitudeAverage = ( *integerColumns[ 22 ] )[ j ];
+        }
+
+        // Cp and C9 are only set if the Cp field is not blank.
+        if( ( *doubleColumns[ 23 ] )[ j ] >= 0.0 )
+        {
+            solarActivityData->planetaryDailyCharacterFigure = ( *doubleColumns[ 23 ] )[ j ];
+            solarActivityData->planetaryDailyCharacterFigureConverted = ( *integerColumns[ 24 ] )[ j ];
+        }
+
+        solarActivityData->internationalSunspotNumber = ( *integerColumns[ 25 ] )[ j ];
+        solarActivityData->solarRadioFlux107Adjusted = ( *doubleColumns[ 26 ] )[ j ];
+        solarActivityData->fluxQualifier = ( *integerColumns[ 27 ] )[ j ];
+        solarActivityData->centered81DaySolarRadioFlux107Adjusted = ( *doubleColumns[ 28 ] )[ j ];
+        solarActivityData->last81DaySolarRadioFlux107Adjusted = ( *doubleColumns[ 29 ] )[ j ];
+        solarActivityData->solarRadioFlux107Observed = ( *doubleColumns[ 30 ] )[ j ];
+        solarActivityData->centered81DaySolarRadioFlux107Observed = ( *doubleColumns[ 31 ] )[ j ];
+        solarActivityData->last81DaySolarRadioFlux107Observed = ( *doubleColumns[ 32 ] )[ j ];
+        solarActivityData->dataType = dataTypes[ j ];
+
+        dataMap[ tudat::basic_astrodynamics::convertCalendarDateToJulianDay(
+                    solarActivityData->year, solarActivityData->month, solarActivityData->day, 0, 0, 0.0 ) ] =
+                solarActivityData;
     }
 
     return dataMap;
-
 }
 
 } // solar_activity
@@ -171,10 +171,15 @@ typedef std::map< double , SolarActivityDataPtr >  SolarActivityDataMap ;
 
 //! Function that reads a SpaceWeather data file
 /*!
- * This function reads a SpaceWeather data file and returns a map with SolarActivityData
+ * This function reads a SpaceWeather data file and returns a map with SolarActivityData. The data lines are converted
+ * directly to typed columns by a TypedTextParser (with the same field layout as ParseSolarActivityData), without
+ * creating the intermediate ParsedDataVector. Blank Kp, Cp, ISN and Q fields are treated as in
+ * ExtractSolarActivityData. Note that a file that can not be opened results in an exception; previous versions of
+ * this function silently returned an empty map in that case.
  *
  * \param filePath std::string
  * \return solarActivityDataMap std::map< double , SolarActivityDataPtr >
+ * \throws std::runtime_error If the file could not be opened, or a data line could not be parsed.
  */
 SolarActivityDataMap readSolarActivityData( std::string filePath ) ;
 
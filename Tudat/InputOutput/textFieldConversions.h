@@ -0,0 +1,244 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_TEXT_FIELD_CONVERSIONS_H
+#define TUDAT_TEXT_FIELD_CONVERSIONS_H
+
+#include <cstdlib>
+#include <limits>
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Function to determine whether a text field contains only whitespace.
+/*!
+ *  Function to determine whether a text field contains only whitespace (spaces, tabs and carriage returns).
+ *  \param fieldStart Pointer to the first character of the field.
+ *  \param fieldEnd Pointer to one beyond the last character of the field.
+ *  \return True if the field is empty or contains only whitespace.
+ */
+inline bool isTextFieldBlank( const char* fieldStart, const char* fieldEnd )
+{
+    for( ; fieldStart < fieldEnd; fieldStart++ )
+    {
+        if( *fieldStart != ' ' && *fieldStart != '\t' && *fieldStart != '\r' )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Function to remove leading and trailing whitespace from a text field.
+/*!
+ *  Function to remove leading and trailing whitespace (spaces, tabs and carriage returns) from a text field, by moving
+ *  the pointers to its start and end.
+ *  \param fieldStart Pointer to the first character of the field (modified by this function).
+ *  \param fieldEnd Pointer to one beyond the last character of the field (modified by this function).
+ */
+inline void trimTextField( const char*& fieldStart, const char*& fieldEnd )
+{
+    while( fieldStart < fieldEnd && ( *fieldStart == ' ' || *fieldStart == '\t' || *fieldStart == '\r' ) )
+    {
+        fieldStart++;
+    }
+    while( fieldEnd > fieldStart && ( *( fieldEnd - 1 ) == ' ' || *( fieldEnd - 1 ) == '\t' ||
+                                      *( fieldEnd - 1 ) == '\r' ) )
+    {
+        fieldEnd--;
+    }
+}
+
+//! Function to convert a text field to an integer.
+/*!
+ *  Function to convert a text field, consisting of an optional sign followed by digits (with optional leading and
+ *  trailing whitespace), to an integer, without creating any intermediate string or stream.
+ *  \param fieldStart Pointer to the first character of the field.
+ *  \param fieldEnd Pointer to one beyond the last character of the field.
+ *  \param value Converted value (returned by reference, only modified if conversion succeeds).
+ *  \return True if the field contains a valid integer that fits in an int, false otherwise.
+ */
+inline bool convertTextToInteger( const char* fieldStart, const char* fieldEnd, int& value )
+{
+    trimTextField( fieldStart, fieldEnd );
+
+    bool isNegative = false;
+    if( fieldStart < fieldEnd && ( *fieldStart == '-' || *fieldStart == '+' ) )
+    {
+        isNegative = ( *fieldStart == '-' );
+        fieldStart++;
+    }
+    if( fieldStart == fieldEnd )
+    {
+        return false;
+    }
+
+    long long absoluteValue = 0;
+    for( ; fieldStart < fieldEnd; fieldStart++ )
+    {
+        if( *fieldStart < '0' || *fieldStart > '9' )
+        {
+            return false;
+        }
+        absoluteValue = 10 * absoluteValue + ( *fieldStart - '0' );
+        if( absoluteValue > static_cast< long long >( std::numeric_limits< int >::max( ) ) + 1 )
+        {
+            return false;
+        }
+    }
+
+    const long long signedValue = isNegative ? -absoluteValue : absoluteValue;
+    if( signedValue > std::numeric_limits< int >::max( ) )
+    {
+        return false;
+    }
+    value = static_cast< int >( signedValue );
+    return true;
+}
+
+//! Function to convert a text field to a double.
+/*!
+ *  Function to convert a text field, containing a decimal number with optional sign, decimal point and exponent (with
+ *  'e', 'E', or the Fortran 'd' or 'D'), and optional leading and trailing whitespace, to a double. Numbers with up to
+ *  15 significant digits and a decimal exponent of at most 22 in magnitude (which includes all numbers in typical data
+ *  files) are converted by a single correctly rounded floating-point operation, without creating any intermediate
+ *  string or stream; other numbers are converted by std::strtod.
+ *  \param fieldStart Pointer to the first character of the field.
+ *  \param fieldEnd Pointer to one beyond the last character of the field.
+ *  \param value Converted value (returned by reference, only modified if conversion succeeds).
+ *  \return True if the field contains a valid number, false otherwise.
+ */
+inline bool convertTextToDouble( const char* fieldStart, const char* fieldEnd, double& value )
+{
+    static const double powersOfTen[ ] = { 1.0E0, 1.0E1, 1.0E2, 1.0E3, 1.0E4, 1.0E5, 1.0E6, 1.0E7, 1.0E8, 1.0E9,
+                                           1.0E10, 1.0E11, 1.0E12, 1.0E13, 1.0E14, 1.0E15, 1.0E16, 1.0E17, 1.0E18,
+                                           1.0E19, 1.0E20, 1.0E21, 1.0E22 };
+
+    trimTextField( fieldStart, fieldEnd );
+    const char* numberStart = fieldStart;
+
+    bool isNegative = false;
+    if( fieldStart < fieldEnd && ( *fieldStart == '-' || *fieldStart == '+' ) )
+    {
+        isNegative = ( *fieldStart == '-' );
+        fieldStart++;
+    }
+
+    // Read digits of mantissa (leading zeros are not significant).
+    long long mantissa = 0;
+    int numberOfDigits = 0;
+    int numberOfSignificantDigits = 0;
+    int decimalExponent = 0;
+    bool hasDecimalPoint = false;
+    for( ; fieldStart < fieldEnd; fieldStart++ )
+    {
+        if( *fieldStart >= '0' && *fieldStart <= '9' )
+        {
+            numberOfDigits++;
+            if( numberOfSignificantDigits > 0 || *fieldStart != '0' )
+            {
+                numberOfSignificantDigits++;
+            }
+            if( numberOfSignificantDigits <= 15 )
+            {
+                mantissa = 10 * mantissa + ( *fieldStart - '0' );
+                if( hasDecimalPoint )
+                {
+                    decimalExponent--;
+                }
+            }
+            else if( !hasDecimalPoint )
+            {
+                decimalExponent++;
+            }
+        }
+        else if( *fieldStart == '.' && !hasDecimalPoint )
+        {
+            hasDecimalPoint = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+    if( numberOfDigits == 0 )
+    {
+        return false;
+    }
+
+    // Read exponent.
+    if( fieldStart < fieldEnd && ( *fieldStart == 'e' || *fieldStart == 'E' || *fieldStart == 'd' || *fieldStart == 'D' ) )
+    {
+        int exponent;
+        if( !convertTextToInteger( fieldStart + 1, fieldEnd, exponent ) || fieldStart + 1 == fieldEnd ||
+                fieldStart[ 1 ] == ' ' )
+        {
+            return false;
+        }
+        if( exponent > 10000 || exponent < -10000 )
+        {
+            numberOfSignificantDigits = 16;
+        }
+        else
+        {
+            decimalExponent += exponent;
+        }
+        fieldStart = fieldEnd;
+    }
+    if( fieldStart != fieldEnd )
+    {
+        return false;
+    }
+
+    if( numberOfSignificantDigits <= 15 && decimalExponent >= -22 && decimalExponent <= 22 )
+    {
+        // Mantissa is exactly representable, so that a single multiplication or division is correctly rounded.
+        value = static_cast< double >( mantissa );
+        if( decimalExponent < 0 )
+        {
+            value /= powersOfTen[ -decimalExponent ];
+        }
+        else if( decimalExponent > 0 )
+        {
+            value *= powersOfTen[ decimalExponent ];
+        }
+        if( isNegative )
+        {
+            value = -value;
+        }
+        return true;
+    }
+    else
+    {
+        // Convert other numbers with strtod (replacing Fortran exponent character).
+        char numberBuffer[ 64 ];
+        const std::ptrdiff_t numberLength = fieldEnd - numberStart;
+        if( numberLength >= 64 )
+        {
+            return false;
+        }
+        for( std::ptrdiff_t i = 0; i < numberLength; i++ )
+        {
+            numberBuffer[ i ] = ( numberStart[ i ] == 'd' || numberStart[ i ] == 'D' ) ? 'e' : numberStart[ i ];
+        }
+        numberBuffer[ numberLength ] = '\0';
+        char* numberEnd;
+        value = std::strtod( numberBuffer, &numberEnd );
+        return ( numberEnd == numberBuffer + numberLength );
+    }
+}
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_TEXT_FIELD_CONVERSIONS_H
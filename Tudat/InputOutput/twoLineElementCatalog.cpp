@@ -0,0 +1,463 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Celestrak (c). NORAD Two-Line Element Set Format,
+ *          http://celestrak.com/NORAD/documentation/tle-fmt.asp, 2004. Last accessed: 5 August,
+ *          2011.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/physicalConstants.h"
+#include "Tudat/Basics/parallelization.h"
+#include "Tudat/InputOutput/memoryMappedFile.h"
+#include "Tudat/InputOutput/textFieldConversions.h"
+#include "Tudat/InputOutput/twoLineElementCatalog.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+namespace
+{
+
+//! Minimum length of a line of an element set.
+const int MINIMUM_ELEMENT_SET_LINE_LENGTH = 69;
+
+//! Minimum size of a file chunk that is parsed by a separate thread.
+const std::size_t MINIMUM_CHUNK_SIZE = 1 << 20;
+
+//! Function to find the end of a line (position of the newline character, or the end of the file).
+const char* findLineEnd( const char* lineStart, const char* fileEnd )
+{
+    const char* lineEnd = static_cast< const char* >( std::memchr( lineStart, '\n', fileEnd - lineStart ) );
+    return ( lineEnd == NULL ) ? fileEnd : lineEnd;
+}
+
+//! Function to find the start of the next line (one beyond the end of the current line, or the end of the file).
+const char* findNextLine( const char* lineEnd, const char* fileEnd )
+{
+    return ( lineEnd < fileEnd ) ? lineEnd + 1 : fileEnd;
+}
+
+//! Function to determine whether a line is long enough to be a line of an element set (excluding carriage return).
+bool isElementSetLine( const char* lineStart, const char* lineEnd )
+{
+    if( lineEnd > lineStart && *( lineEnd - 1 ) == '\r' )
+    {
+        lineEnd--;
+    }
+    return ( lineEnd - lineStart ) >= MINIMUM_ELEMENT_SET_LINE_LENGTH;
+}
+
+//! Function to find the first line, at or after a given position, that starts an element set.
+/*!
+ *  Function to find the first line, at or after a given position, that starts an element set, i.e. a line starting
+ *  with '1' that is followed by a line starting with '2' (both of sufficient length).
+ *  \param position Position in the file from which to search (need not be the start of a line).
+ *  \param fileStart Pointer to the start of the file.
+ *  \param fileEnd Pointer to the end of the file.
+ *  \return Pointer to the start of the line (or end of the file if no element set is found).
+ */
+const char* findElementSetStart( const char* position, const char* fileStart, const char* fileEnd )
+{
+    const char* currentLine = position;
+    if( currentLine > fileStart && *( currentLine - 1 ) != '\n' )
+    {
+        currentLine = findNextLine( findLineEnd( currentLine, fileEnd ), fileEnd );
+    }
+
+    while( currentLine < fileEnd )
+    {
+        const char* currentLineEnd = findLineEnd( currentLine, fileEnd );
+        const char* nextLine = findNextLine( currentLineEnd, fileEnd );
+        if( *currentLine == '1' && isElementSetLine( currentLine, currentLineEnd ) &&
+                nextLine < fileEnd && *nextLine == '2' && isElementSetLine( nextLine, findLineEnd( nextLine, fileEnd ) ) )
+        {
+            return currentLine;
+        }
+        currentLine = nextLine;
+    }
+    return fileEnd;
+}
+
+//! Function to parse a catalog number (five digits, or Alpha-5 format) from a TLE line.
+bool parseCatalogNumber( const char* field, unsigned int& catalogNumber )
+{
+    int value;
+    if( *field >= 'A' && *field <= 'Z' && *field != 'I' && *field != 'O' )
+    {
+        if( !convertTextToInteger( field + 1, field + 5, value ) || value < 0 )
+        {
+            return false;
+        }
+
+        // Letters I and O are omitted, to avoid confusion with 1 and 0.
+        int letterValue = 10 + ( *field - 'A' );
+        if( *field > 'I' )
+        {
+            letterValue--;
+        }
+        if( *field > 'O' )
+        {
+            letterValue--;
+        }
+        catalogNumber = static_cast< unsigned int >( 10000 * letterValue + value );
+        return true;
+    }
+    else if( convertTextToInteger( field, field + 5, value ) && value >= 0 )
+    {
+        catalogNumber = static_cast< unsigned int >( value );
+        return true;
+    }
+    return false;
+}
+
+//! Function to check the modulo-10 checksum of a TLE line (digits count as their value, minus signs as one).
+bool isChecksumValid( const char* line )
+{
+    unsigned int checksum = 0;
+    for( int i = 0; i < MINIMUM_ELEMENT_SET_LINE_LENGTH - 1; i++ )
+    {
+        if( line[ i ] >= '0' && line[ i ] <= '9' )
+        {
+            checksum += static_cast< unsigned int >( line[ i ] - '0' );
+        }
+        else if( line[ i ] == '-' )
+        {
+            checksum++;
+        }
+    }
+    return ( line[ MINIMUM_ELEMENT_SET_LINE_LENGTH - 1 ] >= '0' && line[ MINIMUM_ELEMENT_SET_LINE_LENGTH - 1 ] <= '9' &&
+             checksum % 10 == static_cast< unsigned int >( line[ MINIMUM_ELEMENT_SET_LINE_LENGTH - 1 ] - '0' ) );
+}
+
+//! Function to compute the number of days from 1 January 2000 to 1 January of a given year (Gregorian calendar).
+int computeDaysSinceStartOfYear2000( const int year )
+{
+    const int previousYear = year - 1;
+    return 365 * ( year - 2000 ) + ( previousYear / 4 - previousYear / 100 + previousYear / 400 ) -
+            ( 1999 / 4 - 1999 / 100 + 1999 / 400 );
+}
+
+//! Function to reorder a column of the catalog.
+template< typename ValueType >
+void reorderColumn( std::vector< ValueType >& column, const std::vector< unsigned int >& order )
+{
+    std::vector< ValueType > reorderedColumn( column.size( ) );
+    for( unsigned int i = 0; i < order.size( ); i++ )
+    {
+        reorderedColumn[ i ] = column[ order[ i ] ];
+    }
+    column.swap( reorderedColumn );
+}
+
+//! Function to append a column of a catalog to the same column of another catalog.
+template< typename ValueType >
+void appendColumn( std::vector< ValueType >& column, const std::vector< ValueType >& columnToAppend )
+{
+    column.insert( column.end( ), columnToAppend.begin( ), columnToAppend.end( ) );
+}
+
+} // namespace
+
+//! Constructor.
+TwoLineElementCatalog::TwoLineElementCatalog( const std::string& filePath, const unsigned int numberOfThreads ):
+    numberOfCorruptedElementSets_( 0 )
+{
+    if( !boost::filesystem::is_regular_file( filePath ) )
+    {
+        throw std::runtime_error( "Error, TLE file " + filePath + " could not be opened." );
+    }
+
+    // Memory-map file (an empty file cannot be mapped, and contains no element sets).
+    const std::size_t fileSize = boost::filesystem::file_size( filePath );
+    if( fileSize > 0 )
+    {
+        const MemoryMappedFile mappedFile( filePath );
+        const char* fileStart = mappedFile.data( );
+        const char* fileEnd = fileStart + mappedFile.size( );
+
+        // Divide file into chunks that start at the first line of an element set.
+        const unsigned int numberOfChunks = static_cast< unsigned int >(
+                    std::max< std::size_t >( 1, std::min< std::size_t >( std::max( numberOfThreads, 1U ),
+                                                                         fileSize / MINIMUM_CHUNK_SIZE ) ) );
+        std::vector< const char* > chunkStarts( numberOfChunks + 1 );
+        chunkStarts[ 0 ] = fileStart;
+        for( unsigned int i = 1; i < numberOfChunks; i++ )
+        {
+            chunkStarts[ i ] = std::max( chunkStarts[ i - 1 ], findElementSetStart(
+                                             fileStart + ( i * fileSize ) / numberOfChunks, fileStart, fileEnd ) );
+        }
+        chunkStarts[ numberOfChunks ] = fileEnd;
+
+        // Parse chunks concurrently.
+        std::vector< boost::shared_ptr< TwoLineElementCatalog > > chunkCatalogs( numberOfChunks );
+        for( unsigned int i = 0; i < numberOfChunks; i++ )
+        {
+            chunkCatalogs[ i ] = boost::shared_ptr< TwoLineElementCatalog >( new TwoLineElementCatalog( ) );
+        }
+        utilities::executeParallelLoop( numberOfChunks, [ & ]( const unsigned int chunkIndex )
+        {
+            chunkCatalogs[ chunkIndex ]->parseElementSets(
+                        chunkStarts[ chunkIndex ], chunkStarts[ chunkIndex + 1 ], fileEnd );
+        }, numberOfThreads );
+
+        // Merge chunks in order of the file.
+        if( numberOfChunks == 1 )
+        {
+            std::swap( *this, *chunkCatalogs[ 0 ] );
+        }
+        else
+        {
+            for( unsigned int i = 0; i < numberOfChunks; i++ )
+            {
+                appendElementSets( *chunkCatalogs[ i ] );
+            }
+        }
+    }
+
+    sortElementSets( );
+}
+
+//! Function to retrieve the range of element sets of an object.
+std::pair< unsigned int, unsigned int > TwoLineElementCatalog::getElementSetIndexRange(
+        const unsigned int catalogNumber ) const
+{
+    const std::vector< unsigned int >::const_iterator objectIterator =
+            std::lower_bound( objectCatalogNumbers_.begin( ), objectCatalogNumbers_.end( ), catalogNumber );
+    const unsigned int objectIndex = objectIterator - objectCatalogNumbers_.begin( );
+    if( objectIterator == objectCatalogNumbers_.end( ) || *objectIterator != catalogNumber )
+    {
+        return std::make_pair( objectStartIndices_[ objectIndex ], objectStartIndices_[ objectIndex ] );
+    }
+    return std::make_pair( objectStartIndices_[ objectIndex ], objectStartIndices_[ objectIndex + 1 ] );
+}
+
+//! Function to retrieve the index of the element set of an object that applies at a given epoch.
+int TwoLineElementCatalog::getElementSetIndex( const unsigned int catalogNumber, const double epoch ) const
+{
+    const std::pair< unsigned int, unsigned int > indexRange = getElementSetIndexRange( catalogNumber );
+    if( indexRange.first == indexRange.second )
+    {
+        return -1;
+    }
+
+    // Find first element set after epoch, and select the one before it.
+    const int index = static_cast< int >(
+                std::upper_bound( epochs_.begin( ) + indexRange.first, epochs_.begin( ) + indexRange.second, epoch ) -
+                epochs_.begin( ) ) - 1;
+    return std::max( index, static_cast< int >( indexRange.first ) );
+}
+
+//! Function to append the element sets of another catalog (parsed from a chunk of the file) to this catalog.
+void TwoLineElementCatalog::appendElementSets( const TwoLineElementCatalog& chunkCatalog )
+{
+    numberOfCorruptedElementSets_ += chunkCatalog.numberOfCorruptedElementSets_;
+
+    appendColumn( catalogNumbers_, chunkCatalog.catalogNumbers_ );
+    appendColumn( classifications_, chunkCatalog.classifications_ );
+    appendColumn( epochs_, chunkCatalog.epochs_ );
+    appendColumn( firstDerivativesOfMeanMotionDividedByTwo_, chunkCatalog.firstDerivativesOfMeanMotionDividedByTwo_ );
+    appendColumn( secondDerivativesOfMeanMotionDividedBySix_, chunkCatalog.secondDerivativesOfMeanMotionDividedBySix_ );
+    appendColumn( bStars_, chunkCatalog.bStars_ );
+    appendColumn( elementSetNumbers_, chunkCatalog.elementSetNumbers_ );
+    appendColumn( inclinations_, chunkCatalog.inclinations_ );
+    appendColumn( rightAscensionsOfAscendingNode_, chunkCatalog.rightAscensionsOfAscendingNode_ );
+    appendColumn( eccentricities_, chunkCatalog.eccentricities_ );
+    appendColumn( argumentsOfPerigee_, chunkCatalog.argumentsOfPerigee_ );
+    appendColumn( meanAnomalies_, chunkCatalog.meanAnomalies_ );
+    appendColumn( meanMotions_, chunkCatalog.meanMotions_ );
+    appendColumn( revolutionNumbers_, chunkCatalog.revolutionNumbers_ );
+}
+
+//! Function to sort the element sets by catalog number and epoch, and create the index of objects.
+void TwoLineElementCatalog::sortElementSets( )
+{
+    const unsigned int numberOfElementSets = catalogNumbers_.size( );
+
+    // Determine order of element sets (element sets with equal epoch retain their order in the file).
+    std::vector< unsigned int > order( numberOfElementSets );
+    bool isSorted = true;
+    for( unsigned int i = 0; i < numberOfElementSets; i++ )
+    {
+        order[ i ] = i;
+        if( i > 0 && ( catalogNumbers_[ i ] < catalogNumbers_[ i - 1 ] ||
+                       ( catalogNumbers_[ i ] == catalogNumbers_[ i - 1 ] && epochs_[ i ] < epochs_[ i - 1 ] ) ) )
+        {
+            isSorted = false;
+        }
+    }
+
+    if( !isSorted )
+    {
+        std::stable_sort( order.begin( ), order.end( ), [ this ]( const unsigned int first, const unsigned int second )
+        {
+            return ( catalogNumbers_[ first ] < catalogNumbers_[ second ] ) ||
+                    ( catalogNumbers_[ first ] == catalogNumbers_[ second ] && epochs_[ first ] < epochs_[ second ] );
+        } );
+
+        reorderColumn( catalogNumbers_, order );
+        reorderColumn( classifications_, order );
+        reorderColumn( epochs_, order );
+        reorderColumn( firstDerivativesOfMeanMotionDividedByTwo_, order );
+        reorderColumn( secondDerivativesOfMeanMotionDividedBySix_, order );
+        reorderColumn( bStars_, order );
+        reorderColumn( elementSetNumbers_, order );
+        reorderColumn( inclinations_, order );
+        reorderColumn( rightAscensionsOfAscendingNode_, order );
+        reorderColumn( eccentricities_, order );
+        reorderColumn( argumentsOfPerigee_, order );
+        reorderColumn( meanAnomalies_, order );
+        reorderColumn( meanMotions_, order );
+        reorderColumn( revolutionNumbers_, order );
+    }
+
+    // Create index of objects.
+    objectCatalogNumbers_.clear( );
+    objectStartIndices_.clear( );
+    for( unsigned int i = 0; i < numberOfElementSets; i++ )
+    {
+        if( i == 0 || catalogNumbers_[ i ] != catalogNumbers_[ i - 1 ] )
+        {
+            objectCatalogNumbers_.push_back( catalogNumbers_[ i ] );
+            objectStartIndices_.push_back( i );
+        }
+    }
+    objectStartIndices_.push_back( numberOfElementSets );
+}
+
+//! Function to parse all element sets in a part of a memory-mapped file.
+void TwoLineElementCatalog::parseElementSets( const char* chunkStart, const char* chunkEnd, const char* fileEnd )
+{
+    // Reserve memory for the typical size of an element set in a 3-line file.
+    const std::size_t expectedNumberOfElementSets = ( chunkEnd - chunkStart ) / 140 + 1;
+    catalogNumbers_.reserve( expectedNumberOfElementSets );
+    classifications_.reserve( expectedNumberOfElementSets );
+    epochs_.reserve( expectedNumberOfElementSets );
+    firstDerivativesOfMeanMotionDividedByTwo_.reserve( expectedNumberOfElementSets );
+    secondDerivativesOfMeanMotionDividedBySix_.reserve( expectedNumberOfElementSets );
+    bStars_.reserve( expectedNumberOfElementSets );
+    elementSetNumbers_.reserve( expectedNumberOfElementSets );
+    inclinations_.reserve( expectedNumberOfElementSets );
+    rightAscensionsOfAscendingNode_.reserve( expectedNumberOfElementSets );
+    eccentricities_.reserve( expectedNumberOfElementSets );
+    argumentsOfPerigee_.reserve( expectedNumberOfElementSets );
+    meanAnomalies_.reserve( expectedNumberOfElementSets );
+    meanMotions_.reserve( expectedNumberOfElementSets );
+    revolutionNumbers_.reserve( expectedNumberOfElementSets );
+
+    const char* currentLine = chunkStart;
+    while( currentLine < chunkEnd )
+    {
+        const char* currentLineEnd = findLineEnd( currentLine, fileEnd );
+        const char* nextLine = findNextLine( currentLineEnd, fileEnd );
+
+        // Lines that are too short to be part of an element set (such as object names) are skipped.
+        if( isElementSetLine( currentLine, currentLineEnd ) )
+        {
+            const char* nextLineEnd = findLineEnd( nextLine, fileEnd );
+            if( nextLine < fileEnd && isElementSetLine( nextLine, nextLineEnd ) )
+            {
+                if( !parseElementSet( currentLine, nextLine ) )
+                {
+                    numberOfCorruptedElementSets_++;
+                }
+                nextLine = findNextLine( nextLineEnd, fileEnd );
+            }
+            else
+            {
+                // Element set line without second line.
+                numberOfCorruptedElementSets_++;
+            }
+        }
+        currentLine = nextLine;
+    }
+}
+
+//! Function to parse a single element set, and append it to this catalog if it passes the integrity checks.
+bool TwoLineElementCatalog::parseElementSet( const char* line1, const char* line2 )
+{
+    // Check line numbers, catalog numbers, classification, ephemeris type and checksums.
+    if( line1[ 0 ] != '1' || line2[ 0 ] != '2' || std::memcmp( line1 + 2, line2 + 2, 5 ) != 0 ||
+            ( line1[ 7 ] != 'U' && line1[ 7 ] != 'C' && line1[ 7 ] != 'S' ) || line1[ 62 ] != '0' ||
+            !isChecksumValid( line1 ) || !isChecksumValid( line2 ) )
+    {
+        return false;
+    }
+
+    // Parse line 1 (see Celestrak (c), 2004, for the columns of the fields).
+    unsigned int catalogNumber;
+    int epochYear, secondDerivativeExponent, bStarExponent, elementSetNumber;
+    double epochDay, firstDerivativeOfMeanMotionDividedByTwo, secondDerivativeCoefficient, bStarCoefficient;
+    if( !parseCatalogNumber( line1 + 2, catalogNumber ) ||
+            !convertTextToInteger( line1 + 18, line1 + 20, epochYear ) ||
+            !convertTextToDouble( line1 + 20, line1 + 32, epochDay ) ||
+            !convertTextToDouble( line1 + 33, line1 + 43, firstDerivativeOfMeanMotionDividedByTwo ) ||
+            !convertTextToDouble( line1 + 44, line1 + 50, secondDerivativeCoefficient ) ||
+            !convertTextToInteger( line1 + 50, line1 + 52, secondDerivativeExponent ) ||
+            !convertTextToDouble( line1 + 53, line1 + 59, bStarCoefficient ) ||
+            !convertTextToInteger( line1 + 59, line1 + 61, bStarExponent ) ||
+            !convertTextToInteger( line1 + 64, line1 + 68, elementSetNumber ) )
+    {
+        return false;
+    }
+
+    // Parse line 2.
+    int revolutionNumber;
+    double inclination, rightAscensionOfAscendingNode, eccentricity, argumentOfPerigee, meanAnomaly, meanMotion;
+    if( !convertTextToDouble( line2 + 8, line2 + 16, inclination ) ||
+            !convertTextToDouble( line2 + 17, line2 + 25, rightAscensionOfAscendingNode ) ||
+            !convertTextToDouble( line2 + 26, line2 + 33, eccentricity ) ||
+            !convertTextToDouble( line2 + 34, line2 + 42, argumentOfPerigee ) ||
+            !convertTextToDouble( line2 + 43, line2 + 51, meanAnomaly ) ||
+            !convertTextToDouble( line2 + 52, line2 + 63, meanMotion ) ||
+            !convertTextToInteger( line2 + 63, line2 + 68, revolutionNumber ) )
+    {
+        return false;
+    }
+
+    // Compute epoch from two-digit year (57-99 in 1900s, 00-56 in 2000s) and day of year (1.0 at start of year).
+    const int fourDigitEpochYear = ( epochYear > 56 ) ? epochYear + 1900 : epochYear + 2000;
+    const double epoch = ( static_cast< double >( computeDaysSinceStartOfYear2000( fourDigitEpochYear ) ) +
+                           ( epochDay - 1.0 ) - 0.5 ) * physical_constants::JULIAN_DAY;
+
+    catalogNumbers_.push_back( catalogNumber );
+    classifications_.push_back( line1[ 7 ] );
+    epochs_.push_back( epoch );
+    firstDerivativesOfMeanMotionDividedByTwo_.push_back( firstDerivativeOfMeanMotionDividedByTwo );
+
+    // Apply implied leading decimal point of coefficients of exponential fields.
+    secondDerivativesOfMeanMotionDividedBySix_.push_back(
+                secondDerivativeCoefficient / 100000.0 * std::pow( 10.0, static_cast< double >( secondDerivativeExponent ) ) );
+    bStars_.push_back( bStarCoefficient / 100000.0 * std::pow( 10.0, static_cast< double >( bStarExponent ) ) );
+    elementSetNumbers_.push_back( static_cast< unsigned int >( elementSetNumber ) );
+
+    // Apply implied leading decimal point of eccentricity.
+    inclinations_.push_back( inclination );
+    rightAscensionsOfAscendingNode_.push_back( rightAscensionOfAscendingNode );
+    eccentricities_.push_back( eccentricity / 10000000.0 );
+    argumentsOfPerigee_.push_back( argumentOfPerigee );
+    meanAnomalies_.push_back( meanAnomaly );
+    meanMotions_.push_back( meanMotion );
+    revolutionNumbers_.push_back( static_cast< unsigned int >( revolutionNumber ) );
+
+    return true;
+}
+
+} // namespace input_output
+} // namespace tudat
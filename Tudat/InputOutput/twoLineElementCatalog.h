@@ -0,0 +1,255 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Celestrak (b). FAQs: Two-Line Element Set Format,
+ *          http://celestrak.com/columns/v04n03/, 2006. Last accessed: 5 August, 2011.
+ *      Celestrak (c). NORAD Two-Line Element Set Format,
+ *          http://celestrak.com/NORAD/documentation/tle-fmt.asp, 2004. Last accessed: 5 August,
+ *          2011.
+ *
+ */
+
+#ifndef TUDAT_TWO_LINE_ELEMENT_CATALOG_H
+#define TUDAT_TWO_LINE_ELEMENT_CATALOG_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Columnar store of the two-line element sets in a TLE catalog file.
+/*!
+ *  Columnar store of the two-line element (TLE) sets in a catalog or archive file, in which each TLE variable is stored
+ *  in a separate contiguous vector, with one entry per element set. The element sets are sorted by catalog number and,
+ *  for each object, by epoch, so that all element sets of an object form a contiguous range, which is found by a binary
+ *  search. The file is memory-mapped and split into chunks (at line boundaries) that are parsed concurrently, decoding
+ *  each field directly from its fixed columns (see Celestrak (c), 2004), without creating intermediate strings.
+ *
+ *  Both 2-line and 3-line files are supported: any pair of consecutive lines of at least 69 characters is taken to be an
+ *  element set, other lines (such as object names) are skipped. Element sets that fail the integrity checks (line
+ *  numbers, equal catalog numbers on both lines, classification, ephemeris type, modulo-10 checksums and numerical
+ *  fields) are not stored, but are counted. Catalog numbers in Alpha-5 format (letter followed by four digits) are
+ *  converted to their numerical value (A = 10, ..., Z = 33, omitting I and O). All variables are stored in the units of
+ *  the TLE format (degrees, revolutions per day), except for the epoch, which is converted to seconds since J2000 (in
+ *  UTC, without leap seconds).
+ */
+class TwoLineElementCatalog
+{
+public:
+
+    //! Constructor.
+    /*!
+     *  Constructor, reads and parses all element sets in a TLE file.
+     *  \param filePath Path to the TLE file.
+     *  \param numberOfThreads Number of threads that is used to parse the file.
+     *  \throws std::runtime_error If the file could not be opened.
+     */
+    TwoLineElementCatalog( const std::string& filePath, const unsigned int numberOfThreads = 1 );
+
+    //! Function to retrieve the number of (valid) element sets in the catalog.
+    /*!
+     *  Function to retrieve the number of (valid) element sets in the catalog.
+     *  \return Number of element sets in the catalog.
+     */
+    unsigned int getNumberOfElementSets( ) const
+    {
+        return catalogNumbers_.size( );
+    }
+
+    //! Function to retrieve the number of element sets that failed the integrity checks.
+    /*!
+     *  Function to retrieve the number of element sets that failed the integrity checks, and which are not stored.
+     *  \return Number of element sets that failed the integrity checks.
+     */
+    unsigned int getNumberOfCorruptedElementSets( ) const
+    {
+        return numberOfCorruptedElementSets_;
+    }
+
+    //! Function to retrieve the catalog numbers of all objects in the catalog.
+    /*!
+     *  Function to retrieve the catalog numbers of all objects in the catalog (each listed once, in ascending order).
+     *  \return Catalog numbers of all objects in the catalog.
+     */
+    const std::vector< unsigned int >& getObjectCatalogNumbers( ) const
+    {
+        return objectCatalogNumbers_;
+    }
+
+    //! Function to retrieve the range of element sets of an object.
+    /*!
+     *  Function to retrieve the range of indices of the element sets of an object, which are sorted by epoch.
+     *  \param catalogNumber Catalog number of the object.
+     *  \return Pair with first index and one beyond the last index of the element sets of the object (both equal if the
+     *  object is not in the catalog).
+     */
+    std::pair< unsigned int, unsigned int > getElementSetIndexRange( const unsigned int catalogNumber ) const;
+
+    //! Function to retrieve the index of the element set of an object that applies at a given epoch.
+    /*!
+     *  Function to retrieve the index of the element set of an object that applies at a given epoch, which is the last
+     *  element set with an epoch at or before the given epoch (or the first element set of the object, if the given
+     *  epoch precedes all its element sets).
+     *  \param catalogNumber Catalog number of the object.
+     *  \param epoch Epoch, in seconds since J2000.
+     *  \return Index of the element set (-1 if the object is not in the catalog).
+     */
+    int getElementSetIndex( const unsigned int catalogNumber, const double epoch ) const;
+
+    //! Function to retrieve the catalog numbers of the element sets.
+    const std::vector< unsigned int >& getCatalogNumbers( ) const { return catalogNumbers_; }
+
+    //! Function to retrieve the classifications (U, C or S) of the element sets.
+    const std::vector< char >& getClassifications( ) const { return classifications_; }
+
+    //! Function to retrieve the epochs of the element sets, in seconds since J2000.
+    const std::vector< double >& getEpochs( ) const { return epochs_; }
+
+    //! Function to retrieve the first derivatives of the mean motion divided by two, in revolutions per day squared.
+    const std::vector< double >& getFirstDerivativesOfMeanMotionDividedByTwo( ) const
+    {
+        return firstDerivativesOfMeanMotionDividedByTwo_;
+    }
+
+    //! Function to retrieve the second derivatives of the mean motion divided by six, in revolutions per day cubed.
+    const std::vector< double >& getSecondDerivativesOfMeanMotionDividedBySix( ) const
+    {
+        return secondDerivativesOfMeanMotionDividedBySix_;
+    }
+
+    //! Function to retrieve the B* drag terms of the element sets, in inverse Earth radii.
+    const std::vector< double >& getBStars( ) const { return bStars_; }
+
+    //! Function to retrieve the element set numbers of the element sets.
+    const std::vector< unsigned int >& getElementSetNumbers( ) const { return elementSetNumbers_; }
+
+    //! Function to retrieve the inclinations of the element sets, in degrees.
+    const std::vector< double >& getInclinations( ) const { return inclinations_; }
+
+    //! Function to retrieve the right ascensions of the ascending node of the element sets, in degrees.
+    const std::vector< double >& getRightAscensionsOfAscendingNode( ) const
+    {
+        return rightAscensionsOfAscendingNode_;
+    }
+
+    //! Function to retrieve the eccentricities of the element sets.
+    const std::vector< double >& getEccentricities( ) const { return eccentricities_; }
+
+    //! Function to retrieve the arguments of perigee of the element sets, in degrees.
+    const std::vector< double >& getArgumentsOfPerigee( ) const { return argumentsOfPerigee_; }
+
+    //! Function to retrieve the mean anomalies of the element sets, in degrees.
+    const std::vector< double >& getMeanAnomalies( ) const { return meanAnomalies_; }
+
+    //! Function to retrieve the mean motions of the element sets, in revolutions per day.
+    const std::vector< double >& getMeanMotions( ) const { return meanMotions_; }
+
+    //! Function to retrieve the revolution numbers at epoch of the element sets.
+    const std::vector< unsigned int >& getRevolutionNumbers( ) const { return revolutionNumbers_; }
+
+private:
+
+    //! Function to append the element sets of another catalog (parsed from a chunk of the file) to this catalog.
+    /*!
+     *  Function to append the element sets of another catalog (parsed from a chunk of the file) to this catalog.
+     *  \param chunkCatalog Catalog containing the element sets parsed from a chunk of the file.
+     */
+    void appendElementSets( const TwoLineElementCatalog& chunkCatalog );
+
+    //! Function to sort the element sets by catalog number and epoch, and create the index of objects.
+    void sortElementSets( );
+
+    //! Function to parse all element sets in a part of a memory-mapped file.
+    /*!
+     *  Function to parse all element sets of which the first line starts in a given part of a memory-mapped file, and
+     *  append them to this catalog (in order of the file).
+     *  \param chunkStart Pointer to the start of the part of the file (must be the start of a line).
+     *  \param chunkEnd Pointer to the end of the part of the file.
+     *  \param fileEnd Pointer to the end of the file.
+     */
+    void parseElementSets( const char* chunkStart, const char* chunkEnd, const char* fileEnd );
+
+    //! Function to parse a single element set, and append it to this catalog if it passes the integrity checks.
+    /*!
+     *  Function to parse a single element set, and append it to this catalog if it passes the integrity checks.
+     *  \param line1 Pointer to the start of the first line of the element set (of at least 69 characters).
+     *  \param line2 Pointer to the start of the second line of the element set (of at least 69 characters).
+     *  \return True if the element set passed the integrity checks, false otherwise.
+     */
+    bool parseElementSet( const char* line1, const char* line2 );
+
+    //! Default constructor, creates an empty catalog (used for the parsing of chunks of a file).
+    TwoLineElementCatalog( ): numberOfCorruptedElementSets_( 0 ) { }
+
+    //! Number of element sets that failed the integrity checks.
+    unsigned int numberOfCorruptedElementSets_;
+
+    //! Catalog numbers of all objects in the catalog (each listed once, in ascending order).
+    std::vector< unsigned int > objectCatalogNumbers_;
+
+    //! Index of the first element set of each object in objectCatalogNumbers_ (with the total number appended).
+    std::vector< unsigned int > objectStartIndices_;
+
+    //! Catalog numbers of the element sets.
+    std::vector< unsigned int > catalogNumbers_;
+
+    //! Classifications of the element sets.
+    std::vector< char > classifications_;
+
+    //! Epochs of the element sets, in seconds since J2000.
+    std::vector< double > epochs_;
+
+    //! First derivatives of the mean motion divided by two, in revolutions per day squared.
+    std::vector< double > firstDerivativesOfMeanMotionDividedByTwo_;
+
+    //! Second derivatives of the mean motion divided by six, in revolutions per day cubed.
+    std::vector< double > secondDerivativesOfMeanMotionDividedBySix_;
+
+    //! B* drag terms, in inverse Earth radii.
+    std::vector< double > bStars_;
+
+    //! Element set numbers.
+    std::vector< unsigned int > elementSetNumbers_;
+
+    //! Inclinations, in degrees.
+    std::vector< double > inclinations_;
+
+    //! Right ascensions of the ascending node, in degrees.
+    std::vector< double > rightAscensionsOfAscendingNode_;
+
+    //! Eccentricities.
+    std::vector< double > eccentricities_;
+
+    //! Arguments of perigee, in degrees.
+    std::vector< double > argumentsOfPerigee_;
+
+    //! Mean anomalies, in degrees.
+    std::vector< double > meanAnomalies_;
+
+    //! Mean motions, in revolutions per day.
+    std::vector< double > meanMotions_;
+
+    //! Revolution numbers at epoch.
+    std::vector< unsigned int > revolutionNumbers_;
+};
+
+//! Typedef for shared-pointer to TwoLineElementCatalog object.
+typedef boost::shared_ptr< TwoLineElementCatalog > TwoLineElementCatalogPointer;
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_TWO_LINE_ELEMENT_CATALOG_H
@@ -0,0 +1,345 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/lexical_cast.hpp>
+
+#include "Tudat/InputOutput/textFieldConversions.h"
+#include "Tudat/InputOutput/typedTextParser.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Function to retrieve the values of an integer column.
+const std::vector< int >& TypedTextTable::getIntegerColumn( const unsigned int columnIndex ) const
+{
+    if( columnIndex >= columnTypes_.size( ) || columnTypes_.at( columnIndex ) != integer_column )
+    {
+        throw std::runtime_error( "Error, column " + boost::lexical_cast< std::string >( columnIndex ) +
+                                  " of typed text table is not an integer column." );
+    }
+    return integerColumns_.at( storageIndices_.at( columnIndex ) );
+}
+
+//! Function to retrieve the values of a double column.
+const std::vector< double >& TypedTextTable::getDoubleColumn( const unsigned int columnIndex ) const
+{
+    if( columnIndex >= columnTypes_.size( ) || columnTypes_.at( columnIndex ) != double_column )
+    {
+        throw std::runtime_error( "Error, column " + boost::lexical_cast< std::string >( columnIndex ) +
+                                  " of typed text table is not a double column." );
+    }
+    return doubleColumns_.at( storageIndices_.at( columnIndex ) );
+}
+
+//! Function to remove all rows from the table (retaining the allocated memory).
+void TypedTextTable::clear( )
+{
+    for( unsigned int i = 0; i < integerColumns_.size( ); i++ )
+    {
+        integerColumns_[ i ].clear( );
+    }
+    for( unsigned int i = 0; i < doubleColumns_.size( ); i++ )
+    {
+        doubleColumns_[ i ].clear( );
+    }
+    numberOfRows_ = 0;
+}
+
+//! Constructor for a fixed-width parser.
+TypedTextParser::TypedTextParser( const std::vector< TypedTextColumn >& columns ):
+    columns_( columns ), isSeparated_( false ), areSeparatorsWhitespace_( false ), commentCharacters_( "#%" ),
+    numberOfHeaderLines_( 0 )
+{
+    for( unsigned int i = 0; i < columns_.size( ); i++ )
+    {
+        if( columns_.at( i ).width <= 0 )
+        {
+            throw std::runtime_error( "Error, width of column " + boost::lexical_cast< std::string >( i ) +
+                                      " of fixed-width typed text parser is not positive." );
+        }
+    }
+}
+
+//! Constructor for a separated parser.
+TypedTextParser::TypedTextParser( const std::vector< TypedTextColumn >& columns, const std::string& separators ):
+    columns_( columns ), isSeparated_( true ), separators_( separators ),
+    areSeparatorsWhitespace_( separators.find_first_of( " \t" ) != std::string::npos ),
+    commentCharacters_( "#%" ), numberOfHeaderLines_( 0 )
+{
+    if( separators_.empty( ) )
+    {
+        throw std::runtime_error( "Error, no separators provided to separated typed text parser." );
+    }
+}
+
+//! Function to parse a single line, and append its fields to a table.
+void TypedTextParser::parseLine( const char* lineStart, const char* lineEnd, TypedTextTable& table ) const
+{
+    initializeTable( table );
+
+    const char* fieldStart = lineStart;
+    const char* fieldEnd = lineStart;
+    bool isLineEndReached = false;
+    for( unsigned int i = 0; i < columns_.size( ); i++ )
+    {
+        // Determine the extent of the field.
+        if( !isSeparated_ )
+        {
+            fieldStart = std::min( fieldEnd, lineEnd );
+            fieldEnd = std::min( fieldStart + columns_[ i ].width, lineEnd );
+        }
+        else if( isLineEndReached )
+        {
+            fieldStart = lineEnd;
+            fieldEnd = lineEnd;
+        }
+        else
+        {
+            fieldStart = fieldEnd;
+            if( areSeparatorsWhitespace_ )
+            {
+                while( fieldStart < lineEnd && ( *fieldStart == ' ' || *fieldStart == '\t' || *fieldStart == '\r' ) )
+                {
+                    fieldStart++;
+                }
+            }
+            fieldEnd = fieldStart;
+            while( fieldEnd < lineEnd && separators_.find( *fieldEnd ) == std::string::npos )
+            {
+                fieldEnd++;
+            }
+        }
+
+        // Convert the field.
+        const TypedTextColumn& column = columns_[ i ];
+        if( column.columnType != ignored_column )
+        {
+            bool isConverted = true;
+            const bool isBlank = isTextFieldBlank( fieldStart, fieldEnd );
+            if( column.columnType == integer_column )
+            {
+                int value = 0;
+                if( isBlank )
+                {
+                    isConverted = !std::isnan( column.blankValue );
+                    value = isConverted ? static_cast< int >( column.blankValue ) : 0;
+                }
+                else
+                {
+                    isConverted = convertTextToInteger( fieldStart, fieldEnd, value );
+                }
+                table.integerColumns_[ table.storageIndices_[ i ] ].push_back( value );
+            }
+            else
+            {
+                double value = column.blankValue;
+                if( isBlank )
+                {
+                    isConverted = !std::isnan( value );
+                }
+                else
+                {
+                    isConverted = convertTextToDouble( fieldStart, fieldEnd, value );
+                }
+                table.doubleColumns_[ table.storageIndices_[ i ] ].push_back( value );
+            }
+
+            // Remove the partially parsed row, and report the error.
+            if( !isConverted )
+            {
+                for( unsigned int j = 0; j <= i; j++ )
+                {
+                    if( columns_[ j ].columnType == integer_column )
+                    {
+                        table.integerColumns_[ table.storageIndices_[ j ] ].pop_back( );
+                    }
+                    else if( columns_[ j ].columnType == double_column )
+                    {
+                        table.doubleColumns_[ table.storageIndices_[ j ] ].pop_back( );
+                    }
+                }
+                throw std::runtime_error(
+                            "Error, could not convert field '" + std::string( fieldStart, fieldEnd ) +
+                            "' in column " + boost::lexical_cast< std::string >( i ) + " to " +
+                            ( column.columnType == integer_column ? "an integer." : "a double." ) );
+            }
+        }
+
+        // Move past the separator (for separated files).
+        if( isSeparated_ && !isLineEndReached )
+        {
+            if( fieldEnd < lineEnd )
+            {
+                fieldEnd++;
+            }
+            else
+            {
+                isLineEndReached = true;
+            }
+        }
+    }
+    table.numberOfRows_++;
+}
+
+//! Function to parse all lines of a stream into a table.
+TypedTextTable TypedTextParser::parse( std::istream& stream ) const
+{
+    TypedTextTable table;
+    initializeTable( table );
+
+    std::string line;
+    unsigned int lineNumber = 0;
+    while( readNextLine( stream, line, lineNumber ) )
+    {
+        try
+        {
+            parseLine( line, table );
+        }
+        catch( std::runtime_error& error )
+        {
+            throw std::runtime_error( "Error when parsing line " + boost::lexical_cast< std::string >( lineNumber ) +
+                                      ": " + error.what( ) );
+        }
+    }
+    return table;
+}
+
+//! Function to parse all lines of a stream in chunks.
+unsigned int TypedTextParser::parse( std::istream& stream,
+                                     const boost::function< void( const TypedTextTable& ) >& chunkFunction,
+                                     const unsigned int numberOfRowsPerChunk ) const
+{
+    if( numberOfRowsPerChunk == 0 )
+    {
+        throw std::runtime_error( "Error, number of rows per chunk of typed text parser must be positive." );
+    }
+
+    // Allocate memory for the columns once.
+    TypedTextTable table;
+    initializeTable( table );
+    for( unsigned int i = 0; i < table.integerColumns_.size( ); i++ )
+    {
+        table.integerColumns_[ i ].reserve( numberOfRowsPerChunk );
+    }
+    for( unsigned int i = 0; i < table.doubleColumns_.size( ); i++ )
+    {
+        table.doubleColumns_[ i ].reserve( numberOfRowsPerChunk );
+    }
+
+    std::string line;
+    unsigned int lineNumber = 0;
+    unsigned int numberOfParsedRows = 0;
+    while( readNextLine( stream, line, lineNumber ) )
+    {
+        try
+        {
+            parseLine( line, table );
+        }
+        catch( std::runtime_error& error )
+        {
+            throw std::runtime_error( "Error when parsing line " + boost::lexical_cast< std::string >( lineNumber ) +
+                                      ": " + error.what( ) );
+        }
+        numberOfParsedRows++;
+
+        if( table.getNumberOfRows( ) == numberOfRowsPerChunk )
+        {
+            chunkFunction( table );
+            table.clear( );
+        }
+    }
+
+    if( table.getNumberOfRows( ) > 0 )
+    {
+        chunkFunction( table );
+    }
+    return numberOfParsedRows;
+}
+
+//! Function to parse all lines of a file into a table.
+TypedTextTable TypedTextParser::parseFile( const std::string& filePath ) const
+{
+    std::ifstream stream( filePath.c_str( ), std::ios::binary );
+    if( !stream.good( ) )
+    {
+        throw std::runtime_error( "Error, data file " + filePath + " could not be opened." );
+    }
+    return parse( stream );
+}
+
+//! Function to set up the columns of a table for the schema of this parser (if not already done).
+void TypedTextParser::initializeTable( TypedTextTable& table ) const
+{
+    bool isTableInitialized = ( table.columnTypes_.size( ) == columns_.size( ) );
+    for( unsigned int i = 0; isTableInitialized && i < columns_.size( ); i++ )
+    {
+        isTableInitialized = ( table.columnTypes_[ i ] == columns_[ i ].columnType );
+    }
+
+    if( !isTableInitialized )
+    {
+        table = TypedTextTable( );
+        for( unsigned int i = 0; i < columns_.size( ); i++ )
+        {
+            table.columnTypes_.push_back( columns_[ i ].columnType );
+            if( columns_[ i ].columnType == integer_column )
+            {
+                table.storageIndices_.push_back( table.integerColumns_.size( ) );
+                table.integerColumns_.push_back( std::vector< int >( ) );
+            }
+            else if( columns_[ i ].columnType == double_column )
+            {
+                table.storageIndices_.push_back( table.doubleColumns_.size( ) );
+                table.doubleColumns_.push_back( std::vector< double >( ) );
+            }
+            else
+            {
+                table.storageIndices_.push_back( -1 );
+            }
+        }
+    }
+}
+
+//! Function to determine whether a line is skipped when parsing a stream (blank or comment line).
+bool TypedTextParser::isLineSkipped( const std::string& line ) const
+{
+    const std::size_t firstCharacterIndex = line.find_first_not_of( " \t\r" );
+    return ( firstCharacterIndex == std::string::npos ||
+             commentCharacters_.find( line[ firstCharacterIndex ] ) != std::string::npos );
+}
+
+//! Function to read the next line of a stream that is not skipped, removing the carriage return (if any).
+bool TypedTextParser::readNextLine( std::istream& stream, std::string& line, unsigned int& lineNumber ) const
+{
+    while( std::getline( stream, line ) )
+    {
+        lineNumber++;
+        if( !line.empty( ) && line[ line.size( ) - 1 ] == '\r' )
+        {
+            line.resize( line.size( ) - 1 );
+        }
+        if( lineNumber > numberOfHeaderLines_ && !isLineSkipped( line ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace input_output
+} // namespace tudat
@@ -0,0 +1,271 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_TYPED_TEXT_PARSER_H
+#define TUDAT_TYPED_TEXT_PARSER_H
+
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Types of the columns that can be parsed by a TypedTextParser.
+enum TypedTextColumnType
+{
+    integer_column,
+    double_column,
+    ignored_column
+};
+
+//! Definition of a single column in the schema of a TypedTextParser.
+/*!
+ *  Definition of a single column in the schema of a TypedTextParser: the type to which the fields are converted, the
+ *  width of the fields (for fixed-width files) and the value that is stored for blank fields.
+ */
+struct TypedTextColumn
+{
+    //! Constructor.
+    /*!
+     *  Constructor.
+     *  \param columnType Type to which the fields of the column are converted.
+     *  \param width Width of the fields of the column, in characters (only used for fixed-width files).
+     *  \param blankValue Value that is stored for blank fields (converted to an int for integer columns). If NaN, blank
+     *  fields are not allowed for double columns (and for integer columns, for which NaN can not be stored).
+     */
+    TypedTextColumn( const TypedTextColumnType columnType, const int width = 0,
+                     const double blankValue = std::numeric_limits< double >::quiet_NaN( ) ):
+        columnType( columnType ), width( width ), blankValue( blankValue )
+    { }
+
+    //! Type to which the fields of the column are converted.
+    TypedTextColumnType columnType;
+
+    //! Width of the fields of the column, in characters (only used for fixed-width files).
+    int width;
+
+    //! Value that is stored for blank fields (NaN if blank fields are not allowed).
+    double blankValue;
+};
+
+//! Table of typed data columns, as filled by a TypedTextParser.
+/*!
+ *  Table of typed data columns, as filled by a TypedTextParser, in which each (non-ignored) column of the schema is
+ *  stored as a contiguous vector of ints or doubles, with one entry per parsed line. Clearing the table retains the
+ *  allocated memory, so that a table that is reused (as in chunked parsing) does not allocate after the first chunk.
+ */
+class TypedTextTable
+{
+public:
+
+    //! Default constructor, creates an empty table without columns (set up by the parser on first use).
+    TypedTextTable( ): numberOfRows_( 0 ) { }
+
+    //! Function to retrieve the number of rows in the table.
+    unsigned int getNumberOfRows( ) const { return numberOfRows_; }
+
+    //! Function to retrieve the number of columns in the table (including ignored columns).
+    unsigned int getNumberOfColumns( ) const { return columnTypes_.size( ); }
+
+    //! Function to retrieve the values of an integer column.
+    /*!
+     *  Function to retrieve the values of an integer column.
+     *  \param columnIndex Index of the column in the schema of the parser.
+     *  \return Values of the column, one per row.
+     *  \throws std::runtime_error If the column does not exist, or is not an integer column.
+     */
+    const std::vector< int >& getIntegerColumn( const unsigned int columnIndex ) const;
+
+    //! Function to retrieve the values of a double column.
+    /*!
+     *  Function to retrieve the values of a double column.
+     *  \param columnIndex Index of the column in the schema of the parser.
+     *  \return Values of the column, one per row.
+     *  \throws std::runtime_error If the column does not exist, or is not a double column.
+     */
+    const std::vector< double >& getDoubleColumn( const unsigned int columnIndex ) const;
+
+    //! Function to remove all rows from the table (retaining the allocated memory).
+    void clear( );
+
+private:
+
+    friend class TypedTextParser;
+
+    //! Types of the columns of the table.
+    std::vector< TypedTextColumnType > columnTypes_;
+
+    //! Index of each column in integerColumns_ or doubleColumns_ (-1 for ignored columns).
+    std::vector< int > storageIndices_;
+
+    //! Values of the integer columns.
+    std::vector< std::vector< int > > integerColumns_;
+
+    //! Values of the double columns.
+    std::vector< std::vector< double > > doubleColumns_;
+
+    //! Number of rows in the table.
+    unsigned int numberOfRows_;
+};
+
+//! Schema-driven parser that converts fixed-width or separated text files directly to typed columns.
+/*!
+ *  Schema-driven parser that converts the fields of fixed-width or separated text files directly to typed columns (see
+ *  TypedTextTable), as an alternative to the TextParser framework for large files. Each field is converted in place
+ *  from the line buffer by the functions in textFieldConversions.h, without creating any intermediate strings, streams
+ *  or FieldValue objects, so that parsing requires no memory allocation per field (and, apart from the growth of the
+ *  columns, none per line). Lines can be parsed one at a time (for files with a custom structure), all lines of a
+ *  stream can be parsed into a single table, or a stream can be parsed in chunks of a fixed number of lines, which are
+ *  passed to a function as they are completed, so that files of any size can be processed with a constant memory use.
+ *
+ *  For fixed-width files, the fields are at the positions given by the widths of the columns; fields beyond the end
+ *  of a line are blank. For separated files, fields are split at any of the separator characters and stripped of
+ *  leading and trailing whitespace; if the separators include whitespace, consecutive whitespace is treated as a single
+ *  separator.
+ */
+class TypedTextParser
+{
+public:
+
+    //! Constructor for a fixed-width parser.
+    /*!
+     *  Constructor for a fixed-width parser.
+     *  \param columns Definitions of the columns, from the start of the line onwards (all widths must be positive).
+     *  \throws std::runtime_error If any of the column widths is not positive.
+     */
+    TypedTextParser( const std::vector< TypedTextColumn >& columns );
+
+    //! Constructor for a separated parser.
+    /*!
+     *  Constructor for a separated parser.
+     *  \param columns Definitions of the columns (widths are ignored). Fields beyond the last column are ignored.
+     *  \param separators Characters that separate the fields.
+     *  \throws std::runtime_error If no separators are provided.
+     */
+    TypedTextParser( const std::vector< TypedTextColumn >& columns, const std::string& separators );
+
+    //! Function to set the characters that denote comment lines.
+    /*!
+     *  Function to set the characters that denote comment lines, which are skipped when parsing a stream (default:
+     *  '#' and '%').
+     *  \param commentCharacters Characters that, as the first non-whitespace character, mark a line as comment.
+     */
+    void setCommentCharacters( const std::string& commentCharacters )
+    {
+        commentCharacters_ = commentCharacters;
+    }
+
+    //! Function to set the number of header lines, which are skipped when parsing a stream.
+    void setNumberOfHeaderLines( const unsigned int numberOfHeaderLines )
+    {
+        numberOfHeaderLines_ = numberOfHeaderLines;
+    }
+
+    //! Function to parse a single line, and append its fields to a table.
+    /*!
+     *  Function to parse a single line, and append its fields as a new row of a table. If the table does not have the
+     *  columns of this parser, its contents are discarded and its columns are set up first.
+     *  \param lineStart Pointer to the first character of the line.
+     *  \param lineEnd Pointer to one beyond the last character of the line (excluding the newline).
+     *  \param table Table to which the row is appended (modified by this function).
+     *  \throws std::runtime_error If a field could not be converted (the table is left unmodified).
+     */
+    void parseLine( const char* lineStart, const char* lineEnd, TypedTextTable& table ) const;
+
+    //! Function to parse a single line, and append its fields to a table.
+    /*!
+     *  Function to parse a single line, and append its fields as a new row of a table.
+     *  \param line Line that is parsed (without the newline).
+     *  \param table Table to which the row is appended (modified by this function).
+     *  \throws std::runtime_error If a field could not be converted (the table is left unmodified).
+     */
+    void parseLine( const std::string& line, TypedTextTable& table ) const
+    {
+        parseLine( line.data( ), line.data( ) + line.size( ), table );
+    }
+
+    //! Function to parse all lines of a stream into a table.
+    /*!
+     *  Function to parse all lines of a stream into a table, skipping the header lines, blank lines and comment lines.
+     *  \param stream Stream that is parsed.
+     *  \return Table containing one row per parsed line.
+     *  \throws std::runtime_error If a field could not be converted (the message includes the line number).
+     */
+    TypedTextTable parse( std::istream& stream ) const;
+
+    //! Function to parse all lines of a stream in chunks.
+    /*!
+     *  Function to parse all lines of a stream in chunks of a fixed number of lines, skipping the header lines, blank
+     *  lines and comment lines. Each chunk is passed to a function as soon as it is completed (the last chunk may be
+     *  smaller), after which the table is reused for the next chunk.
+     *  \param stream Stream that is parsed.
+     *  \param chunkFunction Function that is called with each completed chunk.
+     *  \param numberOfRowsPerChunk Number of rows per chunk.
+     *  \return Total number of parsed rows.
+     *  \throws std::runtime_error If a field could not be converted (the message includes the line number).
+     */
+    unsigned int parse( std::istream& stream,
+                        const boost::function< void( const TypedTextTable& ) >& chunkFunction,
+                        const unsigned int numberOfRowsPerChunk ) const;
+
+    //! Function to parse all lines of a file into a table.
+    /*!
+     *  Function to parse all lines of a file into a table (see parse( std::istream& )).
+     *  \param filePath Path to the file.
+     *  \return Table containing one row per parsed line.
+     *  \throws std::runtime_error If the file could not be opened, or a field could not be converted.
+     */
+    TypedTextTable parseFile( const std::string& filePath ) const;
+
+private:
+
+    //! Function to set up the columns of a table for the schema of this parser (if not already done).
+    void initializeTable( TypedTextTable& table ) const;
+
+    //! Function to determine whether a line is skipped when parsing a stream (blank or comment line).
+    bool isLineSkipped( const std::string& line ) const;
+
+    //! Function to read the next line of a stream that is not skipped, removing the carriage return (if any).
+    bool readNextLine( std::istream& stream, std::string& line, unsigned int& lineNumber ) const;
+
+    //! Definitions of the columns.
+    std::vector< TypedTextColumn > columns_;
+
+    //! Boolean denoting whether the file is separated (rather than fixed-width).
+    bool isSeparated_;
+
+    //! Characters that separate the fields (for separated files).
+    std::string separators_;
+
+    //! Boolean denoting whether any of the separators is whitespace.
+    bool areSeparatorsWhitespace_;
+
+    //! Characters that denote comment lines.
+    std::string commentCharacters_;
+
+    //! Number of header lines, which are skipped when parsing a stream.
+    unsigned int numberOfHeaderLines_;
+};
+
+//! Typedef for shared-pointer to TypedTextParser object.
+typedef boost::shared_ptr< TypedTextParser > TypedTextParserPointer;
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_TYPED_TEXT_PARSER_H
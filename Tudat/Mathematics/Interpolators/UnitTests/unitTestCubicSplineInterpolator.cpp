@@ -15,6 +15,8 @@
 
 #include <vector>
 
+#include <Eigen/Core>
+
 #include "Tudat/Basics/testMacros.h"
 #include "Tudat/InputOutput/matrixTextFileReader.h"
 
@@ -207,6 +209,55 @@ BOOST_AUTO_TEST_CASE( test_cubicSplineInterpolator_matlab_compare )
                                        outputData, 1.0e-5 );
 }
 
+// Test cubic spline interpolation with component-major storage and equidistant lookup, and interpolation without allocation.
+BOOST_AUTO_TEST_CASE( testCubicSplineInterpolatorStorageAndLookup )
+{
+    using namespace interpolators;
+
+    // Create equidistant data.
+    std::vector< double > independentVariables;
+    std::vector< Eigen::VectorXd > data;
+    for( unsigned int i = 0; i < 50; i++ )
+    {
+        independentVariables.push_back( 0.25 * static_cast< double >( i ) );
+        data.push_back( Eigen::VectorXd( 3 ) );
+        for( int j = 0; j < 3; j++ )
+        {
+            data.back( )( j ) = std::sin( 0.3 * independentVariables.back( ) + static_cast< double >( j ) );
+        }
+    }
+
+    // Create interpolators with node-wise and component-major storage, and with binary search and equidistant lookup.
+    CubicSplineInterpolator< double, Eigen::VectorXd > nodeWiseInterpolator(
+                independentVariables, data, binarySearch );
+    CubicSplineInterpolator< double, Eigen::VectorXd > componentMajorInterpolator(
+                independentVariables, data, equidistantLookup, component_major_storage );
+    BOOST_CHECK_EQUAL( componentMajorInterpolator.getStorageLayout( ), component_major_storage );
+
+    // Check that results are identical, including at (and beyond) the boundaries and at the nodes.
+    Eigen::VectorXd interpolatedValue;
+    for( int i = -10; i < 510; i++ )
+    {
+        double targetValue = 0.025 * static_cast< double >( i );
+        Eigen::VectorXd expectedValue = nodeWiseInterpolator.interpolate( targetValue );
+
+        componentMajorInterpolator.interpolateInto( targetValue, interpolatedValue );
+        BOOST_CHECK_EQUAL( interpolatedValue.rows( ), 3 );
+        BOOST_CHECK_EQUAL( ( interpolatedValue - expectedValue ).norm( ), 0.0 );
+        BOOST_CHECK_EQUAL( ( componentMajorInterpolator.interpolate( targetValue ) - expectedValue ).norm( ), 0.0 );
+        nodeWiseInterpolator.interpolateInto( targetValue, interpolatedValue );
+        BOOST_CHECK_EQUAL( ( interpolatedValue - expectedValue ).norm( ), 0.0 );
+    }
+
+    // Check retrieval of dependent variables.
+    std::vector< Eigen::VectorXd > retrievedData = componentMajorInterpolator.getDependentValues( );
+    BOOST_CHECK_EQUAL( retrievedData.size( ), data.size( ) );
+    for( unsigned int i = 0; i < data.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( ( retrievedData.at( i ) - data.at( i ) ).norm( ), 0.0 );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
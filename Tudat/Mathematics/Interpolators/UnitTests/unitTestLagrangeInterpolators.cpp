@@ -11,12 +11,16 @@
 
 #define BOOST_TEST_MAIN
 
+
 #include <boost/make_shared.hpp>
 #include <boost/assign/list_of.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <Eigen/Core>
+
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
 
+#include "Tudat/Basics/parallelization.h"
 #include "Tudat/Mathematics/Interpolators/lagrangeInterpolator.h"
 
 namespace tudat
@@ -318,7 +322,7 @@ BOOST_AUTO_TEST_CASE( test_lagrange_interpolation_boundary )
                         lagrangeInterpolator.interpolate( currentTestIndependentVariable );
 
                     }
-                    catch( std::runtime_error )
+                    catch( std::runtime_error& )
                     {
                         runtimeErrorOccurred = 1;
                     }
@@ -346,7 +350,7 @@ BOOST_AUTO_TEST_CASE( test_lagrange_interpolation_boundary )
                         lagrangeInterpolator.interpolate( currentTestIndependentVariable );
 
                     }
-                    catch( std::runtime_error )
+                    catch( std::runtime_error& )
                     {
                         runtimeErrorOccurred = true;
                     }
@@ -379,7 +383,7 @@ BOOST_AUTO_TEST_CASE( test_lagrange_error_checks )
                         dataMap, 8, interpolators::huntingAlgorithm,
                         interpolators::lagrange_no_boundary_interpolation );
         }
-        catch( std::runtime_error )
+        catch( std::runtime_error& )
         {
             runtimeErrorOccurred = true;
         }
@@ -397,7 +401,7 @@ BOOST_AUTO_TEST_CASE( test_lagrange_error_checks )
                         interpolators::huntingAlgorithm,
                         interpolators::lagrange_no_boundary_interpolation );
         }
-        catch( std::runtime_error )
+        catch( std::runtime_error& )
         {
             runtimeErrorOccurred = true;
         }
@@ -416,7 +420,7 @@ BOOST_AUTO_TEST_CASE( test_lagrange_error_checks )
                         interpolators::huntingAlgorithm,
                         interpolators::lagrange_no_boundary_interpolation );
         }
-        catch( std::runtime_error )
+        catch( std::runtime_error& )
         {
             runtimeErrorOccurred = true;
         }
@@ -443,7 +447,7 @@ BOOST_AUTO_TEST_CASE( test_lagrange_error_checks )
                         dataMap, 8, interpolators::huntingAlgorithm,
                         interpolators::lagrange_no_boundary_interpolation );
         }
-        catch( std::runtime_error )
+        catch( std::runtime_error& )
         {
             runtimeErrorOccurred = true;
         }
@@ -469,7 +473,7 @@ BOOST_AUTO_TEST_CASE( test_lagrange_error_checks )
                         interpolators::huntingAlgorithm,
                         interpolators::lagrange_no_boundary_interpolation );
         }
-        catch( std::runtime_error )
+        catch( std::runtime_error& )
         {
             runtimeErrorOccurred = true;
         }
@@ -499,7 +503,7 @@ BOOST_AUTO_TEST_CASE( test_lagrange_error_checks )
                             dataMap, numberOfStages, interpolators::huntingAlgorithm,
                             interpolators::lagrange_no_boundary_interpolation );
             }
-            catch( std::runtime_error )
+            catch( std::runtime_error& )
             {
                 runtimeErrorOccurred = true;
             }
@@ -524,7 +528,7 @@ BOOST_AUTO_TEST_CASE( test_lagrange_error_checks )
                             interpolators::huntingAlgorithm,
                             interpolators::lagrange_no_boundary_interpolation );
             }
-            catch( std::runtime_error )
+            catch( std::runtime_error& )
             {
                 runtimeErrorOccurred = true;
             }
@@ -554,7 +558,7 @@ BOOST_AUTO_TEST_CASE( test_lagrange_error_checks )
                         interpolators::huntingAlgorithm,
                         interpolators::lagrange_no_boundary_interpolation );
         }
-        catch( std::runtime_error )
+        catch( std::runtime_error& )
         {
             runtimeErrorOccurred = true;
         }
@@ -566,6 +570,297 @@ BOOST_AUTO_TEST_CASE( test_lagrange_error_checks )
 }
 
 
+// Test equidistant lookup scheme, and Lagrange interpolation with barycentric weights for equidistant data.
+BOOST_AUTO_TEST_CASE( test_lagrange_equidistant_interpolation )
+{
+    using namespace interpolators;
+
+    // Create equidistant independent variables, and slightly perturbed (non-equidistant) independent variables.
+    std::vector< double > equidistantIndependentVariables;
+    std::vector< double > perturbedIndependentVariables;
+    for( unsigned int i = 0; i < 41; i++ )
+    {
+        equidistantIndependentVariables.push_back( 0.5 * static_cast< double >( i ) );
+        perturbedIndependentVariables.push_back(
+                    0.5 * static_cast< double >( i ) + 0.05 * std::sin( static_cast< double >( i * i ) ) );
+    }
+
+    // Check that equidistant lookup gives results identical to binary search, for equidistant and perturbed data.
+    for( unsigned int k = 0; k < 2; k++ )
+    {
+        std::vector< double > independentVariables =
+                ( k == 0 ) ? equidistantIndependentVariables : perturbedIndependentVariables;
+        EquidistantLookupScheme< double > equidistantLookupScheme( independentVariables );
+        BinarySearchLookupScheme< double > binarySearchLookupScheme( independentVariables );
+        for( int i = -10; i < 430; i++ )
+        {
+            double valueToLookup = 0.05 * static_cast< double >( i );
+            BOOST_CHECK_EQUAL( equidistantLookupScheme.findNearestLowerNeighbour( valueToLookup ),
+                               binarySearchLookupScheme.findNearestLowerNeighbour( valueToLookup ) );
+        }
+        for( unsigned int i = 0; i < independentVariables.size( ); i++ )
+        {
+            BOOST_CHECK_EQUAL( equidistantLookupScheme.findNearestLowerNeighbour( independentVariables.at( i ) ),
+                               binarySearchLookupScheme.findNearestLowerNeighbour( independentVariables.at( i ) ) );
+        }
+    }
+
+    // Check that equidistant lookup scheme cannot be created for strongly non-equidistant data.
+    bool runtimeErrorOccurred = false;
+    try
+    {
+        EquidistantLookupScheme< double > equidistantLookupScheme( getIndependentVariableVector( ) );
+    }
+    catch( std::runtime_error& )
+    {
+        runtimeErrorOccurred = true;
+    }
+    BOOST_CHECK_EQUAL( runtimeErrorOccurred, true );
+
+    for( int numberOfStages = 2; numberOfStages < 12; numberOfStages += 2 )
+    {
+        // Create polynomial data, which are exactly reproduced by Lagrange interpolation.
+        std::map< int, double > coefficients = getPolynomialCoefficients( numberOfStages - 1 );
+        std::vector< double > equidistantData, perturbedData;
+        for( unsigned int i = 0; i < equidistantIndependentVariables.size( ); i++ )
+        {
+            equidistantData.push_back( evaluatePolynomial( coefficients, equidistantIndependentVariables.at( i ) ) );
+            perturbedData.push_back( evaluatePolynomial( coefficients, perturbedIndependentVariables.at( i ) ) );
+        }
+
+        LagrangeInterpolator< double, double > equidistantInterpolator(
+                    equidistantIndependentVariables, equidistantData, numberOfStages, equidistantLookup );
+        LagrangeInterpolator< double, double > huntingInterpolator(
+                    equidistantIndependentVariables, equidistantData, numberOfStages, huntingAlgorithm );
+        LagrangeInterpolator< double, double > perturbedEquidistantInterpolator(
+                    perturbedIndependentVariables, perturbedData, numberOfStages, equidistantLookup );
+        LagrangeInterpolator< double, double > perturbedBinarySearchInterpolator(
+                    perturbedIndependentVariables, perturbedData, numberOfStages, binarySearch );
+
+        // Check whether barycentric weights are (only) used for equidistant data.
+        BOOST_CHECK_EQUAL( equidistantInterpolator.getUseBarycentricWeights( ), true );
+        BOOST_CHECK_EQUAL( huntingInterpolator.getUseBarycentricWeights( ), false );
+        BOOST_CHECK_EQUAL( perturbedEquidistantInterpolator.getUseBarycentricWeights( ), false );
+
+        // Compare interpolated values in the interior of the domain, and at the nodes.
+        int offsetEntries = numberOfStages / 2 - 1;
+        double startValue = equidistantIndependentVariables.at( offsetEntries );
+        double endValue = equidistantIndependentVariables.at( equidistantIndependentVariables.size( ) - offsetEntries - 1 );
+        for( int i = 0; i < 1000; i++ )
+        {
+            double targetValue = startValue + ( endValue - startValue ) * static_cast< double >( i ) / 1000.0;
+            double expectedValue = evaluatePolynomial( coefficients, targetValue );
+
+            BOOST_CHECK_CLOSE_FRACTION( equidistantInterpolator.interpolate( targetValue ), expectedValue, 1.0E-13 );
+            BOOST_CHECK_CLOSE_FRACTION( equidistantInterpolator.interpolate( targetValue ),
+                                        huntingInterpolator.interpolate( targetValue ), 1.0E-13 );
+            BOOST_CHECK_EQUAL( perturbedEquidistantInterpolator.interpolate( targetValue ),
+                               perturbedBinarySearchInterpolator.interpolate( targetValue ) );
+        }
+        for( unsigned int i = 0; i < equidistantIndependentVariables.size( ); i++ )
+        {
+            BOOST_CHECK_CLOSE_FRACTION( equidistantInterpolator.interpolate( equidistantIndependentVariables.at( i ) ),
+                                        huntingInterpolator.interpolate( equidistantIndependentVariables.at( i ) ),
+                                        1.0E-13 );
+        }
+    }
+}
+
+// Test whether Lagrange interpolation with component-major storage gives results identical to node-wise storage.
+BOOST_AUTO_TEST_CASE( test_lagrange_component_major_storage )
+{
+    using namespace interpolators;
+
+    std::vector< double > independentVariables = getIndependentVariableVector( );
+    std::vector< Eigen::VectorXd > vectorData;
+    std::vector< Eigen::MatrixXd > matrixData;
+    for( unsigned int i = 0; i < independentVariables.size( ); i++ )
+    {
+        vectorData.push_back( Eigen::VectorXd( 6 ) );
+        matrixData.push_back( Eigen::MatrixXd( 3, 2 ) );
+        for( int j = 0; j < 6; j++ )
+        {
+            vectorData.back( )( j ) = std::sin( 0.1 * independentVariables.at( i ) + static_cast< double >( j ) );
+            matrixData.back( )( j % 3, j / 3 ) = std::cos( 0.05 * independentVariables.at( i ) * static_cast< double >( j ) );
+        }
+    }
+
+    for( int numberOfStages = 2; numberOfStages < 10; numberOfStages += 2 )
+    {
+        LagrangeInterpolator< double, Eigen::VectorXd > nodeWiseVectorInterpolator(
+                    independentVariables, vectorData, numberOfStages );
+        LagrangeInterpolator< double, Eigen::VectorXd > componentMajorVectorInterpolator(
+                    independentVariables, vectorData, numberOfStages, huntingAlgorithm,
+                    lagrange_cubic_spline_boundary_interpolation, component_major_storage );
+        LagrangeInterpolator< double, Eigen::MatrixXd > nodeWiseMatrixInterpolator(
+                    independentVariables, matrixData, numberOfStages );
+        LagrangeInterpolator< double, Eigen::MatrixXd > componentMajorMatrixInterpolator(
+                    independentVariables, matrixData, numberOfStages, huntingAlgorithm,
+                    lagrange_cubic_spline_boundary_interpolation, component_major_storage );
+
+        BOOST_CHECK_EQUAL( nodeWiseVectorInterpolator.getStorageLayout( ), node_wise_storage );
+        BOOST_CHECK_EQUAL( componentMajorVectorInterpolator.getStorageLayout( ), component_major_storage );
+
+        // Check retrieval of dependent variables.
+        std::vector< Eigen::VectorXd > retrievedVectorData = componentMajorVectorInterpolator.getDependentValues( );
+        BOOST_CHECK_EQUAL( retrievedVectorData.size( ), vectorData.size( ) );
+        for( unsigned int i = 0; i < vectorData.size( ); i++ )
+        {
+            BOOST_CHECK_EQUAL( ( retrievedVectorData.at( i ) - vectorData.at( i ) ).norm( ), 0.0 );
+        }
+
+        // Compare results over full domain (including boundary interpolation and nodes).
+        Eigen::VectorXd interpolatedVector = Eigen::VectorXd::Zero( 6 );
+        Eigen::MatrixXd interpolatedMatrix;
+        for( int i = 0; i <= 2080; i++ )
+        {
+            double targetValue = 0.05 * static_cast< double >( i );
+
+            Eigen::VectorXd expectedVector = nodeWiseVectorInterpolator.interpolate( targetValue );
+            componentMajorVectorInterpolator.interpolateInto( targetValue, interpolatedVector );
+            BOOST_CHECK_EQUAL( ( interpolatedVector - expectedVector ).norm( ), 0.0 );
+            BOOST_CHECK_EQUAL(
+                        ( componentMajorVectorInterpolator.interpolate( targetValue ) - expectedVector ).norm( ), 0.0 );
+
+            Eigen::MatrixXd expectedMatrix = nodeWiseMatrixInterpolator.interpolate( targetValue );
+            componentMajorMatrixInterpolator.interpolateInto( targetValue, interpolatedMatrix );
+            BOOST_CHECK_EQUAL( interpolatedMatrix.rows( ), 3 );
+            BOOST_CHECK_EQUAL( interpolatedMatrix.cols( ), 2 );
+            BOOST_CHECK_EQUAL( ( interpolatedMatrix - expectedMatrix ).norm( ), 0.0 );
+            nodeWiseMatrixInterpolator.interpolateInto( targetValue, interpolatedMatrix );
+            BOOST_CHECK_EQUAL( ( interpolatedMatrix - expectedMatrix ).norm( ), 0.0 );
+        }
+    }
+}
+
+//! Function to create a (sinusoidal) state history, at equidistant epochs, used in the tests below.
+void createTestStateHistory( const int numberOfNodes,
+                             std::vector< double >& independentVariables,
+                             std::vector< Eigen::VectorXd >& stateHistory )
+{
+    independentVariables.clear( );
+    stateHistory.clear( );
+    for( int i = 0; i < numberOfNodes; i++ )
+    {
+        independentVariables.push_back( 60.0 * static_cast< double >( i ) );
+        stateHistory.push_back( Eigen::VectorXd( 6 ) );
+        for( int j = 0; j < 6; j++ )
+        {
+            stateHistory.back( )( j ) = 7.0E6 * std::sin( 1.0E-3 * independentVariables.back( ) + static_cast< double >( j ) );
+        }
+    }
+}
+
+//! Function to create (quasi-random) evaluation epochs in the domain of the state history.
+std::vector< double > getTestEvaluationEpochs( const int numberOfEvaluations, const double finalEpoch )
+{
+    std::vector< double > evaluationEpochs;
+    for( int i = 0; i < numberOfEvaluations; i++ )
+    {
+        evaluationEpochs.push_back( finalEpoch * std::fabs( std::sin( 12.9898 * static_cast< double >( i ) ) ) );
+    }
+    return evaluationEpochs;
+}
+
+// Test Lagrange interpolation of (equidistant) state history, with different lookup schemes and storage.
+BOOST_AUTO_TEST_CASE( test_lagrange_interpolation_lookup_schemes )
+{
+    using namespace interpolators;
+
+    // Create state history and evaluation epochs.
+    std::vector< double > independentVariables;
+    std::vector< Eigen::VectorXd > stateHistory;
+    createTestStateHistory( 5000, independentVariables, stateHistory );
+    std::vector< double > evaluationEpochs = getTestEvaluationEpochs( 20000, independentVariables.back( ) );
+
+    std::vector< AvailableLookupScheme > lookupSchemes = { huntingAlgorithm, binarySearch, equidistantLookup };
+    Eigen::VectorXd referenceSum;
+    for( unsigned int i = 0; i < lookupSchemes.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < 2; j++ )
+        {
+            LagrangeInterpolator< double, Eigen::VectorXd > interpolator(
+                        independentVariables, stateHistory, 8, lookupSchemes.at( i ),
+                        lagrange_cubic_spline_boundary_interpolation,
+                        ( j == 0 ) ? node_wise_storage : component_major_storage );
+
+            Eigen::VectorXd interpolatedState = Eigen::VectorXd::Zero( 6 );
+            Eigen::VectorXd sumOfStates = Eigen::VectorXd::Zero( 6 );
+            for( unsigned int k = 0; k < evaluationEpochs.size( ); k++ )
+            {
+                if( j == 0 )
+                {
+                    interpolatedState = interpolator.interpolate( evaluationEpochs[ k ] );
+                }
+                else
+                {
+                    interpolator.interpolateInto( evaluationEpochs[ k ], interpolatedState );
+                }
+                sumOfStates += interpolatedState;
+            }
+
+            if( i == 0 && j == 0 )
+            {
+                referenceSum = sumOfStates;
+            }
+            BOOST_CHECK_SMALL( ( sumOfStates - referenceSum ).norm( ) / referenceSum.norm( ), 1.0E-14 );
+        }
+    }
+}
+
+// Test whether a single Lagrange interpolator can be used concurrently from multiple threads.
+BOOST_AUTO_TEST_CASE( test_lagrange_concurrent_interpolation )
+{
+    using namespace interpolators;
+
+    // Create state history (with non-equidistant epochs for part of the interpolators) and evaluation epochs.
+    std::vector< double > independentVariables;
+    std::vector< Eigen::VectorXd > stateHistory;
+    createTestStateHistory( 2000, independentVariables, stateHistory );
+    std::vector< double > perturbedIndependentVariables = independentVariables;
+    for( unsigned int i = 0; i < perturbedIndependentVariables.size( ); i++ )
+    {
+        perturbedIndependentVariables[ i ] += 5.0 * std::sin( static_cast< double >( i * i ) );
+    }
+    std::vector< double > evaluationEpochs = getTestEvaluationEpochs( 20000, independentVariables.back( ) );
+
+    std::vector< AvailableLookupScheme > lookupSchemes = { huntingAlgorithm, binarySearch, equidistantLookup };
+    for( unsigned int i = 0; i < lookupSchemes.size( ); i++ )
+    {
+        for( unsigned int j = 0; j < 2; j++ )
+        {
+            for( unsigned int k = 0; k < 2; k++ )
+            {
+                LagrangeInterpolator< double, Eigen::VectorXd > interpolator(
+                            ( k == 0 || lookupSchemes.at( i ) == equidistantLookup ) ?
+                                independentVariables : perturbedIndependentVariables,
+                            stateHistory, ( k == 0 ) ? 8 : 6, lookupSchemes.at( i ),
+                            lagrange_cubic_spline_boundary_interpolation,
+                            ( j == 0 ) ? node_wise_storage : component_major_storage );
+
+                // Interpolate on single thread.
+                std::vector< Eigen::VectorXd > serialStates( evaluationEpochs.size( ) );
+                for( unsigned int l = 0; l < evaluationEpochs.size( ); l++ )
+                {
+                    serialStates[ l ] = interpolator.interpolate( evaluationEpochs[ l ] );
+                }
+
+                // Interpolate concurrently, and check that results are identical.
+                std::vector< Eigen::VectorXd > parallelStates( evaluationEpochs.size( ), Eigen::VectorXd::Zero( 6 ) );
+                utilities::executeParallelLoop(
+                            evaluationEpochs.size( ), [ & ]( const unsigned int l )
+                {
+                    interpolator.interpolateInto( evaluationEpochs[ l ], parallelStates[ l ] );
+                }, 4 );
+
+                for( unsigned int l = 0; l < evaluationEpochs.size( ); l++ )
+                {
+                    BOOST_CHECK_EQUAL( ( parallelStates[ l ] - serialStates[ l ] ).norm( ), 0.0 );
+                }
+            }
+        }
+    }
+}
 
 BOOST_AUTO_TEST_SUITE_END( )
 
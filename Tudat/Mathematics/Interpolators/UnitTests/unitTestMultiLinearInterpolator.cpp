@@ -18,6 +18,7 @@
 #include <vector>
 #include <cmath>
 
+#include "Tudat/Basics/parallelization.h"
 #include "Tudat/Basics/testMacros.h"
 #include "Tudat/InputOutput/matrixTextFileReader.h"
 
@@ -149,6 +150,72 @@ BOOST_AUTO_TEST_CASE( test4Dimensions )
                                 std::numeric_limits< double >::epsilon( ) );
 }
 
+// Test 3: Check whether a single interpolator can be used concurrently from multiple threads.
+BOOST_AUTO_TEST_CASE( testConcurrentInterpolation )
+{
+    // Create (non-equidistant) independent variables and (analytical) dependent variables.
+    std::vector< std::vector< double > > independentValues;
+    independentValues.resize( 3 );
+    for( unsigned int i = 0; i < independentValues.size( ); i++ )
+    {
+        for( int j = 0; j < 40; j++ )
+        {
+            independentValues[ i ].push_back( static_cast< double >( j ) + 0.3 * std::sin( static_cast< double >( j + i ) ) );
+        }
+    }
+
+    boost::multi_array< double, 3 > dependentValues;
+    dependentValues.resize( boost::extents[ 40 ][ 40 ][ 40 ] );
+    for( int i = 0; i < 40; i++ )
+    {
+        for( int j = 0; j < 40; j++ )
+        {
+            for( int k = 0; k < 40; k++ )
+            {
+                dependentValues[ i ][ j ][ k ] = std::sin( 0.1 * independentValues[ 0 ][ i ] ) *
+                        std::cos( 0.2 * independentValues[ 1 ][ j ] ) + 0.01 * independentValues[ 2 ][ k ];
+            }
+        }
+    }
+
+    // Create (quasi-random) interpolation targets.
+    const unsigned int numberOfEvaluations = 20000;
+    std::vector< std::vector< double > > targetValues( numberOfEvaluations, std::vector< double >( 3 ) );
+    for( unsigned int i = 0; i < numberOfEvaluations; i++ )
+    {
+        for( unsigned int j = 0; j < 3; j++ )
+        {
+            targetValues[ i ][ j ] = 38.0 * std::fabs( std::sin( 12.9898 * static_cast< double >( 3 * i + j ) ) );
+        }
+    }
+
+    std::vector< interpolators::AvailableLookupScheme > lookupSchemes =
+    { interpolators::huntingAlgorithm, interpolators::binarySearch };
+    for( unsigned int i = 0; i < lookupSchemes.size( ); i++ )
+    {
+        interpolators::MultiLinearInterpolator< double, double, 3 > interpolator(
+                    independentValues, dependentValues, lookupSchemes.at( i ) );
+
+        // Interpolate on single thread, and concurrently, and check that results are identical.
+        std::vector< double > serialResults( numberOfEvaluations );
+        for( unsigned int j = 0; j < numberOfEvaluations; j++ )
+        {
+            serialResults[ j ] = interpolator.interpolate( targetValues[ j ] );
+        }
+
+        std::vector< double > parallelResults( numberOfEvaluations );
+        utilities::executeParallelLoop( numberOfEvaluations, [ & ]( const unsigned int j )
+        {
+            parallelResults[ j ] = interpolator.interpolate( targetValues[ j ] );
+        }, 4 );
+
+        for( unsigned int j = 0; j < numberOfEvaluations; j++ )
+        {
+            BOOST_CHECK_EQUAL( parallelResults[ j ], serialResults[ j ] );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -0,0 +1,305 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ */
+
+#ifndef TUDAT_COMPONENT_MAJOR_NODE_VALUES_H
+#define TUDAT_COMPONENT_MAJOR_NODE_VALUES_H
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace interpolators
+{
+
+//! Enum of available storage layouts for the dependent variable values of a one-dimensional interpolator.
+/*!
+ *  Enum of available storage layouts for the dependent variable values of a one-dimensional interpolator. With
+ *  node_wise_storage, the values are stored as a vector of dependent variables (one object, and for dynamically sized
+ *  Eigen types one heap allocation, per node). With component_major_storage, all values are stored in a single
+ *  contiguous block, in which the values of a single component at all nodes are adjacent in memory.
+ */
+enum DependentVariableStorageLayout
+{
+    node_wise_storage,
+    component_major_storage
+};
+
+//! Struct to access the individual (scalar) components of a scalar dependent variable.
+/*!
+ *  Struct to access the individual (scalar) components of a dependent variable, providing a single interface for
+ *  scalar and Eigen matrix types. This general implementation is used for scalar types, which have a single
+ *  component; a specialization is provided for Eigen::Matrix types.
+ *  \tparam DependentVariableType Type of dependent variable.
+ */
+template< typename DependentVariableType >
+struct DependentVariableComponents
+{
+    //! Typedef for the type of a single component of the dependent variable.
+    typedef DependentVariableType ComponentType;
+
+    //! Function to retrieve the number of rows of a dependent variable (1 for scalars).
+    static int getNumberOfRows( const DependentVariableType& value )
+    {
+        return 1;
+    }
+
+    //! Function to retrieve the number of columns of a dependent variable (1 for scalars).
+    static int getNumberOfColumns( const DependentVariableType& value )
+    {
+        return 1;
+    }
+
+    //! Function to retrieve a pointer to the (contiguous) components of a dependent variable.
+    static ComponentType* getComponents( DependentVariableType& value )
+    {
+        return &value;
+    }
+
+    //! Function to retrieve a pointer to the (contiguous) components of a constant dependent variable.
+    static const ComponentType* getComponents( const DependentVariableType& value )
+    {
+        return &value;
+    }
+
+    //! Function to set the size of a dependent variable (no operation for scalars).
+    static void resize( DependentVariableType& value, const int numberOfRows, const int numberOfColumns ){ }
+};
+
+//! Struct to access the individual (scalar) components of an Eigen matrix dependent variable.
+/*!
+ *  Struct to access the individual (scalar) components of an Eigen matrix dependent variable. The components are
+ *  indexed in the storage order of the matrix type.
+ */
+template< typename ScalarType, int Rows, int Columns, int Options, int MaximumRows, int MaximumColumns >
+struct DependentVariableComponents< Eigen::Matrix< ScalarType, Rows, Columns, Options, MaximumRows, MaximumColumns > >
+{
+    //! Typedef for the dependent variable type.
+    typedef Eigen::Matrix< ScalarType, Rows, Columns, Options, MaximumRows, MaximumColumns > DependentVariableType;
+
+    //! Typedef for the type of a single component of the dependent variable.
+    typedef ScalarType ComponentType;
+
+    //! Function to retrieve the number of rows of a dependent variable.
+    static int getNumberOfRows( const DependentVariableType& value )
+    {
+        return value.rows( );
+    }
+
+    //! Function to retrieve the number of columns of a dependent variable.
+    static int getNumberOfColumns( const DependentVariableType& value )
+    {
+        return value.cols( );
+    }
+
+    //! Function to retrieve a pointer to the (contiguous) components of a dependent variable.
+    static ComponentType* getComponents( DependentVariableType& value )
+    {
+        return value.data( );
+    }
+
+    //! Function to retrieve a pointer to the (contiguous) components of a constant dependent variable.
+    static const ComponentType* getComponents( const DependentVariableType& value )
+    {
+        return value.data( );
+    }
+
+    //! Function to set the size of a dependent variable, only reallocating memory if the size is changed.
+    static void resize( DependentVariableType& value, const int numberOfRows, const int numberOfColumns )
+    {
+        if( value.rows( ) != numberOfRows || value.cols( ) != numberOfColumns )
+        {
+            value.resize( numberOfRows, numberOfColumns );
+        }
+    }
+};
+
+//! Class to store the values of a dependent variable at a set of nodes in component-major order.
+/*!
+ *  Class to store the values of a dependent variable at a set of nodes in a single contiguous block of memory, in
+ *  component-major order: the values of each component at all nodes are adjacent in memory. This provides fast,
+ *  allocation-free, access to the values of a single component at a range of subsequent nodes, as used by the
+ *  one-dimensional interpolators when set to use component_major_storage. All node values must have the same size.
+ *  \tparam DependentVariableType Type of dependent variable.
+ */
+template< typename DependentVariableType >
+class ComponentMajorNodeValues
+{
+public:
+
+    //! Typedef for the type of a single component of the dependent variable.
+    typedef typename DependentVariableComponents< DependentVariableType >::ComponentType ComponentType;
+
+    //! Constructor
+    /*!
+     *  Constructor, copies the node values into the component-major storage.
+     *  \param nodeValues Values of the dependent variable at the nodes.
+     */
+    ComponentMajorNodeValues( const std::vector< DependentVariableType >& nodeValues )
+    {
+        if( nodeValues.size( ) == 0 )
+        {
+            throw std::runtime_error( "Error when creating component-major node values, no values provided" );
+        }
+
+        numberOfRows_ = DependentVariableComponents< DependentVariableType >::getNumberOfRows( nodeValues.at( 0 ) );
+        numberOfColumns_ = DependentVariableComponents< DependentVariableType >::getNumberOfColumns(
+                    nodeValues.at( 0 ) );
+        numberOfComponents_ = numberOfRows_ * numberOfColumns_;
+
+        values_.resize( nodeValues.size( ), numberOfComponents_ );
+        for( unsigned int i = 0; i < nodeValues.size( ); i++ )
+        {
+            if( DependentVariableComponents< DependentVariableType >::getNumberOfRows( nodeValues.at( i ) ) !=
+                    numberOfRows_ ||
+                    DependentVariableComponents< DependentVariableType >::getNumberOfColumns( nodeValues.at( i ) ) !=
+                    numberOfColumns_ )
+            {
+                throw std::runtime_error( "Error when creating component-major node values, size of value at node " +
+                                          boost::lexical_cast< std::string >( i ) + " is inconsistent" );
+            }
+
+            const ComponentType* nodeComponents =
+                    DependentVariableComponents< DependentVariableType >::getComponents( nodeValues.at( i ) );
+            for( int j = 0; j < numberOfComponents_; j++ )
+            {
+                values_( i, j ) = nodeComponents[ j ];
+            }
+        }
+    }
+
+    //! Function to retrieve the number of nodes.
+    /*!
+     *  Function to retrieve the number of nodes.
+     *  \return Number of nodes.
+     */
+    int getNumberOfNodes( ) const
+    {
+        return values_.rows( );
+    }
+
+    //! Function to retrieve the number of (scalar) components of the dependent variable.
+    /*!
+     *  Function to retrieve the number of (scalar) components of the dependent variable.
+     *  \return Number of (scalar) components of the dependent variable.
+     */
+    int getNumberOfComponents( ) const
+    {
+        return numberOfComponents_;
+    }
+
+    //! Function to retrieve the values of a single component at all nodes.
+    /*!
+     *  Function to retrieve the values of a single component at all nodes.
+     *  \param componentIndex Index of the component.
+     *  \return Pointer to the (contiguous) values of the component, with the node index as offset.
+     */
+    const ComponentType* getComponentValues( const int componentIndex ) const
+    {
+        return values_.data( ) + componentIndex * values_.rows( );
+    }
+
+    //! Function to set the size of a dependent variable to that of the stored values, and its components to zero.
+    /*!
+     *  Function to set the size of a dependent variable to that of the stored values, and its components to zero. Memory
+     *  is only reallocated if the size of the input is changed.
+     *  \param value Dependent variable that is to be resized and set to zero (returned by reference).
+     */
+    void setZeroValue( DependentVariableType& value ) const
+    {
+        DependentVariableComponents< DependentVariableType >::resize( value, numberOfRows_, numberOfColumns_ );
+        ComponentType* components = DependentVariableComponents< DependentVariableType >::getComponents( value );
+        for( int j = 0; j < numberOfComponents_; j++ )
+        {
+            components[ j ] = ComponentType( 0 );
+        }
+    }
+
+    //! Function to retrieve the value of the dependent variable at a single node.
+    /*!
+     *  Function to retrieve the value of the dependent variable at a single node, without allocating memory if the
+     *  output already has the correct size.
+     *  \param nodeIndex Index of the node.
+     *  \param value Value of the dependent variable at the node (returned by reference).
+     */
+    void getNodeValue( const int nodeIndex, DependentVariableType& value ) const
+    {
+        DependentVariableComponents< DependentVariableType >::resize( value, numberOfRows_, numberOfColumns_ );
+        ComponentType* components = DependentVariableComponents< DependentVariableType >::getComponents( value );
+        for( int j = 0; j < numberOfComponents_; j++ )
+        {
+            components[ j ] = values_( nodeIndex, j );
+        }
+    }
+
+    //! Function to retrieve the values of the dependent variable at all nodes.
+    /*!
+     *  Function to retrieve the values of the dependent variable at all nodes, as a vector of dependent variables.
+     *  \return Values of the dependent variable at all nodes.
+     */
+    std::vector< DependentVariableType > getNodeValues( ) const
+    {
+        std::vector< DependentVariableType > nodeValues( values_.rows( ) );
+        for( int i = 0; i < values_.rows( ); i++ )
+        {
+            getNodeValue( i, nodeValues[ i ] );
+        }
+        return nodeValues;
+    }
+
+    //! Function to add a weighted sum of the values at a range of subsequent nodes to a dependent variable.
+    /*!
+     *  Function to add a weighted sum of the values at a range of subsequent nodes to a dependent variable, which must
+     *  already have the size of the stored values. For each component, the products are added in order of increasing
+     *  node index.
+     *  \param firstNodeIndex Index of the first node in the sum.
+     *  \param weights Weights of the nodes in the sum (one per node).
+     *  \param value Dependent variable to which the weighted sum is added (returned by reference).
+     */
+    template< typename WeightType >
+    void addWeightedNodeValues( const int firstNodeIndex, const std::vector< WeightType >& weights,
+                                DependentVariableType& value ) const
+    {
+        ComponentType* components = DependentVariableComponents< DependentVariableType >::getComponents( value );
+        for( int j = 0; j < numberOfComponents_; j++ )
+        {
+            const ComponentType* componentValues = getComponentValues( j ) + firstNodeIndex;
+            for( unsigned int i = 0; i < weights.size( ); i++ )
+            {
+                components[ j ] += componentValues[ i ] * weights[ i ];
+            }
+        }
+    }
+
+private:
+
+    //! Values of the dependent variable (one row per node, one column per component).
+    Eigen::Matrix< ComponentType, Eigen::Dynamic, Eigen::Dynamic > values_;
+
+    //! Number of rows of the dependent variable.
+    int numberOfRows_;
+
+    //! Number of columns of the dependent variable.
+    int numberOfColumns_;
+
+    //! Number of (scalar) components of the dependent variable.
+    int numberOfComponents_;
+};
+
+} // namespace interpolators
+} // namespace tudat
+
+#endif // TUDAT_COMPONENT_MAJOR_NODE_VALUES_H
@@ -53,12 +53,15 @@ public:
      * \param selectedLookupScheme Selected type of lookup scheme for independent variables.
      * \param useLongDoubleTimeStep Boolean denoting whether time step is to be a long double,
      * time step is a double if false.
+     * \param storageLayout Layout in which the dependent variables are to be stored (only used by Lagrange, cubic
+     * spline and Hermite spline interpolators).
      */
     InterpolatorSettings( const OneDimensionalInterpolatorTypes interpolatorType,
                           const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
-                          const bool useLongDoubleTimeStep = 0 ):
+                          const bool useLongDoubleTimeStep = 0,
+                          const DependentVariableStorageLayout storageLayout = node_wise_storage ):
         interpolatorType_( interpolatorType ), selectedLookupScheme_( selectedLookupScheme ),
-        useLongDoubleTimeStep_( useLongDoubleTimeStep ){ }
+        useLongDoubleTimeStep_( useLongDoubleTimeStep ), storageLayout_( storageLayout ){ }
 
     //! Virtual destructor
     virtual ~InterpolatorSettings( ){ }
@@ -94,6 +97,16 @@ public:
         return useLongDoubleTimeStep_;
     }
 
+    //! Function to get the layout in which the dependent variables are to be stored.
+    /*!
+     * Function to get the layout in which the dependent variables are to be stored.
+     * \return Layout in which the dependent variables are to be stored.
+     */
+    DependentVariableStorageLayout getStorageLayout( )
+    {
+        return storageLayout_;
+    }
+
 protected:
 
     //! Selected type of interpolator.
@@ -105,6 +118,9 @@ protected:
     //!  Boolean denoting whether time step is to be a long double.
     bool useLongDoubleTimeStep_;
 
+    //! Layout in which the dependent variables are to be stored.
+    DependentVariableStorageLayout storageLayout_;
+
 };
 
 //! Class for providing settings to creating a Lagrange interpolator.
@@ -120,13 +136,15 @@ public:
      * time step is a double if false.
      * \param selectedLookupScheme Selected type of lookup scheme for independent variables.
      * \param boundaryHandling Variable denoting the method by which the boundary interpolation is handled.
+     * \param storageLayout Layout in which the dependent variables are to be stored.
      */
     LagrangeInterpolatorSettings(
             const int interpolatorOrder,
             const bool useLongDoubleTimeStep = 0,
             const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
-            const LagrangeInterpolatorBoundaryHandling boundaryHandling = lagrange_cubic_spline_boundary_interpolation ):
-        InterpolatorSettings( lagrange_interpolator, selectedLookupScheme, useLongDoubleTimeStep ),
+            const LagrangeInterpolatorBoundaryHandling boundaryHandling = lagrange_cubic_spline_boundary_interpolation,
+            const DependentVariableStorageLayout storageLayout = node_wise_storage ):
+        InterpolatorSettings( lagrange_interpolator, selectedLookupScheme, useLongDoubleTimeStep, storageLayout ),
         interpolatorOrder_( interpolatorOrder ),
         boundaryHandling_( boundaryHandling )
     { }
@@ -197,13 +215,15 @@ createOneDimensionalInterpolator(
         {
             createdInterpolator = boost::make_shared< CubicSplineInterpolator
                     < IndependentVariableType, DependentVariableType > >(
-                        dataToInterpolate, interpolatorSettings->getSelectedLookupScheme( ) );
+                        dataToInterpolate, interpolatorSettings->getSelectedLookupScheme( ),
+                        interpolatorSettings->getStorageLayout( ) );
         }
         else
         {
             createdInterpolator = boost::make_shared< CubicSplineInterpolator
                     < IndependentVariableType, DependentVariableType, long double > >(
-                        dataToInterpolate, interpolatorSettings->getSelectedLookupScheme( ) );
+                        dataToInterpolate, interpolatorSettings->getSelectedLookupScheme( ),
+                        interpolatorSettings->getStorageLayout( ) );
         }
         break;
     }
@@ -221,7 +241,8 @@ createOneDimensionalInterpolator(
                         < IndependentVariableType, DependentVariableType, double > >(
                             dataToInterpolate, lagrangeInterpolatorSettings->getInterpolatorOrder( ),
                             interpolatorSettings->getSelectedLookupScheme( ),
-                            lagrangeInterpolatorSettings->getBoundaryHandling( ) );
+                            lagrangeInterpolatorSettings->getBoundaryHandling( ),
+                            interpolatorSettings->getStorageLayout( ) );
             }
             else
             {
@@ -229,7 +250,8 @@ createOneDimensionalInterpolator(
                         < IndependentVariableType, DependentVariableType, long double > >(
                             dataToInterpolate, lagrangeInterpolatorSettings->getInterpolatorOrder( ),
                             interpolatorSettings->getSelectedLookupScheme( ),
-                            lagrangeInterpolatorSettings->getBoundaryHandling( ) );
+                            lagrangeInterpolatorSettings->getBoundaryHandling( ),
+                            interpolatorSettings->getStorageLayout( ) );
             }
         }
         else
@@ -248,7 +270,8 @@ createOneDimensionalInterpolator(
         createdInterpolator = boost::make_shared< HermiteCubicSplineInterpolator
                 < IndependentVariableType, DependentVariableType > >(
                     dataToInterpolate, firstDerivativeOfDependentVariables,
-                    interpolatorSettings->getSelectedLookupScheme( ) );
+                    interpolatorSettings->getSelectedLookupScheme( ),
+                    interpolatorSettings->getStorageLayout( ) );
         break;
     }
 
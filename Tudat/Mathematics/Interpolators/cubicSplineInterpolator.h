@@ -22,6 +22,7 @@
 #include <Eigen/Core>
 
 #include <boost/exception/all.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include "Tudat/Mathematics/Interpolators/oneDimensionalInterpolator.h"
@@ -127,10 +128,12 @@ public:
      * \param dependentVariables Vector with the dependent variable values.
      * \param selectedLookupScheme Look-up scheme that is to be used when finding interval
      * of requested independent variable value.
+     * \param storageLayout Layout in which the dependent variables are to be stored.
      */
     CubicSplineInterpolator( const std::vector< IndependentVariableType >& independentVariables,
                              const std::vector< DependentVariableType >& dependentVariables,
-                             AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
+                             AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
+                             const DependentVariableStorageLayout storageLayout = node_wise_storage )
 
     {
         // Verify that the initialization variables are not empty.
@@ -163,6 +166,11 @@ public:
 
         // Calculate second derivatives of curve.
         calculateSecondDerivatives( );
+
+        if( storageLayout == component_major_storage )
+        {
+            setComponentMajorStorage( );
+        }
     }
 
     //! Cubic spline interpolator constructor.
@@ -173,10 +181,12 @@ public:
      * dependent variable values as values.
      * \param selectedLookupScheme Lookup scheme that is to be used when finding interval
      * of requested independent variable value.
+     * \param storageLayout Layout in which the dependent variables are to be stored.
      */
     CubicSplineInterpolator(
             const std::map< IndependentVariableType, DependentVariableType > dataMap,
-            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
+            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
+            const DependentVariableStorageLayout storageLayout = node_wise_storage )
     {
         // Verify that the initialization variables are not empty.
         if ( dataMap.size( ) == 0 )
@@ -205,6 +215,11 @@ public:
 
         // Calculate second derivatives of curve.
         calculateSecondDerivatives( );
+
+        if( storageLayout == component_major_storage )
+        {
+            setComponentMajorStorage( );
+        }
     }
 
     //! Default destructor
@@ -227,8 +242,23 @@ public:
     DependentVariableType interpolate(
             const IndependentVariableType targetIndependentVariableValue )
     {
-        using std::pow;
+        DependentVariableType interpolatedValue = zeroValue_;
+        interpolateInto( targetIndependentVariableValue, interpolatedValue );
+        return interpolatedValue;
+    }
 
+    //! Interpolate, without allocating the result.
+    /*!
+     * Executes interpolation of data at a given target value of the independent variable, writing the
+     * interpolated value of the dependent variable into an existing dependent variable (no memory is
+     * allocated if it is of the correct size).
+     * \param targetIndependentVariableValue Target independent variable value at which point
+     * the interpolation is performed.
+     * \param interpolatedValue Interpolated dependent variable value (returned by reference).
+     */
+    void interpolateInto( const IndependentVariableType targetIndependentVariableValue,
+                          DependentVariableType& interpolatedValue )
+    {
         // Determine the lower entry in the table corresponding to the target independent variable
         // value.
         int lowerEntry_ = lookUpScheme_->findNearestLowerNeighbour(
@@ -252,10 +282,27 @@ public:
                 mathematical_constants::getFloatingInteger< ScalarType >( 6.0 ) * squareDifference;
 
         // The interpolated dependent variable value.
-        return coefficientA_ * dependentValues_[ lowerEntry_ ] +
-                coefficientB_ * dependentValues_[ lowerEntry_ + 1 ] +
-                coefficientC_ * secondDerivativeOfCurve_[ lowerEntry_ ] +
-                coefficientD_ * secondDerivativeOfCurve_[ lowerEntry_ + 1 ];
+        if( this->componentMajorDependentValues_ != NULL )
+        {
+            this->componentMajorDependentValues_->setZeroValue( interpolatedValue );
+            typename ComponentMajorNodeValues< DependentVariableType >::ComponentType* interpolatedComponents =
+                    DependentVariableComponents< DependentVariableType >::getComponents( interpolatedValue );
+            for( int i = 0; i < this->componentMajorDependentValues_->getNumberOfComponents( ); i++ )
+            {
+                interpolatedComponents[ i ] =
+                        coefficientA_ * this->componentMajorDependentValues_->getComponentValues( i )[ lowerEntry_ ] +
+                        coefficientB_ * this->componentMajorDependentValues_->getComponentValues( i )[ lowerEntry_ + 1 ] +
+                        coefficientC_ * componentMajorSecondDerivatives_->getComponentValues( i )[ lowerEntry_ ] +
+                        coefficientD_ * componentMajorSecondDerivatives_->getComponentValues( i )[ lowerEntry_ + 1 ];
+            }
+        }
+        else
+        {
+            interpolatedValue = coefficientA_ * dependentValues_[ lowerEntry_ ] +
+                    coefficientB_ * dependentValues_[ lowerEntry_ + 1 ] +
+                    coefficientC_ * secondDerivativeOfCurve_[ lowerEntry_ ] +
+                    coefficientD_ * secondDerivativeOfCurve_[ lowerEntry_ + 1 ];
+        }
     }
 
 protected:
@@ -337,12 +384,28 @@ private:
         secondDerivativeOfCurve_[ numberOfDataPoints_ - 1 ] = zeroValue_;
     }
 
+    //! Function to move the dependent variables and second derivatives into contiguous component-major storage.
+    void setComponentMajorStorage( )
+    {
+        this->setComponentMajorDependentValues( );
+        componentMajorSecondDerivatives_ = boost::make_shared< ComponentMajorNodeValues< DependentVariableType > >(
+                    secondDerivativeOfCurve_ );
+        std::vector< DependentVariableType >( ).swap( secondDerivativeOfCurve_ );
+    }
+
     //! Vector filled with second derivative of curvature of each point.
     /*!
      *  Vector filled with second derivative of curvature of each point.
      */
     std::vector< DependentVariableType > secondDerivativeOfCurve_;
 
+    //! Second derivative of curvature of each point in contiguous component-major storage.
+    /*!
+     *  Second derivative of curvature of each point in contiguous component-major storage, only set (in which case
+     *  secondDerivativeOfCurve_ is empty) if the interpolator uses component_major_storage.
+     */
+    boost::shared_ptr< ComponentMajorNodeValues< DependentVariableType > > componentMajorSecondDerivatives_;
+
     //! The number of datapoints.
     /*!
      * The number of datapoints.
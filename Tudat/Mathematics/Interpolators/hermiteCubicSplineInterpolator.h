@@ -15,6 +15,8 @@
 #include <Eigen/Core>
 #include <vector>
 
+#include <boost/make_shared.hpp>
+
 #include <Tudat/Mathematics/Interpolators/interpolator.h>
 #include <Tudat/Mathematics/Interpolators/oneDimensionalInterpolator.h>
 
@@ -43,7 +45,8 @@ public:
             const std::vector< IndependentVariableType >& independentValues,
             const std::vector< DependentVariableType >& dependentValues,
             const std::vector< DependentVariableType >& derivativeValues,
-            AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
+            AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
+            const DependentVariableStorageLayout storageLayout = node_wise_storage )
     {
         // Check consistency of input data.
         if( dependentValues.size( ) != independentValues.size( ) )
@@ -73,12 +76,18 @@ public:
 
         // Create lookup scheme.
         this->makeLookupScheme( selectedLookupScheme );
+
+        if( storageLayout == component_major_storage )
+        {
+            setComponentMajorStorage( );
+        }
     }
 
     HermiteCubicSplineInterpolator(
             const std::map< IndependentVariableType, DependentVariableType >& dataMap,
             const std::vector< DependentVariableType >& derivativeValues,
-            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
+            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
+            const DependentVariableStorageLayout storageLayout = node_wise_storage )
     {
 
         if( dataMap.size( ) != derivativeValues.size( ) )
@@ -103,6 +112,11 @@ public:
 
         // Create lookup scheme.
         this->makeLookupScheme( selectedLookupScheme );
+
+        if( storageLayout == component_major_storage )
+        {
+            setComponentMajorStorage( );
+        }
     }
 
     //! Destructor
@@ -114,6 +128,19 @@ public:
     //! Get coefficients
     std::vector< std::vector< DependentVariableType > > GetCoefficients( )
     {
+        if( this->componentMajorDependentValues_ != NULL )
+        {
+            std::vector< std::vector< DependentVariableType > > coefficients;
+            for( unsigned int i = 0; i < componentMajorCoefficients_.size( ); i++ )
+            {
+                coefficients.push_back( componentMajorCoefficients_.at( i )->getNodeValues( ) );
+            }
+
+            // Coefficient d is equal to the dependent variable at the start of each interval.
+            coefficients.push_back( this->componentMajorDependentValues_->getNodeValues( ) );
+            coefficients.back( ).pop_back( );
+            return coefficients;
+        }
         return coefficients_;
     }
 
@@ -125,6 +152,22 @@ public:
      *  \return Interpolated value of interpolated dependent variable.
      */
     DependentVariableType interpolate( const IndependentVariableType targetIndependentVariableValue )
+    {
+        DependentVariableType targetValue;
+        interpolateInto( targetIndependentVariableValue, targetValue );
+        return targetValue;
+    }
+
+    //! Function interpolates dependent variable value at given independent variable value, without allocating the result.
+    /*!
+     *  Function interpolates dependent variable value at given independent variable value, writing the result into
+     *  an existing dependent variable (no memory is allocated if it is of the correct size).
+     *  \param targetIndependentVariableValue Value of independent variable at which interpolation
+     *  is to take place.
+     *  \param targetValue Interpolated value of interpolated dependent variable (returned by reference).
+     */
+    void interpolateInto( const IndependentVariableType targetIndependentVariableValue,
+                          DependentVariableType& targetValue )
     {
         // Determine the lower entry in the table corresponding to the target independent variable value.
         int lowerEntry_ = lookUpScheme_->findNearestLowerNeighbour(
@@ -133,13 +176,28 @@ public:
         // Compute Hermite spline
         IndependentVariableType factor = ( targetIndependentVariableValue - independentValues_[ lowerEntry_ ] )
                 /( independentValues_[ lowerEntry_ + 1 ] - independentValues_[ lowerEntry_ ] );
-        DependentVariableType targetValue =
-                coefficients_[ 0 ][ lowerEntry_ ] * factor * factor * factor
-                + coefficients_[ 1 ][ lowerEntry_ ] * factor * factor
-                + coefficients_[ 2 ][ lowerEntry_ ] * factor
-                + coefficients_[ 3 ][ lowerEntry_ ] ;
-
-        return targetValue;
+        if( this->componentMajorDependentValues_ != NULL )
+        {
+            this->componentMajorDependentValues_->setZeroValue( targetValue );
+            typename ComponentMajorNodeValues< DependentVariableType >::ComponentType* targetComponents =
+                    DependentVariableComponents< DependentVariableType >::getComponents( targetValue );
+            for( int i = 0; i < this->componentMajorDependentValues_->getNumberOfComponents( ); i++ )
+            {
+                targetComponents[ i ] =
+                        componentMajorCoefficients_[ 0 ]->getComponentValues( i )[ lowerEntry_ ] * factor * factor * factor
+                        + componentMajorCoefficients_[ 1 ]->getComponentValues( i )[ lowerEntry_ ] * factor * factor
+                        + componentMajorCoefficients_[ 2 ]->getComponentValues( i )[ lowerEntry_ ] * factor
+                        + this->componentMajorDependentValues_->getComponentValues( i )[ lowerEntry_ ];
+            }
+        }
+        else
+        {
+            targetValue =
+                    coefficients_[ 0 ][ lowerEntry_ ] * factor * factor * factor
+                    + coefficients_[ 1 ][ lowerEntry_ ] * factor * factor
+                    + coefficients_[ 2 ][ lowerEntry_ ] * factor
+                    + coefficients_[ 3 ][ lowerEntry_ ] ;
+        }
     }
 
 protected:
@@ -179,6 +237,24 @@ protected:
     }
 
 
+    //! Function to move the dependent variables and coefficients into contiguous component-major storage.
+    /*!
+     *  Function to move the dependent variables and coefficients into contiguous component-major storage. Since
+     *  coefficient d is equal to the dependent variable at the start of each interval, only coefficients a, b and c are
+     *  stored separately. The derivatives, which are no longer needed, are cleared.
+     */
+    void setComponentMajorStorage( )
+    {
+        this->setComponentMajorDependentValues( );
+        for( int i = 0; i < 3; i++ )
+        {
+            componentMajorCoefficients_.push_back(
+                        boost::make_shared< ComponentMajorNodeValues< DependentVariableType > >( coefficients_[ i ] ) );
+        }
+        std::vector< std::vector< DependentVariableType > >( ).swap( coefficients_ );
+        std::vector< DependentVariableType >( ).swap( derivativeValues_ );
+    }
+
 private:
 
     //! Derivatives of dependent variable to independent variable
@@ -186,6 +262,9 @@ private:
 
     //! Coefficients of splines
     std::vector< std::vector< DependentVariableType > > coefficients_ ;
+
+    //! Coefficients a, b and c of splines in contiguous component-major storage (only used for component_major_storage)
+    std::vector< boost::shared_ptr< ComponentMajorNodeValues< DependentVariableType > > > componentMajorCoefficients_;
 };
 
 //! Typede for cubic hermite spline with double (in)dependent variables.
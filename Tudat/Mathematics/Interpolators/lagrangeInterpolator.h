@@ -15,6 +15,8 @@
 #ifndef TUDAT_LAGRANGEINTERPOLATOR_H
 #define TUDAT_LAGRANGEINTERPOLATOR_H
 
+#include <cmath>
+
 #include <boost/make_shared.hpp>
 
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
@@ -45,7 +47,11 @@ enum LagrangeInterpolatorBoundaryHandling
  *  for many function calls to interpolate, since the denominators for
  *  the interpolations are pre-computed for all interpolation intervals.
  *  See e.g. http://mathworld.wolfram.com/LagrangeInterpolatingPolynomial.html for
- *  mathematical details
+ *  mathematical details. If the equidistantLookup scheme is selected, and the independent variables
+ *  are equidistant to within a relative tolerance of 1.0E-12 of the step size, the (barycentric) weights
+ *  of the interpolating polynomial are identical for each interval. In that case, a single set of
+ *  weights is pre-computed, and the barycentric form of the interpolating polynomial is used (see
+ *  Berrut and Trefethen, 2004).
  */
 template< typename IndependentVariableType, typename DependentVariableType,
           typename ScalarType = IndependentVariableType >
@@ -73,13 +79,15 @@ public:
      *  to find the nearest lower data point in the independent variables when requesting
      *  interpolation.
      *  \param boundaryHandling Boundary handling does something.
+     *  \param storageLayout Layout in which the dependent variables are to be stored.
      */
     LagrangeInterpolator( const std::vector< IndependentVariableType >& independentVariables,
                           const std::vector< DependentVariableType >& dependentVariables,
                           const int numberOfStages,
                           const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
                           const LagrangeInterpolatorBoundaryHandling boundaryHandling =
-            lagrange_cubic_spline_boundary_interpolation ):
+            lagrange_cubic_spline_boundary_interpolation,
+                          const DependentVariableStorageLayout storageLayout = node_wise_storage ):
         numberOfStages_( numberOfStages ), boundaryHandling_( boundaryHandling )
     {
         if( numberOfStages_ % 2 != 0 )
@@ -126,11 +134,15 @@ public:
 
         // Calculate denominators for each interval, to prevent recalculations dueint each
         // interpolation call.
-        initializeDenominators( );
-        initializeBoundaryInterpolators( selectedLookupScheme );
+        initializeDenominators( selectedLookupScheme );
+        initializeBoundaryInterpolators( selectedLookupScheme, storageLayout );
+
+        // Pre-allocate cache vectors for computational efficiency.
 
-        // Pre-allocate cache vector for computational efficiency.
-        independentVariableDifferenceCache.resize( 2 * offsetEntries_ + 2 );
+        if( storageLayout == component_major_storage )
+        {
+            this->setComponentMajorDependentValues( );
+        }
     }
 
     //! Constructor from map of independent/dependent data.
@@ -146,13 +158,15 @@ public:
      *  to find the nearest lower data point in the independent variables when requesting
      *  interpolation.
      *  \param boundaryHandling Boundary Handling does something.
+     *  \param storageLayout Layout in which the dependent variables are to be stored.
      */
     LagrangeInterpolator(
             const std::map< IndependentVariableType, DependentVariableType >& dataMap,
             const int numberOfStages,
             const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
             const LagrangeInterpolatorBoundaryHandling boundaryHandling =
-            lagrange_cubic_spline_boundary_interpolation ):
+            lagrange_cubic_spline_boundary_interpolation,
+            const DependentVariableStorageLayout storageLayout = node_wise_storage ):
         numberOfStages_( numberOfStages ), boundaryHandling_( boundaryHandling )
     {
         if( numberOfStages_ % 2 != 0 )
@@ -191,10 +205,14 @@ public:
 
         // Calculate denominators for each interval, to prevent recalculations dueint each
         //interpolation call.
-        initializeDenominators( );
-        initializeBoundaryInterpolators( selectedLookupScheme );
+        initializeDenominators( selectedLookupScheme );
+        initializeBoundaryInterpolators( selectedLookupScheme, storageLayout );
 
-        independentVariableDifferenceCache.resize( 2 * offsetEntries_ + 2 );
+
+        if( storageLayout == component_major_storage )
+        {
+            this->setComponentMajorDependentValues( );
+        }
     }
 
     //! Destructor.
@@ -218,11 +236,26 @@ public:
     DependentVariableType interpolate(
             const IndependentVariableType targetIndependentVariableValue )
     {
-        using std::pow;
+        DependentVariableType interpolatedValue = zeroEntry_;
+        interpolateInto( targetIndependentVariableValue, interpolatedValue );
+        return interpolatedValue;
+    }
 
+    //! Function interpolates dependent variable value at given independent variable value, without allocating the result.
+    /*!
+     *  Function interpolates dependent variable value at given independent variable value, writing the result into
+     *  an existing dependent variable (no memory is allocated if it is of the correct size).
+     *  \sa interpolate
+     *  \param targetIndependentVariableValue Value of independent variable at which interpolation
+     *  is to take place.
+     *  \param interpolatedValue Interpolated value of dependent variable (returned by reference).
+     */
+    void interpolateInto( const IndependentVariableType targetIndependentVariableValue,
+                          DependentVariableType& interpolatedValue )
+    {
         // Determine the lower entry in the table corresponding to the target independent variable
         // value.
-        DependentVariableType interpolatedValue = zeroEntry_;
+        setZeroValue( interpolatedValue );
 
         // Find interpolation interval
         int lowerEntry = lookUpScheme_->findNearestLowerNeighbour(
@@ -239,8 +272,8 @@ public:
             }
             else if( numberOfStages_ > 2 )
             {
-                interpolatedValue = beginInterpolator_->interpolate(
-                            targetIndependentVariableValue );
+                beginInterpolator_->interpolateInto(
+                            targetIndependentVariableValue, interpolatedValue );
             }
         }
         else if( lowerEntry >= numberOfIndependentValues_ - offsetEntries_ - 1 )
@@ -252,60 +285,68 @@ public:
             }
             else if( numberOfStages_ > 2 )
             {
-                interpolatedValue = endInterpolator_->interpolate(
-                            targetIndependentVariableValue );
+                endInterpolator_->interpolateInto(
+                            targetIndependentVariableValue, interpolatedValue );
             }
         }
         else
         {
-            // Initialize repeated numerator to 1
-            ScalarType repeatedNumerator =
-                    mathematical_constants::getFloatingInteger< ScalarType >( 1 );
-
             // Check if requested independent variable is equal to data point
             if( independentValues_[ lowerEntry ] == targetIndependentVariableValue )
             {
-                interpolatedValue = dependentValues_[ lowerEntry ];
+                getNodeValue( lowerEntry, interpolatedValue );
             }
             else if( independentValues_[ lowerEntry + 1 ] == targetIndependentVariableValue )
             {
-                interpolatedValue = dependentValues_[ lowerEntry + 1 ];
+                getNodeValue( lowerEntry + 1, interpolatedValue );
             }
-            else if( independentValues_[ lowerEntry - 1 ] == targetIndependentVariableValue )
+            else if( lowerEntry > 0 && independentValues_[ lowerEntry - 1 ] == targetIndependentVariableValue )
             {
-                interpolatedValue = dependentValues_[ lowerEntry - 1 ];
+                getNodeValue( lowerEntry - 1, interpolatedValue );
             }
             else
             {
-                // Set up repeated numerator and cache of independent variable values from which
-                // interpolant is created.
-                int j = 0;
-                for( int i = 0; i <= 2 * offsetEntries_ + 1; i++ )
+                // Compute weights of the dependent variables in the interpolating polynomial.
+                std::vector< ScalarType >& weights = getWeightsBuffer( );
+                weights.resize( 2 * offsetEntries_ + 2 );
+                if( useBarycentricWeights_ )
                 {
-                    j = i + lowerEntry - offsetEntries_;
-                    independentVariableDifferenceCache[ i ] =
-                            static_cast< ScalarType >(
-                                targetIndependentVariableValue - independentValues_[ j ] );
-
-                    repeatedNumerator *= independentVariableDifferenceCache[ i ];
-
+                    computeBarycentricInterpolationWeights( targetIndependentVariableValue, lowerEntry, weights );
+                }
+                else
+                {
+                    computeInterpolationWeights( targetIndependentVariableValue, lowerEntry, weights );
                 }
 
                 // Evaluate interpolating polynomial at requested data point.
-                for( int i = 0; i <=  2 *offsetEntries_ + 1; i++ )
+                if( this->componentMajorDependentValues_ != NULL )
+                {
+                    this->componentMajorDependentValues_->addWeightedNodeValues(
+                                lowerEntry - offsetEntries_, weights, interpolatedValue );
+                }
+                else
                 {
-                    j = i + lowerEntry - offsetEntries_;
-                    interpolatedValue += dependentValues_[ j ]  *
-                            ( repeatedNumerator /
-                              ( independentVariableDifferenceCache[ i ] *
-                                denominators[ lowerEntry ][ j - lowerEntry + offsetEntries_ ] ) );
+                    int j = 0;
+                    for( int i = 0; i <= 2 * offsetEntries_ + 1; i++ )
+                    {
+                        j = i + lowerEntry - offsetEntries_;
+                        interpolatedValue += dependentValues_[ j ] * weights[ i ];
+                    }
                 }
             }
         }
-
-        return interpolatedValue;
     }
 
+    //! Function to return whether the barycentric form of the interpolating polynomial is used.
+    /*!
+     *  Function to return whether the barycentric form of the interpolating polynomial is used, with a single set
+     *  of pre-computed weights for all intervals (only for equidistant independent variables).
+     *  \return True if the barycentric form of the interpolating polynomial is used.
+     */
+    bool getUseBarycentricWeights( )
+    {
+        return useBarycentricWeights_;
+    }
 
 protected:
 
@@ -315,9 +356,12 @@ private:
     //! interpolants at each interval.
     /*!
      *  Function called at initialization which pre-computes the denominators of the interpolants
-     *  at each interval, i.e. each interval between two subsequent independent variable values.
+     *  at each interval, i.e. each interval between two subsequent independent variable values. If
+     *  the equidistantLookup scheme is used, and the independent variables are equidistant, a single
+     *  set of barycentric weights is computed instead.
+     *  \param selectedLookupScheme Identifier of lookup scheme from enum.
      */
-    void initializeDenominators( )
+    void initializeDenominators( const AvailableLookupScheme selectedLookupScheme )
     {
         // Check validity of requested number of stages"
         if( numberOfStages_% 2 != 0 )
@@ -334,10 +378,27 @@ private:
         // Determine offset from boundary of interpolation interval where interpolant is valid.
         offsetEntries_ = numberOfStages_ / 2 - 1;
 
+        // For equidistant data, compute barycentric weights (-1)^j * binomial( numberOfStages_ - 1, j ), which are
+        // identical for each interval (up to a constant factor that cancels in the barycentric formula).
+        useBarycentricWeights_ = ( selectedLookupScheme == equidistantLookup ) &&
+                areIndependentVariablesEquidistant( );
+        if( useBarycentricWeights_ )
+        {
+            barycentricWeights_.resize( 2 * offsetEntries_ + 2 );
+            barycentricWeights_[ 0 ] = mathematical_constants::getFloatingInteger< ScalarType >( 1 );
+            for( int j = 1; j <= 2 * offsetEntries_ + 1; j++ )
+            {
+                barycentricWeights_[ j ] = -barycentricWeights_[ j - 1 ] *
+                        mathematical_constants::getFloatingInteger< ScalarType >( numberOfStages_ - j ) /
+                        mathematical_constants::getFloatingInteger< ScalarType >( j );
+            }
+            return;
+        }
+
         // Iterate over all intervals and calculate denominators
         int currentIterationStart;
         denominators.resize( numberOfIndependentValues_ );
-        for( int i = offsetEntries_; i <= numberOfIndependentValues_ - offsetEntries_; i++ )
+        for( int i = offsetEntries_; i < numberOfIndependentValues_ - offsetEntries_ - 1; i++ )
         {
             // Determine start index in independent variables for current polynomial
             currentIterationStart = i - offsetEntries_;
@@ -363,6 +424,149 @@ private:
         }
     }
 
+    //! Function to determine whether the independent variables are equidistant.
+    /*!
+     *  Function to determine whether the independent variables are equidistant, to within a relative tolerance of
+     *  1.0E-12 of the step size.
+     *  \return True if the independent variables are equidistant.
+     */
+    bool areIndependentVariablesEquidistant( )
+    {
+        if( numberOfIndependentValues_ < 2 )
+        {
+            return false;
+        }
+
+        const long double stepSize = static_cast< long double >(
+                    independentValues_.back( ) - independentValues_.front( ) ) /
+                static_cast< long double >( numberOfIndependentValues_ - 1 );
+        for( int i = 1; i < numberOfIndependentValues_; i++ )
+        {
+            if( std::fabs( static_cast< long double >( independentValues_[ i ] - independentValues_.front( ) ) -
+                           static_cast< long double >( i ) * stepSize ) > 1.0E-12L * stepSize )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    //! Function to compute the weights of the dependent variables in the interpolating polynomial.
+    /*!
+     *  Function to compute the weights of the dependent variables in the interpolating polynomial, from the
+     *  pre-computed denominators of the current interval.
+     *  \param targetIndependentVariableValue Value of independent variable at which interpolation
+     *  is to take place.
+     *  \param lowerEntry Nearest lower neighbour of targetIndependentVariableValue.
+     *  \param weights Weights of the dependent variables, of size numberOfStages_ (returned by reference).
+     */
+    void computeInterpolationWeights( const IndependentVariableType targetIndependentVariableValue,
+                                      const int lowerEntry,
+                                      std::vector< ScalarType >& weights )
+    {
+        // Initialize repeated numerator to 1
+        ScalarType repeatedNumerator =
+                mathematical_constants::getFloatingInteger< ScalarType >( 1 );
+
+        // Set up repeated numerator, temporarily storing the differences w.r.t. the independent variable values from
+        // which interpolant is created in the weights.
+        int j = 0;
+        for( int i = 0; i <= 2 * offsetEntries_ + 1; i++ )
+        {
+            j = i + lowerEntry - offsetEntries_;
+            weights[ i ] =
+                    static_cast< ScalarType >(
+                        targetIndependentVariableValue - independentValues_[ j ] );
+
+            repeatedNumerator *= weights[ i ];
+
+        }
+
+        for( int i = 0; i <= 2 * offsetEntries_ + 1; i++ )
+        {
+            weights[ i ] = repeatedNumerator /
+                    ( weights[ i ] * denominators[ lowerEntry ][ i ] );
+        }
+    }
+
+    //! Function to compute the weights of the dependent variables in the barycentric interpolating polynomial.
+    /*!
+     *  Function to compute the weights of the dependent variables in the barycentric form of the interpolating
+     *  polynomial, from the pre-computed barycentric weights (for equidistant independent variables).
+     *  \param targetIndependentVariableValue Value of independent variable at which interpolation
+     *  is to take place.
+     *  \param lowerEntry Nearest lower neighbour of targetIndependentVariableValue.
+     *  \param weights Weights of the dependent variables, of size numberOfStages_ (returned by reference).
+     */
+    void computeBarycentricInterpolationWeights( const IndependentVariableType targetIndependentVariableValue,
+                                                 const int lowerEntry,
+                                                 std::vector< ScalarType >& weights )
+    {
+        ScalarType sumOfWeights = mathematical_constants::getFloatingInteger< ScalarType >( 0 );
+
+        int j = 0;
+        for( int i = 0; i <= 2 * offsetEntries_ + 1; i++ )
+        {
+            j = i + lowerEntry - offsetEntries_;
+            weights[ i ] = barycentricWeights_[ i ] / static_cast< ScalarType >(
+                        targetIndependentVariableValue - independentValues_[ j ] );
+            sumOfWeights += weights[ i ];
+        }
+
+        for( int i = 0; i <= 2 * offsetEntries_ + 1; i++ )
+        {
+            weights[ i ] /= sumOfWeights;
+        }
+    }
+
+    //! Function to retrieve the buffer in which the weights of the interpolating polynomial are computed.
+    /*!
+     *  Function to retrieve the buffer in which the weights of the interpolating polynomial are computed. A separate
+     *  buffer is used by each thread (shared by all interpolators on that thread), so that interpolations may be
+     *  performed concurrently. Memory is only allocated when the buffer first needs to grow on a thread.
+     *  \return Buffer for the weights of the interpolating polynomial.
+     */
+    static std::vector< ScalarType >& getWeightsBuffer( )
+    {
+        static thread_local std::vector< ScalarType > weightsBuffer;
+        return weightsBuffer;
+    }
+
+    //! Function to set the size of a dependent variable to that of the data, and its value to zero.
+    /*!
+     *  Function to set the size of a dependent variable to that of the data, and its value to zero.
+     *  \param value Dependent variable that is to be set to zero (returned by reference).
+     */
+    void setZeroValue( DependentVariableType& value )
+    {
+        if( this->componentMajorDependentValues_ != NULL )
+        {
+            this->componentMajorDependentValues_->setZeroValue( value );
+        }
+        else
+        {
+            value = zeroEntry_;
+        }
+    }
+
+    //! Function to retrieve the dependent variable at a given node.
+    /*!
+     *  Function to retrieve the dependent variable at a given node.
+     *  \param nodeIndex Index of node.
+     *  \param value Dependent variable at node (returned by reference).
+     */
+    void getNodeValue( const int nodeIndex, DependentVariableType& value )
+    {
+        if( this->componentMajorDependentValues_ != NULL )
+        {
+            this->componentMajorDependentValues_->getNodeValue( nodeIndex, value );
+        }
+        else
+        {
+            value = dependentValues_[ nodeIndex ];
+        }
+    }
+
     //! Function called at initialization which creates the interpolators used at the boundaries
     //! of the interpolation domain.
     /*!
@@ -373,9 +577,11 @@ private:
      *  these regions, the interpolator applies any of a number of techniques, defined by the
      *  boundaryHandling_ variable.
      *  \param selectedLookupScheme Selected lookup scheme does something.
+     *  \param storageLayout Layout in which the dependent variables are to be stored.
      */
     void initializeBoundaryInterpolators(
-            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm )
+            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm,
+            const DependentVariableStorageLayout storageLayout = node_wise_storage )
     {
         // Create interpolators
         if( boundaryHandling_ == lagrange_cubic_spline_boundary_interpolation )
@@ -402,9 +608,11 @@ private:
 
             // Create cubic spline interpolators
             beginInterpolator_ = boost::make_shared< CubicSplineInterpolator
-                    < IndependentVariableType, DependentVariableType, ScalarType > >( startMap );
+                    < IndependentVariableType, DependentVariableType, ScalarType > >(
+                        startMap, huntingAlgorithm, storageLayout );
             endInterpolator_ = boost::make_shared< CubicSplineInterpolator
-                    < IndependentVariableType, DependentVariableType, ScalarType > >( endMap );
+                    < IndependentVariableType, DependentVariableType, ScalarType > >(
+                        endMap, huntingAlgorithm, storageLayout );
         }
     }
 
@@ -432,7 +640,11 @@ private:
      */
     int offsetEntries_;
 
-    std::vector< ScalarType > independentVariableDifferenceCache;
+    //! Pre-computed barycentric weights, used for all intervals if useBarycentricWeights_ is true.
+    std::vector< ScalarType > barycentricWeights_;
+
+    //! Boolean denoting whether the barycentric form with barycentricWeights_ is used (for equidistant data).
+    bool useBarycentricWeights_;
 
     //! Interpolator to be used at beginning of domain.
     boost::shared_ptr< OneDimensionalInterpolator
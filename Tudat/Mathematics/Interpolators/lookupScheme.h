@@ -12,6 +12,9 @@
 #ifndef TUDAT_LOOK_UP_SCHEME_H
 #define TUDAT_LOOK_UP_SCHEME_H
 
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
 #include <vector>
 
 #include <boost/shared_ptr.hpp>
@@ -30,7 +33,8 @@ namespace interpolators
 enum AvailableLookupScheme
 {
     huntingAlgorithm,
-    binarySearch
+    binarySearch,
+    equidistantLookup
 };
 
 //! Look-up scheme class for nearest left neighbour search.
@@ -80,7 +84,9 @@ protected:
 
 //! Look-up scheme class for nearest left neighbour search using hunting algorithm.
 /*!
- *  Look-up scheme class for nearest left neighbour search using hunting algorithm.
+ *  Look-up scheme class for nearest left neighbour search using hunting algorithm. The result of the previous look-up,
+ *  from which the hunt is started, is stored atomically, so that the look-up may be called concurrently from several
+ *  threads (each look-up then starts from the result of one of the previous look-ups, which does not affect its result).
  *  \tparam IndependentVariableType Type of entries of vector in which lookup is to be performed.
  */
 template< typename IndependentVariableType >
@@ -99,8 +105,7 @@ public:
     HuntingAlgorithmLookupScheme( const std::vector< IndependentVariableType >&
                                   independentVariableValues )
         : LookUpScheme< IndependentVariableType >( independentVariableValues ),
-          isFirstLookupDone( 0 ),
-          previousNearestLowerIndex_( 0 )
+          previousNearestLowerIndex_( -1 )
     { }
 
     //! Default destructor
@@ -121,22 +126,22 @@ public:
     {
         // Initialize return value.
         int newNearestLowerIndex = 0;
+        const int previousNearestLowerIndex = previousNearestLowerIndex_.load( std::memory_order_relaxed );
 
         // If this is first call of function, use binary search.
-        if ( !isFirstLookupDone )
+        if ( previousNearestLowerIndex < 0 )
         {
             newNearestLowerIndex = basic_mathematics::computeNearestLeftNeighborUsingBinarySearch
                     < IndependentVariableType >( independentVariableValues_, valueToLookup );
-            isFirstLookupDone = 1;
         }
 
         else
         {
             // If requested value is in same interval, return same value as previous time.
             if ( basic_mathematics::isIndependentVariableInInterval< IndependentVariableType >
-                 ( previousNearestLowerIndex_,  valueToLookup, independentVariableValues_ ) )
+                 ( previousNearestLowerIndex,  valueToLookup, independentVariableValues_ ) )
             {
-                newNearestLowerIndex = previousNearestLowerIndex_;
+                newNearestLowerIndex = previousNearestLowerIndex;
             }
 
             // Otherwise, perform hunting algorithm.
@@ -145,29 +150,23 @@ public:
                 newNearestLowerIndex =
                         basic_mathematics::findNearestLeftNeighbourUsingHuntingAlgorithm<
                         IndependentVariableType >
-                        (  valueToLookup, previousNearestLowerIndex_, independentVariableValues_ );
+                        (  valueToLookup, previousNearestLowerIndex, independentVariableValues_ );
             }
         }
 
         // Set calculated value for use in next call.
-        previousNearestLowerIndex_ = newNearestLowerIndex;
+        previousNearestLowerIndex_.store( newNearestLowerIndex, std::memory_order_relaxed );
 
         return newNearestLowerIndex;
     }
 
 private:
 
-    //! Boolean to denote whether a lookup has been done.
-    /*!
-     * Boolean to denote whether a lookup has been done.
-     */
-    bool isFirstLookupDone;
-
     //! Nearest left index during previous call.
     /*!
-     * Nearest left index during previous call
+     * Nearest left index during previous call (-1 if no lookup has been done).
      */
-    int previousNearestLowerIndex_;
+    std::atomic< int > previousNearestLowerIndex_;
 };
 
 //! Look-up scheme class for nearest left neighbour search using binary search algorithm.
@@ -213,6 +212,129 @@ public:
     }
 };
 
+//! Look-up scheme class for nearest left neighbour search in (nearly) equidistant data.
+/*!
+ * Look-up scheme class for nearest left neighbour search in (nearly) equidistant data, such as the output of a
+ * fixed step size numerical integration. The nearest left neighbour is estimated directly from the (constant) step
+ * size of the independent variable values, and subsequently corrected using the actual independent variable values.
+ * As a result, the look-up requires a constant number of operations, independent of the size of the data and of the
+ * previously requested value, and its result is identical to that of the binary search algorithm. An exception is
+ * thrown upon construction if the independent variable values deviate by more than half a step from an equidistant
+ * grid.
+ * \tparam IndependentVariableType Type of entries of vector in which lookup is to be performed.
+ */
+template< typename IndependentVariableType >
+class EquidistantLookupScheme: public LookUpScheme< IndependentVariableType >
+{
+public:
+
+    using LookUpScheme< IndependentVariableType >::independentVariableValues_;
+
+    //! Constructor, used to set data vector.
+    /*!
+     * Constructor, used to set data vector, and compute the step size of the independent variable values.
+     * \param independentVariableValues vector of independent variable values in which to perform
+     * lookup procedure.
+     */
+    EquidistantLookupScheme( const std::vector< IndependentVariableType >& independentVariableValues )
+        : LookUpScheme< IndependentVariableType >( independentVariableValues )
+    {
+        numberOfValues_ = static_cast< int >( independentVariableValues_.size( ) );
+        if( numberOfValues_ < 2 )
+        {
+            throw std::runtime_error( "Error when creating equidistant lookup scheme, at least two values required" );
+        }
+
+        stepSize_ = static_cast< long double >(
+                    independentVariableValues_.back( ) - independentVariableValues_.front( ) ) /
+                static_cast< long double >( numberOfValues_ - 1 );
+        if( !( stepSize_ > 0.0L ) )
+        {
+            throw std::runtime_error(
+                        "Error when creating equidistant lookup scheme, values must be in ascending order" );
+        }
+
+        // Check whether the estimated nearest left neighbour is sufficiently close to the actual one.
+        for( int i = 0; i < numberOfValues_; i++ )
+        {
+            if( std::fabs( static_cast< long double >(
+                               independentVariableValues_[ i ] - independentVariableValues_.front( ) ) -
+                           static_cast< long double >( i ) * stepSize_ ) > 0.5L * stepSize_ )
+            {
+                throw std::runtime_error(
+                            "Error when creating equidistant lookup scheme, values are not equidistant" );
+            }
+        }
+    }
+
+    //! Default destructor
+    /*!
+     *  Default destructor
+     */
+    ~EquidistantLookupScheme( ){ }
+
+    //! Find nearest left neighbour.
+    /*!
+     * Function finds nearest left neighbour of given value in independentVariableValues_, by estimating it from the
+     * step size, and correcting the estimate using the independent variable values.
+     * \param valueToLookup Value of which nearest neaighbour is to be determined.
+     * \return Index of entry in independentVariableValues_ vector which is nearest lower neighbour
+     * to valueToLookup.
+     */
+    int findNearestLowerNeighbour( const IndependentVariableType valueToLookup )
+    {
+        int lowerIndex = 0;
+        if( !( valueToLookup == valueToLookup ) )
+        {
+            throw std::runtime_error( "Error in equidistant lookup scheme, input is NaN" );
+        }
+        else if( valueToLookup >= independentVariableValues_[ numberOfValues_ - 1 ] )
+        {
+            lowerIndex = numberOfValues_ - 2;
+        }
+        else if( valueToLookup > independentVariableValues_[ 0 ] )
+        {
+            // Estimate nearest left neighbour from step size.
+            lowerIndex = static_cast< int >(
+                        static_cast< long double >( valueToLookup - independentVariableValues_[ 0 ] ) / stepSize_ );
+            if( lowerIndex > numberOfValues_ - 2 )
+            {
+                lowerIndex = numberOfValues_ - 2;
+            }
+
+            // Correct estimate for rounding errors and deviations from equidistant data.
+            while( lowerIndex > 0 && valueToLookup < independentVariableValues_[ lowerIndex ] )
+            {
+                lowerIndex--;
+            }
+            while( lowerIndex < numberOfValues_ - 2 && valueToLookup >= independentVariableValues_[ lowerIndex + 1 ] )
+            {
+                lowerIndex++;
+            }
+        }
+
+        return lowerIndex;
+    }
+
+    //! Function to retrieve the step size of the independent variable values.
+    /*!
+     * Function to retrieve the step size of the independent variable values.
+     * \return Step size of the independent variable values.
+     */
+    long double getStepSize( )
+    {
+        return stepSize_;
+    }
+
+private:
+
+    //! Number of independent variable values.
+    int numberOfValues_;
+
+    //! Step size of the independent variable values.
+    long double stepSize_;
+};
+
 //! Typedef for shared-pointer to LookUpScheme object with double-type entries.
 typedef boost::shared_ptr< LookUpScheme< double > > LookUpSchemeDoublePointer;
 
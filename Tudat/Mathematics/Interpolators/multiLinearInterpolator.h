@@ -109,7 +109,9 @@ public:
 
     //! Function to perform interpolation.
     /*!
-     *  This function performs the multilinear interpolation.
+     *  This function performs the multilinear interpolation. All intermediate results (including the nearest lower
+     *  neighbours in each dimension) are stored in local variables, and the look-up schemes may be used concurrently,
+     *  so that this function may be called concurrently from several threads.
      *  \param independentValuesToInterpolate Vector of values of independent variables at which
      *  the value of the dependent variable is to be determined.
      *  \return Interpolated value of dependent variable in all dimensions.
@@ -118,8 +120,7 @@ public:
             const std::vector< IndependentVariableType >& independentValuesToInterpolate )
     {
         // Determine the nearest lower neighbours.
-        std::vector< int > nearestLowerIndices;
-        nearestLowerIndices.resize( NumberOfDimensions );
+        boost::array< int, NumberOfDimensions > nearestLowerIndices;
         for ( unsigned int i = 0; i < NumberOfDimensions; i++ )
         {
             nearestLowerIndices[ i ] = lookUpSchemes_[ i ]->findNearestLowerNeighbour(
@@ -221,7 +222,7 @@ private:
             const unsigned int currentVariable,
             const std::vector< IndependentVariableType >& independentValuesToInterpolate,
             boost::array< int, NumberOfDimensions > currentArrayIndices,
-            const std::vector< int >& nearestLowerIndices )
+            const boost::array< int, NumberOfDimensions >& nearestLowerIndices )
     {
         IndependentVariableType upperFraction, lowerFraction;
         DependentVariableType upperContribution, lowerContribution;
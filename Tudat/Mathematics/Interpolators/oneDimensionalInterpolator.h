@@ -15,8 +15,10 @@
 #include <iostream>
 #include <vector>
 
+#include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include "Tudat/Mathematics/Interpolators/componentMajorNodeValues.h"
 #include "Tudat/Mathematics/Interpolators/lookupScheme.h"
 #include "Tudat/Mathematics/Interpolators/interpolator.h"
 
@@ -80,6 +82,21 @@ public:
     virtual DependentVariableType
             interpolate( const IndependentVariableType independentVariableValue ) = 0;
 
+    //! Function to perform interpolation, writing the result into an existing dependent variable.
+    /*!
+     * This function performs the interpolation, writing the result into an existing dependent variable. Derived
+     * classes may override this function to perform the interpolation without allocating memory for the result (for
+     * dynamically sized dependent variables of the correct size). By default, the interpolate function is called.
+     * \param independentVariableValue Independent variable value at which the value of the
+     *          dependent variable is to be determined.
+     * \param interpolatedValue Interpolated value of dependent variable (returned by reference).
+     */
+    virtual void interpolateInto( const IndependentVariableType independentVariableValue,
+                                  DependentVariableType& interpolatedValue )
+    {
+        interpolatedValue = interpolate( independentVariableValue );
+    }
+
     //! Function to return the number of independent variables of the interpolation.
     /*!
      *  Function to return the number of independent variables of the interpolation, which is always
@@ -118,9 +135,23 @@ public:
      */
     std::vector< DependentVariableType > getDependentValues( )
     {
+        if( componentMajorDependentValues_ != NULL )
+        {
+            return componentMajorDependentValues_->getNodeValues( );
+        }
         return dependentValues_;
     }
 
+    //! Function to return the layout in which the dependent variables are stored by the interpolator.
+    /*!
+     *  Function to return the layout in which the dependent variables are stored by the interpolator.
+     *  \return Layout in which the dependent variables are stored by the interpolator.
+     */
+    DependentVariableStorageLayout getStorageLayout( )
+    {
+        return ( componentMajorDependentValues_ == NULL ) ? node_wise_storage : component_major_storage;
+    }
+
 protected:
 
     //! Make look-up scheme that is to be used.
@@ -152,11 +183,32 @@ protected:
                       ( independentValues_ ) );
             break;
 
+        case equidistantLookup:
+
+            // Create equidistant scheme, which computes the nearest lower neighbour from the step size.
+            lookUpScheme_ = boost::shared_ptr< LookUpScheme< IndependentVariableType > >
+                    ( new EquidistantLookupScheme< IndependentVariableType >
+                      ( independentValues_ ) );
+            break;
+
         default:
             throw std::runtime_error( "Warning: lookup scheme not found when making scheme for 1-D interpolator" );
         }
     }
 
+    //! Function to move the dependent variables into contiguous component-major storage.
+    /*!
+     * Function to move the dependent variables from the dependentValues_ vector into contiguous component-major
+     * storage (in componentMajorDependentValues_), after which the dependentValues_ vector is cleared. Derived classes
+     * that support component_major_storage call this function at the end of their construction.
+     */
+    void setComponentMajorDependentValues( )
+    {
+        componentMajorDependentValues_ = boost::make_shared< ComponentMajorNodeValues< DependentVariableType > >(
+                    dependentValues_ );
+        std::vector< DependentVariableType >( ).swap( dependentValues_ );
+    }
+
     //! Pointer to look up scheme.
     /*!
      * Pointer to the lookup scheme that is used to determine in which interval the requested
@@ -170,6 +222,13 @@ protected:
      */
     std::vector< DependentVariableType > dependentValues_;
 
+    //! Dependent variables in contiguous component-major storage.
+    /*!
+     * Dependent variables in contiguous component-major storage, only set (in which case dependentValues_ is empty)
+     * if the interpolator uses component_major_storage.
+     */
+    boost::shared_ptr< ComponentMajorNodeValues< DependentVariableType > > componentMajorDependentValues_;
+
     //! Vector with independent variables.
     /*!
      * Vector with independent variables.
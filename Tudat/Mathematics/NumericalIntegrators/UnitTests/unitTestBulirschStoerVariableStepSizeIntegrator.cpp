@@ -0,0 +1,247 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    Notes
+ *      The last test case is a comparison benchmark between the Bulirsch-Stoer and RKF7(8) integrators
+ *      for a high-accuracy propagation of an eccentric Kepler orbit. The number of state derivative
+ *      evaluations and run times are printed to the screen.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Basics/timeType.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace numerical_integrators;
+
+//! Function to compute the state derivative of an exponential decay/harmonic oscillator system.
+Eigen::VectorXd computeLinearTestStateDerivative( const double time, const Eigen::VectorXd& state )
+{
+    Eigen::VectorXd stateDerivative( 3 );
+    stateDerivative << -0.5 * state( 0 ), state( 2 ), -4.0 * state( 1 );
+    return stateDerivative;
+}
+
+//! Function to compute the state derivative of a Kepler orbit (in normalized units, gravitational parameter of 1).
+template< typename TimeType, typename StateScalarType >
+Eigen::Matrix< StateScalarType, 6, 1 > computeKeplerStateDerivative(
+        const TimeType time, const Eigen::Matrix< StateScalarType, 6, 1 >& state,
+        int& numberOfEvaluations )
+{
+    numberOfEvaluations++;
+    Eigen::Matrix< StateScalarType, 6, 1 > stateDerivative;
+    StateScalarType distance = state.segment( 0, 3 ).norm( );
+    stateDerivative.segment( 0, 3 ) = state.segment( 3, 3 );
+    stateDerivative.segment( 3, 3 ) = -state.segment( 0, 3 ) / ( distance * distance * distance );
+    return stateDerivative;
+}
+
+//! Function to get state at periapsis of an inclined Kepler orbit with given eccentricity, semi-major axis of 1.
+template< typename StateScalarType >
+Eigen::Matrix< StateScalarType, 6, 1 > getPeriapsisState( const StateScalarType eccentricity )
+{
+    StateScalarType periapsisVelocity = std::sqrt( ( 1.0L + eccentricity ) / ( 1.0L - eccentricity ) );
+    Eigen::Matrix< StateScalarType, 6, 1 > state;
+    state << 1.0L - eccentricity, 0.0L, 0.0L, 0.0L, periapsisVelocity * std::cos( 0.3L ),
+            periapsisVelocity * std::sin( 0.3L );
+    return state;
+}
+
+//! Function to integrate a number of orbital periods with a given integrator, to a fixed end time.
+template< typename TimeType, typename StateType, typename TimeStepType >
+StateType integrateToEndTime(
+        const boost::shared_ptr< NumericalIntegrator< TimeType, StateType, StateType, TimeStepType > > integrator,
+        const TimeType endTime, const TimeStepType initialStepSize )
+{
+    // Step sizes may be reduced inside performIntegrationStep, so loop until end time is actually reached.
+    TimeStepType stepSize = initialStepSize;
+    TimeStepType remainingTime = static_cast< TimeStepType >(
+                static_cast< long double >( endTime - integrator->getCurrentIndependentVariable( ) ) );
+    while( remainingTime > 0.0 )
+    {
+        integrator->performIntegrationStep( std::min( stepSize, remainingTime ) );
+        stepSize = integrator->getNextStepSize( );
+        remainingTime = static_cast< TimeStepType >(
+                    static_cast< long double >( endTime - integrator->getCurrentIndependentVariable( ) ) );
+    }
+    return integrator->getCurrentState( );
+}
+
+BOOST_AUTO_TEST_SUITE( test_bulirsch_stoer_variable_step_size_integrator )
+
+//! Test accuracy, backwards integration and rollback for linear system with analytical solution.
+BOOST_AUTO_TEST_CASE( testBulirschStoerLinearSystem )
+{
+    Eigen::VectorXd initialState( 3 );
+    initialState << 1.0, 0.5, -0.2;
+
+    for( int direction = -1; direction <= 1; direction += 2 )
+    {
+        BulirschStoerVariableStepSizeIntegratorXd integrator(
+                    &computeLinearTestStateDerivative, 0.0, initialState, direction * 0.1, 1.0E-8, 10.0,
+                    1.0E-12, 1.0E-12 );
+        BOOST_CHECK_EQUAL( integrator.getNextStepSize( ), direction * 0.1 );
+        double endTime = direction * 20.0;
+        Eigen::VectorXd finalState = integrator.integrateTo( endTime, direction * 0.1 );
+
+        Eigen::VectorXd expectedState( 3 );
+        expectedState << std::exp( -0.5 * endTime ),
+                0.5 * std::cos( 2.0 * endTime ) - 0.1 * std::sin( 2.0 * endTime ),
+                -1.0 * std::sin( 2.0 * endTime ) - 0.2 * std::cos( 2.0 * endTime );
+        for( int i = 0; i < 3; i++ )
+        {
+            BOOST_CHECK_SMALL( finalState( i ) - expectedState( i ),
+                               1.0E-9 * std::max( 1.0, std::fabs( expectedState( i ) ) ) );
+        }
+        BOOST_CHECK_EQUAL( integrator.getCurrentIndependentVariable( ), endTime );
+
+        // Test rollback.
+        double lastTime = integrator.getCurrentIndependentVariable( );
+        BOOST_CHECK( integrator.rollbackToPreviousState( ) );
+        BOOST_CHECK( direction * ( integrator.getCurrentIndependentVariable( ) - lastTime ) < 0.0 );
+        BOOST_CHECK( !integrator.rollbackToPreviousState( ) );
+    }
+
+    // Check exception for too large minimum step size.
+    BulirschStoerVariableStepSizeIntegratorXd integrator(
+                &computeLinearTestStateDerivative, 0.0, initialState, 5.0, 1.0, 10.0, 1.0E-14, 1.0E-14 );
+    bool isExceptionCaught = false;
+    try
+    {
+        integrator.performIntegrationStep( 5.0 );
+    }
+    catch( const std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK( isExceptionCaught );
+}
+
+//! Test Kepler orbit propagation with different independent variable and state scalar types, using settings interface.
+BOOST_AUTO_TEST_CASE( testBulirschStoerKeplerOrbitTypes )
+{
+    const double eccentricity = 0.6;
+    const double orbitalPeriod = 2.0 * mathematical_constants::PI;
+    int numberOfEvaluations = 0;
+
+    // Test double time/double state.
+    {
+        typedef Eigen::Matrix< double, 6, 1 > StateType;
+        StateType initialState = getPeriapsisState< double >( eccentricity );
+        boost::shared_ptr< NumericalIntegrator< double, StateType, StateType > > integrator =
+                createIntegrator< double, StateType >(
+                    boost::bind( &computeKeplerStateDerivative< double, double >, _1, _2,
+                                 boost::ref( numberOfEvaluations ) ), initialState,
+                    boost::make_shared< BulirschStoerIntegratorSettings< double > >(
+                        0.0, 0.01, 1.0E-10, 1.0, 1.0E-13, 1.0E-13 ) );
+        StateType finalState = integrateToEndTime( integrator, 5.0 * orbitalPeriod, 0.01 );
+        BOOST_CHECK_SMALL( ( finalState - initialState ).cwiseAbs( ).maxCoeff( ), 1.0E-9 );
+    }
+
+    // Test double time/long double state.
+    {
+        typedef Eigen::Matrix< long double, 6, 1 > StateType;
+        StateType initialState = getPeriapsisState< long double >( eccentricity );
+        boost::shared_ptr< NumericalIntegrator< double, StateType, StateType > > integrator =
+                createIntegrator< double, StateType >(
+                    boost::bind( &computeKeplerStateDerivative< double, long double >, _1, _2,
+                                 boost::ref( numberOfEvaluations ) ), initialState,
+                    boost::make_shared< BulirschStoerIntegratorSettings< double > >(
+                        0.0, 0.01, 1.0E-10, 1.0, 1.0E-13, 1.0E-13 ) );
+        StateType finalState = integrateToEndTime( integrator, 5.0 * orbitalPeriod, 0.01 );
+        BOOST_CHECK_SMALL( static_cast< double >( ( finalState - initialState ).cwiseAbs( ).maxCoeff( ) ), 1.0E-9 );
+    }
+
+    // Test Time time/long double state, with long double time step.
+    {
+        typedef Eigen::Matrix< long double, 6, 1 > StateType;
+        StateType initialState = getPeriapsisState< long double >( eccentricity );
+        boost::shared_ptr< NumericalIntegrator< Time, StateType, StateType, long double > > integrator =
+                createIntegrator< Time, StateType, long double >(
+                    boost::bind( &computeKeplerStateDerivative< Time, long double >, _1, _2,
+                                 boost::ref( numberOfEvaluations ) ), initialState,
+                    boost::make_shared< BulirschStoerIntegratorSettings< Time > >(
+                        Time( 0.0L ), Time( 0.01L ), Time( 1.0E-10L ), Time( 1.0L ), Time( 1.0E-13L ),
+                        Time( 1.0E-13L ) ) );
+        StateType finalState = integrateToEndTime(
+                    integrator, Time( 5.0L * 2.0L * mathematical_constants::LONG_PI ), 0.01L );
+        BOOST_CHECK_SMALL( static_cast< double >( ( finalState - initialState ).cwiseAbs( ).maxCoeff( ) ), 1.0E-9 );
+    }
+}
+
+//! Comparison with RKF7(8) integrator, for 1.0E-13 tolerance propagation of eccentric Kepler orbit.
+BOOST_AUTO_TEST_CASE( testBulirschStoerComparisonWithRungeKuttaFehlberg78 )
+{
+    typedef Eigen::Matrix< double, 6, 1 > StateType;
+    const double tolerance = 1.0E-13;
+    const double orbitalPeriod = 2.0 * mathematical_constants::PI;
+    const double endTime = 20.0 * orbitalPeriod;
+
+    for( double eccentricity = 0.1; eccentricity < 0.8; eccentricity += 0.3 )
+    {
+        StateType initialState = getPeriapsisState< double >( eccentricity );
+
+        // Propagate with Bulirsch-Stoer integrator.
+        int bulirschStoerEvaluations = 0;
+        boost::shared_ptr< NumericalIntegrator< double, StateType, StateType > > bulirschStoerIntegrator =
+                createIntegrator< double, StateType >(
+                    boost::bind( &computeKeplerStateDerivative< double, double >, _1, _2,
+                                 boost::ref( bulirschStoerEvaluations ) ), initialState,
+                    boost::make_shared< BulirschStoerIntegratorSettings< double > >(
+                        0.0, 0.01, 1.0E-10, 10.0, tolerance, tolerance ) );
+        StateType bulirschStoerState = integrateToEndTime( bulirschStoerIntegrator, endTime, 0.01 );
+
+        // Propagate with RKF7(8) integrator, with same and more stringent tolerance.
+        std::vector< int > rungeKuttaEvaluations;
+        std::vector< double > rungeKuttaErrors;
+        for( double rungeKuttaTolerance = tolerance; rungeKuttaTolerance > 1.0E-15; rungeKuttaTolerance /= 10.0 )
+        {
+            int numberOfEvaluations = 0;
+            boost::shared_ptr< NumericalIntegrator< double, StateType, StateType > > rungeKuttaIntegrator =
+                    createIntegrator< double, StateType >(
+                        boost::bind( &computeKeplerStateDerivative< double, double >, _1, _2,
+                                     boost::ref( numberOfEvaluations ) ), initialState,
+                        boost::make_shared< RungeKuttaVariableStepSizeSettings< double > >(
+                            rungeKuttaVariableStepSize, 0.0, 0.01, RungeKuttaCoefficients::rungeKuttaFehlberg78,
+                            1.0E-10, 10.0, rungeKuttaTolerance, rungeKuttaTolerance ) );
+            StateType rungeKuttaState = integrateToEndTime( rungeKuttaIntegrator, endTime, 0.01 );
+
+            rungeKuttaEvaluations.push_back( numberOfEvaluations );
+            rungeKuttaErrors.push_back( ( rungeKuttaState - initialState ).cwiseAbs( ).maxCoeff( ) );
+        }
+
+        // Check that Bulirsch-Stoer is more accurate than RKF7(8) for the same tolerance, and requires fewer
+        // evaluations than RKF7(8) with a tolerance at which the accuracy is comparable.
+        double bulirschStoerError = ( bulirschStoerState - initialState ).cwiseAbs( ).maxCoeff( );
+        BOOST_CHECK_SMALL( bulirschStoerError, 1.0E-8 );
+        BOOST_CHECK( bulirschStoerError < rungeKuttaErrors.at( 0 ) );
+        BOOST_CHECK( bulirschStoerEvaluations < rungeKuttaEvaluations.at( 1 ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+
+} // namespace tudat
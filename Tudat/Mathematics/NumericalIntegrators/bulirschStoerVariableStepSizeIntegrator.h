@@ -0,0 +1,655 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Hairer, E., Norsett, S.P., Wanner, G. Solving Ordinary Differential Equations I, 2nd Edition,
+ *          Springer, 1993.
+ *      Deuflhard, P. Order and stepsize control in extrapolation methods, Numerische Mathematik 41,
+ *          pp. 399-422, 1983.
+ *      Montenbruck, O., Gill, E. Satellite Orbits: Models, Methods, Applications, Springer, 2005.
+ *
+ */
+
+#ifndef TUDAT_BULIRSCH_STOER_VARIABLE_STEP_SIZE_INTEGRATOR_H
+#define TUDAT_BULIRSCH_STOER_VARIABLE_STEP_SIZE_INTEGRATOR_H
+
+#include <boost/exception/all.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "Tudat/Mathematics/NumericalIntegrators/reinitializableNumericalIntegrator.h"
+
+namespace tudat
+{
+namespace numerical_integrators
+{
+
+//! Class that implements the Gragg-Bulirsch-Stoer variable step size, variable order integrator.
+/*!
+ * Class that implements the Gragg-Bulirsch-Stoer (GBS) extrapolation integrator, with adaptive
+ * order and step size control (Hairer et al., 1993; Deuflhard, 1983). Each step is subdivided
+ * using the step number sequence n_k = 2 ( k + 1 ), the modified midpoint rule (with Gragg's
+ * smoothing step) is applied to each subdivision, and the results are extrapolated to zero step
+ * size using Aitken-Neville polynomial extrapolation in h^2. The error of the extrapolated state
+ * in column k is estimated from the difference between the two highest order values in the
+ * extrapolation table, and is used to both accept/reject the step, and to select the order
+ * (number of extrapolation columns) that minimizes the work per unit step for the next step.
+ * The state derivative at the start of a step is reused for all subdivisions, as well as when a
+ * step is rejected.
+ * \tparam IndependentVariableType The type of the independent variable (double, or Time).
+ * \tparam StateType The type of the state. This type should be an Eigen::Matrix derived type.
+ * \tparam StateDerivativeType The type of the state derivative. This type should be an
+ *          Eigen::Matrix derived type.
+ * \tparam TimeStepType The type of the time step (double, or long double if Time is used).
+ * \sa NumericalIntegrator.
+ */
+template < typename IndependentVariableType = double, typename StateType = Eigen::VectorXd,
+           typename StateDerivativeType = StateType, typename TimeStepType = IndependentVariableType >
+class BulirschStoerVariableStepSizeIntegrator :
+        public ReinitializableNumericalIntegrator<
+        IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+{
+public:
+
+    //! Typedef of the base class.
+    /*!
+     * Typedef of the base class with all template parameters filled in.
+     */
+    typedef numerical_integrators::ReinitializableNumericalIntegrator<
+    IndependentVariableType, StateType,
+    StateDerivativeType, TimeStepType > ReinitializableNumericalIntegratorBase;
+
+    //! Typedef to the state derivative function.
+    /*!
+     * Typedef to the state derivative function inherited from the base class.
+     * \sa NumericalIntegrator::StateDerivativeFunction.
+     */
+    typedef typename ReinitializableNumericalIntegratorBase::NumericalIntegratorBase::
+    StateDerivativeFunction StateDerivativeFunction;
+
+    //! Typedef of the scalar type of the state.
+    typedef typename StateType::Scalar StateScalarType;
+
+    //! Exception that is thrown if the minimum step size is exceeded.
+    /*!
+     * Exception thrown by BulirschStoerVariableStepSizeIntegrator<>::performIntegrationStep() if
+     * the minimum step size is exceeded.
+     */
+    class MinimumStepSizeExceededError;
+
+    //! Default constructor.
+    /*!
+     * Default constructor, taking a state derivative function, initial conditions, minimum &
+     * maximum step size, relative & absolute error tolerance per item in the state vector and
+     * order control settings as argument.
+     * \param stateDerivativeFunction State derivative function.
+     * \param intervalStart The start of the integration interval.
+     * \param initialState The initial state.
+     * \param initialStepSize The initial step size, returned by getNextStepSize( ) before the first step is taken.
+     * \param minimumStepSize The minimum step size to take. If this constraint is violated, an
+     *          exception will be thrown.
+     * \param maximumStepSize The maximum step size to take.
+     * \param relativeErrorTolerance The relative error tolerance, for each individual state
+     *          vector element.
+     * \param absoluteErrorTolerance The absolute error tolerance, for each individual state
+     *          vector element.
+     * \param maximumNumberOfColumns Maximum number of columns in the extrapolation table (must be
+     *          at least 2). The maximum order of the method is 2 * maximumNumberOfColumns.
+     * \param safetyFactorForNextStepSize Safety factor used to scale prediction of next step size.
+     * \param maximumFactorIncreaseForNextStepSize Maximum factor increase for next step size.
+     * \param minimumFactorDecreaseForNextStepSize Maximum factor decrease for next step size.
+     * \sa NumericalIntegrator::NumericalIntegrator.
+     */
+    BulirschStoerVariableStepSizeIntegrator(
+            const StateDerivativeFunction& stateDerivativeFunction,
+            const IndependentVariableType intervalStart,
+            const StateType& initialState,
+            const TimeStepType initialStepSize,
+            const TimeStepType minimumStepSize,
+            const TimeStepType maximumStepSize,
+            const StateType& relativeErrorTolerance,
+            const StateType& absoluteErrorTolerance,
+            const unsigned int maximumNumberOfColumns = 8,
+            const TimeStepType safetyFactorForNextStepSize = 0.8,
+            const TimeStepType maximumFactorIncreaseForNextStepSize = 4.0,
+            const TimeStepType minimumFactorDecreaseForNextStepSize = 0.1 ):
+        ReinitializableNumericalIntegratorBase( stateDerivativeFunction ),
+        stepSize_( initialStepSize ),
+        currentIndependentVariable_( intervalStart ),
+        currentState_( initialState ),
+        lastIndependentVariable_( intervalStart ),
+        minimumStepSize_( std::fabs( static_cast< double >( minimumStepSize ) ) ),
+        maximumStepSize_( std::fabs( static_cast< double >( maximumStepSize ) ) ),
+        relativeErrorTolerance_( relativeErrorTolerance.array( ).abs( ) ),
+        absoluteErrorTolerance_( absoluteErrorTolerance.array( ).abs( ) ),
+        safetyFactorForNextStepSize_( std::fabs( static_cast< double >( safetyFactorForNextStepSize ) ) ),
+        maximumFactorIncreaseForNextStepSize_( std::fabs( static_cast< double >( maximumFactorIncreaseForNextStepSize ) ) ),
+        minimumFactorDecreaseForNextStepSize_( std::fabs( static_cast< double >( minimumFactorDecreaseForNextStepSize ) ) )
+    {
+        initializeExtrapolationSettings( maximumNumberOfColumns );
+    }
+
+    //! Default constructor.
+    /*!
+     * Default constructor, taking a state derivative function, initial conditions, minimum &
+     * maximum step size, relative & absolute error tolerance for all items in the state vector
+     * and order control settings as argument.
+     * \param stateDerivativeFunction State derivative function.
+     * \param intervalStart The start of the integration interval.
+     * \param initialState The initial state.
+     * \param initialStepSize The initial step size, returned by getNextStepSize( ) before the first step is taken.
+     * \param minimumStepSize The minimum step size to take. If this constraint is violated, an
+     *          exception will be thrown.
+     * \param maximumStepSize The maximum step size to take.
+     * \param relativeErrorTolerance The relative error tolerance, equal for all individual state
+     *          vector elements.
+     * \param absoluteErrorTolerance The absolute error tolerance, equal for all individual state
+     *          vector elements.
+     * \param maximumNumberOfColumns Maximum number of columns in the extrapolation table (must be
+     *          at least 2). The maximum order of the method is 2 * maximumNumberOfColumns.
+     * \param safetyFactorForNextStepSize Safety factor used to scale prediction of next step size.
+     * \param maximumFactorIncreaseForNextStepSize Maximum factor increase for next step size.
+     * \param minimumFactorDecreaseForNextStepSize Maximum factor decrease for next step size.
+     * \sa NumericalIntegrator::NumericalIntegrator.
+     */
+    BulirschStoerVariableStepSizeIntegrator(
+            const StateDerivativeFunction& stateDerivativeFunction,
+            const IndependentVariableType intervalStart,
+            const StateType& initialState,
+            const TimeStepType initialStepSize,
+            const TimeStepType minimumStepSize,
+            const TimeStepType maximumStepSize,
+            const StateScalarType relativeErrorTolerance,
+            const StateScalarType absoluteErrorTolerance,
+            const unsigned int maximumNumberOfColumns = 8,
+            const TimeStepType safetyFactorForNextStepSize = 0.8,
+            const TimeStepType maximumFactorIncreaseForNextStepSize = 4.0,
+            const TimeStepType minimumFactorDecreaseForNextStepSize = 0.1 ):
+        ReinitializableNumericalIntegratorBase( stateDerivativeFunction ),
+        stepSize_( initialStepSize ),
+        currentIndependentVariable_( intervalStart ),
+        currentState_( initialState ),
+        lastIndependentVariable_( intervalStart ),
+        minimumStepSize_( std::fabs( static_cast< double >( minimumStepSize ) ) ),
+        maximumStepSize_( std::fabs( static_cast< double >( maximumStepSize ) ) ),
+        relativeErrorTolerance_( StateType::Constant( initialState.rows( ), initialState.cols( ),
+                                                      std::fabs( relativeErrorTolerance ) ) ),
+        absoluteErrorTolerance_( StateType::Constant( initialState.rows( ), initialState.cols( ),
+                                                      std::fabs( absoluteErrorTolerance ) ) ),
+        safetyFactorForNextStepSize_( std::fabs( static_cast< double >( safetyFactorForNextStepSize ) ) ),
+        maximumFactorIncreaseForNextStepSize_( std::fabs( static_cast< double >( maximumFactorIncreaseForNextStepSize ) ) ),
+        minimumFactorDecreaseForNextStepSize_( std::fabs( static_cast< double >( minimumFactorDecreaseForNextStepSize ) ) )
+    {
+        initializeExtrapolationSettings( maximumNumberOfColumns );
+    }
+
+    //! Get step size of the next step.
+    /*!
+     * Returns the step size of the next step.
+     * \return Step size to be used for the next step.
+     */
+    virtual TimeStepType getNextStepSize( ) const { return this->stepSize_; }
+
+    //! Get current state.
+    /*!
+     * Returns the current state of the integrator.
+     * \return Current integrated state.
+     */
+    virtual StateType getCurrentState( ) const { return this->currentState_; }
+
+    //! Get current independent variable.
+    /*!
+     * Returns the current value of the independent variable of the integrator.
+     * \return Current independent variable.
+     */
+    virtual IndependentVariableType getCurrentIndependentVariable( ) const
+    {
+        return this->currentIndependentVariable_;
+    }
+
+    //! Get index of extrapolation column that is targeted in the next step.
+    /*!
+     * Returns the index of extrapolation column that is targeted in the next step. The order of
+     * the extrapolated solution in column k is 2 ( k + 1 ).
+     * \return Index of extrapolation column that is targeted in the next step.
+     */
+    unsigned int getTargetColumn( ) const { return targetColumn_; }
+
+    //! Get number of rejected steps.
+    /*!
+     * Returns the number of integration steps that have been rejected since the creation of this object.
+     * \return Number of rejected steps.
+     */
+    unsigned int getNumberOfRejectedSteps( ) const { return numberOfRejectedSteps_; }
+
+    //! Perform a single integration step.
+    /*!
+     * Perform a single integration step and compute a new step size and order.
+     * \param stepSize The step size to take. If the time step is too large to satisfy the error
+     *          constraints, the step is redone with a smaller step size until the error constraint
+     *          is satisfied.
+     * \return The state at the end of the interval.
+     */
+    virtual StateType performIntegrationStep( const TimeStepType stepSize );
+
+    //! Rollback internal state to the last state.
+    /*!
+     * Performs rollback of the internal state to the last state. This function can only be called
+     * once after calling integrateTo( ) or performIntegrationStep( ) unless specified otherwise by
+     * implementations, and can not be called before any of these functions have been called. Will
+     * return true if the rollback was successful, and false otherwise.
+     * \return True if the rollback was successful.
+     */
+    virtual bool rollbackToPreviousState( )
+    {
+        if ( this->currentIndependentVariable_ == this->lastIndependentVariable_ )
+        {
+            return false;
+        }
+
+        this->currentIndependentVariable_ = this->lastIndependentVariable_;
+        this->currentState_ = this->lastState_;
+        return true;
+    }
+
+    //! Modify the state at the current interval.
+    /*!
+     * Modify the state at the current interval. This allows for discrete jumps in the state, often
+     * used in simulations of discrete events. The modified state cannot be rolled back.
+     * \param newState The state to set the current state to.
+     */
+    void modifyCurrentState( const StateType& newState )
+    {
+        this->currentState_ = newState;
+        this->lastIndependentVariable_ = currentIndependentVariable_;
+    }
+
+protected:
+
+    //! Function to set the step number sequence and work coefficients, for given maximum number of columns.
+    /*!
+     * Function to set the step number sequence and work coefficients, for given maximum number of columns.
+     * \param maximumNumberOfColumns Maximum number of columns in the extrapolation table.
+     */
+    void initializeExtrapolationSettings( const unsigned int maximumNumberOfColumns )
+    {
+        if( maximumNumberOfColumns < 2 )
+        {
+            throw std::runtime_error(
+                        "Error in Bulirsch-Stoer integrator, at least 2 extrapolation columns are required." );
+        }
+
+        // Set step number sequence n_k = 2(k+1) and number of state derivative evaluations A_k required to
+        // compute extrapolation table up to row k (including the evaluation at the start of the step).
+        stepNumberSequence_.resize( maximumNumberOfColumns + 1 );
+        cumulativeWork_.resize( maximumNumberOfColumns + 1 );
+        for( unsigned int k = 0; k <= maximumNumberOfColumns; k++ )
+        {
+            stepNumberSequence_[ k ] = 2 * ( k + 1 );
+            cumulativeWork_[ k ] = static_cast< double >( stepNumberSequence_[ k ] ) +
+                    ( ( k == 0 ) ? 1.0 : cumulativeWork_[ k - 1 ] );
+        }
+
+        // Set initial target column from tolerance (Hairer et al., 1993).
+        double logarithmOfTolerance = -std::log10( static_cast< double >(
+                                                       relativeErrorTolerance_.maxCoeff( ) ) + 1.0E-40 );
+        targetColumn_ = std::max( 1, std::min( static_cast< int >( maximumNumberOfColumns ) - 1,
+                                               static_cast< int >( logarithmOfTolerance * 0.6 + 0.5 ) ) );
+
+        extrapolationTable_.resize( maximumNumberOfColumns + 1 );
+        stepSizeEstimates_.resize( maximumNumberOfColumns + 1 );
+        workPerUnitStep_.resize( maximumNumberOfColumns + 1 );
+        numberOfRejectedSteps_ = 0;
+    }
+
+    //! Function to compute the modified midpoint (Gragg) estimate of the state at the end of a step.
+    /*!
+     * Function to compute the modified midpoint estimate of the state at the end of a step, including
+     * Gragg's smoothing step, using the state derivative at the start of the step that is provided as input.
+     * \param stepSize Total step size over which the state is to be propagated.
+     * \param numberOfSubSteps Number of (even) sub-steps into which the step is divided.
+     * \param initialStateDerivative State derivative at start of step.
+     * \param finalState Estimate of the state at the end of the step (returned by reference).
+     */
+    void computeModifiedMidpointEstimate( const TimeStepType stepSize,
+                                          const unsigned int numberOfSubSteps,
+                                          const StateDerivativeType& initialStateDerivative,
+                                          StateType& finalState )
+    {
+        const TimeStepType subStepSize = stepSize / static_cast< TimeStepType >( numberOfSubSteps );
+        const StateScalarType scalarSubStepSize = static_cast< StateScalarType >( subStepSize );
+
+        previousMidpointState_ = this->currentState_;
+        currentMidpointState_ = this->currentState_ + scalarSubStepSize * initialStateDerivative;
+        for( unsigned int i = 1; i < numberOfSubSteps; i++ )
+        {
+            nextMidpointState_ = previousMidpointState_ + ( 2.0 * scalarSubStepSize ) *
+                    this->stateDerivativeFunction_(
+                        this->currentIndependentVariable_ + static_cast< TimeStepType >( i ) * subStepSize,
+                        currentMidpointState_ );
+            previousMidpointState_.swap( currentMidpointState_ );
+            currentMidpointState_.swap( nextMidpointState_ );
+        }
+
+        finalState = 0.5 * ( previousMidpointState_ + currentMidpointState_ + scalarSubStepSize *
+                             this->stateDerivativeFunction_(
+                                 this->currentIndependentVariable_ + stepSize, currentMidpointState_ ) );
+    }
+
+    //! Function to compute the scaled error between two estimates of the state.
+    /*!
+     * Function to compute the scaled error between two estimates of the state, as the maximum over all
+     * entries of the ratio between the difference and the error tolerance (same definition as in
+     * RungeKuttaVariableStepSizeIntegrator).
+     * \param difference Difference between two estimates of the state.
+     * \param stateEstimate Highest order estimate of the state.
+     * \return Scaled error (step accepted if less than or equal to 1).
+     */
+    double computeScaledError( const StateType& difference, const StateType& stateEstimate )
+    {
+        return static_cast< double >(
+                    ( difference.array( ).abs( ) /
+                      ( stateEstimate.array( ).abs( ) * relativeErrorTolerance_.array( ) +
+                        absoluteErrorTolerance_.array( ) ) ).maxCoeff( ) );
+    }
+
+    //! Function to compute the step size estimate from the error in a given column of the extrapolation table.
+    /*!
+     * Function to compute the step size estimate from the error in a given column of the extrapolation
+     * table, limited by the maximum increase/decrease factors.
+     * \param stepSize Step size that was used to obtain the error.
+     * \param scaledError Scaled error in column.
+     * \param column Index of column in extrapolation table.
+     * \return Estimate of optimal step size.
+     */
+    TimeStepType computeStepSizeEstimate( const TimeStepType stepSize, const double scaledError,
+                                          const unsigned int column )
+    {
+        double stepSizeFactor = ( scaledError > 0.0 ) ?
+                    safetyFactorForNextStepSize_ * std::pow( 1.0 / scaledError, 1.0 / static_cast< double >( 2 * column + 1 ) ) :
+                    maximumFactorIncreaseForNextStepSize_;
+        stepSizeFactor = std::max( static_cast< double >( minimumFactorDecreaseForNextStepSize_ ),
+                                   std::min( static_cast< double >( maximumFactorIncreaseForNextStepSize_ ),
+                                             stepSizeFactor ) );
+        return stepSize * static_cast< TimeStepType >( stepSizeFactor );
+    }
+
+    //! Function to limit the next step size to the minimum and maximum step size.
+    /*!
+     * Function to limit the next step size to the minimum and maximum step size, throws an exception if the
+     * the step size is smaller than the minimum.
+     * \param stepSize Proposed step size.
+     * \return Step size limited to maximum step size.
+     */
+    TimeStepType limitStepSize( const TimeStepType stepSize )
+    {
+        if ( std::fabs( stepSize ) < this->minimumStepSize_ )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            MinimumStepSizeExceededError( this->minimumStepSize_,
+                                                          std::fabs( stepSize ) ) ) );
+        }
+        else if ( std::fabs( stepSize ) > this->maximumStepSize_ )
+        {
+            return ( stepSize < 0.0 ) ? -this->maximumStepSize_ : this->maximumStepSize_;
+        }
+        return stepSize;
+    }
+
+    //! Last used step size.
+    /*!
+     * Step size to be used for the next step: the initial step size before the first step, and the step size
+     * predicted by the last call to performIntegrationStep( ) afterwards.
+     */
+    TimeStepType stepSize_;
+
+    //! Current independent variable.
+    /*!
+     * Current independent variable as computed by performIntegrationStep().
+     */
+    IndependentVariableType currentIndependentVariable_;
+
+    //! Current state.
+    /*!
+     * Current state as computed by performIntegrationStep( ).
+     */
+    StateType currentState_;
+
+    //! Last independent variable.
+    /*!
+     * Last independent variable value as computed by performIntegrationStep().
+     */
+    IndependentVariableType lastIndependentVariable_;
+
+    //! Last state.
+    /*!
+     * Last state as computed by performIntegrationStep( ).
+     */
+    StateType lastState_;
+
+    //! Minimum step size.
+    TimeStepType minimumStepSize_;
+
+    //! Maximum step size.
+    TimeStepType maximumStepSize_;
+
+    //! Relative error tolerance.
+    /*!
+     * Relative error tolerance per element in the state.
+     */
+    StateType relativeErrorTolerance_;
+
+    //! Absolute error tolerance.
+    /*!
+     * Absolute error tolerance per element in the state.
+     */
+    StateType absoluteErrorTolerance_;
+
+    //! Safety factor for next step size.
+    TimeStepType safetyFactorForNextStepSize_;
+
+    //! Maximum factor increase for next step size.
+    TimeStepType maximumFactorIncreaseForNextStepSize_;
+
+    //! Minimum factor decrease for next step size.
+    TimeStepType minimumFactorDecreaseForNextStepSize_;
+
+    //! Step number sequence n_k (number of modified midpoint sub-steps for row k of extrapolation table).
+    std::vector< unsigned int > stepNumberSequence_;
+
+    //! Number of state derivative evaluations required to compute the extrapolation table up to row k.
+    std::vector< double > cumulativeWork_;
+
+    //! Index of extrapolation column that is targeted in the next step.
+    unsigned int targetColumn_;
+
+    //! Number of integration steps that have been rejected.
+    unsigned int numberOfRejectedSteps_;
+
+    //! Last row of extrapolation table (pre-allocated, updated in-place).
+    std::vector< StateType > extrapolationTable_;
+
+    //! Step size estimates, per column of the extrapolation table, from the last step.
+    std::vector< TimeStepType > stepSizeEstimates_;
+
+    //! Work per unit step, per column of the extrapolation table, from the last step.
+    std::vector< double > workPerUnitStep_;
+
+    //! Pre-allocated states used in modified midpoint method.
+    StateType previousMidpointState_, currentMidpointState_, nextMidpointState_;
+
+    //! Pre-allocated difference between subsequent entries of the extrapolation table.
+    StateType extrapolationCorrection_;
+
+    //! Pre-allocated modified midpoint estimate of state at end of step.
+    StateType midpointEstimate_;
+};
+
+//! Perform a single integration step.
+template < typename IndependentVariableType, typename StateType, typename StateDerivativeType, typename TimeStepType >
+StateType
+BulirschStoerVariableStepSizeIntegrator< IndependentVariableType, StateType, StateDerivativeType, TimeStepType >
+::performIntegrationStep( const TimeStepType stepSize )
+{
+    const unsigned int maximumColumn = stepNumberSequence_.size( ) - 1;
+
+    // Compute state derivative at start of step, which is reused for all rows, and rejected steps.
+    const StateDerivativeType initialStateDerivative =
+            this->stateDerivativeFunction_( this->currentIndependentVariable_, this->currentState_ );
+
+    TimeStepType currentStepSize = stepSize;
+    while( true )
+    {
+        // Compute rows of extrapolation table up to one beyond target column, accept as soon as error in column
+        // adjacent to target column is within tolerance.
+        int acceptedColumn = -1;
+        unsigned int lastColumn = std::min( targetColumn_ + 1, maximumColumn );
+        for( unsigned int k = 0; k <= lastColumn; k++ )
+        {
+            computeModifiedMidpointEstimate( currentStepSize, stepNumberSequence_[ k ], initialStateDerivative,
+                                             midpointEstimate_ );
+
+            // Perform Aitken-Neville extrapolation in h^2, updating last row of table in-place.
+            for( unsigned int j = 1; j <= k; j++ )
+            {
+                const double stepNumberRatio = static_cast< double >( stepNumberSequence_[ k ] ) /
+                        static_cast< double >( stepNumberSequence_[ k - j ] );
+                extrapolationCorrection_ = ( midpointEstimate_ - extrapolationTable_[ j - 1 ] ) /
+                        static_cast< StateScalarType >( stepNumberRatio * stepNumberRatio - 1.0 );
+                extrapolationTable_[ j - 1 ] = midpointEstimate_;
+                midpointEstimate_ += extrapolationCorrection_;
+            }
+            extrapolationTable_[ k ] = midpointEstimate_;
+
+            if( k > 0 )
+            {
+                // Estimate error and optimal step size in current column.
+                double scaledError = computeScaledError( extrapolationCorrection_, extrapolationTable_[ k ] );
+                stepSizeEstimates_[ k ] = computeStepSizeEstimate( currentStepSize, scaledError, k );
+                workPerUnitStep_[ k ] = cumulativeWork_[ k ] /
+                        std::fabs( static_cast< double >( stepSizeEstimates_[ k ] ) );
+
+                if( scaledError <= 1.0 && ( k + 1 >= targetColumn_ ) )
+                {
+                    acceptedColumn = static_cast< int >( k );
+                    break;
+                }
+            }
+        }
+
+        if( acceptedColumn > 0 )
+        {
+            // Accept the current step.
+            const unsigned int column = static_cast< unsigned int >( acceptedColumn );
+            this->lastIndependentVariable_ = this->currentIndependentVariable_;
+            this->lastState_ = this->currentState_;
+            this->currentIndependentVariable_ = this->currentIndependentVariable_ + currentStepSize;
+            this->currentState_ = extrapolationTable_[ column ];
+
+            // Select order for next step, based on work per unit step (Hairer et al., 1993).
+            unsigned int newTargetColumn = column;
+            if( column > 1 && workPerUnitStep_[ column - 1 ] < 0.8 * workPerUnitStep_[ column ] )
+            {
+                newTargetColumn = column - 1;
+            }
+            else if( column < maximumColumn && column >= targetColumn_ &&
+                     ( column == 1 || workPerUnitStep_[ column ] < 0.9 * workPerUnitStep_[ column - 1 ] ) )
+            {
+                newTargetColumn = column + 1;
+            }
+
+            // Compute next step size; for an increased order, scale step of current column by work ratio.
+            TimeStepType newStepSize;
+            if( newTargetColumn <= column )
+            {
+                newStepSize = stepSizeEstimates_[ newTargetColumn ];
+            }
+            else
+            {
+                newStepSize = stepSizeEstimates_[ column ] * static_cast< TimeStepType >(
+                            cumulativeWork_[ newTargetColumn ] / cumulativeWork_[ column ] );
+                if( std::fabs( static_cast< double >( newStepSize / currentStepSize ) ) >
+                        static_cast< double >( maximumFactorIncreaseForNextStepSize_ ) )
+                {
+                    newStepSize = currentStepSize * maximumFactorIncreaseForNextStepSize_;
+                }
+            }
+
+            targetColumn_ = newTargetColumn;
+            this->stepSize_ = limitStepSize( newStepSize );
+            return this->currentState_;
+        }
+        else
+        {
+            // Reject current step, and retry with reduced step size for (at most) the target order.
+            numberOfRejectedSteps_++;
+            targetColumn_ = std::max( 1u, std::min( targetColumn_, lastColumn ) );
+            if( targetColumn_ > 1 && workPerUnitStep_[ targetColumn_ - 1 ] < 0.8 * workPerUnitStep_[ targetColumn_ ] )
+            {
+                targetColumn_--;
+            }
+            currentStepSize = limitStepSize( std::min( stepSizeEstimates_[ targetColumn_ ] / currentStepSize,
+                                                       static_cast< TimeStepType >( 0.9 ) ) * currentStepSize );
+            this->stepSize_ = currentStepSize;
+        }
+    }
+}
+
+//! Exception that is thrown if the minimum step size is exceeded.
+/*!
+ * Exception thrown by BulirschStoerVariableStepSizeIntegrator<>::performIntegrationStep() if the minimum
+ * step size is exceeded.
+ */
+template < typename IndependentVariableType, typename StateType, typename StateDerivativeType, typename TimeStepType >
+class BulirschStoerVariableStepSizeIntegrator< IndependentVariableType, StateType,
+        StateDerivativeType, TimeStepType >
+        ::MinimumStepSizeExceededError : public std::runtime_error
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, initializes the parent runtime_error.
+     * \param minimumStepSize_ The minimum step size allowed by the integrator.
+     * \param requestedStepSize_ The new calculated step size.
+     */
+    MinimumStepSizeExceededError( TimeStepType minimumStepSize_,
+                                  TimeStepType requestedStepSize_ ) :
+        std::runtime_error( "Minimum step size exceeded." ),
+        minimumStepSize( minimumStepSize_ ), requestedStepSize( requestedStepSize_ )
+    { }
+
+    //! The minimum step size allowed by the integrator.
+    TimeStepType minimumStepSize;
+
+    //! The new calculated step size.
+    TimeStepType requestedStepSize;
+};
+
+//! Typedef of variable-step size Bulirsch-Stoer integrator (state/state derivative = VectorXd,
+//! independent variable = double).
+typedef BulirschStoerVariableStepSizeIntegrator< > BulirschStoerVariableStepSizeIntegratorXd;
+
+//! Typedef for shared-pointer to BulirschStoerVariableStepSizeIntegratorXd object.
+typedef boost::shared_ptr< BulirschStoerVariableStepSizeIntegratorXd >
+BulirschStoerVariableStepSizeIntegratorXdPointer;
+
+} // namespace numerical_integrators
+} // namespace tudat
+
+#endif // TUDAT_BULIRSCH_STOER_VARIABLE_STEP_SIZE_INTEGRATOR_H
@@ -21,6 +21,7 @@
 #include "Tudat/Mathematics/NumericalIntegrators/euler.h"
 
 #include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+#include "Tudat/Mathematics/NumericalIntegrators/bulirschStoerVariableStepSizeIntegrator.h"
 
 #include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
 
@@ -35,7 +36,8 @@ enum AvailableIntegrators
 {
     rungeKutta4,
     euler,
-    rungeKuttaVariableStepSize
+    rungeKuttaVariableStepSize,
+    bulirschStoer
 };
 
 //! Class to define settings of numerical integrator
@@ -71,6 +73,17 @@ public:
      */
     virtual ~IntegratorSettings( ) { }
 
+    //! Function to create a copy of the integrator settings.
+    /*!
+     *  Function to create a copy of the integrator settings (of the same derived type), for instance so that the
+     *  initial time can be modified without affecting the original settings.
+     *  \return Copy of the integrator settings.
+     */
+    virtual boost::shared_ptr< IntegratorSettings< TimeType > > clone( ) const
+    {
+        return boost::make_shared< IntegratorSettings< TimeType > >( *this );
+    }
+
     //! Type of numerical integrator
     /*!
      *  Type of numerical integrator, from enum of available integrators.
@@ -153,6 +166,16 @@ public:
      */
     ~RungeKuttaVariableStepSizeSettings( ){ }
 
+    //! Function to create a copy of the integrator settings.
+    /*!
+     *  Function to create a copy of the integrator settings.
+     *  \return Copy of the integrator settings.
+     */
+    boost::shared_ptr< IntegratorSettings< TimeType > > clone( ) const
+    {
+        return boost::make_shared< RungeKuttaVariableStepSizeSettings< TimeType > >( *this );
+    }
+
     //! Type of numerical integrator (must be an RK variable step type)
     numerical_integrators::RungeKuttaCoefficients::CoefficientSets coefficientSet_;
 
@@ -181,6 +204,97 @@ public:
     const TimeType minimumFactorDecreaseForNextStepSize_;
 };
 
+//! Class to define settings of variable step, variable order Bulirsch-Stoer numerical integrator
+/*!
+ *  Class to define settings of variable step, variable order Gragg-Bulirsch-Stoer numerical integrator, for instance for
+ *  use in numerical integration of equations of motion/variational equations.
+ */
+template< typename TimeType = double >
+class BulirschStoerIntegratorSettings: public IntegratorSettings< TimeType >
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor for variable step Bulirsch-Stoer integrator settings.
+     *  \param initialTime Start time (independent variable) of numerical integration.
+     *  \param initialTimeStep Initial time (independent variable) step used in numerical integration.
+     *  Adapted during integration
+     *  \param minimumStepSize Minimum step size for integration. Integration stops (exception thrown) if time step
+     *  comes below this value.
+     *  \param maximumStepSize Maximum step size for integration.
+     *  \param relativeErrorTolerance Relative error tolerance for step size control
+     *  \param absoluteErrorTolerance Absolute error tolerance for step size control
+     *  \param maximumNumberOfColumns Maximum number of columns in extrapolation table (maximum order is twice this value)
+     *  \param saveFrequency Frequency at which to save the numerical integrated states (in units of i.e. per n integration
+     *  time steps, with n = saveFrequency).
+     *  \param safetyFactorForNextStepSize Safety factor for step size control
+     *  \param maximumFactorIncreaseForNextStepSize Maximum increase factor in time step in subsequent iterations.
+     *  \param minimumFactorDecreaseForNextStepSize Maximum decrease factor in time step in subsequent iterations.
+     */
+    BulirschStoerIntegratorSettings(
+            const TimeType initialTime,
+            const TimeType initialTimeStep,
+            const TimeType minimumStepSize, const TimeType maximumStepSize,
+            const TimeType relativeErrorTolerance = 1.0E-12,
+            const TimeType absoluteErrorTolerance = 1.0E-12,
+            const unsigned int maximumNumberOfColumns = 8,
+            const int saveFrequency = 1,
+            const TimeType safetyFactorForNextStepSize = 0.8,
+            const TimeType maximumFactorIncreaseForNextStepSize = 4.0,
+            const TimeType minimumFactorDecreaseForNextStepSize = 0.1 ):
+        IntegratorSettings< TimeType >( bulirschStoer, initialTime, initialTimeStep, saveFrequency ),
+        minimumStepSize_( minimumStepSize ), maximumStepSize_( maximumStepSize ),
+        relativeErrorTolerance_( relativeErrorTolerance ), absoluteErrorTolerance_( absoluteErrorTolerance ),
+        maximumNumberOfColumns_( maximumNumberOfColumns ),
+        safetyFactorForNextStepSize_( safetyFactorForNextStepSize ),
+        maximumFactorIncreaseForNextStepSize_( maximumFactorIncreaseForNextStepSize ),
+        minimumFactorDecreaseForNextStepSize_( minimumFactorDecreaseForNextStepSize ){ }
+
+    //! Destructor
+    /*!
+     *  Destructor
+     */
+    ~BulirschStoerIntegratorSettings( ){ }
+
+    //! Function to create a copy of the integrator settings.
+    /*!
+     *  Function to create a copy of the integrator settings.
+     *  \return Copy of the integrator settings.
+     */
+    boost::shared_ptr< IntegratorSettings< TimeType > > clone( ) const
+    {
+        return boost::make_shared< BulirschStoerIntegratorSettings< TimeType > >( *this );
+    }
+
+    //! Minimum step size for integration.
+    /*!
+     *  Minimum step size for integration. Integration stops (exception thrown) if time step comes below this value.
+     */
+    const TimeType minimumStepSize_;
+
+    //! Maximum step size for integration.
+    const TimeType maximumStepSize_;
+
+    //! Relative error tolerance for step size control
+    const TimeType relativeErrorTolerance_;
+
+    //! Absolute error tolerance for step size control
+    const TimeType absoluteErrorTolerance_;
+
+    //! Maximum number of columns in extrapolation table.
+    const unsigned int maximumNumberOfColumns_;
+
+    //! Safety factor for step size control
+    const TimeType safetyFactorForNextStepSize_;
+
+    //! Maximum increase factor in time step in subsequent iterations.
+    const TimeType maximumFactorIncreaseForNextStepSize_;
+
+    //! Maximum decrease factor in time step in subsequent iterations.
+    const TimeType minimumFactorDecreaseForNextStepSize_;
+};
+
 //! Function to create a numerical integrator.
 /*!
  *  Function to create a numerical integrator from given integrator settings, state derivative function and initial state.
@@ -247,6 +361,34 @@ DependentVariableType, TimeStepType > > createIntegrator(
         }
         break;
     }
+    case bulirschStoer:
+    {
+        // Check input consistency
+        boost::shared_ptr< BulirschStoerIntegratorSettings< IndependentVariableType > > bulirschStoerIntegratorSettings =
+                boost::dynamic_pointer_cast< BulirschStoerIntegratorSettings< IndependentVariableType > >(
+                    integratorSettings );
+        if( bulirschStoerIntegratorSettings == NULL )
+        {
+            throw std::runtime_error( "Error, type of integrator settings (bulirschStoer) not compatible with selected integrator (derived class of IntegratorSettings must be BulirschStoerIntegratorSettings for this type)" );
+        }
+
+        integrator = boost::make_shared<
+                BulirschStoerVariableStepSizeIntegrator
+                < IndependentVariableType, DependentVariableType, DependentVariableType, TimeStepType > >
+                ( stateDerivativeFunction, integratorSettings->initialTime_, initialState,
+                  static_cast< TimeStepType >( integratorSettings->initialTimeStep_ ),
+                  static_cast< TimeStepType >( bulirschStoerIntegratorSettings->minimumStepSize_ ),
+                  static_cast< TimeStepType >( bulirschStoerIntegratorSettings->maximumStepSize_ ),
+                  static_cast< typename DependentVariableType::Scalar >(
+                      bulirschStoerIntegratorSettings->relativeErrorTolerance_ ),
+                  static_cast< typename DependentVariableType::Scalar >(
+                      bulirschStoerIntegratorSettings->absoluteErrorTolerance_ ),
+                  bulirschStoerIntegratorSettings->maximumNumberOfColumns_,
+                  static_cast< TimeStepType >( bulirschStoerIntegratorSettings->safetyFactorForNextStepSize_ ),
+                  static_cast< TimeStepType >( bulirschStoerIntegratorSettings->maximumFactorIncreaseForNextStepSize_ ),
+                  static_cast< TimeStepType >( bulirschStoerIntegratorSettings->minimumFactorDecreaseForNextStepSize_ ) );
+        break;
+    }
     default:
         std::runtime_error(
                     "Error, integrator " +  boost::lexical_cast< std::string >( integratorSettings->integratorType_ ) +
@@ -0,0 +1,84 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Mathematics/NumericalQuadrature/gaussianQuadrature.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+// Polynomial of degree 19, the highest degree that the 10-point rule integrates exactly.
+double evaluatePolynomial( const double x )
+{
+    return 3.0 * std::pow( x, 19 ) - 2.0 * std::pow( x, 12 ) + x * x - 5.0;
+}
+
+BOOST_AUTO_TEST_SUITE( test_gaussian_quadrature )
+
+//! Test if polynomials up to degree 19 are integrated exactly by a single segment.
+BOOST_AUTO_TEST_CASE( testGaussLegendrePolynomial )
+{
+    const double lowerBound = -0.5;
+    const double upperBound = 1.2;
+
+    const double expectedIntegral =
+            3.0 / 20.0 * ( std::pow( upperBound, 20 ) - std::pow( lowerBound, 20 ) ) -
+            2.0 / 13.0 * ( std::pow( upperBound, 13 ) - std::pow( lowerBound, 13 ) ) +
+            1.0 / 3.0 * ( std::pow( upperBound, 3 ) - std::pow( lowerBound, 3 ) ) -
+            5.0 * ( upperBound - lowerBound );
+
+    BOOST_CHECK_CLOSE_FRACTION(
+                numerical_quadrature::performGaussLegendreQuadrature( &evaluatePolynomial, lowerBound, upperBound ),
+                expectedIntegral, 1.0E-14 );
+
+    // Check that composite rule gives same result, and that reversed bounds change the sign.
+    BOOST_CHECK_CLOSE_FRACTION(
+                numerical_quadrature::performGaussLegendreQuadrature( &evaluatePolynomial, lowerBound, upperBound, 7 ),
+                expectedIntegral, 1.0E-14 );
+    BOOST_CHECK_CLOSE_FRACTION(
+                numerical_quadrature::performGaussLegendreQuadrature( &evaluatePolynomial, upperBound, lowerBound ),
+                -expectedIntegral, 1.0E-14 );
+
+    // Check invalid input.
+    BOOST_CHECK_THROW(
+                numerical_quadrature::performGaussLegendreQuadrature( &evaluatePolynomial, lowerBound, upperBound, 0 ),
+                std::runtime_error );
+}
+
+//! Test if quadrature is computed correctly (sine function), and converges with number of segments.
+BOOST_AUTO_TEST_CASE( testGaussLegendreSineFunction )
+{
+    numerical_quadrature::GaussLegendreNumericalQuadrature singleSegmentIntegrator(
+                [ ]( const double x ){ return std::sin( x ); }, 0.0, mathematical_constants::PI );
+    BOOST_CHECK_CLOSE_FRACTION( singleSegmentIntegrator.getQuadrature( ), 2.0, 1.0E-14 );
+
+    // Integrate over several periods, and reset bounds.
+    numerical_quadrature::GaussLegendreNumericalQuadrature multiSegmentIntegrator(
+                [ ]( const double x ){ return std::sin( x ); }, 0.0, 9.0 * mathematical_constants::PI, 8 );
+    BOOST_CHECK_CLOSE_FRACTION( multiSegmentIntegrator.getQuadrature( ), 2.0, 1.0E-13 );
+
+    multiSegmentIntegrator.resetBounds( 0.0, 10.0 * mathematical_constants::PI );
+    BOOST_CHECK_SMALL( multiSegmentIntegrator.getQuadrature( ), 1.0E-13 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
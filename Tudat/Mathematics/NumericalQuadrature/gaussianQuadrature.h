@@ -0,0 +1,169 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ *
+ *    References
+ *      Abramowitz, M. and I.A. Stegun. Handbook of Mathematical Functions, Table 25.4, Dover, 1972.
+ */
+
+#ifndef TUDAT_GAUSSIAN_QUADRATURE_H
+#define TUDAT_GAUSSIAN_QUADRATURE_H
+
+#include <stdexcept>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Mathematics/NumericalQuadrature/numericalQuadrature.h"
+
+namespace tudat
+{
+
+namespace numerical_quadrature
+{
+
+//! Number of nodes of the Gauss-Legendre quadrature rule used in each segment of performGaussLegendreQuadrature.
+static const int NUMBER_OF_GAUSS_LEGENDRE_NODES = 10;
+
+//! Positive nodes of the 10-point Gauss-Legendre quadrature rule on the interval [-1, 1] (Abramowitz and Stegun, 1972).
+static const double GAUSS_LEGENDRE_NODES[ NUMBER_OF_GAUSS_LEGENDRE_NODES / 2 ] =
+{ 0.1488743389816312108848260, 0.4333953941292471907992659, 0.6794095682990244062343274,
+  0.8650633666889845107320967, 0.9739065285171717200779640 };
+
+//! Weights of the 10-point Gauss-Legendre quadrature rule, for the nodes in GAUSS_LEGENDRE_NODES.
+static const double GAUSS_LEGENDRE_WEIGHTS[ NUMBER_OF_GAUSS_LEGENDRE_NODES / 2 ] =
+{ 0.2955242247147528701738930, 0.2692667193099963550912269, 0.2190863625159820439955349,
+  0.1494513491505805931457763, 0.0666713443086881375935688 };
+
+//! Function to perform numerical quadrature of a function using the composite 10-point Gauss-Legendre rule.
+/*!
+ * Function to perform numerical quadrature of a function using the composite 10-point Gauss-Legendre rule, which is
+ * exact for polynomials up to degree 19 on each segment. The integration interval is divided into a number of segments
+ * of equal size. Since the integrand is evaluated at a fixed set of points, and no memory is allocated, this function
+ * is suitable for the repeated evaluation of integrals of smooth functions (e.g. in a root-finding loop).
+ * \param integrand Function (object) that is to be integrated, taking the independent variable as input.
+ * \param lowerBound Lower bound of the integration interval.
+ * \param upperBound Upper bound of the integration interval.
+ * \param numberOfSegments Number of segments of equal size into which the integration interval is divided.
+ * \return Numerical quadrature (integral) of the function over the integration interval.
+ */
+template< typename IntegrandType >
+double performGaussLegendreQuadrature(
+        const IntegrandType& integrand, const double lowerBound, const double upperBound,
+        const int numberOfSegments = 1 )
+{
+    if( numberOfSegments < 1 )
+    {
+        throw std::runtime_error( "Error in Gauss-Legendre quadrature, number of segments must be positive" );
+    }
+
+    const double segmentHalfSize = 0.5 * ( upperBound - lowerBound ) / static_cast< double >( numberOfSegments );
+
+    double integral = 0.0;
+    for( int i = 0; i < numberOfSegments; i++ )
+    {
+        const double segmentCenter =
+                lowerBound + segmentHalfSize * ( 2.0 * static_cast< double >( i ) + 1.0 );
+        double segmentIntegral = 0.0;
+        for( int j = 0; j < NUMBER_OF_GAUSS_LEGENDRE_NODES / 2; j++ )
+        {
+            const double nodeOffset = segmentHalfSize * GAUSS_LEGENDRE_NODES[ j ];
+            segmentIntegral += GAUSS_LEGENDRE_WEIGHTS[ j ] *
+                    ( integrand( segmentCenter - nodeOffset ) + integrand( segmentCenter + nodeOffset ) );
+        }
+        integral += segmentHalfSize * segmentIntegral;
+    }
+    return integral;
+}
+
+//! Gauss-Legendre numerical quadrature wrapper class.
+/*!
+ *  Numerical method that uses the composite 10-point Gauss-Legendre rule to compute definite integrals of a function.
+ */
+class GaussLegendreNumericalQuadrature : public NumericalQuadrature< double, double >
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor
+     * \param integrand Function that is to be integrated.
+     * \param lowerBound Lower bound of the integration interval.
+     * \param upperBound Upper bound of the integration interval.
+     * \param numberOfSegments Number of segments of equal size into which the integration interval is divided.
+     */
+    GaussLegendreNumericalQuadrature( const boost::function< double( const double ) > integrand,
+                                      const double lowerBound, const double upperBound,
+                                      const int numberOfSegments = 1 ):
+        integrand_( integrand ), lowerBound_( lowerBound ), upperBound_( upperBound ),
+        numberOfSegments_( numberOfSegments )
+    {
+        performQuadrature( );
+    }
+
+    //! Function to reset the integration interval.
+    /*!
+     * Function to reset the integration interval, and recompute the quadrature.
+     * \param lowerBound Lower bound of the integration interval.
+     * \param upperBound Upper bound of the integration interval.
+     */
+    void resetBounds( const double lowerBound, const double upperBound )
+    {
+        lowerBound_ = lowerBound;
+        upperBound_ = upperBound;
+        performQuadrature( );
+    }
+
+    //! Function to return computed value of the quadrature.
+    /*!
+     *  Function to return computed value of the quadrature, as computed by last call to performQuadrature.
+     *  \return Function to return computed value of the quadrature, as computed by last call to performQuadrature.
+     */
+    double getQuadrature( )
+    {
+        return quadratureResult_;
+    }
+
+protected:
+
+    //! Function that is called to perform the numerical quadrature
+    /*!
+     * Function that is called to perform the numerical quadrature. Sets the result in the quadratureResult_ local
+     * variable.
+     */
+    void performQuadrature( )
+    {
+        quadratureResult_ = performGaussLegendreQuadrature( integrand_, lowerBound_, upperBound_, numberOfSegments_ );
+    }
+
+private:
+
+    //! Function that is to be integrated.
+    boost::function< double( const double ) > integrand_;
+
+    //! Lower bound of the integration interval.
+    double lowerBound_;
+
+    //! Upper bound of the integration interval.
+    double upperBound_;
+
+    //! Number of segments of equal size into which the integration interval is divided.
+    int numberOfSegments_;
+
+    //! Computed value of the quadrature, as computed by last call to performQuadrature.
+    double quadratureResult_;
+};
+
+//! Typedef for shared-pointer to GaussLegendreNumericalQuadrature object.
+typedef boost::shared_ptr< GaussLegendreNumericalQuadrature > GaussLegendreNumericalQuadraturePointer;
+
+} // namespace numerical_quadrature
+
+} // namespace tudat
+
+#endif // TUDAT_GAUSSIAN_QUADRATURE_H
@@ -8,6 +8,11 @@
  *    http://tudat.tudelft.nl/LICENSE.
  */
 
+#include <algorithm>
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/make_shared.hpp>
 
 #if USE_CSPICE
@@ -16,6 +21,7 @@
 
 #include "Tudat/Astrodynamics/Gravitation/timeDependentSphericalHarmonicsGravityField.h"
 #include "Tudat/Astrodynamics/Gravitation/triAxialEllipsoidGravity.h"
+#include "Tudat/InputOutput/memoryMappedFile.h"
 #include "Tudat/SimulationSetup/EnvironmentSetup/createGravityField.h"
 
 namespace tudat
@@ -24,12 +30,55 @@ namespace tudat
 namespace simulation_setup
 {
 
+namespace
+{
+
+//! Identifier at the start of a binary gravity field file.
+const char BINARY_GRAVITY_FIELD_FILE_IDENTIFIER[ 8 ] = { 'T', 'U', 'D', 'A', 'T', 'S', 'H', 'C' };
+
+//! Version of the binary gravity field file format.
+const boost::uint32_t BINARY_GRAVITY_FIELD_FILE_VERSION = 1;
+
+//! Normalization identifier of geodesy-normalized coefficients in a binary gravity field file.
+const boost::uint32_t BINARY_GRAVITY_FIELD_GEODESY_NORMALIZATION = 1;
+
+//! Header of a binary gravity field file (see writeBinaryGravityFieldFile).
+struct BinaryGravityFieldFileHeader
+{
+    char fileIdentifier[ 8 ];
+    boost::uint32_t formatVersion;
+    boost::uint32_t maximumDegree;
+    boost::uint32_t maximumOrder;
+    boost::uint32_t normalization;
+    double gravitationalParameter;
+    double referenceRadius;
+};
+
+//! Function to compute the number of cosine/sine coefficient pairs of all degrees up to a given degree, in the
+//! triangular layout of a binary gravity field file.
+std::size_t getNumberOfCoefficientPairs( const int maximumDegree, const int maximumOrder )
+{
+    std::size_t numberOfCoefficientPairs = 0;
+    for( int degree = 0; degree <= maximumDegree; degree++ )
+    {
+        numberOfCoefficientPairs += std::min( degree, maximumOrder ) + 1;
+    }
+    return numberOfCoefficientPairs;
+}
+
+} // namespace
+
 //! Function to read a gravity field file
 std::pair< double, double  > readGravityFieldFile(
         const std::string& fileName, const int maximumDegree, const int maximumOrder,
         std::pair< Eigen::MatrixXd, Eigen::MatrixXd >& coefficients,
         const int gravitationalParameterIndex, const int referenceRadiusIndex )
 {
+    if( isBinaryGravityFieldFile( fileName ) )
+    {
+        return readBinaryGravityFieldFile( fileName, maximumDegree, maximumOrder, coefficients );
+    }
+
     // Attempt to open gravity file.
     std::fstream stream( fileName.c_str( ), std::ios::in );
     if( stream.fail( ) )
@@ -91,8 +140,13 @@ std::pair< double, double  > readGravityFieldFile(
         // Read current line
         std::getline( stream, line );
 
-        // Trim input string (removes all leading and trailing whitespaces).
+        // Trim input string (removes all leading and trailing whitespaces), and skip empty lines (such as at the
+        // end of the file).
         boost::algorithm::trim( line );
+        if( line.empty( ) )
+        {
+            continue;
+        }
 
         // Split string into multiple strings, each containing one element from a line from the
         // data file.
@@ -132,6 +186,148 @@ std::pair< double, double  > readGravityFieldFile(
     return std::make_pair( gravitationalParameter, referenceRadius );
 }
 
+//! Function to determine whether a file is a binary gravity field file.
+bool isBinaryGravityFieldFile( const std::string& fileName )
+{
+    std::ifstream stream( fileName.c_str( ), std::ios::binary );
+    char fileIdentifier[ 8 ];
+    return ( stream.read( fileIdentifier, 8 ) &&
+             std::memcmp( fileIdentifier, BINARY_GRAVITY_FIELD_FILE_IDENTIFIER, 8 ) == 0 );
+}
+
+//! Function to write spherical harmonic coefficients to a binary gravity field file.
+void writeBinaryGravityFieldFile( const std::string& fileName,
+                                  const double gravitationalParameter,
+                                  const double referenceRadius,
+                                  const Eigen::MatrixXd& cosineCoefficients,
+                                  const Eigen::MatrixXd& sineCoefficients )
+{
+    if( cosineCoefficients.rows( ) != sineCoefficients.rows( ) ||
+            cosineCoefficients.cols( ) != sineCoefficients.cols( ) || cosineCoefficients.size( ) == 0 )
+    {
+        throw std::runtime_error( "Error when writing binary gravity field file, coefficient matrices are "
+                                  "empty or differ in size." );
+    }
+
+    BinaryGravityFieldFileHeader header;
+    std::memcpy( header.fileIdentifier, BINARY_GRAVITY_FIELD_FILE_IDENTIFIER, 8 );
+    header.formatVersion = BINARY_GRAVITY_FIELD_FILE_VERSION;
+    header.maximumDegree = static_cast< boost::uint32_t >( cosineCoefficients.rows( ) - 1 );
+    header.maximumOrder = static_cast< boost::uint32_t >( cosineCoefficients.cols( ) - 1 );
+    header.normalization = BINARY_GRAVITY_FIELD_GEODESY_NORMALIZATION;
+    header.gravitationalParameter = gravitationalParameter;
+    header.referenceRadius = referenceRadius;
+
+    // Put coefficients in triangular layout.
+    std::vector< double > coefficientData;
+    coefficientData.reserve( 2 * getNumberOfCoefficientPairs( header.maximumDegree, header.maximumOrder ) );
+    for( int degree = 0; degree <= static_cast< int >( header.maximumDegree ); degree++ )
+    {
+        for( int order = 0; order <= std::min( degree, static_cast< int >( header.maximumOrder ) ); order++ )
+        {
+            coefficientData.push_back( cosineCoefficients( degree, order ) );
+            coefficientData.push_back( sineCoefficients( degree, order ) );
+        }
+    }
+
+    std::ofstream stream( fileName.c_str( ), std::ios::binary | std::ios::trunc );
+    stream.write( reinterpret_cast< const char* >( &header ), sizeof( BinaryGravityFieldFileHeader ) );
+    stream.write( reinterpret_cast< const char* >( coefficientData.data( ) ),
+                  coefficientData.size( ) * sizeof( double ) );
+    if( !stream.good( ) )
+    {
+        throw std::runtime_error( "Error, binary gravity field file " + fileName + " could not be written." );
+    }
+}
+
+//! Function to convert a spherical harmonic gravity field text file to a binary gravity field file.
+void convertGravityFieldFileToBinary( const std::string& textFileName, const std::string& binaryFileName,
+                                      const int maximumDegree, const int maximumOrder,
+                                      const int gravitationalParameterIndex,
+                                      const int referenceRadiusIndex )
+{
+    std::pair< Eigen::MatrixXd, Eigen::MatrixXd > coefficients;
+    const std::pair< double, double > referenceData = readGravityFieldFile(
+                textFileName, maximumDegree, maximumOrder, coefficients,
+                gravitationalParameterIndex, referenceRadiusIndex );
+    writeBinaryGravityFieldFile( binaryFileName, referenceData.first, referenceData.second,
+                                 coefficients.first, coefficients.second );
+}
+
+//! Function to read a binary gravity field file.
+std::pair< double, double > readBinaryGravityFieldFile(
+        const std::string& fileName, const int maximumDegree, const int maximumOrder,
+        std::pair< Eigen::MatrixXd, Eigen::MatrixXd >& coefficients )
+{
+    // Read and check header.
+    std::ifstream stream( fileName.c_str( ), std::ios::binary );
+    if( !stream.good( ) )
+    {
+        throw std::runtime_error( "Error, binary gravity field file " + fileName + " could not be opened." );
+    }
+
+    BinaryGravityFieldFileHeader header;
+    if( !stream.read( reinterpret_cast< char* >( &header ), sizeof( BinaryGravityFieldFileHeader ) ) ||
+            std::memcmp( header.fileIdentifier, BINARY_GRAVITY_FIELD_FILE_IDENTIFIER, 8 ) != 0 )
+    {
+        throw std::runtime_error( "Error, " + fileName + " is not a binary gravity field file." );
+    }
+    stream.close( );
+
+    if( header.formatVersion != BINARY_GRAVITY_FIELD_FILE_VERSION )
+    {
+        throw std::runtime_error( "Error, binary gravity field file " + fileName + " has an unsupported format "
+                                  "version, or was written on a platform with a different byte order." );
+    }
+    if( header.normalization != BINARY_GRAVITY_FIELD_GEODESY_NORMALIZATION )
+    {
+        throw std::runtime_error( "Error, binary gravity field file " + fileName + " does not contain "
+                                  "geodesy-normalized coefficients." );
+    }
+
+    const int fileMaximumDegree = static_cast< int >( header.maximumDegree );
+    const int fileMaximumOrder = static_cast< int >( header.maximumOrder );
+    if( boost::filesystem::file_size( fileName ) != sizeof( BinaryGravityFieldFileHeader ) + 2 * sizeof( double ) *
+            getNumberOfCoefficientPairs( fileMaximumDegree, fileMaximumOrder ) )
+    {
+        throw std::runtime_error( "Error, size of binary gravity field file " + fileName +
+                                  " is inconsistent with its header." );
+    }
+
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumOrder + 1 );
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumOrder + 1 );
+
+    // Map only the part of the file with the coefficients up to the requested degree.
+    const int degreeToRead = std::min( maximumDegree, fileMaximumDegree );
+    const std::size_t mappedSize = sizeof( BinaryGravityFieldFileHeader ) + 2 * sizeof( double ) *
+            getNumberOfCoefficientPairs( degreeToRead, fileMaximumOrder );
+    const input_output::MemoryMappedFile mappedFile( fileName, mappedSize );
+    const char* coefficientData = mappedFile.data( ) + sizeof( BinaryGravityFieldFileHeader );
+
+    std::size_t coefficientPairIndex = 0;
+    for( int degree = 0; degree <= degreeToRead; degree++ )
+    {
+        const int numberOfOrdersInFile = std::min( degree, fileMaximumOrder ) + 1;
+        const int numberOfOrdersToRead = std::min( numberOfOrdersInFile, maximumOrder + 1 );
+        for( int order = 0; order < numberOfOrdersToRead; order++ )
+        {
+            std::memcpy( &cosineCoefficients( degree, order ),
+                         coefficientData + ( 2 * ( coefficientPairIndex + order ) ) * sizeof( double ),
+                         sizeof( double ) );
+            std::memcpy( &sineCoefficients( degree, order ),
+                         coefficientData + ( 2 * ( coefficientPairIndex + order ) + 1 ) * sizeof( double ),
+                         sizeof( double ) );
+        }
+        coefficientPairIndex += numberOfOrdersInFile;
+    }
+
+    // Set cosine coefficient at (0,0) to 1.
+    cosineCoefficients( 0, 0 ) = 1.0;
+    coefficients = std::make_pair( cosineCoefficients, sineCoefficients );
+
+    return std::make_pair( header.gravitationalParameter, header.referenceRadius );
+}
+
 //! Function to create a gravity field model.
 boost::shared_ptr< gravitation::GravityFieldModel > createGravityFieldModel(
         const boost::shared_ptr< GravityFieldSettings > gravityFieldSettings,
@@ -235,6 +235,9 @@ boost::shared_ptr< SphericalHarmonicsGravityFieldSettings > createHomogeneousTri
  *  Degree, Order, Cosine Coefficient, Sine Coefficients
  *  Subsequent columns may be present in the file, but are ignored when parsing.
  *  All coefficients not defined in the file are set to zero (except C(0,0) which is always 1.0)
+ *  If the file is a binary gravity field file (see writeBinaryGravityFieldFile), it is read by
+ *  readBinaryGravityFieldFile instead, and the gravitational parameter and reference radius are taken from its header
+ *  (gravitationalParameterIndex and referenceRadiusIndex are then ignored).
  *  \param fileName Name of PDS gravity field file to be loaded.
  *  \param maximumDegree Maximum degree of gravity field to be loaded.
  *  \param maximumOrder Maximum order of gravity field to be loaded.
@@ -249,6 +252,77 @@ std::pair< double, double > readGravityFieldFile(
         std::pair< Eigen::MatrixXd, Eigen::MatrixXd >& coefficients,
         const int gravitationalParameterIndex = -1, const int referenceRadiusIndex = -1 );
 
+//! Function to determine whether a file is a binary gravity field file.
+/*!
+ *  Function to determine whether a file is a binary gravity field file (as written by writeBinaryGravityFieldFile), by
+ *  checking the file identifier at its start.
+ *  \param fileName Name of the file.
+ *  \return True if the file is a binary gravity field file, false otherwise (including if the file does not exist).
+ */
+bool isBinaryGravityFieldFile( const std::string& fileName );
+
+//! Function to write spherical harmonic coefficients to a binary gravity field file.
+/*!
+ *  Function to write geodesy-normalized spherical harmonic coefficients to a binary gravity field file, which can be
+ *  loaded much faster than a text file (see readBinaryGravityFieldFile). The file consists of a header of 40 bytes
+ *  (file identifier "TUDATSHC", format version, maximum degree, maximum order, normalization (1: geodesy-normalized),
+ *  gravitational parameter and reference radius), followed by the coefficients in triangular layout: for each degree
+ *  from 0 to the maximum degree, the pairs of cosine and sine coefficients of all orders from 0 up to the minimum of the
+ *  degree and the maximum order. The coefficients of all degrees up to a given degree thus form a contiguous block at
+ *  the start of the coefficient data. All values are written in the byte order of the current platform.
+ *  \param fileName Name of the binary file that is to be written.
+ *  \param gravitationalParameter Gravitational parameter of the gravity field (may be NaN if not known).
+ *  \param referenceRadius Reference radius of the spherical harmonic expansion (may be NaN if not known).
+ *  \param cosineCoefficients Cosine spherical harmonic coefficients (geodesy normalized); the number of rows and
+ *  columns define the maximum degree and order of the file.
+ *  \param sineCoefficients Sine spherical harmonic coefficients (geodesy normalized), of same size as the cosine
+ *  coefficients.
+ *  \throws std::runtime_error If the coefficient matrices differ in size, or the file could not be written.
+ */
+void writeBinaryGravityFieldFile( const std::string& fileName,
+                                  const double gravitationalParameter,
+                                  const double referenceRadius,
+                                  const Eigen::MatrixXd& cosineCoefficients,
+                                  const Eigen::MatrixXd& sineCoefficients );
+
+//! Function to convert a spherical harmonic gravity field text file to a binary gravity field file.
+/*!
+ *  Function to convert a spherical harmonic gravity field text file (in the format read by readGravityFieldFile) to a
+ *  binary gravity field file (see writeBinaryGravityFieldFile).
+ *  \param textFileName Name of the text gravity field file that is to be converted.
+ *  \param binaryFileName Name of the binary gravity field file that is to be written.
+ *  \param maximumDegree Maximum degree of the coefficients that are converted.
+ *  \param maximumOrder Maximum order of the coefficients that are converted.
+ *  \param gravitationalParameterIndex Index of the gravitational parameter in the header of the text file (see
+ *  readGravityFieldFile); if negative, the gravitational parameter is stored as NaN.
+ *  \param referenceRadiusIndex Index of the reference radius in the header of the text file (see
+ *  readGravityFieldFile); if negative, the reference radius is stored as NaN.
+ */
+void convertGravityFieldFileToBinary( const std::string& textFileName, const std::string& binaryFileName,
+                                      const int maximumDegree, const int maximumOrder,
+                                      const int gravitationalParameterIndex = -1,
+                                      const int referenceRadiusIndex = -1 );
+
+//! Function to read a binary gravity field file.
+/*!
+ *  Function to read a binary gravity field file (see writeBinaryGravityFieldFile), returning (by reference) the cosine
+ *  and sine spherical harmonic coefficients up to a given degree and order. Only the part of the file that contains the
+ *  coefficients up to the requested degree is memory-mapped and read, so that loading a truncated field from a
+ *  high-degree file takes a time (and memory) proportional to the size of the truncated field only. Coefficients beyond
+ *  the maximum degree or order of the file are set to zero, and C(0,0) is always set to 1.0, as in
+ *  readGravityFieldFile.
+ *  \param fileName Name of the binary gravity field file.
+ *  \param maximumDegree Maximum degree of gravity field to be loaded.
+ *  \param maximumOrder Maximum order of gravity field to be loaded.
+ *  \param coefficients Spherical harmonics coefficients (first is cosine, second is sine).
+ *  \return Pair of gravitational parameter and reference radius, as stored in the file.
+ *  \throws std::runtime_error If the file could not be opened, is not a (complete) binary gravity field file, or was
+ *  written on a platform with a different byte order.
+ */
+std::pair< double, double > readBinaryGravityFieldFile(
+        const std::string& fileName, const int maximumDegree, const int maximumOrder,
+        std::pair< Eigen::MatrixXd, Eigen::MatrixXd >& coefficients );
+
 //! Function to create a gravity field model.
 /*!
  *  Function to create a gravity field model based on model-specific settings for the gravity field.
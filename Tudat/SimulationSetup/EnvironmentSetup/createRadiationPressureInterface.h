@@ -104,12 +104,15 @@ public:
      * \param area Surface area that undergoes radiation pressure.
      * \param radiationPressureCoefficient Radiation pressure coefficient.
      * \param occultingBodies List of bodies causing (partial) occultation.
+     * \param shadowFunctionType Model to use for the shadow function of the occulting bodies.
      */
     CannonBallRadiationPressureInterfaceSettings(
             const std::string& sourceBody, const double area, const double radiationPressureCoefficient,
-            const std::vector< std::string >& occultingBodies = std::vector< std::string >( ) ):
+            const std::vector< std::string >& occultingBodies = std::vector< std::string >( ),
+            const electro_magnetism::ShadowFunctionType shadowFunctionType = electro_magnetism::conical_shadow ):
         RadiationPressureInterfaceSettings( cannon_ball, sourceBody, occultingBodies ),
-        area_( area ), radiationPressureCoefficient_( radiationPressureCoefficient ){ }
+        area_( area ), radiationPressureCoefficient_( radiationPressureCoefficient ),
+        shadowFunctionType_( shadowFunctionType ){ }
 
     //! Function to return surface area that undergoes radiation pressure.
     /*!
@@ -125,6 +128,12 @@ public:
      */
     double getRadiationPressureCoefficient( ){ return radiationPressureCoefficient_; }
 
+    //! Function to return model to use for the shadow function of the occulting bodies.
+    /*!
+     *  Function to return model to use for the shadow function of the occulting bodies.
+     *  \return Model to use for the shadow function of the occulting bodies.
+     */
+    electro_magnetism::ShadowFunctionType getShadowFunctionType( ){ return shadowFunctionType_; }
 
 private:
 
@@ -133,6 +142,9 @@ private:
 
     //! Radiation pressure coefficient.
     double radiationPressureCoefficient_;
+
+    //! Model to use for the shadow function of the occulting bodies.
+    electro_magnetism::ShadowFunctionType shadowFunctionType_;
 };
 
 //! Function to obtain (by reference) the position functions and radii of occulting bodies
@@ -11,6 +11,7 @@
 #include <boost/make_shared.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include "Tudat/Astrodynamics/Ephemerides/gcrsToItrsRotationModel.h"
 #include "Tudat/Astrodynamics/Ephemerides/simpleRotationalEphemeris.h"
 #if USE_CSPICE
 #include "Tudat/External/SpiceInterface/spiceRotationalEphemeris.h"
@@ -23,6 +24,28 @@ namespace tudat
 namespace simulation_setup
 {
 
+//! Function to retrieve a CIP or CIO series, from file if a file name is given, truncated otherwise (if allowed).
+ephemerides::EarthOrientationSeries getEarthOrientationSeries(
+        const std::string& fileName, const ephemerides::EarthOrientationSeriesType seriesType,
+        const bool useTruncatedSeries, const std::string& body )
+{
+    if( fileName == "" )
+    {
+        if( !useTruncatedSeries )
+        {
+            throw std::runtime_error(
+                        "Error when creating GCRS to ITRS rotation model for " + body + ", no file given for series " +
+                        boost::lexical_cast< std::string >( seriesType ) +
+                        ", and use of truncated series not requested." );
+        }
+        return ephemerides::getTruncatedEarthOrientationSeries( seriesType );
+    }
+    else
+    {
+        return ephemerides::readEarthOrientationSeries( fileName, seriesType );
+    }
+}
+
 //! Function to create a rotation model.
 boost::shared_ptr< ephemerides::RotationalEphemeris > createRotationModel(
         const boost::shared_ptr< RotationModelSettings > rotationModelSettings,
@@ -58,6 +81,46 @@ boost::shared_ptr< ephemerides::RotationalEphemeris > createRotationModel(
         }
         break;
     }
+    case gcrs_to_itrs_rotation_model:
+    {
+        // Check whether settings for GCRS to ITRS rotation model are consistent with its type.
+        boost::shared_ptr< GcrsToItrsRotationModelSettings > gcrsToItrsRotationSettings =
+                boost::dynamic_pointer_cast< GcrsToItrsRotationModelSettings >( rotationModelSettings );
+        if( gcrsToItrsRotationSettings == NULL )
+        {
+            throw std::runtime_error(
+                        "Error, expected GCRS to ITRS rotation model settings for " + body );
+        }
+        else
+        {
+            // Read Earth orientation parameters, if requested.
+            boost::shared_ptr< EarthOrientationParameters > earthOrientationParameters;
+            if( gcrsToItrsRotationSettings->getEarthOrientationParametersFile( ) != "" )
+            {
+                earthOrientationParameters = readEarthOrientationParameters(
+                            gcrsToItrsRotationSettings->getEarthOrientationParametersFile( ) );
+            }
+
+            // Create and initialize GCRS to ITRS rotation model.
+            rotationalEphemeris = boost::make_shared< GcrsToItrsRotationModel >(
+                        getEarthOrientationSeries( gcrsToItrsRotationSettings->getCipXSeriesFile( ),
+                                                   cip_x_coordinate,
+                                                   gcrsToItrsRotationSettings->getUseTruncatedSeries( ), body ),
+                        getEarthOrientationSeries( gcrsToItrsRotationSettings->getCipYSeriesFile( ),
+                                                   cip_y_coordinate,
+                                                   gcrsToItrsRotationSettings->getUseTruncatedSeries( ), body ),
+                        getEarthOrientationSeries( gcrsToItrsRotationSettings->getCioLocatorSeriesFile( ),
+                                                   cio_locator_plus_half_xy,
+                                                   gcrsToItrsRotationSettings->getUseTruncatedSeries( ), body ),
+                        earthOrientationParameters,
+                        gcrsToItrsRotationSettings->getGridStartTime( ),
+                        gcrsToItrsRotationSettings->getGridEndTime( ),
+                        gcrsToItrsRotationSettings->getGridTimeStep( ),
+                        gcrsToItrsRotationSettings->getOriginalFrame( ),
+                        gcrsToItrsRotationSettings->getTargetFrame( ) );
+        }
+        break;
+    }
     #if USE_CSPICE
     case spice_rotation_model:
     {
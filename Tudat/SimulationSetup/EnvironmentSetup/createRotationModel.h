@@ -18,6 +18,7 @@
 
 #include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
 #include "Tudat/Astrodynamics/Ephemerides/rotationalEphemeris.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
 
 
 namespace tudat
@@ -34,7 +35,8 @@ namespace simulation_setup
 enum RotationModelType
 {
     simple_rotation_model,
-    spice_rotation_model
+    spice_rotation_model,
+    gcrs_to_itrs_rotation_model
 };
 
 //! Class for providing settings for rotation model.
@@ -166,6 +168,140 @@ private:
     double rotationRate_;
 };
 
+//! RotationModelSettings derived class for defining settings of the IAU 2006/2000A Earth rotation model.
+/*!
+ *  RotationModelSettings derived class for defining settings of the GCRS to ITRS rotation model, using the
+ *  IAU 2006/2000A precession-nutation model, the Earth rotation angle and Earth orientation parameters (EOP) read
+ *  from local files. The full IAU 2006/2000A series (IERS Conventions tables 5.2a, 5.2b and 5.2d) must be provided as
+ *  files, unless use of a truncated version of the series, which is only accurate to about 0.1 arcseconds, is
+ *  explicitly requested. The series for X, Y and s can be precomputed on an equidistant grid and
+ *  interpolated.
+ */
+class GcrsToItrsRotationModelSettings: public RotationModelSettings
+{
+public:
+
+    //! Constructor,
+    /*!
+     *  Constructor, sets properties of the GCRS to ITRS rotation model.
+     *  \param earthOrientationParametersFile Name of file with Earth orientation parameters, in the IERS C04 format
+     *  (EOP are not used if empty).
+     *  \param cipXSeriesFile Name of file with series for X-coordinate of the CIP, in the format of IERS Conventions
+     *  table 5.2a.
+     *  \param cipYSeriesFile Name of file with series for Y-coordinate of the CIP, in the format of IERS Conventions
+     *  table 5.2b.
+     *  \param cioLocatorSeriesFile Name of file with series for s + XY/2, in the format of IERS Conventions
+     *  table 5.2d.
+     *  \param useTruncatedSeries Boolean denoting whether the truncated built-in series (errors of the order of
+     *  0.1 arcseconds, see getTruncatedEarthOrientationSeries) are to be used for each of the above series for which
+     *  no file name is given. If false, an exception is thrown when the model is created with any of these file names
+     *  empty.
+     *  \param gridStartTime Start time of grid for precomputation of CIP coordinates and CIO locator.
+     *  \param gridEndTime End time of grid for precomputation of CIP coordinates and CIO locator (no grid is used if
+     *  this time is not larger than gridStartTime).
+     *  \param gridTimeStep Time step of grid for precomputation of CIP coordinates and CIO locator.
+     *  \param originalFrame Base frame of rotation model.
+     *  \param targetFrame Target frame of rotation model.
+     */
+    GcrsToItrsRotationModelSettings( const std::string& earthOrientationParametersFile = "",
+                                     const std::string& cipXSeriesFile = "",
+                                     const std::string& cipYSeriesFile = "",
+                                     const std::string& cioLocatorSeriesFile = "",
+                                     const bool useTruncatedSeries = false,
+                                     const double gridStartTime = TUDAT_NAN,
+                                     const double gridEndTime = TUDAT_NAN,
+                                     const double gridTimeStep = 3600.0,
+                                     const std::string& originalFrame = "GCRS",
+                                     const std::string& targetFrame = "ITRS" ):
+        RotationModelSettings( gcrs_to_itrs_rotation_model, originalFrame, targetFrame ),
+        earthOrientationParametersFile_( earthOrientationParametersFile ),
+        cipXSeriesFile_( cipXSeriesFile ), cipYSeriesFile_( cipYSeriesFile ),
+        cioLocatorSeriesFile_( cioLocatorSeriesFile ), useTruncatedSeries_( useTruncatedSeries ),
+        gridStartTime_( gridStartTime ), gridEndTime_( gridEndTime ), gridTimeStep_( gridTimeStep ){ }
+
+    //! Function to return the name of file with Earth orientation parameters.
+    /*!
+     *  Function to return the name of file with Earth orientation parameters.
+     *  \return Name of file with Earth orientation parameters.
+     */
+    std::string getEarthOrientationParametersFile( ){ return earthOrientationParametersFile_; }
+
+    //! Function to return the name of file with series for X-coordinate of the CIP.
+    /*!
+     *  Function to return the name of file with series for X-coordinate of the CIP.
+     *  \return Name of file with series for X-coordinate of the CIP.
+     */
+    std::string getCipXSeriesFile( ){ return cipXSeriesFile_; }
+
+    //! Function to return the name of file with series for Y-coordinate of the CIP.
+    /*!
+     *  Function to return the name of file with series for Y-coordinate of the CIP.
+     *  \return Name of file with series for Y-coordinate of the CIP.
+     */
+    std::string getCipYSeriesFile( ){ return cipYSeriesFile_; }
+
+    //! Function to return the name of file with series for s + XY/2.
+    /*!
+     *  Function to return the name of file with series for s + XY/2.
+     *  \return Name of file with series for s + XY/2.
+     */
+    std::string getCioLocatorSeriesFile( ){ return cioLocatorSeriesFile_; }
+
+    //! Function to return whether truncated series are to be used for series for which no file is given.
+    /*!
+     *  Function to return whether truncated series are to be used for series for which no file is given.
+     *  \return Boolean denoting whether truncated series are to be used for series for which no file is given.
+     */
+    bool getUseTruncatedSeries( ){ return useTruncatedSeries_; }
+
+    //! Function to return the start time of grid for precomputation of CIP coordinates and CIO locator.
+    /*!
+     *  Function to return the start time of grid for precomputation of CIP coordinates and CIO locator.
+     *  \return Start time of grid for precomputation of CIP coordinates and CIO locator.
+     */
+    double getGridStartTime( ){ return gridStartTime_; }
+
+    //! Function to return the end time of grid for precomputation of CIP coordinates and CIO locator.
+    /*!
+     *  Function to return the end time of grid for precomputation of CIP coordinates and CIO locator.
+     *  \return End time of grid for precomputation of CIP coordinates and CIO locator.
+     */
+    double getGridEndTime( ){ return gridEndTime_; }
+
+    //! Function to return the time step of grid for precomputation of CIP coordinates and CIO locator.
+    /*!
+     *  Function to return the time step of grid for precomputation of CIP coordinates and CIO locator.
+     *  \return Time step of grid for precomputation of CIP coordinates and CIO locator.
+     */
+    double getGridTimeStep( ){ return gridTimeStep_; }
+
+private:
+
+    //! Name of file with Earth orientation parameters (EOP are not used if empty).
+    std::string earthOrientationParametersFile_;
+
+    //! Name of file with series for X-coordinate of the CIP (truncated series used if empty and useTruncatedSeries_ is true).
+    std::string cipXSeriesFile_;
+
+    //! Name of file with series for Y-coordinate of the CIP (truncated series used if empty and useTruncatedSeries_ is true).
+    std::string cipYSeriesFile_;
+
+    //! Name of file with series for s + XY/2 (truncated series used if empty and useTruncatedSeries_ is true).
+    std::string cioLocatorSeriesFile_;
+
+    //! Boolean denoting whether truncated series are to be used for series for which no file is given.
+    bool useTruncatedSeries_;
+
+    //! Start time of grid for precomputation of CIP coordinates and CIO locator.
+    double gridStartTime_;
+
+    //! End time of grid for precomputation of CIP coordinates and CIO locator.
+    double gridEndTime_;
+
+    //! Time step of grid for precomputation of CIP coordinates and CIO locator.
+    double gridTimeStep_;
+};
+
 //! Function to create a rotation model.
 /*!
  *  Function to create a rotation model based on model-specific settings for the rotation.
@@ -0,0 +1,606 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#ifndef TUDAT_BATCHLEASTSQUARESESTIMATOR_H
+#define TUDAT_BATCHLEASTSQUARESESTIMATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/parallelization.h"
+#include "Tudat/Astrodynamics/ObservationModels/observationSimulator.h"
+#include "Tudat/Astrodynamics/OrbitDetermination/normalEquationsAccumulator.h"
+#include "Tudat/Astrodynamics/OrbitDetermination/ObservationPartials/linkEndStatePartials.h"
+#include "Tudat/SimulationSetup/EstimationSetup/createObservationModel.h"
+#include "Tudat/SimulationSetup/PropagationSetup/variationalEquationsSolver.h"
+
+namespace tudat
+{
+
+namespace simulation_setup
+{
+
+//! Class containing the observed values of a single observable type, for a single set of link ends, to be used in the
+//! estimation.
+/*!
+ *  Class containing the observed values of a single observable type, for a single set of link ends, to be used in the
+ *  estimation, as well as the object used to compute the associated observations from the current environment.
+ */
+template< typename ObservationScalarType = double, typename TimeType = double,
+          typename StateScalarType = ObservationScalarType >
+class LinkObservationsForEstimation
+{
+public:
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param linkEnds Link ends of the observations.
+     *  \param observationSimulator Object used to compute the observations from the current environment.
+     *  \param observationTimes Times at which the observations are made (must be in ascending order).
+     *  \param observations Concatenated vector of observed values, entries [ i * observationSize,
+     *  ( i + 1 ) * observationSize ) contain the observation at the i-th observation time.
+     *  \param weights Weights of the observations, same ordering as observations.
+     *  \param referenceLinkEnd Link end at which the observation times are valid.
+     */
+    LinkObservationsForEstimation(
+            const observation_models::LinkEnds& linkEnds,
+            const boost::shared_ptr< observation_models::SingleLinkObservationSimulatorBase<
+            ObservationScalarType, TimeType, StateScalarType > > observationSimulator,
+            const std::vector< TimeType >& observationTimes,
+            const Eigen::VectorXd& observations,
+            const Eigen::VectorXd& weights,
+            const observation_models::LinkEndType referenceLinkEnd = observation_models::receiver ):
+        linkEnds_( linkEnds ), observationSimulator_( observationSimulator ), observationTimes_( observationTimes ),
+        observations_( observations ), weights_( weights ), referenceLinkEnd_( referenceLinkEnd )
+    {
+        if( !std::is_sorted( observationTimes_.begin( ), observationTimes_.end( ) ) )
+        {
+            throw std::runtime_error( "Error when creating link observations for estimation, times are not sorted" );
+        }
+
+        if( observations_.rows( ) != weights_.rows( ) || observationTimes_.size( ) == 0 ||
+                observations_.rows( ) % static_cast< int >( observationTimes_.size( ) ) != 0 )
+        {
+            throw std::runtime_error( "Error when creating link observations for estimation, sizes are inconsistent" );
+        }
+    }
+
+    //! Function to retrieve the type of observable.
+    /*!
+     *  Function to retrieve the type of observable.
+     *  \return The type of observable.
+     */
+    observation_models::ObservableType getObservableType( )
+    {
+        return observationSimulator_->getObservableType( );
+    }
+
+    //! Function to retrieve the link ends of the observations.
+    /*!
+     *  Function to retrieve the link ends of the observations.
+     *  \return The link ends of the observations.
+     */
+    observation_models::LinkEnds& getLinkEnds( )
+    {
+        return linkEnds_;
+    }
+
+    //! Function to retrieve the object used to compute the observations from the current environment.
+    /*!
+     *  Function to retrieve the object used to compute the observations from the current environment.
+     *  \return The object used to compute the observations from the current environment.
+     */
+    boost::shared_ptr< observation_models::SingleLinkObservationSimulatorBase<
+    ObservationScalarType, TimeType, StateScalarType > > getObservationSimulator( )
+    {
+        return observationSimulator_;
+    }
+
+    //! Function to retrieve the times at which the observations are made.
+    /*!
+     *  Function to retrieve the times at which the observations are made.
+     *  \return The times at which the observations are made.
+     */
+    const std::vector< TimeType >& getObservationTimes( )
+    {
+        return observationTimes_;
+    }
+
+    //! Function to retrieve the concatenated vector of observed values.
+    /*!
+     *  Function to retrieve the concatenated vector of observed values.
+     *  \return The concatenated vector of observed values.
+     */
+    const Eigen::VectorXd& getObservations( )
+    {
+        return observations_;
+    }
+
+    //! Function to retrieve the weights of the observations.
+    /*!
+     *  Function to retrieve the weights of the observations.
+     *  \return The weights of the observations.
+     */
+    const Eigen::VectorXd& getWeights( )
+    {
+        return weights_;
+    }
+
+    //! Function to retrieve the link end at which the observation times are valid.
+    /*!
+     *  Function to retrieve the link end at which the observation times are valid.
+     *  \return The link end at which the observation times are valid.
+     */
+    observation_models::LinkEndType getReferenceLinkEnd( )
+    {
+        return referenceLinkEnd_;
+    }
+
+    //! Function to retrieve the number of observations (times) of the link.
+    /*!
+     *  Function to retrieve the number of observations (times) of the link.
+     *  \return The number of observations (times) of the link.
+     */
+    int getNumberOfObservations( )
+    {
+        return observationTimes_.size( );
+    }
+
+    //! Function to retrieve the size of a single observation.
+    /*!
+     *  Function to retrieve the size of a single observation.
+     *  \return The size of a single observation.
+     */
+    int getObservationSize( )
+    {
+        return observations_.rows( ) / observationTimes_.size( );
+    }
+
+private:
+
+    //! Link ends of the observations.
+    observation_models::LinkEnds linkEnds_;
+
+    //! Object used to compute the observations from the current environment.
+    boost::shared_ptr< observation_models::SingleLinkObservationSimulatorBase<
+    ObservationScalarType, TimeType, StateScalarType > > observationSimulator_;
+
+    //! Times at which the observations are made (in ascending order).
+    std::vector< TimeType > observationTimes_;
+
+    //! Concatenated vector of observed values.
+    Eigen::VectorXd observations_;
+
+    //! Weights of the observations.
+    Eigen::VectorXd weights_;
+
+    //! Link end at which the observation times are valid.
+    observation_models::LinkEndType referenceLinkEnd_;
+};
+
+//! Function to create the observations of a single link for use in estimation, using an observation model created
+//! from the environment.
+/*!
+ *  Function to create the observations of a single link for use in estimation, using an observation model created
+ *  from the environment.
+ *  \param observableType Type of observable.
+ *  \param linkEnds Link ends of the observations.
+ *  \param bodyMap List of body objects that comprises the environment.
+ *  \param observationTimes Times at which the observations are made (must be in ascending order).
+ *  \param observations Concatenated vector of observed values.
+ *  \param weights Weights of the observations.
+ *  \param referenceLinkEnd Link end at which the observation times are valid.
+ *  \return Observations of a single link for use in estimation.
+ */
+template< int ObservationSize, typename ObservationScalarType = double, typename TimeType = double,
+          typename StateScalarType = ObservationScalarType >
+boost::shared_ptr< LinkObservationsForEstimation< ObservationScalarType, TimeType, StateScalarType > >
+createLinkObservationsForEstimation(
+        const observation_models::ObservableType observableType,
+        const observation_models::LinkEnds& linkEnds,
+        const NamedBodyMap& bodyMap,
+        const std::vector< TimeType >& observationTimes,
+        const Eigen::VectorXd& observations,
+        const Eigen::VectorXd& weights,
+        const observation_models::LinkEndType referenceLinkEnd = observation_models::receiver )
+{
+    return boost::make_shared< LinkObservationsForEstimation< ObservationScalarType, TimeType, StateScalarType > >(
+                linkEnds, boost::make_shared< observation_models::SingleLinkObservationSimulator<
+                ObservationSize, ObservationScalarType, TimeType, StateScalarType > >(
+                    observation_models::ObservationModelCreator<
+                    ObservationSize, ObservationScalarType, TimeType, StateScalarType >::createObservationModel(
+                        observableType, linkEnds, bodyMap ) ),
+                observationTimes, observations, weights, referenceLinkEnd );
+}
+
+//! Class containing the results of a batch least-squares estimation.
+class BatchLeastSquaresEstimationOutput
+{
+public:
+
+    //! Function to retrieve the formal errors of the estimated parameters.
+    /*!
+     *  Function to retrieve the formal errors of the estimated parameters (square root of diagonal of covariance).
+     *  \return Formal errors of the estimated parameters.
+     */
+    Eigen::VectorXd getFormalErrors( )
+    {
+        return parameterCovariance_.diagonal( ).cwiseSqrt( );
+    }
+
+    //! Final estimate of the parameters.
+    Eigen::VectorXd parameterEstimate_;
+
+    //! Covariance matrix of the estimated parameters (inverse of normal matrix) from final iteration.
+    Eigen::MatrixXd parameterCovariance_;
+
+    //! Residuals (observed minus computed) of final iteration, concatenated in order of links.
+    Eigen::VectorXd residuals_;
+
+    //! Parameter values at the start of each iteration, followed by final estimate.
+    std::vector< Eigen::VectorXd > parameterHistory_;
+
+    //! Root mean square of the (unweighted) residuals of each iteration.
+    std::vector< double > residualRmsHistory_;
+
+    //! Number of observations (rows of design matrix) used in the estimation.
+    int numberOfObservations_;
+
+    //! Boolean denoting whether the convergence criterion was met before the maximum number of iterations.
+    bool isConverged_;
+};
+
+//! Class to perform a batch (weighted) least-squares estimation of the parameters of a single-arc dynamical model.
+/*!
+ *  Class to perform a batch (weighted) least-squares estimation of the parameters of a single-arc dynamical model,
+ *  i.e. initial translational states and parameters for which the sensitivity matrix is computed by the variational
+ *  equations solver. The partials of the observations w.r.t. the parameters are computed from the partials w.r.t. the
+ *  states of the link ends (see computeObservationPartialWrtLinkEndStates) and the state transition/sensitivity matrix.
+ *  Direct dependencies of the observations on the parameters (e.g. through ground station positions or light-time
+ *  corrections) are not included. Link ends on bodies for which the initial translational state is not estimated are
+ *  not associated with any estimated state (index -1), so that the observations of such a link end do not contribute
+ *  any partials through its state: their state is then taken as known, even if it depends on the estimated parameters
+ *  (e.g. a body whose dynamics is propagated but whose initial state is not estimated).
+ *
+ *  The normal equations are accumulated block by block (see NormalEquationsAccumulator), so that the full design matrix
+ *  is never stored. The memory use of the estimation scales with the square of the number of parameters, and linearly
+ *  with the block size; it is independent of the total number of observations (apart from the observations and
+ *  residuals themselves).
+ *
+ *  The links are processed concurrently on a number of threads, each link being accumulated into its own normal
+ *  equations. These are summed in the order of the links, so that the estimation result does not depend on the number
+ *  of threads. The computation of the observations and the evaluation of the state transition matrix interface use
+ *  the (shared) environment, and are therefore performed under a lock; the computation of the partials and the update
+ *  of the normal equations, which dominate for large numbers of parameters, are performed concurrently.
+ */
+template< typename ObservationScalarType = double, typename TimeType = double,
+          typename StateScalarType = ObservationScalarType >
+class BatchLeastSquaresEstimator
+{
+public:
+
+    //! Typedef for the observations of a single link.
+    typedef LinkObservationsForEstimation< ObservationScalarType, TimeType, StateScalarType > LinkObservations;
+
+    //! Constructor
+    /*!
+     *  Constructor
+     *  \param variationalEquationsSolver Object used to propagate the dynamics and variational equations (must have
+     *  been integrated before the estimation is started).
+     *  \param linkObservations List of observations per link that are to be used in the estimation.
+     *  \param numberOfThreads Number of threads over which the links are distributed.
+     *  \param observationBlockSize Maximum number of observation times per block added to the normal equations.
+     */
+    BatchLeastSquaresEstimator(
+            const boost::shared_ptr< propagators::SingleArcVariationalEquationsSolver< StateScalarType, TimeType, double > >
+            variationalEquationsSolver,
+            const std::vector< boost::shared_ptr< LinkObservations > >& linkObservations,
+            const unsigned int numberOfThreads = 1,
+            const int observationBlockSize = 1000 ):
+        variationalEquationsSolver_( variationalEquationsSolver ), linkObservations_( linkObservations ),
+        numberOfThreads_( numberOfThreads ), observationBlockSize_( observationBlockSize )
+    {
+        if( observationBlockSize_ <= 0 )
+        {
+            throw std::runtime_error( "Error when creating batch least-squares estimator, block size must be positive" );
+        }
+
+        parametersToEstimate_ = variationalEquationsSolver_->getParametersToEstimate( );
+        numberOfParameters_ = parametersToEstimate_->getParameterSetSize( );
+
+        // Determine, for each link end of each link, the index of the associated estimated body (-1 if none).
+        std::vector< std::string > estimatedBodies =
+                estimatable_parameters::getListOfBodiesWithTranslationalStateToEstimate( parametersToEstimate_ );
+        linkEndBodyIndices_.resize( linkObservations_.size( ) );
+        for( unsigned int i = 0; i < linkObservations_.size( ); i++ )
+        {
+            std::vector< observation_models::LinkEndType > linkEndTypes =
+                    observation_partials::getLinkEndTypesOfObservable( linkObservations_.at( i )->getObservableType( ) );
+            for( unsigned int j = 0; j < linkEndTypes.size( ); j++ )
+            {
+                std::vector< std::string >::iterator bodyIterator = std::find(
+                            estimatedBodies.begin( ), estimatedBodies.end( ),
+                            linkObservations_.at( i )->getLinkEnds( ).at( linkEndTypes.at( j ) ).first );
+                linkEndBodyIndices_[ i ].push_back(
+                            ( bodyIterator == estimatedBodies.end( ) ) ?
+                                -1 : std::distance( estimatedBodies.begin( ), bodyIterator ) );
+            }
+        }
+    }
+
+    //! Function to compute the normal equations for the current parameter values.
+    /*!
+     *  Function to compute the normal equations for the current parameter values (i.e. using the current state of the
+     *  variational equations solver).
+     *  \param normalEquations Accumulated normal equations (returned by reference).
+     *  \param residuals Residuals (observed minus computed), concatenated in order of links (returned by reference).
+     */
+    void computeNormalEquations( orbit_determination::NormalEquationsAccumulator& normalEquations,
+                                 Eigen::VectorXd& residuals )
+    {
+        // Accumulate normal equations per link.
+        std::vector< orbit_determination::NormalEquationsAccumulator > linkNormalEquations(
+                    linkObservations_.size( ),
+                    orbit_determination::NormalEquationsAccumulator( numberOfParameters_ ) );
+        std::vector< Eigen::VectorXd > linkResiduals( linkObservations_.size( ) );
+        utilities::executeParallelLoop(
+                    linkObservations_.size( ),
+                    [ & ]( const unsigned int linkIndex )
+        {
+            accumulateLinkNormalEquations( linkIndex, linkNormalEquations[ linkIndex ], linkResiduals[ linkIndex ] );
+        }, numberOfThreads_ );
+
+        // Sum normal equations in fixed order of links.
+        normalEquations.resetAccumulator( numberOfParameters_ );
+        int numberOfResiduals = 0;
+        for( unsigned int i = 0; i < linkObservations_.size( ); i++ )
+        {
+            normalEquations.addAccumulator( linkNormalEquations[ i ] );
+            numberOfResiduals += linkResiduals[ i ].rows( );
+        }
+
+        residuals.resize( numberOfResiduals );
+        int currentIndex = 0;
+        for( unsigned int i = 0; i < linkObservations_.size( ); i++ )
+        {
+            residuals.segment( currentIndex, linkResiduals[ i ].rows( ) ) = linkResiduals[ i ];
+            currentIndex += linkResiduals[ i ].rows( );
+        }
+    }
+
+    //! Function to perform the iterative least-squares estimation.
+    /*!
+     *  Function to perform the iterative least-squares estimation. In each iteration, the normal equations are
+     *  accumulated, solved using a Cholesky decomposition, and the parameters (and dynamics/variational equations) are
+     *  updated. The iterations are stopped when the relative change in the residual rms between two iterations is below
+     *  the given tolerance, or when the maximum number of iterations is reached. When done, the environment is left in
+     *  the state corresponding to the final estimate.
+     *  \param maximumNumberOfIterations Maximum number of iterations.
+     *  \param convergenceTolerance Relative change in residual rms below which the estimation is considered converged.
+     *  \param inverseAprioriCovariance Inverse a priori covariance of the parameters, with the a priori values taken as
+     *  the parameter values at the start of the estimation (no a priori information is used if empty).
+     *  \return Results of the estimation.
+     */
+    boost::shared_ptr< BatchLeastSquaresEstimationOutput > estimateParameters(
+            const int maximumNumberOfIterations = 5,
+            const double convergenceTolerance = 1.0E-3,
+            const Eigen::MatrixXd& inverseAprioriCovariance = Eigen::MatrixXd::Zero( 0, 0 ) )
+    {
+        boost::shared_ptr< BatchLeastSquaresEstimationOutput > estimationOutput =
+                boost::make_shared< BatchLeastSquaresEstimationOutput >( );
+        estimationOutput->isConverged_ = false;
+
+        Eigen::VectorXd aprioriParameters = parametersToEstimate_->template getFullParameterValues< double >( );
+        Eigen::VectorXd currentParameters = aprioriParameters;
+
+        orbit_determination::NormalEquationsAccumulator normalEquations( numberOfParameters_ );
+        Eigen::VectorXd parameterCorrection;
+        for( int iteration = 0; iteration < maximumNumberOfIterations; iteration++ )
+        {
+            // Compute and solve normal equations for current parameter values.
+            computeNormalEquations( normalEquations, estimationOutput->residuals_ );
+            if( inverseAprioriCovariance.rows( ) > 0 )
+            {
+                normalEquations.addAprioriInformation( inverseAprioriCovariance, aprioriParameters - currentParameters );
+            }
+            normalEquations.solveNormalEquations( parameterCorrection, estimationOutput->parameterCovariance_ );
+
+            estimationOutput->parameterHistory_.push_back( currentParameters );
+            estimationOutput->residualRmsHistory_.push_back(
+                        std::sqrt( normalEquations.getResidualSquareSum( ) /
+                                   static_cast< double >( normalEquations.getNumberOfObservations( ) ) ) );
+            currentParameters += parameterCorrection;
+
+            // Check convergence.
+            if( iteration > 0 )
+            {
+                double previousRms = estimationOutput->residualRmsHistory_.at( iteration - 1 );
+                double currentRms = estimationOutput->residualRmsHistory_.at( iteration );
+                if( std::fabs( previousRms - currentRms ) <= convergenceTolerance * previousRms )
+                {
+                    estimationOutput->isConverged_ = true;
+                }
+            }
+
+            // Update parameters, and only re-integrate variational equations if another iteration is to be performed.
+            bool isLastIteration = estimationOutput->isConverged_ || ( iteration == maximumNumberOfIterations - 1 );
+            variationalEquationsSolver_->resetParameterEstimate( currentParameters, !isLastIteration );
+            if( isLastIteration )
+            {
+                break;
+            }
+        }
+
+        estimationOutput->parameterEstimate_ = currentParameters;
+        estimationOutput->parameterHistory_.push_back( currentParameters );
+        estimationOutput->numberOfObservations_ = normalEquations.getNumberOfObservations( );
+
+        return estimationOutput;
+    }
+
+    //! Function to reset the number of threads over which the links are distributed.
+    /*!
+     *  Function to reset the number of threads over which the links are distributed.
+     *  \param numberOfThreads Number of threads over which the links are distributed.
+     */
+    void setNumberOfThreads( const unsigned int numberOfThreads )
+    {
+        numberOfThreads_ = numberOfThreads;
+    }
+
+    //! Function to retrieve the number of estimated parameters.
+    /*!
+     *  Function to retrieve the number of estimated parameters.
+     *  \return The number of estimated parameters.
+     */
+    int getNumberOfParameters( )
+    {
+        return numberOfParameters_;
+    }
+
+private:
+
+    //! Function to accumulate the normal equations of a single link.
+    /*!
+     *  Function to accumulate the normal equations of a single link, block by block.
+     *  \param linkIndex Index of link in linkObservations_.
+     *  \param normalEquations Normal equations to which the observations of the link are added (returned by reference).
+     *  \param residuals Residuals of the observations of the link (returned by reference).
+     */
+    void accumulateLinkNormalEquations( const unsigned int linkIndex,
+                                        orbit_determination::NormalEquationsAccumulator& normalEquations,
+                                        Eigen::VectorXd& residuals )
+    {
+        boost::shared_ptr< LinkObservations > currentLink = linkObservations_.at( linkIndex );
+        const std::vector< int >& linkEndBodyIndices = linkEndBodyIndices_.at( linkIndex );
+        const std::vector< TimeType >& observationTimes = currentLink->getObservationTimes( );
+
+        int numberOfObservations = currentLink->getNumberOfObservations( );
+        int observationSize = currentLink->getObservationSize( );
+        int numberOfLinkEnds = linkEndBodyIndices.size( );
+        residuals.resize( numberOfObservations * observationSize );
+
+        // Pre-allocate variables used for each block.
+        observation_models::SingleLinkObservationBatch< ObservationScalarType, TimeType, StateScalarType > computedBatch(
+                    currentLink->getObservableType( ), currentLink->getReferenceLinkEnd( ) );
+        std::vector< Eigen::MatrixXd > linkEndStateTransitionMatrices;
+        std::vector< double > stateTransitionMatrixTimes;
+        std::vector< int > stateTransitionMatrixIndices(
+                    std::min( numberOfObservations, observationBlockSize_ ) * numberOfLinkEnds );
+        std::vector< Eigen::Vector6d > currentLinkEndStates( numberOfLinkEnds );
+        Eigen::MatrixXd blockPartials;
+
+        for( int blockStart = 0; blockStart < numberOfObservations; blockStart += observationBlockSize_ )
+        {
+            int blockSize = std::min( observationBlockSize_, numberOfObservations - blockStart );
+            std::vector< TimeType > blockTimes( observationTimes.begin( ) + blockStart,
+                                                observationTimes.begin( ) + blockStart + blockSize );
+
+            // Compute observations and state transition matrices at link end times (using shared environment).
+            {
+                std::lock_guard< std::mutex > environmentLock( environmentMutex_ );
+                currentLink->getObservationSimulator( )->simulateObservations( blockTimes, computedBatch );
+
+                // Collect (nearly sorted) times at which state transition matrices are needed, and evaluate in batch.
+                stateTransitionMatrixTimes.clear( );
+                for( int i = 0; i < blockSize; i++ )
+                {
+                    for( int j = 0; j < numberOfLinkEnds; j++ )
+                    {
+                        if( linkEndBodyIndices.at( j ) >= 0 )
+                        {
+                            stateTransitionMatrixIndices[ i * numberOfLinkEnds + j ] =
+                                    stateTransitionMatrixTimes.size( );
+                            stateTransitionMatrixTimes.push_back(
+                                        static_cast< double >( computedBatch.getLinkEndTimes( )[
+                                                               i * numberOfLinkEnds + j ] ) );
+                        }
+                    }
+                }
+                variationalEquationsSolver_->getStateTransitionMatrixInterface( )->
+                        getCombinedStateTransitionAndSensitivityMatrices(
+                            stateTransitionMatrixTimes, linkEndStateTransitionMatrices );
+            }
+
+            // Compute partials of observations w.r.t. parameters.
+            blockPartials.setZero( blockSize * observationSize, numberOfParameters_ );
+            for( int i = 0; i < blockSize; i++ )
+            {
+                for( int j = 0; j < numberOfLinkEnds; j++ )
+                {
+                    currentLinkEndStates[ j ] = computedBatch.getSingleLinkEndState( i, j ).template cast< double >( );
+                }
+
+                Eigen::MatrixXd linkEndStatePartials = observation_partials::computeObservationPartialWrtLinkEndStates(
+                            currentLink->getObservableType( ), currentLinkEndStates,
+                            currentLink->getReferenceLinkEnd( ) );
+                for( int j = 0; j < numberOfLinkEnds; j++ )
+                {
+                    if( linkEndBodyIndices.at( j ) >= 0 )
+                    {
+                        blockPartials.block( i * observationSize, 0, observationSize, numberOfParameters_ ) +=
+                                linkEndStatePartials.block( 0, 6 * j, observationSize, 6 ) *
+                                linkEndStateTransitionMatrices[
+                                    stateTransitionMatrixIndices[ i * numberOfLinkEnds + j ] ].block(
+                                    6 * linkEndBodyIndices.at( j ), 0, 6, numberOfParameters_ );
+                    }
+                }
+            }
+
+            // Compute residuals, and add block to normal equations.
+            residuals.segment( blockStart * observationSize, blockSize * observationSize ) =
+                    currentLink->getObservations( ).segment( blockStart * observationSize, blockSize * observationSize ) -
+                    computedBatch.getObservations( ).template cast< double >( );
+            normalEquations.addObservationBlock(
+                        blockPartials,
+                        residuals.segment( blockStart * observationSize, blockSize * observationSize ),
+                        currentLink->getWeights( ).segment( blockStart * observationSize, blockSize * observationSize ) );
+        }
+    }
+
+    //! Object used to propagate the dynamics and variational equations.
+    boost::shared_ptr< propagators::SingleArcVariationalEquationsSolver< StateScalarType, TimeType, double > >
+    variationalEquationsSolver_;
+
+    //! Set of parameters that are estimated.
+    boost::shared_ptr< estimatable_parameters::EstimatableParameterSet< double > > parametersToEstimate_;
+
+    //! List of observations per link that are used in the estimation.
+    std::vector< boost::shared_ptr< LinkObservations > > linkObservations_;
+
+    //! Index of estimated body associated with each link end of each link (-1 if none).
+    std::vector< std::vector< int > > linkEndBodyIndices_;
+
+    //! Number of estimated parameters.
+    int numberOfParameters_;
+
+    //! Number of threads over which the links are distributed.
+    unsigned int numberOfThreads_;
+
+    //! Maximum number of observation times per block added to the normal equations.
+    int observationBlockSize_;
+
+    //! Mutex used to prevent concurrent evaluation of the (shared) environment.
+    std::mutex environmentMutex_;
+};
+
+} // namespace simulation_setup
+
+} // namespace tudat
+
+#endif // TUDAT_BATCHLEASTSQUARESESTIMATOR_H
@@ -19,6 +19,7 @@
 #include "Tudat/Astrodynamics/OrbitDetermination/AccelerationPartials/accelerationPartial.h"
 #include "Tudat/Astrodynamics/OrbitDetermination/AccelerationPartials/centralGravityAccelerationPartial.h"
 #include "Tudat/Astrodynamics/OrbitDetermination/AccelerationPartials/radiationPressureAccelerationPartial.h"
+#include "Tudat/Astrodynamics/OrbitDetermination/AccelerationPartials/panelledRadiationPressureAccelerationPartial.h"
 #include "Tudat/Astrodynamics/OrbitDetermination/AccelerationPartials/thirdBodyGravityPartial.h"
 #include "Tudat/Astrodynamics/OrbitDetermination/AccelerationPartials/sphericalHarmonicAccelerationPartial.h"
 #include "Tudat/Astrodynamics/OrbitDetermination/ObservationPartials/rotationMatrixPartial.h"
@@ -203,6 +204,23 @@ boost::shared_ptr< acceleration_partials::AccelerationPartial > createAnalytical
         }
         break;
     }
+    case panelled_radiation_pressure:
+    {
+        // Check if identifier is consistent with type.
+        boost::shared_ptr< PanelledRadiationPressureAcceleration > radiationPressureAcceleration =
+                boost::dynamic_pointer_cast< PanelledRadiationPressureAcceleration >( accelerationModel );
+        if( radiationPressureAcceleration == NULL )
+        {
+            throw std::runtime_error( "Acceleration class type does not match acceleration type (panelled_radiation_pressure) when making acceleration partial" );
+        }
+        else
+        {
+            // Create partial-calculating object.
+            accelerationPartial = boost::make_shared< PanelledRadiationPressurePartial >
+                    ( radiationPressureAcceleration, acceleratedBody.first, acceleratingBody.first );
+        }
+        break;
+    }
     default:
         std::string errorMessage = "Acceleration model " + boost::lexical_cast< std::string >( accelerationType ) +
                 " not found when making acceleration partial";
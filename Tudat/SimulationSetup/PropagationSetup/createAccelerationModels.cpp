@@ -359,6 +359,18 @@ createSphericalHarmonicsGravityAcceleration(
                       boost::bind( &Body::getPosition, bodyExertingAcceleration ),
                       boost::bind( &Body::getCurrentRotationToGlobalFrame,
                                    bodyExertingAcceleration ), useCentralBodyFixedFrame );
+
+            // Retrieve coefficients in place during propagation, to prevent coefficient matrices from being allocated
+            // for each evaluation.
+            accelerationModel->setCoefficientUpdateFunctions(
+                        boost::bind( &SphericalHarmonicsGravityField::getCosineCoefficientsBlock,
+                                     sphericalHarmonicsGravityField, _1,
+                                     sphericalHarmonicsSettings->maximumDegree_,
+                                     sphericalHarmonicsSettings->maximumOrder_ ),
+                        boost::bind( &SphericalHarmonicsGravityField::getSineCoefficientsBlock,
+                                     sphericalHarmonicsGravityField, _1,
+                                     sphericalHarmonicsSettings->maximumDegree_,
+                                     sphericalHarmonicsSettings->maximumOrder_ ) );
         }
     }
     return accelerationModel;
@@ -768,6 +780,94 @@ createCannonballRadiationPressureAcceleratioModel(
 
 }
 
+//! Function to retrieve the panelled surface model of a body undergoing acceleration.
+boost::shared_ptr< system_models::PanelledSurfaceModel > getPanelledSurfaceModel(
+        const boost::shared_ptr< Body > bodyUndergoingAcceleration,
+        const std::string& nameOfBodyUndergoingAcceleration )
+{
+    if( bodyUndergoingAcceleration->getVehicleSystems( ) == NULL ||
+            bodyUndergoingAcceleration->getVehicleSystems( )->getPanelledSurfaceModel( ) == NULL )
+    {
+        throw std::runtime_error(
+                    "Error when making panelled acceleration, no panelled surface model found in " +
+                    nameOfBodyUndergoingAcceleration );
+    }
+    return bodyUndergoingAcceleration->getVehicleSystems( )->getPanelledSurfaceModel( );
+}
+
+//! Function to create a panelled radiation pressure acceleration model.
+boost::shared_ptr< PanelledRadiationPressureAcceleration >
+createPanelledRadiationPressureAccelerationModel(
+        const boost::shared_ptr< Body > bodyUndergoingAcceleration,
+        const boost::shared_ptr< Body > bodyExertingAcceleration,
+        const std::string& nameOfBodyUndergoingAcceleration,
+        const std::string& nameOfBodyExertingAcceleration )
+{
+    // Retrieve radiation pressure interface
+    if( bodyUndergoingAcceleration->getRadiationPressureInterfaces( ).count(
+                nameOfBodyExertingAcceleration ) == 0 )
+    {
+        throw std::runtime_error(
+                    "Error when making panelled radiation pressure, no radiation pressure interface found  in " +
+                    nameOfBodyUndergoingAcceleration +
+                    " for body " + nameOfBodyExertingAcceleration );
+    }
+    boost::shared_ptr< RadiationPressureInterface > radiationPressureInterface =
+            bodyUndergoingAcceleration->getRadiationPressureInterfaces( ).at(
+                nameOfBodyExertingAcceleration );
+
+    // Create acceleration model.
+    return boost::make_shared< PanelledRadiationPressureAcceleration >(
+                boost::bind( &Body::getPosition, bodyExertingAcceleration ),
+                boost::bind( &Body::getPosition, bodyUndergoingAcceleration ),
+                boost::bind( &RadiationPressureInterface::getCurrentRadiationPressure, radiationPressureInterface ),
+                boost::bind( &Body::getCurrentRotationToGlobalFrame, bodyUndergoingAcceleration ),
+                getPanelledSurfaceModel( bodyUndergoingAcceleration, nameOfBodyUndergoingAcceleration ),
+                boost::bind( &Body::getBodyMass, bodyUndergoingAcceleration ) );
+}
+
+//! Function to create a panelled drag acceleration model.
+boost::shared_ptr< aerodynamics::PanelledDragAcceleration >
+createPanelledDragAccelerationModel(
+        const boost::shared_ptr< Body > bodyUndergoingAcceleration,
+        const boost::shared_ptr< Body > bodyExertingAcceleration,
+        const std::string& nameOfBodyUndergoingAcceleration,
+        const std::string& nameOfBodyExertingAcceleration )
+{
+    boost::shared_ptr< system_models::PanelledSurfaceModel > panelledSurfaceModel =
+            getPanelledSurfaceModel( bodyUndergoingAcceleration, nameOfBodyUndergoingAcceleration );
+
+    // Retrieve flight conditions; create object if not yet extant.
+    boost::shared_ptr< FlightConditions > bodyFlightConditions =
+            bodyUndergoingAcceleration->getFlightConditions( );
+
+    if( bodyFlightConditions == NULL )
+    {
+        bodyUndergoingAcceleration->setFlightConditions(
+                    createFlightConditions( bodyUndergoingAcceleration,
+                                            bodyExertingAcceleration,
+                                            nameOfBodyUndergoingAcceleration,
+                                            nameOfBodyExertingAcceleration ) );
+        bodyFlightConditions = bodyUndergoingAcceleration->getFlightConditions( );
+    }
+    else if( bodyFlightConditions->getAerodynamicAngleCalculator( )->getCentralBodyName( ) !=
+             nameOfBodyExertingAcceleration )
+    {
+        throw std::runtime_error( "Error when making panelled drag acceleration, flight conditions of " +
+                                  nameOfBodyUndergoingAcceleration + " are not defined w.r.t. " +
+                                  nameOfBodyExertingAcceleration );
+    }
+
+    // Create acceleration model.
+    return boost::make_shared< PanelledDragAcceleration >(
+                boost::bind( &FlightConditions::getCurrentDensity, bodyFlightConditions ),
+                boost::bind( &FlightConditions::getCurrentAirspeedBasedVelocity, bodyFlightConditions ),
+                boost::bind( &Body::getCurrentRotationToGlobalFrame, bodyExertingAcceleration ),
+                boost::bind( &Body::getCurrentRotationToGlobalFrame, bodyUndergoingAcceleration ),
+                panelledSurfaceModel,
+                boost::bind( &Body::getBodyMass, bodyUndergoingAcceleration ) );
+}
+
 //! Function to create a thrust acceleration model.
 boost::shared_ptr< propulsion::ThrustAcceleration >
 createThrustAcceleratioModel(
@@ -916,6 +1016,20 @@ boost::shared_ptr< AccelerationModel< Eigen::Vector3d > > createAccelerationMode
                     nameOfBodyUndergoingAcceleration,
                     nameOfBodyExertingAcceleration );
         break;
+    case panelled_radiation_pressure:
+        accelerationModelPointer = createPanelledRadiationPressureAccelerationModel(
+                    bodyUndergoingAcceleration,
+                    bodyExertingAcceleration,
+                    nameOfBodyUndergoingAcceleration,
+                    nameOfBodyExertingAcceleration );
+        break;
+    case panelled_drag:
+        accelerationModelPointer = createPanelledDragAccelerationModel(
+                    bodyUndergoingAcceleration,
+                    bodyExertingAcceleration,
+                    nameOfBodyUndergoingAcceleration,
+                    nameOfBodyExertingAcceleration );
+        break;
     case thrust_acceleration:
         accelerationModelPointer = createThrustAcceleratioModel(
                     accelerationSettings, bodyMap,
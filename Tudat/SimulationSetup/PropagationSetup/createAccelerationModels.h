@@ -20,6 +20,8 @@
 #include "Tudat/Astrodynamics/Aerodynamics/aerodynamicAcceleration.h"
 #include "Tudat/SimulationSetup/PropagationSetup/accelerationSettings.h"
 #include "Tudat/Astrodynamics/ElectroMagnetism/cannonBallRadiationPressureAcceleration.h"
+#include "Tudat/Astrodynamics/ElectroMagnetism/panelledRadiationPressureAcceleration.h"
+#include "Tudat/Astrodynamics/Aerodynamics/panelledDragAcceleration.h"
 #include "Tudat/Astrodynamics/Gravitation/thirdBodyPerturbation.h"
 
 namespace tudat
@@ -302,6 +304,59 @@ createCannonballRadiationPressureAcceleratioModel(
         const std::string& nameOfBodyUndergoingAcceleration,
         const std::string& nameOfBodyExertingAcceleration );
 
+//! Function to retrieve the panelled surface model of a body undergoing acceleration.
+/*!
+ *  Function to retrieve the panelled surface model of a body undergoing acceleration from its vehicle systems,
+ *  throwing an error if none is defined.
+ *  \param bodyUndergoingAcceleration Pointer to object of body that is being accelerated.
+ *  \param nameOfBodyUndergoingAcceleration Name of object of body that is being accelerated.
+ *  \return Panelled surface model of body undergoing acceleration.
+ */
+boost::shared_ptr< system_models::PanelledSurfaceModel > getPanelledSurfaceModel(
+        const boost::shared_ptr< Body > bodyUndergoingAcceleration,
+        const std::string& nameOfBodyUndergoingAcceleration );
+
+//! Function to create a panelled radiation pressure acceleration model.
+/*!
+ *  Function to create a panelled radiation pressure acceleration model, automatically creating all required
+ *  links to environment models, vehicle properies and frame conversions. The panelled surface model is retrieved from
+ *  the vehicle systems of the body undergoing acceleration, the (shadowed) radiation pressure from its radiation
+ *  pressure interface for the body exerting the acceleration, and the panel orientation from its rotation.
+ *  \param bodyUndergoingAcceleration Pointer to object of body that is being accelerated.
+ *  \param bodyExertingAcceleration Pointer to object of body that is exerting the acceleration,
+ *  i.e. body emitting the radiation.
+ *  \param nameOfBodyUndergoingAcceleration Name of object of body that is being accelerated.
+ *  \param nameOfBodyExertingAcceleration Name of object of body that is exerting the acceleration.
+ *  \return Pointer to object for calculating panelled radiation pressure acceleration.
+ */
+boost::shared_ptr< electro_magnetism::PanelledRadiationPressureAcceleration >
+createPanelledRadiationPressureAccelerationModel(
+        const boost::shared_ptr< Body > bodyUndergoingAcceleration,
+        const boost::shared_ptr< Body > bodyExertingAcceleration,
+        const std::string& nameOfBodyUndergoingAcceleration,
+        const std::string& nameOfBodyExertingAcceleration );
+
+//! Function to create a panelled drag acceleration model.
+/*!
+ *  Function to create a panelled (free molecular flow) drag acceleration model, automatically creating all required
+ *  links to environment models, vehicle properies and frame conversions. The panelled surface model is retrieved from
+ *  the vehicle systems of the body undergoing acceleration, and the panel orientation from its rotation. The density
+ *  and airspeed are retrieved from the flight conditions of the body undergoing acceleration, which are created if
+ *  not yet extant.
+ *  \param bodyUndergoingAcceleration Pointer to object of body that is being accelerated.
+ *  \param bodyExertingAcceleration Pointer to object of body that is exerting the acceleration,
+ *  i.e. body with the atmosphere.
+ *  \param nameOfBodyUndergoingAcceleration Name of object of body that is being accelerated.
+ *  \param nameOfBodyExertingAcceleration Name of object of body that is exerting the acceleration.
+ *  \return Pointer to object for calculating panelled drag acceleration.
+ */
+boost::shared_ptr< aerodynamics::PanelledDragAcceleration >
+createPanelledDragAccelerationModel(
+        const boost::shared_ptr< Body > bodyUndergoingAcceleration,
+        const boost::shared_ptr< Body > bodyExertingAcceleration,
+        const std::string& nameOfBodyUndergoingAcceleration,
+        const std::string& nameOfBodyExertingAcceleration );
+
 //! Function to create a thrust acceleration model.
 /*!
  *  Function to create a thrust acceleration model. Creates all required
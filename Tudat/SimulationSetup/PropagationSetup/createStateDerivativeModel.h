@@ -164,6 +164,11 @@ createTranslationalStateDerivativeModel(
             "Error, did not recognize translational state propagation type: " +
             boost::lexical_cast< std::string >( translationPropagatorSettings->propagator_ ) );
     }
+
+    // Set number of threads for acceleration evaluation.
+    boost::dynamic_pointer_cast< NBodyStateDerivative< StateScalarType, TimeType > >(
+                stateDerivativeModel )->setNumberOfThreads( translationPropagatorSettings->numberOfThreads_ );
+
     return stateDerivativeModel;
 }
 
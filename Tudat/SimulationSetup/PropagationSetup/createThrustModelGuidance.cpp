@@ -417,20 +417,33 @@ boost::shared_ptr< propulsion::ThrustMagnitudeWrapper > createThrustMagnitudeWra
                 getPropulsionInputVariables(
                     bodyMap.at( nameOfBodyWithGuidance ), parameterizedThrustMagnitudeSettings->thrustIndependentVariables_,
                     parameterizedThrustMagnitudeSettings->thrustGuidanceInputVariables_ );
-        std::vector< boost::function< double( ) > > specificInputVariableFunctions =
-                getPropulsionInputVariables(
-                    bodyMap.at( nameOfBodyWithGuidance ), parameterizedThrustMagnitudeSettings->specificImpulseDependentVariables_,
-                    parameterizedThrustMagnitudeSettings->specificImpulseGuidanceInputVariables_ );
 
         // Create thrust magnitude wrapper
-        thrustMagnitudeWrapper = boost::make_shared< propulsion::ParameterizedThrustMagnitudeWrapper >(
-                    parameterizedThrustMagnitudeSettings->thrustMagnitudeFunction_,
-                    parameterizedThrustMagnitudeSettings->specificImpulseFunction_,
-                    thrustInputVariableFunctions,
-                    specificInputVariableFunctions,
-                    parameterizedThrustMagnitudeSettings->thrustIndependentVariables_,
-                    parameterizedThrustMagnitudeSettings->specificImpulseDependentVariables_,
-                    parameterizedThrustMagnitudeSettings->inputUpdateFunction_ );
+        if( !parameterizedThrustMagnitudeSettings->thrustMagnitudeAndSpecificImpulseFunction_.empty( ) )
+        {
+            thrustMagnitudeWrapper = boost::make_shared< propulsion::ParameterizedThrustMagnitudeWrapper >(
+                        parameterizedThrustMagnitudeSettings->thrustMagnitudeAndSpecificImpulseFunction_,
+                        thrustInputVariableFunctions,
+                        parameterizedThrustMagnitudeSettings->thrustIndependentVariables_,
+                        parameterizedThrustMagnitudeSettings->inputUpdateFunction_ );
+        }
+        else
+        {
+            std::vector< boost::function< double( ) > > specificInputVariableFunctions =
+                    getPropulsionInputVariables(
+                        bodyMap.at( nameOfBodyWithGuidance ),
+                        parameterizedThrustMagnitudeSettings->specificImpulseDependentVariables_,
+                        parameterizedThrustMagnitudeSettings->specificImpulseGuidanceInputVariables_ );
+
+            thrustMagnitudeWrapper = boost::make_shared< propulsion::ParameterizedThrustMagnitudeWrapper >(
+                        parameterizedThrustMagnitudeSettings->thrustMagnitudeFunction_,
+                        parameterizedThrustMagnitudeSettings->specificImpulseFunction_,
+                        thrustInputVariableFunctions,
+                        specificInputVariableFunctions,
+                        parameterizedThrustMagnitudeSettings->thrustIndependentVariables_,
+                        parameterizedThrustMagnitudeSettings->specificImpulseDependentVariables_,
+                        parameterizedThrustMagnitudeSettings->inputUpdateFunction_ );
+        }
 
         break;
 
@@ -8,6 +8,10 @@
  *    http://tudat.tudelft.nl/LICENSE.
  */
 #include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
+#if USE_CSPICE
+#include "Tudat/External/SpiceInterface/spiceEphemeris.h"
+#include "Tudat/External/SpiceInterface/spiceRotationalEphemeris.h"
+#endif
 
 namespace tudat
 {
@@ -32,6 +36,40 @@ boost::shared_ptr< ephemerides::ReferenceFrameManager > createFrameManager(
                 ephemerides );
 }
 
+//! Function to check whether any of the environment models in a body map retrieve data from Spice when evaluated.
+bool doesBodyMapUseSpice( const simulation_setup::NamedBodyMap& bodyMap )
+{
+    bool isSpiceUsed = false;
+#if USE_CSPICE
+    for( simulation_setup::NamedBodyMap::const_iterator bodyIterator = bodyMap.begin( );
+         bodyIterator != bodyMap.end( ); bodyIterator++ )
+    {
+        if( boost::dynamic_pointer_cast< ephemerides::SpiceEphemeris >(
+                    bodyIterator->second->getEphemeris( ) ) != NULL ||
+                boost::dynamic_pointer_cast< ephemerides::SpiceRotationalEphemeris >(
+                    bodyIterator->second->getRotationalEphemeris( ) ) != NULL )
+        {
+            isSpiceUsed = true;
+            break;
+        }
+    }
+#endif
+    return isSpiceUsed;
+}
+
+//! Function to get the number of threads over which the arcs of a multi-arc propagation may be distributed.
+unsigned int getNumberOfConcurrentMultiArcThreads( const std::vector< simulation_setup::NamedBodyMap >& bodyMaps )
+{
+    for( unsigned int i = 0; i < bodyMaps.size( ); i++ )
+    {
+        if( doesBodyMapUseSpice( bodyMaps.at( i ) ) )
+        {
+            return 1;
+        }
+    }
+    return bodyMaps.size( );
+}
+
 }
 
 }
@@ -22,6 +22,7 @@
 #include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
 #include "Tudat/Mathematics/Interpolators/cubicSplineInterpolator.h"
 #include "Tudat/Basics/utilities.h"
+#include "Tudat/Basics/parallelization.h"
 #include "Tudat/Astrodynamics/Propagators/nBodyStateDerivative.h"
 #include "Tudat/Astrodynamics/Ephemerides/frameManager.h"
 #include "Tudat/Mathematics/NumericalIntegrators/createNumericalIntegrator.h"
@@ -213,8 +214,11 @@ public:
             }
         }
 
+        typedef typename DynamicsStateDerivativeModel< TimeType, StateScalarType >::StateType StateDerivativeType;
         stateDerivativeFunction_ =
-                boost::bind( &DynamicsStateDerivativeModel< TimeType, StateScalarType >::computeStateDerivative,
+                boost::bind( static_cast< StateDerivativeType( DynamicsStateDerivativeModel< TimeType, StateScalarType >::* )(
+                                 const TimeType, const StateDerivativeType& ) >(
+                                 &DynamicsStateDerivativeModel< TimeType, StateScalarType >::computeStateDerivative ),
                              dynamicsStateDerivative_, _1, _2 );
         doubleStateDerivativeFunction_ =
                 boost::bind( &DynamicsStateDerivativeModel< TimeType, StateScalarType >::computeStateDoubleDerivative,
@@ -320,6 +324,19 @@ public:
         return propagationTerminationCondition_;
     }
 
+    //! Function to reset the object defining when the propagation is to be terminated.
+    /*!
+     * Function to reset the object defining when the propagation is to be terminated, replacing the one created from
+     * the termination settings in the propagator settings. Used for instance to propagate the same dynamics over
+     * different arcs.
+     * \param propagationTerminationCondition New object defining when the propagation is to be terminated.
+     */
+    void resetPropagationTerminationCondition(
+            const boost::shared_ptr< PropagationTerminationCondition > propagationTerminationCondition )
+    {
+        propagationTerminationCondition_ = propagationTerminationCondition;
+    }
+
     //! Function to retrieve the event that triggered the termination of the last propagation
     /*!
      * Function to retrieve the event that triggered the termination of the last propagation
@@ -581,6 +598,356 @@ protected:
 
 };
 
+//! Function to check whether any of the environment models in a body map retrieve data from Spice when evaluated.
+/*!
+ *  Function to check whether any of the environment models in a body map retrieve data from Spice when they are
+ *  evaluated (i.e. during a propagation), which is the case for a SpiceEphemeris or SpiceRotationalEphemeris. Models
+ *  that only use Spice when they are created (such as ephemerides tabulated from Spice data) do not retrieve data from
+ *  Spice during a propagation. Note that models that call Spice through a user-defined function (e.g. a
+ *  CustomEphemeris) cannot be detected.
+ *  \param bodyMap Map of bodies that is to be checked.
+ *  \return True if any ephemeris or rotation model in bodyMap is evaluated directly from Spice (always false if Tudat is
+ *  compiled without Spice).
+ */
+bool doesBodyMapUseSpice( const simulation_setup::NamedBodyMap& bodyMap );
+
+//! Function to get the number of threads over which the arcs of a multi-arc propagation may be distributed.
+/*!
+ *  Function to get the number of threads over which the arcs of a multi-arc propagation may be distributed. Since the
+ *  CSPICE library is not re-entrant (it keeps global state, such as its error status and the kernel pool), the arcs are
+ *  propagated serially if any of the body maps retrieves data from Spice during the propagation.
+ *  \param bodyMaps Maps of bodies used for the propagation (one per thread).
+ *  \return Number of body maps, or 1 if any of the body maps retrieves data from Spice (see doesBodyMapUseSpice).
+ */
+unsigned int getNumberOfConcurrentMultiArcThreads( const std::vector< simulation_setup::NamedBodyMap >& bodyMaps );
+
+//! Function to set the integration interval of a single-arc dynamics simulator to a given arc.
+/*!
+ *  Function to set the integration interval of a single-arc dynamics simulator to a given arc, by resetting the initial
+ *  time of its integrator settings, and replacing its termination condition by one that stops at the end of the arc.
+ *  \param dynamicsSimulator Simulator of which the integration interval is to be reset.
+ *  \param arcStartTime Start time of the arc.
+ *  \param arcEndTime End time of the arc.
+ */
+template< typename StateScalarType, typename TimeType >
+void resetSingleArcIntegrationInterval(
+        const boost::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > dynamicsSimulator,
+        const TimeType arcStartTime,
+        const TimeType arcEndTime )
+{
+    dynamicsSimulator->getIntegratorSettings( )->initialTime_ = arcStartTime;
+    dynamicsSimulator->resetPropagationTerminationCondition(
+                boost::make_shared< FixedTimePropagationTerminationCondition >(
+                    static_cast< double >( arcEndTime ), arcEndTime > arcStartTime ) );
+}
+
+//! Function to check the input to a multi-arc propagation.
+/*!
+ *  Function to check the input to a multi-arc propagation, throws an error if it is inconsistent.
+ *  \param numberOfBodyMaps Number of body maps (one per thread) provided for the propagation.
+ *  \param numberOfPropagatorSettings Number of propagator settings (one per thread) provided for the propagation.
+ *  \param arcStartTimes Start times of the arcs.
+ *  \param arcEndTimes End times of the arcs.
+ *  \throws std::runtime_error If no body maps or arcs are provided, the number of body maps and propagator settings
+ *  differ, the number of start and end times differ, or the start times are not ascending.
+ */
+template< typename TimeType >
+void checkMultiArcPropagationInput(
+        const unsigned int numberOfBodyMaps,
+        const unsigned int numberOfPropagatorSettings,
+        const std::vector< TimeType >& arcStartTimes,
+        const std::vector< TimeType >& arcEndTimes )
+{
+    if( numberOfBodyMaps == 0 )
+    {
+        throw std::runtime_error( "Error in multi-arc propagation, no body maps provided." );
+    }
+    else if( numberOfBodyMaps != numberOfPropagatorSettings )
+    {
+        throw std::runtime_error( "Error in multi-arc propagation, number of body maps (" +
+                                  boost::lexical_cast< std::string >( numberOfBodyMaps ) +
+                                  ") is inconsistent with number of propagator settings (" +
+                                  boost::lexical_cast< std::string >( numberOfPropagatorSettings ) + ")." );
+    }
+
+    if( arcStartTimes.size( ) == 0 )
+    {
+        throw std::runtime_error( "Error in multi-arc propagation, no arcs provided." );
+    }
+    else if( arcStartTimes.size( ) != arcEndTimes.size( ) )
+    {
+        throw std::runtime_error( "Error in multi-arc propagation, number of arc start and end times is inconsistent." );
+    }
+
+    for( unsigned int i = 1; i < arcStartTimes.size( ); i++ )
+    {
+        if( !( arcStartTimes.at( i ) > arcStartTimes.at( i - 1 ) ) )
+        {
+            throw std::runtime_error( "Error in multi-arc propagation, arc start times are not in ascending order." );
+        }
+    }
+}
+
+//! Function to set the numerical results of a multi-arc propagation in the environment.
+/*!
+ *  Function to set the numerical results of a multi-arc propagation in the environment, by setting a MultiArcEphemeris
+ *  (see resetMultiArcIntegratedEphemerides) for each body with propagated translational state, in each of the body maps.
+ *  Each body map receives its own interpolators, so that the body maps can subsequently be used concurrently.
+ *  \param bodyMaps List of body maps in which the results are to be set.
+ *  \param propagatorSettings Settings for the propagation (one per body map).
+ *  \param arcStartTimes Start times of the arcs.
+ *  \param arcStateHistories Numerical solution of each arc.
+ */
+template< typename StateScalarType, typename TimeType >
+void resetMultiArcIntegratedStatesInEnvironment(
+        const std::vector< simulation_setup::NamedBodyMap >& bodyMaps,
+        const std::vector< boost::shared_ptr< PropagatorSettings< StateScalarType > > >& propagatorSettings,
+        const std::vector< TimeType >& arcStartTimes,
+        const std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >&
+        arcStateHistories )
+{
+    std::vector< double > ephemerisArcStartTimes;
+    for( unsigned int i = 0; i < arcStartTimes.size( ); i++ )
+    {
+        ephemerisArcStartTimes.push_back( static_cast< double >( arcStartTimes.at( i ) ) );
+    }
+
+    for( unsigned int i = 0; i < bodyMaps.size( ); i++ )
+    {
+        resetMultiArcIntegratedEphemerides< TimeType, StateScalarType >(
+                    bodyMaps.at( i ), propagatorSettings.at( i ), ephemerisArcStartTimes, arcStateHistories );
+
+        for( simulation_setup::NamedBodyMap::const_iterator bodyIterator = bodyMaps.at( i ).begin( );
+             bodyIterator != bodyMaps.at( i ).end( ); bodyIterator++ )
+        {
+            bodyIterator->second->updateConstantEphemerisDependentMemberQuantities( );
+        }
+    }
+}
+
+//! Class for performing full numerical integration of a dynamical system in multiple, independent arcs.
+/*!
+ *  Class for performing full numerical integration of a dynamical system in multiple arcs, where each arc has its own
+ *  initial state and time interval (for instance daily arcs in precise orbit determination). Since the arcs are
+ *  independent, they are propagated concurrently: each thread propagates a contiguous block of arcs, using its own
+ *  SingleArcDynamicsSimulator, created from its own body map and propagator settings (so that no environment model or
+ *  state derivative model is shared between threads). The number of threads is equal to the number of body maps that is
+ *  provided. After the propagation, the results may be set in the environment as a MultiArcEphemeris for each
+ *  propagated body, which switches between the interpolated states of the arcs (only translational states are set).
+ *  Since the CSPICE library is not re-entrant, the arcs are propagated serially (still using the simulator of each
+ *  body map for its own block of arcs) if any body map contains an ephemeris or rotation model that is evaluated
+ *  directly from Spice (see getNumberOfConcurrentMultiArcThreads). Ephemerides and rotation models that are tabulated
+ *  from Spice data do not have this limitation. Models that call Spice through a user-defined function cannot be
+ *  detected, and must not be used with more than one body map.
+ */
+template< typename StateScalarType = double, typename TimeType = double >
+class MultiArcDynamicsSimulator
+{
+public:
+
+    //! Constructor of simulator.
+    /*!
+     *  Constructor of simulator, constructs a single-arc simulator for each thread.
+     *  \param bodyMaps Maps of bodies (with names) of all bodies in integration, one per thread. Each must be a separate
+     *  environment (i.e. created by a separate call to createBodies).
+     *  \param integratorSettings Settings for numerical integrator, used for all arcs (with the initial time replaced by
+     *  the arc start time).
+     *  \param propagatorSettings Settings for propagator, one per thread, each created from the associated entry of
+     *  bodyMaps. The initial states and termination settings are not used.
+     *  \param arcStartTimes Start times of the arcs (in ascending order).
+     *  \param arcEndTimes End times of the arcs (in the same order as arcStartTimes).
+     *  \param arcInitialStates Initial states of the arcs (in the same order as arcStartTimes).
+     *  \param areEquationsOfMotionToBeIntegrated Boolean to denote whether equations of motion should be integrated
+     *  immediately at the end of the contructor or not (default true).
+     *  \param setIntegratedResult Boolean to determine whether to automatically use the integrated results to set
+     *  ephemerides in all body maps (default true).
+     *  \throws std::runtime_error If the input is inconsistent (see checkMultiArcPropagationInput).
+     */
+    MultiArcDynamicsSimulator(
+            const std::vector< simulation_setup::NamedBodyMap >& bodyMaps,
+            const boost::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings,
+            const std::vector< boost::shared_ptr< PropagatorSettings< StateScalarType > > >& propagatorSettings,
+            const std::vector< TimeType >& arcStartTimes,
+            const std::vector< TimeType >& arcEndTimes,
+            const std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& arcInitialStates,
+            const bool areEquationsOfMotionToBeIntegrated = true,
+            const bool setIntegratedResult = true ):
+        bodyMaps_( bodyMaps ), propagatorSettings_( propagatorSettings ),
+        arcStartTimes_( arcStartTimes ), arcEndTimes_( arcEndTimes ), setIntegratedResult_( setIntegratedResult )
+    {
+        checkMultiArcPropagationInput( bodyMaps.size( ), propagatorSettings.size( ), arcStartTimes, arcEndTimes );
+
+        if( integratorSettings == NULL )
+        {
+            throw std::runtime_error( "Error in multi-arc dynamics simulator, integrator settings not defined" );
+        }
+
+        // Create simulator for each thread, with its own copy of the integrator settings.
+        for( unsigned int i = 0; i < bodyMaps_.size( ); i++ )
+        {
+            singleArcDynamicsSimulators_.push_back(
+                        boost::make_shared< SingleArcDynamicsSimulator< StateScalarType, TimeType > >(
+                            bodyMaps_.at( i ), integratorSettings->clone( ), propagatorSettings_.at( i ),
+                            false, false, false ) );
+        }
+
+        if( areEquationsOfMotionToBeIntegrated )
+        {
+            integrateEquationsOfMotion( arcInitialStates );
+        }
+    }
+
+    //! Destructor
+    ~MultiArcDynamicsSimulator( ){ }
+
+    //! This function numerically (re-)integrates the equations of motion in all arcs.
+    /*!
+     *  This function numerically (re-)integrates the equations of motion in all arcs, concurrently (unless Spice is used
+     *  during the propagation, see getNumberOfConcurrentMultiArcThreads). The raw results are
+     *  set in the equationsOfMotionNumericalSolution_, and (if requested) set in the environment.
+     *  \param arcInitialStates Initial states of the arcs (in the same order as the arc start times). Note that these
+     *  states should be in the correct frame (i.e. corresponding to centralBodies in propagatorSettings_), but not in
+     *  the propagator-specific form (i.e Encke, Gauss, etc. for translational dynamics)
+     *  \throws std::runtime_error If the number of initial states is not equal to the number of arcs.
+     */
+    void integrateEquationsOfMotion(
+            const std::vector< Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& arcInitialStates )
+    {
+        const unsigned int numberOfArcs = arcStartTimes_.size( );
+        const unsigned int numberOfThreads = singleArcDynamicsSimulators_.size( );
+        if( arcInitialStates.size( ) != numberOfArcs )
+        {
+            throw std::runtime_error( "Error in multi-arc dynamics simulator, number of initial states (" +
+                                      boost::lexical_cast< std::string >( arcInitialStates.size( ) ) +
+                                      ") is inconsistent with number of arcs (" +
+                                      boost::lexical_cast< std::string >( numberOfArcs ) + ")." );
+        }
+
+        equationsOfMotionNumericalSolution_.resize( numberOfArcs );
+        dependentVariableHistory_.resize( numberOfArcs );
+        propagationTerminationReasons_.resize( numberOfArcs );
+
+        // Propagate a contiguous block of arcs with each simulator, concurrently if Spice is not used.
+        utilities::executeParallelLoop( numberOfThreads, [ & ]( const unsigned int threadIndex )
+        {
+            boost::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > currentSimulator =
+                    singleArcDynamicsSimulators_.at( threadIndex );
+            for( unsigned int arcIndex = threadIndex * numberOfArcs / numberOfThreads;
+                 arcIndex < ( threadIndex + 1 ) * numberOfArcs / numberOfThreads; arcIndex++ )
+            {
+                resetSingleArcIntegrationInterval(
+                            currentSimulator, arcStartTimes_.at( arcIndex ), arcEndTimes_.at( arcIndex ) );
+                currentSimulator->integrateEquationsOfMotion( arcInitialStates.at( arcIndex ) );
+
+                equationsOfMotionNumericalSolution_[ arcIndex ] = currentSimulator->getEquationsOfMotionNumericalSolution( );
+                dependentVariableHistory_[ arcIndex ] = currentSimulator->getDependentVariableHistory( );
+                propagationTerminationReasons_[ arcIndex ] = currentSimulator->getPropagationTerminationReason( );
+            }
+        }, getNumberOfConcurrentMultiArcThreads( bodyMaps_ ) );
+
+        if( setIntegratedResult_ )
+        {
+            resetMultiArcIntegratedStatesInEnvironment(
+                        bodyMaps_, propagatorSettings_, arcStartTimes_, equationsOfMotionNumericalSolution_ );
+        }
+    }
+
+    //! Function to return the state history of numerically integrated bodies in each arc.
+    /*!
+     * Function to return the state history of numerically integrated bodies in each arc.
+     * \return List of maps of state history of numerically integrated bodies (one per arc).
+     */
+    std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
+    getEquationsOfMotionNumericalSolution( )
+    {
+        return equationsOfMotionNumericalSolution_;
+    }
+
+    //! Function to return the dependent variable history that was saved during numerical propagation of each arc.
+    /*!
+     * Function to return the dependent variable history that was saved during numerical propagation of each arc.
+     * \return List of maps of dependent variable history (one per arc).
+     */
+    std::vector< std::map< TimeType, Eigen::VectorXd > > getDependentVariableHistory( )
+    {
+        return dependentVariableHistory_;
+    }
+
+    //! Function to retrieve the events that triggered the termination of the last propagation of each arc.
+    /*!
+     * Function to retrieve the events that triggered the termination of the last propagation of each arc.
+     * \return Events that triggered the termination of the last propagation of each arc.
+     */
+    std::vector< PropagationTerminationReason > getPropagationTerminationReasons( )
+    {
+        return propagationTerminationReasons_;
+    }
+
+    //! Function to get the single-arc simulators that are used to propagate the arcs (one per thread).
+    /*!
+     * Function to get the single-arc simulators that are used to propagate the arcs (one per thread).
+     * \return Single-arc simulators that are used to propagate the arcs.
+     */
+    std::vector< boost::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > >
+    getSingleArcDynamicsSimulators( )
+    {
+        return singleArcDynamicsSimulators_;
+    }
+
+    //! Function to get the maps of named bodies involved in simulation (one per thread).
+    /*!
+     *  Function to get the maps of named bodies involved in simulation (one per thread).
+     *  \return Maps of named bodies involved in simulation.
+     */
+    std::vector< simulation_setup::NamedBodyMap > getNamedBodyMaps( )
+    {
+        return bodyMaps_;
+    }
+
+    //! Function to get the start times of the arcs.
+    std::vector< TimeType > getArcStartTimes( )
+    {
+        return arcStartTimes_;
+    }
+
+    //! Function to get the end times of the arcs.
+    std::vector< TimeType > getArcEndTimes( )
+    {
+        return arcEndTimes_;
+    }
+
+private:
+
+    //! Maps of bodies (with names) of all bodies in integration, one per thread.
+    std::vector< simulation_setup::NamedBodyMap > bodyMaps_;
+
+    //! Settings for propagator, one per thread.
+    std::vector< boost::shared_ptr< PropagatorSettings< StateScalarType > > > propagatorSettings_;
+
+    //! Start times of the arcs.
+    std::vector< TimeType > arcStartTimes_;
+
+    //! End times of the arcs.
+    std::vector< TimeType > arcEndTimes_;
+
+    //! Boolean to determine whether to automatically use the integrated results to set ephemerides.
+    bool setIntegratedResult_;
+
+    //! Single-arc simulators that are used to propagate the arcs, one per thread.
+    std::vector< boost::shared_ptr< SingleArcDynamicsSimulator< StateScalarType, TimeType > > >
+    singleArcDynamicsSimulators_;
+
+    //! List of maps of state history of numerically integrated bodies (one per arc).
+    std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
+    equationsOfMotionNumericalSolution_;
+
+    //! List of maps of dependent variable history that was saved during numerical propagation (one per arc).
+    std::vector< std::map< TimeType, Eigen::VectorXd > > dependentVariableHistory_;
+
+    //! Events that triggered the termination of the propagation of each arc.
+    std::vector< PropagationTerminationReason > propagationTerminationReasons_;
+};
+
 } // namespace propagators
 
 } // namespace tudat
@@ -521,6 +521,12 @@ private:
                                                          ::TimeDependentSphericalHarmonicsGravityField
                                                          ::update,
                                                          gravityField, _1 ) ) );
+
+                            resetFunctionVector_.push_back(
+                                        boost::make_tuple(
+                                            spherical_harmonic_gravity_field_update, currentBodies.at( i ),
+                                            boost::bind( &gravitation::TimeDependentSphericalHarmonicsGravityField::
+                                                         resetCurrentTime, gravityField, TUDAT_NAN ) ) );
                         }
                         // If no sh field at all, throw eeror.
                         else if( boost::dynamic_pointer_cast< gravitation::SphericalHarmonicsGravityField >
@@ -595,6 +601,12 @@ private:
                                                             ::RadiationPressureInterface
                                                             ::updateInterface,
                                                             iterator->second, _1 ) ) );
+
+                            resetFunctionVector_.push_back(
+                                        boost::make_tuple(
+                                            radiation_pressure_interface_update, currentBodies.at( i ),
+                                            boost::bind( &electro_magnetism::RadiationPressureInterface::
+                                                         resetCurrentTime, iterator->second, TUDAT_NAN ) ) );
                         }
                         break;
                     }
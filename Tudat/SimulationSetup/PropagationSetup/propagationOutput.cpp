@@ -89,7 +89,7 @@ double computeEquilibriumFayRiddellHeatFluxFromProperties(
 //! Function to evaluate a set of double and vector-returning functions and concatenate the results.
 Eigen::VectorXd evaluateListOfFunctions(
         const std::vector< boost::function< double( ) > >& doubleFunctionList,
-        const std::vector< std::pair< boost::function< Eigen::VectorXd( ) >, int > > vectorFunctionList,
+        const std::vector< std::pair< boost::function< Eigen::VectorXd( ) >, int > >& vectorFunctionList,
         const int totalSize)
 {
     Eigen::VectorXd variableList = Eigen::VectorXd::Zero( totalSize );
@@ -38,17 +38,17 @@ namespace propagators
  */
 template< typename OutputType, typename InputType >
 OutputType evaluateBivariateReferenceFunction(
-        const boost::function< OutputType( const InputType&, const InputType& ) > functionToEvaluate,
-        const boost::function< InputType( ) > firstInput,
-        const boost::function< InputType( ) > secondInput )
+        const boost::function< OutputType( const InputType&, const InputType& ) >& functionToEvaluate,
+        const boost::function< InputType( ) >& firstInput,
+        const boost::function< InputType( ) >& secondInput )
 {
     return functionToEvaluate( firstInput( ), secondInput( ) );
 }
 
 template< typename OutputType, typename InputType >
 OutputType evaluateReferenceFunction(
-        const boost::function< OutputType( const InputType& ) > functionToEvaluate,
-        const boost::function< InputType( ) > firstInput )
+        const boost::function< OutputType( const InputType& ) >& functionToEvaluate,
+        const boost::function< InputType( ) >& firstInput )
 {
     return functionToEvaluate( firstInput( ) );
 }
@@ -64,9 +64,9 @@ OutputType evaluateReferenceFunction(
  */
 template< typename OutputType, typename InputType >
 OutputType evaluateBivariateFunction(
-        const boost::function< OutputType( const InputType, const InputType ) > functionToEvaluate,
-        const boost::function< InputType( ) > firstInput,
-        const boost::function< InputType( ) > secondInput )
+        const boost::function< OutputType( const InputType, const InputType ) >& functionToEvaluate,
+        const boost::function< InputType( ) >& firstInput,
+        const boost::function< InputType( ) >& secondInput )
 {
     return functionToEvaluate( firstInput( ), secondInput( ) );
 }
@@ -83,11 +83,11 @@ OutputType evaluateBivariateFunction(
  */
 template< typename OutputType, typename FirstInputType, typename SecondInputType, typename ThirdInputType >
 OutputType evaluateTrivariateFunction(
-        const boost::function< OutputType( const FirstInputType&, const SecondInputType, const ThirdInputType ) >
+        const boost::function< OutputType( const FirstInputType&, const SecondInputType, const ThirdInputType ) >&
         functionToEvaluate,
-        const boost::function< FirstInputType( ) > firstInput,
-        const boost::function< SecondInputType( ) > secondInput,
-        const boost::function< ThirdInputType( ) > thirdInput )
+        const boost::function< FirstInputType( ) >& firstInput,
+        const boost::function< SecondInputType( ) >& secondInput,
+        const boost::function< ThirdInputType( ) >& thirdInput )
 {
     return functionToEvaluate( firstInput( ), secondInput( ), thirdInput( ) );
 }
@@ -787,7 +787,7 @@ std::pair< boost::function< Eigen::VectorXd( ) >, int > getVectorDependentVariab
  */
 Eigen::VectorXd evaluateListOfFunctions(
         const std::vector< boost::function< double( ) > >& doubleFunctionList,
-        const std::vector< std::pair< boost::function< Eigen::VectorXd( ) >, int > > vectorFunctionList,
+        const std::vector< std::pair< boost::function< Eigen::VectorXd( ) >, int > >& vectorFunctionList,
         const int totalSize );
 
 //! Function to create a function that evaluates a list of dependent variables and concatenates the results.
@@ -184,6 +184,8 @@ public:
      * (default none).
      * \param printInterval Variable indicating how often (once per printInterval_ seconds or propagation independenty
      * variable) the current state and time are to be printed to console (default never).
+     * \param numberOfThreads Number of threads over which the evaluation of the accelerations acting on the
+     * propagated bodies is distributed (default 1, see NBodyStateDerivative::setNumberOfThreads).
      */
     TranslationalStatePropagatorSettings( const std::vector< std::string >& centralBodies,
                                           const basic_astrodynamics::AccelerationMap& accelerationsMap,
@@ -193,12 +195,13 @@ public:
                                           const TranslationalPropagatorType propagator = cowell,
                                           const boost::shared_ptr< DependentVariableSaveSettings > dependentVariablesToSave =
             boost::shared_ptr< DependentVariableSaveSettings >( ),
-                                          const double printInterval = TUDAT_NAN ):
+                                          const double printInterval = TUDAT_NAN,
+                                          const unsigned int numberOfThreads = 1 ):
         PropagatorSettings< StateScalarType >( transational_state, initialBodyStates, terminationSettings,
                                                dependentVariablesToSave, printInterval ),
         centralBodies_( centralBodies ),
         accelerationsMap_( accelerationsMap ), bodiesToIntegrate_( bodiesToIntegrate ),
-        propagator_( propagator ){ }
+        propagator_( propagator ), numberOfThreads_( numberOfThreads ){ }
 
     //! Constructor for fixed propagation time stopping conditions.
     /*!
@@ -217,6 +220,8 @@ public:
      * (default none).
      * \param printInterval Variable indicating how often (once per printInterval_ seconds or propagation independenty
      * variable) the current state and time are to be printed to console (default never).
+     * \param numberOfThreads Number of threads over which the evaluation of the accelerations acting on the
+     * propagated bodies is distributed (default 1, see NBodyStateDerivative::setNumberOfThreads).
      */
     TranslationalStatePropagatorSettings( const std::vector< std::string >& centralBodies,
                                           const basic_astrodynamics::AccelerationMap& accelerationsMap,
@@ -226,13 +231,14 @@ public:
                                           const TranslationalPropagatorType propagator = cowell,
                                           const boost::shared_ptr< DependentVariableSaveSettings > dependentVariablesToSave =
             boost::shared_ptr< DependentVariableSaveSettings >( ),
-                                          const double printInterval = TUDAT_NAN ):
+                                          const double printInterval = TUDAT_NAN,
+                                          const unsigned int numberOfThreads = 1 ):
         PropagatorSettings< StateScalarType >(
             transational_state, initialBodyStates,  boost::make_shared< PropagationTimeTerminationSettings >( endTime ),
             dependentVariablesToSave, printInterval ),
         centralBodies_( centralBodies ),
         accelerationsMap_( accelerationsMap ), bodiesToIntegrate_( bodiesToIntegrate ),
-        propagator_( propagator ){ }
+        propagator_( propagator ), numberOfThreads_( numberOfThreads ){ }
 
     //! Destructor
     ~TranslationalStatePropagatorSettings( ){ }
@@ -256,6 +262,9 @@ public:
     //! Type of translational state propagator to be used
     TranslationalPropagatorType propagator_;
 
+    //! Number of threads over which the evaluation of the accelerations acting on the propagated bodies is distributed.
+    unsigned int numberOfThreads_;
+
 };
 
 
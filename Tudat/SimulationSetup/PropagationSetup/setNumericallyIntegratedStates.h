@@ -14,6 +14,7 @@
 #include "Tudat/Basics/utilities.h"
 #include "Tudat/SimulationSetup/EnvironmentSetup/body.h"
 #include "Tudat/Astrodynamics/Ephemerides/frameManager.h"
+#include "Tudat/Astrodynamics/Ephemerides/multiArcEphemeris.h"
 #include "Tudat/Astrodynamics/Ephemerides/tabulatedEphemeris.h"
 #include "Tudat/SimulationSetup/PropagationSetup/propagationSettings.h"
 
@@ -204,6 +205,8 @@ std::map< TimeType, Eigen::Matrix< StateScalarType, 6, 1 > > convertNumericalSol
  * motion, in Cartesian elements w.r.t. integratation origins.
  * \param integrationToEphemerisFrameFunctions Function to provide the states of the ephemeris
  * origins of each body w.r.t. their respective integration origins.
+ * \param frameStateCacheResetFunction Function to clear the cached frame states used by
+ * integrationToEphemerisFrameFunctions, called after each reset of an ephemeris (empty if none).
  */
 template< typename TimeType, typename StateScalarType >
 void createAndSetInterpolatorsForEphemerides(
@@ -214,7 +217,8 @@ void createAndSetInterpolatorsForEphemerides(
         const std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution,
         const std::map< std::string, boost::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >&
         integrationToEphemerisFrameFunctions =
-        std::map< std::string, boost::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >( ) )
+        std::map< std::string, boost::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >( ),
+        const boost::function< void( ) > frameStateCacheResetFunction = boost::function< void( ) >( ) )
 {
     using namespace tudat::interpolators;
 
@@ -246,6 +250,12 @@ void createAndSetInterpolatorsForEphemerides(
 
         resetIntegratedEphemerisOfBody(
                     bodyMap, ephemerisInput, bodiesToIntegrate.at( bodyIndex ) );
+
+        // Clear cached frame states, which may depend on the ephemeris that was just reset.
+        if( !frameStateCacheResetFunction.empty( ) )
+        {
+            frameStateCacheResetFunction( );
+        }
     }
 }
 
@@ -263,6 +273,8 @@ void createAndSetInterpolatorsForEphemerides(
  * motion, in Cartesian elements w.r.t. integratation origins.
  * \param integrationToEphemerisFrameFunctions Function to provide the states of the ephemeris
  * origins of each body w.r.t. their respective integration origins.
+ * \param frameStateCacheResetFunction Function to clear the cached frame states used by
+ * integrationToEphemerisFrameFunctions, called after each reset of an ephemeris (empty if none).
  */
 template< typename TimeType, typename StateScalarType >
 void resetIntegratedEphemerides(
@@ -273,7 +285,8 @@ void resetIntegratedEphemerides(
         std::vector< std::string > ephemerisUpdateOrder = std::vector< std::string >( ),
         const std::map< std::string, boost::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >&
         integrationToEphemerisFrameFunctions =
-        std::map< std::string, boost::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >( ) )
+        std::map< std::string, boost::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >( ),
+        const boost::function< void( ) > frameStateCacheResetFunction = boost::function< void( ) >( ) )
 {
     // Set update order arbitrarily if no order is provided.
     if( ephemerisUpdateOrder.size( ) == 0 )
@@ -301,7 +314,7 @@ void resetIntegratedEphemerides(
     // Create interpolators from numerical integration results (states) at discrete times.
     createAndSetInterpolatorsForEphemerides(
                 bodyMap, bodiesToIntegrate, startIndexAndSize.first, ephemerisUpdateOrder,
-                equationsOfMotionNumericalSolution, integrationToEphemerisFrameFunctions );
+                equationsOfMotionNumericalSolution, integrationToEphemerisFrameFunctions, frameStateCacheResetFunction );
 }
 
 //! Resets the mass models of the integrated bodies from the numerical integration results.
@@ -424,7 +437,7 @@ public:
             const boost::shared_ptr< ephemerides::ReferenceFrameManager > frameManager ):
         IntegratedStateProcessor< TimeType, StateScalarType >(
             transational_state, std::make_pair( startIndex, 6 * bodiesToIntegrate.size( ) ) ),
-        bodyMap_( bodyMap ), bodiesToIntegrate_( bodiesToIntegrate )
+        bodyMap_( bodyMap ), bodiesToIntegrate_( bodiesToIntegrate ), frameManager_( frameManager )
     {
         // Get update orders.
         ephemerisUpdateOrder_ = determineEphemerisUpdateorder(
@@ -454,7 +467,8 @@ public:
     {
         resetIntegratedEphemerides< TimeType, StateScalarType >(
                     bodyMap_, numericalSolution, bodiesToIntegrate_, this->startIndexAndSize_, ephemerisUpdateOrder_,
-                    integrationToEphemerisFrameFunctions_ );
+                    integrationToEphemerisFrameFunctions_,
+                    boost::bind( &ephemerides::ReferenceFrameManager::resetFrameStateCaches, frameManager_ ) );
     }
 
 private:
@@ -476,6 +490,10 @@ private:
     //! integration origins.
     std::map< std::string, boost::function< Eigen::Matrix< StateScalarType, 6, 1 >( const TimeType ) > >
     integrationToEphemerisFrameFunctions_;
+
+    //! Object to get state of one body w.r.t. another body, of which the frame state caches are cleared after
+    //! resetting the ephemerides.
+    boost::shared_ptr< ephemerides::ReferenceFrameManager > frameManager_;
 };
 
 //! Class used for processing numerically integrated masses of bodies.
@@ -711,6 +729,156 @@ void resetIntegratedStates(
     }
 }
 
+//! Function to retrieve the bodies for which the translational state is numerically integrated.
+/*!
+ * Function to retrieve the bodies for which the translational state is numerically integrated, with their
+ * integration origins and the indices of their states in the full propagated state vector.
+ * \param propagatorSettings Settings for the propagation that is used
+ * \param bodiesToIntegrate List of bodies with numerically integrated translational state (appended to by this
+ * function).
+ * \param centralBodies List of integration origins of bodiesToIntegrate (appended to by this function).
+ * \param stateStartIndices Index in the propagated state vector where the state of each of bodiesToIntegrate starts
+ * (appended to by this function).
+ * \param startIndex Index of state vector where the state entries handled with propagatorSettings starts.
+ */
+template< typename StateScalarType >
+void getIntegratedTranslationalStateBodies(
+        const boost::shared_ptr< PropagatorSettings< StateScalarType > > propagatorSettings,
+        std::vector< std::string >& bodiesToIntegrate,
+        std::vector< std::string >& centralBodies,
+        std::vector< int >& stateStartIndices,
+        const int startIndex = 0 )
+{
+    switch( propagatorSettings->stateType_ )
+    {
+    case hybrid:
+    {
+        boost::shared_ptr< MultiTypePropagatorSettings< StateScalarType > > multiTypePropagatorSettings =
+                boost::dynamic_pointer_cast< MultiTypePropagatorSettings< StateScalarType > >( propagatorSettings );
+        if( multiTypePropagatorSettings == NULL )
+        {
+            throw std::runtime_error( "Error, input type is inconsistent in getIntegratedTranslationalStateBodies" );
+        }
+
+        int currentStartIndex = startIndex;
+        for( typename std::map< IntegratedStateType, std::vector< boost::shared_ptr<
+             PropagatorSettings< StateScalarType > > > >::const_iterator
+             typeIterator = multiTypePropagatorSettings->propagatorSettingsMap_.begin( );
+             typeIterator != multiTypePropagatorSettings->propagatorSettingsMap_.end( ); typeIterator++ )
+        {
+            for( unsigned int i = 0; i < typeIterator->second.size( ); i++ )
+            {
+                getIntegratedTranslationalStateBodies(
+                            typeIterator->second.at( i ), bodiesToIntegrate, centralBodies, stateStartIndices,
+                            currentStartIndex );
+                currentStartIndex += typeIterator->second.at( i )->getStateSize( );
+            }
+        }
+        break;
+    }
+    case transational_state:
+    {
+        boost::shared_ptr< TranslationalStatePropagatorSettings< StateScalarType > >
+                translationalPropagatorSettings = boost::dynamic_pointer_cast
+                < TranslationalStatePropagatorSettings< StateScalarType > >( propagatorSettings );
+        if( translationalPropagatorSettings == NULL )
+        {
+            throw std::runtime_error( "Error, input type is inconsistent in getIntegratedTranslationalStateBodies" );
+        }
+
+        for( unsigned int i = 0; i < translationalPropagatorSettings->bodiesToIntegrate_.size( ); i++ )
+        {
+            bodiesToIntegrate.push_back( translationalPropagatorSettings->bodiesToIntegrate_.at( i ) );
+            centralBodies.push_back( translationalPropagatorSettings->centralBodies_.at( i ) );
+            stateStartIndices.push_back( startIndex + 6 * i );
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+//! Function to reset the ephemerides of the integrated bodies from the numerical results of a multi-arc propagation.
+/*!
+ * Function to reset the ephemerides of the integrated bodies from the numerical results of a multi-arc propagation.
+ * For each body with numerically integrated translational state, a tabulated ephemeris is created for each arc, which
+ * are combined in a MultiArcEphemeris. If the body already has a MultiArcEphemeris, its arcs are reset. If it has a
+ * TabulatedCartesianEphemeris, it is replaced by a new MultiArcEphemeris, with the same frame origin and orientation.
+ * Only translational states are set in the environment; the ephemeris origin of each body must be equal to its
+ * integration origin.
+ * \param bodyMap List of bodies used in simulations.
+ * \param propagatorSettings Settings for the propagation that is used
+ * \param arcStartTimes Start times of the arcs (in ascending order).
+ * \param arcStateHistories Numerical solution of each arc (in 'conventional form', see
+ * SingleStateTypeDerivative::convertToOutputSolution), in the same order as arcStartTimes.
+ * \throws std::runtime_error If the ephemeris of an integrated body is not tabulated or multi-arc, or is defined
+ * w.r.t. an origin that is not its integration origin.
+ */
+template< typename TimeType, typename StateScalarType >
+void resetMultiArcIntegratedEphemerides(
+        const simulation_setup::NamedBodyMap& bodyMap,
+        const boost::shared_ptr< PropagatorSettings< StateScalarType > > propagatorSettings,
+        const std::vector< double >& arcStartTimes,
+        const std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >&
+        arcStateHistories )
+{
+    using namespace tudat::ephemerides;
+
+    std::vector< std::string > bodiesToIntegrate;
+    std::vector< std::string > centralBodies;
+    std::vector< int > stateStartIndices;
+    getIntegratedTranslationalStateBodies(
+                propagatorSettings, bodiesToIntegrate, centralBodies, stateStartIndices );
+
+    for( unsigned int i = 0; i < bodiesToIntegrate.size( ); i++ )
+    {
+        boost::shared_ptr< Ephemeris > currentEphemeris = bodyMap.at( bodiesToIntegrate.at( i ) )->getEphemeris( );
+        if( currentEphemeris == NULL )
+        {
+            throw std::runtime_error( "Error when resetting multi-arc ephemeris of body " +
+                                      bodiesToIntegrate.at( i ) + ", no ephemeris found" );
+        }
+        else if( currentEphemeris->getReferenceFrameOrigin( ) != centralBodies.at( i ) )
+        {
+            throw std::runtime_error( "Error when resetting multi-arc ephemeris of body " +
+                                      bodiesToIntegrate.at( i ) + ", ephemeris origin " +
+                                      currentEphemeris->getReferenceFrameOrigin( ) +
+                                      " is not equal to integration origin " + centralBodies.at( i ) );
+        }
+
+        // Create tabulated ephemeris for each arc.
+        std::vector< boost::shared_ptr< Ephemeris > > arcEphemerides;
+        for( unsigned int j = 0; j < arcStateHistories.size( ); j++ )
+        {
+            arcEphemerides.push_back(
+                        boost::make_shared< TabulatedCartesianEphemeris< StateScalarType, TimeType > >(
+                            createStateInterpolator( convertNumericalSolutionToEphemerisInput(
+                                                         0, stateStartIndices.at( i ), arcStateHistories.at( j ) ) ),
+                            currentEphemeris->getReferenceFrameOrigin( ),
+                            currentEphemeris->getReferenceFrameOrientation( ) ) );
+        }
+
+        // Reset existing multi-arc ephemeris, or replace tabulated ephemeris.
+        if( isMultiArcEphemeris( currentEphemeris ) )
+        {
+            boost::dynamic_pointer_cast< MultiArcEphemeris >( currentEphemeris )->resetArcEphemerides(
+                        arcStartTimes, arcEphemerides );
+        }
+        else if( isTabulatedEphemeris( currentEphemeris ) )
+        {
+            bodyMap.at( bodiesToIntegrate.at( i ) )->setEphemeris(
+                        boost::make_shared< MultiArcEphemeris >(
+                            arcStartTimes, arcEphemerides, currentEphemeris->getReferenceFrameOrigin( ),
+                            currentEphemeris->getReferenceFrameOrientation( ) ) );
+        }
+        else
+        {
+            throw std::runtime_error( "Error when resetting multi-arc ephemeris of body " +
+                                      bodiesToIntegrate.at( i ) + ", no tabulated or multi-arc ephemeris found" );
+        }
+    }
+}
 
 } // namespace propagators
 
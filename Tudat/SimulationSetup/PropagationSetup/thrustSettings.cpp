@@ -91,10 +91,20 @@ double multiplyMaximumThrustByScalingFactor(
     return maximumThrustMultiplier( ) * maximumThrustFunction( maximumThrustIndependentVariables );
 }
 
-//! Function to check the validity of the input data, and process the maximum thrust multiplier if provided
-void ParameterizedThrustMagnitudeSettings::parseInputDataAndCheckConsistency(
-        const boost::shared_ptr< interpolators::Interpolator< double, double > > thrustMagnitudeInterpolator,
-        const boost::shared_ptr< interpolators::Interpolator< double, double > > specificImpulseInterpolator )
+//! Interface function to multiply a maximum thrust by a multiplier, for combined thrust and specific impulse function
+Eigen::Vector2d multiplyMaximumThrustOfThrustAndSpecificImpulseByScalingFactor(
+        const boost::function< Eigen::Vector2d( const std::vector< double >& ) > maximumThrustAndSpecificImpulseFunction,
+        const boost::function< double( ) > maximumThrustMultiplier,
+        const std::vector< double >& maximumThrustIndependentVariables )
+{
+    Eigen::Vector2d thrustAndSpecificImpulse = maximumThrustAndSpecificImpulseFunction( maximumThrustIndependentVariables );
+    thrustAndSpecificImpulse( 0 ) *= maximumThrustMultiplier( );
+    return thrustAndSpecificImpulse;
+}
+
+//! Function to check the validity of the thrust input data, and remove the maximum thrust multiplier from the input
+boost::function< double( ) > ParameterizedThrustMagnitudeSettings::checkThrustInputDataAndRemoveMaximumThrustMultiplier(
+        const int numberOfThrustInterpolatorDimensions )
 {
     int numberOfUserSpecifiedThrustInputs =
             std::count( thrustIndependentVariables_.begin( ), thrustIndependentVariables_.end( ),
@@ -110,7 +120,7 @@ void ParameterizedThrustMagnitudeSettings::parseInputDataAndCheckConsistency(
         throw std::runtime_error( "Error in parameterized thrust settings, inconsistent number of user-defined input variables for thrust" );
     }
 
-    if( thrustMagnitudeInterpolator->getNumberOfDimensions( ) !=
+    if( numberOfThrustInterpolatorDimensions !=
             ( static_cast< int >( thrustIndependentVariables_.size( ) ) - numberOfMaximumThrustMultipliers ) )
     {
         throw std::runtime_error( "Error in parameterized thrust settings, thrust interpolator size has inconsistent size" );
@@ -121,7 +131,8 @@ void ParameterizedThrustMagnitudeSettings::parseInputDataAndCheckConsistency(
         throw std::runtime_error( "Error  in parameterized thrust settings, only 1 maximum thrust multiplier may be defined." );
     }
 
-    // Parse maximum thrust multiplier function
+    // Retrieve and remove maximum thrust multiplier function
+    boost::function< double( ) > maximumThrustMultiplier;
     if( numberOfMaximumThrustMultipliers == 1 )
     {
         std::vector< propulsion::ThrustIndependentVariables >::iterator findIterator =
@@ -143,11 +154,7 @@ void ParameterizedThrustMagnitudeSettings::parseInputDataAndCheckConsistency(
             }
         }
 
-        boost::function< double( const std::vector< double >& ) > maximumThrustMagnitudeFunction =
-                thrustMagnitudeFunction_;
-        thrustMagnitudeFunction_ = boost::bind(
-                    &multiplyMaximumThrustByScalingFactor, maximumThrustMagnitudeFunction,
-                    thrustGuidanceInputVariables_.at( entryForMaximumThrustMultiplierInGuidanceFunctions ), _1 );
+        maximumThrustMultiplier = thrustGuidanceInputVariables_.at( entryForMaximumThrustMultiplierInGuidanceFunctions );
         thrustIndependentVariables_.erase( thrustIndependentVariables_.begin( ) +
                                          entryForMaximumThrustMultiplierInIndependentVariables);
         thrustGuidanceInputVariables_.erase( thrustGuidanceInputVariables_.begin( ) +
@@ -155,6 +162,26 @@ void ParameterizedThrustMagnitudeSettings::parseInputDataAndCheckConsistency(
 
     }
 
+    return maximumThrustMultiplier;
+}
+
+//! Function to check the validity of the input data, and process the maximum thrust multiplier if provided
+void ParameterizedThrustMagnitudeSettings::parseInputDataAndCheckConsistency(
+        const boost::shared_ptr< interpolators::Interpolator< double, double > > thrustMagnitudeInterpolator,
+        const boost::shared_ptr< interpolators::Interpolator< double, double > > specificImpulseInterpolator )
+{
+    // Parse maximum thrust multiplier function
+    boost::function< double( ) > maximumThrustMultiplier = checkThrustInputDataAndRemoveMaximumThrustMultiplier(
+                thrustMagnitudeInterpolator->getNumberOfDimensions( ) );
+    if( !maximumThrustMultiplier.empty( ) )
+    {
+        boost::function< double( const std::vector< double >& ) > maximumThrustMagnitudeFunction =
+                thrustMagnitudeFunction_;
+        thrustMagnitudeFunction_ = boost::bind(
+                    &multiplyMaximumThrustByScalingFactor, maximumThrustMagnitudeFunction,
+                    maximumThrustMultiplier, _1 );
+    }
+
     if( specificImpulseInterpolator != NULL )
     {
         // Check consistency of user-defined specific impulse input.
@@ -189,6 +216,24 @@ void ParameterizedThrustMagnitudeSettings::parseInputDataAndCheckConsistency(
     }
 }
 
+//! Function to check the validity of the input data for a combined thrust and specific impulse interpolator
+void ParameterizedThrustMagnitudeSettings::parseCombinedInputDataAndCheckConsistency(
+        const boost::shared_ptr< interpolators::Interpolator< double, Eigen::Vector2d > >
+        thrustMagnitudeAndSpecificImpulseInterpolator )
+{
+    // Parse maximum thrust multiplier function
+    boost::function< double( ) > maximumThrustMultiplier = checkThrustInputDataAndRemoveMaximumThrustMultiplier(
+                thrustMagnitudeAndSpecificImpulseInterpolator->getNumberOfDimensions( ) );
+    if( !maximumThrustMultiplier.empty( ) )
+    {
+        boost::function< Eigen::Vector2d( const std::vector< double >& ) > maximumThrustAndSpecificImpulseFunction =
+                thrustMagnitudeAndSpecificImpulseFunction_;
+        thrustMagnitudeAndSpecificImpulseFunction_ = boost::bind(
+                    &multiplyMaximumThrustOfThrustAndSpecificImpulseByScalingFactor,
+                    maximumThrustAndSpecificImpulseFunction, maximumThrustMultiplier, _1 );
+    }
+}
+
 //! Function to read a thrust or specific impulse interpolator from a file.
 boost::shared_ptr< interpolators::Interpolator< double, double > > readCoefficientInterpolatorFromFile(
         const std::string coefficientFile )
@@ -355,6 +355,23 @@ double multiplyMaximumThrustByScalingFactor(
         const boost::function< double( ) > maximumThrustMultiplier,
         const std::vector< double >& maximumThrustIndependentVariables );
 
+//! Interface function to multiply a maximum thrust by a multiplier, for combined thrust and specific impulse function
+/*!
+ * Interface function to multiply a maximum thrust by a multiplier to obtain the actual thrust, for a function that
+ * returns both the thrust and specific impulse. Only the thrust (first entry) is multiplied.
+ * \param maximumThrustAndSpecificImpulseFunction Function returning the maxumum thrust (first entry) and specific
+ * impulse (second entry) as a function of a number of independent variables
+ * \param maximumThrustMultiplier Function returning a value by which the thrust returned by
+ * maximumThrustAndSpecificImpulseFunction is to be multiplied to obtain the actual thrust.
+ * \param maximumThrustIndependentVariables List of variables to be passed as input to
+ * maximumThrustAndSpecificImpulseFunction
+ * \return Actual thrust (first entry) and specific impulse (second entry)
+ */
+Eigen::Vector2d multiplyMaximumThrustOfThrustAndSpecificImpulseByScalingFactor(
+        const boost::function< Eigen::Vector2d( const std::vector< double >& ) > maximumThrustAndSpecificImpulseFunction,
+        const boost::function< double( ) > maximumThrustMultiplier,
+        const std::vector< double >& maximumThrustIndependentVariables );
+
 
 //! Interface base class that can be defined by user to make the use of the ParameterizedThrustMagnitudeSettings class easier
 /*!
@@ -742,12 +759,56 @@ public:
                     thrustMagnitudeInterpolator, boost::shared_ptr< interpolators::Interpolator< double, double > >( ) );
     }
 
+    //! Constructor for parameterized thrust and specific impulse, computed by a single interpolator.
+    /*!
+     * Constructor, defines a single interpolator for thrust and specific impulse, as well as the physical meaning of each
+     * of the independent variables. Using a single interpolator with two outputs, the lookup of the independent
+     * variables in the table is performed only once per evaluation of both the thrust and specific impulse.
+     * \param thrustMagnitudeAndSpecificImpulseInterpolator Interpolator returning the current thrust (or maximum thrust
+     * if independentVariables contains an throttle_dependent_thrust entry) as first entry, and the current specific
+     * impulse as second entry, as a function of the independent variables.
+     * \param independentVariables List of identifiers for the physical meaning of each of the entries of the input to
+     * the 'interpolate' function of thrustMagnitudeAndSpecificImpulseInterpolator.
+     * \param guidanceInputVariables List of functions returning user-defined guidance input variables (default none).
+     * The order of the functions in this vector is passed to the thrustMagnitudeAndSpecificImpulseInterpolator
+     * in the order of the throttle_dependent_thrust and guidance_input_dependent_thrust in the independentVariables
+     * vector
+     * \param inputUpdateFunction Function that is called to update the user-defined guidance to the current time
+     * (empty by default).
+     * \param bodyFixedThrustDirection Direction of the thrust vector in the body-fixed frame (default in x-direction; to
+     * vehicle front).
+     */
+    ParameterizedThrustMagnitudeSettings(
+            const boost::shared_ptr< interpolators::Interpolator< double, Eigen::Vector2d > >
+            thrustMagnitudeAndSpecificImpulseInterpolator,
+            const std::vector< propulsion::ThrustIndependentVariables > independentVariables,
+            const std::vector< boost::function< double( ) > > guidanceInputVariables =
+            std::vector< boost::function< double( ) > >( ),
+            const boost::function< void( const double ) > inputUpdateFunction = boost::function< void( const double) >( ),
+            const Eigen::Vector3d bodyFixedThrustDirection = Eigen::Vector3d::UnitX( ) ):
+        ThrustEngineSettings( thrust_magnitude_from_dependent_variables, "" ),
+        thrustMagnitudeAndSpecificImpulseFunction_(
+            boost::bind( &interpolators::Interpolator< double, Eigen::Vector2d >::interpolate,
+                         thrustMagnitudeAndSpecificImpulseInterpolator, _1 ) ),
+        thrustIndependentVariables_( independentVariables ),
+        thrustGuidanceInputVariables_( guidanceInputVariables ),
+        inputUpdateFunction_( inputUpdateFunction ),
+        bodyFixedThrustDirection_( bodyFixedThrustDirection )
+    {
+        parseCombinedInputDataAndCheckConsistency( thrustMagnitudeAndSpecificImpulseInterpolator );
+    }
+
     //! Function returning the thrust as a function of the independent variables.
     boost::function< double( const std::vector< double >& ) > thrustMagnitudeFunction_;
 
     //! Function returning the specific impulse as a function of the independent variables.
     boost::function< double( const std::vector< double >& ) > specificImpulseFunction_;
 
+    //! Function returning the thrust (first entry) and specific impulse (second entry) as a function of the independent
+    //! variables. If this function is set, thrustMagnitudeFunction_ and specificImpulseFunction_ are not used, and
+    //! thrustIndependentVariables_ and thrustGuidanceInputVariables_ define its input.
+    boost::function< Eigen::Vector2d( const std::vector< double >& ) > thrustMagnitudeAndSpecificImpulseFunction_;
+
     //! List of identifiers for the physical meaning of each of the entries of the input to thrustMagnitudeFunction_.
     std::vector< propulsion::ThrustIndependentVariables > thrustIndependentVariables_;
 
@@ -777,6 +838,27 @@ private:
     void parseInputDataAndCheckConsistency(
             const boost::shared_ptr< interpolators::Interpolator< double, double > > thrustMagnitudeInterpolator,
             const boost::shared_ptr< interpolators::Interpolator< double, double > > specificImpulseInterpolator );
+
+    //! Function to check the validity of the input data for a combined thrust and specific impulse interpolator
+    /*!
+     *  Function to check the validity of the input data for a combined thrust and specific impulse interpolator, and
+     *  process the maximum thrust multiplier if provided.
+     *  \param thrustMagnitudeAndSpecificImpulseInterpolator Interpolator for the (maximum) thrust and specific impulse
+     *  provided to the constructor
+     */
+    void parseCombinedInputDataAndCheckConsistency(
+            const boost::shared_ptr< interpolators::Interpolator< double, Eigen::Vector2d > >
+            thrustMagnitudeAndSpecificImpulseInterpolator );
+
+    //! Function to check the validity of the thrust input data, and remove the maximum thrust multiplier from the input
+    /*!
+     *  Function to check the validity of the thrust input data. If a maximum thrust multiplier is provided, it is removed
+     *  from the thrust independent variables and guidance input variables.
+     *  \param numberOfThrustInterpolatorDimensions Number of independent variables of the (maximum) thrust interpolator.
+     *  \return Function returning the maximum thrust multiplier (empty if none provided).
+     */
+    boost::function< double( ) > checkThrustInputDataAndRemoveMaximumThrustMultiplier(
+            const int numberOfThrustInterpolatorDimensions );
 };
 
 //! Function to read a thrust or specific impulse interpolator from a file.
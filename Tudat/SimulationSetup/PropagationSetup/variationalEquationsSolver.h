@@ -23,6 +23,7 @@
 
 #include "Tudat/Astrodynamics/OrbitDetermination/EstimatableParameters/estimatableParameter.h"
 #include "Tudat/Astrodynamics/Propagators/stateTransitionMatrixInterface.h"
+#include "Tudat/Astrodynamics/Propagators/compactStateTransitionMatrixInterface.h"
 #include "Tudat/SimulationSetup/PropagationSetup/dynamicsSimulator.h"
 #include "Tudat/Astrodynamics/Ephemerides/tabulatedEphemeris.h"
 #include "Tudat/SimulationSetup/EstimationSetup/createStateDerivativePartials.h"
@@ -133,8 +134,8 @@ public:
         propagatorSettings_->resetInitialStates(
                     estimatable_parameters::getInitialStateVectorOfBodiesToEstimate( parametersToEstimate_ ) );
 
-        dynamicsStateDerivative_->template updateStateDerivativeModelSettings(
-                    propagatorSettings_->getInitialStates( ), 0 );
+        dynamicsStateDerivative_->updateStateDerivativeModelSettings(
+                    propagatorSettings_->getInitialStates( ) );
 
         // Check if re-integration of variational equations is requested
         if( areVariationalEquationsToBeIntegrated )
@@ -418,6 +419,12 @@ public:
      *  (default true) after propagation and resetting of state transition interface.
      *  \param integrateEquationsOnCreation Boolean to denote whether equations should be integrated immediately at the
      *  end of this contructor.
+     *  \param stateTransitionMatrixStorage Type of storage used for the history of the state transition and sensitivity
+     *  matrices in the state transition matrix interface. For compact storage, with clearNumericalSolution set to true,
+     *  the matrices are added to the compact storage directly during the numerical integration, so that no map of
+     *  dense matrices is created.
+     *  \param setIntegratedResult Boolean to determine whether to automatically use the integrated results to set
+     *  ephemerides (default true).
      */
     SingleArcVariationalEquationsSolver(
             const simulation_setup::NamedBodyMap& bodyMap,
@@ -428,10 +435,13 @@ public:
             const boost::shared_ptr< numerical_integrators::IntegratorSettings< double > > variationalOnlyIntegratorSettings
             = boost::shared_ptr< numerical_integrators::IntegratorSettings< double > >( ),
             const bool clearNumericalSolution = 1,
-            const bool integrateEquationsOnCreation = 1 ):
+            const bool integrateEquationsOnCreation = 1,
+            const StateTransitionMatrixStorageType stateTransitionMatrixStorage = interpolated_matrix_map_storage,
+            const bool setIntegratedResult = true ):
         VariationalEquationsSolver< StateScalarType, TimeType, ParameterType >(
             bodyMap, integratorSettings, propagatorSettings, parametersToEstimate,
-            variationalOnlyIntegratorSettings, clearNumericalSolution )
+            variationalOnlyIntegratorSettings, clearNumericalSolution ),
+        stateTransitionMatrixStorage_( stateTransitionMatrixStorage )
     {
         // Check input consistency
         if( !checkPropagatorSettingsAndParameterEstimationConsistency< StateScalarType, TimeType, ParameterType >(
@@ -444,7 +454,8 @@ public:
         {
             // Create simulation object for dynamics only.
             dynamicsSimulator_ =  boost::make_shared< SingleArcDynamicsSimulator< StateScalarType, TimeType > >(
-                        bodyMap, integratorSettings, propagatorSettings, false, clearNumericalSolution, true );
+                        bodyMap, integratorSettings, propagatorSettings, false, clearNumericalSolution,
+                        setIntegratedResult );
             dynamicsStateDerivative_ = dynamicsSimulator_->getDynamicsStateDerivative( );
 
             // Create state derivative partials
@@ -511,6 +522,18 @@ public:
         variationalEquationsSolution_[ 0 ].clear( );
         variationalEquationsSolution_[ 1 ].clear( );
 
+        // Check whether matrices are to be stored in compact form directly during the integration (no map of matrices)
+        bool storeCompactHistoryDuringIntegration =
+                ( stateTransitionMatrixStorage_ != interpolated_matrix_map_storage ) && this->clearNumericalSolution_;
+        boost::shared_ptr< CompactStateTransitionAndSensitivityMatrixInterface > compactStateTransitionInterface;
+        if( storeCompactHistoryDuringIntegration )
+        {
+            compactStateTransitionInterface = getOrCreateCompactStateTransitionAndSensitivityMatrixInterface(
+                        stateTransitionInterface_, stateTransitionMatrixStorage_,
+                        propagatorSettings_->getStateSize( ), parameterVectorSize_ );
+            compactStateTransitionInterface->clearMatrixHistory( );
+        }
+
 
         if( integrateEquationsConcurrently )
         {
@@ -525,18 +548,31 @@ public:
             dynamicsStateDerivative_->setPropagationSettings( std::vector< IntegratedStateType >( ), 1, 1 );
             std::map< TimeType, Eigen::VectorXd > dependentVariableHistory;
             std::map< TimeType, MatrixType > rawNumericalSolution;
+            std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > equationsOfMotionNumericalSolution;
+
+            boost::function< void( const TimeType, const MatrixType& ) > saveSolutionFunction;
+            if( storeCompactHistoryDuringIntegration )
+            {
+                saveSolutionFunction = boost::bind(
+                            &SingleArcVariationalEquationsSolver< StateScalarType, TimeType, ParameterType >::
+                            saveConcurrentIntegrationEpoch, this, _1, _2, compactStateTransitionInterface,
+                            boost::ref( equationsOfMotionNumericalSolution ) );
+            }
 
             EquationIntegrationInterface< MatrixType, TimeType >::integrateEquations(
                         dynamicsSimulator_->getStateDerivativeFunction( ), rawNumericalSolution,
                         initialVariationalState, integratorSettings_,
                         boost::bind( &PropagationTerminationCondition::checkStopCondition,
                                      dynamicsSimulator_->getPropagationTerminationCondition( ), _1 ),
-                        dependentVariableHistory );
+                        dependentVariableHistory, boost::function< Eigen::VectorXd( ) >( ), TUDAT_NAN,
+                        saveSolutionFunction );
 
-            std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > equationsOfMotionNumericalSolution;
-            utilities::createVectorBlockMatrixHistory(
-                        rawNumericalSolution, equationsOfMotionNumericalSolution,
-                        std::make_pair( 0, parameterVectorSize_ ), stateTransitionMatrixSize_ );
+            if( !storeCompactHistoryDuringIntegration )
+            {
+                utilities::createVectorBlockMatrixHistory(
+                            rawNumericalSolution, equationsOfMotionNumericalSolution,
+                            std::make_pair( 0, parameterVectorSize_ ), stateTransitionMatrixSize_ );
+            }
 
             equationsOfMotionNumericalSolution = convertNumericalStateSolutionsToOutputSolutions(
                         equationsOfMotionNumericalSolution, dynamicsStateDerivative_ );
@@ -544,10 +580,13 @@ public:
                         equationsOfMotionNumericalSolution );
 
             // Reset solution for state transition and sensitivity matrices.
-            setVariationalEquationsSolution< TimeType, StateScalarType >(
-                        rawNumericalSolution, variationalEquationsSolution_,
-                        std::make_pair( 0, 0 ), std::make_pair( 0, stateTransitionMatrixSize_ ),
-                        stateTransitionMatrixSize_, parameterVectorSize_ );
+            if( !storeCompactHistoryDuringIntegration )
+            {
+                setVariationalEquationsSolution< TimeType, StateScalarType >(
+                            rawNumericalSolution, variationalEquationsSolution_,
+                            std::make_pair( 0, 0 ), std::make_pair( 0, stateTransitionMatrixSize_ ),
+                            stateTransitionMatrixSize_, parameterVectorSize_ );
+            }
         }
         else
         {
@@ -561,22 +600,41 @@ public:
             std::map< double, Eigen::MatrixXd > rawNumericalSolution;
             std::map< TimeType, Eigen::VectorXd > dependentVariableHistory;
 
+            boost::function< void( const double, const Eigen::MatrixXd& ) > saveSolutionFunction;
+            if( storeCompactHistoryDuringIntegration )
+            {
+                saveSolutionFunction = boost::bind(
+                            &SingleArcVariationalEquationsSolver< StateScalarType, TimeType, ParameterType >::
+                            saveVariationalIntegrationEpoch, this, _1, _2, compactStateTransitionInterface );
+            }
+
             EquationIntegrationInterface< Eigen::MatrixXd, double >::integrateEquations(
                         dynamicsSimulator_->getDoubleStateDerivativeFunction( ), rawNumericalSolution, initialVariationalState,
                         variationalOnlyIntegratorSettings_,
                         boost::bind( &PropagationTerminationCondition::checkStopCondition,
                                      dynamicsSimulator_->getPropagationTerminationCondition( ), _1 ),
-                        dependentVariableHistory );
+                        dependentVariableHistory, boost::function< Eigen::VectorXd( ) >( ), TUDAT_NAN,
+                        saveSolutionFunction );
 
-            setVariationalEquationsSolution< double, double >(
-                        rawNumericalSolution, variationalEquationsSolution_, std::make_pair( 0, 0 ),
-                        std::make_pair( 0, stateTransitionMatrixSize_ ),
-                        stateTransitionMatrixSize_, parameterVectorSize_ );
+            if( !storeCompactHistoryDuringIntegration )
+            {
+                setVariationalEquationsSolution< double, double >(
+                            rawNumericalSolution, variationalEquationsSolution_, std::make_pair( 0, 0 ),
+                            std::make_pair( 0, stateTransitionMatrixSize_ ),
+                            stateTransitionMatrixSize_, parameterVectorSize_ );
+            }
 
         }
 
         // Reset solution for state transition and sensitivity matrices.
-        resetVariationalEquationsInterpolators( );
+        if( storeCompactHistoryDuringIntegration )
+        {
+            compactStateTransitionInterface->finalizeMatrixHistory( );
+        }
+        else
+        {
+            resetVariationalEquationsInterpolators( );
+        }
 
     }
 
@@ -605,6 +663,49 @@ protected:
 
 private:
 
+    //! Function to save a single epoch of the concurrent numerical solution of variational and dynamical equations.
+    /*!
+     *  Function to save a single epoch of the concurrent numerical solution of variational and dynamical equations, with
+     *  the state transition and sensitivity matrices added directly to a compact state transition matrix interface.
+     *  \param time Epoch of the numerical solution.
+     *  \param fullState Numerical solution of variational and dynamical equations at the epoch.
+     *  \param compactStateTransitionInterface Interface to which the state transition and sensitivity matrices are added.
+     *  \param equationsOfMotionNumericalSolution Numerical solution of the equations of motion, to which the state at
+     *  the current epoch is added (returned by reference).
+     */
+    void saveConcurrentIntegrationEpoch(
+            const TimeType time, const MatrixType& fullState,
+            const boost::shared_ptr< CompactStateTransitionAndSensitivityMatrixInterface > compactStateTransitionInterface,
+            std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > >& equationsOfMotionNumericalSolution )
+    {
+        equationsOfMotionNumericalSolution[ time ] =
+                fullState.block( 0, parameterVectorSize_, stateTransitionMatrixSize_, 1 );
+        compactStateTransitionInterface->addMatrixHistoryEpoch(
+                    static_cast< double >( time ),
+                    fullState.block( 0, 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ).
+                    template cast< double >( ),
+                    fullState.block( 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_,
+                                     parameterVectorSize_ - stateTransitionMatrixSize_ ).template cast< double >( ) );
+    }
+
+    //! Function to save a single epoch of the numerical solution of the variational equations.
+    /*!
+     *  Function to save a single epoch of the numerical solution of the variational equations (integrated separately from
+     *  the dynamical equations), with the state transition and sensitivity matrices added directly to a compact state
+     *  transition matrix interface.
+     *  \param time Epoch of the numerical solution.
+     *  \param variationalState Numerical solution of variational equations at the epoch.
+     *  \param compactStateTransitionInterface Interface to which the state transition and sensitivity matrices are added.
+     */
+    void saveVariationalIntegrationEpoch(
+            const double time, const Eigen::MatrixXd& variationalState,
+            const boost::shared_ptr< CompactStateTransitionAndSensitivityMatrixInterface > compactStateTransitionInterface )
+    {
+        compactStateTransitionInterface->addMatrixHistoryEpoch(
+                    time, variationalState.block( 0, 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_ ),
+                    variationalState.block( 0, stateTransitionMatrixSize_, stateTransitionMatrixSize_,
+                                            parameterVectorSize_ - stateTransitionMatrixSize_ ) );
+    }
 
     //! Reset solutions of variational equations.
     /*!
@@ -618,6 +719,20 @@ private:
         using namespace interpolators;
         using namespace utilities;
 
+        // Create (if non-existent) or reset compact state transition matrix interface
+        if( stateTransitionMatrixStorage_ != interpolated_matrix_map_storage )
+        {
+            createOrUpdateCompactStateTransitionAndSensitivityMatrixInterface(
+                        stateTransitionInterface_, variationalEquationsSolution_, stateTransitionMatrixStorage_,
+                        propagatorSettings_->getStateSize( ), parameterVectorSize_ );
+            if( this->clearNumericalSolution_ )
+            {
+                variationalEquationsSolution_[ 0 ].clear( );
+                variationalEquationsSolution_[ 1 ].clear( );
+            }
+            return;
+        }
+
         // Create interpolators.
         boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > >
                 stateTransitionMatrixInterpolator;
@@ -655,6 +770,334 @@ private:
      */
     std::vector< std::map< double, Eigen::MatrixXd > > variationalEquationsSolution_;
 
+    //! Type of storage used for the history of the state transition and sensitivity matrices.
+    StateTransitionMatrixStorageType stateTransitionMatrixStorage_;
+
+};
+
+//! Class to manage and execute the numerical integration of variational equations of a dynamical system in multiple,
+//! independent arcs.
+/*!
+ *  Class to manage and execute the numerical integration of variational equations of a dynamical system, in addition to
+ *  the dynamics itself, in multiple arcs, where each arc has its own initial state and time interval. The initial state
+ *  of each arc is estimated separately, while the other parameters are shared between the arcs. As in
+ *  MultiArcDynamicsSimulator, the arcs are propagated concurrently: each thread propagates a contiguous block of arcs,
+ *  using its own SingleArcVariationalEquationsSolver created from its own body map, propagator settings and parameter
+ *  set. The variational equations are always integrated concurrently with the equations of motion, and the state
+ *  transition and sensitivity matrices of all arcs are provided through a single
+ *  MultiArcCombinedStateTransitionAndSensitivityMatrixInterface. Since the CSPICE library is not re-entrant, the arcs
+ *  are propagated serially if any body map contains an ephemeris or rotation model that is evaluated directly from Spice
+ *  (see getNumberOfConcurrentMultiArcThreads); models that call Spice through a user-defined function cannot be
+ *  detected, and must not be used with more than one body map.
+ */
+template< typename StateScalarType = double, typename TimeType = double, typename ParameterType = double >
+class MultiArcVariationalEquationsSolver
+{
+public:
+
+    //! Local typedef for vector of given scalar type
+    typedef Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > VectorType;
+
+    //! Constructor
+    /*!
+     *  Constructor, sets up a single-arc variational equations solver for each thread.
+     *  \param bodyMaps Maps of bodies (with names) of all bodies in integration, one per thread. Each must be a separate
+     *  environment (i.e. created by a separate call to createBodies).
+     *  \param integratorSettings Settings for numerical integrator of combined propagation of variational equations
+     *  and equations of motion, used for all arcs (with the initial time replaced by the arc start time).
+     *  \param propagatorSettings Settings for propagation of equations of motion, one per thread, each created from the
+     *  associated entry of bodyMaps. The initial states and termination settings are not used.
+     *  \param parametersToEstimate Object containing all parameters that are to be estimated, one per thread, each
+     *  created from the associated entry of bodyMaps. The initial state parameters define the state of a single arc.
+     *  \param arcStartTimes Start times of the arcs (in ascending order).
+     *  \param arcEndTimes End times of the arcs (in the same order as arcStartTimes).
+     *  \param arcInitialStates Initial states of the arcs (in the same order as arcStartTimes).
+     *  \param integrateEquationsOnCreation Boolean to denote whether equations should be integrated immediately at the
+     *  end of this contructor.
+     *  \param clearNumericalSolution Boolean to determine whether to clear the raw numerical solution of the
+     *  variational equations after creation of the interpolators (default true).
+     *  \param setIntegratedResult Boolean to determine whether to automatically use the integrated results to set
+     *  ephemerides in all body maps (default true).
+     *  \throws std::runtime_error If the input is inconsistent (see checkMultiArcPropagationInput).
+     */
+    MultiArcVariationalEquationsSolver(
+            const std::vector< simulation_setup::NamedBodyMap >& bodyMaps,
+            const boost::shared_ptr< numerical_integrators::IntegratorSettings< TimeType > > integratorSettings,
+            const std::vector< boost::shared_ptr< PropagatorSettings< StateScalarType > > >& propagatorSettings,
+            const std::vector< boost::shared_ptr< estimatable_parameters::EstimatableParameterSet< ParameterType > > >&
+            parametersToEstimate,
+            const std::vector< TimeType >& arcStartTimes,
+            const std::vector< TimeType >& arcEndTimes,
+            const std::vector< VectorType >& arcInitialStates,
+            const bool integrateEquationsOnCreation = true,
+            const bool clearNumericalSolution = true,
+            const bool setIntegratedResult = true ):
+        bodyMaps_( bodyMaps ), propagatorSettings_( propagatorSettings ),
+        arcStartTimes_( arcStartTimes ), arcEndTimes_( arcEndTimes ),
+        clearNumericalSolution_( clearNumericalSolution ), setIntegratedResult_( setIntegratedResult )
+    {
+        checkMultiArcPropagationInput( bodyMaps.size( ), propagatorSettings.size( ), arcStartTimes, arcEndTimes );
+        if( parametersToEstimate.size( ) != bodyMaps.size( ) )
+        {
+            throw std::runtime_error( "Error in multi-arc variational equations solver, number of parameter sets is "
+                                      "inconsistent with number of body maps." );
+        }
+
+        if( integratorSettings == NULL )
+        {
+            throw std::runtime_error( "Error in multi-arc variational equations solver, integrator settings not defined" );
+        }
+
+        // Create solver for each thread, with its own copy of the integrator settings. The raw solutions of the
+        // single-arc solvers are retained, since they are retrieved after the propagation of each arc.
+        for( unsigned int i = 0; i < bodyMaps_.size( ); i++ )
+        {
+            singleArcSolvers_.push_back(
+                        boost::make_shared< SingleArcVariationalEquationsSolver< StateScalarType, TimeType, ParameterType > >(
+                            bodyMaps_.at( i ), integratorSettings->clone( ), propagatorSettings_.at( i ),
+                            parametersToEstimate.at( i ), true,
+                            boost::shared_ptr< numerical_integrators::IntegratorSettings< double > >( ),
+                            false, false, interpolated_matrix_map_storage, false ) );
+        }
+
+        stateTransitionMatrixSize_ = parametersToEstimate.at( 0 )->getInitialDynamicalStateParameterSize( );
+        parameterVectorSize_ = parametersToEstimate.at( 0 )->getParameterSetSize( );
+
+        if( integrateEquationsOnCreation )
+        {
+            integrateVariationalAndDynamicalEquations( arcInitialStates );
+        }
+    }
+
+    //! Destructor
+    ~MultiArcVariationalEquationsSolver( ){ }
+
+    //! Function to integrate variational equations and equations of motion in all arcs.
+    /*!
+     *  Function to integrate variational equations and equations of motion in all arcs, concurrently (unless Spice is
+     *  used during the propagation, see getNumberOfConcurrentMultiArcThreads). At the end of this
+     *  function, the state transition matrix interface is reset with the new state transition and sensitivity matrices
+     *  of all arcs and, if requested, the environment is updated to the new solution.
+     *  \param arcInitialStates Initial states of the arcs (in the same order as the arc start times).
+     *  \throws std::runtime_error If the number of initial states is not equal to the number of arcs.
+     */
+    void integrateVariationalAndDynamicalEquations( const std::vector< VectorType >& arcInitialStates )
+    {
+        integrateArcs( arcInitialStates, true );
+    }
+
+    //! Function to integrate equations of motion only in all arcs.
+    /*!
+     *  Function to integrate equations of motion only in all arcs, concurrently (unless Spice is used during the
+     *  propagation, see getNumberOfConcurrentMultiArcThreads). If requested, the environment is updated to the new
+     *  solution.
+     *  \param arcInitialStates Initial states of the arcs (in the same order as the arc start times).
+     *  \throws std::runtime_error If the number of initial states is not equal to the number of arcs.
+     */
+    void integrateDynamicalEquationsOfMotionOnly( const std::vector< VectorType >& arcInitialStates )
+    {
+        integrateArcs( arcInitialStates, false );
+    }
+
+    //! Function to get the state transition matric interface object.
+    /*!
+     *  Function to get the state transition matric interface object, which contains the matrices of all arcs.
+     *  \return The state transition matric interface object.
+     */
+    boost::shared_ptr< CombinedStateTransitionAndSensitivityMatrixInterface > getStateTransitionMatrixInterface( )
+    {
+        return stateTransitionInterface_;
+    }
+
+    //! Function to return the state history of numerically integrated bodies in each arc.
+    /*!
+     * Function to return the state history of numerically integrated bodies in each arc.
+     * \return List of maps of state history of numerically integrated bodies (one per arc).
+     */
+    std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
+    getEquationsOfMotionNumericalSolution( )
+    {
+        return equationsOfMotionNumericalSolution_;
+    }
+
+    //! Function to return the numerical solution history of numerically integrated variational equations in each arc.
+    /*!
+     *  Function to return the numerical solution history of numerically integrated variational equations in each arc
+     *  (empty if clearNumericalSolution was set to true).
+     *  \return List (one entry per arc) of vectors of maps of state transition matrix history (first vector entry)
+     *  and sensitivity matrix history (second vector entry)
+     */
+    std::vector< std::vector< std::map< double, Eigen::MatrixXd > > > getNumericalVariationalEquationsSolution( )
+    {
+        return variationalEquationsSolution_;
+    }
+
+    //! Function to get the single-arc solvers that are used to propagate the arcs (one per thread).
+    /*!
+     * Function to get the single-arc solvers that are used to propagate the arcs (one per thread).
+     * \return Single-arc solvers that are used to propagate the arcs.
+     */
+    std::vector< boost::shared_ptr< SingleArcVariationalEquationsSolver< StateScalarType, TimeType, ParameterType > > >
+    getSingleArcSolvers( )
+    {
+        return singleArcSolvers_;
+    }
+
+    //! Function to get the maps of named bodies involved in simulation (one per thread).
+    /*!
+     *  Function to get the maps of named bodies involved in simulation (one per thread).
+     *  \return Maps of named bodies involved in simulation.
+     */
+    std::vector< simulation_setup::NamedBodyMap > getNamedBodyMaps( )
+    {
+        return bodyMaps_;
+    }
+
+private:
+
+    //! Function to integrate the equations of motion, and if required the variational equations, in all arcs.
+    /*!
+     *  Function to integrate the equations of motion, and if required the variational equations, in all arcs. Each
+     *  single-arc solver propagates a contiguous block of arcs, concurrently if Spice is not used during the propagation.
+     *  \param arcInitialStates Initial states of the arcs (in the same order as the arc start times).
+     *  \param areVariationalEquationsToBeIntegrated Boolean denoting whether the variational equations are integrated.
+     */
+    void integrateArcs( const std::vector< VectorType >& arcInitialStates,
+                        const bool areVariationalEquationsToBeIntegrated )
+    {
+        const unsigned int numberOfArcs = arcStartTimes_.size( );
+        const unsigned int numberOfThreads = singleArcSolvers_.size( );
+        if( arcInitialStates.size( ) != numberOfArcs )
+        {
+            throw std::runtime_error( "Error in multi-arc variational equations solver, number of initial states (" +
+                                      boost::lexical_cast< std::string >( arcInitialStates.size( ) ) +
+                                      ") is inconsistent with number of arcs (" +
+                                      boost::lexical_cast< std::string >( numberOfArcs ) + ")." );
+        }
+
+        equationsOfMotionNumericalSolution_.resize( numberOfArcs );
+        if( areVariationalEquationsToBeIntegrated )
+        {
+            stateTransitionMatrixInterpolators_.resize( numberOfArcs );
+            sensitivityMatrixInterpolators_.resize( numberOfArcs );
+            variationalEquationsSolution_.resize( clearNumericalSolution_ ? 0 : numberOfArcs );
+        }
+
+        utilities::executeParallelLoop( numberOfThreads, [ & ]( const unsigned int threadIndex )
+        {
+            boost::shared_ptr< SingleArcVariationalEquationsSolver< StateScalarType, TimeType, ParameterType > >
+                    currentSolver = singleArcSolvers_.at( threadIndex );
+            for( unsigned int arcIndex = threadIndex * numberOfArcs / numberOfThreads;
+                 arcIndex < ( threadIndex + 1 ) * numberOfArcs / numberOfThreads; arcIndex++ )
+            {
+                resetSingleArcIntegrationInterval(
+                            currentSolver->getDynamicsSimulator( ), arcStartTimes_.at( arcIndex ),
+                            arcEndTimes_.at( arcIndex ) );
+
+                if( areVariationalEquationsToBeIntegrated )
+                {
+                    currentSolver->integrateVariationalAndDynamicalEquations( arcInitialStates.at( arcIndex ), true );
+
+                    // Retrieve the interpolators of this arc, which are newly created by each propagation.
+                    boost::shared_ptr< SingleArcCombinedStateTransitionAndSensitivityMatrixInterface >
+                            arcStateTransitionInterface = boost::dynamic_pointer_cast<
+                            SingleArcCombinedStateTransitionAndSensitivityMatrixInterface >(
+                                currentSolver->getStateTransitionMatrixInterface( ) );
+                    stateTransitionMatrixInterpolators_[ arcIndex ] =
+                            arcStateTransitionInterface->getStateTransitionMatrixInterpolator( );
+                    sensitivityMatrixInterpolators_[ arcIndex ] =
+                            arcStateTransitionInterface->getSensitivityMatrixInterpolator( );
+                    if( !clearNumericalSolution_ )
+                    {
+                        variationalEquationsSolution_[ arcIndex ] = currentSolver->getNumericalVariationalEquationsSolution( );
+                    }
+                }
+                else
+                {
+                    currentSolver->integrateDynamicalEquationsOfMotionOnly( arcInitialStates.at( arcIndex ) );
+                }
+
+                equationsOfMotionNumericalSolution_[ arcIndex ] =
+                        currentSolver->getDynamicsSimulator( )->getEquationsOfMotionNumericalSolution( );
+            }
+        }, getNumberOfConcurrentMultiArcThreads( bodyMaps_ ) );
+
+        // Create (if non-existent) or reset state transition matrix interface
+        if( areVariationalEquationsToBeIntegrated )
+        {
+            std::vector< double > interfaceArcStartTimes;
+            for( unsigned int i = 0; i < numberOfArcs; i++ )
+            {
+                interfaceArcStartTimes.push_back( static_cast< double >( arcStartTimes_.at( i ) ) );
+            }
+
+            if( stateTransitionInterface_ == NULL )
+            {
+                stateTransitionInterface_ =
+                        boost::make_shared< MultiArcCombinedStateTransitionAndSensitivityMatrixInterface >(
+                            stateTransitionMatrixInterpolators_, sensitivityMatrixInterpolators_,
+                            interfaceArcStartTimes, stateTransitionMatrixSize_, parameterVectorSize_ );
+            }
+            else
+            {
+                stateTransitionInterface_->updateMatrixInterpolators(
+                            stateTransitionMatrixInterpolators_, sensitivityMatrixInterpolators_,
+                            interfaceArcStartTimes );
+            }
+        }
+
+        if( setIntegratedResult_ )
+        {
+            resetMultiArcIntegratedStatesInEnvironment(
+                        bodyMaps_, propagatorSettings_, arcStartTimes_, equationsOfMotionNumericalSolution_ );
+        }
+    }
+
+    //! Maps of bodies (with names) of all bodies in integration, one per thread.
+    std::vector< simulation_setup::NamedBodyMap > bodyMaps_;
+
+    //! Settings for propagation of equations of motion, one per thread.
+    std::vector< boost::shared_ptr< PropagatorSettings< StateScalarType > > > propagatorSettings_;
+
+    //! Start times of the arcs.
+    std::vector< TimeType > arcStartTimes_;
+
+    //! End times of the arcs.
+    std::vector< TimeType > arcEndTimes_;
+
+    //! Boolean to determine whether to clear the raw numerical solution of the variational equations.
+    bool clearNumericalSolution_;
+
+    //! Boolean to determine whether to automatically use the integrated results to set ephemerides.
+    bool setIntegratedResult_;
+
+    //! Size (rows and columns are equal) of state transition matrix of a single arc.
+    int stateTransitionMatrixSize_;
+
+    //! Number of parameters of a single arc (initial state and other parameters).
+    int parameterVectorSize_;
+
+    //! Single-arc solvers that are used to propagate the arcs, one per thread.
+    std::vector< boost::shared_ptr< SingleArcVariationalEquationsSolver< StateScalarType, TimeType, ParameterType > > >
+    singleArcSolvers_;
+
+    //! List of maps of state history of numerically integrated bodies (one per arc).
+    std::vector< std::map< TimeType, Eigen::Matrix< StateScalarType, Eigen::Dynamic, 1 > > >
+    equationsOfMotionNumericalSolution_;
+
+    //! History of numerically integrated variational equations (one per arc).
+    std::vector< std::vector< std::map< double, Eigen::MatrixXd > > > variationalEquationsSolution_;
+
+    //! Interpolators of the state transition matrix (one per arc).
+    std::vector< boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > >
+    stateTransitionMatrixInterpolators_;
+
+    //! Interpolators of the sensitivity matrix (one per arc).
+    std::vector< boost::shared_ptr< interpolators::OneDimensionalInterpolator< double, Eigen::MatrixXd > > >
+    sensitivityMatrixInterpolators_;
+
+    //! Object used for interpolating numerical results of state transition and sensitivity matrices of all arcs.
+    boost::shared_ptr< MultiArcCombinedStateTransitionAndSensitivityMatrixInterface > stateTransitionInterface_;
 };
 
 } // namespace propagators
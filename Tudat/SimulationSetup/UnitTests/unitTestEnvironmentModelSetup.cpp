@@ -28,6 +28,7 @@
 #include "Tudat/Astrodynamics/BasicAstrodynamics/unitConversions.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/geodeticCoordinateConversions.h"
 #include "Tudat/Astrodynamics/Ephemerides/approximatePlanetPositions.h"
+#include "Tudat/Astrodynamics/Ephemerides/gcrsToItrsRotationModel.h"
 #include "Tudat/Astrodynamics/Ephemerides/tabulatedEphemeris.h"
 #include "Tudat/Astrodynamics/Ephemerides/simpleRotationalEphemeris.h"
 #include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
@@ -723,6 +724,39 @@ BOOST_AUTO_TEST_CASE( test_rotationModelSetup )
 }
 #endif
 
+//! Test set up of GCRS to ITRS rotation model, and explicit request of truncated CIP/CIO series.
+BOOST_AUTO_TEST_CASE( test_gcrsToItrsRotationModelSetup )
+{
+    // Check that rotation model without series files can not be created, unless truncated series are requested.
+    bool isExceptionCaught = false;
+    try
+    {
+        createRotationModel( boost::make_shared< GcrsToItrsRotationModelSettings >( ), "Earth" );
+    }
+    catch( const std::runtime_error& )
+    {
+        isExceptionCaught = true;
+    }
+    BOOST_CHECK( isExceptionCaught );
+
+    // Create rotation model with truncated series using setup function.
+    boost::shared_ptr< ephemerides::RotationalEphemeris > rotationModel =
+            createRotationModel( boost::make_shared< GcrsToItrsRotationModelSettings >( "", "", "", "", true ),
+                                 "Earth" );
+
+    // Create rotation model manually.
+    ephemerides::GcrsToItrsRotationModel manualRotationModel(
+                ephemerides::getTruncatedEarthOrientationSeries( ephemerides::cip_x_coordinate ),
+                ephemerides::getTruncatedEarthOrientationSeries( ephemerides::cip_y_coordinate ),
+                ephemerides::getTruncatedEarthOrientationSeries( ephemerides::cio_locator_plus_half_xy ) );
+
+    // Verify equivalence of automatically set up and manual models.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                ( Eigen::Matrix3d( manualRotationModel.getRotationToBaseFrame( 4.0E7 ) ) ),
+                ( Eigen::Matrix3d( rotationModel->getRotationToBaseFrame( 4.0E7 ) ) ),
+                std::numeric_limits< double >::epsilon( ) );
+}
+
 #if USE_CSPICE
 //! Test set up of radiation pressure interfacel environment models.
 BOOST_AUTO_TEST_CASE( test_radiationPressureInterfaceSetup )
@@ -0,0 +1,139 @@
+/*    Copyright (c) 2010-2017, Delft University of Technology
+ *    All rigths reserved
+ *
+ *    This file is part of the Tudat. Redistribution and use in source and
+ *    binary forms, with or without modification, are permitted exclusively
+ *    under the terms of the Modified BSD license. You should have received
+ *    a copy of the license with this file. If not, please or visit:
+ *    http://tudat.tudelft.nl/LICENSE.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/SimulationSetup/EnvironmentSetup/createGravityField.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+using namespace simulation_setup;
+
+BOOST_AUTO_TEST_SUITE( test_gravity_field_files )
+
+//! Test conversion of a text gravity field file to a binary file, and loading of (truncated) fields from it.
+BOOST_AUTO_TEST_CASE( test_binaryGravityFieldFile )
+{
+    const std::string textFileName =
+            input_output::getTudatRootPath( ) + "Astrodynamics/Gravitation/gglp_lpe200_sha.tab";
+    const boost::filesystem::path temporaryDirectory =
+            boost::filesystem::temp_directory_path( ) / boost::filesystem::unique_path( );
+    boost::filesystem::create_directories( temporaryDirectory );
+    const std::string binaryFileName = ( temporaryDirectory / "gglp_lpe200_sha.bin" ).string( );
+
+    // Read text file, and convert it to binary file.
+    std::pair< Eigen::MatrixXd, Eigen::MatrixXd > textCoefficients;
+    const std::pair< double, double > textReferenceData =
+            readGravityFieldFile( textFileName, 200, 200, textCoefficients, 1, 0 );
+
+    convertGravityFieldFileToBinary( textFileName, binaryFileName, 200, 200, 1, 0 );
+    BOOST_CHECK( isBinaryGravityFieldFile( binaryFileName ) );
+    BOOST_CHECK( !isBinaryGravityFieldFile( textFileName ) );
+    BOOST_CHECK( !isBinaryGravityFieldFile( binaryFileName + ".nonExisting" ) );
+
+    // Check that full field is read identically from binary file.
+    std::pair< Eigen::MatrixXd, Eigen::MatrixXd > binaryCoefficients;
+    std::pair< double, double > binaryReferenceData =
+            readBinaryGravityFieldFile( binaryFileName, 200, 200, binaryCoefficients );
+
+    BOOST_CHECK_EQUAL( binaryReferenceData.first, textReferenceData.first );
+    BOOST_CHECK_EQUAL( binaryReferenceData.second, textReferenceData.second );
+    BOOST_CHECK_EQUAL( textReferenceData.first, 0.4902800238000000E+13 );
+    BOOST_CHECK_EQUAL( textReferenceData.second, 0.1738000000000000E+07 );
+    BOOST_CHECK( binaryCoefficients.first == textCoefficients.first );
+    BOOST_CHECK( binaryCoefficients.second == textCoefficients.second );
+
+    // Check that truncated field is read identically through readGravityFieldFile (header indices are ignored).
+    binaryReferenceData = readGravityFieldFile( binaryFileName, 50, 30, binaryCoefficients );
+
+    std::pair< Eigen::MatrixXd, Eigen::MatrixXd > truncatedTextCoefficients;
+    readGravityFieldFile( textFileName, 50, 30, truncatedTextCoefficients, 1, 0 );
+    BOOST_CHECK_EQUAL( binaryReferenceData.first, textReferenceData.first );
+    BOOST_CHECK_EQUAL( binaryCoefficients.first.rows( ), 51 );
+    BOOST_CHECK_EQUAL( binaryCoefficients.first.cols( ), 31 );
+    BOOST_CHECK( binaryCoefficients.first == truncatedTextCoefficients.first );
+    BOOST_CHECK( binaryCoefficients.second == truncatedTextCoefficients.second );
+
+    // Check that coefficients beyond the degree of the file are zero.
+    readBinaryGravityFieldFile( binaryFileName, 250, 220, binaryCoefficients );
+    BOOST_CHECK( binaryCoefficients.first.block( 0, 0, 201, 201 ) == textCoefficients.first );
+    BOOST_CHECK( binaryCoefficients.second.block( 0, 0, 201, 201 ) == textCoefficients.second );
+    BOOST_CHECK_EQUAL( binaryCoefficients.first.block( 201, 0, 50, 221 ).norm( ), 0.0 );
+    BOOST_CHECK_EQUAL( binaryCoefficients.first.block( 0, 201, 251, 20 ).norm( ), 0.0 );
+    BOOST_CHECK_EQUAL( binaryCoefficients.second.block( 201, 0, 50, 221 ).norm( ), 0.0 );
+
+    // Check triangular layout for a file with a maximum order below its maximum degree.
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( 6, 3 );
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( 6, 3 );
+    for( int degree = 0; degree < 6; degree++ )
+    {
+        for( int order = 0; order <= std::min( degree, 2 ); order++ )
+        {
+            cosineCoefficients( degree, order ) = 10.0 * degree + order;
+            sineCoefficients( degree, order ) = order > 0 ? -( 10.0 * degree + order ) : 0.0;
+        }
+    }
+    const std::string smallFileName = ( temporaryDirectory / "small.bin" ).string( );
+    writeBinaryGravityFieldFile( smallFileName, 1.0E5, 2.0E3, cosineCoefficients, sineCoefficients );
+    BOOST_CHECK_EQUAL( boost::filesystem::file_size( smallFileName ), 40 + 16 * ( 1 + 2 + 3 + 3 + 3 + 3 ) );
+
+    binaryReferenceData = readBinaryGravityFieldFile( smallFileName, 4, 4, binaryCoefficients );
+    BOOST_CHECK_EQUAL( binaryReferenceData.first, 1.0E5 );
+    BOOST_CHECK_EQUAL( binaryReferenceData.second, 2.0E3 );
+    for( int degree = 0; degree <= 4; degree++ )
+    {
+        for( int order = 0; order <= 4; order++ )
+        {
+            const double expectedCosineCoefficient =
+                    ( degree == 0 && order == 0 ) ? 1.0 : ( order <= 2 ? cosineCoefficients( degree, order ) : 0.0 );
+            const double expectedSineCoefficient = ( order <= 2 ? sineCoefficients( degree, order ) : 0.0 );
+            BOOST_CHECK_EQUAL( binaryCoefficients.first( degree, order ), expectedCosineCoefficient );
+            BOOST_CHECK_EQUAL( binaryCoefficients.second( degree, order ), expectedSineCoefficient );
+        }
+    }
+
+    // Check that invalid files are rejected.
+    BOOST_CHECK_THROW( readBinaryGravityFieldFile( textFileName, 4, 4, binaryCoefficients ), std::runtime_error );
+    BOOST_CHECK_THROW( readBinaryGravityFieldFile( smallFileName + ".nonExisting", 4, 4, binaryCoefficients ),
+                       std::runtime_error );
+    {
+        std::ofstream truncatedFile( ( temporaryDirectory / "truncated.bin" ).string( ).c_str( ), std::ios::binary );
+        std::ifstream smallFile( smallFileName.c_str( ), std::ios::binary );
+        std::vector< char > fileContents( 100 );
+        smallFile.read( fileContents.data( ), 100 );
+        truncatedFile.write( fileContents.data( ), 100 );
+    }
+    BOOST_CHECK_THROW( readBinaryGravityFieldFile( ( temporaryDirectory / "truncated.bin" ).string( ), 2, 2,
+                                                   binaryCoefficients ), std::runtime_error );
+    BOOST_CHECK_THROW( writeBinaryGravityFieldFile( smallFileName, 1.0, 1.0, cosineCoefficients,
+                                                    Eigen::MatrixXd::Zero( 6, 2 ) ), std::runtime_error );
+
+    boost::filesystem::remove_all( temporaryDirectory );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat